@@ -6,6 +6,8 @@ in vec3 Normal;
 in vec2 TexCoord;
 in vec3 InstanceColor;
 in vec3 WorldPos;
+flat in vec4 MaterialLayer;
+flat in int MaterialIndex;
 
 // 输出颜色
 out vec4 FragColor;
@@ -71,7 +73,7 @@ uniform int nrSpotLights;
 // ========================================
 
 uniform float ambientIntensity;  // 环境光强度
-uniform int ambientMode;          // 0=固定颜色, 1=天空盒采样, 2=半球光照
+uniform int ambientMode;          // 0=固定颜色, 1=天空盒采样, 2=半球光照, 3=球谐辐照度
 
 // 天空盒环境光
 uniform samplerCube ambientSkybox;  // 纹理单元 10（TextureUnit::AMBIENT_SKYBOX）
@@ -80,6 +82,13 @@ uniform samplerCube ambientSkybox;  // 纹理单元 10（TextureUnit::AMBIENT_SK
 uniform vec3 skyColor;      // 天空颜色
 uniform vec3 groundColor;   // 地面颜色
 
+// 球谐辐照度（与 C++ GPUSHIrradiance 对应，std140，绑定点 UniformBinding::AMBIENT_SH）
+// 系数已预乘余弦卷积、1/π 和基函数常数
+layout(std140) uniform AmbientSH
+{
+    vec4 shCoefficients[9];
+};
+
 // ========================================
 // 材质属性
 // ========================================
@@ -91,6 +100,31 @@ uniform bool useTexture;
 
 uniform sampler2D textureSampler;  // 纹理单元 1（TextureUnit::MATERIAL_DIFFUSE）
 
+// 材质图集：每个顶点携带纹理数组层
+uniform bool useTextureArray;
+uniform sampler2DArray textureArraySampler;  // 纹理单元 6（TextureUnit::MATERIAL_DIFFUSE_ARRAY）
+
+// 材质表（与 C++ GPUMaterial 对应，std140，绑定点 UniformBinding::MATERIAL_TABLE）
+struct Material
+{
+    vec4 ambient;   // rgb = Ka, a = dissolve
+    vec4 diffuse;   // rgb = Kd, a = 纹理数组层（<0 表示无纹理）
+    vec4 specular;  // rgb = Ks, a = shininess
+    vec4 params;    // x = 纹理数组索引
+};
+
+#define MAX_MATERIALS 256
+
+layout (std140) uniform MaterialTable
+{
+    Material materials[MAX_MATERIALS];
+};
+
+uniform bool useMaterialTable;
+
+// 当前片段使用的高光指数（来自 uniform 或材质表）
+float materialShininess;
+
 // ========================================
 // 视点位置
 // ========================================
@@ -116,7 +150,36 @@ void main()
 
     // 获取基础颜色
     vec3 baseColor;
-    if (useTexture)
+    float alpha = 1.0;
+    materialShininess = shininess;
+    if (useMaterialTable)
+    {
+        // 材质参数全部来自材质表，切换材质无需 uniform 调用
+        Material material = materials[clamp(MaterialIndex, 0, MAX_MATERIALS - 1)];
+        if (material.diffuse.a >= 0.0)
+        {
+            baseColor = texture(textureArraySampler, vec3(TexCoord, material.diffuse.a)).rgb;
+        }
+        else
+        {
+            baseColor = material.diffuse.rgb;
+        }
+        materialShininess = max(material.specular.a, 1.0);
+        alpha = material.ambient.a;
+    }
+    else if (useTextureArray)
+    {
+        // 层索引 < 0：该材质无纹理，使用顶点携带的漫反射颜色
+        if (MaterialLayer.a >= 0.0)
+        {
+            baseColor = texture(textureArraySampler, vec3(TexCoord, MaterialLayer.a)).rgb;
+        }
+        else
+        {
+            baseColor = MaterialLayer.rgb;
+        }
+    }
+    else if (useTexture)
     {
         vec4 texColor = texture(textureSampler, TexCoord);
         baseColor = texColor.rgb;
@@ -168,7 +231,7 @@ void main()
     // Gamma校正
     result = pow(result, vec3(1.0 / 2.2));
 
-    FragColor = vec4(result, 1.0);
+    FragColor = vec4(result, alpha);
 }
 
 // ========================================
@@ -197,6 +260,21 @@ vec3 CalcAmbientLight(vec3 normal)
         vec3 hemiColor = mix(groundColor, skyColor, hemiFactor);
         ambient = hemiColor * ambientIntensity;
     }
+    else if (ambientMode == 3)
+    {
+        // 模式3: 球谐辐照度（无纹理采样）
+        vec3 n = normal;
+        vec3 irradiance = shCoefficients[0].rgb
+                        + shCoefficients[1].rgb * n.y
+                        + shCoefficients[2].rgb * n.z
+                        + shCoefficients[3].rgb * n.x
+                        + shCoefficients[4].rgb * (n.x * n.y)
+                        + shCoefficients[5].rgb * (n.y * n.z)
+                        + shCoefficients[6].rgb * (3.0 * n.z * n.z - 1.0)
+                        + shCoefficients[7].rgb * (n.x * n.z)
+                        + shCoefficients[8].rgb * (n.x * n.x - n.y * n.y);
+        ambient = max(irradiance, vec3(0.0)) * ambientIntensity;
+    }
 
     return ambient;
 }
@@ -215,7 +293,7 @@ vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir)
 
     // 镜面反射
     vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), materialShininess);
 
     // 合并结果（包含环境光分量，但会被CalcAmbientLight覆盖）
     vec3 ambient = light.ambient * light.color;
@@ -235,7 +313,7 @@ vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
 
     // 镜面反射
     vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), materialShininess);
 
     // 衰减
     float distance = length(light.position - fragPos);
@@ -262,7 +340,7 @@ vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
 
     // 镜面反射
     vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), materialShininess);
 
     // 衰减
     float distance = length(light.position - fragPos);
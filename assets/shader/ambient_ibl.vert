@@ -5,16 +5,28 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
 
+// 量化位置的反量化参数（MeshBuffer 按 VAO 提供；未启用时为默认值 (0,0,0,1)，w = 1 表示未量化）
+layout (location = 10) in vec4 aPositionScale;
+layout (location = 11) in vec3 aPositionOffset;
+
 // 实例化属性
 layout (location = 3) in mat4 aInstanceMatrix;
 layout (location = 7) in vec3 aInstanceColor;
 
+// 材质图集属性（MaterialAtlas 网格）：rgb = 漫反射颜色，a = 纹理数组层（<0 表示无纹理）
+layout (location = 8) in vec4 aMaterialLayer;
+
+// 材质表索引（每顶点属性，或由 InstancedRenderer 以常量属性按次绘制提供）
+layout (location = 9) in float aMaterialIndex;
+
 // 输出到片段着色器
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoord;
 out vec3 InstanceColor;
 out vec3 WorldPos;      // 用于天空盒采样
+flat out vec4 MaterialLayer;
+flat out int MaterialIndex;
 
 // 变换矩阵
 uniform mat4 view;
@@ -22,8 +34,10 @@ uniform mat4 projection;
 
 void main()
 {
+    vec3 position = aPositionScale.w > 0.5 ? aPos : aPos * aPositionScale.xyz + aPositionOffset;
+
     // 计算世界坐标位置
-    vec4 worldPos = aInstanceMatrix * vec4(aPos, 1.0);
+    vec4 worldPos = aInstanceMatrix * vec4(position, 1.0);
     FragPos = worldPos.xyz;
     WorldPos = worldPos.xyz;
 
@@ -34,6 +48,8 @@ void main()
     // 传递纹理坐标和实例颜色
     TexCoord = aTexCoord;
     InstanceColor = aInstanceColor;
+    MaterialLayer = aMaterialLayer;
+    MaterialIndex = int(aMaterialIndex + 0.5);
 
     // 应用变换矩阵
     gl_Position = projection * view * worldPos;
@@ -3,6 +3,10 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord; // 纹理坐标
 
+// 量化位置的反量化参数（MeshBuffer 按 VAO 提供；未启用时为默认值 (0,0,0,1)，w = 1 表示未量化）
+layout (location = 10) in vec4 aPositionScale;
+layout (location = 11) in vec3 aPositionOffset;
+
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
@@ -12,8 +16,10 @@ out vec3 Normal;      // 片段的世界空间法线
 out vec2 TexCoord;    // 传递纹理坐标
 
 void main() {
+    vec3 position = aPositionScale.w > 0.5 ? aPos : aPos * aPositionScale.xyz + aPositionOffset;
+
     // 计算顶点在世界空间中的位置
-    FragPos = vec3(model * vec4(aPos, 1.0));
+    FragPos = vec3(model * vec4(position, 1.0));
     // 计算世界空间下的法线（考虑模型旋转和缩放，但不考虑位移）
     Normal = mat3(transpose(inverse(model))) * aNormal;
     // 传递纹理坐标
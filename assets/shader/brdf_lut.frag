@@ -0,0 +1,71 @@
+#version 330 core
+
+// split-sum BRDF 查找表（EnvironmentPrefilter）
+// x = N·V，y = 粗糙度；输出 F0 的缩放（R）和偏移（G）：specular = prefiltered * (F0 * R + G)
+
+in vec2 FaceCoord;
+out vec2 FragColor;
+
+uniform int sampleCount;
+
+const float PI = 3.14159265359;
+
+float RadicalInverse(uint bits)
+{
+    bits = (bits << 16u) | (bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+    return float(bits) * 2.3283064365386963e-10;
+}
+
+// 切线空间（N = +Z）中的 GGX 半程向量
+vec3 ImportanceSampleGGX(vec2 xi, float r)
+{
+    float a = r * r;
+    float phi = 2.0 * PI * xi.x;
+    float cosTheta = sqrt((1.0 - xi.y) / (1.0 + (a * a - 1.0) * xi.y));
+    float sinTheta = sqrt(max(0.0, 1.0 - cosTheta * cosTheta));
+    return vec3(cos(phi) * sinTheta, sin(phi) * sinTheta, cosTheta);
+}
+
+float GeometrySchlickGGX(float NdotX, float r)
+{
+    float k = (r * r) / 2.0; // IBL 使用的 k
+    return NdotX / (NdotX * (1.0 - k) + k);
+}
+
+void main()
+{
+    vec2 uv = FaceCoord * 0.5 + 0.5;
+    float NdotV = uv.x;
+    float roughness = uv.y;
+
+    vec3 V = vec3(sqrt(1.0 - NdotV * NdotV), 0.0, NdotV);
+    uint count = uint(sampleCount);
+
+    float scale = 0.0;
+    float bias = 0.0;
+    for (uint i = 0u; i < count; ++i)
+    {
+        vec2 xi = vec2(float(i) / float(count), RadicalInverse(i));
+        vec3 H = ImportanceSampleGGX(xi, roughness);
+        float VdotH = dot(V, H);
+        vec3 L = 2.0 * VdotH * H - V;
+
+        float NdotL = L.z;
+        float NdotH = H.z;
+        VdotH = max(VdotH, 0.0);
+        if (NdotL > 0.0)
+        {
+            float G = GeometrySchlickGGX(NdotV, roughness) * GeometrySchlickGGX(NdotL, roughness);
+            float gVis = G * VdotH / (NdotH * NdotV);
+            float Fc = pow(1.0 - VdotH, 5.0);
+            scale += (1.0 - Fc) * gVis;
+            bias += Fc * gVis;
+        }
+    }
+
+    FragColor = vec2(scale, bias) / float(count);
+}
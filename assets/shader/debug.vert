@@ -3,6 +3,10 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
 
+// 量化位置的反量化参数（MeshBuffer 按 VAO 提供；未启用时为默认值 (0,0,0,1)，w = 1 表示未量化）
+layout (location = 10) in vec4 aPositionScale;
+layout (location = 11) in vec3 aPositionOffset;
+
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
@@ -12,7 +16,9 @@ out vec3 Normal;
 out vec2 TexCoord;
 
 void main() {
-    FragPos = vec3(model * vec4(aPos, 1.0));
+    vec3 position = aPositionScale.w > 0.5 ? aPos : aPos * aPositionScale.xyz + aPositionOffset;
+
+    FragPos = vec3(model * vec4(position, 1.0));
     Normal = mat3(transpose(inverse(model))) * aNormal;
     TexCoord = aTexCoord;
 
@@ -0,0 +1,13 @@
+#version 330 core
+
+// 全屏三角形（无顶点缓冲，由 gl_VertexID 生成），用于环境贴图预计算 pass
+// FaceCoord 范围 [-1, 1]，y = -1 对应渲染目标的第 0 行
+
+out vec2 FaceCoord;
+
+void main()
+{
+    vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2) * 2.0 - 1.0;
+    FaceCoord = position;
+    gl_Position = vec4(position, 0.0, 1.0);
+}
@@ -0,0 +1,106 @@
+#version 330 core
+
+// GGX 预滤波：每个 mip 对应一个粗糙度（EnvironmentPrefilter）
+// 近似 N = V = R，用重要性采样对环境贴图做 GGX 卷积
+
+in vec2 FaceCoord;
+out vec4 FragColor;
+
+uniform samplerCube environmentMap;
+uniform int face;                 // 0-5，OpenGL 面顺序（+X, -X, +Y, -Y, +Z, -Z）
+uniform float roughness;          // 当前 mip 的粗糙度
+uniform int sampleCount;          // 重要性采样数
+uniform float sourceResolution;   // 源贴图第 0 级边长
+uniform float sourceMaxLod;       // 源贴图最大 mip（0 = 无 mip，不按 PDF 选择源 mip）
+
+const float PI = 3.14159265359;
+
+// 面坐标 → 方向（OpenGL 立方体贴图约定）
+vec3 FaceDirection(int f, vec2 st)
+{
+    float sc = st.x;
+    float tc = st.y;
+    if (f == 0) return vec3(1.0, -tc, -sc);
+    if (f == 1) return vec3(-1.0, -tc, sc);
+    if (f == 2) return vec3(sc, 1.0, tc);
+    if (f == 3) return vec3(sc, -1.0, -tc);
+    if (f == 4) return vec3(sc, -tc, 1.0);
+    return vec3(-sc, -tc, -1.0);
+}
+
+float RadicalInverse(uint bits)
+{
+    bits = (bits << 16u) | (bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+    return float(bits) * 2.3283064365386963e-10;
+}
+
+vec2 Hammersley(uint i, uint count)
+{
+    return vec2(float(i) / float(count), RadicalInverse(i));
+}
+
+vec3 ImportanceSampleGGX(vec2 xi, vec3 N, float r)
+{
+    float a = r * r;
+    float phi = 2.0 * PI * xi.x;
+    float cosTheta = sqrt((1.0 - xi.y) / (1.0 + (a * a - 1.0) * xi.y));
+    float sinTheta = sqrt(max(0.0, 1.0 - cosTheta * cosTheta));
+
+    vec3 H = vec3(cos(phi) * sinTheta, sin(phi) * sinTheta, cosTheta);
+
+    vec3 up = abs(N.z) < 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+    vec3 tangent = normalize(cross(up, N));
+    vec3 bitangent = cross(N, tangent);
+    return normalize(tangent * H.x + bitangent * H.y + N * H.z);
+}
+
+float DistributionGGX(float NdotH, float r)
+{
+    float a = r * r;
+    float a2 = a * a;
+    float d = NdotH * NdotH * (a2 - 1.0) + 1.0;
+    return a2 / (PI * d * d);
+}
+
+void main()
+{
+    vec3 N = normalize(FaceDirection(face, FaceCoord));
+
+    // 粗糙度 0：镜面反射，直接重采样
+    if (roughness <= 0.0)
+    {
+        FragColor = vec4(texture(environmentMap, N).rgb, 1.0);
+        return;
+    }
+
+    float texelSolidAngle = 4.0 * PI / (6.0 * sourceResolution * sourceResolution);
+    uint count = uint(sampleCount);
+
+    vec3 color = vec3(0.0);
+    float totalWeight = 0.0;
+    for (uint i = 0u; i < count; ++i)
+    {
+        vec3 H = ImportanceSampleGGX(Hammersley(i, count), N, roughness);
+        vec3 L = normalize(2.0 * dot(N, H) * H - N);
+        float NdotL = dot(N, L);
+        if (NdotL > 0.0)
+        {
+            // 按采样 PDF 选择源 mip（N = V 时 pdf = D / 4），用少量采样得到平滑结果
+            float lod = 0.0;
+            if (sourceMaxLod > 0.0)
+            {
+                float pdf = DistributionGGX(max(dot(N, H), 0.0), roughness) * 0.25;
+                float sampleSolidAngle = 1.0 / (float(count) * pdf + 0.0001);
+                lod = clamp(0.5 * log2(sampleSolidAngle / texelSolidAngle) + 1.0, 0.0, sourceMaxLod);
+            }
+            color += textureLod(environmentMap, L, lod).rgb * NdotL;
+            totalWeight += NdotL;
+        }
+    }
+
+    FragColor = vec4(color / max(totalWeight, 0.0001), 1.0);
+}
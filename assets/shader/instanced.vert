@@ -5,6 +5,10 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
 
+// 量化位置的反量化参数（MeshBuffer 按 VAO 提供；未启用时为默认值 (0,0,0,1)，w = 1 表示未量化）
+layout (location = 10) in vec4 aPositionScale;
+layout (location = 11) in vec3 aPositionOffset;
+
 // 实例化属性
 layout (location = 3) in mat4 aInstanceMatrix;
 layout (location = 7) in vec3 aInstanceColor;
@@ -21,12 +25,14 @@ out vec3 InstanceColor;
 
 void main()
 {
+    vec3 position = aPositionScale.w > 0.5 ? aPos : aPos * aPositionScale.xyz + aPositionOffset;
+
     // 计算最终的位置：投影 * 视图 * 实例矩阵 * 顶点位置
     mat4 model = aInstanceMatrix;
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    gl_Position = projection * view * model * vec4(position, 1.0);
 
     // 传递数据到片段着色器
-    FragPos = vec3(model * vec4(aPos, 1.0));
+    FragPos = vec3(model * vec4(position, 1.0));
 
     // 计算法线矩阵（用于正确变换法线）
     Normal = mat3(transpose(inverse(model))) * aNormal;
@@ -67,11 +67,18 @@ uniform bool useInstanceColor;
 uniform bool useTexture;
 uniform bool useReflection;  // 是否使用天空盒反射
 uniform float reflectivity;  // 反射强度 (0.0 - 1.0)
+uniform float roughness;     // 反射粗糙度 (0.0 = 镜面)，仅在 usePrefilteredEnv 时生效
 
 // 纹理
 uniform sampler2D textureSampler;  // 纹理单元 1（TextureUnit::MATERIAL_DIFFUSE）
 uniform samplerCube skybox;  // 纹理单元 15（TextureUnit::SKYBOX_CUBEMAP）
 
+// 预滤波环境贴图（EnvironmentPrefilter::ApplyToShader），未加载时回退到直接采样天空盒
+uniform bool usePrefilteredEnv;
+uniform samplerCube prefilteredEnv;  // 纹理单元 11（TextureUnit::ENVIRONMENT_PREFILTERED）
+uniform sampler2D brdfLUT;           // 纹理单元 12（TextureUnit::BRDF_LUT）
+uniform float prefilterMaxLod;       // 预滤波贴图最大 mip（mip = 粗糙度 * maxLod）
+
 // 视点位置
 uniform vec3 viewPos;
 
@@ -138,11 +145,26 @@ void main()
         // 计算反射向量
         vec3 reflectDir = reflect(-viewDir, norm);
 
-        // 从天空盒采样
-        vec3 reflectColor = texture(skybox, reflectDir).rgb;
-
-        // 混合Phong光照和反射颜色
-        result = mix(result, reflectColor, reflectivity);
+        if (usePrefilteredEnv)
+        {
+            // split-sum：预滤波环境（按粗糙度选 mip）x BRDF LUT 的 F0 缩放/偏移，每片元两次采样
+            float NdotV = max(dot(norm, viewDir), 0.0);
+            vec3 prefiltered = textureLod(prefilteredEnv, reflectDir, roughness * prefilterMaxLod).rgb;
+            vec2 brdf = texture(brdfLUT, vec2(NdotV, roughness)).rg;
+            vec3 F0 = vec3(reflectivity);
+            vec3 specular = prefiltered * (F0 * brdf.x + brdf.y);
+
+            // 能量守恒：反射占比越高，漫反射/Phong 部分越少
+            result = result * (1.0 - reflectivity) + specular;
+        }
+        else
+        {
+            // 从天空盒采样
+            vec3 reflectColor = texture(skybox, reflectDir).rgb;
+
+            // 混合Phong光照和反射颜色
+            result = mix(result, reflectColor, reflectivity);
+        }
     }
 
     // Gamma校正
@@ -5,6 +5,10 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
 
+// 量化位置的反量化参数（MeshBuffer 按 VAO 提供；未启用时为默认值 (0,0,0,1)，w = 1 表示未量化）
+layout (location = 10) in vec4 aPositionScale;
+layout (location = 11) in vec3 aPositionOffset;
+
 // 实例化属性
 layout (location = 3) in mat4 aInstanceMatrix;
 layout (location = 7) in vec3 aInstanceColor;
@@ -22,8 +26,10 @@ uniform mat4 projection;
 
 void main()
 {
+    vec3 position = aPositionScale.w > 0.5 ? aPos : aPos * aPositionScale.xyz + aPositionOffset;
+
     // 计算世界坐标位置
-    vec4 worldPos = aInstanceMatrix * vec4(aPos, 1.0);
+    vec4 worldPos = aInstanceMatrix * vec4(position, 1.0);
     FragPos = worldPos.xyz;
     WorldPos = worldPos.xyz;
 
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Core/Profiler.hpp"
+#include <glad/glad.h>
+#include <cstdint>
+#include <vector>
+
+namespace Core {
+
+/**
+ * @class GpuProfiler
+ * @brief GPU 区间计时（GL_TIMESTAMP 查询），结果延迟几帧回读后写入 Profiler 的 "GPU" 轨道
+ *
+ * 设计原则：
+ * - ✅ 区间起止各发一个 glQueryCounter(GL_TIMESTAMP)：支持嵌套（GL_TIME_ELAPSED 同一时间只能有一个）
+ * - ✅ 查询对象按帧分组循环使用（kFrameLatency 组），EndFrame 回读 kFrameLatency - 1 帧之前的结果，
+ *      结果未就绪时丢弃该帧而不等待，计时本身不会造成 CPU / GPU 同步
+ * - ✅ 每帧用 glGetInteger64v(GL_TIMESTAMP) 校准 GPU 时间到 Profiler 时间轴，与 CPU 区间对齐显示
+ * - ⚠️ 只能在持有 GL 上下文的线程调用；Shutdown 需在上下文销毁前调用
+ */
+class GpuProfiler {
+public:
+    static constexpr size_t kFrameLatency = 4;   ///< 查询组数（回读延迟 3 帧）
+    static constexpr uint32_t kInvalidZone = UINT32_MAX;
+
+    static GpuProfiler& GetInstance();
+
+    /**
+     * @brief 开始一个 GPU 区间
+     * @param name 字符串字面量
+     * @return 区间句柄（传给 EndZone）
+     */
+    uint32_t BeginZone(const char* name);
+    void EndZone(uint32_t zone);
+
+    /**
+     * @brief 帧边界：提交本帧的查询，回读最早一组的结果（每帧在 SwapBuffers 前后调用一次）
+     */
+    void EndFrame();
+
+    /**
+     * @brief 删除所有查询对象（GL 上下文销毁前调用）
+     */
+    void Shutdown();
+
+private:
+    GpuProfiler() = default;
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    struct Zone {
+        const char* name = nullptr;
+        GLuint beginQuery = 0;
+        GLuint endQuery = 0;
+    };
+
+    struct FrameQueries {
+        std::vector<Zone> zones;     ///< 查询对象跨帧复用，只增不减
+        size_t used = 0;             ///< 本帧使用的区间数
+        int64_t cpuOffsetNs = 0;     ///< 提交时 Profiler 时间 - GPU 时间
+    };
+
+    bool IsSupported();
+    void ResolveFrame(FrameQueries& frame);
+
+    FrameQueries m_frames[kFrameLatency];
+    size_t m_current = 0;
+    int m_supported = -1;            ///< -1 未检测；0 不支持；1 支持
+};
+
+/**
+ * @class GpuProfileScope
+ * @brief RAII GPU 区间（同时记录同名 CPU 区间）
+ */
+class GpuProfileScope {
+public:
+    explicit GpuProfileScope(const char* name)
+        : m_cpuScope(name), m_zone(GpuProfiler::GetInstance().BeginZone(name)) {}
+
+    ~GpuProfileScope() { GpuProfiler::GetInstance().EndZone(m_zone); }
+
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+private:
+    ProfileScope m_cpuScope;
+    uint32_t m_zone;
+};
+
+} // namespace Core
+
+#if ENABLE_PROFILER
+#define PROFILE_GPU_SCOPE(name) ::Core::GpuProfileScope LUMEN_PROFILE_CONCAT(lumenGpuProfileScope_, __LINE__)(name)
+#define PROFILE_GPU_FRAME() ::Core::GpuProfiler::GetInstance().EndFrame()
+#else
+#define PROFILE_GPU_SCOPE(name) ((void)0)
+#define PROFILE_GPU_FRAME() ((void)0)
+#endif
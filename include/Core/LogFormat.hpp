@@ -0,0 +1,240 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Core {
+
+/**
+ * @struct LogFormatSite
+ * @brief 一处日志宏调用点（格式串 + 源码位置），首次执行时注册并获得格式 ID
+ *
+ * 由 LOG_INFO 等宏以函数内 static 对象的形式创建，生命周期到程序结束，
+ * 写入线程通过 ID 找回格式串，队列中只传 ID 和参数字节。
+ */
+struct LogFormatSite {
+    LogFormatSite(const char* format, const char* file, int line);
+
+    LogFormatSite(const LogFormatSite&) = delete;
+    LogFormatSite& operator=(const LogFormatSite&) = delete;
+
+    const char* format;
+    const char* file;
+    int line;
+    uint32_t id;   ///< 从 1 开始（0 表示已格式化的文本消息）
+};
+
+/**
+ * @namespace LogFormat
+ * @brief 延迟格式化日志：参数编码、格式串注册表和解码
+ *
+ * 格式串语法：
+ * - "{}"      按参数类型默认格式（浮点数为 %g）
+ * - "{:.3f}"  浮点数固定 3 位小数
+ * - "{:x}"    整数 / 指针十六进制
+ * - "{{" "}}" 字面量花括号
+ *
+ * 参数编码：每个参数 1 字节类型标记 + 定长值，字符串为 4 字节长度 + 内容（拷贝，不保留指针）。
+ * 支持整数、枚举、bool、char、浮点数、指针、const char* / std::string / std::string_view。
+ */
+namespace LogFormat {
+
+enum class ArgType : uint8_t {
+    Int = 1,      ///< int64
+    UInt = 2,     ///< uint64
+    Double = 3,   ///< double
+    String = 4,   ///< uint32 长度 + 字节
+    Bool = 5,     ///< uint8
+    Char = 6,     ///< char
+    Pointer = 7   ///< uint64
+};
+
+// ============================================================
+// 二进制日志文件（Logger 写入，lumen-logdecode 解码）
+// 头部："LLOG" + uint32 版本，之后是记录序列（主机字节序）：
+//   Format  : uint8 kind, uint32 id, uint32 line, uint32 fileLen, file, uint32 formatLen, format
+//   Message : uint8 kind, uint32 formatId, uint8 level, int64 timestampNs, uint32 size, payload
+// formatId 为 0 时 payload 是已格式化的文本，否则是参数编码；每个 ID 的 Format 记录先于它的消息出现
+// ============================================================
+
+constexpr char kBinaryMagic[4] = {'L', 'L', 'O', 'G'};
+constexpr uint32_t kBinaryVersion = 1;
+
+enum class BinaryRecordKind : uint8_t {
+    Format = 1,
+    Message = 2
+};
+
+/**
+ * @brief 格式串中的占位符数量（编译期），花括号不匹配时返回 SIZE_MAX
+ */
+constexpr size_t CountPlaceholders(const char* format)
+{
+    size_t count = 0;
+    for (const char* p = format; *p != '\0'; ++p)
+    {
+        if (*p == '{')
+        {
+            if (p[1] == '{')
+            {
+                ++p;
+                continue;
+            }
+            while (*p != '\0' && *p != '}')
+            {
+                ++p;
+            }
+            if (*p == '\0')
+            {
+                return SIZE_MAX;
+            }
+            ++count;
+        }
+        else if (*p == '}')
+        {
+            if (p[1] != '}')
+            {
+                return SIZE_MAX;
+            }
+            ++p;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief 参数个数（只在 decltype 中使用，不求值参数）
+ */
+template <typename... Args>
+std::integral_constant<size_t, sizeof...(Args)> CountArgs(const Args&...);
+
+template <typename T>
+struct AlwaysFalse : std::false_type {};
+
+template <typename T>
+inline size_t StringLength(const T& value)
+{
+    using D = std::decay_t<T>;
+    if constexpr (std::is_array_v<T>)
+    {
+        return std::strlen(value);  // 字符串字面量 / 字符数组不会为空
+    }
+    else if constexpr (std::is_same_v<D, const char*> || std::is_same_v<D, char*>)
+    {
+        return value ? std::strlen(value) : 0;
+    }
+    else
+    {
+        return std::string_view(value).size();
+    }
+}
+
+/**
+ * @brief 参数编码后的字节数
+ */
+template <typename T>
+inline size_t EncodedSize(const T& value)
+{
+    using D = std::decay_t<T>;
+    if constexpr (std::is_same_v<D, bool> || std::is_same_v<D, char>)
+    {
+        return 2;
+    }
+    else if constexpr (std::is_arithmetic_v<D> || std::is_enum_v<D>)
+    {
+        return 1 + 8;
+    }
+    else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+    {
+        return 1 + 4 + StringLength(value);
+    }
+    else if constexpr (std::is_pointer_v<D>)
+    {
+        return 1 + 8;
+    }
+    else
+    {
+        static_assert(AlwaysFalse<T>::value, "unsupported log argument type");
+        return 0;
+    }
+}
+
+template <typename V>
+inline void Put(char*& cursor, ArgType type, const V& value)
+{
+    *cursor++ = static_cast<char>(type);
+    std::memcpy(cursor, &value, sizeof(V));
+    cursor += sizeof(V);
+}
+
+/**
+ * @brief 把参数编码到 cursor（调用方保证剩余空间 ≥ EncodedSize）
+ */
+template <typename T>
+inline void EncodeArg(char*& cursor, const T& value)
+{
+    using D = std::decay_t<T>;
+    if constexpr (std::is_same_v<D, bool>)
+    {
+        Put(cursor, ArgType::Bool, static_cast<uint8_t>(value ? 1 : 0));
+    }
+    else if constexpr (std::is_same_v<D, char>)
+    {
+        Put(cursor, ArgType::Char, value);
+    }
+    else if constexpr (std::is_enum_v<D>)
+    {
+        Put(cursor, ArgType::Int, static_cast<int64_t>(value));
+    }
+    else if constexpr (std::is_integral_v<D> && std::is_signed_v<D>)
+    {
+        Put(cursor, ArgType::Int, static_cast<int64_t>(value));
+    }
+    else if constexpr (std::is_integral_v<D>)
+    {
+        Put(cursor, ArgType::UInt, static_cast<uint64_t>(value));
+    }
+    else if constexpr (std::is_floating_point_v<D>)
+    {
+        Put(cursor, ArgType::Double, static_cast<double>(value));
+    }
+    else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+    {
+        uint32_t length = static_cast<uint32_t>(StringLength(value));
+        Put(cursor, ArgType::String, length);
+        if (length > 0)
+        {
+            std::memcpy(cursor, std::string_view(value).data(), length);
+            cursor += length;
+        }
+    }
+    else
+    {
+        Put(cursor, ArgType::Pointer, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+    }
+}
+
+/**
+ * @brief 按格式串和参数编码生成文本（写入线程 / 解码工具调用）
+ *
+ * 参数不足的占位符输出 "{?}"，多余的参数忽略。
+ */
+std::string Format(std::string_view format, const char* args, size_t size);
+
+/**
+ * @brief 注册调用点，返回格式 ID（线程安全）
+ */
+uint32_t RegisterSite(const LogFormatSite& site);
+
+/**
+ * @brief 按 ID 查找调用点，不存在时返回 nullptr（线程安全）
+ */
+const LogFormatSite* FindSite(uint32_t id);
+
+} // namespace LogFormat
+
+} // namespace Core
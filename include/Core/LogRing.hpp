@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Core {
+
+/**
+ * @enum LogOverflowPolicy
+ * @brief 日志队列满时生产者的行为
+ */
+enum class LogOverflowPolicy {
+    DROP,   ///< 丢弃 DEBUG / INFO 并计数（写入线程随后输出一条丢弃统计）；WARNING / ERROR 从不丢弃，按 BLOCK 等待
+    BLOCK   ///< 自旋让出 CPU 直到写入线程腾出槽位（不丢日志，但热路径可能被拖慢）
+};
+
+/**
+ * @struct LogRecord
+ * @brief 出队时交给消费者的日志记录（指针只在回调期间有效）
+ */
+struct LogRecord {
+    uint8_t level = 0;         ///< LogLevel 的数值
+    int64_t timestampNs = 0;   ///< system_clock 纪元以来的纳秒（入队时采样）
+    uint32_t formatId = 0;     ///< 0：data 为已格式化的文本；否则为 LogFormatSite ID，data 为参数编码
+    const char* data = nullptr;
+    uint32_t size = 0;
+};
+
+/**
+ * @class LogRing
+ * @brief 有界无锁多生产者 / 单消费者环形队列（Logger 异步队列）
+ *
+ * 设计原则：
+ * - ✅ 固定大小槽位预先分配，每个槽位带序号（Vyukov 有界队列）：生产者 CAS 领取位置，
+ *      写完数据后以 release 发布序号；消费者按序号判断槽位是否可读，不需要锁
+ * - ✅ 短消息（≤ kInlineBytes）直接拷贝进槽位，入队不分配内存；更长的消息单独分配
+ * - ✅ 消费者按批次出队（Drain），出队后立即归还槽位
+ * - ⚠️ 只允许一个线程调用 Drain
+ */
+class LogRing {
+public:
+    static constexpr size_t kSlotBytes = 256;
+    static constexpr size_t kInlineBytes = kSlotBytes - 40;
+
+    /**
+     * @param capacity 槽位数（向上取整为 2 的幂，至少 2）
+     */
+    explicit LogRing(size_t capacity = 8192);
+    ~LogRing();
+
+    LogRing(const LogRing&) = delete;
+    LogRing& operator=(const LogRing&) = delete;
+
+    /**
+     * @brief 入队（可在任意线程调用）
+     * @return 队列已满时返回 false（数据未拷贝）
+     */
+    bool TryPush(uint8_t level, int64_t timestampNs, uint32_t formatId, const char* data, size_t size);
+
+    /**
+     * @brief 出队至多 maxCount 条，对每条调用 consume(const LogRecord&)
+     * @return 出队条数
+     */
+    template <typename F>
+    size_t Drain(size_t maxCount, F&& consume)
+    {
+        size_t count = 0;
+        while (count < maxCount)
+        {
+            Slot& slot = m_slots[m_dequeuePos & m_mask];
+            if (slot.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1)
+            {
+                break; // 空，或生产者尚未写完
+            }
+
+            LogRecord record;
+            record.level = slot.level;
+            record.timestampNs = slot.timestampNs;
+            record.formatId = slot.formatId;
+            record.data = slot.heapData ? slot.heapData : slot.inlineData;
+            record.size = slot.size;
+            consume(static_cast<const LogRecord&>(record));
+
+            ReleaseSlot(slot);
+            ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief 是否没有已发布的记录（消费者线程调用）
+     */
+    bool IsEmpty() const
+    {
+        return m_slots[m_dequeuePos & m_mask].sequence.load(std::memory_order_acquire) != m_dequeuePos + 1;
+    }
+
+    size_t GetCapacity() const { return m_mask + 1; }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<size_t> sequence;
+        int64_t timestampNs;
+        char* heapData;            ///< 超过 kInlineBytes 的消息
+        uint32_t size;
+        uint32_t formatId;
+        uint8_t level;
+        char inlineData[kInlineBytes];
+    };
+    static_assert(sizeof(Slot) == kSlotBytes, "LogRing slot layout changed");
+
+    void ReleaseSlot(Slot& slot);
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_mask = 0;
+    alignas(64) std::atomic<size_t> m_enqueuePos{0};  ///< 生产者共享
+    alignas(64) size_t m_dequeuePos = 0;              ///< 只由消费者访问
+};
+
+} // namespace Core
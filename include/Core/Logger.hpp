@@ -1,14 +1,16 @@
 #pragma once
 
+#include "Core/LogFormat.hpp"
+#include "Core/LogRing.hpp"
 #include <string>
 #include <fstream>
 #include <mutex>
 #include <memory>
 #include <thread>
-#include <queue>
 #include <condition_variable>
 #include <atomic>
 #include <chrono>
+#include <vector>
 
 // 编译时控制DEBUG日志输出
 #if defined(NDEBUG) || defined(FORCE_RELEASE_MODE)
@@ -17,11 +19,6 @@
 #define LOG_DEBUG_ENABLED 1
 #endif
 
-// 编译时控制性能关键路径的日志
-#ifndef ENABLE_RENDER_STATS
-#define ENABLE_RENDER_STATS 0
-#endif
-
 // 编译时控制主循环中的性能日志输出（FPS、调试信息等）
 #ifndef ENABLE_PERFORMANCE_LOGGING
 #define ENABLE_PERFORMANCE_LOGGING 0
@@ -62,6 +59,32 @@ struct LogRotationConfig {
     bool compressOldLogs = false;              ///< 是否压缩旧日志文件
 };
 
+/**
+ * @struct LogQueueConfig
+ * @brief 异步日志队列配置（见 LogRing）
+ */
+struct LogQueueConfig {
+    size_t capacity = 8192;                               ///< 槽位数（每个 256 字节，默认 2MB）
+    LogOverflowPolicy overflow = LogOverflowPolicy::DROP; ///< 队列满时的行为
+    size_t batchSize = 256;                               ///< 写入线程每批最多处理的条数
+    std::string binaryLogPath;                            ///< 非空时写入线程把记录原样写入二进制日志（代替文本日志文件，lumen-logdecode 解码）
+};
+
+/**
+ * @struct LogFlushConfig
+ * @brief 日志文件的提交策略（写入线程把多条日志合并为一次写入）
+ *
+ * 满足任一条件时把缓冲的日志一次写入文件：
+ * 距上次写入超过 intervalMs、缓冲达到 maxBufferedBytes、出现 ERROR、Shutdown、进程收到崩溃 / 终止信号。
+ * 同步模式（async = false）下每条日志立即写入。
+ */
+struct LogFlushConfig {
+    int intervalMs = 100;                 ///< 最长缓冲时间（毫秒）
+    size_t maxBufferedBytes = 64 * 1024;  ///< 缓冲上限（字节）
+    bool flushOnError = true;             ///< ERROR 日志立即写入
+    bool flushOnCrash = true;             ///< 安装 SIGSEGV / SIGABRT / SIGTERM 等信号处理，退出前写出缓冲
+};
+
 /**
  * @struct LogContext
  * @brief 日志上下文信息结构体
@@ -75,31 +98,9 @@ struct LogContext {
     std::string currentMesh;       ///< 当前网格名称
 };
 
-/**
- * @struct LogStatistics
- * @brief 日志统计信息结构体
- */
-struct LogStatistics {
-    std::atomic<int> shaderActivations{0};     ///< 着色器激活次数
-    std::atomic<int> textureBinds{0};          ///< 纹理绑定次数
-    std::atomic<int> drawCalls{0};             ///< DrawCall次数
-    std::atomic<int> meshRenders{0};           ///< 网格渲染次数
-    std::atomic<int> fpsSamples{0};            ///< FPS采样次数
-    std::atomic<double> totalFrameTime{0.0};   ///< 总帧时间
-
-    void Reset() {
-        shaderActivations = 0;
-        textureBinds = 0;
-        drawCalls = 0;
-        meshRenders = 0;
-        fpsSamples = 0;
-        totalFrameTime = 0.0;
-    }
-};
-
 /**
  * @struct LogEntry
- * @brief 日志条目结构体，用于异步队列
+ * @brief 日志条目结构体，用于同步写入
  */
 struct LogEntry {
     LogLevel level;
@@ -119,9 +120,29 @@ struct LogEntry {
  *
  * Logger类提供分级日志记录功能，支持DEBUG、INFO、WARNING、ERROR级别。
  * 可以配置输出到文件和控制台，包含时间戳格式化。
+ *
+ * 异步模式：
+ * - ✅ 调用线程只把消息拷贝进无锁环形队列（LogRing）并记录时间戳，不加锁、短消息不分配内存
+ * - ✅ 写入线程按批次出队，格式化（时间戳、上下文）和 IO 都在写入线程完成
+ * - ✅ 队列满时按 LogQueueConfig::overflow 丢弃计数或等待，丢弃数量由写入线程以 WARNING 输出
+ * - ✅ 文件按批提交（LogFlushConfig）：格式化结果追加到缓冲区，一批只有一次 write，轮转也按批检查；
+ *      控制台输出同样按批写出
+ *
+ * 延迟格式化（LOG_INFO 等宏，热路径优先使用）：
+ * - ✅ 先检查级别再求值参数，被过滤的日志不构造任何字符串
+ * - ✅ 入队的只有调用点的格式 ID 和参数的二进制编码（见 LogFormat），格式化在写入线程完成
+ * - ✅ 占位符数量与参数数量在编译期检查
+ * - ✅ 配置 LogQueueConfig::binaryLogPath 后写入线程完全不格式化，记录原样写入二进制日志
+ *
+ * @code
+ * LOG_INFO("Loaded {} vertices from {} in {:.2f} ms", vertexCount, path, elapsedMs);
+ * @endcode
  */
 class Logger {
 public:
+    /// 实际写入文件 / 控制台的最低级别（DEBUG 记录在任何模式下都不输出）
+    static constexpr LogLevel kLowestWrittenLevel = LogLevel::INFO;
+
     /**
      * @brief 获取Logger单例实例
      * @return Logger实例的引用
@@ -135,12 +156,16 @@ public:
      * @param minLevel 最小日志级别（低于此级别的日志将被忽略）
      * @param async 是否启用异步写入
      * @param rotationConfig 日志轮转配置
+     * @param queueConfig 异步队列配置
+     * @param flushConfig 文件提交策略
      */
     void Initialize(const std::string& logFilePath = "logs/application.log",
                    bool consoleOutput = true,
                    LogLevel minLevel = LogLevel::DEBUG,
                    bool async = true,
-                   const LogRotationConfig& rotationConfig = LogRotationConfig());
+                   const LogRotationConfig& rotationConfig = LogRotationConfig(),
+                   const LogQueueConfig& queueConfig = LogQueueConfig(),
+                   const LogFlushConfig& flushConfig = LogFlushConfig());
 
     /**
      * @brief 设置最小日志级别
@@ -154,6 +179,43 @@ public:
      */
     void SetConsoleOutput(bool enabled);
 
+    /**
+     * @brief 指定级别的日志是否会被记录（LOG_* 宏在求值参数前调用）
+     *
+     * 写入端不输出 DEBUG（见 kLowestWrittenLevel），这里在入队之前就过滤掉，
+     * 不会出现的记录不占用异步队列的槽位，也不会挤掉 WARNING / ERROR
+     */
+    bool IsEnabled(LogLevel level) const
+    {
+        return m_initialized && static_cast<int>(level) >= static_cast<int>(kLowestWrittenLevel) &&
+               static_cast<int>(level) >= static_cast<int>(m_minLevel);
+    }
+
+    /**
+     * @brief 延迟格式化日志（由 LOG_* 宏调用）：只编码参数，格式化在写入线程进行
+     * @param site 调用点（格式串和格式 ID）
+     */
+    template <typename... Args>
+    void LogFormatted(LogLevel level, const LogFormatSite& site, const Args&... args)
+    {
+        size_t size = (size_t(0) + ... + LogFormat::EncodedSize(args));
+
+        // 常见的短参数列表在栈上编码，入队时直接拷贝进槽位
+        char stackBuffer[LogRing::kInlineBytes];
+        std::unique_ptr<char[]> heapBuffer;
+        char* buffer = stackBuffer;
+        if (size > sizeof(stackBuffer))
+        {
+            heapBuffer.reset(new char[size]);
+            buffer = heapBuffer.get();
+        }
+
+        char* cursor = buffer;
+        (LogFormat::EncodeArg(cursor, args), ...);
+        (void)cursor;
+        SubmitFormatted(level, site, buffer, size);
+    }
+
     /**
      * @brief 记录DEBUG级别日志（仅在Debug版本中输出）
      * @param message 日志消息
@@ -205,52 +267,23 @@ public:
      */
     void PopContext();
 
-    /**
-     * @brief 记录上下文感知的着色器激活日志
-     * @param shaderId 着色器ID
-     */
-    void LogShaderActivation(unsigned int shaderId);
-
-    /**
-     * @brief 记录上下文感知的纹理绑定日志
-     * @param textureId 纹理ID
-     */
-    void LogTextureBind(unsigned int textureId);
-
-    /**
-     * @brief 记录上下文感知的绘制调用日志
-     * @param triangleCount 三角形数量
-     */
-    void LogDrawCall(int triangleCount);
-
-    /**
-     * @brief 输出统计摘要
-     */
-    void LogStatisticsSummary();
-
-    /**
-     * @brief 重置统计数据
-     */
-    void ResetStatistics();
-
     /**
      * @brief 设置当前FPS值
      * @param fps FPS值
      */
     void SetFPS(int fps);
 
-    /**
-     * @brief 获取统计数据（用于测试）
-     * @return 统计数据引用
-     */
-    const LogStatistics& GetStatistics() const;
-
     /**
      * @brief 获取当前FPS值
      * @return FPS值
      */
     int GetFPS() const;
 
+    /**
+     * @brief 队列满而被丢弃的日志条数（LogOverflowPolicy::DROP）
+     */
+    uint64_t GetDroppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+
     /**
      * @brief 关闭Logger并清理资源
      */
@@ -278,12 +311,38 @@ private:
      */
     void LogAsync(LogLevel level, const std::string& message);
 
+    /**
+     * @brief 把一条记录放入队列（按溢出策略丢弃或等待）
+     * @param formatId 0 表示 data 为文本
+     */
+    void PushRecord(LogLevel level, uint32_t formatId, const char* data, size_t size);
+
+    /**
+     * @brief 提交已编码的延迟格式化日志（同步模式下立即格式化）
+     */
+    void SubmitFormatted(LogLevel level, const LogFormatSite& site, const char* args, size_t size);
+
+    /**
+     * @brief 把记录原样写入二进制日志（首次出现的格式 ID 先写格式定义）
+     */
+    void WriteBinaryRecord(const LogRecord& record);
+
+    /**
+     * @brief 生成记录的消息文本（延迟格式化的记录在此格式化）
+     */
+    std::string RecordMessage(const LogRecord& record) const;
+
     /**
      * @brief 获取当前时间戳字符串
      * @return 格式化的时间戳字符串
      */
     std::string GetTimestamp() const;
 
+    /**
+     * @brief 格式化指定时间点
+     */
+    std::string FormatTimestamp(std::chrono::system_clock::time_point time) const;
+
     /**
      * @brief 将LogLevel转换为字符串
      * @param level 日志级别
@@ -326,7 +385,44 @@ private:
     void WriteLogEntry(const LogEntry& entry);
 
     /**
-     * @brief 刷新日志文件
+     * @brief 写入队列中的一条记录（写入线程调用）
+     */
+    void WriteRecord(const LogRecord& record);
+
+    /**
+     * @brief 把已格式化的消息追加到文件缓冲和控制台缓冲（按 LogFlushConfig 提交）
+     */
+    void WriteFormatted(LogLevel level, const std::string& finalMessage);
+
+    /**
+     * @brief 追加到控制台缓冲（输出流切换时先写出之前的内容，保持顺序）
+     */
+    void AppendConsole(LogLevel level, const std::string& finalMessage);
+
+    /**
+     * @brief 一次写出控制台缓冲
+     */
+    void FlushConsole();
+
+    /**
+     * @brief 是否到了按时间提交的时刻（写入线程调用）
+     */
+    bool ShouldFlushLogFile() const;
+
+    /**
+     * @brief 崩溃 / 终止信号处理：用异步信号安全的调用把文件缓冲写出后重新触发信号
+     */
+    static void HandleFatalSignal(int signal);
+    void InstallSignalHandlers();
+    void RestoreSignalHandlers();
+
+    /**
+     * @brief 输出自上次报告以来被丢弃的日志数量
+     */
+    void ReportDroppedMessages();
+
+    /**
+     * @brief 提交文件缓冲：检查轮转后一次写入并刷新（二进制日志同时刷新）
      */
     void FlushLogFile();
 
@@ -337,20 +433,22 @@ private:
      * @return 格式化后的消息
      */
     std::string FormatMessageWithContext(LogLevel level, const std::string& message);
-
-    /**
-     * @brief 检查是否应该输出统计摘要
-     * @return 是否应该输出统计
-     */
-    bool ShouldLogStatistics();
+    std::string FormatMessageWithContext(LogLevel level, const std::string& message,
+                                         std::chrono::system_clock::time_point time);
 
 private:
     // 异步写入相关
-    std::queue<std::unique_ptr<LogEntry>> m_logQueue;    ///< 日志队列
+    std::unique_ptr<LogRing> m_ring;                      ///< 无锁日志队列
+    LogQueueConfig m_queueConfig;                         ///< 队列配置
     std::thread m_writeThread;                           ///< 写入线程
-    std::mutex m_queueMutex;                             ///< 队列互斥锁
-    std::condition_variable m_queueCondition;            ///< 队列条件变量
+    std::mutex m_queueMutex;                             ///< 写入线程休眠用（队列本身无锁）
+    std::condition_variable m_queueCondition;            ///< 唤醒空闲的写入线程
+    std::atomic<bool> m_writerWaiting{false};             ///< 写入线程正在等待（生产者据此决定是否 notify）
+    std::atomic<uint64_t> m_droppedCount{0};              ///< 队列满时丢弃的条数
+    uint64_t m_reportedDrops = 0;                         ///< 已报告的丢弃条数（写入线程）
     std::atomic<bool> m_running;                          ///< 线程运行标志
+    std::ofstream m_binaryLog;                            ///< 二进制日志（写入线程）
+    std::vector<bool> m_binaryFormatWritten;              ///< 各格式 ID 是否已写入二进制日志
     bool m_asyncMode;                                     ///< 是否异步模式
 
     // 文件和轮转相关
@@ -359,17 +457,63 @@ private:
     LogRotationConfig m_rotationConfig;                   ///< 轮转配置
     std::chrono::system_clock::time_point m_lastRotationTime; ///< 上次轮转时间
 
+    // 按批提交
+    LogFlushConfig m_flushConfig;                         ///< 提交策略
+    std::unique_ptr<char[]> m_fileBuffer;                 ///< 待写入文件的日志（定长，信号处理中可安全读取）
+    size_t m_fileBufferCapacity = 0;
+    std::atomic<size_t> m_fileBufferSize{0};              ///< 已追加的字节数（追加完成后发布）
+    std::chrono::steady_clock::time_point m_lastFlushTime; ///< 上次提交时间
+    std::string m_consoleBuffer;                          ///< 待输出到控制台的日志
+    bool m_consoleBufferIsError = false;                  ///< 控制台缓冲对应 stderr
+    bool m_signalHandlersInstalled = false;
+
     // 配置相关
     std::mutex m_configMutex;                             ///< 配置互斥锁
     bool m_consoleOutput;                                 ///< 是否输出到控制台
     LogLevel m_minLevel;                                  ///< 最小日志级别
     bool m_initialized;                                   ///< 是否已初始化
 
-    // 上下文和统计相关
+    // 上下文和 FPS
     std::vector<LogContext> m_contextStack;               ///< 上下文栈
-    LogStatistics m_statistics;                           ///< 统计信息
-    std::chrono::steady_clock::time_point m_lastStatsTime; ///< 上次统计输出时间
-    std::atomic<int> m_frameCount{0};                     ///< 帧计数器
+    std::atomic<int> m_frameCount{0};                     ///< 当前FPS（SetFPS 写入）
 };
 
 } // namespace Core
+
+// ============================================================
+// 延迟格式化日志宏
+// - 级别被过滤时参数不求值；格式串必须是字符串字面量
+// - 占位符数量与参数数量不一致时编译失败
+// - Release 版本中 LOG_DEBUG 只保留编译期检查
+// ============================================================
+
+#define LUMEN_LOG_CHECK_FORMAT(format, ...)                                                                \
+    static_assert(::Core::LogFormat::CountPlaceholders(format) ==                                         \
+                      decltype(::Core::LogFormat::CountArgs(__VA_ARGS__))::value,                          \
+                  "log format placeholders do not match the argument count")
+
+#define LUMEN_LOG(level, format, ...)                                                                      \
+    do                                                                                                     \
+    {                                                                                                      \
+        LUMEN_LOG_CHECK_FORMAT(format, __VA_ARGS__);                                                       \
+        ::Core::Logger& lumenLogger_ = ::Core::Logger::GetInstance();                                      \
+        if (lumenLogger_.IsEnabled(level))                                                                 \
+        {                                                                                                  \
+            static const ::Core::LogFormatSite lumenLogSite_(format, __FILE__, __LINE__);                  \
+            lumenLogger_.LogFormatted(level, lumenLogSite_, ##__VA_ARGS__);                                \
+        }                                                                                                  \
+    } while (0)
+
+#if LOG_DEBUG_ENABLED
+#define LOG_DEBUG(format, ...) LUMEN_LOG(::Core::LogLevel::DEBUG, format, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(format, ...)                                                                             \
+    do                                                                                                     \
+    {                                                                                                      \
+        LUMEN_LOG_CHECK_FORMAT(format, __VA_ARGS__);                                                       \
+    } while (0)
+#endif
+
+#define LOG_INFO(format, ...) LUMEN_LOG(::Core::LogLevel::INFO, format, ##__VA_ARGS__)
+#define LOG_WARNING(format, ...) LUMEN_LOG(::Core::LogLevel::WARNING, format, ##__VA_ARGS__)
+#define LOG_ERROR(format, ...) LUMEN_LOG(::Core::LogLevel::ERROR, format, ##__VA_ARGS__)
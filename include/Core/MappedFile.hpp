@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Core {
+
+/**
+ * @class MappedFile
+ * @brief 只读内存映射文件（POSIX mmap / Win32 MapViewOfFile）
+ *
+ * 设计原则：
+ * - ✅ 映射期间数据指针稳定，可直接作为 glBufferData 等的数据源（按需缺页，无额外拷贝）
+ * - ✅ 仅移动，析构时自动解除映射
+ * - ⚠️ 映射期间源文件被截断或覆盖时行为未定义；缓存文件应先写临时文件再重命名
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief 映射整个文件
+     * @return 文件不存在或映射失败时返回 false（空文件映射成功，Data() 为 nullptr）
+     */
+    bool Open(const std::string& filepath);
+
+    /**
+     * @brief 解除映射并关闭文件
+     */
+    void Close();
+
+    /**
+     * @brief 提示系统回收 [offset, offset + length) 已缺页的物理页（之后再访问会重新从文件读入）
+     * @note 用于顺序流式读取大文件，让常驻内存不随已读部分增长；范围按页向内取整
+     */
+    void Release(size_t offset, size_t length) const;
+
+    /**
+     * @brief 提示系统整体预读映射（一次顺序读入，代替之后零散的缺页）
+     * @note 用于启动时整体使用的打包文件（见 Renderer::AssetArchive）
+     */
+    void Prefetch() const;
+
+    bool IsOpen() const { return m_isOpen; }
+    const uint8_t* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+
+private:
+    const uint8_t* m_data = nullptr;   ///< 映射起始地址
+    size_t m_size = 0;                 ///< 映射字节数
+    bool m_isOpen = false;             ///< 是否已打开
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;      ///< HANDLE（文件）
+    void* m_mappingHandle = nullptr;   ///< HANDLE（映射对象）
+#endif
+};
+
+} // namespace Core
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 编译时控制性能分析器（关闭时 PROFILE_* 宏展开为空，不产生任何代码）
+// CMake：-DLUMEN_ENABLE_PROFILER=ON
+#ifndef ENABLE_PROFILER
+#define ENABLE_PROFILER 0
+#endif
+
+namespace Core {
+
+/**
+ * @struct ProfileZone
+ * @brief 一个已完成的计时区间（导出时使用）
+ */
+struct ProfileZone {
+    const char* name = nullptr;   ///< 字符串字面量（只保存指针）
+    int64_t startNs = 0;          ///< 相对 Profiler 启动时间的纳秒
+    int64_t endNs = 0;
+};
+
+/**
+ * @class Profiler
+ * @brief 分层 CPU 帧分析器（GPU 区间见 GpuProfiler），按需导出 Chrome / Perfetto 追踪 JSON
+ *
+ * 设计原则：
+ * - ✅ 每个线程首次记录时注册一个固定容量的环形缓冲，之后记录区间只写本线程缓冲（无锁、不分配）
+ * - ✅ 区间由 RAII 的 ProfileScope 记录开始 / 结束时间，嵌套关系由时间包含关系表达（追踪查看器自动分层）
+ * - ✅ 缓冲写满后覆盖最旧的区间：随时导出的都是最近一段时间（每线程 kThreadCapacity 个区间）
+ * - ✅ 帧边界（EndFrame）记录为主线程上的 "Frame" 区间
+ * - ⚠️ 区间名必须是字符串字面量或生命周期覆盖导出的字符串
+ *
+ * 使用方式：
+ * @code
+ * void UpdateInstances() {
+ *     PROFILE_SCOPE("UpdateInstances");
+ *     ...
+ * }
+ * // 主循环末尾
+ * PROFILE_FRAME();
+ * // 按需导出（chrome://tracing 或 ui.perfetto.dev 打开）
+ * Core::Profiler::GetInstance().ExportChromeTrace("logs/trace.json");
+ * @endcode
+ */
+class Profiler {
+public:
+    static constexpr size_t kThreadCapacity = 1 << 16;   ///< 每线程保留的区间数
+
+    static Profiler& GetInstance();
+
+    /**
+     * @brief 当前时间（相对启动时间的纳秒，steady_clock）
+     */
+    int64_t Now() const;
+
+    /**
+     * @brief 记录本线程的一个区间（由 ProfileScope 调用）
+     */
+    void RecordZone(const char* name, int64_t startNs, int64_t endNs);
+
+    /**
+     * @brief 设置本线程在追踪中显示的名称（字符串字面量）
+     */
+    void SetThreadName(const char* name);
+
+    /**
+     * @brief 帧边界：记录上一帧结束到现在的 "Frame" 区间（主循环每帧调用一次）
+     */
+    void EndFrame();
+
+    /**
+     * @brief 记录一个 GPU 区间（GpuProfiler 在查询结果可用时调用，时间已换算到 CPU 时间轴）
+     */
+    void RecordGpuZone(const char* name, int64_t startNs, int64_t endNs);
+
+    uint64_t GetFrameIndex() const { return m_frameIndex.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 导出所有线程缓冲中的区间为 Chrome 追踪 JSON（可在任意线程调用）
+     */
+    bool ExportChromeTrace(const std::string& path) const;
+
+private:
+    Profiler();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    /**
+     * @brief 单个线程的区间环形缓冲（单写者；导出线程按写入位置校验读到的区间未被覆盖）
+     */
+    struct ThreadBuffer {
+        struct Slot {
+            std::atomic<const char*> name{nullptr};
+            std::atomic<int64_t> startNs{0};
+            std::atomic<int64_t> endNs{0};
+        };
+
+        explicit ThreadBuffer(uint32_t id) : threadId(id), slots(new Slot[kThreadCapacity]) {}
+
+        void Push(const char* name, int64_t startNs, int64_t endNs);
+        void Snapshot(std::vector<ProfileZone>& out) const;
+
+        uint32_t threadId;
+        std::atomic<const char*> threadName{nullptr};
+        std::unique_ptr<Slot[]> slots;
+        std::atomic<uint64_t> writeIndex{0};
+    };
+
+    ThreadBuffer& GetThreadBuffer();
+
+    int64_t m_epochNs = 0;                                   ///< 启动时的 steady_clock 时间
+    mutable std::mutex m_registryMutex;                      ///< 只保护线程注册 / 导出遍历
+    std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
+    std::unique_ptr<ThreadBuffer> m_gpuTrack;                ///< GPU 区间（只由渲染线程写入）
+    int64_t m_lastFrameNs = 0;
+    std::atomic<uint64_t> m_frameIndex{0};
+};
+
+/**
+ * @class ProfileScope
+ * @brief RAII CPU 区间
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : m_name(name), m_startNs(Profiler::GetInstance().Now()) {}
+
+    ~ProfileScope()
+    {
+        Profiler& profiler = Profiler::GetInstance();
+        profiler.RecordZone(m_name, m_startNs, profiler.Now());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_name;
+    int64_t m_startNs;
+};
+
+} // namespace Core
+
+#define LUMEN_PROFILE_CONCAT_INNER(a, b) a##b
+#define LUMEN_PROFILE_CONCAT(a, b) LUMEN_PROFILE_CONCAT_INNER(a, b)
+
+#if ENABLE_PROFILER
+#define PROFILE_SCOPE(name) ::Core::ProfileScope LUMEN_PROFILE_CONCAT(lumenProfileScope_, __LINE__)(name)
+#define PROFILE_THREAD(name) ::Core::Profiler::GetInstance().SetThreadName(name)
+#define PROFILE_FRAME() ::Core::Profiler::GetInstance().EndFrame()
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#endif
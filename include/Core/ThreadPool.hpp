@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Core {
+
+/**
+ * @class ThreadPool
+ * @brief 固定数量工作线程的任务池，用于资源加载等可并行的 CPU 工作
+ *
+ * 设计原则：
+ * - ✅ 工作线程只做纯 CPU 工作（解码、编码、投影），OpenGL 调用始终留在主线程
+ * - ✅ Submit() 返回 std::future，任务中的异常通过 future 传回调用者
+ * - ✅ 全局实例 GetInstance() 使用 硬件线程数 - 1 个工作线程（至少 1 个，调用线程通过 ParallelFor 参与计算）
+ * - ⚠️ 任务内部不要等待同一个池中的其他任务（线程数有限，可能死锁）；需要扇出时使用 ParallelFor
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief 获取全局线程池
+     */
+    static ThreadPool& GetInstance();
+
+    /**
+     * @brief 创建线程池
+     * @param threadCount 工作线程数（0 = 硬件线程数 - 1，至少 1）
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+
+    /**
+     * @brief 等待队列中所有任务执行完毕后退出工作线程
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief 提交任务
+     * @return 任务结果的 future
+     */
+    template <typename F>
+    auto Submit(F&& task) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+    {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        Enqueue([packaged]() { (*packaged)(); });
+        return future;
+    }
+
+    /**
+     * @brief 将 [0, count) 切分为若干块并行执行 body(begin, end)，调用线程也参与执行
+     *
+     * 调用线程在池中的任务完成前不会返回，因此可以安全地从主线程调用；
+     * 若从工作线程调用，则在当前线程串行执行，避免嵌套等待。
+     * @param minChunk 每块最少元素数（避免过细的切分）
+     */
+    void ParallelFor(size_t count, const std::function<void(size_t, size_t)>& body, size_t minChunk = 1);
+
+    /**
+     * @brief 工作线程数
+     */
+    size_t GetThreadCount() const { return m_workers.size(); }
+
+    /**
+     * @brief 当前线程是否为本池的工作线程
+     */
+    bool IsWorkerThread() const;
+
+private:
+    void Enqueue(std::function<void()> task);
+    void WorkerLoop();
+
+    std::vector<std::thread> m_workers;              ///< 工作线程
+    std::queue<std::function<void()>> m_tasks;       ///< 任务队列
+    std::mutex m_mutex;                              ///< 队列互斥锁
+    std::condition_variable m_condition;             ///< 新任务/退出通知
+    bool m_stopping = false;                         ///< 析构中，不再接受新任务
+};
+
+} // namespace Core
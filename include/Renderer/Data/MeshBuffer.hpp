@@ -3,11 +3,23 @@
 #include "Renderer/Resources/Texture.hpp"
 #include "Core/GLM.hpp"
 #include <memory>
+#include <vector>
 #include <glad/glad.h>
 
 namespace Renderer
 {
 
+    /**
+     * @struct IndexDrawRange
+     * @brief 一段索引绘制范围（16 位索引超出 65536 顶点时按 baseVertex 分段）
+     */
+    struct IndexDrawRange
+    {
+        size_t firstIndex = 0;  // 起始索引（按索引元素计）
+        size_t indexCount = 0;
+        int baseVertex = 0;     // 加到每个索引上的顶点偏移（glDrawElements*BaseVertex）
+    };
+
     /**
      * @class MeshBuffer
      * @brief GPU 资源包装器 - 管理网格的 OpenGL 缓冲区
@@ -30,6 +42,11 @@ namespace Renderer
     class MeshBuffer
     {
     public:
+        // 量化位置的反量化参数（每个 VAO 一份常量属性，见 MeshQuantizer）
+        // 着色器中 aPositionScale.w = 1（未启用时的默认值）表示位置未量化
+        static constexpr unsigned int kPositionScaleLocation = 10;
+        static constexpr unsigned int kPositionOffsetLocation = 11;
+
         MeshBuffer() = default;
         ~MeshBuffer();
 
@@ -89,6 +106,33 @@ namespace Renderer
          */
         void ReleaseGPU();
 
+        // ============================================================
+        // 流式上传（可增长缓冲区）
+        // ============================================================
+
+        /**
+         * @brief 创建空的可增长缓冲区：顶点布局、材质颜色和纹理路径取自 layout（其顶点 / 索引数据被忽略）
+         * @param vertexCapacity / indexCapacity 初始容量（元素个数，不足时按 2 倍增长）
+         * @note VAO 立即可用（GetVAO() != 0），渲染器可以马上 Initialize，之后绘制已追加的部分
+         * @note 不支持量化布局（每块的量化范围不同，而反量化参数是整个 VAO 一份）
+         */
+        bool BeginStreaming(const MeshData& layout, size_t vertexCapacity = 65536, size_t indexCapacity = 3 * 65536);
+
+        /**
+         * @brief 追加一块索引网格（块内局部索引，顶点数 ≤ 65536），写入 16 位索引缓冲区的末尾
+         * @return 未 BeginStreaming、布局不一致或块过大时返回 false
+         *
+         * - ✅ 与上一段的顶点跨度不超过 65536 时并入上一段（索引加上段内偏移），否则新开一段（baseVertex = 已有顶点数）
+         * - ✅ 容量不足时在 GPU 上复制旧数据并保持缓冲区名不变，已创建的 VAO（包括渲染器自有的）继续有效
+         * - ⚠️ 不保留 CPU 数据副本：GetData() 只有布局，没有顶点 / 索引（也就没有簇和 LOD）
+         */
+        bool AppendToGPU(const MeshData& chunk);
+
+        /**
+         * @brief 是否为流式缓冲区（BeginStreaming 之后，直到 ReleaseGPU / UploadToGPU）
+         */
+        bool IsStreaming() const { return m_streaming; }
+
         // ============================================================
         // 访问接口
         // ============================================================
@@ -106,20 +150,55 @@ namespace Renderer
          */
         void BindBuffersToVAO() const;
 
+        /**
+         * @brief 创建一个引用本网格 VBO/EBO 的新 VAO（顶点属性、反量化参数已配置）
+         * @return 新 VAO，由调用者负责 glDeleteVertexArrays；网格未上传时返回 0
+         * @note 多个 InstancedRenderer 共享同一网格时，各自在自己的 VAO 上配置实例属性
+         */
+        unsigned int CreateVertexArray() const;
+
         /**
          * @brief 获取顶点数量
          */
-        size_t GetVertexCount() const { return m_data.GetVertexCount(); }
+        size_t GetVertexCount() const { return m_streaming ? m_streamVertexCount : m_data.GetVertexCount(); }
 
         /**
          * @brief 获取索引数量
          */
-        size_t GetIndexCount() const { return m_data.GetIndexCount(); }
+        size_t GetIndexCount() const { return m_streaming ? m_streamIndexCount : m_data.GetIndexCount(); }
 
         /**
          * @brief 是否有索引
          */
-        bool HasIndices() const { return m_data.HasIndices(); }
+        bool HasIndices() const { return GetIndexCount() > 0; }
+
+        /**
+         * @brief GPU 索引类型（GL_UNSIGNED_BYTE / GL_UNSIGNED_SHORT / GL_UNSIGNED_INT），上传时按网格选择
+         */
+        unsigned int GetIndexType() const { return m_indexType; }
+
+        /**
+         * @brief 索引绘制范围（未分段时只有一段，baseVertex = 0）
+         */
+        const std::vector<IndexDrawRange>& GetIndexRanges() const { return m_indexRanges; }
+
+        /**
+         * @brief 把索引区间 [firstIndex, firstIndex + indexCount) 按索引分段切开并追加到 out（附带各段 baseVertex）
+         * @note 区间端点应落在三角形边界上（分段总在三角形边界切分）
+         */
+        void AppendDrawRanges(size_t firstIndex, size_t indexCount, std::vector<IndexDrawRange>& out) const;
+
+        /**
+         * @brief GPU 端索引缓冲区字节数
+         */
+        size_t GetIndexBufferSizeBytes() const;
+
+        /**
+         * @brief 允许 ≤ 256 个顶点的网格使用 8 位索引（全局设置，影响之后的 UploadToGPU）
+         * @note 默认关闭：部分 GPU 不原生支持 8 位索引，驱动会在内部转换
+         */
+        static void SetByteIndicesEnabled(bool enabled) { s_byteIndicesEnabled = enabled; }
+        static bool IsByteIndicesEnabled() { return s_byteIndicesEnabled; }
 
         /**
          * @brief 获取材质颜色
@@ -162,6 +241,19 @@ namespace Renderer
         unsigned int m_vao = 0;
         unsigned int m_vbo = 0;
         unsigned int m_ebo = 0;
+        unsigned int m_dequantVBO = 0;  // 位置反量化参数（仅量化网格）
+
+        // 索引格式
+        unsigned int m_indexType = GL_UNSIGNED_INT;
+        std::vector<IndexDrawRange> m_indexRanges;
+        static bool s_byteIndicesEnabled;
+
+        // 流式缓冲区（元素个数）
+        bool m_streaming = false;
+        size_t m_streamVertexCount = 0;
+        size_t m_streamIndexCount = 0;
+        size_t m_vertexCapacity = 0;
+        size_t m_indexCapacity = 0;
 
         // 纹理（使用 shared_ptr 管理所有权）
         std::shared_ptr<Texture> m_texture;
@@ -170,7 +262,11 @@ namespace Renderer
         void CreateVAO();
         void UploadVertexData();
         void UploadIndexData();
-        void SetupVertexAttributes();
+        void SetupVertexAttributes() const;
+        void SetupDequantization();
+        void BindDequantizationAttributes() const;
+        bool BuildShortIndexRanges(const unsigned int* indices, size_t indexCount, unsigned int maxIndex);
+        static void GrowBuffer(unsigned int buffer, size_t usedBytes, size_t capacityBytes);
     };
 
 } // namespace Renderer
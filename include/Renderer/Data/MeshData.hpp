@@ -1,12 +1,29 @@
 #pragma once
+#include "Renderer/Data/Meshlet.hpp"
 #include "Core/GLM.hpp"
 #include <vector>
 #include <string>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 
 namespace Renderer
 {
 
+    /**
+     * @brief 顶点属性的存储类型
+     *
+     * 顶点数据始终按 4 字节字（float）为单位存放，偏移和步长都以字为单位；
+     * 非 Float 类型的属性以打包形式占用一个或多个字（见 MeshQuantizer）。
+     */
+    enum class VertexAttributeType : uint8_t
+    {
+        Float,              // GL_FLOAT
+        HalfFloat,          // GL_HALF_FLOAT
+        Short,              // GL_SHORT，归一化到 [-1, 1]
+        Int2_10_10_10_Rev   // GL_INT_2_10_10_10_REV，归一化到 [-1, 1]（size 必须为 4）
+    };
+
     /**
      * @class MeshData
      * @brief 纯数据容器 - 存储网格的顶点和索引数据（CPU 内存）
@@ -16,6 +33,7 @@ namespace Renderer
      * - ✅ 无 GPU 资源（无 VAO/VBO/EBO）
      * - ✅ 无渲染能力（无 Draw/Render）
      * - ✅ 可序列化，可传递，可复制
+     * - ✅ 支持外部数据视图（例如内存映射的 .lmesh 缓存），拷贝时共享 owner 而不复制数据
      *
      * 使用场景：
      * - 作为数据交换格式
@@ -60,6 +78,21 @@ namespace Renderer
          */
         void SetIndices(std::vector<unsigned int>&& indices);
 
+        /**
+         * @brief 引用外部顶点数据（不拷贝）
+         * @param data 顶点数据起始地址，生命周期由 owner 保证
+         * @param floatCount float 总数
+         * @param stride 每个顶点的 float 数量
+         * @param owner 持有数据所在内存的对象（例如 MeshCache），与 MeshData 副本共享
+         * @note 视图模式下 GetVertices() 为空，请使用 GetVertexData()
+         */
+        void SetVertexView(const float* data, size_t floatCount, size_t stride, std::shared_ptr<const void> owner);
+
+        /**
+         * @brief 引用外部索引数据（不拷贝），约定同 SetVertexView
+         */
+        void SetIndexView(const unsigned int* data, size_t count, std::shared_ptr<const void> owner);
+
         /**
          * @brief 设置顶点属性布局
          * @param offsets 每个属性在顶点中的偏移（float 索引）
@@ -71,6 +104,36 @@ namespace Renderer
          */
         void SetVertexLayout(const std::vector<size_t>& offsets, const std::vector<int>& sizes);
 
+        /**
+         * @brief 设置顶点属性布局（显式指定 shader location）
+         * @param locations 每个属性的 location
+         *
+         * 用于跳过实例化属性占用的 location 3-7，例如：
+         * 位置(0) + 法线(1) + UV(2) + 材质层(8)
+         */
+        void SetVertexLayout(const std::vector<size_t>& offsets, const std::vector<int>& sizes,
+                             const std::vector<unsigned int>& locations);
+
+        /**
+         * @brief 设置顶点属性布局（显式指定 location 和存储类型）
+         * @param types 每个属性的存储类型（偏移仍以 4 字节字为单位）
+         */
+        void SetVertexLayout(const std::vector<size_t>& offsets, const std::vector<int>& sizes,
+                             const std::vector<unsigned int>& locations,
+                             const std::vector<VertexAttributeType>& types);
+
+        /**
+         * @brief 设置位置反量化参数（位置 = 量化值 * scale + offset）
+         * @note 由 MeshQuantizer 设置；MeshBuffer 通过 location 10/11 的常量属性传给着色器
+         */
+        void SetPositionDequantization(const glm::vec3& scale, const glm::vec3& offset);
+
+        /**
+         * @brief 设置网格簇（MeshletBuilder），簇引用当前索引缓冲区中的区间
+         * @note 重新设置索引时簇会被清空
+         */
+        void SetMeshlets(std::vector<Meshlet>&& meshlets) { m_meshlets = std::move(meshlets); }
+
         /**
          * @brief 设置材质颜色
          */
@@ -81,22 +144,57 @@ namespace Renderer
          */
         void SetTexturePath(const std::string& path) { m_texturePath = path; }
 
+        /**
+         * @brief 设置所属纹理数组（MaterialAtlas 分辨率档位索引，-1 表示不使用纹理数组）
+         */
+        void SetTextureArrayIndex(int index) { m_textureArrayIndex = index; }
+
         // ============================================================
         // 数据访问接口
         // ============================================================
 
         const std::vector<float>& GetVertices() const { return m_vertices; }
         const std::vector<unsigned int>& GetIndices() const { return m_indices; }
+
+        /**
+         * @brief 顶点/索引数据指针（同时适用于自有数据和外部视图）
+         */
+        const float* GetVertexData() const { return m_vertexView ? m_vertexView : m_vertices.data(); }
+        const unsigned int* GetIndexData() const { return m_indexView ? m_indexView : m_indices.data(); }
+        bool IsView() const { return m_vertexView != nullptr || m_indexView != nullptr; }
+
         size_t GetVertexStride() const { return m_vertexStride; }
         size_t GetVertexCount() const { return m_vertexCount; }
         size_t GetIndexCount() const { return m_indexCount; }
-        bool HasIndices() const { return !m_indices.empty(); }
+        bool HasIndices() const { return m_indexCount > 0; }
         const glm::vec3& GetMaterialColor() const { return m_materialColor; }
         const std::string& GetTexturePath() const { return m_texturePath; }
+        int GetTextureArrayIndex() const { return m_textureArrayIndex; }
 
         const std::vector<size_t>& GetAttributeOffsets() const { return m_attributeOffsets; }
         const std::vector<int>& GetAttributeSizes() const { return m_attributeSizes; }
 
+        /**
+         * @brief 获取第 i 个属性的 location（未显式设置时为 i）
+         */
+        unsigned int GetAttributeLocation(size_t i) const {
+            return i < m_attributeLocations.size() ? m_attributeLocations[i] : static_cast<unsigned int>(i);
+        }
+
+        /**
+         * @brief 获取第 i 个属性的存储类型（未显式设置时为 Float）
+         */
+        VertexAttributeType GetAttributeType(size_t i) const {
+            return i < m_attributeTypes.size() ? m_attributeTypes[i] : VertexAttributeType::Float;
+        }
+
+        const std::vector<Meshlet>& GetMeshlets() const { return m_meshlets; }
+        bool HasMeshlets() const { return !m_meshlets.empty(); }
+
+        bool IsPositionQuantized() const { return m_positionQuantized; }
+        const glm::vec3& GetPositionScale() const { return m_positionScale; }
+        const glm::vec3& GetPositionOffset() const { return m_positionOffset; }
+
         // ============================================================
         // 工具方法
         // ============================================================
@@ -109,20 +207,27 @@ namespace Renderer
         /**
          * @brief 检查是否为空
          */
-        bool IsEmpty() const { return m_vertices.empty(); }
+        bool IsEmpty() const { return m_vertexCount == 0; }
+
+        /**
+         * @brief 计算包围球半径（以模型原点为球心，假设位置位于第一个属性）
+         * @note 用于屏幕空间尺寸估算（纹理流送、LOD 选择）
+         * @note 支持 Float 和量化（Short）位置
+         */
+        float ComputeBoundingRadius() const;
 
         /**
          * @brief 计算顶点数据的字节大小
          */
         size_t GetVertexDataSizeBytes() const {
-            return m_vertices.size() * sizeof(float);
+            return m_vertexCount * m_vertexStride * sizeof(float);
         }
 
         /**
          * @brief 计算索引数据的字节大小
          */
         size_t GetIndexDataSizeBytes() const {
-            return m_indices.size() * sizeof(unsigned int);
+            return m_indexCount * sizeof(unsigned int);
         }
 
     private:
@@ -133,13 +238,29 @@ namespace Renderer
         size_t m_vertexCount = 0;
         size_t m_indexCount = 0;
 
+        // 外部数据视图（非空时优先于 m_vertices / m_indices）
+        const float* m_vertexView = nullptr;
+        const unsigned int* m_indexView = nullptr;
+        std::shared_ptr<const void> m_viewOwner;  // 保证视图内存有效
+
         // 材质数据
         glm::vec3 m_materialColor = glm::vec3(1.0f);
         std::string m_texturePath;  // 纹理路径
+        int m_textureArrayIndex = -1;  // 纹理数组索引（MaterialAtlas）
 
         // 顶点属性布局
         std::vector<size_t> m_attributeOffsets;  // 每个属性的偏移（float 索引）
         std::vector<int> m_attributeSizes;       // 每个属性的大小（float 数量）
+        std::vector<unsigned int> m_attributeLocations;  // 每个属性的 location（为空时按顺序）
+        std::vector<VertexAttributeType> m_attributeTypes;  // 每个属性的存储类型（为空时均为 Float）
+
+        // 网格簇（逐簇剔除）
+        std::vector<Meshlet> m_meshlets;
+
+        // 位置反量化（MeshQuantizer）
+        bool m_positionQuantized = false;
+        glm::vec3 m_positionScale = glm::vec3(1.0f);
+        glm::vec3 m_positionOffset = glm::vec3(0.0f);
     };
 
 } // namespace Renderer
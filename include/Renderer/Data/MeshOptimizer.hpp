@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Renderer
+{
+    class MeshData;
+
+    /**
+     * @struct MeshOptimizerConfig
+     * @brief 导入时网格优化参数
+     */
+    struct MeshOptimizerConfig
+    {
+        uint32_t cacheSize = 16;          // 模拟的变换后顶点缓存大小（FIFO）
+        float overdrawThreshold = 1.05f;  // 过度绘制聚类允许的 ACMR 恶化比例（1.0 = 不允许）
+        size_t positionOffset = 0;        // 位置属性在顶点中的 float 偏移
+        bool optimizeVertexCache = true;  // 1. Tipsify 三角形重排
+        bool optimizeOverdraw = true;     // 2. 视角无关的聚类排序
+        bool optimizeVertexFetch = true;  // 3. 顶点按首次使用顺序重排
+    };
+
+    /**
+     * @struct VertexCacheStatistics
+     * @brief 顶点缓存模拟结果
+     */
+    struct VertexCacheStatistics
+    {
+        size_t triangleCount = 0;
+        size_t vertexCount = 0;
+        size_t transformedVertices = 0;  // 缓存未命中次数（需要执行顶点着色器的次数）
+        float acmr = 0.0f;               // 平均每三角形未命中数（0.5 ~ 3，越低越好）
+        float atvr = 0.0f;               // 未命中数 / 顶点数（1.0 为最优）
+    };
+
+    /**
+     * @class MeshOptimizer
+     * @brief 索引网格的导入时优化（纯 CPU，不依赖 OpenGL）
+     *
+     * 三个步骤依次执行：
+     * - ✅ 顶点缓存：Tipsify（Sander 等，2007）按顶点扇形输出三角形，提高变换后缓存命中率
+     * - ✅ 过度绘制：按缓存失效点切分聚类，聚类内保持缓存顺序，聚类间按“朝外程度”降序排列，
+     *      使外表面先绘制、被遮挡的内部三角形更容易被深度测试剔除（与视角无关）
+     * - ✅ 顶点获取：顶点按首次被索引的顺序重排（未被引用的顶点被移除），提高顶点拉取的内存局部性
+     *
+     * OBJModel 在导入时对每个材质的数据调用 Optimize()，结果随 .lmesh 缓存保存。
+     */
+    class MeshOptimizer
+    {
+    public:
+        MeshOptimizer() = delete;
+
+        /**
+         * @brief 依次执行配置中启用的三个步骤
+         * @param vertices 交错顶点数据（会被重排，顶点数可能减少）
+         * @param stride 每个顶点的 float 数量
+         * @param indices 三角形列表索引（原地重排）
+         * @param before / after 可选：优化前后的顶点缓存统计
+         */
+        static void Optimize(std::vector<float>& vertices, size_t stride, std::vector<unsigned int>& indices,
+                             const MeshOptimizerConfig& config = {}, VertexCacheStatistics* before = nullptr,
+                             VertexCacheStatistics* after = nullptr);
+
+        /**
+         * @brief 优化 MeshData（外部视图会先拷贝为自有数据），并记录优化前后的 ACMR / ATVR
+         * @return 没有索引或顶点数据时返回 false
+         */
+        static bool Optimize(MeshData& mesh, const MeshOptimizerConfig& config = {});
+
+        /**
+         * @brief Tipsify 三角形重排
+         */
+        static void OptimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount, uint32_t cacheSize);
+
+        /**
+         * @brief 过度绘制聚类排序（输入应为已做顶点缓存优化的索引）
+         */
+        static void OptimizeOverdraw(std::vector<unsigned int>& indices, const float* vertices, size_t vertexCount,
+                                     size_t stride, size_t positionOffset, uint32_t cacheSize, float threshold);
+
+        /**
+         * @brief 顶点按首次使用顺序重排，并改写索引
+         * @return 重排后的顶点数
+         */
+        static size_t OptimizeVertexFetch(std::vector<float>& vertices, size_t stride, std::vector<unsigned int>& indices);
+
+        /**
+         * @brief 模拟 FIFO 变换后顶点缓存
+         */
+        static VertexCacheStatistics AnalyzeVertexCache(const unsigned int* indices, size_t indexCount,
+                                                        size_t vertexCount, uint32_t cacheSize);
+    };
+
+} // namespace Renderer
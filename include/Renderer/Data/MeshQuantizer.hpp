@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Renderer/Data/MeshData.hpp"
+#include <cstdint>
+
+namespace Renderer
+{
+
+    /**
+     * @class MeshQuantizer
+     * @brief 导入时顶点量化：8 个 float（32 字节）→ 4 个字（16 字节）
+     *
+     * 量化布局（每个字 4 字节，其余属性原样追加在后面）：
+     * - 字 0-1：位置，3 x GL_SHORT 归一化 + 1 个填充；按网格包围盒映射到 [-1, 1]，
+     *           反量化参数（scale = 半尺寸，offset = 中心）存入 MeshData，由 MeshBuffer 传给着色器
+     * - 字 2  ：法线，GL_INT_2_10_10_10_REV 归一化（w = 0），着色器中直接作为 vec3 读取
+     * - 字 3  ：UV，2 x GL_HALF_FLOAT
+     *
+     * 精度：位置误差 ≤ 包围盒尺寸 / 65534；法线约 0.1°；UV 为半精度（|uv| < 2048 时误差 < 1/1024）
+     *
+     * @note 只处理前三个属性为 位置(3) / 法线(3) / UV(2) 的 float 布局（OBJ 和图集布局均满足）
+     * @note 应在 MeshOptimizer 之后调用（优化器按 float 读取位置）
+     */
+    class MeshQuantizer
+    {
+    public:
+        MeshQuantizer() = delete;
+
+        static constexpr size_t kQuantizedWords = 4;  // 位置 + 法线 + UV 量化后占用的字数
+
+        /**
+         * @brief 原地量化 MeshData
+         * @return 布局不符合要求或已量化时返回 false（数据保持不变）
+         */
+        static bool Quantize(MeshData& mesh);
+
+        /**
+         * @brief 为已是量化布局的顶点（例如 .lmesh 映射）设置属性布局和反量化参数，不做转换
+         * @note 只描述位置 / 法线 / UV 三个属性（location 0-2），与 Quantize 无额外属性时的结果一致
+         */
+        static void SetQuantizedLayout(MeshData& mesh, const glm::vec3& scale, const glm::vec3& offset);
+
+        /**
+         * @brief float → IEEE 754 binary16（舍入到最近，超出范围时饱和到 ±65504）
+         */
+        static uint16_t FloatToHalf(float value);
+
+        /**
+         * @brief 单位向量 → 10:10:10:2 有符号归一化（w = 0）
+         */
+        static uint32_t PackNormal(const glm::vec3& normal);
+    };
+
+} // namespace Renderer
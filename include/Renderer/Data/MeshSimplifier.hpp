@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Renderer/Data/MeshData.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace Renderer
+{
+
+    /**
+     * @struct MeshLODConfig
+     * @brief LOD 链生成参数
+     */
+    struct MeshLODConfig
+    {
+        size_t levelCount = 4;           // 总层级数（含原始网格 LOD0），3~5 较合适
+        float reductionPerLevel = 0.5f;  // 每级目标三角形数相对上一级的比例
+        float maxError = 0.02f;          // 每级允许的最大几何误差（相对包围盒最大边长）
+        float minReduction = 0.85f;      // 某级三角形数超过上一级的该比例时停止（通常是边界锁定导致无法继续简化）
+    };
+
+    /**
+     * @class MeshSimplifier
+     * @brief 二次误差度量（QEM，Garland & Heckbert 1997）网格简化，纯 CPU
+     *
+     * 实现要点：
+     * - ✅ 只改写索引，顶点数据不变：折叠 u → v 时 v 必须是已有顶点（半边折叠），
+     *      因此 UV / 材质属性无需插值，同一份顶点数据可被所有层级共用
+     * - ✅ 每轮为所有边计算折叠代价并排序，执行一组互不相邻的折叠后重建邻接，直到达到目标或误差上限
+     * - ✅ 边界边（只属于一个三角形）的端点被锁定：网格开口以及 UV / 材质接缝（顶点被拆分处）保持不变
+     * - ✅ 拒绝会使相邻三角形法线翻转的折叠
+     *
+     * 误差以包围盒最大边长归一化，与网格尺寸无关。
+     */
+    class MeshSimplifier
+    {
+    public:
+        MeshSimplifier() = delete;
+
+        /**
+         * @brief 简化三角形列表
+         * @param vertices 交错顶点数据（位置为 float）
+         * @param stride 每个顶点的 float 数量
+         * @param positionOffset 位置属性的 float 偏移
+         * @param targetIndexCount 目标索引数（达到或误差超限时停止）
+         * @param targetError 允许的最大误差（相对包围盒最大边长）
+         * @param resultError 可选：实际产生的最大误差（相对）
+         * @return 简化后的索引（引用原顶点）
+         */
+        static std::vector<unsigned int> Simplify(const float* vertices, size_t vertexCount, size_t stride,
+                                                  size_t positionOffset, const unsigned int* indices,
+                                                  size_t indexCount, size_t targetIndexCount, float targetError,
+                                                  float* resultError = nullptr);
+
+        /**
+         * @brief 生成 LOD 链
+         * @param mesh LOD0（float 位置、带索引；会被移入返回值的第 0 项）
+         * @return 各级网格，第 0 项为原网格；低级别只保留被引用的顶点并重新做缓存优化
+         * @note 应在 MeshQuantizer 之前调用；不满足条件（已量化 / 无索引）时只返回原网格
+         */
+        static std::vector<MeshData> BuildLODChain(MeshData mesh, const MeshLODConfig& config = {});
+    };
+
+} // namespace Renderer
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Core/GLM.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Renderer
+{
+    class MeshData;
+
+    /**
+     * @struct Meshlet
+     * @brief 网格簇：索引缓冲区中连续的一段三角形 + 剔除用包围体（模型空间）
+     */
+    struct Meshlet
+    {
+        uint32_t firstIndex = 0;      // 在网格索引缓冲区中的起始索引
+        uint32_t triangleCount = 0;
+        uint32_t vertexCount = 0;     // 引用的不同顶点数
+
+        glm::vec3 center = glm::vec3(0.0f);   // 包围球
+        float radius = 0.0f;
+
+        // 法线锥：dot(normalize(coneApex - cameraPos), coneAxis) >= coneCutoff 时整簇背向摄像机
+        glm::vec3 coneApex = glm::vec3(0.0f);
+        glm::vec3 coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+        float coneCutoff = 1.0f;      // 1 表示法线分布过宽，不做背面剔除
+    };
+
+    /**
+     * @class MeshletBuilder
+     * @brief 导入时把网格切分为簇（纯 CPU，不依赖 OpenGL）
+     *
+     * 按现有三角形顺序贪心扫描：三角形顺序已由 MeshOptimizer 优化为局部连续，
+     * 因此每个簇在空间上紧凑，且在索引缓冲区中连续 —— 剔除后可直接以索引区间绘制，无需重写索引。
+     *
+     * @note 位置必须为 float，应在 MeshQuantizer 之前调用
+     */
+    class MeshletBuilder
+    {
+    public:
+        MeshletBuilder() = delete;
+
+        static constexpr size_t kMaxVertices = 64;
+        static constexpr size_t kMaxTriangles = 124;
+        static constexpr size_t kMinTriangles = 4096;  // 小于该三角形数的网格不值得逐簇剔除
+
+        /**
+         * @brief 切分网格并计算每个簇的包围球和法线锥
+         * @return 簇列表；网格没有索引或位置不是 float 时为空
+         */
+        static std::vector<Meshlet> Build(const MeshData& mesh, size_t maxVertices = kMaxVertices,
+                                          size_t maxTriangles = kMaxTriangles);
+    };
+
+} // namespace Renderer
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "Renderer/Resources/Shader.hpp"
+#include "Renderer/Environment/SphericalHarmonics.hpp"
 #include "Core/GLM.hpp"
 #include <memory>
 
 namespace Renderer
 {
+    class Skybox;
 
     /**
      * AmbientLighting 类 - 轻量级环境光照系统
@@ -15,6 +17,7 @@ namespace Renderer
      * - 与Phong光照系统完美兼容
      * - 不需要HDR或PBR，使用普通纹理即可
      * - 支持半球光照（hemisphere lighting）
+     * - ⭐ 球谐（SH9）漫反射环境光：加载时投影一次，逐片元只需几次乘加，无纹理采样
      *
      * 使用场景：
      * - 让物体的暗部显示天空盒的颜色
@@ -45,6 +48,12 @@ namespace Renderer
          */
         bool LoadFromSkybox(unsigned int skyboxTextureID, float intensity = 0.3f);
 
+        /**
+         * 从天空盒创建环境光照，SH 系数按天空盒源文件缓存到磁盘
+         * ⭐ 缓存文件：<第一个面>.sh9（键为 Skybox::GetSourceKey()），源文件变化时自动重新投影
+         */
+        bool LoadFromSkybox(const Skybox& skybox, float intensity = 0.3f);
+
         /**
          * 应用环境光设置到着色器
          * @param shader 目标着色器
@@ -75,7 +84,8 @@ namespace Renderer
         {
             SOLID_COLOR,    // 固定颜色（传统Phong）
             SKYBOX_SAMPLE,  // 从天空盒采样
-            HEMISPHERE       // 半球光照（天空/地面渐变）
+            HEMISPHERE,      // 半球光照（天空/地面渐变）
+            SPHERICAL_HARMONICS // 球谐辐照度（UniformBinding::AMBIENT_SH）
         };
 
         void SetMode(Mode mode) { m_mode = mode; }
@@ -97,15 +107,28 @@ namespace Renderer
          */
         bool IsLoaded() const { return m_skyboxTextureID != 0; }
 
+        /**
+         * 球谐辐照度是否可用（SPHERICAL_HARMONICS 模式需要）
+         */
+        bool HasIrradiance() const { return m_shUBO != 0; }
+        const GPUSHIrradiance& GetIrradiance() const { return m_irradiance; }
+
     private:
         void BindTexture(unsigned int textureUnit) const;  // 绑定天空盒纹理
 
+        // 投影（或读取缓存）并上传 SH 系数；cachePath 为空时不使用缓存
+        bool ComputeIrradiance(const std::string& cachePath, uint64_t cacheKey);
+        void UploadIrradiance();
+        void ReleaseIrradiance();
+
         unsigned int m_skyboxTextureID;  // 天空盒纹理ID（不拥有所有权）
         float m_intensity;               // 环境光强度
         bool m_enabled;                  // 是否启用
         Mode m_mode;                     // 环境光模式
         glm::vec3 m_skyColor;            // 半球光照天空颜色
         glm::vec3 m_groundColor;         // 半球光照地面颜色
+        GPUSHIrradiance m_irradiance;    // 球谐辐照度系数（std140）
+        unsigned int m_shUBO;            // AmbientSH uniform buffer
     };
 
 } // namespace Renderer
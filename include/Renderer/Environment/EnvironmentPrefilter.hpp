@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Renderer/Resources/Shader.hpp"
+#include "Renderer/Resources/TextureCompression.hpp"
+#include "Renderer/Resources/TextureUnits.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Renderer
+{
+    class Skybox;
+
+    /**
+     * @struct EnvironmentPrefilterConfig
+     * @brief 预滤波参数（任一项变化都会使磁盘缓存失效）
+     */
+    struct EnvironmentPrefilterConfig
+    {
+        uint32_t size = 128;            // 预滤波立方体贴图第 0 级边长
+        uint32_t mipCount = 6;          // 粗糙度级数（mip i 的粗糙度 = i / (mipCount - 1)）
+        uint32_t sampleCount = 256;     // 每个 texel 的 GGX 重要性采样数
+        uint32_t lutSize = 128;         // BRDF LUT 边长
+        uint32_t lutSampleCount = 512;  // BRDF LUT 每个 texel 的采样数
+        bool useGPU = true;             // false = 强制 CPU 路径（无着色器时自动回退）
+        std::string shaderDirectory = "assets/shader/";
+    };
+
+    /**
+     * @class EnvironmentPrefilter
+     * @brief 镜面反射 IBL 预计算：GGX 预滤波立方体贴图 + split-sum BRDF LUT
+     *
+     * 设计方案：
+     * - ✅ 预滤波立方体贴图的每个 mip 对应一个粗糙度，着色器中 textureLod(R, roughness * maxLod) 一次采样
+     * - ✅ BRDF LUT（RG16F）以 (N·V, roughness) 为坐标存储 F0 的缩放和偏移，再一次采样
+     * - ✅ 默认通过 FBO 逐面逐级渲染生成；着色器不可用或 useGPU = false 时在 CPU 上用 Core::ThreadPool 计算
+     * - ✅ 结果读回为半精度并缓存为 DDS：<第一个面>.prefilter.dds（键为 Skybox::GetSourceKey() + 参数）和 brdf_lut.dds
+     * - ⚠️ Generate() 会改变 FBO/视口等 GL 状态，完成后恢复；需在 GL 线程调用
+     */
+    class EnvironmentPrefilter
+    {
+    public:
+        EnvironmentPrefilter() = default;
+        ~EnvironmentPrefilter();
+
+        // 禁止拷贝，允许移动
+        EnvironmentPrefilter(const EnvironmentPrefilter&) = delete;
+        EnvironmentPrefilter& operator=(const EnvironmentPrefilter&) = delete;
+        EnvironmentPrefilter(EnvironmentPrefilter&& other) noexcept;
+        EnvironmentPrefilter& operator=(EnvironmentPrefilter&& other) noexcept;
+
+        /**
+         * @brief 为天空盒生成（或从缓存加载）预滤波贴图和 BRDF LUT
+         */
+        bool Generate(const Skybox& skybox, const EnvironmentPrefilterConfig& config = {});
+
+        /**
+         * @brief 为任意立方体贴图生成；cacheName 为空时不使用缓存（缓存写入 cacheDirectory/<cacheName>.prefilter.dds）
+         */
+        bool Generate(unsigned int cubemapTextureID, const std::string& cacheDirectory, const std::string& cacheName,
+                      uint64_t cacheKey, const EnvironmentPrefilterConfig& config = {});
+
+        /**
+         * @brief 绑定预滤波贴图和 BRDF LUT 到纹理单元
+         */
+        void Bind(TextureUnit prefilteredUnit = TextureUnit::ENVIRONMENT_PREFILTERED,
+                  TextureUnit lutUnit = TextureUnit::BRDF_LUT) const;
+
+        /**
+         * @brief 绑定纹理并设置 prefilteredEnv / brdfLUT / prefilterMaxLod / usePrefilteredEnv
+         */
+        void ApplyToShader(Shader& shader) const;
+
+        bool IsLoaded() const { return m_prefilteredTextureID != 0 && m_brdfLUTTextureID != 0; }
+        unsigned int GetPrefilteredTextureID() const { return m_prefilteredTextureID; }
+        unsigned int GetBRDFLUTTextureID() const { return m_brdfLUTTextureID; }
+        uint32_t GetMipCount() const { return m_mipCount; }
+
+        /**
+         * @brief CPU 预滤波（纯计算，不依赖 GL，可用于无窗口测试）
+         * @param faces 6 个 RGBA8 面（OpenGL 面顺序和行序），每个 faceSize x faceSize
+         * @param outImage RGBA16F 立方体贴图，mipCount = config.mipCount
+         */
+        static bool PrefilterCubemapCPU(const std::vector<std::vector<uint8_t>>& faces, uint32_t faceSize,
+                                        const EnvironmentPrefilterConfig& config, CompressedImage& outImage);
+
+        /**
+         * @brief CPU 计算 split-sum BRDF LUT（RG16F，x = N·V，y = 粗糙度，行 0 对应粗糙度 0）
+         */
+        static void ComputeBRDFLUTCPU(uint32_t size, uint32_t sampleCount, CompressedImage& outImage);
+
+    private:
+        bool GeneratePrefilteredGPU(unsigned int cubemapTextureID, const EnvironmentPrefilterConfig& config);
+        bool GeneratePrefilteredCPU(unsigned int cubemapTextureID, const EnvironmentPrefilterConfig& config);
+        bool GenerateBRDFLUTGPU(const EnvironmentPrefilterConfig& config);
+
+        // 读回当前 GL 纹理为半精度图像（用于写缓存）
+        bool ReadBackPrefiltered(CompressedImage& outImage) const;
+        bool ReadBackBRDFLUT(CompressedImage& outImage) const;
+
+        bool UploadPrefiltered(const CompressedImage& image);
+        bool UploadBRDFLUT(const CompressedImage& image);
+
+        void Release();
+
+        unsigned int m_prefilteredTextureID = 0;  // GL_TEXTURE_CUBE_MAP，RGBA16F
+        unsigned int m_brdfLUTTextureID = 0;      // GL_TEXTURE_2D，RG16F
+        uint32_t m_size = 0;                      // 预滤波第 0 级边长
+        uint32_t m_lutSize = 0;                   // LUT 边长
+        uint32_t m_mipCount = 0;                  // 预滤波 mip 数
+    };
+
+} // namespace Renderer
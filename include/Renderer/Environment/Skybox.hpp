@@ -3,7 +3,9 @@
 #include "Renderer/Resources/Shader.hpp"
 #include "Renderer/Environment/SkyboxLoader.hpp"
 #include "Core/GLM.hpp"
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace Renderer
 {
@@ -36,6 +38,7 @@ namespace Renderer
 
         /**
          * 从6个纹理文件加载天空盒
+         * ⭐ 若6个面都存在预编码的 .dds（或直接传入 .dds 路径），直接上传压缩数据和 mip 链
          */
         bool Load(
             const std::string& right,
@@ -46,6 +49,19 @@ namespace Renderer
             const std::string& front
         );
 
+        /**
+         * 从6个纹理文件加载天空盒（OpenGL 顺序：+X, -X, +Y, -Y, +Z, -Z）
+         *
+         * 加载顺序：
+         * 1. 每个面都有预编码 .dds → 直接上传
+         * 2. 源图像旁的立方体贴图缓存（<第一个面>.cubemap.dds）且未过期 → 直接上传
+         * 3. 在 Core::ThreadPool 上并行解码6个面，主线程按完成顺序上传，随后在后台写入缓存
+         *
+         * @param flipVertically 是否垂直翻转（线程局部设置，不影响其他纹理加载）
+         * @param generateMipmaps 是否生成 mip 链
+         */
+        bool Load(const std::vector<std::string>& faces, bool flipVertically = false, bool generateMipmaps = false);
+
         /**
          * 从配置加载天空盒
          * @param config 天空盒配置（支持多种约定）
@@ -80,6 +96,13 @@ namespace Renderer
          */
         bool IsLoaded() const { return m_textureID != 0 && m_isInitialized; }
 
+        /**
+         * 获取源文件路径（OpenGL 面顺序）和缓存键
+         * ⭐ 由天空盒派生的数据（例如环境光 SH 系数）可用此键判断缓存是否过期
+         */
+        const std::vector<std::string>& GetSourceFiles() const { return m_sourceFiles; }
+        uint64_t GetSourceKey() const { return m_sourceKey; }
+
         /**
          * 设置旋转角度
          */
@@ -96,11 +119,34 @@ namespace Renderer
         unsigned int m_VAO, m_VBO;
         bool m_isInitialized;
         float m_rotation;  // 天空盒旋转角度（度）
+        std::vector<std::string> m_sourceFiles;  // 源文件（OpenGL 面顺序）
+        uint64_t m_sourceKey = 0;                // 源文件 + 加载选项的哈希
 
         /**
          * 创建天空盒的立方体网格
          */
         void CreateCubeMesh();
+
+        /**
+         * 尝试从预编码 DDS 加载6个面
+         * @return 所有面都找到且格式一致时返回 true；否则不修改状态，由调用者回退到解码路径
+         */
+        bool LoadCompressedFaces(const std::vector<std::string>& faces);
+
+        /**
+         * 尝试从立方体贴图缓存加载（userKey 与源文件不一致时视为过期）
+         */
+        bool LoadCachedCubemap(const std::string& cachePath, uint64_t cacheKey);
+
+        /**
+         * 在工作线程上编码6个面并写入缓存（编码格式按内容选择，GL 不支持时使用 RGBA8）
+         */
+        void WriteCubemapCacheAsync(const std::string& cachePath, uint64_t cacheKey,
+                                    std::vector<std::vector<uint8_t>> faces, uint32_t size,
+                                    int channels, bool generateMipmaps);
+
+        static std::string GetCubemapCachePath(const std::vector<std::string>& faces);
+        static uint64_t ComputeCubemapCacheKey(const std::vector<std::string>& faces, bool flipVertically, bool generateMipmaps);
     };
 
 } // namespace Renderer
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Core/GLM.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace Renderer
+{
+
+    /**
+     * @struct SH9Color
+     * @brief 三阶（9 项）球谐系数，RGB 各一组
+     *
+     * 系数顺序：Y00, Y1-1, Y10, Y11, Y2-2, Y2-1, Y20, Y21, Y22
+     */
+    struct SH9Color
+    {
+        std::array<glm::vec3, 9> coefficients{};
+    };
+
+    /**
+     * @struct GPUSHIrradiance
+     * @brief 上传到 AmbientSH uniform block 的数据（std140，9 x vec4 = 144 字节）
+     *
+     * 已预乘余弦卷积系数、1/π 和基函数常数，着色器中只需：
+     * c0 + c1*y + c2*z + c3*x + c4*xy + c5*yz + c6*(3z²-1) + c7*xz + c8*(x²-y²)
+     */
+    struct GPUSHIrradiance
+    {
+        glm::vec4 coefficients[9];
+    };
+
+    static_assert(sizeof(GPUSHIrradiance) == 144, "GPUSHIrradiance must match std140 layout (9 x vec4)");
+
+    /**
+     * @namespace SphericalHarmonics
+     * @brief 立方体贴图的球谐投影（漫反射环境光）
+     *
+     * 设计方案：
+     * - ✅ 遍历所有 texel，按立体角加权投影到 9 个 SH 基函数
+     * - ✅ 每个面按行切分到 Core::ThreadPool，行内 SSE 一次处理 4 个 texel（无 SSE 时回退到标量）
+     * - ✅ 投影结果可缓存到磁盘，键由调用者提供（例如天空盒源文件的缓存键）
+     */
+    namespace SphericalHarmonics
+    {
+        /**
+         * @brief 投影 RGBA8 立方体贴图（6 个面，OpenGL 面顺序和行序）
+         * @param faces 6 个面的像素指针，每个面 size x size x 4 字节
+         * @return 辐射度（radiance）的 SH 系数
+         */
+        SH9Color ProjectCubemap(const uint8_t* const faces[6], uint32_t size);
+
+        /**
+         * @brief 从 GL 立方体贴图读回 level 0 并投影（需在 GL 线程调用）
+         * @return 纹理无效时返回 false
+         */
+        bool ProjectCubemapTexture(unsigned int cubemapTextureID, SH9Color& outRadiance);
+
+        /**
+         * @brief 辐射度 SH → 着色器使用的漫反射辐照度系数（E/π，含基函数常数）
+         */
+        GPUSHIrradiance ToIrradiance(const SH9Color& radiance);
+
+        /**
+         * @brief 在 CPU 上求值辐照度（与着色器公式一致，用于调试/测试）
+         */
+        glm::vec3 EvaluateIrradiance(const GPUSHIrradiance& irradiance, const glm::vec3& normal);
+
+        /**
+         * @brief 读取/写入缓存文件（魔数 + 版本 + 键 + 27 个 float）
+         */
+        bool ReadCache(const std::string& filepath, uint64_t key, SH9Color& outRadiance);
+        bool WriteCache(const std::string& filepath, uint64_t key, const SH9Color& radiance);
+
+    } // namespace SphericalHarmonics
+
+} // namespace Renderer
@@ -1,6 +1,9 @@
 #pragma once
 #include "Renderer/Data/MeshData.hpp"
 #include "Renderer/Data/MeshBuffer.hpp"  // 前向声明改为完整包含
+#include "Renderer/Data/MeshSimplifier.hpp"
+#include "Renderer/Resources/MaterialAtlas.hpp"
+#include "Renderer/Resources/MaterialTable.hpp"
 #include <string>
 #include <vector>
 
@@ -60,6 +63,26 @@ namespace Renderer
         static MeshData CreatePlaneData(float width = 1.0f, float height = 1.0f,
                                        int widthSegments = 1, int heightSegments = 1);
 
+        // ============================================================
+        // 参数化 LOD（每级分段数减半，直到最小分段数）
+        // ============================================================
+
+        /**
+         * @brief 创建球体 LOD 链
+         * @param levelCount 最大级数（分段数降到下限后不再生成更多级别）
+         * @return 第 0 项为完整精度，之后每级 stacks / slices 减半（下限 4 / 6）
+         */
+        static std::vector<MeshData> CreateSphereLODData(int stacks = 32, int slices = 32, float radius = 1.0f,
+                                                         size_t levelCount = 4);
+
+        /**
+         * @brief 创建圆环体 LOD 链
+         * @return 第 0 项为完整精度，之后每级两个方向的分段数减半（下限 8 / 4）
+         */
+        static std::vector<MeshData> CreateTorusLODData(float majorRadius = 1.0f, float minorRadius = 0.3f,
+                                                        int majorSegments = 32, int minorSegments = 24,
+                                                        size_t levelCount = 4);
+
         // ============================================================
         // OBJ 模型
         // ============================================================
@@ -73,13 +96,86 @@ namespace Renderer
          * - OBJ 模型可能包含多个材质
          * - 每个材质需要单独的 MeshData
          * - 返回的顺序与材质在 OBJ 文件中的出现顺序一致
+         * - .lmesh 缓存有效时返回的 MeshData 为内存映射视图（零拷贝，见 MeshCache）
          */
         static std::vector<MeshData> CreateOBJData(const std::string& objPath);
 
+        /**
+         * @brief 从 OBJ 文件创建纹理数组图集版本的网格数据
+         * @param objPath OBJ 文件路径
+         * @param atlas 材质图集（材质纹理会被加入其中，可在多个模型间共享）
+         * @return std::vector<MeshData> 每个纹理数组（分辨率档位）对应一个 MeshData
+         *
+         * @note
+         * - 顶点布局：位置(3) + 法线(3) + UV(2) + 材质层(4) = 12 floats
+         * - 材质层 location 8：rgb = 漫反射颜色，a = 纹理数组层（-1 表示无纹理）
+         * - 无纹理材质合并到第一个网格中，通常整个模型只需一次绘制
+         * - 传入 materialTable 时材质会登记到表中，并追加材质索引属性（location 9，共 13 floats）
+         * - 调用后需执行 atlas.Build() 上传纹理（以及 materialTable->Upload()）
+         */
+        static std::vector<MeshData> CreateOBJAtlasData(const std::string& objPath, MaterialAtlas& atlas,
+                                                        MaterialTable* materialTable = nullptr);
+
+        /**
+         * @brief 把流式导入的一块（OBJLoader::LoadStreaming）转换为网格数据
+         * @param materials 块的材质下标所指的材质表（OBJLoader::GetMaterials()）
+         * @param basePath 纹理查找目录（OBJLoader::GetBasePath()）
+         *
+         * @note
+         * - 布局与 CreateOBJData 相同：位置(3) + 法线(3) + UV(2) = 8 floats，不量化（各块的量化范围不同）
+         * - 块内执行 MeshOptimizer 优化；纯 CPU，可在工作线程执行
+         */
+        static MeshData CreateOBJChunkData(OBJMeshChunk&& chunk, const std::vector<OBJMaterial>& materials,
+                                           const std::string& basePath);
+
+        // ============================================================
+        // glTF 模型
+        // ============================================================
+
+        /**
+         * @brief 从 .gltf / .glb 文件创建网格数据（GLTFLoader）
+         * @return std::vector<MeshData> 每个图元对应一个 MeshData（默认场景的节点顺序）
+         *
+         * @note
+         * - 交错 float 属性和 32 位索引直接引用文件映射（零拷贝），其余转换为 位置(3) + 法线(3) + UV(2) = 8 floats
+         * - 材质颜色 / 纹理路径与 CreateOBJData 的约定相同，可直接用于 InstancedRenderer
+         * @param outSourceFiles 可选，返回读取的文件（glTF + 外部 .bin，网格缓存的依赖）
+         */
+        static std::vector<MeshData> CreateGLTFData(const std::string& gltfPath,
+                                                    std::vector<std::string>* outSourceFiles = nullptr);
+
+        // ============================================================
+        // 上传布局（导入 + PrepareForUpload，量化结果缓存到 .q.lmesh）
+        // ============================================================
+
+        /**
+         * @brief CreateOBJData + PrepareForUpload
+         * @note quantize 时优先映射量化缓存（MeshCache::Open(objPath, true)），未命中则导入、量化并写入缓存，
+         *       之后的启动直接上传映射中的 16 字节顶点，不再拷贝和重新量化
+         */
+        static std::vector<MeshData> CreatePreparedOBJData(const std::string& objPath, bool quantize);
+
+        /**
+         * @brief CreateGLTFData + PrepareForUpload（缓存规则同 CreatePreparedOBJData）
+         */
+        static std::vector<MeshData> CreatePreparedGLTFData(const std::string& gltfPath, bool quantize);
+
         // ============================================================
         // 工具方法
         // ============================================================
 
+        /**
+         * @brief 上传前的导入期处理：足够大的网格切分为簇（需要 float 位置），然后按需量化
+         * @note MeshBufferFactory 的导入路径在上传前调用；纯 CPU，可在工作线程执行（见 AssetLoader）
+         */
+        static void PrepareForUpload(MeshData& data, bool quantize);
+
+        /**
+         * @brief 用 QEM 简化生成 LOD 链，并对每一级执行 PrepareForUpload（MeshBufferFactory::CreateLODBuffers 的 CPU 部分）
+         */
+        static std::vector<MeshData> CreateLODData(MeshData data, const MeshLODConfig& config = {},
+                                                   bool quantize = false);
+
         /**
          * @brief 从 Cube 对象提取 MeshData
          * @param cube Cube 对象引用
@@ -151,6 +247,31 @@ namespace Renderer
         static MeshBuffer CreatePlaneBuffer(float width = 1.0f, float height = 1.0f,
                                            int widthSegments = 1, int heightSegments = 1);
 
+        // ============================================================
+        // LOD 链（自动上传到 GPU，配合 InstancedRenderer::SetLODMeshes 使用）
+        // ============================================================
+
+        /**
+         * @brief 创建球体 LOD 缓冲区（参数化，见 MeshDataFactory::CreateSphereLODData）
+         */
+        static std::vector<MeshBuffer> CreateSphereLODBuffers(int stacks = 32, int slices = 32, float radius = 1.0f,
+                                                              size_t levelCount = 4);
+
+        /**
+         * @brief 创建圆环体 LOD 缓冲区（参数化，见 MeshDataFactory::CreateTorusLODData）
+         */
+        static std::vector<MeshBuffer> CreateTorusLODBuffers(float majorRadius = 1.0f, float minorRadius = 0.3f,
+                                                             int majorSegments = 32, int minorSegments = 24,
+                                                             size_t levelCount = 4);
+
+        /**
+         * @brief 用 QEM 简化为任意网格生成 LOD 链并上传
+         * @param data LOD0（float 位置、带索引）
+         * @param quantize 各级简化完成后再量化顶点（MeshQuantizer）
+         */
+        static std::vector<MeshBuffer> CreateLODBuffers(MeshData data, const MeshLODConfig& config = {},
+                                                        bool quantize = false);
+
         // ============================================================
         // OBJ 模型（自动上传到 GPU）
         // ============================================================
@@ -158,13 +279,41 @@ namespace Renderer
         /**
          * @brief 从 OBJ 文件创建网格缓冲区（已上传到 GPU）
          * @param objPath OBJ 文件路径
+         * @param quantize 上传前量化顶点（MeshQuantizer，32 → 16 字节/顶点）
          * @return std::vector<MeshBuffer> 每个材质对应一个 MeshBuffer
          *
          * @note
          * - 返回的 MeshBuffer 已经调用过 UploadToGPU()
          * - 可以直接传递给 InstancedRenderer 使用
+         * - 三角形数 ≥ MeshletBuilder::kMinTriangles 的网格在量化前切分为簇，供逐簇剔除使用
+         * - 量化结果缓存为 .q.lmesh，之后直接上传映射（见 MeshDataFactory::CreatePreparedOBJData）
+         */
+        static std::vector<MeshBuffer> CreateOBJBuffers(const std::string& objPath, bool quantize = true);
+
+        /**
+         * @brief 从 .gltf / .glb 文件创建网格缓冲区（已上传到 GPU），每个图元一个 MeshBuffer
+         * @param quantize 上传前量化顶点（同 CreateOBJBuffers，量化结果同样缓存为 .q.lmesh）
+         */
+        static std::vector<MeshBuffer> CreateGLTFBuffers(const std::string& gltfPath, bool quantize = true);
+
+        /**
+         * @brief 从 OBJ 文件创建纹理数组图集版本的网格缓冲区（已上传到 GPU）
+         * @param quantize 上传前量化位置 / 法线 / UV（材质属性保持 float）
+         * @note 每个 MeshBuffer 的 GetData().GetTextureArrayIndex() 指向 atlas 中的纹理数组
+         */
+        static std::vector<MeshBuffer> CreateOBJAtlasBuffers(const std::string& objPath, MaterialAtlas& atlas,
+                                                             MaterialTable* materialTable = nullptr,
+                                                             bool quantize = true);
+
+        /**
+         * @brief 从 OBJ 文件创建纹理数组图集版本的 LOD 缓冲区
+         * @return 每个网格一条 LOD 链（第 0 项为完整精度）
          */
-        static std::vector<MeshBuffer> CreateOBJBuffers(const std::string& objPath);
+        static std::vector<std::vector<MeshBuffer>> CreateOBJAtlasLODBuffers(const std::string& objPath,
+                                                                             MaterialAtlas& atlas,
+                                                                             const MeshLODConfig& config = {},
+                                                                             MaterialTable* materialTable = nullptr,
+                                                                             bool quantize = true);
 
         // ============================================================
         // 从 MeshData 创建
@@ -46,6 +46,8 @@ namespace Renderer
          * @return std::vector<MaterialVertexData> 每个材质的顶点数据列表
          *
          * @note 这是推荐的方法，用于实例化渲染
+         * @note 每个材质的数据经过 MeshOptimizer 优化（顶点缓存、过度绘制、顶点获取顺序）
+         * @note 结果缓存为 <objPath 去扩展名>.lmesh（见 MeshCache），源文件未变化时直接读取缓存
          */
         static std::vector<MaterialVertexData> GetMaterialVertexData(const std::string& objPath);
 
@@ -80,6 +82,17 @@ namespace Renderer
          * 布局：位置(3), 法线(3), UV(2)
          */
         static void GetVertexLayout(std::vector<size_t>& offsets, std::vector<int>& sizes);
+
+        /**
+         * @brief 解析 OBJ 并按材质拆分（不读写 .lmesh 缓存，结果已优化）
+         * @note lumen-cook 用它生成打包文件中的网格，不在源目录留下缓存文件
+         */
+        static std::vector<MaterialVertexData> ParseMaterialVertexData(const std::string& objPath);
+
+    private:
+
+        // 导入时网格优化（见 MeshOptimizer），记录优化前后的 ACMR / ATVR
+        static void OptimizeMaterialVertexData(std::vector<MaterialVertexData>& materialDataList);
     };
 
 } // namespace Renderer
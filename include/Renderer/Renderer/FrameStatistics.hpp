@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 编译时控制渲染统计（关闭时 RENDER_STATS_* 宏展开为空）
+// 计数只写本线程的计数器，开销约为一次线程局部变量访问，默认开启
+#ifndef ENABLE_RENDER_STATS
+#define ENABLE_RENDER_STATS 1
+#endif
+
+namespace Renderer
+{
+
+    /**
+     * @enum RenderCounter
+     * @brief 每帧统计的计数项
+     */
+    enum class RenderCounter : uint32_t
+    {
+        DrawCalls = 0,          // glDraw* 调用次数
+        Instances,              // 各绘制调用的实例数之和
+        Triangles,              // 提交的三角形数（× 实例数）
+        Vertices,               // 提交的顶点 / 索引数（× 实例数，即顶点着色器调用上限）
+        ShaderBinds,            // 状态切换：glUseProgram
+        TextureBinds,           // 状态切换：glBindTexture（材质 / 纹理数组 / 天空盒）
+        VertexArrayBinds,       // 状态切换：glBindVertexArray
+        BufferBinds,            // 状态切换：glBindBufferBase（UBO）
+        BufferBytesUploaded,    // glBufferData / glBufferSubData 上传的字节数
+        TextureBytesUploaded,   // glTexImage* / glTexSubImage* / glCompressedTexImage* 上传的字节数
+        InstancesSubmitted,     // 交给渲染器绘制的实例数
+        InstancesCulled,        // 其中被剔除、没有产生绘制的实例数
+        Count
+    };
+
+    /**
+     * @struct FrameStats
+     * @brief 一帧的统计结果
+     */
+    struct FrameStats
+    {
+        uint64_t frameIndex = 0;
+        double frameTimeMs = 0.0;
+        uint64_t counters[static_cast<size_t>(RenderCounter::Count)] = {};
+
+        uint64_t Get(RenderCounter counter) const { return counters[static_cast<size_t>(counter)]; }
+    };
+
+    /**
+     * @class FrameStatistics
+     * @brief 渲染路径的每帧统计：各线程独立累加，帧末合并为一帧记录，保留最近 N 帧
+     *
+     * 设计方案：
+     * - ✅ 每个线程首次计数时注册一组计数器，之后只由该线程写入（relaxed 读写，无锁、无原子读改写）
+     * - ✅ 计数器只增不清零：EndFrame 对每个线程取与上一帧的差值求和，计数线程与合并线程无需同步
+     * - ✅ 最近 N 帧保存在环形缓冲中，可按帧查询，或导出 CSV / JSON 用于性能回归对比
+     * - ⚠️ EndFrame 由渲染线程每帧调用一次；其他线程的计数在其下一次 EndFrame 计入
+     *
+     * 使用方式：
+     * @code
+     * RENDER_STATS_DRAW(instanceCount, triangles, vertices);   // 每次 glDraw*
+     * RENDER_STATS_ADD(TextureBinds, 1);                       // 状态切换 / 上传字节
+     * // 主循环末尾
+     * Renderer::FrameStatistics::GetInstance().EndFrame(deltaTime * 1000.0);
+     * @endcode
+     */
+    class FrameStatistics
+    {
+    public:
+        static constexpr size_t kDefaultHistorySize = 600;   // 约 10 秒（60 FPS）
+
+        static FrameStatistics& GetInstance();
+
+        /**
+         * @brief 累加本线程的计数（任意线程）
+         */
+        static void Add(RenderCounter counter, uint64_t value);
+
+        /**
+         * @brief 记录一次绘制调用（任意线程）
+         */
+        static void RecordDraw(uint64_t instances, uint64_t triangles, uint64_t vertices);
+
+        /**
+         * @brief 帧边界：合并所有线程本帧的计数，写入历史
+         * @param frameTimeMs 本帧耗时
+         */
+        void EndFrame(double frameTimeMs);
+
+        /**
+         * @brief 设置保留的帧数（清空已有历史）
+         */
+        void SetHistorySize(size_t frames);
+
+        /**
+         * @brief 最近一帧（尚未有完整帧时返回全零）
+         */
+        FrameStats GetLastFrame() const;
+
+        /**
+         * @brief 最近 maxFrames 帧，按时间从旧到新
+         */
+        std::vector<FrameStats> GetHistory(size_t maxFrames = SIZE_MAX) const;
+
+        /**
+         * @brief 导出历史（每帧一行 / 一个对象）
+         */
+        bool ExportCSV(const std::string& path) const;
+        bool ExportJSON(const std::string& path) const;
+
+        static const char* GetCounterName(RenderCounter counter);
+
+    private:
+        FrameStatistics();
+
+        FrameStatistics(const FrameStatistics&) = delete;
+        FrameStatistics& operator=(const FrameStatistics&) = delete;
+
+        static constexpr size_t kCounterCount = static_cast<size_t>(RenderCounter::Count);
+
+        /**
+         * @brief 单个线程的累计计数（单写者；lastValues 只在 EndFrame 中访问）
+         */
+        struct ThreadCounters
+        {
+            std::atomic<uint64_t> values[kCounterCount] = {};
+            uint64_t lastValues[kCounterCount] = {};
+        };
+
+        static ThreadCounters& GetThreadCounters();
+
+        mutable std::mutex m_mutex;                            // 保护线程注册和历史
+        std::vector<std::unique_ptr<ThreadCounters>> m_threads;
+        std::vector<FrameStats> m_history;                     // 环形缓冲
+        size_t m_historyStart = 0;                             // 最旧一帧的位置
+        size_t m_historyCount = 0;
+        uint64_t m_frameIndex = 0;
+    };
+
+} // namespace Renderer
+
+#if ENABLE_RENDER_STATS
+#define RENDER_STATS_ADD(counter, value) \
+    ::Renderer::FrameStatistics::Add(::Renderer::RenderCounter::counter, static_cast<uint64_t>(value))
+#define RENDER_STATS_DRAW(instances, triangles, vertices)                                   \
+    ::Renderer::FrameStatistics::RecordDraw(static_cast<uint64_t>(instances),               \
+                                            static_cast<uint64_t>(triangles),               \
+                                            static_cast<uint64_t>(vertices))
+#else
+#define RENDER_STATS_ADD(counter, value) ((void)0)
+#define RENDER_STATS_DRAW(instances, triangles, vertices) ((void)0)
+#endif
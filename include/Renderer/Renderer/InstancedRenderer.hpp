@@ -1,8 +1,15 @@
 #pragma once
 #include "Renderer/Data/MeshBuffer.hpp"
 #include "Renderer/Resources/Texture.hpp"
+#include "Renderer/Resources/TextureArray.hpp"
+#include "Renderer/Resources/MaterialAtlas.hpp"
+#include "Renderer/Resources/MaterialTable.hpp"
 #include "Renderer/Data/InstanceData.hpp"
 #include "Renderer/Core/IRenderer.hpp"
+#include "Renderer/Data/MeshSimplifier.hpp"
+#include "Renderer/Renderer/MeshletCuller.hpp"
+#include "Renderer/Resources/AssetRegistry.hpp"
+#include "Core/Camera.hpp"
 #include "Core/GLM.hpp"
 #include <vector>
 #include <memory>
@@ -23,9 +30,9 @@ namespace Renderer
      * - ✅ InstancedRenderer: 负责渲染逻辑
      *
      * 职责：
-     * 1. 持有 MeshBuffer 引用（网格模板）
+     * 1. 持有 MeshBuffer 引用（网格模板，可与其他渲染器共享）
      * 2. 持有 InstanceData（实例数据）
-     * 3. 管理 OpenGL 实例化缓冲区（instanceVBO）
+     * 3. 管理 OpenGL 实例化缓冲区（instanceVBO）和自有 VAO
      * 4. 执行实例化渲染
      *
      * 使用方式：
@@ -79,6 +86,44 @@ namespace Renderer
         bool HasTexture() const { return m_texture != nullptr; }
         const std::shared_ptr<Texture>& GetTexture() const { return m_texture; }
 
+        // 设置纹理数组（MaterialAtlas，绑定到纹理单元6）
+        void SetTextureArray(std::shared_ptr<TextureArray> textureArray) { m_textureArray = textureArray; }
+        bool HasTextureArray() const { return m_textureArray != nullptr; }
+        const std::shared_ptr<TextureArray>& GetTextureArray() const { return m_textureArray; }
+
+        // 设置每次绘制的材质索引（MaterialTable）
+        // 网格没有每顶点材质索引（location 9）时，绘制前以常量顶点属性提供，无需 uniform 调用
+        // -1 表示不设置（使用网格自带的每顶点索引）
+        void SetMaterialIndex(int index) { m_materialIndex = index; }
+        int GetMaterialIndex() const { return m_materialIndex; }
+
+        // ⭐ 设置 LOD 网格链（lods[0] 为最精细级别，同时作为 SetMesh 的网格），须在 Initialize() 之前调用
+        // minScreenPixels[k]：实例包围球投影直径 ≥ 该像素值时使用 LOD k，否则继续尝试下一级；
+        // 为空时使用 DefaultLODThresholds()
+        void SetLODMeshes(const std::vector<std::shared_ptr<MeshBuffer>>& lods,
+                          const std::vector<float>& minScreenPixels = {});
+        size_t GetLODCount() const { return m_lodMeshes.empty() ? 1 : m_lodMeshes.size(); }
+
+        // 默认 LOD 阈值：256、128、64… 像素（屏幕尺寸每减半降一级）
+        static std::vector<float> DefaultLODThresholds(size_t levelCount);
+
+        // ⭐ 每帧按实例的投影尺寸分桶到各 LOD（一个 LOD 一段连续的实例子流，每级一次绘制）
+        // 实例顺序变化时重新上传实例缓冲区；未设置 LOD 时为空操作
+        void UpdateLOD(const ::Core::Camera& camera, float viewportHeight);
+
+        // 各 LOD 当前的实例数
+        std::vector<size_t> GetLODInstanceCounts() const;
+
+        // ⭐ 逐簇剔除：网格带有簇（MeshletBuilder）时按视锥体（面剔除开启时可加上法线锥，见 MeshletCullConfig）整簇剔除，只绘制可见的索引区间
+        // 每帧在 UpdateLOD 之后调用（依赖各级的实例子流）；从未调用时绘制完整网格
+        void UpdateCulling(const glm::mat4& viewProjection, const glm::vec3& cameraPos);
+        void SetMeshletCullConfig(const MeshletCullConfig& config);
+        void SetMeshletCullingEnabled(bool enabled);
+        bool HasMeshletCulling() const;
+
+        // 本帧所有 LOD 级别的剔除统计之和
+        MeshletCullStats GetMeshletCullStats() const;
+
         // 获取信息
         size_t GetInstanceCount() const { return m_instanceCount; }
         const std::shared_ptr<MeshBuffer>& GetMesh() const { return m_meshBuffer; }
@@ -90,13 +135,34 @@ namespace Renderer
         // 静态辅助方法：为 Cube 创建实例化渲染器
         static InstancedRenderer CreateForCube(const std::shared_ptr<InstanceData>& instances);
 
+        // 静态辅助方法：为已加载的网格资源创建渲染器（每个子网格一个，LOD 链自动设置）
+        // atlas 非空时按网格的纹理数组索引绑定图集；否则加载网格记录的漫反射纹理（已挂纹理的网格跳过）
+        // ⭐ 用于 AssetLoader 回调：资源到达后再创建渲染器
+        static std::vector<InstancedRenderer> CreateForAsset(const MeshHandle& asset,
+                                                             const std::shared_ptr<InstanceData>& instances,
+                                                             const std::shared_ptr<MaterialAtlas>& atlas = nullptr);
+
         // 静态辅助方法：为 OBJ 模型创建实例化渲染器（返回多个渲染器，每个材质一个）
         // 同时返回 meshBuffer 和 instanceData 的 shared_ptr 以保持生命周期
+        // 网格经 AssetRegistry 导入：同一 OBJ 多次调用只解析、上传一次
         static std::tuple<std::vector<InstancedRenderer>,
                           std::vector<std::shared_ptr<MeshBuffer>>,
                           std::shared_ptr<InstanceData>>
         CreateForOBJ(const std::string& objPath, const std::shared_ptr<InstanceData>& instances);
 
+        // 静态辅助方法：为 OBJ 模型创建纹理数组版本的渲染器
+        // 所有材质按分辨率档位合并，通常整个模型只需一个渲染器（一次绑定、一次绘制）
+        // atlas 为空时使用 AssetRegistry 的共享图集；同一模型 + 图集 + 材质表 + LOD 配置只导入一次
+        // 传入 materialTable 时材质参数登记到材质表并上传，网格携带每顶点材质索引
+        // 传入 lodConfig 时为每个网格生成 LOD 链（返回的 meshBuffers 包含所有级别）
+        static std::tuple<std::vector<InstancedRenderer>,
+                          std::vector<std::shared_ptr<MeshBuffer>>,
+                          std::shared_ptr<InstanceData>>
+        CreateForOBJAtlas(const std::string& objPath, const std::shared_ptr<InstanceData>& instances,
+                          std::shared_ptr<MaterialAtlas> atlas = nullptr,
+                          const std::shared_ptr<MaterialTable>& materialTable = nullptr,
+                          const MeshLODConfig* lodConfig = nullptr);
+
         // ✅ 性能优化（2026-01-02）：批量渲染方法
         // 按纹理分组渲染多个渲染器，减少OpenGL状态切换
         // 修复前：每个渲染器独立绑定/解绑纹理和VAO（168次状态切换/帧）
@@ -122,17 +188,40 @@ namespace Renderer
         size_t m_instanceCount = 0;                   // 实例数量
 
         // OpenGL 对象
-        // ✅ 修复：删除独立的VAO，直接使用MeshBuffer的VAO
-        // 避免双重所有权导致的资源重复释放/泄漏问题
+        // ⭐ 每个 LOD 级别一个自有 VAO（由 MeshBuffer::CreateVertexArray 创建，只引用网格的 VBO/EBO）
+        // 实例属性配置在自己的 VAO 上，多个渲染器可以共享同一个 MeshBuffer（AssetRegistry）
+        std::vector<GLuint> m_vaos;
         GLuint m_instanceVBO = 0;                     // 实例化 VBO（存储矩阵和颜色）
 
         // 材质和纹理
         std::shared_ptr<Texture> m_texture;           // 纹理（使用 shared_ptr 管理所有权）
+        std::shared_ptr<TextureArray> m_textureArray; // 纹理数组（MaterialAtlas）
         glm::vec3 m_materialColor = glm::vec3(1.0f);
+        int m_materialIndex = -1;                     // 每次绘制的材质索引（MaterialTable）
+
+        // LOD
+        std::vector<std::shared_ptr<MeshBuffer>> m_lodMeshes;  // 所有级别（为空或只有一级时不启用）
+        std::vector<float> m_lodThresholds;                    // 每级的最小屏幕像素
+        std::vector<unsigned int> m_lodOrder;                  // 按 LOD 分桶后的实例顺序（实例缓冲区中的顺序）
+        std::vector<size_t> m_lodOffsets;                      // 每级实例子流的起始位置（级数 + 1）
+        float m_boundingRadius = 0.0f;                         // LOD0 包围球半径（模型空间）
+
+        // 逐簇剔除（每个 LOD 级别一个，网格没有簇时为空剔除器）
+        std::vector<MeshletCuller> m_meshletCullers;
+        MeshletCullConfig m_meshletCullConfig;
+        bool m_meshletCullingEnabled = true;
+        bool m_meshletCullValid = false;                       // 剔除结果是否可用于本帧绘制
 
         // 内部方法
         void UploadInstanceData();
         std::vector<float> PrepareInstanceBuffer() const;  // 辅助方法：准备缓冲区数据
+        void SetupInstanceAttributes(GLuint vao, size_t firstInstance) const;
+        void ReleaseVertexArrays();
+        void BuildMeshletCullers();
+        const MeshBuffer& GetLevelMesh(size_t level) const;
+        const std::vector<IndexDrawRange>& GetDrawRanges(size_t level, const MeshBuffer& mesh) const;
+        // 绘制各索引区间（每个区间一次绘制调用，计入 FrameStatistics）
+        void DrawMesh(const MeshBuffer& mesh, const std::vector<IndexDrawRange>& ranges, GLsizei instanceCount) const;
     };
 
 } // namespace Renderer
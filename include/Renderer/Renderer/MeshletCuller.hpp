@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Renderer/Data/Meshlet.hpp"
+#include "Renderer/Data/MeshBuffer.hpp"
+#include "Core/GLM.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace Renderer
+{
+
+    /**
+     * @struct MeshletCullConfig
+     * @brief 逐簇剔除配置
+     */
+    struct MeshletCullConfig
+    {
+        bool frustumCulling = true;   // 包围球 vs 视锥体
+        // 法线锥背面剔除（只对近似均匀缩放的实例生效）
+        // ⚠️ 只在绘制时开启了 GL_CULL_FACE 的材质上打开：双面绘制的网格（开放 / 薄壁几何，例如车身面板）
+        //    背面本来可见，按法线锥剔除会留下空洞。程序默认不开启面剔除，因此默认关闭
+        bool backfaceCulling = false;
+        size_t maxDrawRanges = 16;    // 每个网格每帧最多的绘制区间（超出时合并最小的间隙，多画少量被剔除的簇）
+        size_t maxInstances = 64;     // 实例数超过该值时不做逐簇剔除（可见簇的并集接近全部）
+    };
+
+    /**
+     * @struct MeshletCullStats
+     * @brief 本帧剔除统计
+     */
+    struct MeshletCullStats
+    {
+        size_t totalClusters = 0;
+        size_t visibleClusters = 0;
+        size_t totalTriangles = 0;
+        size_t visibleTriangles = 0;
+        size_t drawnTriangles = 0;    // 合并间隙后实际提交的三角形数（≥ visibleTriangles）
+        size_t drawRanges = 0;
+
+        void Accumulate(const MeshletCullStats& other);
+        float GetClusterCulledFraction() const;
+        float GetTriangleCulledFraction() const;
+    };
+
+    /**
+     * @class MeshletCuller
+     * @brief CPU 逐簇剔除 - 每帧为一个网格（及其一组实例）生成可见簇的索引绘制区间
+     *
+     * 设计方案：
+     * - ✅ 簇包围体以 SoA 存放，SSE 一次测试 4 个簇（视锥体 6 个平面 + 法线锥）
+     * - ✅ 视锥平面变换到各实例的模型空间（plane · M），无需逐簇变换包围球
+     * - ✅ 多个实例时取可见簇的并集；簇在索引缓冲区中连续，相邻可见簇合并为一个区间，
+     *      区间数超过上限时合并最小的间隙，绘制调用数有界
+     * - ✅ 输出区间已按 MeshBuffer 的 16 位索引分段切开，可直接用于 glDrawElements*BaseVertex
+     *
+     * @note OpenGL 3.3 没有计算着色器，剔除只在 CPU 上进行
+     */
+    class MeshletCuller
+    {
+    public:
+        explicit MeshletCuller(const MeshletCullConfig& config = MeshletCullConfig());
+
+        /**
+         * @brief 设置簇（拷贝为 SoA 布局）
+         */
+        void SetMeshlets(const std::vector<Meshlet>& meshlets);
+        bool IsEmpty() const { return m_count == 0; }
+        size_t GetMeshletCount() const { return m_count; }
+
+        void SetConfig(const MeshletCullConfig& config) { m_config = config; }
+        const MeshletCullConfig& GetConfig() const { return m_config; }
+
+        /**
+         * @brief 剔除并生成绘制区间
+         * @param mesh 簇所属的网格（用于按索引分段切分区间）
+         * @param models 实例模型矩阵
+         * @param order 可选：实例下标（LOD 子流），为空时使用 models[0..count)
+         * @param count 实例数
+         */
+        void Cull(const MeshBuffer& mesh, const glm::mat4& viewProjection, const glm::vec3& cameraPos,
+                  const glm::mat4* models, const unsigned int* order, size_t count);
+
+        const std::vector<IndexDrawRange>& GetDrawRanges() const { return m_ranges; }
+        const MeshletCullStats& GetStats() const { return m_stats; }
+
+        /**
+         * @brief 从 viewProjection 提取视锥体平面（xyz 为单位法线，指向视锥体内部）
+         */
+        static void ExtractFrustumPlanes(const glm::mat4& viewProjection, glm::vec4 planes[6]);
+
+    private:
+        void CullInstance(const glm::vec4 planes[6], const glm::vec3& cameraPos, const glm::mat4& model);
+        void BuildDrawRanges(const MeshBuffer& mesh);
+
+        MeshletCullConfig m_config;
+        size_t m_count = 0;
+
+        // SoA（长度补齐到 4 的倍数）
+        std::vector<float> m_centerX, m_centerY, m_centerZ, m_radius;
+        std::vector<float> m_apexX, m_apexY, m_apexZ;
+        std::vector<float> m_axisX, m_axisY, m_axisZ, m_cutoff;
+        std::vector<uint32_t> m_firstIndex, m_triangleCount;
+
+        std::vector<uint8_t> m_visible;
+        std::vector<IndexDrawRange> m_ranges;
+        MeshletCullStats m_stats;
+    };
+
+} // namespace Renderer
@@ -0,0 +1,180 @@
+#pragma once
+#include "Core/MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Renderer
+{
+
+    /**
+     * @enum AssetType
+     * @brief 打包条目类型（同一路径可以有不同类型的条目）
+     */
+    enum class AssetType : uint32_t
+    {
+        Mesh = 1,     // .lmesh 数据（MeshCache::WriteToMemory，依赖表为空）
+        Texture = 2,  // DDS 数据（预编码格式 + 完整 mip 链，已按 OpenGL 行序翻转）
+        Shader = 3,   // GLSL 源码
+        Raw = 4       // 原样拷贝的文件
+    };
+
+    /**
+     * @struct AssetArchiveEntry
+     * @brief 目录表中的一个条目
+     */
+    struct AssetArchiveEntry
+    {
+        std::string name;      // 规范化的源路径（相对工作目录，'/' 分隔）
+        AssetType type = AssetType::Raw;
+        uint64_t offset = 0;   // 数据在打包文件中的偏移（16 字节对齐）
+        uint64_t size = 0;
+        uint64_t hash = 0;     // 数据的 FNV-1a 64
+        uint32_t firstSource = 0;  // 源文件记录在 AssetArchive::GetSources() 中的范围
+        uint32_t sourceCount = 0;
+    };
+
+    /**
+     * @struct AssetArchiveSource
+     * @brief 烘焙条目时源文件的大小和修改时间（用于检测打包文件过期）
+     */
+    struct AssetArchiveSource
+    {
+        std::string name;           // 规范化路径（相对工作目录）
+        uint64_t size = 0;
+        int64_t modifiedTime = 0;   // fs::last_write_time 的计数值
+    };
+
+    /**
+     * @class AssetArchive
+     * @brief 只读资源打包文件（.lpak），整个文件内存映射，条目数据零拷贝访问
+     *
+     * 文件布局（小端，数据块 16 字节对齐）：
+     * - 头部：魔数 "LPAK"、版本、条目数、目录表 / 字符串表偏移、文件大小
+     * - 数据块：按清单顺序排列（启动时按顺序访问，接近一次顺序读）
+     * - 目录表：类型、名称引用、偏移、大小、哈希
+     * - 字符串表
+     *
+     * 设计方案：
+     * - ✅ 由 lumen-cook 离线生成（见 tools/lumen_cook.cpp），网格为 GPU 布局的 .lmesh，
+     *      纹理为带 mip 链的块压缩 DDS，着色器为源码
+     * - ✅ Mount() 后以下加载入口先查打包文件，命中时不再访问松散文件：
+     *      MeshCache::Open（OBJ 网格，顶点 / 索引视图直接指向映射）、Texture::LoadFromFile / Decode、Shader::Load
+     * - ✅ 条目名与请求路径都经过 NormalizeName，"assets/models/../textures/a.png" 与 "assets/textures/a.png" 相同
+     * - ✅ 目录表记录每个条目的源文件（网格包括 mtllib）大小和修改时间；松散源文件存在且与记录不同时，
+     *      Find() 视条目为过期并返回 nullptr，调用者回退到松散文件（发布时不带源文件则始终使用打包文件）
+     * - ⚠️ 过期条目只是被跳过，打包文件本身不会更新，重新运行 lumen-cook 才能恢复打包加载
+     *
+     * 使用方式：
+     * @code
+     * if (AssetArchive::Mount("assets/scene.lpak")) {
+     *     // 之后的 Texture / Shader / OBJ 加载自动从打包文件读取
+     * }
+     * @endcode
+     */
+    class AssetArchive
+    {
+    public:
+        static constexpr uint32_t kVersion = 2;  // v2：目录表记录源文件大小 / 修改时间
+
+        AssetArchive() = default;
+
+        AssetArchive(const AssetArchive&) = delete;
+        AssetArchive& operator=(const AssetArchive&) = delete;
+
+        /**
+         * @brief 映射并解析打包文件
+         * @param verifyHashes 是否校验所有条目的哈希（需要读入整个文件）
+         */
+        bool Open(const std::string& path, bool verifyHashes = false);
+
+        /**
+         * @brief 查找条目（name 先规范化）
+         * @return 不存在或已过期（见 IsStale）时返回 nullptr
+         */
+        const AssetArchiveEntry* Find(const std::string& name, AssetType type) const;
+
+        /**
+         * @brief 条目的源文件是否在烘焙后发生变化
+         * @note 第一个源文件（条目本身）不存在时视为发布环境，不过期；否则任一源文件丢失、大小或修改时间不同即过期
+         */
+        bool IsStale(const AssetArchiveEntry& entry) const;
+
+        /**
+         * @brief 条目数据的起始地址（指向映射，生命周期与本对象相同）
+         */
+        const uint8_t* GetData(const AssetArchiveEntry& entry) const { return m_file.Data() + entry.offset; }
+
+        /**
+         * @brief 校验条目的哈希
+         */
+        bool Verify(const AssetArchiveEntry& entry) const;
+
+        const std::vector<AssetArchiveEntry>& GetEntries() const { return m_entries; }
+        const std::vector<AssetArchiveSource>& GetSources() const { return m_sources; }
+        const std::string& GetPath() const { return m_path; }
+        size_t GetSizeBytes() const { return m_file.Size(); }
+
+        /**
+         * @brief 路径规范化（去掉 "." / ".."，统一为 '/' 分隔）
+         */
+        static std::string NormalizeName(const std::string& name);
+
+        // ============================================================
+        // 全局挂载（加载入口通过 GetMounted() 查找，线程安全）
+        // ============================================================
+
+        /**
+         * @brief 打开并挂载为全局打包文件（替换之前挂载的，已返回的数据仍由持有者保持有效）
+         */
+        static bool Mount(const std::string& path, bool verifyHashes = false);
+        static void Unmount();
+        static std::shared_ptr<const AssetArchive> GetMounted();
+
+    private:
+        static std::string MakeKey(const std::string& normalizedName, AssetType type);
+
+        ::Core::MappedFile m_file;  // Renderer::Core 命名空间同名，需要全局限定
+        std::string m_path;
+        std::vector<AssetArchiveEntry> m_entries;
+        std::vector<AssetArchiveSource> m_sources;
+        std::unordered_map<std::string, size_t> m_lookup;  // "类型:名称" → 条目下标
+    };
+
+    /**
+     * @class AssetArchiveWriter
+     * @brief 生成 .lpak（lumen-cook 使用）
+     */
+    class AssetArchiveWriter
+    {
+    public:
+        /**
+         * @brief 添加条目（同名同类型的条目被替换）
+         * @param sources 条目的源文件（为空时即 name 本身），此时记录其大小和修改时间；第一个应为 name
+         */
+        void Add(const std::string& name, AssetType type, std::vector<uint8_t> data,
+                 const std::vector<std::string>& sources = {});
+
+        bool Has(const std::string& name, AssetType type) const;
+        size_t GetEntryCount() const { return m_entries.size(); }
+
+        /**
+         * @brief 写入文件（先写临时文件再重命名，不影响正在映射旧文件的进程）
+         */
+        bool Write(const std::string& path, std::string* error = nullptr) const;
+
+    private:
+        struct PendingEntry
+        {
+            std::string name;
+            AssetType type;
+            std::vector<uint8_t> data;
+            std::vector<AssetArchiveSource> sources;
+        };
+        std::vector<PendingEntry> m_entries;
+    };
+
+} // namespace Renderer
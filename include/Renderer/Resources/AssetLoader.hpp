@@ -0,0 +1,227 @@
+#pragma once
+#include "Renderer/Resources/AssetRegistry.hpp"
+#include "Renderer/Resources/OBJLoader.hpp"
+#include "Renderer/Resources/Texture.hpp"
+#include "Renderer/Data/MeshData.hpp"
+#include "Renderer/Data/MeshSimplifier.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Renderer
+{
+    class MaterialAtlas;
+    class MaterialTable;
+    class TextureStreamer;
+
+    /**
+     * @struct AssetLoaderConfig
+     * @brief 后台加载配置
+     */
+    struct AssetLoaderConfig
+    {
+        double uploadBudgetMs = 2.0;                        // 每帧 ProcessUploads 的上传时间预算
+        size_t uploadBudgetBytes = 16ull * 1024 * 1024;     // 每帧上传字节预算（顶点 + 索引 + 像素）
+        size_t streamPendingBytes = 64ull * 1024 * 1024;    // 流式导入：上传队列超过此字节数时解析线程等待（限制常驻内存）
+    };
+
+    /**
+     * @struct AssetLoadProgress
+     * @brief 加载进度（按加载任务计数：合并到进行中任务的重复请求不单独计数，命中注册表的请求计为一个任务）
+     */
+    struct AssetLoadProgress
+    {
+        size_t requested = 0;          // 已发起的加载任务
+        size_t decoded = 0;            // CPU 阶段已完成（解析 / 解码 / 生成）
+        size_t completed = 0;          // 已上传并回调
+        size_t failed = 0;             // 失败（回调参数为空）
+        size_t pendingUploadBytes = 0; // 队列中等待上传的字节数
+
+        float GetFraction() const
+        {
+            return requested > 0 ? static_cast<float>(completed + failed) / static_cast<float>(requested) : 1.0f;
+        }
+        bool IsComplete() const { return completed + failed >= requested; }
+    };
+
+    /**
+     * @class AssetLoader
+     * @brief 后台资源加载器 - CPU 工作在线程池执行，GPU 上传在渲染线程按每帧预算排空
+     *
+     * 设计方案：
+     * - ✅ OBJ 解析、材质拆分、LOD 简化、簇切分 / 量化、图像解码、程序化网格生成提交到 Core::ThreadPool
+     * - ✅ 工作线程把结果（MeshData / TextureSource）作为上传任务放入队列（一个网格一个任务），
+     *      渲染线程每帧调用 ProcessUploads()，在时间 / 字节预算内执行上传（至少执行一个任务，保证前进）
+     * - ✅ 一个资源的全部上传完成后登记到 AssetRegistry（与同步加载同一个键，互相命中缓存），再调用回调；
+     *      回调总在渲染线程（ProcessUploads 内）执行，可直接 SetMesh / Initialize
+     * - ✅ 相同键的进行中请求合并为一次加载；注册表中已存在的资源下一次 ProcessUploads 时直接回调
+     *
+     * 使用方式：
+     * @code
+     * AssetLoader loader;
+     * loader.LoadSphereLOD(32, 32, 1.0f, 4, [renderer](const MeshHandle& asset) {
+     *     if (!asset) return;
+     *     renderer->SetLODMeshes(asset->GetLODs());
+     *     renderer->Initialize();
+     * });
+     * // 每帧
+     * loader.ProcessUploads();
+     * @endcode
+     *
+     * @note Load* / ProcessUploads / Flush 只能在 OpenGL 上下文所在线程调用
+     * @note 没有使用共享 GL 上下文：上传只发生在渲染线程，与现有渲染代码不需要额外同步
+     */
+    class AssetLoader
+    {
+    public:
+        using MeshCallback = std::function<void(const MeshHandle&)>;
+        using TextureCallback = std::function<void(const std::shared_ptr<Texture>&)>;
+        using MeshBuildFunc = std::function<std::vector<std::vector<MeshData>>()>;  // [子网格][LOD]
+        using StreamSubmeshCallback = std::function<void(const std::shared_ptr<MeshBuffer>&)>;
+        using StreamDoneCallback = std::function<void(bool success)>;
+
+        explicit AssetLoader(const AssetLoaderConfig& config = AssetLoaderConfig());
+        ~AssetLoader();  // 等待进行中的 CPU 任务；未上传的结果直接丢弃，不再回调
+
+        AssetLoader(const AssetLoader&) = delete;
+        AssetLoader& operator=(const AssetLoader&) = delete;
+
+        // ============================================================
+        // 网格（键与 AssetRegistry 的同步接口一致）
+        // ============================================================
+
+        /**
+         * @brief 通用入口：在工作线程执行 build，结果上传后以 key 登记到注册表
+         * @param dependencies 资源持有的外部对象（同 AssetRegistry::GetOrCreate）
+         * @param onUploaded 可选：所有网格上传完成、登记之前在渲染线程执行（如构建图集）
+         */
+        void LoadMesh(const std::string& key, MeshBuildFunc build, MeshCallback callback,
+                      std::vector<std::shared_ptr<const void>> dependencies = {},
+                      std::function<void()> onUploaded = nullptr);
+
+        /**
+         * @brief 异步版 AssetRegistry::LoadOBJ（材质纹理也在工作线程解码，上传后挂到对应子网格）
+         * @param textureStreamer 可选：材质纹理直接交由流送管理（工作线程生成完整 mip 链，渲染线程只上传初始驻留层级），
+         *                        之后 TextureStreamer::Track 不再重新读取文件；须比本加载器的上传任务存活更久
+         * @note 同一 OBJ 已在注册表中时沿用已有的纹理（无论是否流送）
+         */
+        void LoadOBJ(const std::string& objPath, MeshCallback callback, bool quantize = true,
+                     TextureStreamer* textureStreamer = nullptr);
+
+        /**
+         * @brief 异步版 AssetRegistry::LoadGLTF（嵌入的图像在工作线程从内存解码）
+         */
+        void LoadGLTF(const std::string& gltfPath, MeshCallback callback, bool quantize = true);
+
+        /**
+         * @brief 异步版 AssetRegistry::LoadOBJAtlas（atlas 为空时使用注册表的共享图集）
+         * @note 工作线程会向 atlas / materialTable 登记材质，加载完成前不要在其他地方使用它们；
+         *       atlas->Build() 和 materialTable->Upload() 在回调之前于渲染线程执行
+         */
+        void LoadOBJAtlas(const std::string& objPath, std::shared_ptr<MaterialAtlas> atlas,
+                          const std::shared_ptr<MaterialTable>& materialTable, const MeshLODConfig* lodConfig,
+                          MeshCallback callback, bool quantize = true);
+
+        /**
+         * @brief 流式导入大型 OBJ：边解析边上传，模型在加载过程中逐步出现
+         * @param onSubmesh 某个材质的第一块上传后在渲染线程调用（纹理已挂上），可立即创建渲染器并 Initialize；
+         *                  之后到达的块追加到同一个可增长 MeshBuffer（见 MeshBuffer::AppendToGPU），渲染器自动绘制
+         * @param onComplete 全部上传后调用（打开失败或加载器析构时为 false，已到达的部分仍可绘制）
+         *
+         * - ✅ 首个像素的时间取决于第一个文件窗口和第一块，而不是整个文件
+         * - ✅ 常驻内存：属性数组 + 一个文件窗口 + 上传队列（≤ streamPendingBytes，超过时解析线程等待）+ GPU 缓冲区
+         * - ✅ 解析在独立线程进行，窗口内仍在线程池上并行分块解析
+         * - ⚠️ 不经过 AssetRegistry 和 .lmesh 缓存，不量化、不切簇、不生成 LOD（适用于只加载一次的超大扫描模型）
+         */
+        void StreamOBJ(const std::string& objPath, StreamSubmeshCallback onSubmesh,
+                       StreamDoneCallback onComplete = nullptr, const OBJStreamConfig& config = OBJStreamConfig());
+
+        void LoadCube(MeshCallback callback);
+        void LoadPlane(float width, float height, int widthSegments, int heightSegments, MeshCallback callback);
+        void LoadSphereLOD(int stacks, int slices, float radius, size_t levelCount, MeshCallback callback);
+        void LoadTorusLOD(float majorRadius, float minorRadius, int majorSegments, int minorSegments,
+                          size_t levelCount, MeshCallback callback);
+
+        // ============================================================
+        // 纹理
+        // ============================================================
+
+        /**
+         * @brief 在工作线程解码纹理（规则同 Texture::LoadFromFile），上传后回调（失败时参数为空）
+         */
+        void LoadTexture(const std::string& filepath, TextureCallback callback);
+
+        // ============================================================
+        // 每帧驱动
+        // ============================================================
+
+        /**
+         * @brief 在预算内执行上传任务和完成回调
+         * @return 本次执行的任务数
+         */
+        size_t ProcessUploads();
+
+        /**
+         * @brief 等待所有请求完成（不限预算），包括回调中发出的新请求
+         */
+        void Flush();
+
+        AssetLoadProgress GetProgress() const;
+        bool IsIdle() const { return GetProgress().IsComplete(); }
+
+    private:
+        struct UploadTask
+        {
+            std::string name;
+            size_t bytes = 0;
+            std::function<void()> run;
+        };
+
+        struct MeshJob;
+        struct TextureJob;
+        struct StreamJob;
+
+        void StartMeshJob(const std::string& key, MeshBuildFunc build, MeshCallback callback,
+                          std::vector<std::shared_ptr<const void>> dependencies, std::function<void()> onUploaded,
+                          bool loadTextures, TextureStreamer* textureStreamer = nullptr);
+        void SubmitMeshJob(const std::shared_ptr<MeshJob>& job, MeshBuildFunc build);
+        void FinishMeshJob(const std::shared_ptr<MeshJob>& job);
+        void SubmitTextureJob(const std::shared_ptr<TextureJob>& job);
+        void AppendStreamChunk(const std::shared_ptr<StreamJob>& job, int material, const MeshData& chunk,
+                               const std::shared_ptr<TextureSource>& texture);
+        void FinishStreamJob(const std::shared_ptr<StreamJob>& job, bool success);
+        bool WaitForUploadSpace();
+
+        void Enqueue(std::vector<UploadTask>&& tasks);
+        size_t Drain(bool ignoreBudget);
+        void PruneFinishedWork();
+
+        AssetLoaderConfig m_config;
+
+        mutable std::mutex m_queueMutex;
+        std::deque<UploadTask> m_uploads;              // 工作线程写入，渲染线程读取
+        std::condition_variable m_uploadDrained;       // 队列字节数下降（流式导入的背压）
+        bool m_stopping = false;                       // 析构中：流式导入停止等待并取消
+
+        // 以下只在渲染线程访问
+        std::unordered_map<std::string, std::shared_ptr<MeshJob>> m_meshJobs;        // 进行中的网格请求（按键合并）
+        std::unordered_map<std::string, std::shared_ptr<TextureJob>> m_textureJobs;  // 进行中的纹理请求（按路径合并）
+        std::vector<std::future<void>> m_work;
+
+        std::atomic<size_t> m_requested{0};
+        std::atomic<size_t> m_decoded{0};
+        std::atomic<size_t> m_completed{0};
+        std::atomic<size_t> m_failed{0};
+        std::atomic<size_t> m_pendingUploadBytes{0};
+    };
+
+} // namespace Renderer
@@ -0,0 +1,190 @@
+#pragma once
+#include "Renderer/Data/MeshBuffer.hpp"
+#include "Renderer/Data/MeshSimplifier.hpp"
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Renderer
+{
+    class MaterialAtlas;
+    class MaterialTable;
+
+    /**
+     * @class MeshAsset
+     * @brief 一个已上传的网格资源：若干子网格（每个材质一个），每个子网格一条 LOD 链
+     *
+     * GetMesh() / GetLODs() 返回的 shared_ptr 与资源共享引用计数（别名构造），
+     * 渲染器持有任意一个子网格都会让整个资源保持加载。
+     */
+    class MeshAsset : public std::enable_shared_from_this<MeshAsset>
+    {
+    public:
+        MeshAsset(std::string key, std::vector<std::vector<MeshBuffer>>&& submeshes,
+                  std::vector<std::shared_ptr<const void>> dependencies = {});
+        ~MeshAsset();
+
+        MeshAsset(const MeshAsset&) = delete;
+        MeshAsset& operator=(const MeshAsset&) = delete;
+
+        const std::string& GetKey() const { return m_key; }
+        size_t GetSubmeshCount() const { return m_submeshes.size(); }
+        size_t GetLODCount(size_t submesh) const { return m_submeshes[submesh].size(); }
+
+        /**
+         * @brief 子网格的某一级 LOD（与资源共享引用计数）
+         */
+        std::shared_ptr<MeshBuffer> GetMesh(size_t submesh = 0, size_t lod = 0) const;
+
+        /**
+         * @brief 子网格的整条 LOD 链（可直接传给 InstancedRenderer::SetLODMeshes）
+         */
+        std::vector<std::shared_ptr<MeshBuffer>> GetLODs(size_t submesh = 0) const;
+
+        /**
+         * @brief 所有子网格的 LOD0
+         */
+        std::vector<std::shared_ptr<MeshBuffer>> GetMeshes() const;
+
+        size_t GetCPUBytes() const { return m_cpuBytes; }
+        size_t GetGPUBytes() const { return m_gpuBytes; }
+
+    private:
+        std::string m_key;
+        std::vector<std::vector<MeshBuffer>> m_submeshes;  // [子网格][LOD]
+        std::vector<std::shared_ptr<const void>> m_dependencies;  // 网格数据引用的外部对象（图集、材质表）
+        size_t m_cpuBytes = 0;
+        size_t m_gpuBytes = 0;
+    };
+
+    using MeshHandle = std::shared_ptr<const MeshAsset>;
+
+    /**
+     * @struct AssetInfo
+     * @brief 已加载资源的统计
+     */
+    struct AssetInfo
+    {
+        std::string key;
+        long references = 0;  // 句柄和渲染器持有的子网格引用之和
+        size_t cpuBytes = 0;
+        size_t gpuBytes = 0;
+    };
+
+    /**
+     * @class AssetRegistry
+     * @brief 网格资源注册表 - 相同的导入 / 程序化网格只加载一次，引用计数归零时自动卸载
+     *
+     * 设计方案：
+     * - ✅ 导入网格以“路径 + 导入选项”为键，程序化网格以“工厂名 + 参数”为键
+     * - ✅ 注册表只保存 weak_ptr：最后一个句柄（或持有其子网格的渲染器）释放时，
+     *      MeshAsset 析构，GPU 缓冲区随之释放，注册表条目在下次访问时清理
+     * - ✅ 多个 InstancedRenderer 共享同一 MeshBuffer，各自使用自己的 VAO 配置实例属性
+     *
+     * 使用方式：
+     * @code
+     * auto& registry = AssetRegistry::GetInstance();
+     * MeshHandle plane = registry.GetPlane(1.0f, 1.0f, 1, 1);
+     * floorRenderer->SetMesh(plane->GetMesh());
+     * platformRenderer->SetMesh(plane->GetMesh());   // 同一份 VBO/EBO
+     * @endcode
+     *
+     * @note 只能在 OpenGL 上下文所在线程调用（加载时上传 GPU）
+     */
+    class AssetRegistry
+    {
+    public:
+        static AssetRegistry& GetInstance();
+
+        AssetRegistry(const AssetRegistry&) = delete;
+        AssetRegistry& operator=(const AssetRegistry&) = delete;
+
+        // ============================================================
+        // 导入网格（键：路径 + 导入选项）
+        // ============================================================
+
+        MeshHandle LoadOBJ(const std::string& objPath, bool quantize = true);
+
+        /**
+         * @brief 导入 .gltf / .glb（每个图元一个子网格，见 MeshBufferFactory::CreateGLTFBuffers）
+         */
+        MeshHandle LoadGLTF(const std::string& gltfPath, bool quantize = true);
+
+        /**
+         * @brief 纹理数组版本（键包含 atlas / materialTable：层索引和材质索引只对该图集 / 材质表有效）
+         * @param lodConfig 为空时不生成 LOD
+         * @note 资源持有 atlas / materialTable 的引用，保证键中的地址在资源存活期间不被复用
+         */
+        MeshHandle LoadOBJAtlas(const std::string& objPath, const std::shared_ptr<MaterialAtlas>& atlas,
+                                const std::shared_ptr<MaterialTable>& materialTable = nullptr,
+                                const MeshLODConfig* lodConfig = nullptr, bool quantize = true);
+
+        /**
+         * @brief 共享的默认材质图集（未指定图集的导入共用，使重复导入能够命中缓存）
+         * @note 注册表只保存 weak_ptr，最后一个使用者释放后图集随之销毁（不会在 GL 上下文销毁后才释放纹理）
+         */
+        std::shared_ptr<MaterialAtlas> GetDefaultAtlas();
+
+        // ============================================================
+        // 程序化网格（键：工厂名 + 参数）
+        // ============================================================
+
+        MeshHandle GetCube();
+        MeshHandle GetPlane(float width, float height, int widthSegments, int heightSegments);
+        MeshHandle GetSphere(int stacks, int slices, float radius);
+        MeshHandle GetSphereLOD(int stacks, int slices, float radius, size_t levelCount);
+        MeshHandle GetTorus(float majorRadius, float minorRadius, int majorSegments, int minorSegments);
+        MeshHandle GetTorusLOD(float majorRadius, float minorRadius, int majorSegments, int minorSegments,
+                               size_t levelCount);
+
+        /**
+         * @brief 通用入口：键已加载时返回现有资源，否则调用 create 创建（[子网格][LOD]，已上传）
+         */
+        MeshHandle GetOrCreate(const std::string& key,
+                               const std::function<std::vector<std::vector<MeshBuffer>>()>& create,
+                               std::vector<std::shared_ptr<const void>> dependencies = {});
+
+        /**
+         * @brief 查找已加载的资源（不创建、不计入命中统计）
+         */
+        MeshHandle Find(const std::string& key) const;
+
+        // ============================================================
+        // 资源键（AssetLoader 使用同样的键，异步与同步加载共享缓存）
+        // ============================================================
+
+        static std::string OBJKey(const std::string& objPath, bool quantize = true);
+        static std::string GLTFKey(const std::string& gltfPath, bool quantize = true);
+        static std::string OBJAtlasKey(const std::string& objPath, const MaterialAtlas* atlas,
+                                       const MaterialTable* materialTable, const MeshLODConfig* lodConfig,
+                                       bool quantize = true);
+        static std::string ProceduralKey(const std::string& kind, std::initializer_list<float> params);
+
+        // ============================================================
+        // 统计
+        // ============================================================
+
+        std::vector<AssetInfo> GetAssetInfos() const;
+        size_t GetImportCount() const { return m_importCount; }  // 实际执行的创建次数（缓存未命中）
+        size_t GetHitCount() const { return m_hitCount; }
+        void LogStats() const;
+
+    private:
+        AssetRegistry() = default;
+
+        static std::string FormatFloat(float value);
+        void PurgeExpired();
+
+        mutable std::mutex m_mutex;
+        std::unordered_map<std::string, std::weak_ptr<const MeshAsset>> m_assets;
+        std::weak_ptr<MaterialAtlas> m_defaultAtlas;
+        size_t m_importCount = 0;
+        size_t m_hitCount = 0;
+    };
+
+} // namespace Renderer
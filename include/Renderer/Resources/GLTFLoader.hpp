@@ -0,0 +1,109 @@
+#pragma once
+#include "Renderer/Data/MeshData.hpp"
+#include "Renderer/Resources/OBJLoader.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Renderer
+{
+
+    /**
+     * @struct GLTFPrimitive
+     * @brief glTF 的一个三角形图元（节点的世界变换已烘焙到顶点）
+     */
+    struct GLTFPrimitive
+    {
+        std::string name;          // 所属 mesh 的名称（无名称时为 "mesh<下标>"）
+        int materialIndex = -1;    // GLTFLoader::GetMaterials() 中的下标，-1 表示默认材质
+        MeshData data;             // 位置(location 0) + 法线(1) + UV(2)，可能是文件映射的视图
+    };
+
+    /**
+     * @struct GLTFImportStats
+     * @brief 导入统计（零拷贝映射了多少顶点 / 索引缓冲区）
+     */
+    struct GLTFImportStats
+    {
+        size_t primitives = 0;
+        size_t mappedVertexBuffers = 0;  // 交错 float 属性直接引用文件映射
+        size_t mappedIndexBuffers = 0;   // 32 位索引直接引用文件映射
+        size_t vertices = 0;
+        size_t triangles = 0;
+    };
+
+    /**
+     * @class GLTFLoader
+     * @brief glTF 2.0 / GLB 导入器 - 内存映射二进制数据，访问器直接映射为 MeshData 布局
+     *
+     * 设计方案：
+     * - ✅ .glb 整个文件内存映射（Core::MappedFile），BIN 块即 buffer 0；.gltf 的外部 .bin 同样映射，
+     *      data: URI 的缓冲区解码到内存
+     * - ✅ 位置 / 法线 / UV 为同一个 bufferView 中交错的 float 属性时，MeshData 直接引用映射（SetVertexView，
+     *      偏移按访问器的 byteOffset 计算）；32 位索引同样直接引用（SetIndexView）——只做边界检查，不拷贝
+     * - ✅ 其他情况（非交错、归一化整数属性、缺少法线 / UV、节点带变换）拷贝为 位置(3) + 法线(3) + UV(2) = 8 floats；
+     *      16 / 8 位索引展开为 32 位（MeshBuffer 上传时会重新收窄为 16 位）
+     * - ✅ 材质转换为 OBJMaterial：baseColor → diffuse / dissolve，roughness → shininess，metallic → specular；
+     *      纹理名相对 GetBasePath()，与 OBJ 一致；嵌入的图像（bufferView / data URI）不写出文件，
+     *      纹理路径为 "<glTF 路径>#image<N>"，Texture::Decode 通过 ReadEmbeddedImage 在内存中解码
+     * - ⚠️ 只导入默认场景中三角形类图元（TRIANGLES / STRIP / FAN），忽略蒙皮、变形目标、动画和相机
+     * - ⚠️ 不支持 KHR_draco_mesh_compression / EXT_meshopt_compression
+     *
+     * 使用方式：
+     * @code
+     * GLTFLoader loader;
+     * if (loader.LoadFromFile("assets/models/helmet.glb")) {
+     *     for (auto& primitive : loader.GetPrimitives()) { ... }
+     * }
+     * @endcode
+     *
+     * @note 纯 CPU，可在工作线程执行（见 AssetLoader::LoadGLTF）
+     */
+    class GLTFLoader
+    {
+    public:
+        GLTFLoader();
+        ~GLTFLoader();
+
+        // 加载 .gltf / .glb 文件
+        bool LoadFromFile(const std::string& filepath);
+
+        // 获取图元（非 const 版本用于移出 MeshData）
+        const std::vector<GLTFPrimitive>& GetPrimitives() const { return m_primitives; }
+        std::vector<GLTFPrimitive>& GetPrimitives() { return m_primitives; }
+
+        // 获取材质数据（glTF materials 数组顺序）
+        const std::vector<OBJMaterial>& GetMaterials() const { return m_materials; }
+
+        // 获取基础路径（纹理名相对于此目录）
+        const std::string& GetBasePath() const { return m_basePath; }
+
+        const GLTFImportStats& GetStats() const { return m_stats; }
+
+        // 导入读取的文件：glTF 本身 + 外部 .bin 缓冲区（网格缓存的依赖文件）
+        const std::vector<std::string>& GetSourceFiles() const { return m_sourceFiles; }
+
+        // 嵌入图像的纹理路径："<glTF 路径>#image<N>"
+        static std::string MakeEmbeddedImageKey(const std::string& gltfPath, int imageIndex);
+
+        // 拆分嵌入图像路径（前缀须为 .gltf / .glb），不是嵌入图像路径时返回 false
+        static bool ParseEmbeddedImageKey(const std::string& key, std::string& outGLTFPath, int& outImageIndex);
+
+        // 读取嵌入图像的编码数据（PNG / JPEG），只解析 JSON 和缓冲区，不导入网格、不写文件
+        static bool ReadEmbeddedImage(const std::string& key, std::vector<uint8_t>& outBytes);
+
+        // 清理数据
+        void Clear();
+
+    private:
+        // 解析细节（JSON、缓冲区、节点遍历）在 GLTFLoader.cpp 的匿名命名空间中
+        std::vector<GLTFPrimitive> m_primitives;
+        std::vector<OBJMaterial> m_materials;
+        std::string m_basePath;
+        std::vector<std::string> m_sourceFiles;
+        GLTFImportStats m_stats;
+    };
+
+} // namespace Renderer
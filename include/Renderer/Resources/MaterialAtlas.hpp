@@ -0,0 +1,98 @@
+#pragma once
+#include "Renderer/Resources/TextureArray.hpp"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Renderer
+{
+
+    /**
+     * @struct AtlasSlot
+     * @brief 纹理在 MaterialAtlas 中的位置
+     */
+    struct AtlasSlot
+    {
+        int arrayIndex = -1;  // 分辨率档位（对应一个 TextureArray）
+        int layer = -1;       // 数组内的层索引
+
+        bool IsValid() const { return arrayIndex >= 0 && layer >= 0; }
+    };
+
+    /**
+     * @class MaterialAtlas
+     * @brief 材质纹理图集 - 将多个材质纹理打包为按分辨率分组的纹理数组
+     *
+     * 设计方案：
+     * - 每张纹理按较长边向上取整到 2 的幂，得到分辨率档位（限制在 [minSize, maxSize]）
+     * - 同一档位的纹理打包为一个 GL_TEXTURE_2D_ARRAY，非正方形/非 2 的幂纹理缩放到档位尺寸
+     * - AddTexture() 立即返回槽位（层索引在加入时确定），Build() 统一上传
+     * - 每个档位的 TextureArray 对象在档位创建时确定、之后不再替换：Build() 把新增纹理写入预留的空闲层，
+     *   空闲层不足时按 2 的幂扩容并在同一对象上重建，已持有 GetArray() 结果的渲染器无需重新获取
+     * - 可在多个模型间共享（整个场景的材质共用少量纹理数组）
+     * - AddTexture() / 查询可在加载线程调用（内部加锁）；Build() 只在渲染线程调用，解码和上传时不持锁
+     *
+     * 使用方式：
+     * @code
+     * auto atlas = std::make_shared<MaterialAtlas>();
+     * AtlasSlot slot = atlas->AddTexture("car/body.png");
+     * atlas->Build();  // 只上传新增的层（容量不足时整档重建）
+     * atlas->GetArray(slot.arrayIndex)->Bind();
+     * @endcode
+     */
+    class MaterialAtlas
+    {
+    public:
+        explicit MaterialAtlas(int minSize = 64, int maxSize = 2048);
+
+        MaterialAtlas(const MaterialAtlas&) = delete;
+        MaterialAtlas& operator=(const MaterialAtlas&) = delete;
+
+        /**
+         * @brief 添加纹理（相同路径只添加一次）
+         * @return 槽位；文件无法读取时返回无效槽位
+         */
+        AtlasSlot AddTexture(const std::string& filepath);
+
+        /**
+         * @brief 上传所有分辨率档位中新增的纹理（渲染线程）
+         * @return 所有档位是否都上传成功
+         */
+        bool Build();
+
+        /**
+         * @brief 查询已添加纹理的槽位
+         */
+        AtlasSlot GetSlot(const std::string& filepath) const;
+
+        size_t GetArrayCount() const;
+        std::shared_ptr<TextureArray> GetArray(size_t arrayIndex) const;
+        int GetArraySize(size_t arrayIndex) const;
+        size_t GetTextureCount() const;
+
+        /**
+         * @brief 所有纹理数组的显存占用
+         */
+        size_t GetGPUSizeBytes() const;
+
+    private:
+        struct ResolutionClass
+        {
+            int size = 0;
+            std::vector<std::string> paths;
+            std::shared_ptr<TextureArray> array;   // 档位创建时分配，Build() 原地更新
+            size_t uploadedLayers = 0;             // 已上传到 array 的层数
+        };
+
+        int m_minSize;
+        int m_maxSize;
+        mutable std::mutex m_mutex;    // 保护 m_classes / m_slots（不保护 TextureArray 本身，它只在渲染线程访问）
+        std::vector<ResolutionClass> m_classes;
+        std::unordered_map<std::string, AtlasSlot> m_slots;
+
+        int GetResolutionClassSize(int width, int height) const;
+    };
+
+} // namespace Renderer
@@ -0,0 +1,110 @@
+#pragma once
+#include "Renderer/Resources/OBJLoader.hpp"
+#include "Renderer/Resources/MaterialAtlas.hpp"
+#include "Core/GLM.hpp"
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Renderer
+{
+
+    /**
+     * @struct GPUMaterial
+     * @brief 材质表中的单个条目（std140 布局，64 字节）
+     *
+     * 与着色器中的 struct Material 一一对应：
+     * - ambient:  rgb = Ka, a = dissolve
+     * - diffuse:  rgb = Kd, a = 纹理数组层（-1 表示无纹理）
+     * - specular: rgb = Ks, a = shininess
+     * - params:   x = 纹理数组索引（MaterialAtlas 分辨率档位），yzw 预留
+     */
+    struct GPUMaterial
+    {
+        glm::vec4 ambient;
+        glm::vec4 diffuse;
+        glm::vec4 specular;
+        glm::vec4 params;
+    };
+
+    static_assert(sizeof(GPUMaterial) == 64, "GPUMaterial must match std140 layout (4 x vec4)");
+
+    /**
+     * @class MaterialTable
+     * @brief 材质表 - 将所有材质参数打包进一个 Uniform Buffer
+     *
+     * 设计方案：
+     * - ✅ 每个材质 64 字节，最多 MAX_MATERIALS 个（16KB，GL 3.3 保证的最小 UBO 大小）
+     * - ✅ 绘制时通过材质索引查表：每顶点属性（location 9）或每次绘制的常量属性
+     * - ✅ 切换材质不再需要 uniform 调用，不同材质的网格可以合并为一次绘制
+     * - ✅ 绑定到 UniformBinding::MATERIAL_TABLE
+     * - ✅ Add / AddColor / Set / Get 可在加载线程调用（内部加锁），Upload / Bind 只在渲染线程调用
+     *
+     * 使用方式：
+     * @code
+     * auto table = std::make_shared<MaterialTable>();
+     * unsigned int index = table->Add(material, atlasSlot, "car.obj#Body");
+     * table->Upload();
+     * shader.BindUniformBlock("MaterialTable", static_cast<unsigned>(UniformBinding::MATERIAL_TABLE));
+     * table->Bind();
+     * @endcode
+     */
+    class MaterialTable
+    {
+    public:
+        static constexpr unsigned int MAX_MATERIALS = 256;
+
+        MaterialTable();
+        ~MaterialTable();
+
+        MaterialTable(const MaterialTable&) = delete;
+        MaterialTable& operator=(const MaterialTable&) = delete;
+
+        /**
+         * @brief 添加材质（相同 key 只添加一次）
+         * @param material OBJ 材质
+         * @param slot 漫反射纹理在图集中的位置（无纹理时为无效槽位）
+         * @param key 去重键（例如 "模型路径#材质名"），为空时总是新增
+         * @return 材质索引；表已满时返回 0（默认材质）
+         */
+        unsigned int Add(const OBJMaterial& material, const AtlasSlot& slot = AtlasSlot(), const std::string& key = "");
+
+        /**
+         * @brief 添加纯色材质
+         */
+        unsigned int AddColor(const glm::vec3& diffuse, float shininess = 32.0f, const std::string& key = "");
+
+        /**
+         * @brief 修改已有材质（下次 Upload() 时生效）
+         */
+        void Set(unsigned int index, const GPUMaterial& material);
+        GPUMaterial Get(unsigned int index) const;
+
+        /**
+         * @brief 将修改过的材质上传到 GPU（首次调用时创建 UBO）
+         */
+        void Upload();
+
+        /**
+         * @brief 绑定到 UniformBinding::MATERIAL_TABLE
+         */
+        void Bind() const;
+
+        size_t GetCount() const;
+        unsigned int GetBufferID() const { return m_ubo; }
+
+    private:
+        mutable std::mutex m_mutex;    // 保护材质数据和脏范围（加载线程 Add 与渲染线程 Upload 并发）
+        std::vector<GPUMaterial> m_materials;
+        std::unordered_map<std::string, unsigned int> m_keyToIndex;
+        unsigned int m_ubo = 0;
+        size_t m_uploadedCount = 0;    // 已上传的条目数
+        size_t m_dirtyBegin = 0;       // 需要重新上传的范围 [m_dirtyBegin, m_dirtyEnd)
+        size_t m_dirtyEnd = 0;
+
+        unsigned int Append(const GPUMaterial& material, const std::string& key);  // 调用方已持有 m_mutex
+        void MarkDirty(size_t index);
+    };
+
+} // namespace Renderer
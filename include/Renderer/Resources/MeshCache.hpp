@@ -0,0 +1,156 @@
+#pragma once
+
+#include "Renderer/Geometry/OBJModel.hpp"
+#include "Renderer/Data/MeshData.hpp"
+#include "Core/GLM.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Renderer
+{
+
+    /**
+     * @struct MeshCacheSubmesh
+     * @brief .lmesh 中的一个子网格（一个材质），顶点/索引指针直接指向内存映射
+     */
+    struct MeshCacheSubmesh
+    {
+        const float* vertices = nullptr;        // 交错顶点（位置 3 + 法线 3 + UV 2，或 MeshQuantizer 布局）
+        uint32_t vertexCount = 0;
+        uint32_t vertexStride = 0;              // 每个顶点的字数（4 字节）
+        const unsigned int* indices = nullptr;
+        uint32_t indexCount = 0;
+        glm::vec3 boundsMin = glm::vec3(0.0f);  // 轴对齐包围盒
+        glm::vec3 boundsMax = glm::vec3(0.0f);
+        OBJMaterial material;
+        std::string texturePath;                // 与 OBJModel::MaterialVertexData::texturePath 相同
+        bool quantized = false;                 // 顶点为 MeshQuantizer 布局
+        glm::vec3 positionScale = glm::vec3(1.0f);  // 量化位置的反量化参数
+        glm::vec3 positionOffset = glm::vec3(0.0f);
+        std::vector<Meshlet> meshlets;          // 写入时已构建的簇（可为空）
+    };
+
+    /**
+     * @class MeshCache
+     * @brief 二进制网格缓存（.lmesh），首次导入 OBJ 后写入，之后通过 mmap 零拷贝加载
+     *
+     * 文件布局（小端，所有数据块 16 字节对齐）：
+     * - 头部：魔数 "LMSH"、版本、各表偏移
+     * - 依赖表：OBJ 及其 mtllib 文件的大小、修改时间、内容哈希（FNV-1a 64）
+     * - 子网格表：顶点/索引/簇块偏移、数量、包围盒、材质参数、反量化参数和字符串引用
+     * - 字符串表、顶点块、索引块、簇块
+     *
+     * 两种顶点布局（一个文件只有一种）：
+     * - float（foo.lmesh）：OBJModel::MaterialVertexData，OBJ 导入路径的中间结果
+     * - 量化（foo.obj.q.lmesh / foo.glb.q.lmesh）：PrepareForUpload 之后的上传布局，
+     *   打开后直接作为 MeshData 视图上传，不再拷贝和重新量化
+     *
+     * 失效规则：
+     * - ✅ 任一依赖文件大小变化或丢失 → 失效
+     * - ✅ 大小相同但修改时间变化 → 比较内容哈希，相同则仍然有效（例如 git checkout 只改了时间戳）
+     * - ✅ 版本号不同 → 失效
+     *
+     * 使用方式：
+     * @code
+     * if (auto cache = MeshCache::Open(objPath)) {
+     *     for (const auto& submesh : cache->GetSubmeshes()) { ... submesh.vertices ... }
+     * }
+     * @endcode
+     *
+     * @note lumen-cook 把同样的 .lmesh 数据（依赖表为空）嵌入 .lpak 打包文件，见 AssetArchive
+     */
+    class MeshCache
+    {
+    public:
+        static constexpr uint32_t kVersion = 3;  // v3：可选的量化布局 + 簇
+
+        /**
+         * @brief 缓存文件路径（foo.obj → foo.lmesh；量化布局 foo.obj → foo.obj.q.lmesh）
+         */
+        static std::string GetCachePath(const std::string& sourcePath, bool quantized = false);
+
+        /**
+         * @brief 打开并校验 sourcePath 对应的缓存
+         * @param quantized 打开量化布局的缓存（缓存键的一部分，布局不符时视为未命中）
+         * @note 已挂载的 AssetArchive 中有对应网格条目且未过期时直接引用打包文件
+         *       （float 条目名为 sourcePath，量化条目名为 GetCachePath(sourcePath, true)）
+         * @return 缓存不存在、已过期或损坏时返回 nullptr
+         */
+        static std::shared_ptr<const MeshCache> Open(const std::string& sourcePath, bool quantized = false);
+
+        /**
+         * @brief OBJ 及其 mtllib 文件的路径（相对工作目录，缓存依赖表 / 打包条目的源文件）
+         */
+        static std::vector<std::string> GetSourceFiles(const std::string& sourcePath);
+
+        /**
+         * @brief 从内存中的 .lmesh 数据创建（不拷贝，不校验依赖文件）
+         * @param owner 持有 data 的对象（如 AssetArchive），生命周期延长到缓存及其视图释放
+         * @param sourcePath 原始 OBJ 路径，用于生成纹理路径
+         */
+        static std::shared_ptr<const MeshCache> OpenMemory(const uint8_t* data, size_t size,
+                                                           std::shared_ptr<const void> owner,
+                                                           const std::string& sourcePath);
+
+        /**
+         * @brief 写入缓存（先写临时文件再重命名，避免其他进程映射到半个文件）
+         */
+        static bool Write(const std::string& sourcePath, const std::vector<OBJModel::MaterialVertexData>& submeshes,
+                          std::string* error = nullptr);
+
+        /**
+         * @brief 序列化为 .lmesh 字节流，不记录依赖文件（打包文件由 lumen-cook 整体重新生成）
+         */
+        static bool WriteToMemory(const std::string& sourcePath,
+                                  const std::vector<OBJModel::MaterialVertexData>& submeshes,
+                                  std::vector<uint8_t>& outBytes, std::string* error = nullptr);
+
+        /**
+         * @brief 序列化已 PrepareForUpload 的量化网格（只接受位置 / 法线 / UV 三个属性的量化布局）
+         * @param sourceFiles 依赖文件（相对工作目录，第一个为源文件）；为空时不记录依赖（打包用）
+         * @note 纹理路径必须位于源文件目录下（OBJ 纹理、glTF 外部图片和内嵌图片键均满足）
+         */
+        static bool SerializeQuantized(const std::string& sourcePath, const std::vector<MeshData>& meshes,
+                                       const std::vector<std::string>& sourceFiles, std::vector<uint8_t>& outBytes,
+                                       std::string* error = nullptr);
+
+        /**
+         * @brief 写入量化布局的缓存（GetCachePath(sourcePath, true)）
+         */
+        static bool WriteQuantized(const std::string& sourcePath, const std::vector<MeshData>& meshes,
+                                   const std::vector<std::string>& sourceFiles, std::string* error = nullptr);
+
+        /**
+         * @brief 每个子网格一个 MeshData，顶点 / 索引为指向缓存的视图（缓存随视图存活）
+         * @note 量化缓存同时恢复属性布局、反量化参数和簇，可直接上传
+         */
+        static std::vector<MeshData> ToMeshData(const std::shared_ptr<const MeshCache>& cache);
+
+        const std::vector<MeshCacheSubmesh>& GetSubmeshes() const { return m_submeshes; }
+        bool IsQuantized() const { return m_quantized; }
+        const std::string& GetPath() const { return m_path; }
+        size_t GetSizeBytes() const { return m_size; }
+
+        /**
+         * @brief 拷贝为 OBJModel::MaterialVertexData（需要修改顶点数据的调用者使用）
+         * @note 只适用于 float 布局，量化缓存返回空
+         */
+        std::vector<OBJModel::MaterialVertexData> ToMaterialVertexData() const;
+
+    private:
+        MeshCache() = default;
+
+        bool Parse(std::string& error);
+        void ResolveTexturePaths(const std::string& sourcePath);
+
+        std::shared_ptr<const void> m_storage;  // Core::MappedFile 或打包文件
+        const uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+        std::string m_path;
+        std::vector<MeshCacheSubmesh> m_submeshes;
+        bool m_quantized = false;
+    };
+
+} // namespace Renderer
@@ -63,14 +63,62 @@ namespace Renderer
         std::string normalTexname;
     };
 
+    // OBJ 文本解析后端（两者输出逐字节一致，TinyObj 保留用于对照验证）
+    enum class OBJParserBackend
+    {
+        Parallel,  // OBJParser：内存映射 + 多线程分块解析（默认）
+        TinyObj    // tinyobj::LoadObj：单线程流式解析
+    };
+
+    /**
+     * @struct OBJStreamConfig
+     * @brief 流式导入配置（见 OBJLoader::LoadStreaming）
+     *
+     * ⚠️ 流式导入要求 v / vn / vt 出现在引用它们的 f 之前（常见导出器都满足）：
+     * 面在所在窗口解析完后立即转换，此时只能看到已解析的属性；引用尚未出现或越界的索引会使导入失败
+     */
+    struct OBJStreamConfig
+    {
+        size_t chunkTriangles = 16384;             // 每个材质攒够多少三角形输出一块（上限 kMaxChunkTriangles）
+        size_t windowBytes = 32ull * 1024 * 1024;  // 每次解析的文件窗口大小
+    };
+
+    /**
+     * @struct OBJMeshChunk
+     * @brief 流式导入输出的一块网格：单一材质，块内局部索引（顶点数 ≤ 65536，可直接用 16 位索引）
+     */
+    struct OBJMeshChunk
+    {
+        int materialIndex = -1;               // OBJLoader::GetMaterials() 中的下标，-1 表示无材质
+        std::vector<OBJVertex> vertices;
+        std::vector<unsigned int> indices;
+    };
+
     class OBJLoader
     {
     public:
+        // 每块最多 21845 个三角形：即使没有共享顶点，块内顶点数也不超过 65535
+        static constexpr size_t kMaxChunkTriangles = 65535 / 3;
+
+        using ChunkCallback = std::function<bool(OBJMeshChunk&& chunk)>;
+
         OBJLoader();
         ~OBJLoader();
 
         // 加载OBJ文件
-        bool LoadFromFile(const std::string& filepath);
+        bool LoadFromFile(const std::string& filepath, OBJParserBackend backend = OBJParserBackend::Parallel);
+
+        /**
+         * @brief 流式加载：边解析边按材质输出网格块，不保留完整的顶点 / 索引数组
+         * @param onChunk 在调用线程执行，返回 false 取消加载；回调中 GetMaterials() 为目前已加载的材质
+         * @return 文件无法打开或被取消时返回 false（取消之前输出的块仍然有效）
+         *
+         * 与 LoadFromFile 的区别：
+         * - ✅ 常驻内存为属性数组（v / vn / vt）+ 一个文件窗口的面 + 每个材质一个未满的块
+         * - ⚠️ 顶点只在块内去重，跨块共享的顶点会重复；GetVertices() / GetIndices() 保持为空
+         * - ⚠️ 没有材质的面（包括在材质文件之前的面）单独输出为 materialIndex = -1 的块
+         */
+        bool LoadStreaming(const std::string& filepath, const OBJStreamConfig& config, const ChunkCallback& onChunk);
 
         // 获取解析后的顶点数据
         const std::vector<OBJVertex>& GetVertices() const { return m_vertices; }
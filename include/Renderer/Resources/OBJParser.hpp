@@ -0,0 +1,64 @@
+#pragma once
+
+#include "tiny_obj_loader.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Renderer
+{
+
+    /**
+     * @namespace OBJParser
+     * @brief 多线程 OBJ 解析器（替代 tinyobj::LoadObj 的文本解析部分）
+     *
+     * 流程：
+     * - ✅ Core::MappedFile 映射整个文件，按行边界切成若干块
+     * - ✅ 每块在 Core::ThreadPool 上独立解析 v / vn / vt / f，并记录 usemtl / mtllib / g / o 事件
+     * - ✅ 按块计数做前缀和得到全局偏移，并行拼接属性数组并修正相对（负）索引
+     * - ✅ 事件按文件顺序串行回放：加载材质、解析 usemtl、按 tinyobj 的规则划分 shape
+     *
+     * 输出与 tinyobj::LoadObj(..., triangulate = true) 逐字节一致：
+     * - 浮点数使用与 tinyobj 相同的 tryParseDouble 算法（std::from_chars 是正确舍入的，个别输入会差 1 ulp）
+     * - 面按扇形三角化，索引规则（atoi + fixIndex）、缺省值和 shape 划分保持不变
+     * - MTL 文件仍由 tinyobj::MaterialFileReader 读取
+     * - ⚠️ 兼容 tinyobj 的行为：usemtl 之后紧跟 g / o 且其间没有面时，之前已按材质刷新的面会被丢弃
+     */
+    namespace OBJParser
+    {
+        /**
+         * @brief 解析 OBJ 文件（参数和返回值语义同 tinyobj::LoadObj，始终三角化）
+         * @param basePath mtllib 的查找目录（需以路径分隔符结尾，可为空）
+         * @param err 追加警告和错误信息（tinyobj 的 "WARN: ..." 格式）
+         */
+        bool LoadObj(tinyobj::attrib_t* attrib, std::vector<tinyobj::shape_t>* shapes,
+                     std::vector<tinyobj::material_t>* materials, std::string* err,
+                     const std::string& filepath, const std::string& basePath);
+
+        /**
+         * @brief 流式回调：每个文件窗口解析完成后调用一次
+         * @param attrib 到目前为止的全部属性（面可以引用之前任意位置的顶点，属性数组随文件增长）
+         * @param materials 到目前为止加载的材质
+         * @param corners 本窗口的三角形角点（每个三角形 3 个，已是全局索引）
+         * @param materialIds 本窗口每个三角形的材质（-1 表示无材质）
+         * @return false 时停止解析
+         */
+        using TriangleSink = std::function<bool(const tinyobj::attrib_t& attrib,
+                                                const std::vector<tinyobj::material_t>& materials,
+                                                const std::vector<tinyobj::index_t>& corners,
+                                                const std::vector<int>& materialIds)>;
+
+        /**
+         * @brief 流式解析：按 windowBytes 大小的文件窗口顺序推进（窗口内仍多线程分块解析），逐窗口交给 sink
+         * @param windowBytes 窗口大小（至少 1MB），决定常驻的面数据量和首批三角形的到达时间
+         * @return 文件无法打开或 sink 取消时返回 false
+         *
+         * 与 LoadObj 的区别：
+         * - ✅ 只保留属性数组和当前窗口的面；已解析的文件窗口通知系统回收映射页
+         * - ⚠️ g / o 不划分 shape，面也不会因 tinyobj 的 shape 规则被丢弃（流式导入按材质合并）
+         */
+        bool StreamObj(const std::string& filepath, const std::string& basePath, size_t windowBytes,
+                       const TriangleSink& sink, std::string* err);
+    }
+
+} // namespace Renderer
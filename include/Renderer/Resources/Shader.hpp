@@ -13,6 +13,7 @@ namespace Renderer
         Shader() = default;
         ~Shader();
 
+        // 已挂载的 AssetArchive 中同时有两个源文件时从打包文件编译，否则读取松散文件
         void Load(const std::string &vertexPath, const std::string &fragmentPath);
         void Use() const;
 
@@ -23,8 +24,16 @@ namespace Renderer
         void SetInt(const std::string &name, int value) const;
         void SetBool(const std::string &name, bool value) const;
 
+        // Uniform Block 绑定（见 UniformBindings.hpp）
+        // 着色器中不存在该 block 时返回 false（未使用的 block 会被编译器优化掉）
+        bool BindUniformBlock(const std::string &blockName, unsigned int bindingPoint) const;
+
         // 新增：获取OpenGL程序ID
         unsigned int GetID() const { return m_id; }
+
+    private:
+        // 编译并链接（源码按长度传入，不要求以 '\0' 结尾）
+        void Compile(const char *vertexCode, int vertexLength, const char *fragmentCode, int fragmentLength);
     };
 
 } // namespace Renderer
\ No newline at end of file
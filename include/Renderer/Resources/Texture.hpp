@@ -1,9 +1,28 @@
 #pragma once
+#include "Renderer/Resources/TextureCompression.hpp"
 #include <string>
+#include <vector>
 #include <glad/glad.h>
 
 namespace Renderer
 {
+    // 纹理的 CPU 端数据：Texture::Decode 可在任意线程生成，LoadFromSource 在 GL 线程上传
+    struct TextureSource
+    {
+        std::string path;                   // 源文件路径（上传后作为纹理文件名）
+        bool compressed = false;            // true: compressedImage 有效（预编码 DDS）
+        CompressedImage compressedImage;
+        std::vector<unsigned char> pixels;  // 未压缩像素（已按 OpenGL 行序翻转）
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+
+        size_t GetSizeBytes() const
+        {
+            return compressed ? compressedImage.GetTotalSizeBytes() : pixels.size();
+        }
+    };
+
     class Texture
     {
     public:
@@ -11,8 +30,24 @@ namespace Renderer
         ~Texture();
 
         // 加载纹理文件
+        // ⭐ .dds 文件直接按压缩格式上传；其他格式若存在同名且不旧于源文件的 .dds，优先使用预编码版本
+        // ⭐ 已挂载的 AssetArchive 中有该路径的纹理条目时，直接从打包文件上传（不访问松散文件）
         bool LoadFromFile(const std::string& filepath);
 
+        // 读取 / 解码纹理文件（只做文件 IO 和 CPU 解码，不调用 OpenGL，可在工作线程执行）
+        // 选择规则与 LoadFromFile 相同；LoadFromFile = Decode + LoadFromSource
+        static bool Decode(const std::string& filepath, TextureSource& source);
+
+        // 上传 Decode 的结果（需在 OpenGL 上下文所在线程调用）
+        // 预编码格式不被当前上下文支持时，回退为同步解码源图像
+        bool LoadFromSource(const TextureSource& source);
+
+        // 从预编码图像加载（glCompressedTexImage2D 逐级上传，不调用 glGenerateMipmap）
+        bool LoadFromCompressed(const CompressedImage& image, const std::string& sourceName);
+
+        // 从外部内存中的预编码图像加载（如 AssetArchive 的映射，层级直接作为上传源）
+        bool LoadFromCompressedView(const CompressedImageView& image, const std::string& sourceName);
+
         // 绑定纹理到指定的纹理单元
         // ⭐ 默认使用纹理单元1（TextureUnit::MATERIAL_DIFFUSE），为ImGui预留单元0
         void Bind(GLenum textureUnit = GL_TEXTURE1) const;
@@ -31,11 +66,52 @@ namespace Renderer
 
         // 获取纹理文件名
         const std::string& GetFilePath() const { return m_filepath; }
+        void SetFilePath(const std::string& filepath) { m_filepath = filepath; }
+
+        // 纹理尺寸与显存占用（含 mip 链）
+        int GetWidth() const { return m_width; }
+        int GetHeight() const { return m_height; }
+        size_t GetGPUSizeBytes() const { return m_gpuSizeBytes; }
+
+        // 是否为块压缩纹理
+        bool IsCompressed() const { return m_compressed; }
+
+        // 接管一个已创建的 GL 纹理对象（释放旧对象，保留文件路径）
+        // ⭐ 用于 TextureStreamer 调整驻留 mip 时重新分配存储，持有本对象的渲染器无需更新
+        void AdoptGLTexture(GLuint textureID, int width, int height, size_t gpuSizeBytes, bool compressed);
+
+        // ========================================
+        // 压缩纹理辅助（Skybox 等也使用）
+        // ========================================
+
+        // 当前上下文是否支持该格式（BC1/BC3 需 S3TC 扩展，BC7 需 BPTC 扩展，BC4/BC5 为 3.3 核心）
+        static bool IsCompressedFormatSupported(BlockFormat format);
+
+        // 对应的 OpenGL 内部格式
+        static GLenum GetGLInternalFormat(BlockFormat format);
+
+        // 将指定面从 firstMip 开始的 mip 层级上传到 target（GL_TEXTURE_2D 或 GL_TEXTURE_CUBE_MAP_POSITIVE_X + i）
+        // firstMip 层级作为 GL 层级 0 上传；调用前需已绑定目标纹理
+        static bool UploadCompressedLevels(GLenum target, const CompressedImage& image, uint32_t face, uint32_t firstMip = 0);
+        static bool UploadCompressedLevels(GLenum target, const CompressedImageView& image, uint32_t face, uint32_t firstMip = 0);
+
+        // 查找可用的预编码文件（存在且不早于源文件），否则返回空字符串
+        static std::string FindCompressedSibling(const std::string& sourcePath);
 
     private:
         GLuint m_textureID;
         bool m_loaded;
         std::string m_filepath;
+        int m_width;
+        int m_height;
+        size_t m_gpuSizeBytes;
+        bool m_compressed;
+
+        // 读取 DDS（只接受 2D 纹理）
+        static bool ReadCompressedFile(const std::string& ddsPath, CompressedImage& image);
+
+        // stb_image 解码源图像（本线程翻转为 OpenGL 行序）
+        static bool DecodePixels(const std::string& filepath, TextureSource& source);
 
         // 清理资源
         void Cleanup();
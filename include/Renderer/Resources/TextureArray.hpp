@@ -0,0 +1,76 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <glad/glad.h>
+
+namespace Renderer
+{
+
+    /**
+     * @class TextureArray
+     * @brief GL_TEXTURE_2D_ARRAY 包装器 - 多张同尺寸纹理共享一次绑定
+     *
+     * 设计原则：
+     * - ✅ 所有层尺寸相同（加载时自动缩放到目标尺寸）
+     * - ✅ mip 链在 CPU 上预计算并逐级上传（与预编码纹理保持一致，不调用 glGenerateMipmap）
+     * - ✅ 可预留空闲层（capacity），之后 AppendFromFiles() 只上传新增的层，不重新分配
+     * - ✅ 禁止拷贝，允许移动（与 Skybox 一致）
+     *
+     * 使用场景：
+     * - MaterialAtlas 将同一分辨率档位的材质纹理打包为一个纹理数组
+     * - 着色器通过 sampler2DArray + 层索引采样
+     */
+    class TextureArray
+    {
+    public:
+        TextureArray();
+        ~TextureArray();
+
+        TextureArray(const TextureArray&) = delete;
+        TextureArray& operator=(const TextureArray&) = delete;
+        TextureArray(TextureArray&& other) noexcept;
+        TextureArray& operator=(TextureArray&& other) noexcept;
+
+        /**
+         * @brief 从文件列表创建纹理数组（已创建时先释放旧的存储）
+         * @param filepaths 每层的图像路径（第 i 个文件对应第 i 层）
+         * @param size 每层的边长（所有层缩放到 size x size）
+         * @param capacity 分配的层数（小于文件数时按文件数分配），多出的层留给 AppendFromFiles()
+         * @return 创建是否成功；单个文件加载失败时该层填充为白色，不视为失败
+         */
+        bool LoadFromFiles(const std::vector<std::string>& filepaths, int size, int capacity = 0);
+
+        /**
+         * @brief 将文件依次写入预留的空闲层（不重新分配、不重新上传已有的层）
+         * @return 尚未创建或空闲层不足时返回 false（此时不做任何修改，需要用 LoadFromFiles 重建）
+         */
+        bool AppendFromFiles(const std::vector<std::string>& filepaths);
+
+        /**
+         * @brief 绑定到指定纹理单元
+         * ⭐ 默认使用纹理单元6（TextureUnit::MATERIAL_DIFFUSE_ARRAY）
+         */
+        void Bind(GLenum textureUnit = GL_TEXTURE6) const;
+
+        static void UnbindStatic() { glBindTexture(GL_TEXTURE_2D_ARRAY, 0); }
+
+        GLuint GetID() const { return m_textureID; }
+        bool IsLoaded() const { return m_textureID != 0; }
+        int GetSize() const { return m_size; }
+        int GetLayerCount() const { return m_layerCount; }
+        int GetCapacity() const { return m_capacity; }
+        size_t GetGPUSizeBytes() const { return m_gpuSizeBytes; }
+
+    private:
+        GLuint m_textureID;
+        int m_size;
+        int m_layerCount;
+        int m_capacity;                // 已分配的层数（≥ m_layerCount）
+        size_t m_gpuSizeBytes;
+
+        void UploadLayer(GLsizei layer, const std::string& path);
+        void Cleanup();
+    };
+
+} // namespace Renderer
@@ -0,0 +1,244 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Renderer
+{
+
+    /**
+     * @enum BlockFormat
+     * @brief GPU 可直接采样的纹理存储格式
+     *
+     * - BC1: RGB（1bit alpha），4bpp
+     * - BC3: RGBA（BC1 颜色 + BC4 alpha），8bpp
+     * - BC4: 单通道，4bpp
+     * - BC5: 双通道（法线贴图），8bpp
+     * - BC7: 高质量 RGBA，8bpp（仅支持加载，转换器不编码）
+     * - RGBA8: 未压缩（用于缓存/回退）
+     * - RGBA16F / RG16F: 未压缩半精度浮点（预滤波环境贴图、BRDF LUT 等预计算数据，不能由 RGBA8 编码得到）
+     */
+    enum class BlockFormat : uint32_t
+    {
+        BC1 = 0,
+        BC3,
+        BC4,
+        BC5,
+        BC7,
+        RGBA8,
+        RGBA16F,
+        RG16F
+    };
+
+    /**
+     * @enum CompressionQuality
+     * @brief 编码质量档位（速度/质量权衡）
+     *
+     * - FAST:   包围盒端点，单次索引匹配
+     * - NORMAL: 主轴（PCA）端点
+     * - HIGH:   主轴端点 + 最小二乘端点迭代优化
+     */
+    enum class CompressionQuality
+    {
+        FAST,
+        NORMAL,
+        HIGH
+    };
+
+    /**
+     * @struct CompressedImage
+     * @brief 预编码的纹理数据（含完整 mip 链，可为 cubemap）
+     *
+     * 内存布局：levels[face * mipCount + mip]
+     * 面的顺序与 OpenGL 一致（+X, -X, +Y, -Y, +Z, -Z）
+     */
+    struct CompressedImage
+    {
+        BlockFormat format = BlockFormat::RGBA8;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t faceCount = 1;                 // 1 = 2D 纹理，6 = cubemap
+        uint32_t mipCount = 0;
+        bool flippedForGL = false;              // 行序已按 OpenGL 约定（自下而上）存储
+        uint64_t userKey = 0;                   // 缓存校验键（由调用者定义）
+        std::vector<std::vector<uint8_t>> levels;
+
+        const std::vector<uint8_t>& GetLevel(uint32_t face, uint32_t mip) const
+        {
+            return levels[face * mipCount + mip];
+        }
+
+        bool IsValid() const
+        {
+            return width > 0 && height > 0 && mipCount > 0 &&
+                   levels.size() == static_cast<size_t>(faceCount) * mipCount;
+        }
+
+        /**
+         * @brief 所有层级的总字节数（GPU 占用估算）
+         */
+        size_t GetTotalSizeBytes() const;
+    };
+
+    /**
+     * @struct CompressedImageView
+     * @brief 指向外部内存（如内存映射的打包文件）的预编码纹理，字段含义同 CompressedImage，不拥有数据
+     */
+    struct CompressedImageView
+    {
+        BlockFormat format = BlockFormat::RGBA8;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t faceCount = 1;
+        uint32_t mipCount = 0;
+        bool flippedForGL = false;
+        uint64_t userKey = 0;
+        std::vector<const uint8_t*> levelData;  // levelData[face * mipCount + mip]
+        std::vector<size_t> levelSizes;
+
+        bool IsValid() const
+        {
+            return width > 0 && height > 0 && mipCount > 0 &&
+                   levelData.size() == static_cast<size_t>(faceCount) * mipCount &&
+                   levelSizes.size() == levelData.size();
+        }
+
+        size_t GetTotalSizeBytes() const;
+    };
+
+    /**
+     * @namespace TextureCompression
+     * @brief 纯 CPU 的纹理压缩与容器读写工具
+     *
+     * 设计原则：
+     * - ✅ 不依赖 OpenGL 和 Logger，可在离线转换工具中单独编译
+     * - ✅ 错误通过返回值 + 可选错误字符串报告
+     * - ✅ GPU 上传由 Texture / Skybox 负责
+     *
+     * 容器格式为标准 DDS（BC1/3/4/5 使用 FourCC 头，BC7 和半精度格式使用 DX10 扩展头，RGBA8 使用位掩码头），
+     * 并在 reserved1 字段中写入 Lumenaris 标记（行序、缓存键）。
+     */
+    namespace TextureCompression
+    {
+        /**
+         * @brief 是否为块压缩格式（BC*）
+         */
+        bool IsBlockCompressed(BlockFormat format);
+
+        /**
+         * @brief 未压缩格式的每像素字节数（块压缩格式返回 0）
+         */
+        size_t GetPixelBytes(BlockFormat format);
+
+        /**
+         * @brief 计算单个 mip 层级的字节数
+         */
+        size_t GetLevelSizeBytes(BlockFormat format, uint32_t width, uint32_t height);
+
+        /**
+         * @brief 完整 mip 链的层级数（直到 1x1）
+         */
+        uint32_t GetFullMipCount(uint32_t width, uint32_t height);
+
+        /**
+         * @brief 格式名称（用于日志和命令行）
+         */
+        const char* GetFormatName(BlockFormat format);
+
+        /**
+         * @brief 从名称解析格式（"bc1"/"bc3"/"bc4"/"bc5"/"bc7"/"rgba8"/"rgba16f"/"rg16f"，不区分大小写）
+         */
+        bool ParseFormatName(const std::string& name, BlockFormat& outFormat);
+
+        /**
+         * @brief 根据通道数和 alpha 内容选择默认格式
+         * @param rgba RGBA8 像素
+         * @param channels 源图像通道数
+         */
+        BlockFormat ChooseDefaultFormat(const uint8_t* rgba, uint32_t width, uint32_t height, int channels);
+
+        /**
+         * @brief 将任意通道数（1-4）的 8bit 像素扩展为 RGBA8
+         */
+        std::vector<uint8_t> ExpandToRGBA8(const uint8_t* pixels, uint32_t width, uint32_t height, int channels);
+
+        /**
+         * @brief 原地垂直翻转 RGBA8 图像
+         */
+        void FlipVerticalRGBA8(std::vector<uint8_t>& rgba, uint32_t width, uint32_t height);
+
+        /**
+         * @brief 2x2 盒式滤波生成下一级 mip（奇数尺寸边缘钳制）
+         */
+        std::vector<uint8_t> DownsampleRGBA8(const std::vector<uint8_t>& rgba, uint32_t width, uint32_t height);
+
+        /**
+         * @brief 缩放 RGBA8 图像到任意尺寸
+         *
+         * 缩小超过 2 倍时先做 2x2 盒式滤波逐级减半，再双线性插值到目标尺寸，避免走样
+         */
+        std::vector<uint8_t> ResizeRGBA8(const std::vector<uint8_t>& rgba, uint32_t width, uint32_t height,
+                                         uint32_t newWidth, uint32_t newHeight);
+
+        /**
+         * @brief 生成完整 mip 链（RGBA8）
+         * @return 第 0 级为输入本身
+         */
+        std::vector<std::vector<uint8_t>> BuildMipChainRGBA8(std::vector<uint8_t> rgba, uint32_t width, uint32_t height);
+
+        /**
+         * @brief 将单个 RGBA8 层级编码为目标格式
+         * @note BC7 和半精度格式不支持编码，返回空数组
+         */
+        std::vector<uint8_t> EncodeLevel(const uint8_t* rgba, uint32_t width, uint32_t height,
+                                         BlockFormat format, CompressionQuality quality);
+
+        /**
+         * @brief 编码整张图像（可选 mip 链）
+         * @param faces 每个面的 RGBA8 数据（1 或 6 个），尺寸相同
+         * @param generateMips 是否生成完整 mip 链
+         * @param error 可选的错误信息输出
+         */
+        bool Compress(const std::vector<std::vector<uint8_t>>& faces, uint32_t width, uint32_t height,
+                      BlockFormat format, CompressionQuality quality, bool generateMips,
+                      CompressedImage& outImage, std::string* error = nullptr);
+
+        /**
+         * @brief 序列化为 DDS 字节流
+         */
+        bool WriteDDSToMemory(const CompressedImage& image, std::vector<uint8_t>& outBytes, std::string* error = nullptr);
+
+        /**
+         * @brief 写入 DDS 文件
+         */
+        bool WriteDDS(const std::string& filepath, const CompressedImage& image, std::string* error = nullptr);
+
+        /**
+         * @brief 从内存解析 DDS，层级指针直接指向 data（不拷贝，data 需在视图使用期间保持有效）
+         */
+        bool ParseDDS(const uint8_t* data, size_t size, CompressedImageView& outView, std::string* error = nullptr);
+
+        /**
+         * @brief 创建指向 CompressedImage 层级数据的视图
+         */
+        CompressedImageView MakeView(const CompressedImage& image);
+
+        /**
+         * @brief 从内存解析 DDS（拷贝层级数据）
+         */
+        bool ReadDDSFromMemory(const uint8_t* data, size_t size, CompressedImage& outImage, std::string* error = nullptr);
+
+        /**
+         * @brief 读取 DDS 文件
+         */
+        bool ReadDDS(const std::string& filepath, CompressedImage& outImage, std::string* error = nullptr);
+
+        /**
+         * @brief 获取与源图像对应的预编码文件路径（foo.png → foo.dds）
+         */
+        std::string GetCompressedSiblingPath(const std::string& sourcePath);
+
+    } // namespace TextureCompression
+
+} // namespace Renderer
@@ -0,0 +1,156 @@
+#pragma once
+#include "Renderer/Resources/Texture.hpp"
+#include "Renderer/Resources/TextureCompression.hpp"
+#include "Renderer/Data/InstanceData.hpp"
+#include "Core/Camera.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Renderer
+{
+
+    /**
+     * @struct TextureStreamerConfig
+     * @brief 纹理流送配置
+     */
+    struct TextureStreamerConfig
+    {
+        size_t budgetBytes = 64ull * 1024 * 1024; // 显存预算（所有被管理纹理的驻留 mip 总和）
+        uint32_t initialMaxSize = 128;            // 首次加载时驻留的最大边长（只上传不大于此尺寸的 mip）
+        uint32_t maxUploadsPerFrame = 2;          // 每帧最多处理的提升请求数（限制上传卡顿）
+        float lodBias = 0.0f;                     // 期望 mip 偏移（正值 = 更模糊、更省显存）
+    };
+
+    /**
+     * @struct TextureStreamerStats
+     * @brief 纹理流送计数器
+     */
+    struct TextureStreamerStats
+    {
+        size_t trackedTextures = 0;   // 被管理的纹理数
+        size_t residentBytes = 0;     // 当前驻留字节数
+        size_t budgetBytes = 0;       // 预算
+        size_t pendingRequests = 0;   // 尚未满足的提升请求（本帧未处理或超出预算）
+        uint64_t uploads = 0;         // 累计重新分配次数（提升）
+        uint64_t evictions = 0;       // 累计因预算降级的次数
+    };
+
+    /**
+     * @class TextureStreamer
+     * @brief 纹理流送管理器 - 按屏幕空间尺寸决定每张纹理驻留的 mip 层级
+     *
+     * 设计方案：
+     * - ✅ 纹理首次只上传不大于 initialMaxSize 的低分辨率 mip，完整 mip 链保留在内存中
+     * - ✅ 每帧根据使用该纹理的实例包围球投影到屏幕的像素尺寸计算期望 mip
+     * - ✅ 提升/降级通过重新分配 GL 纹理实现（只分配驻留层级，真正节省显存），
+     *      Texture 对象保持不变，持有它的渲染器无需更新
+     * - ✅ 超出预算时按 LRU（最近可见帧）降级其他纹理，当前帧可见的纹理只降到期望层级
+     *
+     * 使用方式：
+     * @code
+     * TextureStreamer streamer;
+     * assetLoader.LoadOBJ(path, callback, true, &streamer);  // 纹理加载时即交由流送管理
+     * // 回调中登记使用者
+     * streamer.Track(renderer.GetTexture(), renderer.GetInstances(), mesh.GetData().ComputeBoundingRadius());
+     * // 每帧
+     * streamer.Update(camera, aspectRatio, static_cast<float>(window.GetHeight()));
+     * @endcode
+     *
+     * @note 只管理 2D 纹理；立方体贴图和纹理数组保持完整驻留
+     */
+    class TextureStreamer
+    {
+    public:
+        explicit TextureStreamer(const TextureStreamerConfig& config = TextureStreamerConfig());
+
+        TextureStreamer(const TextureStreamer&) = delete;
+        TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+        /**
+         * @brief 加载纹理并交由流送管理（只驻留低分辨率 mip）
+         * @return 纹理；加载失败时返回 nullptr
+         */
+        std::shared_ptr<Texture> Load(const std::string& filepath);
+
+        /**
+         * @brief 从已解码的数据创建纹理并交由流送管理（不再读取文件，只上传初始驻留层级）
+         * @param source Texture::Decode 的结果（最好已在工作线程经过 PrepareSource），mip 链被移入管理器
+         * @note 需在 OpenGL 上下文所在线程调用（见 AssetLoader::LoadOBJ 的 textureStreamer 参数）
+         */
+        std::shared_ptr<Texture> Load(TextureSource&& source);
+
+        /**
+         * @brief 把解码结果转换为流送使用的完整 mip 链（纯 CPU，可在工作线程调用）
+         *
+         * 未压缩像素扩展为 RGBA8 并在 CPU 上生成 mip 链（之后 source.compressed = true），
+         * 预编码图像保持不变。
+         */
+        static bool PrepareSource(TextureSource& source);
+
+        /**
+         * @brief 登记纹理的一组使用者（实例 + 网格包围球半径）
+         *
+         * 通过 Load 创建的纹理直接追加使用者。
+         * ⚠️ 其他途径加载的纹理（如 Texture::LoadFromFile）需从文件路径重新读取、解码完整 mip 链并重新上传，
+         *    应尽量在加载时就交给流送管理器。
+         * @return 纹理是否处于流送管理下
+         */
+        bool Track(const std::shared_ptr<Texture>& texture,
+                   const std::shared_ptr<InstanceData>& instances,
+                   float boundingRadius);
+
+        /**
+         * @brief 停止管理纹理（恢复完整驻留）
+         */
+        void Untrack(const Texture* texture);
+
+        /**
+         * @brief 每帧调用：更新期望层级、按优先级处理请求、在预算下执行 LRU 降级
+         * @param viewportHeight 视口高度（像素）
+         */
+        void Update(const ::Core::Camera& camera, float aspectRatio, float viewportHeight);
+
+        void SetBudgetBytes(size_t budgetBytes) { m_config.budgetBytes = budgetBytes; }
+        const TextureStreamerConfig& GetConfig() const { return m_config; }
+        TextureStreamerStats GetStats() const;
+
+    private:
+        struct TextureUser
+        {
+            std::weak_ptr<InstanceData> instances;
+            float boundingRadius = 0.0f;
+        };
+
+        struct StreamedTexture
+        {
+            std::shared_ptr<Texture> texture;
+            CompressedImage image;         // 完整 mip 链（系统内存）
+            uint32_t residentMip = 0;      // 当前驻留的最高分辨率层级
+            uint32_t initialMip = 0;       // 最低驻留层级（不会降到更低）
+            uint32_t desiredMip = 0;       // 本帧期望层级
+            float screenPixels = 0.0f;     // 本帧最大投影尺寸（像素），用于请求优先级
+            uint64_t lastVisibleFrame = 0; // LRU 时间戳
+            std::vector<TextureUser> users;
+        };
+
+        TextureStreamerConfig m_config;
+        std::unordered_map<const Texture*, StreamedTexture> m_textures;
+        size_t m_residentBytes = 0;
+        size_t m_pendingRequests = 0;
+        uint64_t m_uploads = 0;
+        uint64_t m_evictions = 0;
+        uint64_t m_frame = 0;
+
+        bool ReadSource(const std::string& filepath, CompressedImage& outImage) const;
+        StreamedTexture* Adopt(const std::shared_ptr<Texture>& texture, CompressedImage&& image);
+        float ComputeScreenPixels(const StreamedTexture& entry, const glm::vec3& cameraPos, const glm::vec3& cameraFront,
+                                  float pixelsPerUnitAtOne) const;
+        size_t GetResidentBytes(const StreamedTexture& entry, uint32_t mip) const;
+        bool SetResidency(StreamedTexture& entry, uint32_t mip);
+        bool MakeRoom(size_t requiredBytes, const StreamedTexture* requester);
+    };
+
+} // namespace Renderer
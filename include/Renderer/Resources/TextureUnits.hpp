@@ -32,11 +32,14 @@ namespace Renderer
         MATERIAL_SPECULAR = 3,    // 高光纹理
         MATERIAL_HEIGHT = 4,      // 高度纹理
         MATERIAL_EMISSION = 5,    // 自发光纹理
+        MATERIAL_DIFFUSE_ARRAY = 6, // 漫反射纹理数组（MaterialAtlas，GL_TEXTURE_2D_ARRAY）
 
         // ========================================
         // 环境纹理
         // ========================================
         AMBIENT_SKYBOX = 10,      // 环境光天空盒
+        ENVIRONMENT_PREFILTERED = 11, // GGX 预滤波环境立方体贴图（EnvironmentPrefilter）
+        BRDF_LUT = 12,            // split-sum BRDF 查找表（EnvironmentPrefilter）
 
         // ========================================
         // 天空盒渲染
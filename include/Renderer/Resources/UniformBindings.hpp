@@ -0,0 +1,29 @@
+#pragma once
+
+namespace Renderer
+{
+    /**
+     * Uniform Buffer 绑定点分配方案
+     *
+     * 设计目标：
+     * - 与 TextureUnits 一样集中管理，避免不同模块使用同一绑定点
+     * - 着色器（GLSL 330 不支持 layout(binding)）通过 Shader::BindUniformBlock() 关联
+     *
+     * 分配原则：
+     * - 绑定点 0-3: 材质/场景数据
+     * - 绑定点 4+: 环境光照/高级功能
+     */
+    enum class UniformBinding : unsigned int
+    {
+        // ========================================
+        // 材质数据
+        // ========================================
+        MATERIAL_TABLE = 0,       // 材质表（MaterialTable，std140）
+
+        // ========================================
+        // 环境光照
+        // ========================================
+        AMBIENT_SH = 4,           // 球谐辐照度（AmbientLighting，9 x vec4）
+    };
+
+} // namespace Renderer
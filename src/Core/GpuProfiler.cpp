@@ -0,0 +1,120 @@
+#include "Core/GpuProfiler.hpp"
+#include "Core/Logger.hpp"
+
+namespace Core
+{
+
+    GpuProfiler &GpuProfiler::GetInstance()
+    {
+        static GpuProfiler instance;
+        return instance;
+    }
+
+    bool GpuProfiler::IsSupported()
+    {
+        if (m_supported < 0)
+        {
+            // 计时查询是 OpenGL 3.3 核心功能
+            m_supported = (GLAD_GL_VERSION_3_3 && glQueryCounter && glGetInteger64v) ? 1 : 0;
+            if (!m_supported)
+            {
+                Core::Logger::GetInstance().Warning("GpuProfiler: timer queries unavailable, GPU zones disabled");
+            }
+        }
+        return m_supported == 1;
+    }
+
+    uint32_t GpuProfiler::BeginZone(const char *name)
+    {
+        if (!IsSupported())
+        {
+            return kInvalidZone;
+        }
+
+        FrameQueries &frame = m_frames[m_current];
+        if (frame.used == frame.zones.size())
+        {
+            Zone zone;
+            GLuint queries[2] = {0, 0};
+            glGenQueries(2, queries);
+            zone.beginQuery = queries[0];
+            zone.endQuery = queries[1];
+            frame.zones.push_back(zone);
+        }
+
+        uint32_t index = static_cast<uint32_t>(frame.used++);
+        Zone &zone = frame.zones[index];
+        zone.name = name;
+        glQueryCounter(zone.beginQuery, GL_TIMESTAMP);
+        return index;
+    }
+
+    void GpuProfiler::EndZone(uint32_t zone)
+    {
+        if (zone == kInvalidZone)
+        {
+            return;
+        }
+        glQueryCounter(m_frames[m_current].zones[zone].endQuery, GL_TIMESTAMP);
+    }
+
+    void GpuProfiler::EndFrame()
+    {
+        if (!IsSupported())
+        {
+            return;
+        }
+
+        // 记录本帧的时间轴偏移（GPU 时间戳与 CPU 时钟的零点不同）
+        GLint64 gpuNow = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+        m_frames[m_current].cpuOffsetNs = Profiler::GetInstance().Now() - static_cast<int64_t>(gpuNow);
+
+        // 下一组是 kFrameLatency - 1 帧之前提交的：回读后复用
+        m_current = (m_current + 1) % kFrameLatency;
+        ResolveFrame(m_frames[m_current]);
+    }
+
+    void GpuProfiler::ResolveFrame(FrameQueries &frame)
+    {
+        if (frame.used == 0)
+        {
+            return;
+        }
+
+        // ⭐ 最后一个结束查询可用即整帧可用；仍未完成时丢弃，不阻塞 CPU
+        GLuint available = 0;
+        glGetQueryObjectuiv(frame.zones[frame.used - 1].endQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available)
+        {
+            Profiler &profiler = Profiler::GetInstance();
+            for (size_t i = 0; i < frame.used; ++i)
+            {
+                const Zone &zone = frame.zones[i];
+                GLuint64 beginNs = 0;
+                GLuint64 endNs = 0;
+                glGetQueryObjectui64v(zone.beginQuery, GL_QUERY_RESULT, &beginNs);
+                glGetQueryObjectui64v(zone.endQuery, GL_QUERY_RESULT, &endNs);
+                profiler.RecordGpuZone(zone.name, static_cast<int64_t>(beginNs) + frame.cpuOffsetNs,
+                                       static_cast<int64_t>(endNs) + frame.cpuOffsetNs);
+            }
+        }
+        frame.used = 0;
+    }
+
+    void GpuProfiler::Shutdown()
+    {
+        for (FrameQueries &frame : m_frames)
+        {
+            for (const Zone &zone : frame.zones)
+            {
+                GLuint queries[2] = {zone.beginQuery, zone.endQuery};
+                glDeleteQueries(2, queries);
+            }
+            frame.zones.clear();
+            frame.used = 0;
+        }
+        m_current = 0;
+    }
+
+} // namespace Core
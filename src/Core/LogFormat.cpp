@@ -0,0 +1,197 @@
+#include "Core/LogFormat.hpp"
+#include <cstdio>
+#include <deque>
+#include <mutex>
+
+namespace Core {
+
+namespace {
+
+using LogFormat::ArgType;
+
+std::mutex s_siteMutex;
+std::deque<const LogFormatSite*> s_sites;   // 下标 + 1 == ID
+
+// 读取一个参数并追加到 out；数据不足时返回 false
+bool AppendArg(std::string& out, std::string_view spec, const char*& cursor, const char* end)
+{
+    if (cursor >= end)
+    {
+        return false;
+    }
+    ArgType type = static_cast<ArgType>(*cursor++);
+
+    auto read = [&](void* value, size_t bytes) {
+        if (static_cast<size_t>(end - cursor) < bytes)
+        {
+            return false;
+        }
+        std::memcpy(value, cursor, bytes);
+        cursor += bytes;
+        return true;
+    };
+
+    // 解析 ":.Nf" / ":x"
+    bool hex = false;
+    int precision = -1;
+    if (spec.size() >= 2 && spec[0] == ':')
+    {
+        if (spec[1] == 'x')
+        {
+            hex = true;
+        }
+        else if (spec[1] == '.')
+        {
+            precision = 0;
+            for (size_t i = 2; i < spec.size() && spec[i] >= '0' && spec[i] <= '9'; ++i)
+            {
+                precision = precision * 10 + (spec[i] - '0');
+            }
+            precision = precision > 17 ? 17 : precision;
+        }
+    }
+
+    char buffer[64];
+    int length = 0;
+    switch (type)
+    {
+    case ArgType::Int:
+    {
+        int64_t value;
+        if (!read(&value, sizeof(value)))
+            return false;
+        length = hex ? std::snprintf(buffer, sizeof(buffer), "%llx", static_cast<unsigned long long>(value))
+                     : std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(value));
+        break;
+    }
+    case ArgType::UInt:
+    {
+        uint64_t value;
+        if (!read(&value, sizeof(value)))
+            return false;
+        length = std::snprintf(buffer, sizeof(buffer), hex ? "%llx" : "%llu", static_cast<unsigned long long>(value));
+        break;
+    }
+    case ArgType::Double:
+    {
+        double value;
+        if (!read(&value, sizeof(value)))
+            return false;
+        length = precision >= 0 ? std::snprintf(buffer, sizeof(buffer), "%.*f", precision, value)
+                                : std::snprintf(buffer, sizeof(buffer), "%g", value);
+        break;
+    }
+    case ArgType::String:
+    {
+        uint32_t size;
+        if (!read(&size, sizeof(size)) || static_cast<size_t>(end - cursor) < size)
+            return false;
+        out.append(cursor, size);
+        cursor += size;
+        return true;
+    }
+    case ArgType::Bool:
+    {
+        uint8_t value;
+        if (!read(&value, sizeof(value)))
+            return false;
+        out += value ? "true" : "false";
+        return true;
+    }
+    case ArgType::Char:
+    {
+        char value;
+        if (!read(&value, sizeof(value)))
+            return false;
+        out += value;
+        return true;
+    }
+    case ArgType::Pointer:
+    {
+        uint64_t value;
+        if (!read(&value, sizeof(value)))
+            return false;
+        length = std::snprintf(buffer, sizeof(buffer), "0x%llx", static_cast<unsigned long long>(value));
+        break;
+    }
+    default:
+        cursor = end;   // 未知类型：后续数据无法定位
+        return false;
+    }
+
+    if (length > 0)
+    {
+        out.append(buffer, static_cast<size_t>(length) < sizeof(buffer) ? static_cast<size_t>(length) : sizeof(buffer) - 1);
+    }
+    return true;
+}
+
+} // namespace
+
+LogFormatSite::LogFormatSite(const char* format, const char* file, int line)
+    : format(format), file(file), line(line), id(0)
+{
+    id = LogFormat::RegisterSite(*this);
+}
+
+namespace LogFormat {
+
+uint32_t RegisterSite(const LogFormatSite& site)
+{
+    std::lock_guard<std::mutex> lock(s_siteMutex);
+    s_sites.push_back(&site);
+    return static_cast<uint32_t>(s_sites.size());
+}
+
+const LogFormatSite* FindSite(uint32_t id)
+{
+    std::lock_guard<std::mutex> lock(s_siteMutex);
+    return (id > 0 && id <= s_sites.size()) ? s_sites[id - 1] : nullptr;
+}
+
+std::string Format(std::string_view format, const char* args, size_t size)
+{
+    std::string out;
+    out.reserve(format.size() + size);
+
+    const char* cursor = args;
+    const char* end = args + size;
+    for (size_t i = 0; i < format.size(); ++i)
+    {
+        char c = format[i];
+        if (c == '{')
+        {
+            if (i + 1 < format.size() && format[i + 1] == '{')
+            {
+                out += '{';
+                ++i;
+                continue;
+            }
+            size_t close = format.find('}', i);
+            if (close == std::string_view::npos)
+            {
+                out.append(format.substr(i));
+                break;
+            }
+            if (!AppendArg(out, format.substr(i + 1, close - i - 1), cursor, end))
+            {
+                out += "{?}";
+            }
+            i = close;
+        }
+        else if (c == '}' && i + 1 < format.size() && format[i + 1] == '}')
+        {
+            out += '}';
+            ++i;
+        }
+        else
+        {
+            out += c;
+        }
+    }
+    return out;
+}
+
+} // namespace LogFormat
+
+} // namespace Core
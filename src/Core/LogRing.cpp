@@ -0,0 +1,85 @@
+#include "Core/LogRing.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Core {
+
+LogRing::LogRing(size_t capacity)
+{
+    size_t rounded = 2;
+    while (rounded < capacity)
+    {
+        rounded <<= 1;
+    }
+
+    m_slots.reset(new Slot[rounded]);
+    m_mask = rounded - 1;
+    for (size_t i = 0; i < rounded; ++i)
+    {
+        // 序号 == 位置：可写；序号 == 位置 + 1：已发布可读
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        m_slots[i].heapData = nullptr;
+    }
+}
+
+LogRing::~LogRing()
+{
+    // 释放未被消费的长消息
+    Drain(GetCapacity(), [](const LogRecord&) {});
+}
+
+bool LogRing::TryPush(uint8_t level, int64_t timestampNs, uint32_t formatId, const char* data, size_t size)
+{
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;)
+    {
+        slot = &m_slots[pos & m_mask];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0)
+        {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false; // 槽位还未被消费者归还：队列已满
+        }
+        else
+        {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    size = std::min<size_t>(size, UINT32_MAX);
+    slot->level = level;
+    slot->timestampNs = timestampNs;
+    slot->formatId = formatId;
+    slot->size = static_cast<uint32_t>(size);
+    if (size <= kInlineBytes)
+    {
+        slot->heapData = nullptr;
+        std::memcpy(slot->inlineData, data, size);
+    }
+    else
+    {
+        slot->heapData = new char[size];
+        std::memcpy(slot->heapData, data, size);
+    }
+
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+void LogRing::ReleaseSlot(Slot& slot)
+{
+    delete[] slot.heapData;
+    slot.heapData = nullptr;
+    slot.sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+    ++m_dequeuePos;
+}
+
+} // namespace Core
@@ -5,16 +5,67 @@
 #include <filesystem>
 #include <sstream>
 #include <algorithm>
+#include <csignal>
+#include <cstring>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace fs = std::filesystem;
 
 namespace Core
 {
 
+    namespace
+    {
+        using SignalHandler = void (*)(int);
+
+        const int kFatalSignals[] = {SIGSEGV, SIGABRT, SIGFPE, SIGILL, SIGTERM, SIGINT};
+        constexpr size_t kFatalSignalCount = sizeof(kFatalSignals) / sizeof(kFatalSignals[0]);
+        SignalHandler s_previousHandlers[kFatalSignalCount] = {};
+
+        // 只使用异步信号安全的调用，把数据追加到文件
+        void AppendToFileUnsafe(const char *path, const char *data, size_t size)
+        {
+#ifdef _WIN32
+            int fd = _open(path, _O_WRONLY | _O_APPEND | _O_BINARY);
+            if (fd < 0)
+                return;
+            while (size > 0)
+            {
+                int written = _write(fd, data, static_cast<unsigned int>(std::min<size_t>(size, 1u << 30)));
+                if (written <= 0)
+                    break;
+                data += written;
+                size -= static_cast<size_t>(written);
+            }
+            _close(fd);
+#else
+            int fd = ::open(path, O_WRONLY | O_APPEND);
+            if (fd < 0)
+                return;
+            while (size > 0)
+            {
+                ssize_t written = ::write(fd, data, size);
+                if (written <= 0)
+                    break;
+                data += written;
+                size -= static_cast<size_t>(written);
+            }
+            ::close(fd);
+#endif
+        }
+
+    } // namespace
+
     Logger::Logger()
         : m_running(false), m_asyncMode(true), m_consoleOutput(true),
-          m_minLevel(LogLevel::DEBUG), m_initialized(false),
-          m_lastStatsTime(std::chrono::steady_clock::now())
+          m_minLevel(LogLevel::DEBUG), m_initialized(false)
     {
     }
 
@@ -25,7 +76,8 @@ namespace Core
     }
 
     void Logger::Initialize(const std::string &logFilePath, bool consoleOutput, LogLevel minLevel,
-                            bool async, const LogRotationConfig &rotationConfig)
+                            bool async, const LogRotationConfig &rotationConfig, const LogQueueConfig &queueConfig,
+                            const LogFlushConfig &flushConfig)
     {
         std::lock_guard<std::mutex> lock(m_configMutex);
 
@@ -39,6 +91,8 @@ namespace Core
         m_minLevel = minLevel;
         m_asyncMode = async;
         m_rotationConfig = rotationConfig;
+        m_queueConfig = queueConfig;
+        m_flushConfig = flushConfig;
         m_lastRotationTime = std::chrono::system_clock::now();
 
         // 确保日志目录存在
@@ -55,11 +109,38 @@ namespace Core
             return;
         }
 
+        // 文件缓冲定长分配：追加过程中不重新分配，信号处理可以安全读取
+        m_fileBufferCapacity = std::max<size_t>(m_flushConfig.maxBufferedBytes, 4096);
+        m_fileBuffer.reset(new char[m_fileBufferCapacity]);
+        m_fileBufferSize.store(0, std::memory_order_relaxed);
+        m_lastFlushTime = std::chrono::steady_clock::now();
+
         // 如果启用异步模式，启动写入线程
         if (m_asyncMode)
         {
+            m_ring = std::make_unique<LogRing>(m_queueConfig.capacity);
+            if (!m_queueConfig.binaryLogPath.empty())
+            {
+                EnsureLogDirectoryExists(m_queueConfig.binaryLogPath);
+                m_binaryLog.open(m_queueConfig.binaryLogPath, std::ios::out | std::ios::binary | std::ios::trunc);
+                if (m_binaryLog.is_open())
+                {
+                    m_binaryLog.write(LogFormat::kBinaryMagic, sizeof(LogFormat::kBinaryMagic));
+                    m_binaryLog.write(reinterpret_cast<const char *>(&LogFormat::kBinaryVersion), sizeof(uint32_t));
+                    m_binaryFormatWritten.clear();
+                }
+                else if (m_consoleOutput)
+                {
+                    std::cerr << "[ERROR] Failed to open binary log file: " << m_queueConfig.binaryLogPath << std::endl;
+                }
+            }
             m_running = true;
             m_writeThread = std::thread(&Logger::AsyncWriteThread, this);
+
+            if (m_flushConfig.flushOnCrash)
+            {
+                InstallSignalHandlers();
+            }
         }
 
         m_initialized = true;
@@ -136,10 +217,13 @@ namespace Core
             return;
         }
 
-        // 停止异步写入线程
+        // 停止异步写入线程（退出前会排空队列）
         if (m_asyncMode && m_running)
         {
-            m_running = false;
+            {
+                std::lock_guard<std::mutex> queueLock(m_queueMutex);
+                m_running = false;
+            }
             m_queueCondition.notify_one(); // 唤醒等待的线程
 
             if (m_writeThread.joinable())
@@ -148,20 +232,20 @@ namespace Core
             }
         }
 
-        // 确保所有队列中的日志都被写入
-        if (m_asyncMode && !m_logQueue.empty())
+        // 写入线程退出后仍可能有生产者入队
+        if (m_ring)
         {
-            std::queue<std::unique_ptr<LogEntry>> tempQueue;
-            {
-                std::lock_guard<std::mutex> queueLock(m_queueMutex);
-                std::swap(tempQueue, m_logQueue);
-            }
+            m_ring->Drain(m_ring->GetCapacity(), [this](const LogRecord &record)
+                          { WriteRecord(record); });
+            ReportDroppedMessages();
+        }
+        FlushLogFile();
+        FlushConsole();
+        RestoreSignalHandlers();
 
-            while (!tempQueue.empty())
-            {
-                WriteLogEntry(*tempQueue.front());
-                tempQueue.pop();
-            }
+        if (m_binaryLog.is_open())
+        {
+            m_binaryLog.close();
         }
 
         if (m_logFile.is_open())
@@ -190,8 +274,8 @@ namespace Core
             return;
         }
 
-        // 检查日志级别
-        if (static_cast<int>(level) < static_cast<int>(m_minLevel))
+        // 检查日志级别（包括写入端不输出的 DEBUG）
+        if (!IsEnabled(level))
         {
             return;
         }
@@ -216,52 +300,206 @@ namespace Core
             return;
         }
 
-        // 检查日志级别
-        if (static_cast<int>(level) < static_cast<int>(m_minLevel))
+        // 检查日志级别（包括写入端不输出的 DEBUG）
+        if (!IsEnabled(level))
         {
             return;
         }
 
-        // 创建日志条目并放入队列（不在主线程格式化，让写入线程处理以确保上下文正确）
+        // 只拷贝消息和时间戳，格式化在写入线程进行（上下文也在写入线程读取）
+        PushRecord(level, 0, message.data(), message.size());
+    }
+
+    void Logger::PushRecord(LogLevel level, uint32_t formatId, const char *data, size_t size)
+    {
+        int64_t timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::system_clock::now().time_since_epoch())
+                                  .count();
+        // WARNING / ERROR 在任何溢出策略下都不丢弃：等待写入线程腾出槽位
+        const bool mustKeep = static_cast<int>(level) >= static_cast<int>(LogLevel::WARNING);
+        while (!m_ring->TryPush(static_cast<uint8_t>(level), timestampNs, formatId, data, size))
         {
-            std::lock_guard<std::mutex> lock(m_queueMutex);
-            m_logQueue.push(std::make_unique<LogEntry>(level, "", "", message, ""));
+            if (std::this_thread::get_id() == m_writeThread.get_id())
+            {
+                // 写入线程自身不能等待自己出队：直接写出（或丢弃低级别日志）
+                if (mustKeep)
+                {
+                    WriteRecord(LogRecord{static_cast<uint8_t>(level), timestampNs, formatId, data, static_cast<uint32_t>(size)});
+                }
+                else
+                {
+                    m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                }
+                return;
+            }
+            if (!m_running || (m_queueConfig.overflow == LogOverflowPolicy::DROP && !mustKeep))
+            {
+                m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::this_thread::yield();
         }
 
-        // 通知写入线程
-        m_queueCondition.notify_one();
+        // 写入线程空闲时才需要唤醒；错过的唤醒最多延迟一个等待周期
+        if (m_writerWaiting.load(std::memory_order_relaxed))
+        {
+            m_queueCondition.notify_one();
+        }
+    }
+
+    void Logger::SubmitFormatted(LogLevel level, const LogFormatSite &site, const char *args, size_t size)
+    {
+        if (!IsEnabled(level))
+        {
+            return;
+        }
+
+        if (m_asyncMode)
+        {
+            PushRecord(level, site.id, args, size);
+        }
+        else
+        {
+            Log(level, LogFormat::Format(site.format, args, size));
+        }
     }
 
     void Logger::AsyncWriteThread()
     {
-        while (m_running)
+        const size_t batchSize = std::max<size_t>(1, m_queueConfig.batchSize);
+        for (;;)
         {
-            std::unique_ptr<LogEntry> entry;
+            // 先读取运行标志：停止后再完整排空一次，保证 Shutdown 前入队的日志都被写入
+            bool running = m_running;
+
+            size_t written = m_ring->Drain(batchSize, [this](const LogRecord &record)
+                                           { WriteRecord(record); });
+            ReportDroppedMessages();
 
-            // 从队列获取日志条目
+            // ⭐ 一批只写一次：控制台每批写出，文件按 LogFlushConfig 提交
+            FlushConsole();
+            if (ShouldFlushLogFile())
             {
-                std::unique_lock<std::mutex> lock(m_queueMutex);
-                m_queueCondition.wait(lock, [this]()
-                                      { return !m_running || !m_logQueue.empty(); });
+                FlushLogFile();
+            }
 
-                if (!m_running && m_logQueue.empty())
-                {
-                    break;
-                }
+            if (written > 0)
+            {
+                continue;
+            }
+            if (!running)
+            {
+                break;
+            }
 
-                if (!m_logQueue.empty())
-                {
-                    entry = std::move(m_logQueue.front());
-                    m_logQueue.pop();
-                }
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_writerWaiting = true;
+            m_queueCondition.wait_for(lock, std::chrono::milliseconds(10), [this]()
+                                      { return !m_running || !m_ring->IsEmpty(); });
+            m_writerWaiting = false;
+        }
+    }
+
+    void Logger::WriteRecord(const LogRecord &record)
+    {
+        LogLevel level = static_cast<LogLevel>(record.level);
+        if (static_cast<int>(level) < static_cast<int>(kLowestWrittenLevel))
+        {
+            return;
+        }
+
+        std::chrono::system_clock::time_point time{
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(record.timestampNs))};
+
+        // ⭐ 二进制日志：记录原样写出，只有需要控制台输出时才格式化
+        if (m_binaryLog.is_open())
+        {
+            WriteBinaryRecord(record);
+            if (m_consoleOutput)
+            {
+                AppendConsole(level, FormatMessageWithContext(level, RecordMessage(record), time));
             }
+            if (level == LogLevel::ERROR && m_flushConfig.flushOnError)
+            {
+                FlushLogFile();
+                FlushConsole();
+            }
+            return;
+        }
 
-            // 写入日志条目
-            if (entry)
+        WriteFormatted(level, FormatMessageWithContext(level, RecordMessage(record), time));
+    }
+
+    std::string Logger::RecordMessage(const LogRecord &record) const
+    {
+        if (record.formatId == 0)
+        {
+            return std::string(record.data, record.size);
+        }
+
+        const LogFormatSite *site = LogFormat::FindSite(record.formatId);
+        if (!site)
+        {
+            return "<unknown log format " + std::to_string(record.formatId) + ">";
+        }
+        return LogFormat::Format(site->format, record.data, record.size);
+    }
+
+    void Logger::WriteBinaryRecord(const LogRecord &record)
+    {
+        auto put = [this](const void *bytes, size_t count)
+        {
+            m_binaryLog.write(static_cast<const char *>(bytes), static_cast<std::streamsize>(count));
+        };
+
+        // 每个格式 ID 在文件中首次出现时写入格式串，解码不依赖程序本身
+        if (record.formatId != 0)
+        {
+            if (record.formatId >= m_binaryFormatWritten.size())
             {
-                WriteLogEntry(*entry);
+                m_binaryFormatWritten.resize(record.formatId + 1, false);
+            }
+            if (!m_binaryFormatWritten[record.formatId])
+            {
+                const LogFormatSite *site = LogFormat::FindSite(record.formatId);
+                const char *file = site ? site->file : "";
+                const char *format = site ? site->format : "";
+                uint32_t line = site ? static_cast<uint32_t>(site->line) : 0;
+                uint32_t fileLength = static_cast<uint32_t>(std::strlen(file));
+                uint32_t formatLength = static_cast<uint32_t>(std::strlen(format));
+
+                uint8_t kind = static_cast<uint8_t>(LogFormat::BinaryRecordKind::Format);
+                put(&kind, sizeof(kind));
+                put(&record.formatId, sizeof(record.formatId));
+                put(&line, sizeof(line));
+                put(&fileLength, sizeof(fileLength));
+                put(file, fileLength);
+                put(&formatLength, sizeof(formatLength));
+                put(format, formatLength);
+                m_binaryFormatWritten[record.formatId] = true;
             }
         }
+
+        uint8_t kind = static_cast<uint8_t>(LogFormat::BinaryRecordKind::Message);
+        put(&kind, sizeof(kind));
+        put(&record.formatId, sizeof(record.formatId));
+        put(&record.level, sizeof(record.level));
+        put(&record.timestampNs, sizeof(record.timestampNs));
+        put(&record.size, sizeof(record.size));
+        put(record.data, record.size);
+    }
+
+    void Logger::ReportDroppedMessages()
+    {
+        uint64_t dropped = m_droppedCount.load(std::memory_order_relaxed);
+        if (dropped == m_reportedDrops)
+        {
+            return;
+        }
+        WriteFormatted(LogLevel::WARNING,
+                       FormatMessageWithContext(LogLevel::WARNING, "Log queue full: " + std::to_string(dropped - m_reportedDrops) +
+                                                                       " messages dropped"));
+        m_reportedDrops = dropped;
     }
 
     void Logger::WriteLogEntry(const LogEntry &entry)
@@ -272,41 +510,159 @@ namespace Core
             return;
         }
 
-        // 检查轮转
-        CheckRotation();
-
-        // 如果消息还没有格式化（异步模式），现在格式化
+        // 如果消息还没有格式化，现在格式化
         std::string finalMessage = entry.formattedMessage;
         if (finalMessage.empty()) {
             finalMessage = FormatMessageWithContext(entry.level, entry.message);
         }
 
-        // 输出到文件
-        if (m_logFile.is_open())
+        WriteFormatted(entry.level, finalMessage);
+    }
+
+    void Logger::WriteFormatted(LogLevel level, const std::string &finalMessage)
+    {
+        // 追加到文件缓冲（轮转检查和写入在 FlushLogFile 中按批进行）
+        if (m_logFile.is_open() && m_fileBuffer)
         {
-            m_logFile << finalMessage << std::endl;
-            m_logFile.flush();
+            size_t needed = finalMessage.size() + 1;
+            size_t size = m_fileBufferSize.load(std::memory_order_relaxed);
+            if (size + needed > m_fileBufferCapacity)
+            {
+                FlushLogFile();
+                size = 0;
+            }
+
+            if (needed > m_fileBufferCapacity)
+            {
+                // 超过整个缓冲的消息直接写入
+                CheckRotation();
+                m_logFile << finalMessage << '\n';
+                m_logFile.flush();
+            }
+            else
+            {
+                std::memcpy(m_fileBuffer.get() + size, finalMessage.data(), finalMessage.size());
+                m_fileBuffer[size + finalMessage.size()] = '\n';
+                m_fileBufferSize.store(size + needed, std::memory_order_release);
+            }
         }
 
-        // 输出到控制台
         if (m_consoleOutput)
         {
-            std::ostream &stream = (entry.level == LogLevel::ERROR) ? std::cerr : std::cout;
-            stream << finalMessage << std::endl;
+            AppendConsole(level, finalMessage);
+        }
+
+        bool urgent = level == LogLevel::ERROR && m_flushConfig.flushOnError;
+        if (!m_asyncMode || urgent || m_fileBufferSize.load(std::memory_order_relaxed) >= m_flushConfig.maxBufferedBytes)
+        {
+            FlushLogFile();
+        }
+        if (!m_asyncMode || urgent)
+        {
+            FlushConsole();
         }
     }
 
+    void Logger::AppendConsole(LogLevel level, const std::string &finalMessage)
+    {
+        bool isError = level == LogLevel::ERROR;
+        if (isError != m_consoleBufferIsError)
+        {
+            FlushConsole();
+            m_consoleBufferIsError = isError;
+        }
+        m_consoleBuffer += finalMessage;
+        m_consoleBuffer += '\n';
+    }
+
+    void Logger::FlushConsole()
+    {
+        if (m_consoleBuffer.empty())
+        {
+            return;
+        }
+        std::ostream &stream = m_consoleBufferIsError ? std::cerr : std::cout;
+        stream.write(m_consoleBuffer.data(), static_cast<std::streamsize>(m_consoleBuffer.size()));
+        stream.flush();
+        m_consoleBuffer.clear();
+    }
+
     void Logger::FlushLogFile()
     {
-        if (m_logFile.is_open())
+        size_t size = m_fileBufferSize.load(std::memory_order_relaxed);
+        if (size > 0 && m_logFile.is_open())
         {
+            // ⭐ 轮转每批检查一次，整批一次写入
+            CheckRotation();
+            m_logFile.write(m_fileBuffer.get(), static_cast<std::streamsize>(size));
             m_logFile.flush();
         }
+        m_fileBufferSize.store(0, std::memory_order_release);
+
+        if (m_binaryLog.is_open())
+        {
+            m_binaryLog.flush();
+        }
+        m_lastFlushTime = std::chrono::steady_clock::now();
+    }
+
+    bool Logger::ShouldFlushLogFile() const
+    {
+        return std::chrono::steady_clock::now() - m_lastFlushTime >= std::chrono::milliseconds(m_flushConfig.intervalMs);
+    }
+
+    void Logger::HandleFatalSignal(int signal)
+    {
+        // ⚠️ 尽力而为：写入线程可能正在提交，同一段日志可能被写两次
+        Logger &logger = GetInstance();
+        size_t size = logger.m_fileBufferSize.load(std::memory_order_acquire);
+        if (size > 0 && logger.m_fileBuffer)
+        {
+            AppendToFileUnsafe(logger.m_baseFilePath.c_str(), logger.m_fileBuffer.get(), size);
+        }
+
+        // 恢复之前的处理方式并重新触发，保留默认的崩溃行为（core dump / 退出码）
+        for (size_t i = 0; i < kFatalSignalCount; ++i)
+        {
+            if (kFatalSignals[i] == signal)
+            {
+                SignalHandler previous = s_previousHandlers[i];
+                std::signal(signal, (previous == SIG_ERR || previous == nullptr) ? SIG_DFL : previous);
+            }
+        }
+        std::raise(signal);
+    }
+
+    void Logger::InstallSignalHandlers()
+    {
+        for (size_t i = 0; i < kFatalSignalCount; ++i)
+        {
+            s_previousHandlers[i] = std::signal(kFatalSignals[i], &Logger::HandleFatalSignal);
+        }
+        m_signalHandlersInstalled = true;
+    }
+
+    void Logger::RestoreSignalHandlers()
+    {
+        if (!m_signalHandlersInstalled)
+        {
+            return;
+        }
+        for (size_t i = 0; i < kFatalSignalCount; ++i)
+        {
+            SignalHandler previous = s_previousHandlers[i];
+            std::signal(kFatalSignals[i], (previous == SIG_ERR || previous == nullptr) ? SIG_DFL : previous);
+        }
+        m_signalHandlersInstalled = false;
     }
 
     std::string Logger::GetTimestamp() const
     {
-        auto now = std::chrono::system_clock::now();
+        return FormatTimestamp(std::chrono::system_clock::now());
+    }
+
+    std::string Logger::FormatTimestamp(std::chrono::system_clock::time_point now) const
+    {
         auto time = std::chrono::system_clock::to_time_t(now);
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                       now.time_since_epoch()) %
@@ -451,7 +807,13 @@ namespace Core
 
     std::string Logger::FormatMessageWithContext(LogLevel level, const std::string &message)
     {
-        std::string timestamp = GetTimestamp();
+        return FormatMessageWithContext(level, message, std::chrono::system_clock::now());
+    }
+
+    std::string Logger::FormatMessageWithContext(LogLevel level, const std::string &message,
+                                                 std::chrono::system_clock::time_point time)
+    {
+        std::string timestamp = FormatTimestamp(time);
         std::string levelStr = LevelToString(level);
 
         std::string contextStr;
@@ -491,13 +853,6 @@ namespace Core
         return result;
     }
 
-    bool Logger::ShouldLogStatistics()
-    {
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - m_lastStatsTime).count();
-        return elapsed >= 5; // 每5秒输出一次统计
-    }
-
     void Logger::SetContext(const LogContext &context)
     {
         std::lock_guard<std::mutex> lock(m_configMutex);
@@ -532,65 +887,11 @@ namespace Core
         }
     }
 
-    void Logger::LogShaderActivation(unsigned int shaderId)
-    {
-        m_statistics.shaderActivations++;
-        // DEBUG 级别的日志已被删除
-    }
-
-    void Logger::LogTextureBind(unsigned int textureId)
-    {
-        m_statistics.textureBinds++;
-        // 纹理绑定通常过于频繁，减少日志输出
-    }
-
-    void Logger::LogDrawCall(int triangleCount)
-    {
-        m_statistics.drawCalls++;
-        m_statistics.meshRenders++;
-        // DrawCall通常也比较频繁，使用统计摘要
-    }
-
-    void Logger::LogStatisticsSummary()
-    {
-        if (!ShouldLogStatistics())
-        {
-            return;
-        }
-
-        auto fps = m_frameCount.load();
-        auto shaderCount = m_statistics.shaderActivations.load();
-        auto drawCalls = m_statistics.drawCalls.load();
-        auto meshRenders = m_statistics.meshRenders.load();
-
-        std::string summary = "FrameSummary: FPS=" + std::to_string(fps) +
-                              ", Shaders=" + std::to_string(shaderCount) +
-                              ", DrawCalls=" + std::to_string(drawCalls) +
-                              ", Meshes=" + std::to_string(meshRenders);
-
-        Info(summary);
-
-        // 重置统计数据
-        ResetStatistics();
-        m_frameCount = 0;
-        m_lastStatsTime = std::chrono::steady_clock::now();
-    }
-
-    void Logger::ResetStatistics()
-    {
-        m_statistics.Reset();
-    }
-
     void Logger::SetFPS(int fps)
     {
         m_frameCount = fps;
     }
 
-    const LogStatistics &Logger::GetStatistics() const
-    {
-        return m_statistics;
-    }
-
     int Logger::GetFPS() const
     {
         return m_frameCount.load();
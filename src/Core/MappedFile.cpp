@@ -0,0 +1,211 @@
+#include "Core/MappedFile.hpp"
+#include <algorithm>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Core
+{
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Close();
+            m_data = other.m_data;
+            m_size = other.m_size;
+            m_isOpen = other.m_isOpen;
+#ifdef _WIN32
+            m_fileHandle = other.m_fileHandle;
+            m_mappingHandle = other.m_mappingHandle;
+            other.m_fileHandle = nullptr;
+            other.m_mappingHandle = nullptr;
+#endif
+            other.m_data = nullptr;
+            other.m_size = 0;
+            other.m_isOpen = false;
+        }
+        return *this;
+    }
+
+#ifdef _WIN32
+
+    bool MappedFile::Open(const std::string& filepath)
+    {
+        Close();
+
+        HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize))
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        m_fileHandle = file;
+        m_size = static_cast<size_t>(fileSize.QuadPart);
+        m_isOpen = true;
+        if (m_size == 0)
+        {
+            return true; // 空文件无法创建映射对象
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            Close();
+            return false;
+        }
+        m_mappingHandle = mapping;
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr)
+        {
+            Close();
+            return false;
+        }
+        m_data = static_cast<const uint8_t*>(view);
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_data != nullptr)
+        {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mappingHandle != nullptr)
+        {
+            CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+        }
+        if (m_fileHandle != nullptr)
+        {
+            CloseHandle(static_cast<HANDLE>(m_fileHandle));
+        }
+        m_data = nullptr;
+        m_size = 0;
+        m_isOpen = false;
+        m_fileHandle = nullptr;
+        m_mappingHandle = nullptr;
+    }
+
+    void MappedFile::Release(size_t, size_t) const
+    {
+        // 只读映射的页由工作集管理器按需换出，无需显式处理
+    }
+
+    void MappedFile::Prefetch() const
+    {
+        // PrefetchVirtualMemory 需要 Windows 8，这里依赖系统自身的顺序预读
+    }
+
+#else
+
+    bool MappedFile::Open(const std::string& filepath)
+    {
+        Close();
+
+        int fd = ::open(filepath.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        size_t size = static_cast<size_t>(info.st_size);
+        if (size > 0)
+        {
+            void* view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view == MAP_FAILED)
+            {
+                ::close(fd);
+                return false;
+            }
+            ::madvise(view, size, MADV_SEQUENTIAL);
+            m_data = static_cast<const uint8_t*>(view);
+        }
+        ::close(fd); // 映射保持有效，不需要文件描述符
+
+        m_size = size;
+        m_isOpen = true;
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_data != nullptr)
+        {
+            ::munmap(const_cast<uint8_t*>(m_data), m_size);
+        }
+        m_data = nullptr;
+        m_size = 0;
+        m_isOpen = false;
+    }
+
+    void MappedFile::Release(size_t offset, size_t length) const
+    {
+        if (m_data == nullptr || offset >= m_size)
+        {
+            return;
+        }
+        length = std::min(length, m_size - offset);
+
+        // madvise 要求页对齐：起点向上、终点向下取整，不影响范围外的页
+        const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(m_data) + offset;
+        const uintptr_t end = begin + length;
+        const uintptr_t alignedBegin = (begin + pageSize - 1) & ~(pageSize - 1);
+        const uintptr_t alignedEnd = end & ~(pageSize - 1);
+        if (alignedBegin < alignedEnd)
+        {
+            ::madvise(reinterpret_cast<void*>(alignedBegin), alignedEnd - alignedBegin, MADV_DONTNEED);
+        }
+    }
+
+    void MappedFile::Prefetch() const
+    {
+        if (m_data != nullptr)
+        {
+            // mmap 返回的起始地址本身页对齐
+            ::madvise(const_cast<uint8_t*>(m_data), m_size, MADV_WILLNEED);
+        }
+    }
+
+#endif
+
+} // namespace Core
@@ -0,0 +1,237 @@
+#include "Core/Profiler.hpp"
+#include "Core/Logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace Core
+{
+
+    namespace
+    {
+        constexpr uint64_t kMask = Profiler::kThreadCapacity - 1;
+        static_assert((Profiler::kThreadCapacity & kMask) == 0, "capacity must be a power of two");
+
+        constexpr uint32_t kGpuThreadId = 0;
+
+        // 本线程的缓冲（首次记录时注册）
+        thread_local void *t_threadBuffer = nullptr;
+
+        int64_t SteadyNowNs()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        }
+
+        void AppendEscaped(std::string &out, const char *text)
+        {
+            for (const char *p = text ? text : ""; *p != '\0'; ++p)
+            {
+                char c = *p;
+                if (c == '"' || c == '\\')
+                {
+                    out += '\\';
+                    out += c;
+                }
+                else if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    out += ' ';
+                }
+                else
+                {
+                    out += c;
+                }
+            }
+        }
+
+    } // namespace
+
+    void Profiler::ThreadBuffer::Push(const char *name, int64_t startNs, int64_t endNs)
+    {
+        uint64_t index = writeIndex.load(std::memory_order_relaxed);
+        Slot &slot = slots[index & kMask];
+
+        // 覆盖旧区间前，保证导出线程能通过 writeIndex 发现覆盖（同顺序锁）
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.startNs.store(startNs, std::memory_order_relaxed);
+        slot.endNs.store(endNs, std::memory_order_relaxed);
+        writeIndex.store(index + 1, std::memory_order_release);
+    }
+
+    void Profiler::ThreadBuffer::Snapshot(std::vector<ProfileZone> &out) const
+    {
+        uint64_t end = writeIndex.load(std::memory_order_acquire);
+        uint64_t begin = end > kThreadCapacity ? end - kThreadCapacity : 0;
+
+        size_t first = out.size();
+        for (uint64_t index = begin; index < end; ++index)
+        {
+            const Slot &slot = slots[index & kMask];
+            ProfileZone zone;
+            zone.name = slot.name.load(std::memory_order_relaxed);
+            zone.startNs = slot.startNs.load(std::memory_order_relaxed);
+            zone.endNs = slot.endNs.load(std::memory_order_relaxed);
+            out.push_back(zone);
+        }
+
+        // 复制期间被写入线程覆盖的区间丢弃（写入位置 after 正在覆盖 after - 容量）
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = writeIndex.load(std::memory_order_relaxed);
+        uint64_t validBegin = after >= kThreadCapacity ? after - kThreadCapacity + 1 : 0;
+        if (validBegin > begin)
+        {
+            size_t invalid = static_cast<size_t>(std::min(validBegin, end) - begin);
+            out.erase(out.begin() + static_cast<std::ptrdiff_t>(first),
+                      out.begin() + static_cast<std::ptrdiff_t>(first + invalid));
+        }
+    }
+
+    Profiler::Profiler()
+        : m_epochNs(SteadyNowNs()), m_gpuTrack(std::make_unique<ThreadBuffer>(kGpuThreadId))
+    {
+        m_gpuTrack->threadName.store("GPU", std::memory_order_relaxed);
+    }
+
+    Profiler &Profiler::GetInstance()
+    {
+        static Profiler instance;
+        return instance;
+    }
+
+    int64_t Profiler::Now() const
+    {
+        return SteadyNowNs() - m_epochNs;
+    }
+
+    Profiler::ThreadBuffer &Profiler::GetThreadBuffer()
+    {
+        if (t_threadBuffer == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(m_registryMutex);
+            m_threads.push_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(m_threads.size() + 1)));
+            t_threadBuffer = m_threads.back().get();
+        }
+        return *static_cast<ThreadBuffer *>(t_threadBuffer);
+    }
+
+    void Profiler::RecordZone(const char *name, int64_t startNs, int64_t endNs)
+    {
+        GetThreadBuffer().Push(name, startNs, endNs);
+    }
+
+    void Profiler::SetThreadName(const char *name)
+    {
+        GetThreadBuffer().threadName.store(name, std::memory_order_relaxed);
+    }
+
+    void Profiler::EndFrame()
+    {
+        int64_t now = Now();
+        if (m_lastFrameNs != 0)
+        {
+            RecordZone("Frame", m_lastFrameNs, now);
+        }
+        m_lastFrameNs = now;
+        m_frameIndex.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Profiler::RecordGpuZone(const char *name, int64_t startNs, int64_t endNs)
+    {
+        m_gpuTrack->Push(name, startNs, endNs);
+    }
+
+    bool Profiler::ExportChromeTrace(const std::string &path) const
+    {
+        // 先在锁内复制所有缓冲，格式化和写文件在锁外进行
+        struct Track
+        {
+            uint32_t threadId;
+            const char *threadName;
+            std::vector<ProfileZone> zones;
+        };
+        std::vector<Track> tracks;
+        {
+            std::lock_guard<std::mutex> lock(m_registryMutex);
+            tracks.reserve(m_threads.size() + 1);
+            auto snapshot = [&tracks](const ThreadBuffer &buffer)
+            {
+                Track track{buffer.threadId, buffer.threadName.load(std::memory_order_relaxed), {}};
+                buffer.Snapshot(track.zones);
+                tracks.push_back(std::move(track));
+            };
+            snapshot(*m_gpuTrack);
+            for (const auto &buffer : m_threads)
+            {
+                snapshot(*buffer);
+            }
+        }
+
+        std::string json;
+        json.reserve(1 << 20);
+        json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        size_t zoneCount = 0;
+        bool first = true;
+        char number[128];
+        for (const Track &track : tracks)
+        {
+            if (track.zones.empty() && track.threadName == nullptr)
+            {
+                continue;
+            }
+
+            // 线程名元数据
+            json += first ? "" : ",\n";
+            first = false;
+            std::snprintf(number, sizeof(number), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+                          track.threadId);
+            json += number;
+            if (track.threadName)
+            {
+                AppendEscaped(json, track.threadName);
+            }
+            else
+            {
+                std::snprintf(number, sizeof(number), "Thread %u", track.threadId);
+                json += number;
+            }
+            json += "\"}}";
+
+            const char *category = track.threadId == kGpuThreadId ? "gpu" : "cpu";
+            for (const ProfileZone &zone : track.zones)
+            {
+                json += ",\n{\"name\":\"";
+                AppendEscaped(json, zone.name);
+                std::snprintf(number, sizeof(number), "\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                              category, track.threadId, zone.startNs / 1000.0,
+                              (zone.endNs > zone.startNs ? zone.endNs - zone.startNs : 0) / 1000.0);
+                json += number;
+            }
+            zoneCount += track.zones.size();
+        }
+        json += "\n]}\n";
+
+        fs::path filePath(path);
+        std::error_code ec;
+        if (filePath.has_parent_path())
+        {
+            fs::create_directories(filePath.parent_path(), ec);
+        }
+        std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out || !out.write(json.data(), static_cast<std::streamsize>(json.size())))
+        {
+            Core::Logger::GetInstance().Error("Failed to write profiler trace: " + path);
+            return false;
+        }
+
+        Core::Logger::GetInstance().Info("Profiler trace exported: " + path + " (" + std::to_string(zoneCount) +
+                                         " zones, " + std::to_string(tracks.size()) + " tracks)");
+        return true;
+    }
+
+} // namespace Core
@@ -0,0 +1,137 @@
+#include "Core/ThreadPool.hpp"
+#include "Core/Profiler.hpp"
+#include <algorithm>
+
+namespace Core
+{
+
+    namespace
+    {
+        // 当前线程所属的线程池（非工作线程为 nullptr）
+        thread_local const ThreadPool* t_currentPool = nullptr;
+    }
+
+    ThreadPool& ThreadPool::GetInstance()
+    {
+        static ThreadPool instance;
+        return instance;
+    }
+
+    ThreadPool::ThreadPool(size_t threadCount)
+    {
+        if (threadCount == 0)
+        {
+            unsigned int hardwareThreads = std::thread::hardware_concurrency();
+            threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        m_workers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i)
+        {
+            m_workers.emplace_back([this]() { WorkerLoop(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_condition.notify_all();
+
+        for (auto& worker : m_workers)
+        {
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+    }
+
+    bool ThreadPool::IsWorkerThread() const
+    {
+        return t_currentPool == this;
+    }
+
+    void ThreadPool::Enqueue(std::function<void()> task)
+    {
+        bool queued = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_stopping)
+            {
+                m_tasks.push(std::move(task));
+                queued = true;
+            }
+        }
+
+        if (!queued)
+        {
+            // 析构期间提交的任务直接在调用线程执行，保证 future 总能完成
+            task();
+            return;
+        }
+        m_condition.notify_one();
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        t_currentPool = this;
+        PROFILE_THREAD("Worker");
+
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+
+                // 退出前先清空队列（例如后台写缓存的任务）
+                if (m_tasks.empty())
+                {
+                    return;
+                }
+                task = std::move(m_tasks.front());
+                m_tasks.pop();
+            }
+            task();
+        }
+    }
+
+    void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t, size_t)>& body, size_t minChunk)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        minChunk = std::max<size_t>(1, minChunk);
+        size_t maxChunks = (count + minChunk - 1) / minChunk;
+        size_t chunkCount = std::min(maxChunks, m_workers.size() + 1);
+        if (chunkCount <= 1 || IsWorkerThread())
+        {
+            body(0, count);
+            return;
+        }
+
+        size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+        std::vector<std::future<void>> futures;
+        futures.reserve(chunkCount - 1);
+
+        // 前 chunkCount - 1 块交给工作线程，最后一块由调用线程执行
+        for (size_t chunk = 0; chunk + 1 < chunkCount; ++chunk)
+        {
+            size_t begin = chunk * chunkSize;
+            size_t end = std::min(count, begin + chunkSize);
+            futures.push_back(Submit([&body, begin, end]() { body(begin, end); }));
+        }
+        body(std::min(count, (chunkCount - 1) * chunkSize), count);
+
+        for (auto& future : futures)
+        {
+            future.get(); // 传播任务中的异常
+        }
+    }
+
+} // namespace Core
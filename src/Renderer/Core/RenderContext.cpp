@@ -38,6 +38,9 @@ namespace Renderer
             case AmbientLighting::Mode::HEMISPHERE:
                 oss << "Hemisphere";
                 break;
+            case AmbientLighting::Mode::SPHERICAL_HARMONICS:
+                oss << "Spherical Harmonics (SH9)";
+                break;
             }
 
             oss << "\n";
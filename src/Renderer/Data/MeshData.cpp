@@ -1,10 +1,14 @@
 #include "Renderer/Data/MeshData.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 
 namespace Renderer
 {
 
     void MeshData::SetVertices(const std::vector<float>& vertices, size_t stride)
     {
+        m_vertexView = nullptr;
         m_vertices = vertices;
         m_vertexStride = stride;
         m_vertexCount = stride > 0 ? vertices.size() / stride : 0;
@@ -12,6 +16,7 @@ namespace Renderer
 
     void MeshData::SetVertices(std::vector<float>&& vertices, size_t stride)
     {
+        m_vertexView = nullptr;
         m_vertices = std::move(vertices);
         m_vertexStride = stride;
         m_vertexCount = stride > 0 ? m_vertices.size() / stride : 0;
@@ -19,32 +24,131 @@ namespace Renderer
 
     void MeshData::SetIndices(const std::vector<unsigned int>& indices)
     {
+        m_indexView = nullptr;
         m_indices = indices;
         m_indexCount = indices.size();
+        m_meshlets.clear();
     }
 
     void MeshData::SetIndices(std::vector<unsigned int>&& indices)
     {
+        m_indexView = nullptr;
         m_indices = std::move(indices);
         m_indexCount = m_indices.size();
+        m_meshlets.clear();
+    }
+
+    void MeshData::SetVertexView(const float* data, size_t floatCount, size_t stride, std::shared_ptr<const void> owner)
+    {
+        m_vertices.clear();
+        m_vertexView = data;
+        m_vertexStride = stride;
+        m_vertexCount = stride > 0 ? floatCount / stride : 0;
+        if (owner)
+        {
+            m_viewOwner = std::move(owner);
+        }
+    }
+
+    void MeshData::SetIndexView(const unsigned int* data, size_t count, std::shared_ptr<const void> owner)
+    {
+        m_indices.clear();
+        m_indexView = count > 0 ? data : nullptr;
+        m_indexCount = count;
+        m_meshlets.clear();
+        if (owner)
+        {
+            m_viewOwner = std::move(owner);
+        }
     }
 
     void MeshData::SetVertexLayout(const std::vector<size_t>& offsets, const std::vector<int>& sizes)
     {
         m_attributeOffsets = offsets;
         m_attributeSizes = sizes;
+        m_attributeLocations.clear();
+        m_attributeTypes.clear();
+    }
+
+    void MeshData::SetVertexLayout(const std::vector<size_t>& offsets, const std::vector<int>& sizes,
+                                   const std::vector<unsigned int>& locations)
+    {
+        m_attributeOffsets = offsets;
+        m_attributeSizes = sizes;
+        m_attributeLocations = locations;
+        m_attributeTypes.clear();
+    }
+
+    void MeshData::SetVertexLayout(const std::vector<size_t>& offsets, const std::vector<int>& sizes,
+                                   const std::vector<unsigned int>& locations,
+                                   const std::vector<VertexAttributeType>& types)
+    {
+        m_attributeOffsets = offsets;
+        m_attributeSizes = sizes;
+        m_attributeLocations = locations;
+        m_attributeTypes = types;
+    }
+
+    void MeshData::SetPositionDequantization(const glm::vec3& scale, const glm::vec3& offset)
+    {
+        m_positionQuantized = true;
+        m_positionScale = scale;
+        m_positionOffset = offset;
+    }
+
+    float MeshData::ComputeBoundingRadius() const
+    {
+        if (m_vertexStride < 3)
+        {
+            return 0.0f;
+        }
+
+        size_t positionOffset = m_attributeOffsets.empty() ? 0 : m_attributeOffsets[0];
+        const float* vertices = GetVertexData();
+        float maxLengthSq = 0.0f;
+
+        // 量化位置：int16 snorm * scale + offset
+        if (m_positionQuantized && GetAttributeType(0) == VertexAttributeType::Short)
+        {
+            for (size_t i = 0; i < m_vertexCount; ++i)
+            {
+                int16_t q[3];
+                std::memcpy(q, &vertices[i * m_vertexStride + positionOffset], sizeof(q));
+                glm::vec3 p = glm::vec3(q[0], q[1], q[2]) / 32767.0f * m_positionScale + m_positionOffset;
+                maxLengthSq = std::max(maxLengthSq, glm::dot(p, p));
+            }
+            return std::sqrt(maxLengthSq);
+        }
+
+        for (size_t i = 0; i < m_vertexCount; ++i)
+        {
+            const float* p = &vertices[i * m_vertexStride + positionOffset];
+            maxLengthSq = std::max(maxLengthSq, p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        }
+        return std::sqrt(maxLengthSq);
     }
 
     void MeshData::Clear()
     {
         m_vertices.clear();
         m_indices.clear();
+        m_vertexView = nullptr;
+        m_indexView = nullptr;
+        m_viewOwner.reset();
+        m_meshlets.clear();
         m_attributeOffsets.clear();
         m_attributeSizes.clear();
+        m_attributeLocations.clear();
+        m_attributeTypes.clear();
+        m_positionQuantized = false;
+        m_positionScale = glm::vec3(1.0f);
+        m_positionOffset = glm::vec3(0.0f);
         m_vertexStride = 0;
         m_vertexCount = 0;
         m_indexCount = 0;
         m_materialColor = glm::vec3(1.0f);
+        m_texturePath.clear();
+        m_textureArrayIndex = -1;
     }
 
 } // namespace Renderer
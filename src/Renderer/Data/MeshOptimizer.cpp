@@ -0,0 +1,425 @@
+#include "Renderer/Data/MeshOptimizer.hpp"
+#include "Renderer/Data/MeshData.hpp"
+#include "Core/GLM.hpp"
+#include "Core/Logger.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+
+namespace Renderer
+{
+    namespace
+    {
+        constexpr unsigned int kInvalidIndex = ~0u;
+
+        /**
+         * @brief 顶点 → 相邻三角形列表（CSR 格式）
+         */
+        struct TriangleAdjacency
+        {
+            std::vector<unsigned int> offsets;    // vertexCount + 1
+            std::vector<unsigned int> triangles;
+
+            void Build(const std::vector<unsigned int>& indices, size_t vertexCount)
+            {
+                offsets.assign(vertexCount + 1, 0);
+                for (unsigned int v : indices)
+                {
+                    ++offsets[v + 1];
+                }
+                for (size_t v = 0; v < vertexCount; ++v)
+                {
+                    offsets[v + 1] += offsets[v];
+                }
+
+                triangles.resize(indices.size());
+                std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+                for (size_t i = 0; i < indices.size(); ++i)
+                {
+                    triangles[cursor[indices[i]]++] = static_cast<unsigned int>(i / 3);
+                }
+            }
+        };
+
+        /**
+         * @brief 基于时间戳的 FIFO 缓存模拟（与 AnalyzeVertexCache 相同的模型）
+         */
+        struct FifoCache
+        {
+            std::vector<unsigned int> timestamps;
+            unsigned int time;
+            uint32_t size;
+
+            FifoCache(size_t vertexCount, uint32_t cacheSize)
+                : timestamps(vertexCount, 0), time(cacheSize + 1), size(cacheSize)
+            {
+            }
+
+            void Reset()
+            {
+                // 时间戳整体前移一个缓存大小即可使所有项失效，无需清零数组
+                time += size + 1;
+            }
+
+            // 返回是否未命中
+            bool Access(unsigned int v)
+            {
+                if (time - timestamps[v] > size)
+                {
+                    timestamps[v] = time++;
+                    return true;
+                }
+                return false;
+            }
+
+            unsigned int AccessTriangle(const unsigned int* tri)
+            {
+                return static_cast<unsigned int>(Access(tri[0])) + Access(tri[1]) + Access(tri[2]);
+            }
+        };
+    } // namespace
+
+    VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const unsigned int* indices, size_t indexCount,
+                                                            size_t vertexCount, uint32_t cacheSize)
+    {
+        VertexCacheStatistics stats;
+        stats.triangleCount = indexCount / 3;
+        stats.vertexCount = vertexCount;
+        if (stats.triangleCount == 0 || vertexCount == 0)
+        {
+            return stats;
+        }
+
+        FifoCache cache(vertexCount, cacheSize);
+        for (size_t i = 0; i + 2 < indexCount; i += 3)
+        {
+            stats.transformedVertices += cache.AccessTriangle(indices + i);
+        }
+
+        stats.acmr = static_cast<float>(stats.transformedVertices) / static_cast<float>(stats.triangleCount);
+        stats.atvr = static_cast<float>(stats.transformedVertices) / static_cast<float>(vertexCount);
+        return stats;
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount, uint32_t cacheSize)
+    {
+        const size_t triangleCount = indices.size() / 3;
+        if (triangleCount == 0 || vertexCount == 0)
+        {
+            return;
+        }
+
+        TriangleAdjacency adjacency;
+        adjacency.Build(indices, vertexCount);
+
+        // 每个顶点剩余未输出的相邻三角形数
+        std::vector<unsigned int> live(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            live[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+        }
+
+        std::vector<unsigned int> cacheTime(vertexCount, 0);
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<unsigned int> deadEnd;  // 最近输出过的顶点（用于死胡同时回退）
+        std::vector<unsigned int> candidates;
+        std::vector<unsigned int> output;
+        output.reserve(indices.size());
+
+        const unsigned int k = cacheSize;
+        unsigned int time = k + 1;
+        size_t cursor = 0;  // 顺序扫描的回退位置
+        long long fanVertex = 0;
+
+        while (fanVertex >= 0)
+        {
+            const unsigned int f = static_cast<unsigned int>(fanVertex);
+            candidates.clear();
+
+            // 输出 f 的所有未输出三角形
+            for (unsigned int a = adjacency.offsets[f]; a < adjacency.offsets[f + 1]; ++a)
+            {
+                const unsigned int tri = adjacency.triangles[a];
+                if (emitted[tri])
+                {
+                    continue;
+                }
+                emitted[tri] = true;
+
+                for (int c = 0; c < 3; ++c)
+                {
+                    const unsigned int v = indices[tri * 3 + c];
+                    output.push_back(v);
+                    deadEnd.push_back(v);
+                    candidates.push_back(v);
+                    --live[v];
+                    if (time - cacheTime[v] > k)
+                    {
+                        cacheTime[v] = time++;
+                    }
+                }
+            }
+
+            // 选择下一个扇形中心：仍在缓存中且输出其剩余三角形后仍不会被挤出的顶点，优先最早进入缓存的
+            fanVertex = -1;
+            long long bestPriority = -1;
+            for (unsigned int v : candidates)
+            {
+                if (live[v] == 0)
+                {
+                    continue;
+                }
+                long long priority = 0;
+                if (time - cacheTime[v] + 2 * live[v] <= k)
+                {
+                    priority = time - cacheTime[v];
+                }
+                if (priority > bestPriority)
+                {
+                    bestPriority = priority;
+                    fanVertex = v;
+                }
+            }
+
+            if (fanVertex >= 0)
+            {
+                continue;
+            }
+
+            // 死胡同：先回退到最近输出的顶点，再顺序扫描
+            while (!deadEnd.empty())
+            {
+                const unsigned int v = deadEnd.back();
+                deadEnd.pop_back();
+                if (live[v] > 0)
+                {
+                    fanVertex = v;
+                    break;
+                }
+            }
+            while (fanVertex < 0 && cursor < vertexCount)
+            {
+                if (live[cursor] > 0)
+                {
+                    fanVertex = static_cast<long long>(cursor);
+                }
+                ++cursor;
+            }
+        }
+
+        indices.swap(output);
+    }
+
+    void MeshOptimizer::OptimizeOverdraw(std::vector<unsigned int>& indices, const float* vertices, size_t vertexCount,
+                                         size_t stride, size_t positionOffset, uint32_t cacheSize, float threshold)
+    {
+        const size_t triangleCount = indices.size() / 3;
+        if (triangleCount == 0 || vertexCount == 0 || stride < positionOffset + 3)
+        {
+            return;
+        }
+
+        auto position = [&](unsigned int v) {
+            const float* p = vertices + static_cast<size_t>(v) * stride + positionOffset;
+            return glm::vec3(p[0], p[1], p[2]);
+        };
+
+        // 1. 硬边界：三个顶点全部未命中的三角形（Tipsify 跳到了新的区域）
+        std::vector<size_t> hardBoundaries;
+        {
+            FifoCache cache(vertexCount, cacheSize);
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                if (cache.AccessTriangle(&indices[t * 3]) == 3)
+                {
+                    hardBoundaries.push_back(t);
+                }
+            }
+            if (hardBoundaries.empty() || hardBoundaries.front() != 0)
+            {
+                hardBoundaries.insert(hardBoundaries.begin(), 0);
+            }
+            hardBoundaries.push_back(triangleCount);
+        }
+
+        // 2. 软边界：在硬聚类内部继续切分，只要切出的片段（缓存冷启动）的 ACMR 不超过整个聚类的 threshold 倍
+        std::vector<size_t> boundaries;
+        {
+            FifoCache cache(vertexCount, cacheSize);
+            for (size_t h = 0; h + 1 < hardBoundaries.size(); ++h)
+            {
+                const size_t begin = hardBoundaries[h];
+                const size_t end = hardBoundaries[h + 1];
+
+                cache.Reset();
+                size_t clusterMisses = 0;
+                for (size_t t = begin; t < end; ++t)
+                {
+                    clusterMisses += cache.AccessTriangle(&indices[t * 3]);
+                }
+                const float clusterACMR = static_cast<float>(clusterMisses) / static_cast<float>(end - begin);
+
+                cache.Reset();
+                boundaries.push_back(begin);
+                size_t start = begin;
+                size_t misses = 0;
+                for (size_t t = begin; t < end; ++t)
+                {
+                    misses += cache.AccessTriangle(&indices[t * 3]);
+                    const float acmr = static_cast<float>(misses) / static_cast<float>(t + 1 - start);
+                    if (t + 1 < end && acmr <= clusterACMR * threshold)
+                    {
+                        boundaries.push_back(t + 1);
+                        cache.Reset();
+                        start = t + 1;
+                        misses = 0;
+                    }
+                }
+            }
+            boundaries.push_back(triangleCount);
+        }
+
+        // 3. 每个聚类的面积加权质心和法线
+        const size_t clusterCount = boundaries.size() - 1;
+        std::vector<glm::vec3> clusterCentroid(clusterCount, glm::vec3(0.0f));
+        std::vector<glm::vec3> clusterNormal(clusterCount, glm::vec3(0.0f));
+        glm::vec3 meshCentroid(0.0f);
+        float meshArea = 0.0f;
+
+        for (size_t c = 0; c < clusterCount; ++c)
+        {
+            float clusterArea = 0.0f;
+            for (size_t t = boundaries[c]; t < boundaries[c + 1]; ++t)
+            {
+                const glm::vec3 p0 = position(indices[t * 3]);
+                const glm::vec3 p1 = position(indices[t * 3 + 1]);
+                const glm::vec3 p2 = position(indices[t * 3 + 2]);
+                const glm::vec3 n = glm::cross(p1 - p0, p2 - p0);  // 长度 = 面积的两倍
+                const float area = glm::length(n);
+
+                clusterCentroid[c] += (p0 + p1 + p2) * (area / 3.0f);
+                clusterNormal[c] += n;
+                clusterArea += area;
+            }
+
+            meshCentroid += clusterCentroid[c];
+            meshArea += clusterArea;
+            clusterCentroid[c] = clusterArea > 0.0f ? clusterCentroid[c] / clusterArea : position(indices[boundaries[c] * 3]);
+
+            const float normalLength = glm::length(clusterNormal[c]);
+            clusterNormal[c] = normalLength > 0.0f ? clusterNormal[c] / normalLength : glm::vec3(0.0f);
+        }
+        if (meshArea > 0.0f)
+        {
+            meshCentroid /= meshArea;
+        }
+
+        // 4. 朝外程度降序（稳定排序保证结果确定）
+        std::vector<float> sortKey(clusterCount);
+        for (size_t c = 0; c < clusterCount; ++c)
+        {
+            sortKey[c] = glm::dot(clusterCentroid[c] - meshCentroid, clusterNormal[c]);
+        }
+        std::vector<size_t> order(clusterCount);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sortKey[a] > sortKey[b]; });
+
+        std::vector<unsigned int> output;
+        output.reserve(indices.size());
+        for (size_t c : order)
+        {
+            output.insert(output.end(), indices.begin() + boundaries[c] * 3, indices.begin() + boundaries[c + 1] * 3);
+        }
+        indices.swap(output);
+    }
+
+    size_t MeshOptimizer::OptimizeVertexFetch(std::vector<float>& vertices, size_t stride, std::vector<unsigned int>& indices)
+    {
+        if (stride == 0)
+        {
+            return 0;
+        }
+
+        const size_t vertexCount = vertices.size() / stride;
+        std::vector<unsigned int> remap(vertexCount, kInvalidIndex);
+        std::vector<float> output;
+        output.reserve(vertices.size());
+
+        unsigned int next = 0;
+        for (unsigned int& index : indices)
+        {
+            if (remap[index] == kInvalidIndex)
+            {
+                remap[index] = next++;
+                output.insert(output.end(), vertices.begin() + static_cast<size_t>(index) * stride,
+                              vertices.begin() + static_cast<size_t>(index + 1) * stride);
+            }
+            index = remap[index];
+        }
+
+        vertices.swap(output);
+        return next;
+    }
+
+    void MeshOptimizer::Optimize(std::vector<float>& vertices, size_t stride, std::vector<unsigned int>& indices,
+                                 const MeshOptimizerConfig& config, VertexCacheStatistics* before,
+                                 VertexCacheStatistics* after)
+    {
+        const size_t vertexCount = stride > 0 ? vertices.size() / stride : 0;
+        if (before)
+        {
+            *before = AnalyzeVertexCache(indices.data(), indices.size(), vertexCount, config.cacheSize);
+        }
+
+        // 越界索引说明数据有误，保持原样
+        const bool valid = vertexCount > 0 && indices.size() % 3 == 0 &&
+                           std::all_of(indices.begin(), indices.end(), [&](unsigned int i) { return i < vertexCount; });
+        if (valid)
+        {
+            if (config.optimizeVertexCache)
+            {
+                OptimizeVertexCache(indices, vertexCount, config.cacheSize);
+            }
+            if (config.optimizeOverdraw)
+            {
+                OptimizeOverdraw(indices, vertices.data(), vertexCount, stride, config.positionOffset,
+                                 config.cacheSize, config.overdrawThreshold);
+            }
+            if (config.optimizeVertexFetch)
+            {
+                OptimizeVertexFetch(vertices, stride, indices);
+            }
+        }
+
+        if (after)
+        {
+            *after = AnalyzeVertexCache(indices.data(), indices.size(), stride > 0 ? vertices.size() / stride : 0,
+                                        config.cacheSize);
+        }
+    }
+
+    bool MeshOptimizer::Optimize(MeshData& mesh, const MeshOptimizerConfig& config)
+    {
+        if (!mesh.HasIndices() || mesh.IsEmpty())
+        {
+            return false;
+        }
+
+        const size_t stride = mesh.GetVertexStride();
+        std::vector<float> vertices(mesh.GetVertexData(), mesh.GetVertexData() + mesh.GetVertexCount() * stride);
+        std::vector<unsigned int> indices(mesh.GetIndexData(), mesh.GetIndexData() + mesh.GetIndexCount());
+
+        VertexCacheStatistics before, after;
+        Optimize(vertices, stride, indices, config, &before, &after);
+
+        mesh.SetVertices(std::move(vertices), stride);
+        mesh.SetIndices(std::move(indices));
+
+        char message[160];
+        std::snprintf(message, sizeof(message), "Mesh optimized: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f (%zu triangles)",
+                      before.acmr, after.acmr, before.atvr, after.atvr, after.triangleCount);
+        Core::Logger::GetInstance().Info(message);
+        return true;
+    }
+
+} // namespace Renderer
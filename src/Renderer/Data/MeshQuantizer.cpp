@@ -0,0 +1,175 @@
+#include "Renderer/Data/MeshQuantizer.hpp"
+#include "Core/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace Renderer
+{
+
+    uint16_t MeshQuantizer::FloatToHalf(float value)
+    {
+        // 饱和到半精度最大有限值，避免超大 UV 变成无穷大
+        if (!(std::fabs(value) <= 65504.0f))
+        {
+            value = std::isnan(value) ? 0.0f : std::copysign(65504.0f, value);
+        }
+
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        uint32_t sign = (bits >> 16) & 0x8000u;
+        int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFFu) - 127 + 15;
+        uint32_t mantissa = bits & 0x7FFFFFu;
+
+        if (exponent <= 0)
+        {
+            if (exponent < -10)
+            {
+                return static_cast<uint16_t>(sign);
+            }
+            mantissa |= 0x800000u;
+            uint32_t shift = static_cast<uint32_t>(14 - exponent);
+            uint32_t half = mantissa >> shift;
+            if ((mantissa >> (shift - 1)) & 1u)
+            {
+                ++half;
+            }
+            return static_cast<uint16_t>(sign | half);
+        }
+
+        uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+        if ((mantissa & 0x1000u) && (half & 0x7FFFu) < 0x7BFFu)
+        {
+            ++half; // 进位可能溢出到指数，结果仍正确（65504 不再向上进位）
+        }
+        return static_cast<uint16_t>(half);
+    }
+
+    uint32_t MeshQuantizer::PackNormal(const glm::vec3& normal)
+    {
+        auto pack = [](float v) {
+            float clamped = std::clamp(std::isnan(v) ? 0.0f : v, -1.0f, 1.0f);
+            int32_t q = static_cast<int32_t>(std::lround(clamped * 511.0f));
+            return static_cast<uint32_t>(q) & 0x3FFu;
+        };
+        return pack(normal.x) | (pack(normal.y) << 10) | (pack(normal.z) << 20);
+    }
+
+    void MeshQuantizer::SetQuantizedLayout(MeshData& mesh, const glm::vec3& scale, const glm::vec3& offset)
+    {
+        mesh.SetVertexLayout({0, 2, 3}, {3, 4, 2}, {0, 1, 2},
+                             {VertexAttributeType::Short, VertexAttributeType::Int2_10_10_10_Rev,
+                              VertexAttributeType::HalfFloat});
+        mesh.SetPositionDequantization(scale, offset);
+    }
+
+    bool MeshQuantizer::Quantize(MeshData& mesh)
+    {
+        const auto& offsets = mesh.GetAttributeOffsets();
+        const auto& sizes = mesh.GetAttributeSizes();
+        if (mesh.IsPositionQuantized() || mesh.IsEmpty() || sizes.size() < 3 ||
+            sizes[0] != 3 || sizes[1] != 3 || sizes[2] != 2)
+        {
+            return false;
+        }
+        for (size_t i = 0; i < sizes.size(); ++i)
+        {
+            if (mesh.GetAttributeType(i) != VertexAttributeType::Float)
+            {
+                return false;
+            }
+        }
+
+        const size_t srcStride = mesh.GetVertexStride();
+        const size_t vertexCount = mesh.GetVertexCount();
+        const float* src = mesh.GetVertexData();
+
+        // 额外属性（例如图集的材质层 / 材质索引）原样以 float 追加
+        size_t extraWords = 0;
+        for (size_t i = 3; i < sizes.size(); ++i)
+        {
+            extraWords += static_cast<size_t>(sizes[i]);
+        }
+        const size_t dstStride = kQuantizedWords + extraWords;
+
+        // 包围盒 → 反量化参数
+        glm::vec3 boundsMin(std::numeric_limits<float>::max());
+        glm::vec3 boundsMax(-std::numeric_limits<float>::max());
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            const float* p = src + v * srcStride + offsets[0];
+            boundsMin = glm::min(boundsMin, glm::vec3(p[0], p[1], p[2]));
+            boundsMax = glm::max(boundsMax, glm::vec3(p[0], p[1], p[2]));
+        }
+        const glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+        const glm::vec3 extent = (boundsMax - boundsMin) * 0.5f;
+        const glm::vec3 invExtent(extent.x > 0.0f ? 1.0f / extent.x : 0.0f,
+                                  extent.y > 0.0f ? 1.0f / extent.y : 0.0f,
+                                  extent.z > 0.0f ? 1.0f / extent.z : 0.0f);
+
+        std::vector<float> packed(vertexCount * dstStride);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            const float* in = src + v * srcStride;
+            uint8_t* out = reinterpret_cast<uint8_t*>(&packed[v * dstStride]);
+
+            // 位置：snorm16（填充分量为 0）
+            const float* p = in + offsets[0];
+            int16_t position[4] = {0, 0, 0, 0};
+            for (int c = 0; c < 3; ++c)
+            {
+                float normalized = std::clamp((p[c] - center[c]) * invExtent[c], -1.0f, 1.0f);
+                position[c] = static_cast<int16_t>(std::lround(normalized * 32767.0f));
+            }
+            std::memcpy(out, position, sizeof(position));
+
+            // 法线：10:10:10:2
+            const float* n = in + offsets[1];
+            uint32_t normal = PackNormal(glm::vec3(n[0], n[1], n[2]));
+            std::memcpy(out + 8, &normal, sizeof(normal));
+
+            // UV：half2
+            const float* uv = in + offsets[2];
+            uint16_t texCoord[2] = {FloatToHalf(uv[0]), FloatToHalf(uv[1])};
+            std::memcpy(out + 12, texCoord, sizeof(texCoord));
+
+            // 额外属性
+            float* extra = &packed[v * dstStride + kQuantizedWords];
+            for (size_t i = 3; i < sizes.size(); ++i)
+            {
+                std::memcpy(extra, in + offsets[i], static_cast<size_t>(sizes[i]) * sizeof(float));
+                extra += sizes[i];
+            }
+        }
+
+        // 新布局
+        std::vector<size_t> newOffsets = {0, 2, 3};
+        std::vector<int> newSizes = {3, 4, 2};
+        std::vector<unsigned int> locations = {mesh.GetAttributeLocation(0), mesh.GetAttributeLocation(1),
+                                               mesh.GetAttributeLocation(2)};
+        std::vector<VertexAttributeType> types = {VertexAttributeType::Short, VertexAttributeType::Int2_10_10_10_Rev,
+                                                  VertexAttributeType::HalfFloat};
+        size_t extraOffset = kQuantizedWords;
+        for (size_t i = 3; i < sizes.size(); ++i)
+        {
+            newOffsets.push_back(extraOffset);
+            newSizes.push_back(sizes[i]);
+            locations.push_back(mesh.GetAttributeLocation(i));
+            types.push_back(VertexAttributeType::Float);
+            extraOffset += static_cast<size_t>(sizes[i]);
+        }
+
+        const size_t srcBytes = mesh.GetVertexDataSizeBytes();
+        mesh.SetVertices(std::move(packed), dstStride);
+        mesh.SetVertexLayout(newOffsets, newSizes, locations, types);
+        mesh.SetPositionDequantization(extent, center);
+
+        Core::Logger::GetInstance().Debug("MeshQuantizer::Quantize() - " + std::to_string(vertexCount) + " vertices, " +
+                                          std::to_string(srcBytes) + " -> " +
+                                          std::to_string(mesh.GetVertexDataSizeBytes()) + " bytes");
+        return true;
+    }
+
+} // namespace Renderer
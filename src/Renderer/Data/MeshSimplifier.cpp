@@ -0,0 +1,452 @@
+#include "Renderer/Data/MeshSimplifier.hpp"
+#include "Renderer/Data/MeshOptimizer.hpp"
+#include "Core/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace Renderer
+{
+    namespace
+    {
+        constexpr unsigned int kInvalidIndex = ~0u;
+
+        /**
+         * @brief 对称 4x4 二次型（10 个系数）+ 面积权重
+         *
+         * Q(p) = pᵀAp + 2bᵀp + c，A = Σ w·nnᵀ，b = Σ w·d·n，c = Σ w·d²
+         */
+        struct Quadric
+        {
+            double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+            double b0 = 0, b1 = 0, b2 = 0;
+            double c = 0;
+            double weight = 0;
+
+            void AddPlane(double nx, double ny, double nz, double d, double w)
+            {
+                a00 += w * nx * nx; a01 += w * nx * ny; a02 += w * nx * nz;
+                a11 += w * ny * ny; a12 += w * ny * nz; a22 += w * nz * nz;
+                b0 += w * nx * d; b1 += w * ny * d; b2 += w * nz * d;
+                c += w * d * d;
+                weight += w;
+            }
+
+            void Add(const Quadric& q)
+            {
+                a00 += q.a00; a01 += q.a01; a02 += q.a02;
+                a11 += q.a11; a12 += q.a12; a22 += q.a22;
+                b0 += q.b0; b1 += q.b1; b2 += q.b2;
+                c += q.c;
+                weight += q.weight;
+            }
+
+            double Evaluate(const float* p) const
+            {
+                const double x = p[0], y = p[1], z = p[2];
+                double value = a00 * x * x + a11 * y * y + a22 * z * z +
+                               2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                               2.0 * (b0 * x + b1 * y + b2 * z) + c;
+                return value > 0.0 ? value : 0.0;
+            }
+        };
+
+        /**
+         * @brief 顶点 → 相邻三角形列表（CSR 格式）
+         */
+        struct TriangleAdjacency
+        {
+            std::vector<unsigned int> offsets;    // vertexCount + 1
+            std::vector<unsigned int> triangles;
+
+            void Build(const std::vector<unsigned int>& indices, size_t vertexCount)
+            {
+                offsets.assign(vertexCount + 1, 0);
+                for (unsigned int v : indices)
+                {
+                    ++offsets[v + 1];
+                }
+                for (size_t v = 0; v < vertexCount; ++v)
+                {
+                    offsets[v + 1] += offsets[v];
+                }
+
+                triangles.resize(indices.size());
+                std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+                for (size_t i = 0; i < indices.size(); ++i)
+                {
+                    triangles[cursor[indices[i]]++] = static_cast<unsigned int>(i / 3);
+                }
+            }
+        };
+
+        struct Collapse
+        {
+            unsigned int from;
+            unsigned int to;
+            float cost;
+        };
+
+        void Cross(const float* a, const float* b, const float* c, float* out)
+        {
+            const float e0[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+            const float e1[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+            out[0] = e0[1] * e1[2] - e0[2] * e1[1];
+            out[1] = e0[2] * e1[0] - e0[0] * e1[2];
+            out[2] = e0[0] * e1[1] - e0[1] * e1[0];
+        }
+
+        /**
+         * @brief 锁定边界边的端点
+         *
+         * 半边 a→b 在流形内部时必有唯一的反向半边 b→a；找不到（开口、顶点拆分的接缝）
+         * 或出现多次（非流形）的边都视为边界。
+         */
+        std::vector<uint8_t> FindLockedVertices(const std::vector<unsigned int>& indices, size_t vertexCount)
+        {
+            std::vector<unsigned int> offsets(vertexCount + 1, 0);
+            for (unsigned int v : indices)
+            {
+                ++offsets[v + 1];
+            }
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                offsets[v + 1] += offsets[v];
+            }
+            std::vector<unsigned int> targets(indices.size());
+            std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+            for (size_t t = 0; t < indices.size(); t += 3)
+            {
+                for (int e = 0; e < 3; ++e)
+                {
+                    unsigned int a = indices[t + e];
+                    unsigned int b = indices[t + (e + 1) % 3];
+                    targets[cursor[a]++] = b;
+                }
+            }
+
+            auto countHalfEdges = [&](unsigned int a, unsigned int b) {
+                unsigned int count = 0;
+                for (unsigned int i = offsets[a]; i < offsets[a + 1]; ++i)
+                {
+                    count += targets[i] == b ? 1u : 0u;
+                }
+                return count;
+            };
+
+            std::vector<uint8_t> locked(vertexCount, 0);
+            for (size_t a = 0; a < vertexCount; ++a)
+            {
+                for (unsigned int i = offsets[a]; i < offsets[a + 1]; ++i)
+                {
+                    unsigned int b = targets[i];
+                    if (countHalfEdges(static_cast<unsigned int>(a), b) != 1 ||
+                        countHalfEdges(b, static_cast<unsigned int>(a)) != 1)
+                    {
+                        locked[a] = 1;
+                        locked[b] = 1;
+                    }
+                }
+            }
+            return locked;
+        }
+    } // namespace
+
+    std::vector<unsigned int> MeshSimplifier::Simplify(const float* vertices, size_t vertexCount, size_t stride,
+                                                       size_t positionOffset, const unsigned int* indices,
+                                                       size_t indexCount, size_t targetIndexCount, float targetError,
+                                                       float* resultError)
+    {
+        std::vector<unsigned int> result(indices, indices + indexCount);
+        if (resultError)
+        {
+            *resultError = 0.0f;
+        }
+        if (indexCount % 3 != 0 || targetIndexCount >= indexCount || vertexCount == 0)
+        {
+            return result;
+        }
+
+        // 位置归一化到包围盒最大边长 = 1，误差因此与网格尺寸无关
+        float boundsMin[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                              std::numeric_limits<float>::max()};
+        float boundsMax[3] = {-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(),
+                              -std::numeric_limits<float>::max()};
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            const float* p = vertices + v * stride + positionOffset;
+            for (int c = 0; c < 3; ++c)
+            {
+                boundsMin[c] = std::min(boundsMin[c], p[c]);
+                boundsMax[c] = std::max(boundsMax[c], p[c]);
+            }
+        }
+        const float extent = std::max({boundsMax[0] - boundsMin[0], boundsMax[1] - boundsMin[1],
+                                       boundsMax[2] - boundsMin[2]});
+        if (!(extent > 0.0f))
+        {
+            return result;
+        }
+
+        std::vector<float> positions(vertexCount * 3);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            const float* p = vertices + v * stride + positionOffset;
+            for (int c = 0; c < 3; ++c)
+            {
+                positions[v * 3 + c] = (p[c] - boundsMin[c]) / extent;
+            }
+        }
+
+        // 每个顶点累积相邻三角形所在平面的二次型（按面积加权）
+        std::vector<Quadric> quadrics(vertexCount);
+        for (size_t t = 0; t < indexCount; t += 3)
+        {
+            const float* p0 = &positions[result[t] * 3];
+            const float* p1 = &positions[result[t + 1] * 3];
+            const float* p2 = &positions[result[t + 2] * 3];
+            float n[3];
+            Cross(p0, p1, p2, n);
+            double length = std::sqrt(double(n[0]) * n[0] + double(n[1]) * n[1] + double(n[2]) * n[2]);
+            if (length <= 0.0)
+            {
+                continue;
+            }
+            double nx = n[0] / length, ny = n[1] / length, nz = n[2] / length;
+            double d = -(nx * p0[0] + ny * p0[1] + nz * p0[2]);
+            double area = length * 0.5;
+            for (int k = 0; k < 3; ++k)
+            {
+                quadrics[result[t + k]].AddPlane(nx, ny, nz, d, area);
+            }
+        }
+
+        const std::vector<uint8_t> locked = FindLockedVertices(result, vertexCount);
+        const double maxCost = double(targetError) * double(targetError);
+        double worstCost = 0.0;
+
+        TriangleAdjacency adjacency;
+        std::vector<Collapse> collapses;
+        std::vector<unsigned int> remap(vertexCount);
+        std::vector<uint8_t> touched(vertexCount);
+
+        while (result.size() > targetIndexCount)
+        {
+            adjacency.Build(result, vertexCount);
+
+            // 1. 每条内部边（a < b 的半边恰好覆盖一次）取代价较低的折叠方向
+            collapses.clear();
+            for (size_t t = 0; t < result.size(); t += 3)
+            {
+                for (int e = 0; e < 3; ++e)
+                {
+                    unsigned int a = result[t + e];
+                    unsigned int b = result[t + (e + 1) % 3];
+                    if (a >= b || (locked[a] && locked[b]))
+                    {
+                        continue;
+                    }
+
+                    Quadric q = quadrics[a];
+                    q.Add(quadrics[b]);
+                    const double invWeight = q.weight > 0.0 ? 1.0 / q.weight : 0.0;
+                    double costAB = locked[a] ? std::numeric_limits<double>::max() : q.Evaluate(&positions[b * 3]) * invWeight;
+                    double costBA = locked[b] ? std::numeric_limits<double>::max() : q.Evaluate(&positions[a * 3]) * invWeight;
+                    if (costAB <= costBA)
+                    {
+                        collapses.push_back(Collapse{a, b, static_cast<float>(costAB)});
+                    }
+                    else
+                    {
+                        collapses.push_back(Collapse{b, a, static_cast<float>(costBA)});
+                    }
+                }
+            }
+            if (collapses.empty())
+            {
+                break;
+            }
+            std::sort(collapses.begin(), collapses.end(),
+                      [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+            // 2. 按代价从低到高执行互不相邻的折叠（本轮被触及的顶点不再参与）
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                remap[v] = static_cast<unsigned int>(v);
+            }
+            std::fill(touched.begin(), touched.end(), 0);
+
+            const size_t trianglesToRemove = (result.size() - targetIndexCount + 2) / 3;
+            size_t removed = 0;
+            size_t performed = 0;
+            for (const Collapse& collapse : collapses)
+            {
+                if (collapse.cost > maxCost || removed >= trianglesToRemove)
+                {
+                    break;
+                }
+                const unsigned int u = collapse.from;
+                const unsigned int v = collapse.to;
+                if (touched[u] || touched[v])
+                {
+                    continue;
+                }
+
+                // 法线翻转检查：u 的相邻三角形（不含 v）在 u 移到 v 后法线旋转不能超过约 75°
+                // （只拒绝真正反向的折叠时，多轮累积仍可能把三角形翻到背面）
+                bool flips = false;
+                size_t collapsedTriangles = 0;
+                for (unsigned int i = adjacency.offsets[u]; i < adjacency.offsets[u + 1] && !flips; ++i)
+                {
+                    const unsigned int* tri = &result[adjacency.triangles[i] * 3];
+                    unsigned int r[3] = {remap[tri[0]], remap[tri[1]], remap[tri[2]]};
+                    if (r[0] == v || r[1] == v || r[2] == v)
+                    {
+                        ++collapsedTriangles;
+                        continue;
+                    }
+
+                    float before[3], after[3];
+                    Cross(&positions[r[0] * 3], &positions[r[1] * 3], &positions[r[2] * 3], before);
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        r[k] = r[k] == u ? v : r[k];
+                    }
+                    Cross(&positions[r[0] * 3], &positions[r[1] * 3], &positions[r[2] * 3], after);
+                    float dot = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+                    float lengths = std::sqrt((before[0] * before[0] + before[1] * before[1] + before[2] * before[2]) *
+                                              (after[0] * after[0] + after[1] * after[1] + after[2] * after[2]));
+                    flips = dot <= 0.25f * lengths;
+                }
+                if (flips)
+                {
+                    continue;
+                }
+
+                remap[u] = v;
+                touched[u] = 1;
+                touched[v] = 1;
+                quadrics[v].Add(quadrics[u]);
+                removed += collapsedTriangles;
+                worstCost = std::max(worstCost, static_cast<double>(collapse.cost));
+                ++performed;
+            }
+            if (performed == 0)
+            {
+                break;
+            }
+
+            // 3. 改写索引并移除退化三角形
+            size_t write = 0;
+            for (size_t t = 0; t < result.size(); t += 3)
+            {
+                unsigned int a = remap[result[t]];
+                unsigned int b = remap[result[t + 1]];
+                unsigned int c = remap[result[t + 2]];
+                if (a != b && b != c && a != c)
+                {
+                    result[write++] = a;
+                    result[write++] = b;
+                    result[write++] = c;
+                }
+            }
+            result.resize(write);
+        }
+
+        if (resultError)
+        {
+            *resultError = static_cast<float>(std::sqrt(worstCost));
+        }
+        return result;
+    }
+
+    std::vector<MeshData> MeshSimplifier::BuildLODChain(MeshData mesh, const MeshLODConfig& config)
+    {
+        std::vector<MeshData> levels;
+        const auto& sizes = mesh.GetAttributeSizes();
+        const auto& offsets = mesh.GetAttributeOffsets();
+        if (!mesh.HasIndices() || mesh.IsEmpty() || mesh.IsPositionQuantized() || sizes.empty() || sizes[0] < 3)
+        {
+            levels.push_back(std::move(mesh));
+            return levels;
+        }
+
+        const size_t stride = mesh.GetVertexStride();
+        const size_t positionOffset = offsets[0];
+        const float* vertices = mesh.GetVertexData();
+        const size_t vertexCount = mesh.GetVertexCount();
+
+        // 每级从上一级的索引继续简化（顶点数据始终是 LOD0 的）
+        std::vector<std::vector<unsigned int>> levelIndices;
+        std::vector<float> levelErrors;
+        std::vector<unsigned int> previous(mesh.GetIndexData(), mesh.GetIndexData() + mesh.GetIndexCount());
+        for (size_t level = 1; level < config.levelCount; ++level)
+        {
+            size_t target = static_cast<size_t>(static_cast<double>(previous.size() / 3) * config.reductionPerLevel) * 3;
+            float error = 0.0f;
+            std::vector<unsigned int> simplified = Simplify(vertices, vertexCount, stride, positionOffset,
+                                                            previous.data(), previous.size(), target,
+                                                            config.maxError, &error);
+            if (simplified.empty() ||
+                static_cast<double>(simplified.size()) > static_cast<double>(previous.size()) * config.minReduction)
+            {
+                break;
+            }
+            previous = simplified;
+            levelIndices.push_back(std::move(simplified));
+            levelErrors.push_back(error);
+        }
+
+        std::vector<unsigned int> remap;
+        for (size_t i = 0; i < levelIndices.size(); ++i)
+        {
+            // 只保留被引用的顶点，再做顶点缓存 / 过度绘制 / 顶点获取优化
+            std::vector<unsigned int>& indices = levelIndices[i];
+            remap.assign(vertexCount, kInvalidIndex);
+            std::vector<float> levelVertices;
+            levelVertices.reserve(indices.size() / 2 * stride);
+            unsigned int next = 0;
+            for (unsigned int& index : indices)
+            {
+                if (remap[index] == kInvalidIndex)
+                {
+                    remap[index] = next++;
+                    levelVertices.insert(levelVertices.end(), vertices + index * stride,
+                                         vertices + (index + 1) * stride);
+                }
+                index = remap[index];
+            }
+
+            MeshOptimizerConfig optimizerConfig;
+            optimizerConfig.positionOffset = positionOffset;
+            MeshOptimizer::Optimize(levelVertices, stride, indices, optimizerConfig);
+
+            MeshData data;
+            data.SetVertices(std::move(levelVertices), stride);
+            data.SetIndices(std::move(indices));
+            std::vector<unsigned int> locations;
+            std::vector<VertexAttributeType> types;
+            for (size_t a = 0; a < sizes.size(); ++a)
+            {
+                locations.push_back(mesh.GetAttributeLocation(a));
+                types.push_back(mesh.GetAttributeType(a));
+            }
+            data.SetVertexLayout(offsets, sizes, locations, types);
+            data.SetMaterialColor(mesh.GetMaterialColor());
+            data.SetTexturePath(mesh.GetTexturePath());
+            data.SetTextureArrayIndex(mesh.GetTextureArrayIndex());
+
+            char message[160];
+            std::snprintf(message, sizeof(message), "MeshSimplifier::BuildLODChain() - LOD%zu: %zu triangles, %zu vertices, error %.4f",
+                          i + 1, data.GetIndexCount() / 3, data.GetVertexCount(), levelErrors[i]);
+            Core::Logger::GetInstance().Debug(message);
+
+            levels.push_back(std::move(data));
+        }
+
+        levels.insert(levels.begin(), std::move(mesh));
+        return levels;
+    }
+
+} // namespace Renderer
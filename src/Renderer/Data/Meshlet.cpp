@@ -0,0 +1,160 @@
+#include "Renderer/Data/Meshlet.hpp"
+#include "Renderer/Data/MeshData.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Renderer
+{
+    namespace
+    {
+        void ComputeBounds(Meshlet& meshlet, const float* vertices, size_t stride, const unsigned int* indices)
+        {
+            auto position = [&](unsigned int index) {
+                const float* p = vertices + static_cast<size_t>(index) * stride;
+                return glm::vec3(p[0], p[1], p[2]);
+            };
+
+            // 包围球：AABB 中心 + 最远顶点距离
+            glm::vec3 boundsMin(std::numeric_limits<float>::max());
+            glm::vec3 boundsMax(-std::numeric_limits<float>::max());
+            const unsigned int* begin = indices + meshlet.firstIndex;
+            const unsigned int* end = begin + meshlet.triangleCount * 3;
+            for (const unsigned int* it = begin; it != end; ++it)
+            {
+                glm::vec3 p = position(*it);
+                boundsMin = glm::min(boundsMin, p);
+                boundsMax = glm::max(boundsMax, p);
+            }
+            meshlet.center = (boundsMin + boundsMax) * 0.5f;
+            float radiusSq = 0.0f;
+            for (const unsigned int* it = begin; it != end; ++it)
+            {
+                glm::vec3 d = position(*it) - meshlet.center;
+                radiusSq = std::max(radiusSq, glm::dot(d, d));
+            }
+            meshlet.radius = std::sqrt(radiusSq);
+
+            // 法线锥：轴为面积加权平均法线，张角由最偏离轴的三角形决定
+            std::vector<glm::vec3> normals;
+            normals.reserve(meshlet.triangleCount);
+            glm::vec3 axis(0.0f);
+            for (const unsigned int* it = begin; it != end; it += 3)
+            {
+                glm::vec3 p0 = position(it[0]);
+                glm::vec3 n = glm::cross(position(it[1]) - p0, position(it[2]) - p0);
+                float length = glm::length(n);
+                if (length > 0.0f)
+                {
+                    axis += n;
+                    normals.push_back(n / length);
+                }
+            }
+            float axisLength = glm::length(axis);
+            if (normals.empty() || axisLength <= 0.0f)
+            {
+                return; // 退化簇：保持 coneCutoff = 1
+            }
+            axis /= axisLength;
+
+            float minDot = 1.0f;
+            for (const glm::vec3& n : normals)
+            {
+                minDot = std::min(minDot, glm::dot(axis, n));
+            }
+
+            // 张角接近 90° 时锥体检测几乎不会成功，直接关闭
+            if (minDot <= 0.1f)
+            {
+                return;
+            }
+
+            // 锥顶沿轴后退，使其位于所有三角形平面的背面（透视投影下检测保守）
+            float maxT = 0.0f;
+            size_t normalIndex = 0;
+            for (const unsigned int* it = begin; it != end; it += 3)
+            {
+                glm::vec3 p0 = position(it[0]);
+                glm::vec3 n = glm::cross(position(it[1]) - p0, position(it[2]) - p0);
+                if (glm::length(n) <= 0.0f)
+                {
+                    continue;
+                }
+                const glm::vec3& unitNormal = normals[normalIndex++];
+                float t = glm::dot(meshlet.center - p0, unitNormal) / glm::dot(axis, unitNormal);
+                maxT = std::max(maxT, t);
+            }
+
+            meshlet.coneAxis = axis;
+            meshlet.coneApex = meshlet.center - axis * maxT;
+            meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+        }
+    } // namespace
+
+    std::vector<Meshlet> MeshletBuilder::Build(const MeshData& mesh, size_t maxVertices, size_t maxTriangles)
+    {
+        std::vector<Meshlet> meshlets;
+        const auto& offsets = mesh.GetAttributeOffsets();
+        if (!mesh.HasIndices() || mesh.IsEmpty() || mesh.IsPositionQuantized() || offsets.empty() ||
+            mesh.GetIndexCount() % 3 != 0 || maxVertices < 3 || maxTriangles < 1)
+        {
+            return meshlets;
+        }
+
+        const float* vertices = mesh.GetVertexData() + offsets[0];
+        const size_t stride = mesh.GetVertexStride();
+        const unsigned int* indices = mesh.GetIndexData();
+        const size_t indexCount = mesh.GetIndexCount();
+
+        // 顶点所属的簇编号（用于统计簇内不同顶点数，无需每簇清空）
+        std::vector<uint32_t> owner(mesh.GetVertexCount(), std::numeric_limits<uint32_t>::max());
+
+        meshlets.reserve(indexCount / 3 / maxTriangles + 1);
+        Meshlet current;
+        uint32_t currentId = 0;
+        for (size_t t = 0; t < indexCount; t += 3)
+        {
+            size_t newVertices = 0;
+            for (int k = 0; k < 3; ++k)
+            {
+                unsigned int v = indices[t + k];
+                bool repeated = (k > 0 && indices[t] == v) || (k > 1 && indices[t + 1] == v);
+                newVertices += (owner[v] != currentId && !repeated) ? 1 : 0;
+            }
+
+            if (current.triangleCount > 0 &&
+                (current.vertexCount + newVertices > maxVertices || current.triangleCount + 1 > maxTriangles))
+            {
+                meshlets.push_back(current);
+                current = Meshlet();
+                current.firstIndex = static_cast<uint32_t>(t);
+                ++currentId;
+                newVertices = 0;
+                for (int k = 0; k < 3; ++k)
+                {
+                    unsigned int v = indices[t + k];
+                    bool repeated = (k > 0 && indices[t] == v) || (k > 1 && indices[t + 1] == v);
+                    newVertices += repeated ? 0 : 1;
+                }
+            }
+
+            for (int k = 0; k < 3; ++k)
+            {
+                owner[indices[t + k]] = currentId;
+            }
+            current.vertexCount += static_cast<uint32_t>(newVertices);
+            ++current.triangleCount;
+        }
+        if (current.triangleCount > 0)
+        {
+            meshlets.push_back(current);
+        }
+
+        for (Meshlet& meshlet : meshlets)
+        {
+            ComputeBounds(meshlet, vertices, stride, indices);
+        }
+        return meshlets;
+    }
+
+} // namespace Renderer
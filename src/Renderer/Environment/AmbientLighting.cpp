@@ -1,6 +1,13 @@
 #include "Renderer/Environment/AmbientLighting.hpp"
+#include "Renderer/Environment/Skybox.hpp"
+#include "Renderer/Renderer/FrameStatistics.hpp"
+#include "Renderer/Resources/UniformBindings.hpp"
 #include "Core/Logger.hpp"
 #include <glad/glad.h>
+#include <chrono>
+#include <filesystem>
+
+namespace fs = std::filesystem;
 
 namespace Renderer
 {
@@ -12,12 +19,15 @@ namespace Renderer
         , m_mode(Mode::SOLID_COLOR)
         , m_skyColor(0.5f, 0.7f, 1.0f)    // 默认蓝天
         , m_groundColor(0.1f, 0.1f, 0.1f) // 默认深灰地面
+        , m_irradiance{}
+        , m_shUBO(0)
     {
     }
 
     AmbientLighting::~AmbientLighting()
     {
         // 不删除纹理，由Skybox类管理
+        ReleaseIrradiance();
     }
 
     AmbientLighting::AmbientLighting(AmbientLighting&& other) noexcept
@@ -27,8 +37,11 @@ namespace Renderer
         , m_mode(other.m_mode)
         , m_skyColor(other.m_skyColor)
         , m_groundColor(other.m_groundColor)
+        , m_irradiance(other.m_irradiance)
+        , m_shUBO(other.m_shUBO)
     {
         other.m_skyboxTextureID = 0;
+        other.m_shUBO = 0;
     }
 
     AmbientLighting& AmbientLighting::operator=(AmbientLighting&& other) noexcept
@@ -41,8 +54,12 @@ namespace Renderer
             m_mode = other.m_mode;
             m_skyColor = other.m_skyColor;
             m_groundColor = other.m_groundColor;
+            ReleaseIrradiance();
+            m_irradiance = other.m_irradiance;
+            m_shUBO = other.m_shUBO;
 
             other.m_skyboxTextureID = 0;
+            other.m_shUBO = 0;
         }
         return *this;
     }
@@ -65,11 +82,89 @@ namespace Renderer
         m_intensity = intensity;
         m_mode = Mode::SKYBOX_SAMPLE;
 
+        ComputeIrradiance("", 0);
+
+        Core::Logger::GetInstance().Info("Ambient lighting loaded from skybox, intensity: " +
+                                         std::to_string(intensity));
+        return true;
+    }
+
+    bool AmbientLighting::LoadFromSkybox(const Skybox& skybox, float intensity)
+    {
+        if (!skybox.IsLoaded())
+        {
+            Core::Logger::GetInstance().Error("Skybox not loaded, cannot create ambient lighting");
+            return false;
+        }
+
+        m_skyboxTextureID = skybox.GetTextureID();
+        m_intensity = intensity;
+        m_mode = Mode::SKYBOX_SAMPLE;
+
+        std::string cachePath;
+        if (!skybox.GetSourceFiles().empty())
+        {
+            fs::path first(skybox.GetSourceFiles()[0]);
+            cachePath = (first.parent_path() / (first.stem().string() + ".sh9")).string();
+        }
+        ComputeIrradiance(cachePath, skybox.GetSourceKey());
+
         Core::Logger::GetInstance().Info("Ambient lighting loaded from skybox, intensity: " +
                                          std::to_string(intensity));
         return true;
     }
 
+    bool AmbientLighting::ComputeIrradiance(const std::string& cachePath, uint64_t cacheKey)
+    {
+        SH9Color radiance;
+        if (!cachePath.empty() && SphericalHarmonics::ReadCache(cachePath, cacheKey, radiance))
+        {
+            Core::Logger::GetInstance().Info("Ambient SH loaded from cache: " + cachePath);
+        }
+        else
+        {
+            auto start = std::chrono::steady_clock::now();
+            if (!SphericalHarmonics::ProjectCubemapTexture(m_skyboxTextureID, radiance))
+            {
+                Core::Logger::GetInstance().Warning("Failed to project skybox to spherical harmonics, SH ambient disabled");
+                ReleaseIrradiance();
+                return false;
+            }
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+            Core::Logger::GetInstance().Info("Ambient SH projected from skybox in " + std::to_string(elapsed.count()) + " ms");
+
+            if (!cachePath.empty() && !SphericalHarmonics::WriteCache(cachePath, cacheKey, radiance))
+            {
+                Core::Logger::GetInstance().Warning("Failed to write ambient SH cache: " + cachePath);
+            }
+        }
+
+        m_irradiance = SphericalHarmonics::ToIrradiance(radiance);
+        UploadIrradiance();
+        return true;
+    }
+
+    void AmbientLighting::UploadIrradiance()
+    {
+        if (m_shUBO == 0)
+        {
+            glGenBuffers(1, &m_shUBO);
+        }
+        glBindBuffer(GL_UNIFORM_BUFFER, m_shUBO);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(GPUSHIrradiance), &m_irradiance, GL_STATIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        RENDER_STATS_ADD(BufferBytesUploaded, sizeof(GPUSHIrradiance));
+    }
+
+    void AmbientLighting::ReleaseIrradiance()
+    {
+        if (m_shUBO != 0)
+        {
+            glDeleteBuffers(1, &m_shUBO);
+            m_shUBO = 0;
+        }
+    }
+
     void AmbientLighting::BindTexture(unsigned int textureUnit) const
     {
         if (m_skyboxTextureID != 0)
@@ -111,6 +206,15 @@ namespace Renderer
                 shader.SetVec3("skyColor", m_skyColor);
                 shader.SetVec3("groundColor", m_groundColor);
                 break;
+
+            case Mode::SPHERICAL_HARMONICS:
+                // 系数常驻 UBO，只需绑定
+                if (m_shUBO != 0)
+                {
+                    glBindBufferBase(GL_UNIFORM_BUFFER, static_cast<GLuint>(UniformBinding::AMBIENT_SH), m_shUBO);
+                    RENDER_STATS_ADD(BufferBinds, 1);
+                }
+                break;
         }
     }
 
@@ -0,0 +1,988 @@
+#include "Renderer/Environment/EnvironmentPrefilter.hpp"
+#include "Renderer/Environment/Skybox.hpp"
+#include "Renderer/Resources/Texture.hpp"
+#include "Core/Logger.hpp"
+#include "Core/ThreadPool.hpp"
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+
+namespace fs = std::filesystem;
+
+namespace Renderer
+{
+
+    namespace
+    {
+        constexpr float kPi = 3.14159265358979f;
+        constexpr uint32_t kCacheVersion = 1; // 算法变化时递增，使旧缓存失效
+
+        // ========================================
+        // 半精度浮点转换（IEEE 754 binary16，舍入到最近）
+        // ========================================
+
+        uint16_t FloatToHalf(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+
+            uint32_t sign = (bits >> 16) & 0x8000u;
+            int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFFu) - 127 + 15;
+            uint32_t mantissa = bits & 0x7FFFFFu;
+
+            if (exponent >= 31)
+            {
+                return static_cast<uint16_t>(sign | 0x7C00u); // 溢出 → 无穷大（预计算数据不含 NaN）
+            }
+            if (exponent <= 0)
+            {
+                if (exponent < -10)
+                {
+                    return static_cast<uint16_t>(sign);
+                }
+                mantissa |= 0x800000u;
+                uint32_t shift = static_cast<uint32_t>(14 - exponent);
+                uint32_t half = mantissa >> shift;
+                if ((mantissa >> (shift - 1)) & 1u)
+                {
+                    ++half;
+                }
+                return static_cast<uint16_t>(sign | half);
+            }
+
+            uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+            if (mantissa & 0x1000u)
+            {
+                ++half; // 进位可能溢出到指数，结果仍正确
+            }
+            return static_cast<uint16_t>(half);
+        }
+
+        // ========================================
+        // 采样工具（与 env_prefilter.frag / brdf_lut.frag 一致）
+        // ========================================
+
+        glm::vec2 Hammersley(uint32_t i, uint32_t count)
+        {
+            uint32_t bits = i;
+            bits = (bits << 16u) | (bits >> 16u);
+            bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+            bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+            bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+            bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+            return glm::vec2(static_cast<float>(i) / static_cast<float>(count),
+                             static_cast<float>(bits) * 2.3283064365386963e-10f);
+        }
+
+        // 切线空间（N = +Z）中的 GGX 半程向量
+        glm::vec3 ImportanceSampleGGX(const glm::vec2& xi, float roughness)
+        {
+            float a = roughness * roughness;
+            float phi = 2.0f * kPi * xi.x;
+            float cosTheta = std::sqrt((1.0f - xi.y) / (1.0f + (a * a - 1.0f) * xi.y));
+            float sinTheta = std::sqrt(std::max(0.0f, 1.0f - cosTheta * cosTheta));
+            return glm::vec3(std::cos(phi) * sinTheta, std::sin(phi) * sinTheta, cosTheta);
+        }
+
+        float DistributionGGX(float NdotH, float roughness)
+        {
+            float a = roughness * roughness;
+            float a2 = a * a;
+            float d = NdotH * NdotH * (a2 - 1.0f) + 1.0f;
+            return a2 / (kPi * d * d);
+        }
+
+        float GeometrySchlickGGX(float NdotX, float roughness)
+        {
+            float k = roughness * roughness / 2.0f; // IBL 使用的 k
+            return NdotX / (NdotX * (1.0f - k) + k);
+        }
+
+        // 面坐标 → 方向（OpenGL 立方体贴图约定，行 0 对应 tc = -1）
+        glm::vec3 FaceDirection(int face, float sc, float tc)
+        {
+            switch (face)
+            {
+            case 0: return glm::vec3(1.0f, -tc, -sc);
+            case 1: return glm::vec3(-1.0f, -tc, sc);
+            case 2: return glm::vec3(sc, 1.0f, tc);
+            case 3: return glm::vec3(sc, -1.0f, -tc);
+            case 4: return glm::vec3(sc, -tc, 1.0f);
+            default: return glm::vec3(-sc, -tc, -1.0f);
+            }
+        }
+
+        /**
+         * 带 mip 链的 RGBA8 立方体贴图（CPU 采样用）
+         */
+        struct CubemapMips
+        {
+            uint32_t size = 0;
+            std::vector<std::vector<std::vector<uint8_t>>> faces; // faces[face][mip]
+
+            uint32_t GetMipCount() const { return static_cast<uint32_t>(faces[0].size()); }
+
+            // 方向 → 面坐标，面内双线性（不跨面过滤）
+            glm::vec3 Sample(const glm::vec3& dir, float lod) const
+            {
+                float ax = std::fabs(dir.x), ay = std::fabs(dir.y), az = std::fabs(dir.z);
+                int face;
+                float sc, tc, ma;
+                if (ax >= ay && ax >= az)
+                {
+                    ma = ax;
+                    face = dir.x > 0.0f ? 0 : 1;
+                    sc = dir.x > 0.0f ? -dir.z : dir.z;
+                    tc = -dir.y;
+                }
+                else if (ay >= az)
+                {
+                    ma = ay;
+                    face = dir.y > 0.0f ? 2 : 3;
+                    sc = dir.x;
+                    tc = dir.y > 0.0f ? dir.z : -dir.z;
+                }
+                else
+                {
+                    ma = az;
+                    face = dir.z > 0.0f ? 4 : 5;
+                    sc = dir.z > 0.0f ? dir.x : -dir.x;
+                    tc = -dir.y;
+                }
+
+                uint32_t mip = std::min(GetMipCount() - 1, static_cast<uint32_t>(std::max(0.0f, lod + 0.5f)));
+                uint32_t mipSize = std::max(1u, size >> mip);
+                const uint8_t* pixels = faces[face][mip].data();
+
+                float u = (sc / ma * 0.5f + 0.5f) * mipSize - 0.5f;
+                float v = (tc / ma * 0.5f + 0.5f) * mipSize - 0.5f;
+                float maxCoord = static_cast<float>(mipSize - 1);
+                u = std::min(std::max(u, 0.0f), maxCoord);
+                v = std::min(std::max(v, 0.0f), maxCoord);
+                uint32_t x0 = static_cast<uint32_t>(u), y0 = static_cast<uint32_t>(v);
+                uint32_t x1 = std::min(x0 + 1, mipSize - 1), y1 = std::min(y0 + 1, mipSize - 1);
+                float fx = u - x0, fy = v - y0;
+
+                auto texel = [&](uint32_t x, uint32_t y) {
+                    const uint8_t* p = pixels + (static_cast<size_t>(y) * mipSize + x) * 4;
+                    return glm::vec3(p[0], p[1], p[2]);
+                };
+                glm::vec3 top = texel(x0, y0) * (1.0f - fx) + texel(x1, y0) * fx;
+                glm::vec3 bottom = texel(x0, y1) * (1.0f - fx) + texel(x1, y1) * fx;
+                return (top * (1.0f - fy) + bottom * fy) * (1.0f / 255.0f);
+            }
+        };
+
+        /**
+         * 预计算的采样方向（切线空间），对所有 texel 共用
+         */
+        struct PrefilterSample
+        {
+            glm::vec3 direction;
+            float weight;  // N·L
+            float lod;     // 源贴图 mip（按 PDF 选择，减少少量采样下的噪点）
+        };
+
+        std::vector<PrefilterSample> BuildPrefilterSamples(float roughness, uint32_t sampleCount, uint32_t sourceSize)
+        {
+            std::vector<PrefilterSample> samples;
+            samples.reserve(sampleCount);
+            float texelSolidAngle = 4.0f * kPi / (6.0f * sourceSize * sourceSize);
+            for (uint32_t i = 0; i < sampleCount; ++i)
+            {
+                glm::vec3 h = ImportanceSampleGGX(Hammersley(i, sampleCount), roughness);
+                glm::vec3 l = h * (2.0f * h.z) - glm::vec3(0.0f, 0.0f, 1.0f); // V = N
+                if (l.z <= 0.0f)
+                {
+                    continue;
+                }
+
+                // N = V 时 pdf = D / 4
+                float pdf = DistributionGGX(h.z, roughness) * 0.25f;
+                float sampleSolidAngle = 1.0f / (static_cast<float>(sampleCount) * pdf + 1e-4f);
+                float lod = std::max(0.0f, 0.5f * std::log2(sampleSolidAngle / texelSolidAngle) + 1.0f);
+                samples.push_back({l, l.z, lod});
+            }
+            return samples;
+        }
+
+        uint64_t MixKey(uint64_t hash, uint64_t value)
+        {
+            // FNV-1a（按字节）
+            for (int i = 0; i < 8; ++i)
+            {
+                hash ^= (value >> (i * 8)) & 0xFFu;
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        bool ReadCache(const std::string& path, uint64_t key, BlockFormat format, uint32_t faceCount,
+                       CompressedImage& outImage)
+        {
+            std::error_code ec;
+            if (path.empty() || !fs::exists(path, ec))
+            {
+                return false;
+            }
+
+            std::string error;
+            if (!TextureCompression::ReadDDS(path, outImage, &error))
+            {
+                Core::Logger::GetInstance().Warning("Failed to read environment cache " + path + ": " + error);
+                return false;
+            }
+            if (outImage.userKey != key || outImage.format != format || outImage.faceCount != faceCount)
+            {
+                Core::Logger::GetInstance().Info("Environment cache is stale, rebuilding: " + path);
+                return false;
+            }
+            return true;
+        }
+
+        void WriteCacheAsync(const std::string& path, CompressedImage image)
+        {
+            auto shared = std::make_shared<CompressedImage>(std::move(image));
+            Core::ThreadPool::GetInstance().Submit([path, shared]() {
+                std::string error;
+                if (TextureCompression::WriteDDS(path, *shared, &error))
+                {
+                    Core::Logger::GetInstance().Info("Environment cache written: " + path + " (" +
+                                                    std::to_string(shared->GetTotalSizeBytes() / 1024) + " KB)");
+                }
+                else
+                {
+                    Core::Logger::GetInstance().Warning("Failed to write environment cache " + path + ": " + error);
+                }
+            });
+        }
+
+        /**
+         * 保存/恢复预计算 pass 修改的 GL 状态
+         */
+        struct ScopedPassState
+        {
+            GLint framebuffer = 0;
+            GLint viewport[4] = {};
+            GLint program = 0;
+            GLint vertexArray = 0;
+            GLboolean depthTest = GL_FALSE;
+            GLboolean blend = GL_FALSE;
+            GLboolean cullFace = GL_FALSE;
+            GLboolean seamless = GL_FALSE;
+
+            ScopedPassState()
+            {
+                glGetIntegerv(GL_FRAMEBUFFER_BINDING, &framebuffer);
+                glGetIntegerv(GL_VIEWPORT, viewport);
+                glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+                glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vertexArray);
+                depthTest = glIsEnabled(GL_DEPTH_TEST);
+                blend = glIsEnabled(GL_BLEND);
+                cullFace = glIsEnabled(GL_CULL_FACE);
+                seamless = glIsEnabled(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+                glDisable(GL_DEPTH_TEST);
+                glDisable(GL_BLEND);
+                glDisable(GL_CULL_FACE);
+                glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+            }
+
+            ~ScopedPassState()
+            {
+                glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(framebuffer));
+                glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+                glUseProgram(static_cast<GLuint>(program));
+                glBindVertexArray(static_cast<GLuint>(vertexArray));
+                if (depthTest) glEnable(GL_DEPTH_TEST);
+                if (blend) glEnable(GL_BLEND);
+                if (cullFace) glEnable(GL_CULL_FACE);
+                if (!seamless) glDisable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+            }
+        };
+
+        /**
+         * 清空之前调用残留的 GL 错误，之后的 glGetError 只反映本 pass 自己的错误
+         */
+        void DrainGLErrors(const char* pass)
+        {
+            for (GLenum error = glGetError(); error != GL_NO_ERROR; error = glGetError())
+            {
+                Core::Logger::GetInstance().Warning(std::string("Stale GL error before ") + pass + ": " +
+                                                    std::to_string(error));
+            }
+        }
+
+        bool LoadPassShader(Shader& shader, const EnvironmentPrefilterConfig& config, const char* fragmentName)
+        {
+            try
+            {
+                shader.Load(config.shaderDirectory + "env_fullscreen.vert", config.shaderDirectory + fragmentName);
+                return true;
+            }
+            catch (const std::exception& e)
+            {
+                Core::Logger::GetInstance().Warning(std::string("Environment prefilter shader unavailable, using CPU path: ") + e.what());
+                return false;
+            }
+        }
+
+    } // namespace
+
+    EnvironmentPrefilter::~EnvironmentPrefilter()
+    {
+        Release();
+    }
+
+    EnvironmentPrefilter::EnvironmentPrefilter(EnvironmentPrefilter&& other) noexcept
+        : m_prefilteredTextureID(other.m_prefilteredTextureID)
+        , m_brdfLUTTextureID(other.m_brdfLUTTextureID)
+        , m_size(other.m_size)
+        , m_lutSize(other.m_lutSize)
+        , m_mipCount(other.m_mipCount)
+    {
+        other.m_prefilteredTextureID = 0;
+        other.m_brdfLUTTextureID = 0;
+        other.m_mipCount = 0;
+    }
+
+    EnvironmentPrefilter& EnvironmentPrefilter::operator=(EnvironmentPrefilter&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Release();
+            m_prefilteredTextureID = other.m_prefilteredTextureID;
+            m_brdfLUTTextureID = other.m_brdfLUTTextureID;
+            m_size = other.m_size;
+            m_lutSize = other.m_lutSize;
+            m_mipCount = other.m_mipCount;
+
+            other.m_prefilteredTextureID = 0;
+            other.m_brdfLUTTextureID = 0;
+            other.m_mipCount = 0;
+        }
+        return *this;
+    }
+
+    bool EnvironmentPrefilter::Generate(const Skybox& skybox, const EnvironmentPrefilterConfig& config)
+    {
+        if (!skybox.IsLoaded())
+        {
+            Core::Logger::GetInstance().Error("Skybox not loaded, cannot prefilter environment");
+            return false;
+        }
+
+        std::string cacheDirectory;
+        std::string cacheName;
+        if (!skybox.GetSourceFiles().empty())
+        {
+            fs::path first(skybox.GetSourceFiles()[0]);
+            cacheDirectory = first.parent_path().string();
+            cacheName = first.stem().string();
+        }
+        return Generate(skybox.GetTextureID(), cacheDirectory, cacheName, skybox.GetSourceKey(), config);
+    }
+
+    bool EnvironmentPrefilter::Generate(unsigned int cubemapTextureID, const std::string& cacheDirectory,
+                                        const std::string& cacheName, uint64_t cacheKey,
+                                        const EnvironmentPrefilterConfig& requested)
+    {
+        if (cubemapTextureID == 0)
+        {
+            Core::Logger::GetInstance().Error("Invalid cubemap texture ID, cannot prefilter environment");
+            return false;
+        }
+
+        EnvironmentPrefilterConfig config = requested;
+        config.size = std::max(1u, config.size);
+        config.lutSize = std::max(1u, config.lutSize);
+        config.mipCount = std::min(std::max(1u, config.mipCount), TextureCompression::GetFullMipCount(config.size, config.size));
+        config.sampleCount = std::max(1u, config.sampleCount);
+        config.lutSampleCount = std::max(1u, config.lutSampleCount);
+
+        Release();
+        bool useCache = !cacheName.empty();
+
+        // ========================================
+        // 预滤波立方体贴图
+        // ========================================
+        uint64_t prefilterKey = cacheKey;
+        prefilterKey = MixKey(prefilterKey, config.size);
+        prefilterKey = MixKey(prefilterKey, config.mipCount);
+        prefilterKey = MixKey(prefilterKey, config.sampleCount);
+        prefilterKey = MixKey(prefilterKey, kCacheVersion);
+        std::string prefilterPath = useCache ? (fs::path(cacheDirectory) / (cacheName + ".prefilter.dds")).string() : "";
+
+        CompressedImage cached;
+        if (ReadCache(prefilterPath, prefilterKey, BlockFormat::RGBA16F, 6, cached) && UploadPrefiltered(cached))
+        {
+            Core::Logger::GetInstance().Info("Prefiltered environment loaded from cache: " + prefilterPath);
+        }
+        else
+        {
+            Release();
+            auto start = std::chrono::steady_clock::now();
+            bool generated = config.useGPU && GeneratePrefilteredGPU(cubemapTextureID, config);
+            if (!generated)
+            {
+                Release();
+                generated = GeneratePrefilteredCPU(cubemapTextureID, config);
+            }
+            if (!generated)
+            {
+                Core::Logger::GetInstance().Error("Failed to prefilter environment cubemap");
+                Release();
+                return false;
+            }
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+            Core::Logger::GetInstance().Info("Environment prefiltered (" + std::to_string(m_size) + "px, " +
+                                            std::to_string(m_mipCount) + " roughness levels) in " +
+                                            std::to_string(elapsed.count()) + " ms");
+
+            CompressedImage image;
+            if (useCache && ReadBackPrefiltered(image))
+            {
+                image.userKey = prefilterKey;
+                WriteCacheAsync(prefilterPath, std::move(image));
+            }
+        }
+
+        // ========================================
+        // BRDF LUT（与环境无关，同目录共用一份）
+        // ========================================
+        uint64_t lutKey = 1469598103934665603ull;
+        lutKey = MixKey(lutKey, config.lutSize);
+        lutKey = MixKey(lutKey, config.lutSampleCount);
+        lutKey = MixKey(lutKey, kCacheVersion);
+        std::string lutPath = useCache ? (fs::path(cacheDirectory) / "brdf_lut.dds").string() : "";
+
+        if (ReadCache(lutPath, lutKey, BlockFormat::RG16F, 1, cached) && UploadBRDFLUT(cached))
+        {
+            Core::Logger::GetInstance().Info("BRDF LUT loaded from cache: " + lutPath);
+        }
+        else
+        {
+            bool generated = config.useGPU && GenerateBRDFLUTGPU(config);
+            if (!generated)
+            {
+                CompressedImage lut;
+                ComputeBRDFLUTCPU(config.lutSize, config.lutSampleCount, lut);
+                generated = UploadBRDFLUT(lut);
+            }
+            if (!generated)
+            {
+                Core::Logger::GetInstance().Error("Failed to generate BRDF LUT");
+                Release();
+                return false;
+            }
+
+            CompressedImage image;
+            if (useCache && ReadBackBRDFLUT(image))
+            {
+                image.userKey = lutKey;
+                WriteCacheAsync(lutPath, std::move(image));
+            }
+        }
+
+        return true;
+    }
+
+    bool EnvironmentPrefilter::GeneratePrefilteredGPU(unsigned int cubemapTextureID, const EnvironmentPrefilterConfig& config)
+    {
+        Shader shader;
+        if (!LoadPassShader(shader, config, "env_prefilter.frag"))
+        {
+            return false;
+        }
+        DrainGLErrors("environment prefilter");
+
+        // 源贴图有 mip 且使用 mipmap 过滤时按 PDF 选择源 mip（减少噪点）
+        GLint sourceSize = 0, sourceLevel1 = 0, sourceMinFilter = GL_LINEAR;
+        glBindTexture(GL_TEXTURE_CUBE_MAP, cubemapTextureID);
+        glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, GL_TEXTURE_WIDTH, &sourceSize);
+        glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 1, GL_TEXTURE_WIDTH, &sourceLevel1);
+        glGetTexParameteriv(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, &sourceMinFilter);
+        bool sourceHasMips = sourceLevel1 > 0 && sourceMinFilter != GL_LINEAR && sourceMinFilter != GL_NEAREST;
+        float sourceMaxLod = sourceHasMips ? std::floor(std::log2(static_cast<float>(std::max(1, sourceSize)))) : 0.0f;
+
+        // 目标：RGBA16F 立方体贴图，mipCount 级
+        glGenTextures(1, &m_prefilteredTextureID);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, m_prefilteredTextureID);
+        for (uint32_t mip = 0; mip < config.mipCount; ++mip)
+        {
+            GLsizei mipSize = static_cast<GLsizei>(std::max(1u, config.size >> mip));
+            for (unsigned int face = 0; face < 6; ++face)
+            {
+                glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, static_cast<GLint>(mip), GL_RGBA16F,
+                             mipSize, mipSize, 0, GL_RGBA, GL_HALF_FLOAT, nullptr);
+            }
+        }
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(config.mipCount - 1));
+        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+        bool complete = true;
+        {
+            ScopedPassState state;
+
+            GLuint framebuffer = 0, vertexArray = 0;
+            glGenFramebuffers(1, &framebuffer);
+            glGenVertexArrays(1, &vertexArray); // 全屏三角形由 gl_VertexID 生成，核心模式仍需绑定 VAO
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+            glBindVertexArray(vertexArray);
+
+            const int sourceUnit = static_cast<int>(TextureUnit::ENVIRONMENT_PREFILTERED);
+            glActiveTexture(GL_TEXTURE0 + sourceUnit);
+            glBindTexture(GL_TEXTURE_CUBE_MAP, cubemapTextureID);
+
+            shader.Use();
+            shader.SetInt("environmentMap", sourceUnit);
+            shader.SetInt("sampleCount", static_cast<int>(config.sampleCount));
+            shader.SetFloat("sourceResolution", static_cast<float>(std::max(1, sourceSize)));
+            shader.SetFloat("sourceMaxLod", sourceMaxLod);
+
+            for (uint32_t mip = 0; mip < config.mipCount && complete; ++mip)
+            {
+                GLsizei mipSize = static_cast<GLsizei>(std::max(1u, config.size >> mip));
+                float roughness = config.mipCount > 1 ? static_cast<float>(mip) / static_cast<float>(config.mipCount - 1) : 0.0f;
+                glViewport(0, 0, mipSize, mipSize);
+                shader.SetFloat("roughness", roughness);
+
+                for (unsigned int face = 0; face < 6; ++face)
+                {
+                    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face,
+                                           m_prefilteredTextureID, static_cast<GLint>(mip));
+                    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+                    {
+                        Core::Logger::GetInstance().Warning("RGBA16F cubemap framebuffer incomplete, using CPU prefilter");
+                        complete = false;
+                        break;
+                    }
+                    shader.SetInt("face", static_cast<int>(face));
+                    glDrawArrays(GL_TRIANGLES, 0, 3);
+                }
+            }
+
+            glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+            glActiveTexture(GL_TEXTURE0);
+            glDeleteVertexArrays(1, &vertexArray);
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glDeleteFramebuffers(1, &framebuffer);
+        }
+
+        if (!complete || glGetError() != GL_NO_ERROR)
+        {
+            return false;
+        }
+
+        m_size = config.size;
+        m_mipCount = config.mipCount;
+        return true;
+    }
+
+    bool EnvironmentPrefilter::GeneratePrefilteredCPU(unsigned int cubemapTextureID, const EnvironmentPrefilterConfig& config)
+    {
+        glBindTexture(GL_TEXTURE_CUBE_MAP, cubemapTextureID);
+        GLint width = 0, height = 0;
+        glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, GL_TEXTURE_WIDTH, &width);
+        glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, GL_TEXTURE_HEIGHT, &height);
+        if (width <= 0 || width != height)
+        {
+            glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+            return false;
+        }
+
+        // 读回 level 0（压缩格式由驱动解码）
+        uint32_t size = static_cast<uint32_t>(width);
+        std::vector<std::vector<uint8_t>> faces(6, std::vector<uint8_t>(static_cast<size_t>(size) * size * 4));
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        for (unsigned int face = 0; face < 6; ++face)
+        {
+            glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGBA, GL_UNSIGNED_BYTE, faces[face].data());
+        }
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+        CompressedImage image;
+        return PrefilterCubemapCPU(faces, size, config, image) && UploadPrefiltered(image);
+    }
+
+    bool EnvironmentPrefilter::GenerateBRDFLUTGPU(const EnvironmentPrefilterConfig& config)
+    {
+        Shader shader;
+        if (!LoadPassShader(shader, config, "brdf_lut.frag"))
+        {
+            return false;
+        }
+        DrainGLErrors("BRDF LUT precompute");
+
+        GLsizei size = static_cast<GLsizei>(config.lutSize);
+        glGenTextures(1, &m_brdfLUTTextureID);
+        glBindTexture(GL_TEXTURE_2D, m_brdfLUTTextureID);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, size, size, 0, GL_RG, GL_HALF_FLOAT, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        bool complete;
+        {
+            ScopedPassState state;
+
+            GLuint framebuffer = 0, vertexArray = 0;
+            glGenFramebuffers(1, &framebuffer);
+            glGenVertexArrays(1, &vertexArray);
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+            glBindVertexArray(vertexArray);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_brdfLUTTextureID, 0);
+
+            complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+            if (complete)
+            {
+                glViewport(0, 0, size, size);
+                shader.Use();
+                shader.SetInt("sampleCount", static_cast<int>(config.lutSampleCount));
+                glDrawArrays(GL_TRIANGLES, 0, 3);
+            }
+
+            glDeleteVertexArrays(1, &vertexArray);
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glDeleteFramebuffers(1, &framebuffer);
+        }
+
+        if (!complete || glGetError() != GL_NO_ERROR)
+        {
+            glDeleteTextures(1, &m_brdfLUTTextureID);
+            m_brdfLUTTextureID = 0;
+            return false;
+        }
+
+        m_lutSize = config.lutSize;
+        return true;
+    }
+
+    bool EnvironmentPrefilter::PrefilterCubemapCPU(const std::vector<std::vector<uint8_t>>& faces, uint32_t faceSize,
+                                                   const EnvironmentPrefilterConfig& config, CompressedImage& outImage)
+    {
+        if (faces.size() != 6 || faceSize == 0 || config.size == 0)
+        {
+            return false;
+        }
+        for (const auto& face : faces)
+        {
+            if (face.size() < static_cast<size_t>(faceSize) * faceSize * 4)
+            {
+                return false;
+            }
+        }
+
+        uint32_t mipCount = std::min(std::max(1u, config.mipCount), TextureCompression::GetFullMipCount(config.size, config.size));
+        uint32_t sampleCount = std::max(1u, config.sampleCount);
+
+        CubemapMips source;
+        source.size = faceSize;
+        source.faces.resize(6);
+        Core::ThreadPool::GetInstance().ParallelFor(6, [&](size_t begin, size_t end) {
+            for (size_t face = begin; face < end; ++face)
+            {
+                source.faces[face] = TextureCompression::BuildMipChainRGBA8(faces[face], faceSize, faceSize);
+            }
+        });
+
+        outImage = CompressedImage{};
+        outImage.format = BlockFormat::RGBA16F;
+        outImage.width = config.size;
+        outImage.height = config.size;
+        outImage.faceCount = 6;
+        outImage.mipCount = mipCount;
+        outImage.flippedForGL = false; // 与 GL 立方体贴图行序相同
+        outImage.levels.resize(static_cast<size_t>(6) * mipCount);
+
+        for (uint32_t mip = 0; mip < mipCount; ++mip)
+        {
+            uint32_t mipSize = std::max(1u, config.size >> mip);
+            float roughness = mipCount > 1 ? static_cast<float>(mip) / static_cast<float>(mipCount - 1) : 0.0f;
+
+            // 粗糙度 0：直接按输出分辨率重采样源贴图
+            float baseLod = std::max(0.0f, std::log2(static_cast<float>(faceSize) / static_cast<float>(mipSize)));
+            std::vector<PrefilterSample> samples;
+            if (roughness > 0.0f)
+            {
+                samples = BuildPrefilterSamples(roughness, sampleCount, faceSize);
+            }
+
+            for (uint32_t face = 0; face < 6; ++face)
+            {
+                outImage.levels[face * mipCount + mip].resize(static_cast<size_t>(mipSize) * mipSize * 4 * sizeof(uint16_t));
+            }
+
+            // 按行并行（6 个面的行拼接为一个范围）
+            Core::ThreadPool::GetInstance().ParallelFor(static_cast<size_t>(6) * mipSize, [&](size_t begin, size_t end) {
+                for (size_t row = begin; row < end; ++row)
+                {
+                    uint32_t face = static_cast<uint32_t>(row / mipSize);
+                    uint32_t y = static_cast<uint32_t>(row % mipSize);
+                    uint16_t* out = reinterpret_cast<uint16_t*>(outImage.levels[face * mipCount + mip].data()) +
+                                    static_cast<size_t>(y) * mipSize * 4;
+                    float tc = 2.0f * (y + 0.5f) / mipSize - 1.0f;
+
+                    for (uint32_t x = 0; x < mipSize; ++x)
+                    {
+                        float sc = 2.0f * (x + 0.5f) / mipSize - 1.0f;
+                        glm::vec3 n = glm::normalize(FaceDirection(static_cast<int>(face), sc, tc));
+
+                        glm::vec3 color(0.0f);
+                        if (samples.empty())
+                        {
+                            color = source.Sample(n, baseLod);
+                        }
+                        else
+                        {
+                            glm::vec3 up = std::fabs(n.z) < 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+                            glm::vec3 tangent = glm::normalize(glm::cross(up, n));
+                            glm::vec3 bitangent = glm::cross(n, tangent);
+
+                            float totalWeight = 0.0f;
+                            for (const PrefilterSample& sample : samples)
+                            {
+                                glm::vec3 l = tangent * sample.direction.x + bitangent * sample.direction.y + n * sample.direction.z;
+                                color += source.Sample(l, sample.lod) * sample.weight;
+                                totalWeight += sample.weight;
+                            }
+                            color = totalWeight > 0.0f ? color / totalWeight : source.Sample(n, baseLod);
+                        }
+
+                        out[x * 4 + 0] = FloatToHalf(color.x);
+                        out[x * 4 + 1] = FloatToHalf(color.y);
+                        out[x * 4 + 2] = FloatToHalf(color.z);
+                        out[x * 4 + 3] = FloatToHalf(1.0f);
+                    }
+                }
+            }, 4);
+        }
+
+        return true;
+    }
+
+    void EnvironmentPrefilter::ComputeBRDFLUTCPU(uint32_t size, uint32_t sampleCount, CompressedImage& outImage)
+    {
+        size = std::max(1u, size);
+        sampleCount = std::max(1u, sampleCount);
+
+        outImage = CompressedImage{};
+        outImage.format = BlockFormat::RG16F;
+        outImage.width = size;
+        outImage.height = size;
+        outImage.faceCount = 1;
+        outImage.mipCount = 1;
+        outImage.flippedForGL = true; // 行 0 = 粗糙度 0 = 纹理坐标 v = 0
+        outImage.levels.resize(1);
+        outImage.levels[0].resize(static_cast<size_t>(size) * size * 2 * sizeof(uint16_t));
+        uint16_t* pixels = reinterpret_cast<uint16_t*>(outImage.levels[0].data());
+
+        Core::ThreadPool::GetInstance().ParallelFor(size, [&](size_t begin, size_t end) {
+            for (size_t y = begin; y < end; ++y)
+            {
+                float roughness = (y + 0.5f) / size;
+                for (uint32_t x = 0; x < size; ++x)
+                {
+                    float NdotV = (x + 0.5f) / size;
+                    glm::vec3 v(std::sqrt(1.0f - NdotV * NdotV), 0.0f, NdotV);
+
+                    float scale = 0.0f, bias = 0.0f;
+                    for (uint32_t i = 0; i < sampleCount; ++i)
+                    {
+                        glm::vec3 h = ImportanceSampleGGX(Hammersley(i, sampleCount), roughness);
+                        float VdotH = glm::dot(v, h);
+                        glm::vec3 l = h * (2.0f * VdotH) - v;
+
+                        float NdotL = l.z;
+                        float NdotH = h.z;
+                        VdotH = std::max(VdotH, 0.0f);
+                        if (NdotL > 0.0f)
+                        {
+                            float g = GeometrySchlickGGX(NdotV, roughness) * GeometrySchlickGGX(NdotL, roughness);
+                            float gVis = g * VdotH / (NdotH * NdotV);
+                            float fc = std::pow(1.0f - VdotH, 5.0f);
+                            scale += (1.0f - fc) * gVis;
+                            bias += fc * gVis;
+                        }
+                    }
+
+                    uint16_t* out = pixels + (y * size + x) * 2;
+                    out[0] = FloatToHalf(scale / sampleCount);
+                    out[1] = FloatToHalf(bias / sampleCount);
+                }
+            }
+        }, 4);
+    }
+
+    bool EnvironmentPrefilter::ReadBackPrefiltered(CompressedImage& outImage) const
+    {
+        if (m_prefilteredTextureID == 0)
+        {
+            return false;
+        }
+
+        outImage = CompressedImage{};
+        outImage.format = BlockFormat::RGBA16F;
+        outImage.width = m_size;
+        outImage.height = m_size;
+        outImage.faceCount = 6;
+        outImage.mipCount = m_mipCount;
+        outImage.flippedForGL = false;
+        outImage.levels.resize(static_cast<size_t>(6) * m_mipCount);
+
+        DrainGLErrors("prefiltered environment readback");
+        glBindTexture(GL_TEXTURE_CUBE_MAP, m_prefilteredTextureID);
+        for (uint32_t face = 0; face < 6; ++face)
+        {
+            for (uint32_t mip = 0; mip < m_mipCount; ++mip)
+            {
+                uint32_t mipSize = std::max(1u, m_size >> mip);
+                std::vector<uint8_t>& level = outImage.levels[face * m_mipCount + mip];
+                level.resize(TextureCompression::GetLevelSizeBytes(BlockFormat::RGBA16F, mipSize, mipSize));
+                glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, static_cast<GLint>(mip), GL_RGBA, GL_HALF_FLOAT, level.data());
+            }
+        }
+        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        return glGetError() == GL_NO_ERROR;
+    }
+
+    bool EnvironmentPrefilter::ReadBackBRDFLUT(CompressedImage& outImage) const
+    {
+        if (m_brdfLUTTextureID == 0)
+        {
+            return false;
+        }
+
+        outImage = CompressedImage{};
+        outImage.format = BlockFormat::RG16F;
+        outImage.width = m_lutSize;
+        outImage.height = m_lutSize;
+        outImage.faceCount = 1;
+        outImage.mipCount = 1;
+        outImage.flippedForGL = true;
+        outImage.levels.resize(1);
+        outImage.levels[0].resize(TextureCompression::GetLevelSizeBytes(BlockFormat::RG16F, m_lutSize, m_lutSize));
+
+        DrainGLErrors("BRDF LUT readback");
+        glBindTexture(GL_TEXTURE_2D, m_brdfLUTTextureID);
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RG, GL_HALF_FLOAT, outImage.levels[0].data());
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return glGetError() == GL_NO_ERROR;
+    }
+
+    bool EnvironmentPrefilter::UploadPrefiltered(const CompressedImage& image)
+    {
+        if (!image.IsValid() || image.faceCount != 6 || image.width != image.height)
+        {
+            return false;
+        }
+
+        glGenTextures(1, &m_prefilteredTextureID);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, m_prefilteredTextureID);
+        for (uint32_t face = 0; face < 6; ++face)
+        {
+            if (!Texture::UploadCompressedLevels(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, image, face))
+            {
+                Core::Logger::GetInstance().Error("OpenGL error uploading prefiltered environment face " + std::to_string(face));
+                glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+                glDeleteTextures(1, &m_prefilteredTextureID);
+                m_prefilteredTextureID = 0;
+                return false;
+            }
+        }
+
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, image.mipCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.mipCount - 1));
+        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+        m_size = image.width;
+        m_mipCount = image.mipCount;
+        return true;
+    }
+
+    bool EnvironmentPrefilter::UploadBRDFLUT(const CompressedImage& image)
+    {
+        if (!image.IsValid() || image.faceCount != 1)
+        {
+            return false;
+        }
+
+        glGenTextures(1, &m_brdfLUTTextureID);
+        glBindTexture(GL_TEXTURE_2D, m_brdfLUTTextureID);
+        if (!Texture::UploadCompressedLevels(GL_TEXTURE_2D, image, 0))
+        {
+            Core::Logger::GetInstance().Error("OpenGL error uploading BRDF LUT");
+            glBindTexture(GL_TEXTURE_2D, 0);
+            glDeleteTextures(1, &m_brdfLUTTextureID);
+            m_brdfLUTTextureID = 0;
+            return false;
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        m_lutSize = image.width;
+        return true;
+    }
+
+    void EnvironmentPrefilter::Bind(TextureUnit prefilteredUnit, TextureUnit lutUnit) const
+    {
+        glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(prefilteredUnit));
+        glBindTexture(GL_TEXTURE_CUBE_MAP, m_prefilteredTextureID);
+        glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(lutUnit));
+        glBindTexture(GL_TEXTURE_2D, m_brdfLUTTextureID);
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    void EnvironmentPrefilter::ApplyToShader(Shader& shader) const
+    {
+        if (!IsLoaded())
+        {
+            shader.SetBool("usePrefilteredEnv", false);
+            return;
+        }
+
+        Bind();
+        shader.SetBool("usePrefilteredEnv", true);
+        shader.SetInt("prefilteredEnv", static_cast<int>(TextureUnit::ENVIRONMENT_PREFILTERED));
+        shader.SetInt("brdfLUT", static_cast<int>(TextureUnit::BRDF_LUT));
+        shader.SetFloat("prefilterMaxLod", static_cast<float>(m_mipCount - 1));
+    }
+
+    void EnvironmentPrefilter::Release()
+    {
+        if (m_prefilteredTextureID != 0)
+        {
+            glDeleteTextures(1, &m_prefilteredTextureID);
+            m_prefilteredTextureID = 0;
+        }
+        if (m_brdfLUTTextureID != 0)
+        {
+            glDeleteTextures(1, &m_brdfLUTTextureID);
+            m_brdfLUTTextureID = 0;
+        }
+        m_mipCount = 0;
+    }
+
+} // namespace Renderer
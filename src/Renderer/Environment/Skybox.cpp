@@ -1,6 +1,14 @@
 #include "Renderer/Environment/Skybox.hpp"
+#include "Renderer/Resources/Texture.hpp"
+#include "Renderer/Renderer/FrameStatistics.hpp"
+#include "Core/GpuProfiler.hpp"
 #include "Core/Logger.hpp"
+#include "Core/ThreadPool.hpp"
 #include <glad/glad.h>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
 #include <vector>
 #include <cmath>
 #include <stb_image.h>
@@ -42,6 +50,8 @@ namespace Renderer
         , m_VBO(other.m_VBO)
         , m_isInitialized(other.m_isInitialized)
         , m_rotation(other.m_rotation)
+        , m_sourceFiles(std::move(other.m_sourceFiles))
+        , m_sourceKey(other.m_sourceKey)
     {
         other.m_textureID = 0;
         other.m_VAO = 0;
@@ -63,6 +73,8 @@ namespace Renderer
             m_VBO = other.m_VBO;
             m_isInitialized = other.m_isInitialized;
             m_rotation = other.m_rotation;
+            m_sourceFiles = std::move(other.m_sourceFiles);
+            m_sourceKey = other.m_sourceKey;
 
             other.m_textureID = 0;
             other.m_VAO = 0;
@@ -94,6 +106,11 @@ namespace Renderer
         const std::string& bottom,
         const std::string& back,
         const std::string& front)
+    {
+        return Load(std::vector<std::string>{right, left, top, bottom, back, front});
+    }
+
+    bool Skybox::Load(const std::vector<std::string>& faces, bool flipVertically, bool generateMipmaps)
     {
         if (!m_isInitialized)
         {
@@ -101,61 +118,432 @@ namespace Renderer
             return false;
         }
 
-        // 存储6个面的文件路径
-        std::vector<std::string> faces = {
-            right, left, top, bottom, back, front
+        if (faces.size() != 6)
+        {
+            Core::Logger::GetInstance().Error("Skybox::Load() requires exactly 6 faces");
+            return false;
+        }
+
+        // 记录源文件和缓存键（派生数据如环境光 SH 也以此为缓存键）
+        std::string cachePath = GetCubemapCachePath(faces);
+        uint64_t cacheKey = ComputeCubemapCacheKey(faces, flipVertically, generateMipmaps);
+        m_sourceFiles = faces;
+        m_sourceKey = cacheKey;
+
+        // ⭐ 优先使用预编码的压缩面（无需解码，mip 链已预计算）
+        if (LoadCompressedFaces(faces))
+        {
+            return true;
+        }
+
+        // 检查文件是否存在
+        for (const auto& face : faces)
+        {
+            if (!fs::exists(face))
+            {
+                Core::Logger::GetInstance().Error("Skybox texture file not found: " + face);
+                return false;
+            }
+        }
+
+        // ⭐ 其次使用上次启动写入的立方体贴图缓存
+        if (LoadCachedCubemap(cachePath, cacheKey))
+        {
+            return true;
+        }
+
+        // ========================================
+        // 6 个面在工作线程上并行解码，主线程按完成顺序上传
+        // ========================================
+        struct DecodedFace
+        {
+            std::vector<uint8_t> rgba;
+            int width = 0;
+            int height = 0;
+            int channels = 0;
+            std::string error;
+        };
+
+        std::vector<DecodedFace> decoded(faces.size());
+        std::mutex doneMutex;
+        std::condition_variable doneCondition;
+        std::vector<size_t> doneOrder;
+
+        Core::ThreadPool& pool = Core::ThreadPool::GetInstance();
+        std::vector<std::future<void>> futures;
+        futures.reserve(faces.size());
+        for (size_t i = 0; i < faces.size(); ++i)
+        {
+            futures.push_back(pool.Submit([&, i]() {
+                // 翻转标志和错误信息都是线程局部的，不影响其他线程上的加载
+                stbi_set_flip_vertically_on_load_thread(flipVertically ? 1 : 0);
+                DecodedFace& face = decoded[i];
+                unsigned char* data = stbi_load(faces[i].c_str(), &face.width, &face.height, &face.channels, 4);
+                if (data)
+                {
+                    face.rgba.assign(data, data + static_cast<size_t>(face.width) * face.height * 4);
+                    stbi_image_free(data);
+                }
+                else
+                {
+                    face.error = stbi_failure_reason() ? stbi_failure_reason() : "unknown error";
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(doneMutex);
+                    doneOrder.push_back(i);
+                }
+                doneCondition.notify_one();
+            }));
+        }
+
+        glGenTextures(1, &m_textureID);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, m_textureID);
+
+        bool success = true;
+        for (size_t uploaded = 0; uploaded < faces.size(); ++uploaded)
+        {
+            size_t index;
+            {
+                std::unique_lock<std::mutex> lock(doneMutex);
+                doneCondition.wait(lock, [&]() { return doneOrder.size() > uploaded; });
+                index = doneOrder[uploaded];
+            }
+
+            const DecodedFace& face = decoded[index];
+            if (!success)
+            {
+                continue; // 已失败：只等待剩余任务结束
+            }
+            if (!face.error.empty())
+            {
+                Core::Logger::GetInstance().Error("Failed to load skybox texture: " + faces[index]);
+                Core::Logger::GetInstance().Error("STB Image error: " + face.error);
+                success = false;
+                continue;
+            }
+            if (face.width != face.height)
+            {
+                Core::Logger::GetInstance().Error("Skybox face is not square: " + faces[index]);
+                success = false;
+                continue;
+            }
+
+            // 上传纹理数据到cubemap的对应面
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<GLenum>(index), 0, GL_RGBA8,
+                         face.width, face.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, face.rgba.data());
+            RENDER_STATS_ADD(TextureBytesUploaded, face.rgba.size());
+        }
+
+        for (auto& future : futures)
+        {
+            future.get();
+        }
+
+        for (const auto& face : decoded)
+        {
+            if (success && (face.width != decoded[0].width || face.height != decoded[0].height))
+            {
+                Core::Logger::GetInstance().Error("Skybox faces have different sizes");
+                success = false;
+            }
+        }
+
+        if (!success)
+        {
+            glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+            glDeleteTextures(1, &m_textureID);
+            m_textureID = 0;
+            return false;
+        }
+
+        if (generateMipmaps)
+        {
+            glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+        }
+
+        // 设置纹理参数
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, generateMipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+        Core::Logger::GetInstance().Info("Skybox cubemap loaded successfully (ID: " +
+                                        std::to_string(m_textureID) + ", " + std::to_string(decoded[0].width) + "x" +
+                                        std::to_string(decoded[0].height) + ", decoded on " +
+                                        std::to_string(pool.GetThreadCount()) + " worker threads)");
+
+        // 后台编码并写入缓存，下次启动直接上传
+        std::vector<std::vector<uint8_t>> faceData;
+        faceData.reserve(decoded.size());
+        for (auto& face : decoded)
+        {
+            faceData.push_back(std::move(face.rgba));
+        }
+        WriteCubemapCacheAsync(cachePath, cacheKey, std::move(faceData),
+                               static_cast<uint32_t>(decoded[0].width), decoded[0].channels, generateMipmaps);
+        return true;
+    }
+
+    std::string Skybox::GetCubemapCachePath(const std::vector<std::string>& faces)
+    {
+        fs::path first(faces[0]);
+        return (first.parent_path() / (first.stem().string() + ".cubemap.dds")).string();
+    }
+
+    uint64_t Skybox::ComputeCubemapCacheKey(const std::vector<std::string>& faces, bool flipVertically, bool generateMipmaps)
+    {
+        // FNV-1a：路径 + 文件大小 + 修改时间 + 加载选项，任一源文件变化都会使缓存失效
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const void* data, size_t size) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
         };
 
-        // 生成cubemap纹理
+        const uint32_t version = 1;
+        mix(&version, sizeof(version));
+        for (const auto& face : faces)
+        {
+            std::error_code ec;
+            uint64_t size = static_cast<uint64_t>(fs::file_size(face, ec));
+            int64_t time = static_cast<int64_t>(fs::last_write_time(face, ec).time_since_epoch().count());
+            mix(face.data(), face.size());
+            mix(&size, sizeof(size));
+            mix(&time, sizeof(time));
+        }
+        uint8_t flags = static_cast<uint8_t>((flipVertically ? 1 : 0) | (generateMipmaps ? 2 : 0));
+        mix(&flags, sizeof(flags));
+        return hash;
+    }
+
+    bool Skybox::LoadCachedCubemap(const std::string& cachePath, uint64_t cacheKey)
+    {
+        if (!fs::exists(cachePath))
+        {
+            return false;
+        }
+
+        CompressedImage image;
+        std::string error;
+        if (!TextureCompression::ReadDDS(cachePath, image, &error))
+        {
+            Core::Logger::GetInstance().Warning("Failed to read skybox cache " + cachePath + ": " + error);
+            return false;
+        }
+
+        if (image.userKey != cacheKey || image.faceCount != 6 || image.width != image.height)
+        {
+            Core::Logger::GetInstance().Info("Skybox cache is stale, rebuilding: " + cachePath);
+            return false;
+        }
+
+        if (!Texture::IsCompressedFormatSupported(image.format))
+        {
+            return false;
+        }
+
         glGenTextures(1, &m_textureID);
         glBindTexture(GL_TEXTURE_CUBE_MAP, m_textureID);
 
-        // 加载6个面的纹理
-        for (unsigned int i = 0; i < faces.size(); i++)
+        for (unsigned int i = 0; i < 6; ++i)
         {
-            // 检查文件是否存在
-            if (!fs::exists(faces[i]))
+            if (!Texture::UploadCompressedLevels(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, image, i))
             {
-                Core::Logger::GetInstance().Error("Skybox texture file not found: " + faces[i]);
+                Core::Logger::GetInstance().Error("OpenGL error uploading cached skybox face " + std::to_string(i));
+                glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
                 glDeleteTextures(1, &m_textureID);
                 m_textureID = 0;
                 return false;
             }
+        }
+
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, image.mipCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.mipCount - 1));
+
+        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+        Core::Logger::GetInstance().Info("Skybox cubemap loaded from cache (ID: " + std::to_string(m_textureID) + ", " +
+                                        TextureCompression::GetFormatName(image.format) + ", " +
+                                        std::to_string(image.mipCount) + " mips): " + cachePath);
+        return true;
+    }
+
+    void Skybox::WriteCubemapCacheAsync(const std::string& cachePath, uint64_t cacheKey,
+                                        std::vector<std::vector<uint8_t>> faces, uint32_t size,
+                                        int channels, bool generateMipmaps)
+    {
+        // 格式选择在主线程完成（需要查询 GL 扩展）
+        BlockFormat format = TextureCompression::ChooseDefaultFormat(faces[0].data(), size, size, channels);
+        if (!Texture::IsCompressedFormatSupported(format))
+        {
+            format = BlockFormat::RGBA8;
+        }
+
+        // 每个面一个编码任务，最后完成的任务负责组装并写入文件（任务之间不互相等待）
+        struct CacheJob
+        {
+            std::string path;
+            uint64_t key = 0;
+            BlockFormat format = BlockFormat::RGBA8;
+            uint32_t size = 0;
+            bool generateMipmaps = false;
+            std::vector<std::vector<uint8_t>> faces;
+            std::vector<CompressedImage> encoded;
+            std::atomic<int> remaining{0};
+            std::atomic<bool> failed{false};
+        };
+
+        auto job = std::make_shared<CacheJob>();
+        job->path = cachePath;
+        job->key = cacheKey;
+        job->format = format;
+        job->size = size;
+        job->generateMipmaps = generateMipmaps;
+        job->faces = std::move(faces);
+        job->encoded.resize(job->faces.size());
+        job->remaining = static_cast<int>(job->faces.size());
+
+        for (size_t i = 0; i < job->faces.size(); ++i)
+        {
+            Core::ThreadPool::GetInstance().Submit([job, i]() {
+                std::string error;
+                std::vector<std::vector<uint8_t>> face;
+                face.push_back(std::move(job->faces[i])); // 编码后源像素随之释放
+                if (!TextureCompression::Compress(face, job->size, job->size, job->format,
+                                                  CompressionQuality::FAST, job->generateMipmaps, job->encoded[i], &error))
+                {
+                    job->failed = true;
+                }
+
+                if (--job->remaining != 0)
+                {
+                    return;
+                }
+
+                if (job->failed)
+                {
+                    Core::Logger::GetInstance().Warning("Skybox cache encoding failed: " + job->path);
+                    return;
+                }
+
+                CompressedImage cubemap;
+                cubemap.format = job->format;
+                cubemap.width = job->size;
+                cubemap.height = job->size;
+                cubemap.faceCount = 6;
+                cubemap.mipCount = job->encoded[0].mipCount;
+                cubemap.flippedForGL = false;
+                cubemap.userKey = job->key;
+                for (auto& face : job->encoded)
+                {
+                    for (auto& level : face.levels)
+                    {
+                        cubemap.levels.push_back(std::move(level));
+                    }
+                }
+
+                if (TextureCompression::WriteDDS(job->path, cubemap, &error))
+                {
+                    Core::Logger::GetInstance().Info("Skybox cache written: " + job->path + " (" +
+                                                    TextureCompression::GetFormatName(job->format) + ", " +
+                                                    std::to_string(cubemap.GetTotalSizeBytes() / 1024) + " KB)");
+                }
+                else
+                {
+                    Core::Logger::GetInstance().Warning("Failed to write skybox cache " + job->path + ": " + error);
+                }
+            });
+        }
+    }
+
+    bool Skybox::LoadCompressedFaces(const std::vector<std::string>& faces)
+    {
+        std::vector<CompressedImage> images(faces.size());
+
+        for (size_t i = 0; i < faces.size(); ++i)
+        {
+            std::string ddsPath = faces[i];
+            if (fs::path(ddsPath).extension() != ".dds")
+            {
+                ddsPath = Texture::FindCompressedSibling(faces[i]);
+                if (ddsPath.empty())
+                {
+                    return false;
+                }
+            }
 
-            int width, height, channels;
-            stbi_set_flip_vertically_on_load(false); // 天空盒不需要翻转
-            unsigned char* data = stbi_load(faces[i].c_str(), &width, &height, &channels, 0);
+            std::string error;
+            if (!TextureCompression::ReadDDS(ddsPath, images[i], &error))
+            {
+                Core::Logger::GetInstance().Warning("Failed to read compressed skybox face " + ddsPath + ": " + error);
+                return false;
+            }
 
-            if (!data)
+            const CompressedImage& first = images[0];
+            const CompressedImage& image = images[i];
+            if (image.faceCount != 1 || image.format != first.format || image.width != first.width ||
+                image.height != first.height || image.mipCount != first.mipCount || image.width != image.height)
             {
-                Core::Logger::GetInstance().Error("Failed to load skybox texture: " + faces[i]);
-                Core::Logger::GetInstance().Error("STB Image error: " + std::string(stbi_failure_reason()));
-                glDeleteTextures(1, &m_textureID);
-                m_textureID = 0;
+                Core::Logger::GetInstance().Warning("Compressed skybox faces are inconsistent, falling back to source images");
                 return false;
             }
 
-            // 确定格式
-            GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
+            if (image.flippedForGL)
+            {
+                // 天空盒面不翻转，转换时需使用 --no-flip
+                Core::Logger::GetInstance().Warning("Compressed skybox face was flipped (convert with --no-flip): " + ddsPath);
+            }
+        }
 
-            // 上传纹理数据到cubemap的对应面
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, format,
-                        width, height, 0, format, GL_UNSIGNED_BYTE, data);
+        if (!Texture::IsCompressedFormatSupported(images[0].format))
+        {
+            Core::Logger::GetInstance().Warning(std::string("Skybox compressed format not supported: ") +
+                                                TextureCompression::GetFormatName(images[0].format));
+            return false;
+        }
+
+        glGenTextures(1, &m_textureID);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, m_textureID);
 
-            stbi_image_free(data);
+        for (unsigned int i = 0; i < images.size(); ++i)
+        {
+            if (!Texture::UploadCompressedLevels(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, images[i], 0))
+            {
+                Core::Logger::GetInstance().Error("OpenGL error uploading compressed skybox face " + std::to_string(i));
+                glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+                glDeleteTextures(1, &m_textureID);
+                m_textureID = 0;
+                return false;
+            }
         }
 
-        // 设置纹理参数
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        uint32_t mipCount = images[0].mipCount;
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, mipCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(mipCount - 1));
 
         glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
 
-        Core::Logger::GetInstance().Info("Skybox cubemap loaded successfully (ID: " +
-                                        std::to_string(m_textureID) + ")");
+        Core::Logger::GetInstance().Info("Skybox cubemap loaded from compressed faces (ID: " +
+                                        std::to_string(m_textureID) + ", " +
+                                        TextureCompression::GetFormatName(images[0].format) + ", " +
+                                        std::to_string(mipCount) + " mips)");
         return true;
     }
 
@@ -179,15 +567,8 @@ namespace Renderer
             return false;
         }
 
-        // 使用配置中的文件路径（已经是OpenGL顺序）
-        return Load(
-            config.faceFilenames[0], // right
-            config.faceFilenames[1], // left
-            config.faceFilenames[2], // top
-            config.faceFilenames[3], // bottom
-            config.faceFilenames[4], // back
-            config.faceFilenames[5]  // front
-        );
+        // 使用配置中的文件路径（已经是OpenGL顺序：right, left, top, bottom, back, front）
+        return Load(config.faceFilenames, config.flipVertically, config.generateMipmaps);
     }
 
     void Skybox::Render(const glm::mat4& projection, const glm::mat4& view)
@@ -198,6 +579,8 @@ namespace Renderer
             return;
         }
 
+        PROFILE_GPU_SCOPE("Skybox");
+
         // 深度测试设置为GL_LEQUAL，确保天空盒在最远处
         glDepthFunc(GL_LEQUAL);
 
@@ -223,9 +606,12 @@ namespace Renderer
         glActiveTexture(GL_TEXTURE15);
         glBindTexture(GL_TEXTURE_CUBE_MAP, m_textureID);
         m_shader.SetInt("skybox", 15);
+        RENDER_STATS_ADD(VertexArrayBinds, 1);
+        RENDER_STATS_ADD(TextureBinds, 1);
 
         // 绘制天空盒
         glDrawArrays(GL_TRIANGLES, 0, 36);
+        RENDER_STATS_DRAW(1, 12, 36);
 
         // 恢复深度写入
         glDepthMask(GL_TRUE);
@@ -0,0 +1,356 @@
+#include "Renderer/Environment/SphericalHarmonics.hpp"
+#include "Core/ThreadPool.hpp"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LUMEN_SH_USE_SSE 1
+#include <emmintrin.h>
+#else
+#define LUMEN_SH_USE_SSE 0
+#endif
+
+namespace Renderer
+{
+    namespace SphericalHarmonics
+    {
+        namespace
+        {
+            constexpr float kPi = 3.14159265358979f;
+
+            // 基函数常数 K_i（Y_i = K_i * p_i(x, y, z)）
+            constexpr float kBasisScale[9] = {
+                0.282095f,
+                0.488603f, 0.488603f, 0.488603f,
+                1.092548f, 1.092548f, 0.315392f, 1.092548f, 0.546274f};
+
+            // 余弦卷积系数 A_l / π（l = 0, 1, 2）
+            constexpr float kIrradianceBand[9] = {
+                1.0f,
+                2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f,
+                0.25f, 0.25f, 0.25f, 0.25f, 0.25f};
+
+            constexpr uint32_t kCacheMagic = 0x39485348; // "HSH9"
+            constexpr uint32_t kCacheVersion = 1;
+
+            /**
+             * 面坐标 → 方向：每个分量 = k + ks * sc + kt * tc（OpenGL 立方体贴图约定，行 0 对应 tc = -1）
+             */
+            struct AxisTerm
+            {
+                float k, ks, kt;
+            };
+
+            struct FaceMapping
+            {
+                AxisTerm x, y, z;
+            };
+
+            constexpr FaceMapping kFaces[6] = {
+                {{1, 0, 0}, {0, 0, -1}, {0, -1, 0}},  // +X: ( 1, -tc, -sc)
+                {{-1, 0, 0}, {0, 0, -1}, {0, 1, 0}},  // -X: (-1, -tc,  sc)
+                {{0, 1, 0}, {1, 0, 0}, {0, 0, 1}},    // +Y: ( sc,  1,  tc)
+                {{0, 1, 0}, {-1, 0, 0}, {0, 0, -1}},  // -Y: ( sc, -1, -tc)
+                {{0, 1, 0}, {0, 0, -1}, {1, 0, 0}},   // +Z: ( sc, -tc,  1)
+                {{0, -1, 0}, {0, 0, -1}, {-1, 0, 0}}, // -Z: (-sc, -tc, -1)
+            };
+
+            // 累加项：9 个基函数 x RGB + 立体角权重总和
+            constexpr int kSumCount = 28;
+
+            struct Accumulator
+            {
+                double sums[kSumCount] = {};
+
+                void Add(const float* values)
+                {
+                    for (int i = 0; i < kSumCount; ++i)
+                    {
+                        sums[i] += values[i];
+                    }
+                }
+
+                void Add(const Accumulator& other)
+                {
+                    for (int i = 0; i < kSumCount; ++i)
+                    {
+                        sums[i] += other.sums[i];
+                    }
+                }
+            };
+
+            inline void AccumulateTexel(float sc, float tc, const FaceMapping& face, const uint8_t* pixel, float* sums)
+            {
+                float invLength = 1.0f / std::sqrt(1.0f + sc * sc + tc * tc);
+                float weight = invLength * invLength * invLength; // 立体角 ∝ (1 + u² + v²)^(-3/2)
+
+                float x = (face.x.k + face.x.ks * sc + face.x.kt * tc) * invLength;
+                float y = (face.y.k + face.y.ks * sc + face.y.kt * tc) * invLength;
+                float z = (face.z.k + face.z.ks * sc + face.z.kt * tc) * invLength;
+
+                const float basis[9] = {1.0f, y, z, x, x * y, y * z, 3.0f * z * z - 1.0f, x * z, x * x - y * y};
+                float r = pixel[0], g = pixel[1], b = pixel[2];
+                for (int i = 0; i < 9; ++i)
+                {
+                    float wb = weight * basis[i];
+                    sums[i * 3 + 0] += wb * r;
+                    sums[i * 3 + 1] += wb * g;
+                    sums[i * 3 + 2] += wb * b;
+                }
+                sums[27] += weight;
+            }
+
+            /**
+             * 累加一行 texel（行内先用 float 累加，再合并到 double，避免大面上的精度损失）
+             */
+            void AccumulateRow(const uint8_t* row, uint32_t size, const FaceMapping& face, float tc, Accumulator& out)
+            {
+                float sums[kSumCount] = {};
+                const float texelScale = 2.0f / static_cast<float>(size);
+                uint32_t column = 0;
+
+#if LUMEN_SH_USE_SSE
+                __m128 acc[kSumCount];
+                for (auto& value : acc)
+                {
+                    value = _mm_setzero_ps();
+                }
+
+                const __m128 one = _mm_set1_ps(1.0f);
+                const __m128 three = _mm_set1_ps(3.0f);
+                const __m128 scale = _mm_set1_ps(texelScale);
+                const __m128 laneOffset = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+                const __m128 tcTerm = _mm_set1_ps(1.0f + tc * tc);
+                const __m128 xConst = _mm_set1_ps(face.x.k + face.x.kt * tc), xSc = _mm_set1_ps(face.x.ks);
+                const __m128 yConst = _mm_set1_ps(face.y.k + face.y.kt * tc), ySc = _mm_set1_ps(face.y.ks);
+                const __m128 zConst = _mm_set1_ps(face.z.k + face.z.kt * tc), zSc = _mm_set1_ps(face.z.ks);
+
+                for (; column + 4 <= size; column += 4)
+                {
+                    __m128 sc = _mm_sub_ps(_mm_mul_ps(_mm_add_ps(_mm_set1_ps(static_cast<float>(column)), laneOffset), scale), one);
+                    __m128 invLength = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(tcTerm, _mm_mul_ps(sc, sc))));
+                    __m128 weight = _mm_mul_ps(_mm_mul_ps(invLength, invLength), invLength);
+
+                    __m128 x = _mm_mul_ps(_mm_add_ps(xConst, _mm_mul_ps(xSc, sc)), invLength);
+                    __m128 y = _mm_mul_ps(_mm_add_ps(yConst, _mm_mul_ps(ySc, sc)), invLength);
+                    __m128 z = _mm_mul_ps(_mm_add_ps(zConst, _mm_mul_ps(zSc, sc)), invLength);
+
+                    // 4 个 RGBA8 texel → 3 个 float 向量
+                    __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + column * 4));
+                    __m128i zero = _mm_setzero_si128();
+                    __m128i lo = _mm_unpacklo_epi8(packed, zero);
+                    __m128i hi = _mm_unpackhi_epi8(packed, zero);
+                    __m128 p0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)); // texel 0: r g b a
+                    __m128 p1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)); // texel 1
+                    __m128 p2 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)); // texel 2
+                    __m128 p3 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)); // texel 3
+                    _MM_TRANSPOSE4_PS(p0, p1, p2, p3);                          // p0 = r, p1 = g, p2 = b
+                    __m128 r = _mm_mul_ps(p0, weight);
+                    __m128 g = _mm_mul_ps(p1, weight);
+                    __m128 b = _mm_mul_ps(p2, weight);
+
+                    const __m128 basis[9] = {
+                        one, y, z, x,
+                        _mm_mul_ps(x, y), _mm_mul_ps(y, z),
+                        _mm_sub_ps(_mm_mul_ps(three, _mm_mul_ps(z, z)), one),
+                        _mm_mul_ps(x, z), _mm_sub_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y))};
+
+                    for (int i = 0; i < 9; ++i)
+                    {
+                        acc[i * 3 + 0] = _mm_add_ps(acc[i * 3 + 0], _mm_mul_ps(basis[i], r));
+                        acc[i * 3 + 1] = _mm_add_ps(acc[i * 3 + 1], _mm_mul_ps(basis[i], g));
+                        acc[i * 3 + 2] = _mm_add_ps(acc[i * 3 + 2], _mm_mul_ps(basis[i], b));
+                    }
+                    acc[27] = _mm_add_ps(acc[27], weight);
+                }
+
+                for (int i = 0; i < kSumCount; ++i)
+                {
+                    alignas(16) float lanes[4];
+                    _mm_store_ps(lanes, acc[i]);
+                    sums[i] = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+                }
+#endif
+
+                for (; column < size; ++column)
+                {
+                    float sc = (static_cast<float>(column) + 0.5f) * texelScale - 1.0f;
+                    AccumulateTexel(sc, tc, face, row + column * 4, sums);
+                }
+
+                out.Add(sums);
+            }
+
+            /**
+             * 投影单个面：按行切分到线程池，每块使用独立累加器
+             */
+            void ProjectFace(const uint8_t* rgba, uint32_t size, int faceIndex, Accumulator& total)
+            {
+                const FaceMapping& face = kFaces[faceIndex];
+                std::mutex totalMutex;
+
+                Core::ThreadPool::GetInstance().ParallelFor(size, [&](size_t begin, size_t end) {
+                    Accumulator local;
+                    for (size_t rowIndex = begin; rowIndex < end; ++rowIndex)
+                    {
+                        float tc = (static_cast<float>(rowIndex) + 0.5f) * 2.0f / static_cast<float>(size) - 1.0f;
+                        AccumulateRow(rgba + rowIndex * size * 4, size, face, tc, local);
+                    }
+                    std::lock_guard<std::mutex> lock(totalMutex);
+                    total.Add(local);
+                }, 16);
+            }
+
+            SH9Color Finalize(const Accumulator& total)
+            {
+                SH9Color result;
+                if (total.sums[27] <= 0.0)
+                {
+                    return result;
+                }
+
+                // 权重总和归一化到 4π（修正立体角近似的误差），颜色从 [0, 255] 归一化
+                double normalization = 4.0 * kPi / total.sums[27] / 255.0;
+                for (int i = 0; i < 9; ++i)
+                {
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        result.coefficients[i][c] = static_cast<float>(total.sums[i * 3 + c] * normalization * kBasisScale[i]);
+                    }
+                }
+                return result;
+            }
+        } // namespace
+
+        SH9Color ProjectCubemap(const uint8_t* const faces[6], uint32_t size)
+        {
+            Accumulator total;
+            for (int face = 0; face < 6; ++face)
+            {
+                ProjectFace(faces[face], size, face, total);
+            }
+            return Finalize(total);
+        }
+
+        bool ProjectCubemapTexture(unsigned int cubemapTextureID, SH9Color& outRadiance)
+        {
+            if (cubemapTextureID == 0)
+            {
+                return false;
+            }
+
+            glBindTexture(GL_TEXTURE_CUBE_MAP, cubemapTextureID);
+            GLint width = 0, height = 0;
+            glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, GL_TEXTURE_WIDTH, &width);
+            glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, GL_TEXTURE_HEIGHT, &height);
+            if (width <= 0 || width != height)
+            {
+                glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+                return false;
+            }
+
+            // 逐面读回（压缩格式由驱动解码），一个面的缓冲区复用
+            uint32_t size = static_cast<uint32_t>(width);
+            std::vector<uint8_t> pixels(static_cast<size_t>(size) * size * 4);
+            Accumulator total;
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+            for (int face = 0; face < 6; ++face)
+            {
+                glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+                ProjectFace(pixels.data(), size, face, total);
+            }
+            glPixelStorei(GL_PACK_ALIGNMENT, 4);
+            glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+            outRadiance = Finalize(total);
+            return glGetError() == GL_NO_ERROR;
+        }
+
+        GPUSHIrradiance ToIrradiance(const SH9Color& radiance)
+        {
+            GPUSHIrradiance result;
+            for (int i = 0; i < 9; ++i)
+            {
+                result.coefficients[i] = glm::vec4(radiance.coefficients[i] * (kIrradianceBand[i] * kBasisScale[i]), 0.0f);
+            }
+            return result;
+        }
+
+        glm::vec3 EvaluateIrradiance(const GPUSHIrradiance& irradiance, const glm::vec3& n)
+        {
+            const glm::vec4* c = irradiance.coefficients;
+            glm::vec3 result = glm::vec3(c[0]) +
+                               glm::vec3(c[1]) * n.y + glm::vec3(c[2]) * n.z + glm::vec3(c[3]) * n.x +
+                               glm::vec3(c[4]) * (n.x * n.y) + glm::vec3(c[5]) * (n.y * n.z) +
+                               glm::vec3(c[6]) * (3.0f * n.z * n.z - 1.0f) +
+                               glm::vec3(c[7]) * (n.x * n.z) + glm::vec3(c[8]) * (n.x * n.x - n.y * n.y);
+            return glm::max(result, glm::vec3(0.0f));
+        }
+
+        bool ReadCache(const std::string& filepath, uint64_t key, SH9Color& outRadiance)
+        {
+            std::ifstream file(filepath, std::ios::binary);
+            if (!file)
+            {
+                return false;
+            }
+
+            uint32_t magic = 0, version = 0;
+            uint64_t storedKey = 0;
+            float values[27];
+            file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+            file.read(reinterpret_cast<char*>(&version), sizeof(version));
+            file.read(reinterpret_cast<char*>(&storedKey), sizeof(storedKey));
+            file.read(reinterpret_cast<char*>(values), sizeof(values));
+            if (!file || magic != kCacheMagic || version != kCacheVersion || storedKey != key)
+            {
+                return false;
+            }
+
+            for (int i = 0; i < 9; ++i)
+            {
+                outRadiance.coefficients[i] = glm::vec3(values[i * 3], values[i * 3 + 1], values[i * 3 + 2]);
+            }
+            return true;
+        }
+
+        bool WriteCache(const std::string& filepath, uint64_t key, const SH9Color& radiance)
+        {
+            float values[27];
+            for (int i = 0; i < 9; ++i)
+            {
+                values[i * 3 + 0] = radiance.coefficients[i].x;
+                values[i * 3 + 1] = radiance.coefficients[i].y;
+                values[i * 3 + 2] = radiance.coefficients[i].z;
+            }
+
+            // 先写临时文件再重命名，避免中断时留下损坏的缓存
+            std::string tempPath = filepath + ".tmp";
+            {
+                std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+                if (!file)
+                {
+                    return false;
+                }
+                file.write(reinterpret_cast<const char*>(&kCacheMagic), sizeof(kCacheMagic));
+                file.write(reinterpret_cast<const char*>(&kCacheVersion), sizeof(kCacheVersion));
+                file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+                file.write(reinterpret_cast<const char*>(values), sizeof(values));
+                if (!file)
+                {
+                    return false;
+                }
+            }
+
+            std::remove(filepath.c_str());
+            return std::rename(tempPath.c_str(), filepath.c_str()) == 0;
+        }
+
+    } // namespace SphericalHarmonics
+} // namespace Renderer
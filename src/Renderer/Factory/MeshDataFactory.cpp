@@ -4,12 +4,69 @@
 #include "Renderer/Geometry/Torus.hpp"
 #include "Renderer/Geometry/Plane.hpp"
 #include "Renderer/Geometry/OBJModel.hpp"
+#include "Renderer/Resources/MeshCache.hpp"
+#include "Renderer/Resources/GLTFLoader.hpp"
+#include "Renderer/Data/MeshOptimizer.hpp"
+#include "Renderer/Data/MeshQuantizer.hpp"
+#include "Renderer/Data/Meshlet.hpp"
 #include "Core/Logger.hpp"
 #include <glad/glad.h>
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <map>
 
 namespace Renderer
 {
 
+    namespace
+    {
+
+        /**
+         * CreatePreparedOBJData / CreatePreparedGLTFData 的公共部分
+         * create：缓存未命中时导入网格，并填写依赖文件（相对工作目录，第一个为源文件）
+         */
+        std::vector<MeshData> CreatePreparedData(const std::string& sourcePath, bool quantize,
+                                                 const std::function<std::vector<MeshData>(std::vector<std::string>&)>& create)
+        {
+            // ✅ 量化缓存命中：上传布局（含反量化参数和簇）直接引用映射，不拷贝也不重新量化
+            if (quantize)
+            {
+                if (auto cache = MeshCache::Open(sourcePath, true))
+                {
+                    std::vector<MeshData> dataList = MeshCache::ToMeshData(cache);
+                    Core::Logger::GetInstance().Info("MeshDataFactory - Mapped " +
+                                                     std::to_string(dataList.size()) + " prepared mesh data from " +
+                                                     cache->GetPath());
+                    return dataList;
+                }
+            }
+
+            std::vector<std::string> sourceFiles;
+            std::vector<MeshData> dataList = create(sourceFiles);
+            for (auto& data : dataList)
+            {
+                MeshDataFactory::PrepareForUpload(data, quantize);
+            }
+
+            // 未量化时 float 布局已由 .lmesh / 文件映射零拷贝提供，只缓存量化结果
+            if (quantize && !dataList.empty())
+            {
+                std::string error;
+                if (MeshCache::WriteQuantized(sourcePath, dataList, sourceFiles, &error))
+                {
+                    Core::Logger::GetInstance().Info("Mesh cache written: " + MeshCache::GetCachePath(sourcePath, true));
+                }
+                else
+                {
+                    Core::Logger::GetInstance().Warning("Failed to write quantized mesh cache for " + sourcePath + ": " + error);
+                }
+            }
+            return dataList;
+        }
+
+    } // namespace
+
     // ============================================================
     // MeshDataFactory 实现
     // ============================================================
@@ -175,8 +232,57 @@ namespace Renderer
         return data;
     }
 
+    std::vector<MeshData> MeshDataFactory::CreateSphereLODData(int stacks, int slices, float radius, size_t levelCount)
+    {
+        std::vector<MeshData> levels;
+        levels.push_back(CreateSphereData(stacks, slices, radius));
+        for (size_t level = 1; level < levelCount; ++level)
+        {
+            int nextStacks = std::max(stacks / 2, 4);
+            int nextSlices = std::max(slices / 2, 6);
+            if (nextStacks == stacks && nextSlices == slices)
+            {
+                break;
+            }
+            stacks = nextStacks;
+            slices = nextSlices;
+            levels.push_back(CreateSphereData(stacks, slices, radius));
+        }
+        return levels;
+    }
+
+    std::vector<MeshData> MeshDataFactory::CreateTorusLODData(float majorRadius, float minorRadius,
+                                                              int majorSegments, int minorSegments, size_t levelCount)
+    {
+        std::vector<MeshData> levels;
+        levels.push_back(CreateTorusData(majorRadius, minorRadius, majorSegments, minorSegments));
+        for (size_t level = 1; level < levelCount; ++level)
+        {
+            int nextMajor = std::max(majorSegments / 2, 8);
+            int nextMinor = std::max(minorSegments / 2, 4);
+            if (nextMajor == majorSegments && nextMinor == minorSegments)
+            {
+                break;
+            }
+            majorSegments = nextMajor;
+            minorSegments = nextMinor;
+            levels.push_back(CreateTorusData(majorRadius, minorRadius, majorSegments, minorSegments));
+        }
+        return levels;
+    }
+
     std::vector<MeshData> MeshDataFactory::CreateOBJData(const std::string& objPath)
     {
+        // ✅ 缓存命中：MeshData 直接引用内存映射（零拷贝），MeshBuffer 上传时从映射读取
+        if (auto cache = MeshCache::Open(objPath))
+        {
+            std::vector<MeshData> dataList = MeshCache::ToMeshData(cache);
+
+            Core::Logger::GetInstance().Info("MeshDataFactory::CreateOBJData() - Mapped " +
+                                             std::to_string(dataList.size()) + " mesh data from " + cache->GetPath());
+            return dataList;
+        }
+
         // 使用 OBJModel 的静态方法获取按材质分离的顶点数据
         std::vector<OBJModel::MaterialVertexData> materialDataList =
             OBJModel::GetMaterialVertexData(objPath);
@@ -215,6 +321,180 @@ namespace Renderer
         return dataList;
     }
 
+    MeshData MeshDataFactory::CreateOBJChunkData(OBJMeshChunk&& chunk, const std::vector<OBJMaterial>& materials,
+                                                 const std::string& basePath)
+    {
+        std::vector<float> vertices(chunk.vertices.size() * 8);
+        float* out = vertices.data();
+        for (const OBJVertex& vertex : chunk.vertices)
+        {
+            out[0] = vertex.position.x;
+            out[1] = vertex.position.y;
+            out[2] = vertex.position.z;
+            out[3] = vertex.normal.x;
+            out[4] = vertex.normal.y;
+            out[5] = vertex.normal.z;
+            out[6] = vertex.texCoord.x;
+            out[7] = vertex.texCoord.y;
+            out += 8;
+        }
+        std::vector<OBJVertex>().swap(chunk.vertices);
+
+        MeshOptimizer::Optimize(vertices, 8, chunk.indices);
+
+        MeshData data;
+        data.SetVertices(std::move(vertices), 8);
+        data.SetIndices(std::move(chunk.indices));
+        data.SetVertexLayout({0, 3, 6}, {3, 3, 2});
+
+        if (chunk.materialIndex >= 0 && static_cast<size_t>(chunk.materialIndex) < materials.size())
+        {
+            const OBJMaterial& material = materials[chunk.materialIndex];
+            data.SetMaterialColor(material.diffuse);
+            if (!material.diffuseTexname.empty())
+            {
+                data.SetTexturePath(basePath + material.diffuseTexname);
+            }
+        }
+        return data;
+    }
+
+    std::vector<MeshData> MeshDataFactory::CreateGLTFData(const std::string& gltfPath,
+                                                          std::vector<std::string>* outSourceFiles)
+    {
+        GLTFLoader loader;
+        if (!loader.LoadFromFile(gltfPath))
+        {
+            Core::Logger::GetInstance().Error("MeshDataFactory::CreateGLTFData() - Failed to load " + gltfPath);
+            return {};
+        }
+        if (outSourceFiles)
+        {
+            *outSourceFiles = loader.GetSourceFiles();
+        }
+
+        const std::vector<OBJMaterial>& materials = loader.GetMaterials();
+        std::vector<MeshData> dataList;
+        dataList.reserve(loader.GetPrimitives().size());
+        for (GLTFPrimitive& primitive : loader.GetPrimitives())
+        {
+            MeshData data = std::move(primitive.data);
+            if (primitive.materialIndex >= 0)
+            {
+                const OBJMaterial& material = materials[primitive.materialIndex];
+                data.SetMaterialColor(material.diffuse);
+                if (!material.diffuseTexname.empty())
+                {
+                    data.SetTexturePath(loader.GetBasePath() + material.diffuseTexname);
+                }
+            }
+            dataList.push_back(std::move(data));
+        }
+
+        Core::Logger::GetInstance().Info("MeshDataFactory::CreateGLTFData() - Created " +
+                                         std::to_string(dataList.size()) + " mesh data from " + gltfPath);
+        return dataList;
+    }
+
+    std::vector<MeshData> MeshDataFactory::CreateOBJAtlasData(const std::string& objPath, MaterialAtlas& atlas,
+                                                              MaterialTable* materialTable)
+    {
+        std::vector<OBJModel::MaterialVertexData> materialDataList =
+            OBJModel::GetMaterialVertexData(objPath);
+
+        // 第一步：登记纹理，确定每个材质的槽位
+        std::vector<AtlasSlot> slots(materialDataList.size());
+        int defaultArray = -1;
+        for (size_t i = 0; i < materialDataList.size(); ++i)
+        {
+            const auto& materialData = materialDataList[i];
+            if (!materialData.material.diffuseTexname.empty() &&
+                std::filesystem::exists(materialData.texturePath))
+            {
+                slots[i] = atlas.AddTexture(materialData.texturePath);
+            }
+            if (slots[i].IsValid() && (defaultArray < 0 || slots[i].arrayIndex < defaultArray))
+            {
+                defaultArray = slots[i].arrayIndex;
+            }
+        }
+
+        // 第二步：按纹理数组分组合并（无纹理材质并入默认组）
+        struct Group
+        {
+            std::vector<float> vertices;
+            std::vector<unsigned int> indices;
+        };
+        std::map<int, Group> groups;
+        const size_t srcStride = 8;
+        const size_t dstStride = materialTable ? 13 : 12;
+
+        for (size_t i = 0; i < materialDataList.size(); ++i)
+        {
+            auto& materialData = materialDataList[i];
+            int arrayIndex = slots[i].IsValid() ? slots[i].arrayIndex : defaultArray;
+            float layer = slots[i].IsValid() ? static_cast<float>(slots[i].layer) : -1.0f;
+            const glm::vec3& diffuse = materialData.material.diffuse;
+            float materialIndex = 0.0f;
+            if (materialTable)
+            {
+                materialIndex = static_cast<float>(
+                    materialTable->Add(materialData.material, slots[i], objPath + "#" + materialData.material.name));
+            }
+
+            Group& group = groups[arrayIndex];
+            unsigned int baseVertex = static_cast<unsigned int>(group.vertices.size() / dstStride);
+            size_t vertexCount = materialData.vertices.size() / srcStride;
+
+            group.vertices.reserve(group.vertices.size() + vertexCount * dstStride);
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                const float* src = &materialData.vertices[v * srcStride];
+                group.vertices.insert(group.vertices.end(), src, src + srcStride);
+                group.vertices.push_back(diffuse.r);
+                group.vertices.push_back(diffuse.g);
+                group.vertices.push_back(diffuse.b);
+                group.vertices.push_back(layer);
+                if (materialTable)
+                {
+                    group.vertices.push_back(materialIndex);
+                }
+            }
+
+            group.indices.reserve(group.indices.size() + materialData.indices.size());
+            for (unsigned int index : materialData.indices)
+            {
+                group.indices.push_back(baseVertex + index);
+            }
+        }
+
+        std::vector<MeshData> dataList;
+        dataList.reserve(groups.size());
+        for (auto& [arrayIndex, group] : groups)
+        {
+            MeshData data;
+            data.SetVertices(std::move(group.vertices), dstStride);
+            data.SetIndices(std::move(group.indices));
+            if (materialTable)
+            {
+                data.SetVertexLayout({0, 3, 6, 8, 12}, {3, 3, 2, 4, 1}, {0, 1, 2, 8, 9});
+            }
+            else
+            {
+                data.SetVertexLayout({0, 3, 6, 8}, {3, 3, 2, 4}, {0, 1, 2, 8});
+            }
+            data.SetMaterialColor(glm::vec3(1.0f));
+            data.SetTextureArrayIndex(arrayIndex);
+            dataList.push_back(std::move(data));
+        }
+
+        Core::Logger::GetInstance().Info("MeshDataFactory::CreateOBJAtlasData() - Merged " +
+                                         std::to_string(materialDataList.size()) + " materials into " +
+                                         std::to_string(dataList.size()) + " mesh data from " + objPath);
+
+        return dataList;
+    }
+
     // 已删除（2026-01-02）：ExtractFromCube() - 几何体类已改为纯静态类
     // 已删除（2026-01-02）：ExtractFromSphere() - 几何体类已改为纯静态类
 
@@ -222,6 +502,44 @@ namespace Renderer
     // MeshBufferFactory 实现
     // ============================================================
 
+    void MeshDataFactory::PrepareForUpload(MeshData& data, bool quantize)
+    {
+        if (data.GetIndexCount() / 3 >= MeshletBuilder::kMinTriangles)
+        {
+            data.SetMeshlets(MeshletBuilder::Build(data));
+        }
+        if (quantize)
+        {
+            MeshQuantizer::Quantize(data);
+        }
+    }
+
+    std::vector<MeshData> MeshDataFactory::CreatePreparedOBJData(const std::string& objPath, bool quantize)
+    {
+        return CreatePreparedData(objPath, quantize, [&objPath](std::vector<std::string>& sourceFiles) {
+            sourceFiles = MeshCache::GetSourceFiles(objPath);
+            return CreateOBJData(objPath);
+        });
+    }
+
+    std::vector<MeshData> MeshDataFactory::CreatePreparedGLTFData(const std::string& gltfPath, bool quantize)
+    {
+        return CreatePreparedData(gltfPath, quantize, [&gltfPath](std::vector<std::string>& sourceFiles) {
+            return CreateGLTFData(gltfPath, &sourceFiles);
+        });
+    }
+
+    std::vector<MeshData> MeshDataFactory::CreateLODData(MeshData data, const MeshLODConfig& config, bool quantize)
+    {
+        // ⚠️ 简化器按 float 读取位置，必须先生成 LOD 再量化
+        std::vector<MeshData> levels = MeshSimplifier::BuildLODChain(std::move(data), config);
+        for (auto& level : levels)
+        {
+            PrepareForUpload(level, quantize);
+        }
+        return levels;
+    }
+
     MeshBuffer MeshBufferFactory::CreateCubeBuffer()
     {
         MeshData data = MeshDataFactory::CreateCubeData();
@@ -248,12 +566,61 @@ namespace Renderer
         return CreateFromMeshData(std::move(data));
     }
 
-    std::vector<MeshBuffer> MeshBufferFactory::CreateOBJBuffers(const std::string& objPath)
+    std::vector<MeshBuffer> MeshBufferFactory::CreateSphereLODBuffers(int stacks, int slices, float radius,
+                                                                      size_t levelCount)
+    {
+        return CreateFromMeshDataList(MeshDataFactory::CreateSphereLODData(stacks, slices, radius, levelCount));
+    }
+
+    std::vector<MeshBuffer> MeshBufferFactory::CreateTorusLODBuffers(float majorRadius, float minorRadius,
+                                                                     int majorSegments, int minorSegments,
+                                                                     size_t levelCount)
+    {
+        return CreateFromMeshDataList(MeshDataFactory::CreateTorusLODData(majorRadius, minorRadius, majorSegments,
+                                                                          minorSegments, levelCount));
+    }
+
+    std::vector<MeshBuffer> MeshBufferFactory::CreateLODBuffers(MeshData data, const MeshLODConfig& config,
+                                                                bool quantize)
+    {
+        return CreateFromMeshDataList(MeshDataFactory::CreateLODData(std::move(data), config, quantize));
+    }
+
+    std::vector<MeshBuffer> MeshBufferFactory::CreateOBJBuffers(const std::string& objPath, bool quantize)
+    {
+        return CreateFromMeshDataList(MeshDataFactory::CreatePreparedOBJData(objPath, quantize));
+    }
+
+    std::vector<MeshBuffer> MeshBufferFactory::CreateGLTFBuffers(const std::string& gltfPath, bool quantize)
+    {
+        return CreateFromMeshDataList(MeshDataFactory::CreatePreparedGLTFData(gltfPath, quantize));
+    }
+
+    std::vector<MeshBuffer> MeshBufferFactory::CreateOBJAtlasBuffers(const std::string& objPath, MaterialAtlas& atlas,
+                                                                     MaterialTable* materialTable, bool quantize)
     {
-        std::vector<MeshData> dataList = MeshDataFactory::CreateOBJData(objPath);
+        std::vector<MeshData> dataList = MeshDataFactory::CreateOBJAtlasData(objPath, atlas, materialTable);
+        for (auto& data : dataList)
+        {
+            MeshDataFactory::PrepareForUpload(data, quantize);
+        }
         return CreateFromMeshDataList(std::move(dataList));
     }
 
+    std::vector<std::vector<MeshBuffer>> MeshBufferFactory::CreateOBJAtlasLODBuffers(const std::string& objPath,
+                                                                                     MaterialAtlas& atlas,
+                                                                                     const MeshLODConfig& config,
+                                                                                     MaterialTable* materialTable,
+                                                                                     bool quantize)
+    {
+        std::vector<std::vector<MeshBuffer>> chains;
+        for (auto& data : MeshDataFactory::CreateOBJAtlasData(objPath, atlas, materialTable))
+        {
+            chains.push_back(CreateLODBuffers(std::move(data), config, quantize));
+        }
+        return chains;
+    }
+
     MeshBuffer MeshBufferFactory::CreateFromMeshData(const MeshData& data)
     {
         MeshBuffer buffer;
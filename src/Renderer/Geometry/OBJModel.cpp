@@ -1,12 +1,39 @@
 #include "Renderer/Geometry/OBJModel.hpp"
+#include "Renderer/Resources/MeshCache.hpp"
+#include "Renderer/Data/MeshOptimizer.hpp"
 #include "Core/Logger.hpp"
+#include "Core/ThreadPool.hpp"
 #include <algorithm>
-#include <unordered_map>
+#include <cstdio>
 
 namespace Renderer
 {
 
     std::vector<OBJModel::MaterialVertexData> OBJModel::GetMaterialVertexData(const std::string& objPath)
+    {
+        // ✅ 优先使用 .lmesh 缓存，跳过文本解析、顶点去重和材质拆分
+        if (auto cache = MeshCache::Open(objPath))
+        {
+            return cache->ToMaterialVertexData();
+        }
+
+        std::vector<MaterialVertexData> materialDataList = ParseMaterialVertexData(objPath);
+        if (!materialDataList.empty())
+        {
+            std::string error;
+            if (MeshCache::Write(objPath, materialDataList, &error))
+            {
+                Core::Logger::GetInstance().Info("Mesh cache written: " + MeshCache::GetCachePath(objPath));
+            }
+            else
+            {
+                Core::Logger::GetInstance().Warning("Failed to write mesh cache for " + objPath + ": " + error);
+            }
+        }
+        return materialDataList;
+    }
+
+    std::vector<OBJModel::MaterialVertexData> OBJModel::ParseMaterialVertexData(const std::string& objPath)
     {
         std::vector<MaterialVertexData> materialDataList;
 
@@ -52,80 +79,133 @@ namespace Renderer
             data.indices = indices;
 
             materialDataList.push_back(std::move(data));
+            OptimizeMaterialVertexData(materialDataList);
         }
         else
         {
-            // ✅ 性能优化：为每个材质只收集实际使用的顶点
-            // 避免复制全部顶点，减少内存占用和GPU传输
+            // ✅ 性能优化：单遍计数排序按材质分桶，再并行为每个材质生成顶点数据
+            // 输出与逐材质扫描 + sort/unique + unordered_map 重映射的旧实现完全一致：
+            // - 材质内的面保持原顺序
+            // - 局部顶点按全局索引升序排列
+
+            // 第一步：统计每个材质的面数（计数排序）
+            const size_t materialCount = materials.size();
+            std::vector<size_t> materialFaceOffsets(materialCount + 1, 0);
+            size_t faceCount = std::min(faceMaterialIndices.size(), indices.size() / 3);
+            for (size_t faceIdx = 0; faceIdx < faceCount; ++faceIdx)
+            {
+                int matIdx = faceMaterialIndices[faceIdx];
+                if (matIdx >= 0 && static_cast<size_t>(matIdx) < materialCount)
+                {
+                    ++materialFaceOffsets[matIdx + 1];
+                }
+            }
+            for (size_t matIdx = 0; matIdx < materialCount; ++matIdx)
+            {
+                materialFaceOffsets[matIdx + 1] += materialFaceOffsets[matIdx];
+            }
 
-            // 第一步：收集每个材质使用的唯一顶点索引
-            std::vector<std::vector<unsigned int>> materialVertexIndices(materials.size());
-            for (size_t matIdx = 0; matIdx < materials.size(); ++matIdx)
+            // 第二步：按材质分桶（稳定，桶内保持面顺序）
+            std::vector<unsigned int> sortedFaces(materialFaceOffsets[materialCount]);
             {
-                // 收集使用此材质的所有面的索引
-                for (size_t faceIdx = 0; faceIdx < faceMaterialIndices.size(); ++faceIdx)
+                std::vector<size_t> cursor(materialFaceOffsets.begin(), materialFaceOffsets.end() - 1);
+                for (size_t faceIdx = 0; faceIdx < faceCount; ++faceIdx)
                 {
-                    if (faceMaterialIndices[faceIdx] == static_cast<int>(matIdx))
+                    int matIdx = faceMaterialIndices[faceIdx];
+                    if (matIdx >= 0 && static_cast<size_t>(matIdx) < materialCount)
                     {
-                        size_t idxStart = faceIdx * 3;
-                        if (idxStart + 2 < indices.size())
-                        {
-                            materialVertexIndices[matIdx].push_back(indices[idxStart]);
-                            materialVertexIndices[matIdx].push_back(indices[idxStart + 1]);
-                            materialVertexIndices[matIdx].push_back(indices[idxStart + 2]);
-                        }
+                        sortedFaces[cursor[matIdx]++] = static_cast<unsigned int>(faceIdx);
                     }
                 }
+            }
+
+            // 第三步：并行生成每个材质的数据，全局 → 局部索引使用平坦数组（每个任务一份，用完只重置访问过的项）
+            constexpr unsigned int kUnmapped = ~0u;
+            std::vector<MaterialVertexData> perMaterial(materialCount);
+            Core::ThreadPool::GetInstance().ParallelFor(materialCount, [&](size_t begin, size_t end) {
+                std::vector<unsigned int> globalToLocal(vertices.size(), kUnmapped);
+                std::vector<unsigned int> usedVertices;
 
-                // 如果此材质没有使用任何面，跳过
-                if (materialVertexIndices[matIdx].empty())
+                for (size_t matIdx = begin; matIdx < end; ++matIdx)
                 {
-                    continue;
-                }
+                    const size_t faceBegin = materialFaceOffsets[matIdx];
+                    const size_t faceEnd = materialFaceOffsets[matIdx + 1];
+                    // 如果此材质没有使用任何面，跳过
+                    if (faceBegin == faceEnd)
+                    {
+                        continue;
+                    }
 
-                // 第二步：获取唯一顶点索引（去重）
-                std::vector<unsigned int> uniqueIndices = materialVertexIndices[matIdx];
-                std::sort(uniqueIndices.begin(), uniqueIndices.end());
-                uniqueIndices.erase(std::unique(uniqueIndices.begin(), uniqueIndices.end()), uniqueIndices.end());
+                    // 收集唯一顶点并按全局索引升序分配局部索引
+                    usedVertices.clear();
+                    for (size_t i = faceBegin; i < faceEnd; ++i)
+                    {
+                        const size_t idxStart = static_cast<size_t>(sortedFaces[i]) * 3;
+                        for (size_t corner = 0; corner < 3; ++corner)
+                        {
+                            unsigned int globalIdx = indices[idxStart + corner];
+                            if (globalToLocal[globalIdx] == kUnmapped)
+                            {
+                                globalToLocal[globalIdx] = 0;
+                                usedVertices.push_back(globalIdx);
+                            }
+                        }
+                    }
+                    std::sort(usedVertices.begin(), usedVertices.end());
+                    for (size_t i = 0; i < usedVertices.size(); ++i)
+                    {
+                        globalToLocal[usedVertices[i]] = static_cast<unsigned int>(i);
+                    }
 
-                // 第三步：创建局部顶点索引映射（全局索引 → 局部索引）
-                std::unordered_map<unsigned int, unsigned int> globalToLocalMap;
-                for (size_t i = 0; i < uniqueIndices.size(); ++i)
-                {
-                    globalToLocalMap[uniqueIndices[i]] = static_cast<unsigned int>(i);
-                }
+                    MaterialVertexData& data = perMaterial[matIdx];
+                    data.material = materials[matIdx];
+                    data.texturePath = loader.GetBasePath() + materials[matIdx].diffuseTexname;
 
-                // 第四步：只复制实际使用的顶点
-                MaterialVertexData data;
-                data.material = materials[matIdx];
-                data.texturePath = loader.GetBasePath() + materials[matIdx].diffuseTexname;
+                    // 只复制实际使用的顶点
+                    data.vertices.resize(usedVertices.size() * 8);
+                    float* out = data.vertices.data();
+                    for (unsigned int globalIdx : usedVertices)
+                    {
+                        const auto& vertex = vertices[globalIdx];
+                        out[0] = vertex.position.x;
+                        out[1] = vertex.position.y;
+                        out[2] = vertex.position.z;
+                        out[3] = vertex.normal.x;
+                        out[4] = vertex.normal.y;
+                        out[5] = vertex.normal.z;
+                        out[6] = vertex.texCoord.x;
+                        out[7] = vertex.texCoord.y;
+                        out += 8;
+                    }
 
-                // 预分配空间：只分配实际使用的顶点
-                data.vertices.reserve(uniqueIndices.size() * 8);
-                data.indices.reserve(materialVertexIndices[matIdx].size());
+                    // 转换索引：全局索引 → 局部索引
+                    data.indices.resize((faceEnd - faceBegin) * 3);
+                    unsigned int* outIndex = data.indices.data();
+                    for (size_t i = faceBegin; i < faceEnd; ++i)
+                    {
+                        const size_t idxStart = static_cast<size_t>(sortedFaces[i]) * 3;
+                        *outIndex++ = globalToLocal[indices[idxStart]];
+                        *outIndex++ = globalToLocal[indices[idxStart + 1]];
+                        *outIndex++ = globalToLocal[indices[idxStart + 2]];
+                    }
 
-                // 复制实际使用的顶点数据
-                for (unsigned int globalIdx : uniqueIndices)
-                {
-                    const auto& vertex = vertices[globalIdx];
-                    data.vertices.push_back(vertex.position.x);
-                    data.vertices.push_back(vertex.position.y);
-                    data.vertices.push_back(vertex.position.z);
-                    data.vertices.push_back(vertex.normal.x);
-                    data.vertices.push_back(vertex.normal.y);
-                    data.vertices.push_back(vertex.normal.z);
-                    data.vertices.push_back(vertex.texCoord.x);
-                    data.vertices.push_back(vertex.texCoord.y);
+                    // 重置本材质访问过的项，供下一个材质复用
+                    for (unsigned int globalIdx : usedVertices)
+                    {
+                        globalToLocal[globalIdx] = kUnmapped;
+                    }
                 }
+            });
 
-                // 转换索引：全局索引 → 局部索引
-                for (unsigned int globalIdx : materialVertexIndices[matIdx])
+            // 按材质顺序输出（跳过未使用的材质）
+            for (size_t matIdx = 0; matIdx < materialCount; ++matIdx)
+            {
+                if (!perMaterial[matIdx].indices.empty())
                 {
-                    data.indices.push_back(globalToLocalMap[globalIdx]);
+                    materialDataList.push_back(std::move(perMaterial[matIdx]));
                 }
-
-                materialDataList.push_back(std::move(data));
             }
+            OptimizeMaterialVertexData(materialDataList);
         }
 
         Core::Logger::GetInstance().Info("Generated material vertex data: " +
@@ -133,6 +213,42 @@ namespace Renderer
         return materialDataList;
     }
 
+    void OBJModel::OptimizeMaterialVertexData(std::vector<MaterialVertexData>& materialDataList)
+    {
+        // ✅ 顶点缓存 / 过度绘制 / 顶点获取优化，每个材质独立并行处理（结果随 .lmesh 缓存保存）
+        std::vector<VertexCacheStatistics> before(materialDataList.size());
+        std::vector<VertexCacheStatistics> after(materialDataList.size());
+        Core::ThreadPool::GetInstance().ParallelFor(materialDataList.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                MeshOptimizer::Optimize(materialDataList[i].vertices, 8, materialDataList[i].indices, {},
+                                        &before[i], &after[i]);
+            }
+        });
+
+        // 汇总所有材质的统计
+        size_t triangles = 0, vertices = 0, transformedBefore = 0, transformedAfter = 0;
+        for (size_t i = 0; i < materialDataList.size(); ++i)
+        {
+            triangles += before[i].triangleCount;
+            vertices += before[i].vertexCount;
+            transformedBefore += before[i].transformedVertices;
+            transformedAfter += after[i].transformedVertices;
+        }
+        if (triangles == 0 || vertices == 0)
+        {
+            return;
+        }
+
+        char message[192];
+        std::snprintf(message, sizeof(message),
+                      "Mesh optimized: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f (%zu triangles, %zu vertices)",
+                      static_cast<double>(transformedBefore) / triangles, static_cast<double>(transformedAfter) / triangles,
+                      static_cast<double>(transformedBefore) / vertices, static_cast<double>(transformedAfter) / vertices,
+                      triangles, vertices);
+        Core::Logger::GetInstance().Info(message);
+    }
+
     MeshData OBJModel::GetMeshData(const std::string& objPath)
     {
         MeshData data;
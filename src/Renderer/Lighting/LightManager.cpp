@@ -2,6 +2,7 @@
 #include "Renderer/Resources/Shader.hpp"
 #include "Core/Logger.hpp"
 #include "Core/GLM.hpp"
+#include "Core/Profiler.hpp"
 #include <sstream>
 #include <shared_mutex>
 
@@ -300,6 +301,8 @@ namespace Renderer
 
         void LightManager::ApplyToShader(Shader &shader) const
         {
+            PROFILE_SCOPE("LightManager::ApplyToShader");
+
             // 使用共享锁，允许多个渲染线程并发调用
             std::shared_lock<std::shared_mutex> lock(m_mutex);
 
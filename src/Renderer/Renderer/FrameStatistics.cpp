@@ -0,0 +1,235 @@
+#include "Renderer/Renderer/FrameStatistics.hpp"
+#include "Core/Logger.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace Renderer
+{
+
+    namespace
+    {
+        // 本线程的计数器（首次计数时注册）
+        thread_local void* t_threadCounters = nullptr;
+
+        constexpr const char* kCounterNames[] = {
+            "drawCalls",
+            "instances",
+            "triangles",
+            "vertices",
+            "shaderBinds",
+            "textureBinds",
+            "vertexArrayBinds",
+            "bufferBinds",
+            "bufferBytesUploaded",
+            "textureBytesUploaded",
+            "instancesSubmitted",
+            "instancesCulled",
+        };
+        static_assert(sizeof(kCounterNames) / sizeof(kCounterNames[0]) == static_cast<size_t>(RenderCounter::Count),
+                      "every RenderCounter needs a name");
+
+        bool WriteStatsFile(const std::string& path, const std::string& content)
+        {
+            fs::path filePath(path);
+            std::error_code ec;
+            if (filePath.has_parent_path())
+            {
+                fs::create_directories(filePath.parent_path(), ec);
+            }
+            std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!out || !out.write(content.data(), static_cast<std::streamsize>(content.size())))
+            {
+                Core::Logger::GetInstance().Error("Failed to write render statistics: " + path);
+                return false;
+            }
+            return true;
+        }
+
+    } // namespace
+
+    FrameStatistics::FrameStatistics()
+        : m_history(kDefaultHistorySize)
+    {
+    }
+
+    FrameStatistics& FrameStatistics::GetInstance()
+    {
+        static FrameStatistics instance;
+        return instance;
+    }
+
+    FrameStatistics::ThreadCounters& FrameStatistics::GetThreadCounters()
+    {
+        if (t_threadCounters == nullptr)
+        {
+            FrameStatistics& stats = GetInstance();
+            std::lock_guard<std::mutex> lock(stats.m_mutex);
+            stats.m_threads.push_back(std::make_unique<ThreadCounters>());
+            t_threadCounters = stats.m_threads.back().get();
+        }
+        return *static_cast<ThreadCounters*>(t_threadCounters);
+    }
+
+    void FrameStatistics::Add(RenderCounter counter, uint64_t value)
+    {
+        // 单写者：普通的读 + 写即可，不需要原子读改写
+        std::atomic<uint64_t>& slot = GetThreadCounters().values[static_cast<size_t>(counter)];
+        slot.store(slot.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    void FrameStatistics::RecordDraw(uint64_t instances, uint64_t triangles, uint64_t vertices)
+    {
+        ThreadCounters& counters = GetThreadCounters();
+        auto add = [&counters](RenderCounter counter, uint64_t value)
+        {
+            std::atomic<uint64_t>& slot = counters.values[static_cast<size_t>(counter)];
+            slot.store(slot.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        };
+        add(RenderCounter::DrawCalls, 1);
+        add(RenderCounter::Instances, instances);
+        add(RenderCounter::Triangles, triangles);
+        add(RenderCounter::Vertices, vertices);
+    }
+
+    void FrameStatistics::EndFrame(double frameTimeMs)
+    {
+        FrameStats frame;
+        frame.frameTimeMs = frameTimeMs;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& thread : m_threads)
+        {
+            for (size_t i = 0; i < kCounterCount; ++i)
+            {
+                uint64_t value = thread->values[i].load(std::memory_order_relaxed);
+                frame.counters[i] += value - thread->lastValues[i];
+                thread->lastValues[i] = value;
+            }
+        }
+
+        frame.frameIndex = m_frameIndex++;
+        if (m_history.empty())
+        {
+            return;
+        }
+        if (m_historyCount < m_history.size())
+        {
+            m_history[(m_historyStart + m_historyCount) % m_history.size()] = frame;
+            ++m_historyCount;
+        }
+        else
+        {
+            m_history[m_historyStart] = frame;
+            m_historyStart = (m_historyStart + 1) % m_history.size();
+        }
+    }
+
+    void FrameStatistics::SetHistorySize(size_t frames)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_history.assign(frames, FrameStats());
+        m_historyStart = 0;
+        m_historyCount = 0;
+    }
+
+    FrameStats FrameStatistics::GetLastFrame() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_historyCount == 0)
+        {
+            return FrameStats();
+        }
+        return m_history[(m_historyStart + m_historyCount - 1) % m_history.size()];
+    }
+
+    std::vector<FrameStats> FrameStatistics::GetHistory(size_t maxFrames) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t count = std::min(maxFrames, m_historyCount);
+        std::vector<FrameStats> frames;
+        frames.reserve(count);
+        for (size_t i = m_historyCount - count; i < m_historyCount; ++i)
+        {
+            frames.push_back(m_history[(m_historyStart + i) % m_history.size()]);
+        }
+        return frames;
+    }
+
+    const char* FrameStatistics::GetCounterName(RenderCounter counter)
+    {
+        size_t index = static_cast<size_t>(counter);
+        return index < kCounterCount ? kCounterNames[index] : "unknown";
+    }
+
+    bool FrameStatistics::ExportCSV(const std::string& path) const
+    {
+        std::vector<FrameStats> frames = GetHistory();
+
+        std::string csv = "frame,frameTimeMs";
+        for (size_t i = 0; i < kCounterCount; ++i)
+        {
+            csv += ',';
+            csv += kCounterNames[i];
+        }
+        csv += '\n';
+
+        char number[64];
+        for (const FrameStats& frame : frames)
+        {
+            std::snprintf(number, sizeof(number), "%llu,%.3f", static_cast<unsigned long long>(frame.frameIndex),
+                          frame.frameTimeMs);
+            csv += number;
+            for (size_t i = 0; i < kCounterCount; ++i)
+            {
+                std::snprintf(number, sizeof(number), ",%llu", static_cast<unsigned long long>(frame.counters[i]));
+                csv += number;
+            }
+            csv += '\n';
+        }
+
+        if (!WriteStatsFile(path, csv))
+        {
+            return false;
+        }
+        Core::Logger::GetInstance().Info("Render statistics exported: " + path + " (" + std::to_string(frames.size()) +
+                                         " frames)");
+        return true;
+    }
+
+    bool FrameStatistics::ExportJSON(const std::string& path) const
+    {
+        std::vector<FrameStats> frames = GetHistory();
+
+        std::string json = "{\"frames\":[";
+        char number[64];
+        for (size_t f = 0; f < frames.size(); ++f)
+        {
+            const FrameStats& frame = frames[f];
+            std::snprintf(number, sizeof(number), "%s\n{\"frame\":%llu,\"frameTimeMs\":%.3f", f == 0 ? "" : ",",
+                          static_cast<unsigned long long>(frame.frameIndex), frame.frameTimeMs);
+            json += number;
+            for (size_t i = 0; i < kCounterCount; ++i)
+            {
+                json += ",\"";
+                json += kCounterNames[i];
+                std::snprintf(number, sizeof(number), "\":%llu", static_cast<unsigned long long>(frame.counters[i]));
+                json += number;
+            }
+            json += '}';
+        }
+        json += "\n]}\n";
+
+        if (!WriteStatsFile(path, json))
+        {
+            return false;
+        }
+        Core::Logger::GetInstance().Info("Render statistics exported: " + path + " (" + std::to_string(frames.size()) +
+                                         " frames)");
+        return true;
+    }
+
+} // namespace Renderer
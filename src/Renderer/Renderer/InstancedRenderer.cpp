@@ -1,9 +1,15 @@
 #include "Renderer/Renderer/InstancedRenderer.hpp"
+#include "Renderer/Renderer/FrameStatistics.hpp"
 #include "Renderer/Data/MeshBuffer.hpp"
 #include "Renderer/Factory/MeshDataFactory.hpp"
 #include "Renderer/Geometry/OBJModel.hpp"
+#include "Renderer/Resources/TextureUnits.hpp"
+#include "Renderer/Resources/AssetRegistry.hpp"
 #include "Core/Logger.hpp"
+#include "Core/Profiler.hpp"
 #include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
 #include <cstring>  // for std::memcpy
 
 namespace Renderer
@@ -16,14 +22,28 @@ namespace Renderer
         : m_meshBuffer(std::move(other.m_meshBuffer)),
           m_instances(std::move(other.m_instances)),
           m_instanceCount(other.m_instanceCount),
+          m_vaos(std::move(other.m_vaos)),
           m_instanceVBO(other.m_instanceVBO),
           m_texture(std::move(other.m_texture)),
-          m_materialColor(other.m_materialColor)
+          m_textureArray(std::move(other.m_textureArray)),
+          m_materialColor(other.m_materialColor),
+          m_materialIndex(other.m_materialIndex),
+          m_lodMeshes(std::move(other.m_lodMeshes)),
+          m_lodThresholds(std::move(other.m_lodThresholds)),
+          m_lodOrder(std::move(other.m_lodOrder)),
+          m_lodOffsets(std::move(other.m_lodOffsets)),
+          m_boundingRadius(other.m_boundingRadius),
+          m_meshletCullers(std::move(other.m_meshletCullers)),
+          m_meshletCullConfig(other.m_meshletCullConfig),
+          m_meshletCullingEnabled(other.m_meshletCullingEnabled),
+          m_meshletCullValid(other.m_meshletCullValid)
     {
         // 将源对象的OpenGL资源ID置零，避免析构时重复释放
+        other.m_vaos.clear();
         other.m_instanceVBO = 0;
         other.m_instanceCount = 0;
         other.m_materialColor = glm::vec3(1.0f);
+        other.m_meshletCullValid = false;
     }
 
     // 移动赋值运算符
@@ -31,7 +51,8 @@ namespace Renderer
     {
         if (this != &other)
         {
-            // 1. 释放当前对象的OpenGL资源（instanceVBO）
+            // 1. 释放当前对象的OpenGL资源（VAO、instanceVBO）
+            ReleaseVertexArrays();
             if (m_instanceVBO)
             {
                 glDeleteBuffers(1, &m_instanceVBO);
@@ -42,21 +63,36 @@ namespace Renderer
             m_meshBuffer = std::move(other.m_meshBuffer);
             m_instances = std::move(other.m_instances);
             m_instanceCount = other.m_instanceCount;
+            m_vaos = std::move(other.m_vaos);
             m_instanceVBO = other.m_instanceVBO;
             m_texture = std::move(other.m_texture);
+            m_textureArray = std::move(other.m_textureArray);
             m_materialColor = other.m_materialColor;
+            m_materialIndex = other.m_materialIndex;
+            m_lodMeshes = std::move(other.m_lodMeshes);
+            m_lodThresholds = std::move(other.m_lodThresholds);
+            m_lodOrder = std::move(other.m_lodOrder);
+            m_lodOffsets = std::move(other.m_lodOffsets);
+            m_boundingRadius = other.m_boundingRadius;
+            m_meshletCullers = std::move(other.m_meshletCullers);
+            m_meshletCullConfig = other.m_meshletCullConfig;
+            m_meshletCullingEnabled = other.m_meshletCullingEnabled;
+            m_meshletCullValid = other.m_meshletCullValid;
 
             // 3. 将源对象置为有效但空的状态
+            other.m_vaos.clear();
             other.m_instanceVBO = 0;
             other.m_instanceCount = 0;
             other.m_materialColor = glm::vec3(1.0f);
+            other.m_meshletCullValid = false;
         }
         return *this;
     }
 
     InstancedRenderer::~InstancedRenderer()
     {
-        // ✅ 修复：只清理实例化VBO，VAO由MeshBuffer管理
+        // 自有 VAO 和实例化 VBO；网格的 VBO/EBO 由 MeshBuffer 管理
+        ReleaseVertexArrays();
         if (m_instanceVBO)
         {
             glDeleteBuffers(1, &m_instanceVBO);
@@ -66,6 +102,15 @@ namespace Renderer
         // 注意：网格缓冲区（含VAO）和纹理由 shared_ptr 自动管理，无需手动删除
     }
 
+    void InstancedRenderer::ReleaseVertexArrays()
+    {
+        if (!m_vaos.empty())
+        {
+            glDeleteVertexArrays(static_cast<GLsizei>(m_vaos.size()), m_vaos.data());
+            m_vaos.clear();
+        }
+    }
+
     void InstancedRenderer::SetMesh(std::shared_ptr<MeshBuffer> meshBuffer)
     {
         m_meshBuffer = meshBuffer;
@@ -82,65 +127,273 @@ namespace Renderer
         m_instanceCount = data ? data->GetCount() : 0;
     }
 
+    void InstancedRenderer::SetLODMeshes(const std::vector<std::shared_ptr<MeshBuffer>> &lods,
+                                         const std::vector<float> &minScreenPixels)
+    {
+        if (lods.empty() || !lods[0])
+        {
+            Core::Logger::GetInstance().Error("InstancedRenderer::SetLODMeshes() - LOD0 mesh is required!");
+            return;
+        }
+
+        SetMesh(lods[0]);
+        m_lodMeshes = lods;
+        m_lodThresholds = minScreenPixels.empty() ? DefaultLODThresholds(lods.size()) : minScreenPixels;
+        m_boundingRadius = lods[0]->GetData().ComputeBoundingRadius();
+    }
+
+    std::vector<float> InstancedRenderer::DefaultLODThresholds(size_t levelCount)
+    {
+        std::vector<float> thresholds;
+        float pixels = 256.0f;
+        for (size_t level = 0; level + 1 < levelCount; ++level)
+        {
+            thresholds.push_back(pixels);
+            pixels *= 0.5f;
+        }
+        return thresholds;
+    }
+
+    std::vector<size_t> InstancedRenderer::GetLODInstanceCounts() const
+    {
+        std::vector<size_t> counts;
+        if (m_lodOffsets.size() < 2)
+        {
+            counts.push_back(m_instanceCount);
+            return counts;
+        }
+        for (size_t level = 0; level + 1 < m_lodOffsets.size(); ++level)
+        {
+            counts.push_back(m_lodOffsets[level + 1] - m_lodOffsets[level]);
+        }
+        return counts;
+    }
+
+    void InstancedRenderer::UpdateLOD(const ::Core::Camera &camera, float viewportHeight)
+    {
+        if (m_lodMeshes.size() <= 1 || !m_instances || m_instanceVBO == 0)
+        {
+            return;
+        }
+
+        const auto &matrices = m_instances->GetModelMatrices();
+        const size_t count = std::min(m_instanceCount, matrices.size());
+        const size_t levelCount = m_lodMeshes.size();
+        const float tanHalfFov = std::tan(glm::radians(camera.GetFOV()) * 0.5f);
+        const float pixelsPerUnitAtOne = viewportHeight / (2.0f * std::max(tanHalfFov, 1e-4f));
+        const glm::vec3 &cameraPos = camera.GetPosition();
+        const glm::vec3 &cameraFront = camera.GetFront();
+
+        // 1. 每个实例的 LOD 级别（与 TextureStreamer 相同的包围球投影估算）
+        std::vector<uint8_t> instanceLevels(count);
+        std::vector<size_t> offsets(levelCount + 1, 0);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const glm::mat4 &model = matrices[i];
+            glm::vec3 center = glm::vec3(model[3]);
+            float scale = std::max({glm::length(glm::vec3(model[0])),
+                                    glm::length(glm::vec3(model[1])),
+                                    glm::length(glm::vec3(model[2]))});
+            float radius = m_boundingRadius * scale;
+
+            size_t level = levelCount - 1;
+            glm::vec3 toCenter = center - cameraPos;
+            if (glm::dot(toCenter, cameraFront) >= -radius)  // 完全在摄像机后方的实例使用最低级别
+            {
+                float distance = std::max(glm::length(toCenter) - radius, 0.1f);
+                float pixels = 2.0f * radius * pixelsPerUnitAtOne / distance;
+                for (size_t k = 0; k < m_lodThresholds.size() && k + 1 < levelCount; ++k)
+                {
+                    if (pixels >= m_lodThresholds[k])
+                    {
+                        level = k;
+                        break;
+                    }
+                }
+            }
+            instanceLevels[i] = static_cast<uint8_t>(level);
+            ++offsets[level + 1];
+        }
+
+        // 2. 计数排序：同一级别的实例在缓冲区中连续，级别内保持原顺序
+        for (size_t level = 0; level < levelCount; ++level)
+        {
+            offsets[level + 1] += offsets[level];
+        }
+        std::vector<unsigned int> order(count);
+        std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < count; ++i)
+        {
+            order[cursor[instanceLevels[i]]++] = static_cast<unsigned int>(i);
+        }
+
+        // 3. 顺序不变时无需上传（实例数据本身的变化由 UpdateInstanceData 负责）
+        if (order == m_lodOrder)
+        {
+            return;
+        }
+        const bool offsetsChanged = offsets != m_lodOffsets;
+        m_lodOrder = std::move(order);
+        m_lodOffsets = std::move(offsets);
+
+        UploadInstanceData();
+        if (offsetsChanged)
+        {
+            for (size_t level = 0; level < levelCount; ++level)
+            {
+                SetupInstanceAttributes(m_vaos[level], m_lodOffsets[level]);
+            }
+            glBindVertexArray(0);
+        }
+    }
+
+    const MeshBuffer &InstancedRenderer::GetLevelMesh(size_t level) const
+    {
+        return m_lodMeshes.size() > 1 ? *m_lodMeshes[level] : *m_meshBuffer;
+    }
+
+    void InstancedRenderer::BuildMeshletCullers()
+    {
+        m_meshletCullers.clear();
+        m_meshletCullValid = false;
+        for (size_t level = 0; level < GetLODCount(); ++level)
+        {
+            m_meshletCullers.emplace_back(m_meshletCullConfig);
+            m_meshletCullers.back().SetMeshlets(GetLevelMesh(level).GetData().GetMeshlets());
+        }
+    }
+
+    void InstancedRenderer::SetMeshletCullConfig(const MeshletCullConfig &config)
+    {
+        m_meshletCullConfig = config;
+        for (auto &culler : m_meshletCullers)
+        {
+            culler.SetConfig(config);
+        }
+    }
+
+    void InstancedRenderer::SetMeshletCullingEnabled(bool enabled)
+    {
+        m_meshletCullingEnabled = enabled;
+        if (!enabled)
+        {
+            m_meshletCullValid = false;
+        }
+    }
+
+    bool InstancedRenderer::HasMeshletCulling() const
+    {
+        for (const auto &culler : m_meshletCullers)
+        {
+            if (!culler.IsEmpty())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    MeshletCullStats InstancedRenderer::GetMeshletCullStats() const
+    {
+        MeshletCullStats stats;
+        if (m_meshletCullValid)
+        {
+            for (const auto &culler : m_meshletCullers)
+            {
+                stats.Accumulate(culler.GetStats());
+            }
+        }
+        return stats;
+    }
+
+    void InstancedRenderer::UpdateCulling(const glm::mat4 &viewProjection, const glm::vec3 &cameraPos)
+    {
+        m_meshletCullValid = false;
+        if (!m_meshletCullingEnabled || !m_instances || m_instanceVBO == 0 || !HasMeshletCulling())
+        {
+            return;
+        }
+
+        const auto &matrices = m_instances->GetModelMatrices();
+        const size_t count = std::min(m_instanceCount, matrices.size());
+        const bool lodActive = m_lodMeshes.size() > 1 && m_lodOffsets.size() == m_lodMeshes.size() + 1;
+
+        // 每级只考虑该级子流中的实例（可见簇取并集）
+        for (size_t level = 0; level < m_meshletCullers.size(); ++level)
+        {
+            MeshletCuller &culler = m_meshletCullers[level];
+            if (culler.IsEmpty())
+            {
+                continue;
+            }
+            size_t first = lodActive ? std::min(m_lodOffsets[level], count) : 0;
+            size_t last = lodActive ? std::min(m_lodOffsets[level + 1], count) : count;
+            const unsigned int *order = m_lodOrder.size() == matrices.size() ? m_lodOrder.data() + first : nullptr;
+            const glm::mat4 *models = order ? matrices.data() : matrices.data() + first;
+            culler.Cull(GetLevelMesh(level), viewProjection, cameraPos, models, order, last - first);
+        }
+        m_meshletCullValid = true;
+    }
+
     void InstancedRenderer::Initialize()
     {
         // 网格缓冲区必须已经上传到 GPU
         if (!m_meshBuffer || m_meshBuffer->GetVAO() == 0)
         {
-            Core::Logger::GetInstance().Error("InstancedRenderer::Initialize() - MeshBuffer not uploaded to GPU! Call meshBuffer.UploadToGPU() first.");
+            LOG_ERROR("InstancedRenderer::Initialize() - MeshBuffer not uploaded to GPU! Call meshBuffer.UploadToGPU() first.");
             return;
         }
 
         if (!m_instances || m_instances->IsEmpty())
         {
-            Core::Logger::GetInstance().Error("InstancedRenderer::Initialize() - No instances set!");
+            LOG_ERROR("InstancedRenderer::Initialize() - No instances set!");
             return;
         }
 
         // ✅ 修复：检查是否已经初始化，避免VBO泄漏
         if (m_instanceVBO != 0)
         {
-            Core::Logger::GetInstance().Warning("InstancedRenderer::Initialize() - Already initialized, cleaning up old instance VBO.");
+            LOG_WARNING("InstancedRenderer::Initialize() - Already initialized, cleaning up old instance VBO.");
             glDeleteBuffers(1, &m_instanceVBO);
             m_instanceVBO = 0;
         }
+        ReleaseVertexArrays();
 
-        // ✅ 修复：不再创建独立VAO，直接使用MeshBuffer的VAO
         // 创建实例化 VBO（用于存储实例矩阵和颜色）
         glGenBuffers(1, &m_instanceVBO);
 
         // 上传实例数据
         UploadInstanceData();
 
-        // ✅ 修复：直接在MeshBuffer的VAO上配置实例属性
-        GLuint meshVAO = m_meshBuffer->GetVAO();
-        glBindVertexArray(meshVAO);
-
-        // 设置实例属性（从instanceVBO）
-        glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+        // ⭐ 每个级别一个自有 VAO：共享网格的 VBO/EBO，实例属性只影响本渲染器
+        for (size_t level = 0; level < GetLODCount(); ++level)
+        {
+            m_vaos.push_back(GetLevelMesh(level).CreateVertexArray());
+        }
+        GLuint meshVAO = m_vaos[0];
+        SetupInstanceAttributes(meshVAO, 0);
 
-        // 设置实例矩阵属性 (location 3, 4, 5, 6)
-        for (size_t i = 0; i < 4; ++i)
+        // LOD：首次 UpdateLOD 之前所有实例都使用 LOD0，其余级别的子流为空
+        m_lodOrder.clear();
+        m_lodOffsets.clear();
+        if (m_lodMeshes.size() > 1)
         {
-            glEnableVertexAttribArray(3 + i);
-            glVertexAttribPointer(3 + i, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void *)(i * sizeof(glm::vec4)));
-            glVertexAttribDivisor(3 + i, 1); // 每个实例更新一次
+            m_lodOffsets.assign(m_lodMeshes.size() + 1, m_instanceCount);
+            m_lodOffsets[0] = 0;
+            for (size_t level = 1; level < m_lodMeshes.size(); ++level)
+            {
+                SetupInstanceAttributes(m_vaos[level], m_instanceCount);
+            }
         }
 
-        // 设置实例颜色属性 (location 7)
-        size_t matrixDataSize = m_instances->GetModelMatrices().size() * sizeof(glm::mat4);
-        glEnableVertexAttribArray(7);
-        glVertexAttribPointer(7, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void *)matrixDataSize);
-        glVertexAttribDivisor(7, 1); // 每个实例更新一次
+        // 逐簇剔除器（网格没有簇时为空，不影响绘制）
+        BuildMeshletCullers();
 
         glBindBuffer(GL_ARRAY_BUFFER, 0);
         glBindVertexArray(0);
 
-        Core::Logger::GetInstance().Info("InstancedRenderer::Initialize() - Initialized with " +
-                                         std::to_string(m_instanceCount) + " instances" +
-                                         ", MeshBuffer VAO: " + std::to_string(meshVAO) +
-                                         ", instanceVBO: " + std::to_string(m_instanceVBO) +
-                                         ", instancesPtr: " + std::to_string(reinterpret_cast<uintptr_t>(m_instances.get())));
+        LOG_INFO("InstancedRenderer::Initialize() - Initialized with {} instances, VAO: {}, instanceVBO: {}, instancesPtr: {}",
+                 m_instanceCount, meshVAO, m_instanceVBO, static_cast<const void *>(m_instances.get()));
     }
 
     void InstancedRenderer::UploadInstanceData()
@@ -161,6 +414,7 @@ namespace Renderer
                      buffer.data(),
                      GL_DYNAMIC_DRAW);
         glBindBuffer(GL_ARRAY_BUFFER, 0);
+        RENDER_STATS_ADD(BufferBytesUploaded, buffer.size() * sizeof(float));
     }
 
     std::vector<float> InstancedRenderer::PrepareInstanceBuffer() const
@@ -177,6 +431,19 @@ namespace Renderer
         std::vector<float> buffer;
         buffer.resize(totalFloatCount);  // 只分配一次
 
+        // LOD 分桶后按实例子流顺序收集
+        if (!m_lodOrder.empty() && m_lodOrder.size() == matrices.size() && colors.size() == matrices.size())
+        {
+            glm::mat4 *matrixOut = reinterpret_cast<glm::mat4 *>(buffer.data());
+            glm::vec3 *colorOut = reinterpret_cast<glm::vec3 *>(buffer.data() + matrixFloatCount);
+            for (size_t i = 0; i < m_lodOrder.size(); ++i)
+            {
+                matrixOut[i] = matrices[m_lodOrder[i]];
+                colorOut[i] = colors[m_lodOrder[i]];
+            }
+            return buffer;
+        }
+
         // ✅ 性能优化：批量复制矩阵（编译器自动优化为 AVX/AVX2/AVX-512）
         std::memcpy(buffer.data(), matrices.data(), matrices.size() * sizeof(glm::mat4));
 
@@ -193,7 +460,7 @@ namespace Renderer
     {
         if (!m_instanceVBO)
         {
-            Core::Logger::GetInstance().Error("InstancedRenderer::UpdateInstanceData() - Instance VBO not created!");
+            // 网格尚未到达（AssetLoader 异步加载）：静默跳过，Initialize() 时上传完整实例数据
             return;
         }
 
@@ -209,6 +476,8 @@ namespace Renderer
             return;  // 数据未变化，跳过 GPU 更新
         }
 
+        PROFILE_SCOPE("InstancedRenderer::UpdateInstanceData");
+
         // 准备缓冲区数据
         std::vector<float> buffer = PrepareInstanceBuffer();
 
@@ -219,6 +488,7 @@ namespace Renderer
                         buffer.size() * sizeof(float),
                         buffer.data());
         glBindBuffer(GL_ARRAY_BUFFER, 0);
+        RENDER_STATS_ADD(BufferBytesUploaded, buffer.size() * sizeof(float));
 
         // ❌ BUG 修复（2026-01-02）：不要在这里清除脏标记！
         // 当多个 renderer 共享同一个 instanceData 时（例如多材质 OBJ 模型），
@@ -229,12 +499,13 @@ namespace Renderer
 
     void InstancedRenderer::Render() const
     {
-        // ✅ 修复：检查MeshBuffer的VAO（而不是已删除的m_vao）
-        if (!m_meshBuffer || m_meshBuffer->GetVAO() == 0)
+        if (!m_meshBuffer || m_vaos.empty())
         {
             return; // 静默失败，避免每帧日志
         }
 
+        PROFILE_SCOPE("InstancedRenderer::Render");
+
         if (!m_instances || m_instances->IsEmpty())
         {
             return; // 静默失败，避免每帧日志
@@ -247,25 +518,52 @@ namespace Renderer
             m_texture->Bind(GL_TEXTURE1);
         }
 
-        // ✅ 修复：绑定MeshBuffer的VAO（而不是独立的m_vao）
-        GLuint meshVAO = m_meshBuffer->GetVAO();
-        glBindVertexArray(meshVAO);
+        // ⭐ 纹理数组使用纹理单元6（TextureUnit::MATERIAL_DIFFUSE_ARRAY）
+        if (m_textureArray)
+        {
+            m_textureArray->Bind(GL_TEXTURE0 + static_cast<int>(TextureUnit::MATERIAL_DIFFUSE_ARRAY));
+        }
+
+        // ⭐ 每次绘制的材质索引：未启用的属性数组读取当前常量值（location 9）
+        if (m_materialIndex >= 0)
+        {
+            glVertexAttrib1f(9, static_cast<float>(m_materialIndex));
+        }
 
-        // 执行实例化渲染
-        if (m_meshBuffer->HasIndices())
+        // 执行实例化渲染：启用 LOD 时每级一次绘制（空子流跳过）
+        // 整级的簇都被剔除时该级实例计为剔除（三角形 / 绘制调用数在 DrawMesh 中统计）
+        size_t culledInstances = 0;
+        if (m_lodOffsets.size() == m_lodMeshes.size() + 1 && m_lodMeshes.size() > 1)
         {
-            glDrawElementsInstanced(GL_TRIANGLES,
-                                    static_cast<GLsizei>(m_meshBuffer->GetIndexCount()),
-                                    GL_UNSIGNED_INT,
-                                    0,
-                                    static_cast<GLsizei>(m_instanceCount));
+            for (size_t level = 0; level < m_lodMeshes.size(); ++level)
+            {
+                size_t count = m_lodOffsets[level + 1] - m_lodOffsets[level];
+                if (count == 0)
+                {
+                    continue;
+                }
+                const MeshBuffer &mesh = *m_lodMeshes[level];
+                const auto &ranges = GetDrawRanges(level, mesh);
+                if (ranges.empty() && mesh.HasIndices())
+                {
+                    culledInstances += count;
+                    continue; // 整级的簇都被剔除
+                }
+                glBindVertexArray(m_vaos[level]);
+                RENDER_STATS_ADD(VertexArrayBinds, 1);
+                DrawMesh(mesh, ranges, static_cast<GLsizei>(count));
+            }
         }
         else
         {
-            glDrawArraysInstanced(GL_TRIANGLES,
-                                  0,
-                                  static_cast<GLsizei>(m_meshBuffer->GetVertexCount()),
-                                  static_cast<GLsizei>(m_instanceCount));
+            const auto &ranges = GetDrawRanges(0, *m_meshBuffer);
+            if (ranges.empty() && m_meshBuffer->HasIndices())
+            {
+                culledInstances = m_instanceCount;
+            }
+            glBindVertexArray(m_vaos[0]);
+            RENDER_STATS_ADD(VertexArrayBinds, 1);
+            DrawMesh(*m_meshBuffer, ranges, static_cast<GLsizei>(m_instanceCount));
         }
 
         glBindVertexArray(0);
@@ -275,14 +573,96 @@ namespace Renderer
         {
             Texture::UnbindStatic();
         }
+        if (m_textureArray)
+        {
+            glActiveTexture(GL_TEXTURE0 + static_cast<int>(TextureUnit::MATERIAL_DIFFUSE_ARRAY));
+            TextureArray::UnbindStatic();
+            glActiveTexture(GL_TEXTURE1);
+        }
 
-        // 记录绘制调用
-#if ENABLE_RENDER_STATS
-        size_t triangleCount = ((m_meshBuffer->HasIndices() ? m_meshBuffer->GetIndexCount() : m_meshBuffer->GetVertexCount()) / 3) * m_instanceCount;
-        Core::Logger::GetInstance().LogDrawCall(triangleCount);
+        RENDER_STATS_ADD(InstancesSubmitted, m_instanceCount);
+        RENDER_STATS_ADD(InstancesCulled, culledInstances);
+#if !ENABLE_RENDER_STATS
+        (void)culledInstances;
 #endif
     }
 
+    void InstancedRenderer::SetupInstanceAttributes(GLuint vao, size_t firstInstance) const
+    {
+        glBindVertexArray(vao);
+
+        // 设置实例属性（从instanceVBO）
+        glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+
+        // 设置实例矩阵属性 (location 3, 4, 5, 6)
+        // firstInstance：该 VAO 的实例子流在缓冲区中的起始实例（GL 3.3 没有 baseInstance，通过属性偏移实现）
+        size_t matrixOffset = firstInstance * sizeof(glm::mat4);
+        for (size_t i = 0; i < 4; ++i)
+        {
+            glEnableVertexAttribArray(3 + i);
+            glVertexAttribPointer(3 + i, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void *)(matrixOffset + i * sizeof(glm::vec4)));
+            glVertexAttribDivisor(3 + i, 1); // 每个实例更新一次
+        }
+
+        // 设置实例颜色属性 (location 7)
+        size_t matrixDataSize = m_instances->GetModelMatrices().size() * sizeof(glm::mat4);
+        glEnableVertexAttribArray(7);
+        glVertexAttribPointer(7, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void *)(matrixDataSize + firstInstance * sizeof(glm::vec3)));
+        glVertexAttribDivisor(7, 1); // 每个实例更新一次
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    const std::vector<IndexDrawRange> &InstancedRenderer::GetDrawRanges(size_t level, const MeshBuffer &mesh) const
+    {
+        // 有本帧剔除结果时只绘制可见簇的区间，否则绘制完整网格
+        if (m_meshletCullValid && level < m_meshletCullers.size() && !m_meshletCullers[level].IsEmpty())
+        {
+            return m_meshletCullers[level].GetDrawRanges();
+        }
+        return mesh.GetIndexRanges();
+    }
+
+    void InstancedRenderer::DrawMesh(const MeshBuffer &mesh, const std::vector<IndexDrawRange> &ranges,
+                                     GLsizei instanceCount) const
+    {
+        if (mesh.HasIndices())
+        {
+            // ⭐ 索引类型由 MeshBuffer 上传时按网格选择（8 / 16 / 32 位）
+            const GLenum indexType = mesh.GetIndexType();
+            const size_t indexSize = indexType == GL_UNSIGNED_BYTE ? 1 : (indexType == GL_UNSIGNED_SHORT ? 2 : 4);
+            for (const IndexDrawRange& range : ranges)
+            {
+                RENDER_STATS_DRAW(instanceCount, range.indexCount / 3 * instanceCount, range.indexCount * instanceCount);
+                const void* offset = reinterpret_cast<const void*>(range.firstIndex * indexSize);
+                if (range.baseVertex == 0)
+                {
+                    glDrawElementsInstanced(GL_TRIANGLES,
+                                            static_cast<GLsizei>(range.indexCount),
+                                            indexType,
+                                            offset,
+                                            instanceCount);
+                }
+                else
+                {
+                    glDrawElementsInstancedBaseVertex(GL_TRIANGLES,
+                                                      static_cast<GLsizei>(range.indexCount),
+                                                      indexType,
+                                                      offset,
+                                                      instanceCount,
+                                                      range.baseVertex);
+                }
+            }
+            return;
+        }
+
+        glDrawArraysInstanced(GL_TRIANGLES,
+                              0,
+                              static_cast<GLsizei>(mesh.GetVertexCount()),
+                              instanceCount);
+        RENDER_STATS_DRAW(instanceCount, mesh.GetVertexCount() / 3 * instanceCount, mesh.GetVertexCount() * instanceCount);
+    }
+
     // 静态方法：为 Cube 创建实例化渲染器
     InstancedRenderer InstancedRenderer::CreateForCube(const std::shared_ptr<InstanceData> &instances)
     {
@@ -298,8 +678,7 @@ namespace Renderer
         renderer.SetInstances(instances);
         renderer.Initialize();
 
-        Core::Logger::GetInstance().Info("InstancedRenderer::CreateForCube() - Created renderer for " +
-                                         std::to_string(instances->GetCount()) + " instances");
+        LOG_INFO("InstancedRenderer::CreateForCube() - Created renderer for {} instances", instances->GetCount());
 
         return renderer;
     }
@@ -312,9 +691,11 @@ namespace Renderer
             return;
         }
 
+        PROFILE_SCOPE("InstancedRenderer::RenderBatch");
+
         // ✅ 按纹理分组（使用原始指针作为key，避免shared_ptr拷贝）
-        // 使用 std::map 保持纹理顺序稳定
-        std::map<Texture*, std::vector<InstancedRenderer*>> batches;
+        // 使用 std::map 保持纹理顺序稳定；纹理数组也参与分组
+        std::map<std::pair<Texture*, TextureArray*>, std::vector<InstancedRenderer*>> batches;
 
         for (auto* renderer : renderers)
         {
@@ -324,13 +705,15 @@ namespace Renderer
             }
 
             // 获取纹理原始指针（nullptr表示无纹理）
-            Texture* textureKey = renderer->GetTexture().get();
+            std::pair<Texture*, TextureArray*> textureKey(renderer->GetTexture().get(),
+                                                          renderer->GetTextureArray().get());
             batches[textureKey].push_back(renderer);
         }
 
         // ✅ 批量渲染每个纹理组
-        for (const auto& [texturePtr, batch] : batches)
+        for (const auto& [textureKey, batch] : batches)
         {
+            Texture* texturePtr = textureKey.first;
             if (batch.empty())
             {
                 continue;
@@ -387,52 +770,121 @@ namespace Renderer
         RenderBatch(rawPointers);
     }
 
-    // 静态方法：为 OBJ 模型创建实例化渲染器（返回多个渲染器，每个材质一个）
-    std::tuple<std::vector<InstancedRenderer>, std::vector<std::shared_ptr<MeshBuffer>>, std::shared_ptr<InstanceData>>
-    InstancedRenderer::CreateForOBJ(const std::string &objPath, const std::shared_ptr<InstanceData> &instances)
+    // 静态方法：为已加载的网格资源创建渲染器（每个子网格一个）
+    std::vector<InstancedRenderer> InstancedRenderer::CreateForAsset(const MeshHandle &asset,
+                                                                     const std::shared_ptr<InstanceData> &instances,
+                                                                     const std::shared_ptr<MaterialAtlas> &atlas)
     {
         std::vector<InstancedRenderer> renderers;
-        std::vector<std::shared_ptr<MeshBuffer>> meshBuffers;
-
-        // 使用工厂创建 MeshBuffer 列表（已上传到 GPU）
-        std::vector<MeshBuffer> buffers = MeshBufferFactory::CreateOBJBuffers(objPath);
-
-        Core::Logger::GetInstance().Info("InstancedRenderer::CreateForOBJ() - Creating " +
-                                         std::to_string(buffers.size()) + " renderers from " + objPath);
-
-        renderers.reserve(buffers.size());
-        meshBuffers.reserve(buffers.size());
+        if (!asset)
+        {
+            return renderers;
+        }
 
-        // 为每个材质创建渲染器
-        for (size_t i = 0; i < buffers.size(); ++i)
+        renderers.reserve(asset->GetSubmeshCount());
+        for (size_t i = 0; i < asset->GetSubmeshCount(); ++i)
         {
-            auto meshBufferPtr = std::make_shared<MeshBuffer>(std::move(buffers[i]));
+            // 每个网格一条 LOD 链（未启用 LOD 时只有一级）
+            std::vector<std::shared_ptr<MeshBuffer>> lods = asset->GetLODs(i);
+            const std::shared_ptr<MeshBuffer> &meshBufferPtr = lods[0];
 
-            // 从MeshData中获取纹理路径（无需重新加载OBJ！）
-            const std::string &texturePath = meshBufferPtr->GetData().GetTexturePath();
+            InstancedRenderer renderer;
+            if (lods.size() > 1)
+            {
+                renderer.SetLODMeshes(lods);
+            }
+            else
+            {
+                renderer.SetMesh(meshBufferPtr);
+            }
 
-            // 如果有纹理，加载纹理
-            if (!texturePath.empty())
+            if (atlas)
             {
-                auto texture = std::make_shared<Texture>();
-                if (texture->LoadFromFile(texturePath))
+                int arrayIndex = meshBufferPtr->GetData().GetTextureArrayIndex();
+                if (arrayIndex >= 0)
                 {
-                    meshBufferPtr->SetTexture(texture);
+                    renderer.SetTextureArray(atlas->GetArray(static_cast<size_t>(arrayIndex)));
                 }
             }
+            else
+            {
+                // 从MeshData中获取纹理路径（无需重新加载OBJ！）
+                const std::string &texturePath = meshBufferPtr->GetData().GetTexturePath();
 
-            meshBuffers.push_back(meshBufferPtr);
+                // 如果有纹理，加载纹理（共享的网格只加载一次；AssetLoader 导入时已在后台解码并挂好）
+                if (!texturePath.empty() && !meshBufferPtr->HasTexture())
+                {
+                    auto texture = std::make_shared<Texture>();
+                    if (texture->LoadFromFile(texturePath))
+                    {
+                        meshBufferPtr->SetTexture(texture);
+                    }
+                }
+            }
 
-            // 创建渲染器并使用移动语义添加到 vector
-            InstancedRenderer renderer;
-            renderer.SetMesh(meshBufferPtr);
             renderer.SetInstances(instances);
             renderer.Initialize();
 
             renderers.push_back(std::move(renderer));
         }
+        return renderers;
+    }
+
+    // 静态方法：为 OBJ 模型创建实例化渲染器（返回多个渲染器，每个材质一个）
+    std::tuple<std::vector<InstancedRenderer>, std::vector<std::shared_ptr<MeshBuffer>>, std::shared_ptr<InstanceData>>
+    InstancedRenderer::CreateForOBJ(const std::string &objPath, const std::shared_ptr<InstanceData> &instances)
+    {
+        // ⭐ 通过资源注册表导入：同一 OBJ 只解析和上传一次，多个调用共享 MeshBuffer
+        MeshHandle asset = AssetRegistry::GetInstance().LoadOBJ(objPath);
+        if (!asset)
+        {
+            return std::make_tuple(std::vector<InstancedRenderer>(), std::vector<std::shared_ptr<MeshBuffer>>(),
+                                   instances);
+        }
+
+        LOG_INFO("InstancedRenderer::CreateForOBJ() - Creating {} renderers from {}", asset->GetSubmeshCount(), objPath);
 
         // 使用移动语义返回 tuple，避免拷贝
+        std::vector<InstancedRenderer> renderers = CreateForAsset(asset, instances);
+        return std::make_tuple(std::move(renderers), asset->GetMeshes(), instances);
+    }
+
+    // 静态方法：为 OBJ 模型创建纹理数组版本的渲染器（按分辨率档位合并材质）
+    std::tuple<std::vector<InstancedRenderer>, std::vector<std::shared_ptr<MeshBuffer>>, std::shared_ptr<InstanceData>>
+    InstancedRenderer::CreateForOBJAtlas(const std::string &objPath, const std::shared_ptr<InstanceData> &instances,
+                                         std::shared_ptr<MaterialAtlas> atlas,
+                                         const std::shared_ptr<MaterialTable> &materialTable,
+                                         const MeshLODConfig *lodConfig)
+    {
+        std::vector<std::shared_ptr<MeshBuffer>> meshBuffers;
+
+        // 未指定图集时使用注册表的共享图集，重复导入同一模型可以命中缓存
+        if (!atlas)
+        {
+            atlas = AssetRegistry::GetInstance().GetDefaultAtlas();
+        }
+
+        MeshHandle asset = AssetRegistry::GetInstance().LoadOBJAtlas(objPath, atlas, materialTable, lodConfig);
+        if (!asset)
+        {
+            return std::make_tuple(std::vector<InstancedRenderer>(), std::move(meshBuffers), instances);
+        }
+        atlas->Build();
+        if (materialTable)
+        {
+            materialTable->Upload();
+        }
+
+        LOG_INFO("InstancedRenderer::CreateForOBJAtlas() - Creating {} renderers from {}", asset->GetSubmeshCount(),
+                 objPath);
+
+        for (size_t i = 0; i < asset->GetSubmeshCount(); ++i)
+        {
+            std::vector<std::shared_ptr<MeshBuffer>> lods = asset->GetLODs(i);
+            meshBuffers.insert(meshBuffers.end(), lods.begin(), lods.end());
+        }
+
+        std::vector<InstancedRenderer> renderers = CreateForAsset(asset, instances, atlas);
         return std::make_tuple(std::move(renderers), std::move(meshBuffers), instances);
     }
 
@@ -0,0 +1,335 @@
+#include "Renderer/Renderer/MeshletCuller.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LUMEN_MESHLET_USE_SSE 1
+#include <emmintrin.h>
+#else
+#define LUMEN_MESHLET_USE_SSE 0
+#endif
+
+namespace Renderer
+{
+    namespace
+    {
+        // 禁用法线锥时写入的 cutoff：dot(normalize(d), axis) 永远不会 ≥ 2
+        constexpr float kDisabledConeCutoff = 2.0f;
+    } // namespace
+
+    // ========================================
+    // MeshletCullStats
+    // ========================================
+
+    void MeshletCullStats::Accumulate(const MeshletCullStats& other)
+    {
+        totalClusters += other.totalClusters;
+        visibleClusters += other.visibleClusters;
+        totalTriangles += other.totalTriangles;
+        visibleTriangles += other.visibleTriangles;
+        drawnTriangles += other.drawnTriangles;
+        drawRanges += other.drawRanges;
+    }
+
+    float MeshletCullStats::GetClusterCulledFraction() const
+    {
+        return totalClusters > 0 ? 1.0f - static_cast<float>(visibleClusters) / static_cast<float>(totalClusters)
+                                 : 0.0f;
+    }
+
+    float MeshletCullStats::GetTriangleCulledFraction() const
+    {
+        return totalTriangles > 0 ? 1.0f - static_cast<float>(visibleTriangles) / static_cast<float>(totalTriangles)
+                                  : 0.0f;
+    }
+
+    // ========================================
+    // MeshletCuller
+    // ========================================
+
+    MeshletCuller::MeshletCuller(const MeshletCullConfig& config) : m_config(config)
+    {
+    }
+
+    void MeshletCuller::SetMeshlets(const std::vector<Meshlet>& meshlets)
+    {
+        m_count = meshlets.size();
+        const size_t padded = (m_count + 3) & ~static_cast<size_t>(3);
+
+        for (std::vector<float>* soa : {&m_centerX, &m_centerY, &m_centerZ, &m_radius, &m_apexX, &m_apexY, &m_apexZ,
+                                        &m_axisX, &m_axisY, &m_axisZ})
+        {
+            soa->assign(padded, 0.0f);
+        }
+        m_cutoff.assign(padded, kDisabledConeCutoff);
+        m_firstIndex.resize(m_count);
+        m_triangleCount.resize(m_count);
+        m_visible.assign(padded, 0);
+        m_ranges.clear();
+        m_stats = MeshletCullStats();
+
+        for (size_t i = 0; i < m_count; ++i)
+        {
+            const Meshlet& meshlet = meshlets[i];
+            m_centerX[i] = meshlet.center.x;
+            m_centerY[i] = meshlet.center.y;
+            m_centerZ[i] = meshlet.center.z;
+            m_radius[i] = meshlet.radius;
+            m_apexX[i] = meshlet.coneApex.x;
+            m_apexY[i] = meshlet.coneApex.y;
+            m_apexZ[i] = meshlet.coneApex.z;
+            m_axisX[i] = meshlet.coneAxis.x;
+            m_axisY[i] = meshlet.coneAxis.y;
+            m_axisZ[i] = meshlet.coneAxis.z;
+            m_cutoff[i] = meshlet.coneCutoff < 1.0f ? meshlet.coneCutoff : kDisabledConeCutoff;
+            m_firstIndex[i] = meshlet.firstIndex;
+            m_triangleCount[i] = meshlet.triangleCount;
+        }
+    }
+
+    void MeshletCuller::ExtractFrustumPlanes(const glm::mat4& viewProjection, glm::vec4 planes[6])
+    {
+        // Gribb-Hartmann：clip = VP * p，平面为第 4 行 ± 第 1/2/3 行
+        auto row = [&](int r) {
+            return glm::vec4(viewProjection[0][r], viewProjection[1][r], viewProjection[2][r], viewProjection[3][r]);
+        };
+        const glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+        planes[0] = r3 + r0; // 左
+        planes[1] = r3 - r0; // 右
+        planes[2] = r3 + r1; // 下
+        planes[3] = r3 - r1; // 上
+        planes[4] = r3 + r2; // 近
+        planes[5] = r3 - r2; // 远
+        for (int i = 0; i < 6; ++i)
+        {
+            float length = glm::length(glm::vec3(planes[i]));
+            if (length > 0.0f)
+            {
+                planes[i] = planes[i] / length;
+            }
+        }
+    }
+
+    void MeshletCuller::Cull(const MeshBuffer& mesh, const glm::mat4& viewProjection, const glm::vec3& cameraPos,
+                             const glm::mat4* models, const unsigned int* order, size_t count)
+    {
+        m_ranges.clear();
+        m_stats = MeshletCullStats();
+        m_stats.totalClusters = m_count;
+        for (size_t i = 0; i < m_count; ++i)
+        {
+            m_stats.totalTriangles += m_triangleCount[i];
+        }
+
+        if (m_count == 0 || count == 0)
+        {
+            return;
+        }
+
+        // 实例过多时并集几乎总是全部可见，剔除只会浪费 CPU
+        if (count > m_config.maxInstances || (!m_config.frustumCulling && !m_config.backfaceCulling))
+        {
+            m_ranges = mesh.GetIndexRanges();
+            m_stats.visibleClusters = m_count;
+            m_stats.visibleTriangles = m_stats.totalTriangles;
+            m_stats.drawnTriangles = mesh.GetIndexCount() / 3;
+            m_stats.drawRanges = m_ranges.size();
+            return;
+        }
+
+        glm::vec4 planes[6];
+        ExtractFrustumPlanes(viewProjection, planes);
+
+        std::fill(m_visible.begin(), m_visible.end(), static_cast<uint8_t>(0));
+        for (size_t i = 0; i < count; ++i)
+        {
+            CullInstance(planes, cameraPos, models[order ? order[i] : i]);
+        }
+
+        BuildDrawRanges(mesh);
+    }
+
+    void MeshletCuller::CullInstance(const glm::vec4 planes[6], const glm::vec3& cameraPos, const glm::mat4& model)
+    {
+        // 平面变换到模型空间：dot(P, M * q) = dot(Mᵀ * P, q)
+        glm::vec4 localPlanes[6];
+        for (int p = 0; p < 6; ++p)
+        {
+            localPlanes[p] = glm::vec4(glm::dot(model[0], planes[p]), glm::dot(model[1], planes[p]),
+                                       glm::dot(model[2], planes[p]), glm::dot(model[3], planes[p]));
+        }
+
+        const glm::vec3 axisX(model[0]), axisY(model[1]), axisZ(model[2]);
+        const float scaleX = glm::length(axisX), scaleY = glm::length(axisY), scaleZ = glm::length(axisZ);
+        const float maxScale = std::max(scaleX, std::max(scaleY, scaleZ));
+
+        // 法线锥在模型空间测试，要求变换保角（均匀缩放 + 旋转、无镜像）
+        bool coneTest = m_config.backfaceCulling && maxScale > 0.0f;
+        glm::vec3 localCamera(0.0f);
+        if (coneTest)
+        {
+            const float tolerance = 0.01f * maxScale;
+            const float orthoTolerance = 0.01f * maxScale * maxScale;
+            coneTest = std::abs(scaleX - scaleY) <= tolerance && std::abs(scaleX - scaleZ) <= tolerance &&
+                       std::abs(glm::dot(axisX, axisY)) <= orthoTolerance &&
+                       std::abs(glm::dot(axisX, axisZ)) <= orthoTolerance &&
+                       std::abs(glm::dot(axisY, axisZ)) <= orthoTolerance &&
+                       glm::dot(glm::cross(axisX, axisY), axisZ) > 0.0f;
+            if (coneTest)
+            {
+                // M = [sR | t] ⇒ M⁻¹p = Rᵀ(p - t) / s = M₃ᵀ(p - t) / s²
+                const glm::vec3 d = cameraPos - glm::vec3(model[3]);
+                const float invScaleSq = 1.0f / (scaleX * scaleX);
+                localCamera = glm::vec3(glm::dot(axisX, d), glm::dot(axisY, d), glm::dot(axisZ, d)) * invScaleSq;
+            }
+        }
+        const bool frustumTest = m_config.frustumCulling;
+        const size_t padded = m_visible.size();
+
+#if LUMEN_MESHLET_USE_SSE
+        const __m128 scale = _mm_set1_ps(maxScale);
+        const __m128 camX = _mm_set1_ps(localCamera.x);
+        const __m128 camY = _mm_set1_ps(localCamera.y);
+        const __m128 camZ = _mm_set1_ps(localCamera.z);
+        __m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+        for (int p = 0; p < 6; ++p)
+        {
+            planeX[p] = _mm_set1_ps(localPlanes[p].x);
+            planeY[p] = _mm_set1_ps(localPlanes[p].y);
+            planeZ[p] = _mm_set1_ps(localPlanes[p].z);
+            planeW[p] = _mm_set1_ps(localPlanes[p].w);
+        }
+
+        for (size_t i = 0; i < padded; i += 4)
+        {
+            __m128 culled = _mm_setzero_ps();
+            if (frustumTest)
+            {
+                const __m128 cx = _mm_loadu_ps(&m_centerX[i]);
+                const __m128 cy = _mm_loadu_ps(&m_centerY[i]);
+                const __m128 cz = _mm_loadu_ps(&m_centerZ[i]);
+                const __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(_mm_loadu_ps(&m_radius[i]), scale));
+                for (int p = 0; p < 6; ++p)
+                {
+                    __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[p], cx), _mm_mul_ps(planeY[p], cy)),
+                                          _mm_add_ps(_mm_mul_ps(planeZ[p], cz), planeW[p]));
+                    culled = _mm_or_ps(culled, _mm_cmplt_ps(d, negRadius));
+                }
+            }
+            if (coneTest)
+            {
+                const __m128 dx = _mm_sub_ps(_mm_loadu_ps(&m_apexX[i]), camX);
+                const __m128 dy = _mm_sub_ps(_mm_loadu_ps(&m_apexY[i]), camY);
+                const __m128 dz = _mm_sub_ps(_mm_loadu_ps(&m_apexZ[i]), camZ);
+                const __m128 length =
+                    _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+                const __m128 projected =
+                    _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, _mm_loadu_ps(&m_axisX[i])), _mm_mul_ps(dy, _mm_loadu_ps(&m_axisY[i]))),
+                               _mm_mul_ps(dz, _mm_loadu_ps(&m_axisZ[i])));
+                culled = _mm_or_ps(culled, _mm_cmpge_ps(projected, _mm_mul_ps(_mm_loadu_ps(&m_cutoff[i]), length)));
+            }
+
+            const int visibleMask = ~_mm_movemask_ps(culled) & 0xF;
+            for (int k = 0; k < 4; ++k)
+            {
+                m_visible[i + k] |= static_cast<uint8_t>((visibleMask >> k) & 1);
+            }
+        }
+#else
+        for (size_t i = 0; i < padded; ++i)
+        {
+            bool culled = false;
+            if (frustumTest)
+            {
+                const float negRadius = -m_radius[i] * maxScale;
+                for (int p = 0; p < 6 && !culled; ++p)
+                {
+                    float d = localPlanes[p].x * m_centerX[i] + localPlanes[p].y * m_centerY[i] +
+                              localPlanes[p].z * m_centerZ[i] + localPlanes[p].w;
+                    culled = d < negRadius;
+                }
+            }
+            if (coneTest && !culled)
+            {
+                const glm::vec3 d = glm::vec3(m_apexX[i], m_apexY[i], m_apexZ[i]) - localCamera;
+                const float projected = d.x * m_axisX[i] + d.y * m_axisY[i] + d.z * m_axisZ[i];
+                culled = projected >= m_cutoff[i] * glm::length(d);
+            }
+            m_visible[i] |= culled ? 0 : 1;
+        }
+#endif
+    }
+
+    void MeshletCuller::BuildDrawRanges(const MeshBuffer& mesh)
+    {
+        // 连续可见簇合并为一个区间（簇在索引缓冲区中首尾相接）
+        struct Run
+        {
+            size_t begin;
+            size_t end;
+        };
+        std::vector<Run> runs;
+        for (size_t i = 0; i < m_count; ++i)
+        {
+            if (!m_visible[i])
+            {
+                continue;
+            }
+            ++m_stats.visibleClusters;
+            m_stats.visibleTriangles += m_triangleCount[i];
+
+            const size_t begin = m_firstIndex[i];
+            const size_t end = begin + static_cast<size_t>(m_triangleCount[i]) * 3;
+            if (!runs.empty() && runs.back().end == begin)
+            {
+                runs.back().end = end;
+            }
+            else
+            {
+                runs.push_back(Run{begin, end});
+            }
+        }
+
+        // 区间过多时合并最小的间隙（多画少量被剔除的三角形，换取有界的绘制调用数）
+        const size_t maxRanges = std::max<size_t>(m_config.maxDrawRanges, 1);
+        if (runs.size() > maxRanges)
+        {
+            std::vector<size_t> gaps(runs.size() - 1);
+            for (size_t i = 0; i + 1 < runs.size(); ++i)
+            {
+                gaps[i] = runs[i + 1].begin - runs[i].end;
+            }
+            const size_t mergeCount = runs.size() - maxRanges;
+            std::vector<size_t> sorted = gaps;
+            std::nth_element(sorted.begin(), sorted.begin() + (mergeCount - 1), sorted.end());
+            const size_t threshold = sorted[mergeCount - 1];
+
+            std::vector<Run> merged;
+            merged.reserve(maxRanges);
+            merged.push_back(runs[0]);
+            size_t mergedSoFar = 0;
+            for (size_t i = 1; i < runs.size(); ++i)
+            {
+                // 等于阈值的间隙可能多于需要合并的数量，只合并到恰好满足上限
+                if (gaps[i - 1] <= threshold && mergedSoFar < mergeCount)
+                {
+                    merged.back().end = runs[i].end;
+                    ++mergedSoFar;
+                }
+                else
+                {
+                    merged.push_back(runs[i]);
+                }
+            }
+            runs.swap(merged);
+        }
+
+        for (const Run& run : runs)
+        {
+            m_stats.drawnTriangles += (run.end - run.begin) / 3;
+            mesh.AppendDrawRanges(run.begin, run.end - run.begin, m_ranges);
+        }
+        m_stats.drawRanges = m_ranges.size();
+    }
+
+} // namespace Renderer
@@ -0,0 +1,438 @@
+#include "Renderer/Resources/AssetArchive.hpp"
+#include "Core/Logger.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+
+namespace fs = std::filesystem;
+
+namespace Renderer
+{
+
+    namespace
+    {
+        constexpr char kMagic[4] = {'L', 'P', 'A', 'K'};
+        constexpr size_t kAlignment = 16;
+
+        struct FileHeader
+        {
+            char magic[4];
+            uint32_t version;
+            uint32_t entryCount;
+            uint32_t sourceCount;
+            uint64_t tocOffset;
+            uint64_t sourceOffset;   // 源文件表
+            uint64_t stringOffset;
+            uint64_t stringSize;
+            uint64_t fileSize;       // 用于检测截断
+        };
+
+        struct FileEntry
+        {
+            uint32_t type;
+            uint32_t nameOffset;     // 字符串表中的偏移
+            uint32_t nameLength;
+            uint32_t firstSource;    // 源文件表中的范围
+            uint32_t sourceCount;
+            uint32_t reserved;
+            uint64_t offset;
+            uint64_t size;
+            uint64_t hash;
+        };
+
+        struct FileSource
+        {
+            uint32_t nameOffset;
+            uint32_t nameLength;
+            uint64_t size;
+            int64_t modifiedTime;
+        };
+
+        static_assert(sizeof(FileHeader) % 8 == 0, "FileHeader must be 8-byte aligned");
+        static_assert(sizeof(FileEntry) % 8 == 0, "FileEntry must be 8-byte aligned");
+        static_assert(sizeof(FileSource) % 8 == 0, "FileSource must be 8-byte aligned");
+
+        size_t AlignUp(size_t value)
+        {
+            return (value + kAlignment - 1) & ~(kAlignment - 1);
+        }
+
+        uint64_t HashBytes(const uint8_t* data, size_t size)
+        {
+            uint64_t hash = 1469598103934665603ull;
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= data[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        bool StatFile(const std::string& path, uint64_t& outSize, int64_t& outTime)
+        {
+            std::error_code ec;
+            uintmax_t size = fs::file_size(path, ec);
+            if (ec)
+                return false;
+            auto time = fs::last_write_time(path, ec);
+            if (ec)
+                return false;
+            outSize = static_cast<uint64_t>(size);
+            outTime = static_cast<int64_t>(time.time_since_epoch().count());
+            return true;
+        }
+
+        bool IsKnownType(uint32_t type)
+        {
+            return type >= static_cast<uint32_t>(AssetType::Mesh) && type <= static_cast<uint32_t>(AssetType::Raw);
+        }
+
+        std::mutex s_mountMutex;
+        std::shared_ptr<const AssetArchive> s_mounted;
+
+    } // namespace
+
+    std::string AssetArchive::NormalizeName(const std::string& name)
+    {
+        return fs::path(name).lexically_normal().generic_string();
+    }
+
+    std::string AssetArchive::MakeKey(const std::string& normalizedName, AssetType type)
+    {
+        return std::to_string(static_cast<uint32_t>(type)) + ":" + normalizedName;
+    }
+
+    bool AssetArchive::Open(const std::string& path, bool verifyHashes)
+    {
+        m_entries.clear();
+        m_sources.clear();
+        m_lookup.clear();
+        m_path = path;
+
+        auto fail = [&](const std::string& message) {
+            Core::Logger::GetInstance().Error("Invalid asset archive " + path + ": " + message);
+            m_entries.clear();
+            m_sources.clear();
+            m_lookup.clear();
+            m_file.Close();
+            return false;
+        };
+
+        if (!m_file.Open(path))
+        {
+            Core::Logger::GetInstance().Error("Failed to map asset archive: " + path);
+            return false;
+        }
+
+        const uint8_t* data = m_file.Data();
+        size_t size = m_file.Size();
+        if (data == nullptr || size < sizeof(FileHeader))
+        {
+            return fail("file too small");
+        }
+
+        const FileHeader* header = reinterpret_cast<const FileHeader*>(data);
+        if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0)
+        {
+            return fail("bad magic");
+        }
+        if (header->version != kVersion)
+        {
+            return fail("version " + std::to_string(header->version) + " (expected " + std::to_string(kVersion) + ")");
+        }
+        if (header->fileSize != size)
+        {
+            return fail("truncated");
+        }
+
+        auto inRange = [size](uint64_t offset, uint64_t bytes) {
+            return offset <= size && bytes <= size - offset;
+        };
+        if (!inRange(header->tocOffset, static_cast<uint64_t>(header->entryCount) * sizeof(FileEntry)) ||
+            !inRange(header->sourceOffset, static_cast<uint64_t>(header->sourceCount) * sizeof(FileSource)) ||
+            !inRange(header->stringOffset, header->stringSize) || header->tocOffset % alignof(FileEntry) != 0 ||
+            header->sourceOffset % alignof(FileSource) != 0)
+        {
+            return fail("table out of range");
+        }
+
+        const FileEntry* fileEntries = reinterpret_cast<const FileEntry*>(data + header->tocOffset);
+        const FileSource* fileSources = reinterpret_cast<const FileSource*>(data + header->sourceOffset);
+        const char* strings = reinterpret_cast<const char*>(data + header->stringOffset);
+
+        m_sources.reserve(header->sourceCount);
+        for (uint32_t i = 0; i < header->sourceCount; ++i)
+        {
+            const FileSource& src = fileSources[i];
+            if (static_cast<uint64_t>(src.nameOffset) + src.nameLength > header->stringSize)
+            {
+                return fail("source " + std::to_string(i) + " name out of range");
+            }
+            AssetArchiveSource source;
+            source.name.assign(strings + src.nameOffset, src.nameLength);
+            source.size = src.size;
+            source.modifiedTime = src.modifiedTime;
+            m_sources.push_back(std::move(source));
+        }
+
+        m_entries.reserve(header->entryCount);
+        for (uint32_t i = 0; i < header->entryCount; ++i)
+        {
+            const FileEntry& src = fileEntries[i];
+            if (static_cast<uint64_t>(src.nameOffset) + src.nameLength > header->stringSize)
+            {
+                return fail("entry " + std::to_string(i) + " name out of range");
+            }
+            if (!IsKnownType(src.type) || !inRange(src.offset, src.size) || src.offset % kAlignment != 0)
+            {
+                return fail("entry " + std::to_string(i) + " out of range");
+            }
+            if (static_cast<uint64_t>(src.firstSource) + src.sourceCount > header->sourceCount)
+            {
+                return fail("entry " + std::to_string(i) + " sources out of range");
+            }
+
+            AssetArchiveEntry entry;
+            entry.name.assign(strings + src.nameOffset, src.nameLength);
+            entry.type = static_cast<AssetType>(src.type);
+            entry.offset = src.offset;
+            entry.size = src.size;
+            entry.hash = src.hash;
+            entry.firstSource = src.firstSource;
+            entry.sourceCount = src.sourceCount;
+            if (verifyHashes && !Verify(entry))
+            {
+                return fail("hash mismatch: " + entry.name);
+            }
+
+            m_lookup[MakeKey(entry.name, entry.type)] = m_entries.size();
+            m_entries.push_back(std::move(entry));
+        }
+
+        Core::Logger::GetInstance().Info("Asset archive mapped: " + path + " (" + std::to_string(m_entries.size()) +
+                                         " entries, " + std::to_string(size / 1024) + " KB)");
+        return true;
+    }
+
+    const AssetArchiveEntry* AssetArchive::Find(const std::string& name, AssetType type) const
+    {
+        auto it = m_lookup.find(MakeKey(NormalizeName(name), type));
+        if (it == m_lookup.end())
+        {
+            return nullptr;
+        }
+
+        const AssetArchiveEntry& entry = m_entries[it->second];
+        if (IsStale(entry))
+        {
+            // ✅ 源文件在烘焙后被修改：回退到松散文件，避免运行时读到旧资源
+            Core::Logger::GetInstance().Info("Archived asset is stale, loading source instead: " + entry.name);
+            return nullptr;
+        }
+        return &entry;
+    }
+
+    bool AssetArchive::IsStale(const AssetArchiveEntry& entry) const
+    {
+        for (uint32_t i = 0; i < entry.sourceCount; ++i)
+        {
+            const AssetArchiveSource& source = m_sources[entry.firstSource + i];
+            uint64_t size = 0;
+            int64_t modifiedTime = 0;
+            if (!StatFile(source.name, size, modifiedTime))
+            {
+                // 条目本身的源文件不存在：发布环境只带打包文件；其余依赖（如 mtl）丢失则视为已变化
+                if (i == 0)
+                    return false;
+                return true;
+            }
+            if (size != source.size || modifiedTime != source.modifiedTime)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool AssetArchive::Verify(const AssetArchiveEntry& entry) const
+    {
+        return HashBytes(GetData(entry), static_cast<size_t>(entry.size)) == entry.hash;
+    }
+
+    bool AssetArchive::Mount(const std::string& path, bool verifyHashes)
+    {
+        auto archive = std::make_shared<AssetArchive>();
+        if (!archive->Open(path, verifyHashes))
+        {
+            return false;
+        }
+        // ⭐ 一次顺序预读整个打包文件，代替之后逐个资源的随机缺页
+        archive->m_file.Prefetch();
+
+        std::lock_guard<std::mutex> lock(s_mountMutex);
+        s_mounted = std::move(archive);
+        return true;
+    }
+
+    void AssetArchive::Unmount()
+    {
+        std::lock_guard<std::mutex> lock(s_mountMutex);
+        s_mounted.reset();
+    }
+
+    std::shared_ptr<const AssetArchive> AssetArchive::GetMounted()
+    {
+        std::lock_guard<std::mutex> lock(s_mountMutex);
+        return s_mounted;
+    }
+
+    // ============================================================
+    // AssetArchiveWriter
+    // ============================================================
+
+    void AssetArchiveWriter::Add(const std::string& name, AssetType type, std::vector<uint8_t> data,
+                                 const std::vector<std::string>& sources)
+    {
+        std::string normalized = AssetArchive::NormalizeName(name);
+
+        // 记录烘焙时源文件的大小和修改时间（不存在的源文件不记录，例如内存生成的条目）
+        std::vector<AssetArchiveSource> stamps;
+        for (const std::string& sourceName : sources.empty() ? std::vector<std::string>{name} : sources)
+        {
+            AssetArchiveSource source;
+            source.name = AssetArchive::NormalizeName(sourceName);
+            if (StatFile(source.name, source.size, source.modifiedTime))
+            {
+                stamps.push_back(std::move(source));
+            }
+        }
+
+        for (PendingEntry& entry : m_entries)
+        {
+            if (entry.type == type && entry.name == normalized)
+            {
+                entry.data = std::move(data);
+                entry.sources = std::move(stamps);
+                return;
+            }
+        }
+        m_entries.push_back(PendingEntry{std::move(normalized), type, std::move(data), std::move(stamps)});
+    }
+
+    bool AssetArchiveWriter::Has(const std::string& name, AssetType type) const
+    {
+        std::string normalized = AssetArchive::NormalizeName(name);
+        for (const PendingEntry& entry : m_entries)
+        {
+            if (entry.type == type && entry.name == normalized)
+                return true;
+        }
+        return false;
+    }
+
+    bool AssetArchiveWriter::Write(const std::string& path, std::string* error) const
+    {
+        auto fail = [error](const std::string& message) {
+            if (error)
+                *error = message;
+            return false;
+        };
+
+        if (m_entries.size() > std::numeric_limits<uint32_t>::max())
+        {
+            return fail("too many entries");
+        }
+
+        // 布局：头部 → 数据块（清单顺序）→ 目录表 → 源文件表 → 字符串表
+        std::vector<FileEntry> fileEntries(m_entries.size());
+        std::vector<FileSource> fileSources;
+        std::string strings;
+        size_t offset = AlignUp(sizeof(FileHeader));
+        for (size_t i = 0; i < m_entries.size(); ++i)
+        {
+            const PendingEntry& src = m_entries[i];
+            FileEntry& dst = fileEntries[i];
+            dst.type = static_cast<uint32_t>(src.type);
+            dst.nameOffset = static_cast<uint32_t>(strings.size());
+            dst.nameLength = static_cast<uint32_t>(src.name.size());
+            strings += src.name;
+            dst.firstSource = static_cast<uint32_t>(fileSources.size());
+            dst.sourceCount = static_cast<uint32_t>(src.sources.size());
+            for (const AssetArchiveSource& source : src.sources)
+            {
+                FileSource fileSource{};
+                fileSource.nameOffset = static_cast<uint32_t>(strings.size());
+                fileSource.nameLength = static_cast<uint32_t>(source.name.size());
+                fileSource.size = source.size;
+                fileSource.modifiedTime = source.modifiedTime;
+                fileSources.push_back(fileSource);
+                strings += source.name;
+            }
+            dst.offset = offset;
+            dst.size = src.data.size();
+            dst.hash = HashBytes(src.data.data(), src.data.size());
+            offset = AlignUp(offset + src.data.size());
+        }
+
+        FileHeader header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = AssetArchive::kVersion;
+        header.entryCount = static_cast<uint32_t>(m_entries.size());
+        header.sourceCount = static_cast<uint32_t>(fileSources.size());
+        header.tocOffset = offset;
+        header.sourceOffset = header.tocOffset + fileEntries.size() * sizeof(FileEntry);
+        header.stringOffset = header.sourceOffset + fileSources.size() * sizeof(FileSource);
+        header.stringSize = strings.size();
+        header.fileSize = header.stringOffset + header.stringSize;
+
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                return fail("cannot open " + tempPath);
+            }
+
+            static const char padding[kAlignment] = {};
+            size_t written = 0;
+            auto write = [&](const void* bytes, size_t count) {
+                out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(count));
+                written += count;
+            };
+            auto pad = [&]() {
+                write(padding, AlignUp(written) - written);
+            };
+
+            write(&header, sizeof(header));
+            pad();
+            for (const PendingEntry& entry : m_entries)
+            {
+                write(entry.data.data(), entry.data.size());
+                pad();
+            }
+            write(fileEntries.data(), fileEntries.size() * sizeof(FileEntry));
+            write(fileSources.data(), fileSources.size() * sizeof(FileSource));
+            write(strings.data(), strings.size());
+
+            if (!out)
+            {
+                out.close();
+                std::error_code ec;
+                fs::remove(tempPath, ec);
+                return fail("write failed: " + tempPath);
+            }
+        }
+
+        std::error_code ec;
+        fs::rename(tempPath, path, ec);
+        if (ec)
+        {
+            fs::remove(tempPath, ec);
+            return fail("cannot rename " + tempPath + " to " + path);
+        }
+        return true;
+    }
+
+} // namespace Renderer
@@ -0,0 +1,709 @@
+#include "Renderer/Resources/AssetLoader.hpp"
+#include "Renderer/Factory/MeshDataFactory.hpp"
+#include "Renderer/Resources/MaterialAtlas.hpp"
+#include "Renderer/Resources/MaterialTable.hpp"
+#include "Renderer/Resources/TextureStreamer.hpp"
+#include "Core/ThreadPool.hpp"
+#include "Core/Logger.hpp"
+#include "Core/Profiler.hpp"
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <unordered_set>
+
+namespace Renderer
+{
+
+    // 一个进行中的网格请求：工作线程写入 buffers 的形状，上传任务和完成任务在渲染线程执行
+    struct AssetLoader::MeshJob
+    {
+        std::string key;
+        std::vector<MeshCallback> callbacks;
+        std::vector<std::shared_ptr<const void>> dependencies;
+        std::function<void()> onUploaded;
+        bool loadTextures = false;  // 解码每个子网格的材质纹理（OBJ 导入）
+        TextureStreamer* textureStreamer = nullptr;  // 非空时材质纹理交由流送管理
+
+        std::vector<std::vector<MeshBuffer>> buffers;       // [子网格][LOD]，逐个上传
+        std::vector<std::shared_ptr<Texture>> textures;     // 每个子网格一个（可为空）
+        bool failed = false;
+    };
+
+    struct AssetLoader::TextureJob
+    {
+        std::string path;
+        std::vector<TextureCallback> callbacks;
+    };
+
+    // 一个流式导入：块在渲染线程按材质追加到可增长缓冲区
+    struct AssetLoader::StreamJob
+    {
+        std::string path;
+        StreamSubmeshCallback onSubmesh;
+        StreamDoneCallback onComplete;
+
+        std::map<int, std::shared_ptr<MeshBuffer>> submeshes;  // 按材质下标（只在渲染线程访问）
+        size_t chunks = 0;
+    };
+
+    namespace
+    {
+        std::vector<std::vector<MeshData>> Single(MeshData&& data)
+        {
+            std::vector<std::vector<MeshData>> submeshes(1);
+            submeshes[0].push_back(std::move(data));
+            return submeshes;
+        }
+
+        std::vector<std::vector<MeshData>> Chain(std::vector<MeshData>&& lods)
+        {
+            std::vector<std::vector<MeshData>> submeshes;
+            submeshes.push_back(std::move(lods));
+            return submeshes;
+        }
+
+        std::vector<std::vector<MeshData>> PerSubmesh(std::vector<MeshData>&& dataList)
+        {
+            std::vector<std::vector<MeshData>> submeshes;
+            submeshes.reserve(dataList.size());
+            for (auto& data : dataList)
+            {
+                submeshes.emplace_back();
+                submeshes.back().push_back(std::move(data));
+            }
+            return submeshes;
+        }
+    } // namespace
+
+    AssetLoader::AssetLoader(const AssetLoaderConfig& config)
+        : m_config(config)
+    {
+    }
+
+    AssetLoader::~AssetLoader()
+    {
+        // 流式导入可能在等待上传队列腾出空间：通知它们取消
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            m_stopping = true;
+        }
+        m_uploadDrained.notify_all();
+
+        // 工作线程会访问本对象（Enqueue），必须先等待它们结束
+        for (auto& work : m_work)
+        {
+            if (work.valid())
+            {
+                work.wait();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        if (!m_uploads.empty())
+        {
+            Core::Logger::GetInstance().Warning("AssetLoader - Discarding " + std::to_string(m_uploads.size()) +
+                                                " pending upload(s)");
+        }
+        m_uploads.clear();
+    }
+
+    // ========================================
+    // 网格
+    // ========================================
+
+    void AssetLoader::LoadMesh(const std::string& key, MeshBuildFunc build, MeshCallback callback,
+                               std::vector<std::shared_ptr<const void>> dependencies,
+                               std::function<void()> onUploaded)
+    {
+        StartMeshJob(key, std::move(build), std::move(callback), std::move(dependencies), std::move(onUploaded), false);
+    }
+
+    void AssetLoader::StartMeshJob(const std::string& key, MeshBuildFunc build, MeshCallback callback,
+                                   std::vector<std::shared_ptr<const void>> dependencies,
+                                   std::function<void()> onUploaded, bool loadTextures,
+                                   TextureStreamer* textureStreamer)
+    {
+        // 进行中的同键请求：只追加回调
+        auto it = m_meshJobs.find(key);
+        if (it != m_meshJobs.end())
+        {
+            it->second->callbacks.push_back(std::move(callback));
+            return;
+        }
+
+        ++m_requested;
+
+        // 已加载：下一次 ProcessUploads 时回调（回调时机与异步加载一致）
+        if (MeshHandle existing = AssetRegistry::GetInstance().Find(key))
+        {
+            ++m_decoded;
+            std::vector<UploadTask> tasks;
+            tasks.push_back(UploadTask{key, 0, [this, existing, callback]() {
+                                           ++m_completed;
+                                           if (callback)
+                                               callback(existing);
+                                       }});
+            Enqueue(std::move(tasks));
+            return;
+        }
+
+        auto job = std::make_shared<MeshJob>();
+        job->key = key;
+        job->callbacks.push_back(std::move(callback));
+        job->dependencies = std::move(dependencies);
+        job->onUploaded = std::move(onUploaded);
+        job->loadTextures = loadTextures;
+        job->textureStreamer = textureStreamer;
+        m_meshJobs[key] = job;
+        SubmitMeshJob(job, std::move(build));
+    }
+
+    void AssetLoader::SubmitMeshJob(const std::shared_ptr<MeshJob>& job, MeshBuildFunc build)
+    {
+        m_work.push_back(Core::ThreadPool::GetInstance().Submit([this, job, build = std::move(build)]() {
+            PROFILE_SCOPE("AssetLoader::BuildMesh");
+            auto& logger = Core::Logger::GetInstance();
+            auto startTime = std::chrono::steady_clock::now();
+
+            std::vector<std::vector<MeshData>> data;
+            try
+            {
+                data = build();
+            }
+            catch (const std::exception& e)
+            {
+                logger.Error("AssetLoader - Failed to build " + job->key + ": " + e.what());
+                data.clear();
+            }
+
+            std::vector<UploadTask> tasks;
+            if (data.empty())
+            {
+                job->failed = true;
+            }
+            else
+            {
+                // 材质纹理：同一路径只解码一次，上传后挂到所有使用它的子网格
+                job->textures.resize(data.size());
+                if (job->loadTextures)
+                {
+                    std::unordered_map<std::string, std::vector<size_t>> users;
+                    std::vector<std::string> paths;
+                    for (size_t submesh = 0; submesh < data.size(); ++submesh)
+                    {
+                        if (data[submesh].empty())
+                            continue;
+                        const std::string& path = data[submesh][0].GetTexturePath();
+                        if (path.empty())
+                            continue;
+                        if (users.find(path) == users.end())
+                            paths.push_back(path);
+                        users[path].push_back(submesh);
+                    }
+
+                    for (const auto& path : paths)
+                    {
+                        auto source = std::make_shared<TextureSource>();
+                        if (!Texture::Decode(path, *source))
+                        {
+                            continue;
+                        }
+                        // 流送纹理：mip 链在工作线程生成，渲染线程不再 glGenerateMipmap
+                        if (job->textureStreamer)
+                        {
+                            TextureStreamer::PrepareSource(*source);
+                        }
+                        std::vector<size_t> submeshes = users[path];
+                        tasks.push_back(UploadTask{path, source->GetSizeBytes(), [job, source, submeshes]() {
+                                                       std::shared_ptr<Texture> texture;
+                                                       if (job->textureStreamer)
+                                                       {
+                                                           texture = job->textureStreamer->Load(std::move(*source));
+                                                       }
+                                                       else
+                                                       {
+                                                           texture = std::make_shared<Texture>();
+                                                           if (!texture->LoadFromSource(*source))
+                                                               texture.reset();
+                                                       }
+                                                       if (!texture)
+                                                           return;
+                                                       for (size_t submesh : submeshes)
+                                                           job->textures[submesh] = texture;
+                                                   }});
+                    }
+                }
+
+                // 每个网格一个上传任务（数据以 shared_ptr 持有，std::function 需要可拷贝）
+                job->buffers.resize(data.size());
+                for (size_t submesh = 0; submesh < data.size(); ++submesh)
+                {
+                    job->buffers[submesh].resize(data[submesh].size());
+                    for (size_t lod = 0; lod < data[submesh].size(); ++lod)
+                    {
+                        auto payload = std::make_shared<MeshData>(std::move(data[submesh][lod]));
+                        size_t bytes = payload->GetVertexDataSizeBytes() + payload->GetIndexDataSizeBytes();
+                        tasks.push_back(UploadTask{job->key, bytes, [job, payload, submesh, lod]() {
+                                                       job->buffers[submesh][lod].UploadToGPU(std::move(*payload));
+                                                   }});
+                    }
+                }
+            }
+
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+            logger.Debug("AssetLoader - Decoded " + job->key + " in " + std::to_string(static_cast<int>(ms)) + " ms (" +
+                         std::to_string(tasks.size()) + " upload task(s))");
+
+            // 完成任务排在该资源所有上传任务之后
+            tasks.push_back(UploadTask{job->key, 0, [this, job]() { FinishMeshJob(job); }});
+            ++m_decoded;
+            Enqueue(std::move(tasks));
+        }));
+    }
+
+    void AssetLoader::FinishMeshJob(const std::shared_ptr<MeshJob>& job)
+    {
+        MeshHandle asset;
+        if (!job->failed)
+        {
+            for (size_t submesh = 0; submesh < job->buffers.size(); ++submesh)
+            {
+                if (!job->textures[submesh])
+                    continue;
+                for (auto& buffer : job->buffers[submesh])
+                {
+                    buffer.SetTexture(job->textures[submesh]);
+                }
+            }
+
+            if (job->onUploaded)
+            {
+                job->onUploaded();
+            }
+
+            // 期间同步接口已加载同一个键时，注册表返回现有资源，这里上传的缓冲区随 job 释放
+            asset = AssetRegistry::GetInstance().GetOrCreate(
+                job->key, [&]() { return std::move(job->buffers); }, job->dependencies);
+        }
+
+        // ⚠️ 在渲染线程释放未被注册表接管的 GL 缓冲区（job 的最后一个引用可能在工作线程）
+        job->buffers.clear();
+        job->textures.clear();
+
+        // 先移除再回调：回调中对同一个键的新请求直接命中注册表
+        m_meshJobs.erase(job->key);
+        ++(asset ? m_completed : m_failed);
+
+        std::vector<MeshCallback> callbacks = std::move(job->callbacks);
+        for (auto& callback : callbacks)
+        {
+            if (callback)
+                callback(asset);
+        }
+    }
+
+    void AssetLoader::LoadOBJ(const std::string& objPath, MeshCallback callback, bool quantize,
+                              TextureStreamer* textureStreamer)
+    {
+        StartMeshJob(
+            AssetRegistry::OBJKey(objPath, quantize),
+            [objPath, quantize]() {
+                return PerSubmesh(MeshDataFactory::CreatePreparedOBJData(objPath, quantize));
+            },
+            std::move(callback), {}, nullptr, true, textureStreamer);
+    }
+
+    void AssetLoader::LoadGLTF(const std::string& gltfPath, MeshCallback callback, bool quantize)
+    {
+        StartMeshJob(
+            AssetRegistry::GLTFKey(gltfPath, quantize),
+            [gltfPath, quantize]() {
+                return PerSubmesh(MeshDataFactory::CreatePreparedGLTFData(gltfPath, quantize));
+            },
+            std::move(callback), {}, nullptr, true);
+    }
+
+    void AssetLoader::LoadOBJAtlas(const std::string& objPath, std::shared_ptr<MaterialAtlas> atlas,
+                                   const std::shared_ptr<MaterialTable>& materialTable, const MeshLODConfig* lodConfig,
+                                   MeshCallback callback, bool quantize)
+    {
+        if (!atlas)
+        {
+            atlas = AssetRegistry::GetInstance().GetDefaultAtlas();
+        }
+
+        const bool useLOD = lodConfig && lodConfig->levelCount > 1;
+        const MeshLODConfig config = useLOD ? *lodConfig : MeshLODConfig();
+        LoadMesh(
+            AssetRegistry::OBJAtlasKey(objPath, atlas.get(), materialTable.get(), lodConfig, quantize),
+            [objPath, atlas, materialTable, useLOD, config, quantize]() {
+                // 图集和材质表内部加锁：多个导入任务可同时登记纹理和材质，GL 上传留给渲染线程
+                std::vector<MeshData> dataList = MeshDataFactory::CreateOBJAtlasData(objPath, *atlas, materialTable.get());
+                if (!useLOD)
+                {
+                    for (auto& data : dataList)
+                    {
+                        MeshDataFactory::PrepareForUpload(data, quantize);
+                    }
+                    return PerSubmesh(std::move(dataList));
+                }
+
+                std::vector<std::vector<MeshData>> chains;
+                chains.reserve(dataList.size());
+                for (auto& data : dataList)
+                {
+                    chains.push_back(MeshDataFactory::CreateLODData(std::move(data), config, quantize));
+                }
+                return chains;
+            },
+            std::move(callback), {atlas, materialTable},
+            [atlas, materialTable]() {
+                // 纹理数组在渲染线程构建：新纹理写入预留的空闲层，容量不足时该档位扩容并重新解码上传全部层
+                atlas->Build();
+                if (materialTable)
+                {
+                    materialTable->Upload();
+                }
+            });
+    }
+
+    // ========================================
+    // 流式导入
+    // ========================================
+
+    void AssetLoader::StreamOBJ(const std::string& objPath, StreamSubmeshCallback onSubmesh,
+                                StreamDoneCallback onComplete, const OBJStreamConfig& config)
+    {
+        ++m_requested;
+        auto job = std::make_shared<StreamJob>();
+        job->path = objPath;
+        job->onSubmesh = std::move(onSubmesh);
+        job->onComplete = std::move(onComplete);
+
+        // ⚠️ 独立线程而不是线程池任务：解析持续整个文件且会等待背压，
+        //    同时线程池外调用 ParallelFor 才能让每个窗口并行解析
+        m_work.push_back(std::async(std::launch::async, [this, job, config]() {
+            PROFILE_THREAD("OBJ Stream");
+            PROFILE_SCOPE("AssetLoader::StreamOBJ");
+            auto startTime = std::chrono::steady_clock::now();
+            std::unordered_set<int> seenMaterials;
+
+            OBJLoader loader;
+            bool success = loader.LoadStreaming(job->path, config, [&](OBJMeshChunk&& chunk) {
+                if (!WaitForUploadSpace())
+                {
+                    return false;
+                }
+
+                const int material = chunk.materialIndex;
+                auto payload = std::make_shared<MeshData>(
+                    MeshDataFactory::CreateOBJChunkData(std::move(chunk), loader.GetMaterials(), loader.GetBasePath()));
+
+                // 材质纹理随该材质的第一块一起上传
+                std::shared_ptr<TextureSource> texture;
+                if (seenMaterials.insert(material).second && !payload->GetTexturePath().empty())
+                {
+                    texture = std::make_shared<TextureSource>();
+                    if (!Texture::Decode(payload->GetTexturePath(), *texture))
+                    {
+                        texture.reset();
+                    }
+                }
+
+                size_t bytes = payload->GetVertexDataSizeBytes() + payload->GetIndexCount() * sizeof(uint16_t) +
+                               (texture ? texture->GetSizeBytes() : 0);
+                std::vector<UploadTask> tasks;
+                tasks.push_back(UploadTask{job->path, bytes, [this, job, material, payload, texture]() {
+                                               AppendStreamChunk(job, material, *payload, texture);
+                                           }});
+                Enqueue(std::move(tasks));
+                return true;
+            });
+
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+            Core::Logger::GetInstance().Debug("AssetLoader - Streamed " + job->path + " in " +
+                                              std::to_string(static_cast<int>(ms)) + " ms");
+
+            ++m_decoded;
+            std::vector<UploadTask> tasks;
+            tasks.push_back(UploadTask{job->path, 0, [this, job, success]() { FinishStreamJob(job, success); }});
+            Enqueue(std::move(tasks));
+        }));
+    }
+
+    bool AssetLoader::WaitForUploadSpace()
+    {
+        std::unique_lock<std::mutex> lock(m_queueMutex);
+        m_uploadDrained.wait(lock, [this]() {
+            return m_stopping || m_pendingUploadBytes.load() <= m_config.streamPendingBytes;
+        });
+        return !m_stopping;
+    }
+
+    void AssetLoader::AppendStreamChunk(const std::shared_ptr<StreamJob>& job, int material, const MeshData& chunk,
+                                        const std::shared_ptr<TextureSource>& texture)
+    {
+        std::shared_ptr<MeshBuffer>& buffer = job->submeshes[material];
+        const bool created = !buffer;
+        if (created)
+        {
+            buffer = std::make_shared<MeshBuffer>();
+            if (!buffer->BeginStreaming(chunk))
+            {
+                buffer.reset();
+                return;
+            }
+            if (texture)
+            {
+                auto loaded = std::make_shared<Texture>();
+                if (loaded->LoadFromSource(*texture))
+                {
+                    buffer->SetTexture(loaded);
+                }
+            }
+        }
+
+        if (!buffer || !buffer->AppendToGPU(chunk))
+        {
+            return;
+        }
+        ++job->chunks;
+
+        // 先追加再回调：渲染器 Initialize 时网格已有第一块
+        if (created && job->onSubmesh)
+        {
+            job->onSubmesh(buffer);
+        }
+    }
+
+    void AssetLoader::FinishStreamJob(const std::shared_ptr<StreamJob>& job, bool success)
+    {
+        size_t triangles = 0;
+        for (const auto& [material, buffer] : job->submeshes)
+        {
+            if (buffer)
+                triangles += buffer->GetIndexCount() / 3;
+        }
+        Core::Logger::GetInstance().Info("AssetLoader - Streamed " + job->path + ": " +
+                                         std::to_string(job->submeshes.size()) + " submesh(es), " +
+                                         std::to_string(job->chunks) + " chunk(s), " + std::to_string(triangles) +
+                                         " triangles");
+
+        ++(success ? m_completed : m_failed);
+        if (job->onComplete)
+        {
+            job->onComplete(success);
+        }
+    }
+
+    void AssetLoader::LoadCube(MeshCallback callback)
+    {
+        LoadMesh(AssetRegistry::ProceduralKey("cube", {}),
+                 []() { return Single(MeshDataFactory::CreateCubeData()); }, std::move(callback));
+    }
+
+    void AssetLoader::LoadPlane(float width, float height, int widthSegments, int heightSegments,
+                                MeshCallback callback)
+    {
+        LoadMesh(AssetRegistry::ProceduralKey("plane", {width, height, static_cast<float>(widthSegments),
+                                                        static_cast<float>(heightSegments)}),
+                 [=]() { return Single(MeshDataFactory::CreatePlaneData(width, height, widthSegments, heightSegments)); },
+                 std::move(callback));
+    }
+
+    void AssetLoader::LoadSphereLOD(int stacks, int slices, float radius, size_t levelCount, MeshCallback callback)
+    {
+        LoadMesh(AssetRegistry::ProceduralKey("sphere-lod", {static_cast<float>(stacks), static_cast<float>(slices),
+                                                             radius, static_cast<float>(levelCount)}),
+                 [=]() { return Chain(MeshDataFactory::CreateSphereLODData(stacks, slices, radius, levelCount)); },
+                 std::move(callback));
+    }
+
+    void AssetLoader::LoadTorusLOD(float majorRadius, float minorRadius, int majorSegments, int minorSegments,
+                                   size_t levelCount, MeshCallback callback)
+    {
+        LoadMesh(AssetRegistry::ProceduralKey("torus-lod", {majorRadius, minorRadius, static_cast<float>(majorSegments),
+                                                            static_cast<float>(minorSegments),
+                                                            static_cast<float>(levelCount)}),
+                 [=]() {
+                     return Chain(MeshDataFactory::CreateTorusLODData(majorRadius, minorRadius, majorSegments,
+                                                                      minorSegments, levelCount));
+                 },
+                 std::move(callback));
+    }
+
+    // ========================================
+    // 纹理
+    // ========================================
+
+    void AssetLoader::LoadTexture(const std::string& filepath, TextureCallback callback)
+    {
+        auto it = m_textureJobs.find(filepath);
+        if (it != m_textureJobs.end())
+        {
+            it->second->callbacks.push_back(std::move(callback));
+            return;
+        }
+
+        ++m_requested;
+        auto job = std::make_shared<TextureJob>();
+        job->path = filepath;
+        job->callbacks.push_back(std::move(callback));
+        m_textureJobs[filepath] = job;
+        SubmitTextureJob(job);
+    }
+
+    void AssetLoader::SubmitTextureJob(const std::shared_ptr<TextureJob>& job)
+    {
+        m_work.push_back(Core::ThreadPool::GetInstance().Submit([this, job]() {
+            PROFILE_SCOPE("AssetLoader::DecodeTexture");
+            auto source = std::make_shared<TextureSource>();
+            bool decoded = Texture::Decode(job->path, *source);
+            size_t bytes = decoded ? source->GetSizeBytes() : 0;
+
+            std::vector<UploadTask> tasks;
+            tasks.push_back(UploadTask{job->path, bytes, [this, job, source, decoded]() {
+                                           std::shared_ptr<Texture> texture;
+                                           if (decoded)
+                                           {
+                                               texture = std::make_shared<Texture>();
+                                               if (!texture->LoadFromSource(*source))
+                                                   texture.reset();
+                                           }
+
+                                           m_textureJobs.erase(job->path);
+                                           ++(texture ? m_completed : m_failed);
+
+                                           std::vector<TextureCallback> callbacks = std::move(job->callbacks);
+                                           for (auto& callback : callbacks)
+                                           {
+                                               if (callback)
+                                                   callback(texture);
+                                           }
+                                       }});
+            ++m_decoded;
+            Enqueue(std::move(tasks));
+        }));
+    }
+
+    // ========================================
+    // 上传队列
+    // ========================================
+
+    void AssetLoader::Enqueue(std::vector<UploadTask>&& tasks)
+    {
+        size_t bytes = 0;
+        for (const auto& task : tasks)
+        {
+            bytes += task.bytes;
+        }
+        m_pendingUploadBytes += bytes;
+
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        for (auto& task : tasks)
+        {
+            m_uploads.push_back(std::move(task));
+        }
+    }
+
+    size_t AssetLoader::Drain(bool ignoreBudget)
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+        size_t executed = 0;
+        size_t bytes = 0;
+
+        while (true)
+        {
+            UploadTask task;
+            {
+                std::lock_guard<std::mutex> lock(m_queueMutex);
+                if (m_uploads.empty())
+                {
+                    break;
+                }
+                // 至少执行一个任务：超出预算的单个大网格也能在某一帧完成
+                if (!ignoreBudget && executed > 0)
+                {
+                    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+                    if (ms >= m_config.uploadBudgetMs || bytes + m_uploads.front().bytes > m_config.uploadBudgetBytes)
+                    {
+                        break;
+                    }
+                }
+                task = std::move(m_uploads.front());
+                m_uploads.pop_front();
+            }
+
+            // 锁外执行：任务（回调）可能发出新的请求
+            task.run();
+            {
+                // 在锁内更新，保证等待背压的流式导入不会错过通知
+                std::lock_guard<std::mutex> lock(m_queueMutex);
+                m_pendingUploadBytes -= task.bytes;
+            }
+            m_uploadDrained.notify_all();
+            bytes += task.bytes;
+            ++executed;
+        }
+        return executed;
+    }
+
+    void AssetLoader::PruneFinishedWork()
+    {
+        for (auto it = m_work.begin(); it != m_work.end();)
+        {
+            if (it->wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                it->get();
+                it = m_work.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    size_t AssetLoader::ProcessUploads()
+    {
+        PROFILE_SCOPE("AssetLoader::ProcessUploads");
+        PruneFinishedWork();
+        return Drain(false);
+    }
+
+    void AssetLoader::Flush()
+    {
+        while (true)
+        {
+            // 等待期间持续排空队列：流式导入在队列满时会等待上传
+            // 按下标遍历：Drain 中的回调可能追加新的工作
+            for (size_t i = 0; i < m_work.size(); ++i)
+            {
+                while (m_work[i].wait_for(std::chrono::milliseconds(1)) != std::future_status::ready)
+                {
+                    Drain(true);
+                }
+            }
+            PruneFinishedWork();
+            Drain(true);
+
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            if (m_work.empty() && m_uploads.empty())
+            {
+                break;
+            }
+        }
+    }
+
+    AssetLoadProgress AssetLoader::GetProgress() const
+    {
+        AssetLoadProgress progress;
+        progress.requested = m_requested.load();
+        progress.decoded = m_decoded.load();
+        progress.completed = m_completed.load();
+        progress.failed = m_failed.load();
+        progress.pendingUploadBytes = m_pendingUploadBytes.load();
+        return progress;
+    }
+
+} // namespace Renderer
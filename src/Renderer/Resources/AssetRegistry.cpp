@@ -0,0 +1,347 @@
+#include "Renderer/Resources/AssetRegistry.hpp"
+#include "Renderer/Factory/MeshDataFactory.hpp"
+#include "Renderer/Resources/MaterialAtlas.hpp"
+#include "Renderer/Resources/MaterialTable.hpp"
+#include "Core/Logger.hpp"
+#include <cstdio>
+#include <sstream>
+
+namespace Renderer
+{
+
+    // ========================================
+    // MeshAsset
+    // ========================================
+
+    MeshAsset::MeshAsset(std::string key, std::vector<std::vector<MeshBuffer>>&& submeshes,
+                         std::vector<std::shared_ptr<const void>> dependencies)
+        : m_key(std::move(key)), m_submeshes(std::move(submeshes)), m_dependencies(std::move(dependencies))
+    {
+        for (const auto& chain : m_submeshes)
+        {
+            for (const auto& buffer : chain)
+            {
+                const MeshData& data = buffer.GetData();
+                m_cpuBytes += data.GetVertexDataSizeBytes() + data.GetIndexDataSizeBytes() +
+                              data.GetMeshlets().size() * sizeof(Meshlet);
+                m_gpuBytes += data.GetVertexDataSizeBytes() + buffer.GetIndexBufferSizeBytes();
+            }
+        }
+    }
+
+    MeshAsset::~MeshAsset()
+    {
+        Core::Logger::GetInstance().Info("AssetRegistry - Unloaded " + m_key + " (" +
+                                         std::to_string(m_gpuBytes / 1024) + " KB GPU)");
+    }
+
+    std::shared_ptr<MeshBuffer> MeshAsset::GetMesh(size_t submesh, size_t lod) const
+    {
+        if (submesh >= m_submeshes.size() || lod >= m_submeshes[submesh].size())
+        {
+            return nullptr;
+        }
+        // 别名构造：指向子网格，引用计数记在资源上
+        auto self = std::const_pointer_cast<MeshAsset>(shared_from_this());
+        return std::shared_ptr<MeshBuffer>(self, &self->m_submeshes[submesh][lod]);
+    }
+
+    std::vector<std::shared_ptr<MeshBuffer>> MeshAsset::GetLODs(size_t submesh) const
+    {
+        std::vector<std::shared_ptr<MeshBuffer>> lods;
+        if (submesh < m_submeshes.size())
+        {
+            for (size_t lod = 0; lod < m_submeshes[submesh].size(); ++lod)
+            {
+                lods.push_back(GetMesh(submesh, lod));
+            }
+        }
+        return lods;
+    }
+
+    std::vector<std::shared_ptr<MeshBuffer>> MeshAsset::GetMeshes() const
+    {
+        std::vector<std::shared_ptr<MeshBuffer>> meshes;
+        meshes.reserve(m_submeshes.size());
+        for (size_t submesh = 0; submesh < m_submeshes.size(); ++submesh)
+        {
+            meshes.push_back(GetMesh(submesh, 0));
+        }
+        return meshes;
+    }
+
+    // ========================================
+    // AssetRegistry
+    // ========================================
+
+    AssetRegistry& AssetRegistry::GetInstance()
+    {
+        static AssetRegistry instance;
+        return instance;
+    }
+
+    std::string AssetRegistry::FormatFloat(float value)
+    {
+        // %.9g 可区分所有 float，避免 std::to_string 的 6 位小数截断造成键冲突
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+        return buffer;
+    }
+
+    std::string AssetRegistry::OBJKey(const std::string& objPath, bool quantize)
+    {
+        return "obj:" + objPath + "|q=" + (quantize ? "1" : "0");
+    }
+
+    std::string AssetRegistry::GLTFKey(const std::string& gltfPath, bool quantize)
+    {
+        return "gltf:" + gltfPath + "|q=" + (quantize ? "1" : "0");
+    }
+
+    std::string AssetRegistry::OBJAtlasKey(const std::string& objPath, const MaterialAtlas* atlas,
+                                           const MaterialTable* materialTable, const MeshLODConfig* lodConfig,
+                                           bool quantize)
+    {
+        std::ostringstream key;
+        key << "obj-atlas:" << objPath << "|atlas=" << static_cast<const void*>(atlas)
+            << "|table=" << static_cast<const void*>(materialTable) << "|q=" << (quantize ? 1 : 0);
+        if (lodConfig && lodConfig->levelCount > 1)
+        {
+            key << "|lod=" << lodConfig->levelCount << "," << FormatFloat(lodConfig->reductionPerLevel) << ","
+                << FormatFloat(lodConfig->maxError) << "," << FormatFloat(lodConfig->minReduction);
+        }
+        return key.str();
+    }
+
+    std::string AssetRegistry::ProceduralKey(const std::string& kind, std::initializer_list<float> params)
+    {
+        // 整数参数经 %.9g 格式化后与 std::to_string 相同（"32"）
+        std::string key = kind;
+        char separator = ':';
+        for (float param : params)
+        {
+            key += separator;
+            key += FormatFloat(param);
+            separator = ',';
+        }
+        return key;
+    }
+
+    void AssetRegistry::PurgeExpired()
+    {
+        for (auto it = m_assets.begin(); it != m_assets.end();)
+        {
+            it = it->second.expired() ? m_assets.erase(it) : std::next(it);
+        }
+    }
+
+    MeshHandle AssetRegistry::Find(const std::string& key) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_assets.find(key);
+        return it != m_assets.end() ? it->second.lock() : nullptr;
+    }
+
+    MeshHandle AssetRegistry::GetOrCreate(const std::string& key,
+                                          const std::function<std::vector<std::vector<MeshBuffer>>()>& create,
+                                          std::vector<std::shared_ptr<const void>> dependencies)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_assets.find(key);
+        if (it != m_assets.end())
+        {
+            if (MeshHandle existing = it->second.lock())
+            {
+                ++m_hitCount;
+                Core::Logger::GetInstance().Debug("AssetRegistry - Reusing " + key);
+                return existing;
+            }
+        }
+        PurgeExpired();
+
+        auto submeshes = create();
+        if (submeshes.empty())
+        {
+            Core::Logger::GetInstance().Error("AssetRegistry - Failed to create " + key);
+            return nullptr;
+        }
+
+        auto asset = std::make_shared<MeshAsset>(key, std::move(submeshes), std::move(dependencies));
+        m_assets[key] = asset;
+        ++m_importCount;
+        Core::Logger::GetInstance().Info("AssetRegistry - Loaded " + key + " (" +
+                                         std::to_string(asset->GetSubmeshCount()) + " submesh(es), " +
+                                         std::to_string(asset->GetGPUBytes() / 1024) + " KB GPU)");
+        return asset;
+    }
+
+    namespace
+    {
+        // 单个网格 / 单条 LOD 链包装为 [子网格][LOD]
+        std::vector<std::vector<MeshBuffer>> Single(MeshBuffer&& buffer)
+        {
+            std::vector<std::vector<MeshBuffer>> submeshes(1);
+            submeshes[0].push_back(std::move(buffer));
+            return submeshes;
+        }
+
+        std::vector<std::vector<MeshBuffer>> Chain(std::vector<MeshBuffer>&& lods)
+        {
+            std::vector<std::vector<MeshBuffer>> submeshes;
+            submeshes.push_back(std::move(lods));
+            return submeshes;
+        }
+
+        std::vector<std::vector<MeshBuffer>> PerSubmesh(std::vector<MeshBuffer>&& buffers)
+        {
+            std::vector<std::vector<MeshBuffer>> submeshes;
+            submeshes.reserve(buffers.size());
+            for (auto& buffer : buffers)
+            {
+                submeshes.emplace_back();
+                submeshes.back().push_back(std::move(buffer));
+            }
+            return submeshes;
+        }
+    } // namespace
+
+    MeshHandle AssetRegistry::LoadOBJ(const std::string& objPath, bool quantize)
+    {
+        return GetOrCreate(OBJKey(objPath, quantize), [&]() {
+            return PerSubmesh(MeshBufferFactory::CreateOBJBuffers(objPath, quantize));
+        });
+    }
+
+    MeshHandle AssetRegistry::LoadGLTF(const std::string& gltfPath, bool quantize)
+    {
+        return GetOrCreate(GLTFKey(gltfPath, quantize), [&]() {
+            return PerSubmesh(MeshBufferFactory::CreateGLTFBuffers(gltfPath, quantize));
+        });
+    }
+
+    std::shared_ptr<MaterialAtlas> AssetRegistry::GetDefaultAtlas()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::shared_ptr<MaterialAtlas> atlas = m_defaultAtlas.lock();
+        if (!atlas)
+        {
+            atlas = std::make_shared<MaterialAtlas>();
+            m_defaultAtlas = atlas;
+        }
+        return atlas;
+    }
+
+    MeshHandle AssetRegistry::LoadOBJAtlas(const std::string& objPath, const std::shared_ptr<MaterialAtlas>& atlas,
+                                           const std::shared_ptr<MaterialTable>& materialTable,
+                                           const MeshLODConfig* lodConfig, bool quantize)
+    {
+        if (!atlas)
+        {
+            Core::Logger::GetInstance().Error("AssetRegistry::LoadOBJAtlas() - Atlas is required: " + objPath);
+            return nullptr;
+        }
+
+        const bool useLOD = lodConfig && lodConfig->levelCount > 1;
+        return GetOrCreate(
+            OBJAtlasKey(objPath, atlas.get(), materialTable.get(), lodConfig, quantize),
+            [&]() {
+                if (useLOD)
+                {
+                    return MeshBufferFactory::CreateOBJAtlasLODBuffers(objPath, *atlas, *lodConfig,
+                                                                       materialTable.get(), quantize);
+                }
+                return PerSubmesh(
+                    MeshBufferFactory::CreateOBJAtlasBuffers(objPath, *atlas, materialTable.get(), quantize));
+            },
+            {atlas, materialTable});
+    }
+
+    MeshHandle AssetRegistry::GetCube()
+    {
+        return GetOrCreate(ProceduralKey("cube", {}), []() { return Single(MeshBufferFactory::CreateCubeBuffer()); });
+    }
+
+    MeshHandle AssetRegistry::GetPlane(float width, float height, int widthSegments, int heightSegments)
+    {
+        std::string key = ProceduralKey("plane", {width, height, static_cast<float>(widthSegments),
+                                                  static_cast<float>(heightSegments)});
+        return GetOrCreate(key, [&]() {
+            return Single(MeshBufferFactory::CreatePlaneBuffer(width, height, widthSegments, heightSegments));
+        });
+    }
+
+    MeshHandle AssetRegistry::GetSphere(int stacks, int slices, float radius)
+    {
+        std::string key = ProceduralKey("sphere", {static_cast<float>(stacks), static_cast<float>(slices), radius});
+        return GetOrCreate(key, [&]() { return Single(MeshBufferFactory::CreateSphereBuffer(stacks, slices, radius)); });
+    }
+
+    MeshHandle AssetRegistry::GetSphereLOD(int stacks, int slices, float radius, size_t levelCount)
+    {
+        std::string key = ProceduralKey("sphere-lod", {static_cast<float>(stacks), static_cast<float>(slices), radius,
+                                                       static_cast<float>(levelCount)});
+        return GetOrCreate(key, [&]() {
+            return Chain(MeshBufferFactory::CreateSphereLODBuffers(stacks, slices, radius, levelCount));
+        });
+    }
+
+    MeshHandle AssetRegistry::GetTorus(float majorRadius, float minorRadius, int majorSegments, int minorSegments)
+    {
+        std::string key = ProceduralKey("torus", {majorRadius, minorRadius, static_cast<float>(majorSegments),
+                                                  static_cast<float>(minorSegments)});
+        return GetOrCreate(key, [&]() {
+            return Single(MeshBufferFactory::CreateTorusBuffer(majorRadius, minorRadius, majorSegments, minorSegments));
+        });
+    }
+
+    MeshHandle AssetRegistry::GetTorusLOD(float majorRadius, float minorRadius, int majorSegments, int minorSegments,
+                                          size_t levelCount)
+    {
+        std::string key = ProceduralKey("torus-lod", {majorRadius, minorRadius, static_cast<float>(majorSegments),
+                                                      static_cast<float>(minorSegments), static_cast<float>(levelCount)});
+        return GetOrCreate(key, [&]() {
+            return Chain(MeshBufferFactory::CreateTorusLODBuffers(majorRadius, minorRadius, majorSegments,
+                                                                  minorSegments, levelCount));
+        });
+    }
+
+    std::vector<AssetInfo> AssetRegistry::GetAssetInfos() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<AssetInfo> infos;
+        for (const auto& [key, weak] : m_assets)
+        {
+            if (MeshHandle asset = weak.lock())
+            {
+                // 减去这里临时持有的一个引用
+                infos.push_back(AssetInfo{key, asset.use_count() - 1, asset->GetCPUBytes(), asset->GetGPUBytes()});
+            }
+        }
+        return infos;
+    }
+
+    void AssetRegistry::LogStats() const
+    {
+        std::vector<AssetInfo> infos = GetAssetInfos();
+        size_t cpuBytes = 0;
+        size_t gpuBytes = 0;
+        for (const auto& info : infos)
+        {
+            cpuBytes += info.cpuBytes;
+            gpuBytes += info.gpuBytes;
+        }
+
+        auto& logger = Core::Logger::GetInstance();
+        logger.Info("=== AssetRegistry: " + std::to_string(infos.size()) + " asset(s), " +
+                    std::to_string(m_importCount) + " import(s), " + std::to_string(m_hitCount) + " hit(s), " +
+                    std::to_string(cpuBytes / 1024) + " KB CPU, " + std::to_string(gpuBytes / 1024) + " KB GPU ===");
+        for (const auto& info : infos)
+        {
+            logger.Info("  " + info.key + " refs=" + std::to_string(info.references) +
+                        " cpu=" + std::to_string(info.cpuBytes / 1024) + "KB gpu=" +
+                        std::to_string(info.gpuBytes / 1024) + "KB");
+        }
+    }
+
+} // namespace Renderer
@@ -0,0 +1,1470 @@
+#include "Renderer/Resources/GLTFLoader.hpp"
+#include "Core/MappedFile.hpp"
+#include "Core/Logger.hpp"
+#include "Core/Profiler.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace Renderer
+{
+
+    namespace
+    {
+        // ============================================================
+        // 最小 JSON DOM（glTF 的 JSON 部分通常只有几 KB ~ 几 MB，几何数据都在二进制缓冲区中）
+        // ============================================================
+
+        struct JsonValue
+        {
+            enum class Type { Null, Bool, Number, String, Array, Object };
+
+            Type type = Type::Null;
+            bool boolean = false;
+            double number = 0.0;
+            std::string string;
+            std::vector<JsonValue> items;                            // Array
+            std::vector<std::pair<std::string, JsonValue>> members;  // Object（保持文件顺序）
+
+            static const JsonValue& Null()
+            {
+                static const JsonValue null;
+                return null;
+            }
+
+            bool IsNull() const { return type == Type::Null; }
+            bool IsNumber() const { return type == Type::Number; }
+            bool IsString() const { return type == Type::String; }
+            bool IsArray() const { return type == Type::Array; }
+            bool IsObject() const { return type == Type::Object; }
+
+            size_t Size() const { return type == Type::Array ? items.size() : 0; }
+
+            const JsonValue* Find(const char* key) const
+            {
+                if (type != Type::Object)
+                    return nullptr;
+                for (const auto& member : members)
+                {
+                    if (member.first == key)
+                        return &member.second;
+                }
+                return nullptr;
+            }
+
+            const JsonValue& operator[](const char* key) const
+            {
+                const JsonValue* value = Find(key);
+                return value ? *value : Null();
+            }
+
+            // 越界或负下标返回 null（下标通常来自文件中的引用，不单独校验）
+            const JsonValue& operator[](int index) const
+            {
+                return type == Type::Array && index >= 0 && static_cast<size_t>(index) < items.size() ? items[index]
+                                                                                                    : Null();
+            }
+
+            double AsNumber(double fallback) const { return type == Type::Number ? number : fallback; }
+
+            // 非负整数（缺失、非整数或超出范围时返回 fallback）
+            int AsIndex(int fallback = -1) const
+            {
+                if (type != Type::Number || number < 0.0 || number > 2147483647.0 || number != std::floor(number))
+                    return fallback;
+                return static_cast<int>(number);
+            }
+
+            // 字节数 / 偏移 / 数量（上限 2^53，避免后续乘法溢出前先拒绝异常值）
+            bool AsSize(size_t& out, size_t fallback) const
+            {
+                if (type == Type::Null)
+                {
+                    out = fallback;
+                    return true;
+                }
+                if (type != Type::Number || number < 0.0 || number > 9007199254740992.0 ||
+                    number != std::floor(number))
+                    return false;
+                out = static_cast<size_t>(number);
+                return true;
+            }
+
+            const std::string& AsString() const { return type == Type::String ? string : Null().string; }
+        };
+
+        class JsonParser
+        {
+        public:
+            JsonParser(const char* begin, const char* end) : m_pos(begin), m_begin(begin), m_end(end) {}
+
+            bool Parse(JsonValue& out, std::string& err)
+            {
+                SkipWhitespace();
+                if (ParseValue(out, 0))
+                {
+                    SkipWhitespace();
+                    if (m_pos == m_end)
+                        return true;
+                    Fail("unexpected trailing characters");
+                }
+                err = m_error + " at offset " + std::to_string(m_pos - m_begin);
+                return false;
+            }
+
+        private:
+            static constexpr int kMaxDepth = 128;
+
+            bool Fail(const char* message)
+            {
+                if (m_error.empty())
+                    m_error = message;
+                return false;
+            }
+
+            void SkipWhitespace()
+            {
+                while (m_pos < m_end && (*m_pos == ' ' || *m_pos == '\t' || *m_pos == '\n' || *m_pos == '\r'))
+                    ++m_pos;
+            }
+
+            bool Consume(const char* literal)
+            {
+                const size_t length = std::strlen(literal);
+                if (static_cast<size_t>(m_end - m_pos) < length || std::memcmp(m_pos, literal, length) != 0)
+                    return Fail("invalid literal");
+                m_pos += length;
+                return true;
+            }
+
+            bool ParseValue(JsonValue& out, int depth)
+            {
+                if (depth > kMaxDepth)
+                    return Fail("nesting too deep");
+                if (m_pos >= m_end)
+                    return Fail("unexpected end of input");
+
+                switch (*m_pos)
+                {
+                case '{':
+                    return ParseObject(out, depth);
+                case '[':
+                    return ParseArray(out, depth);
+                case '"':
+                    out.type = JsonValue::Type::String;
+                    return ParseString(out.string);
+                case 't':
+                    out.type = JsonValue::Type::Bool;
+                    out.boolean = true;
+                    return Consume("true");
+                case 'f':
+                    out.type = JsonValue::Type::Bool;
+                    out.boolean = false;
+                    return Consume("false");
+                case 'n':
+                    out.type = JsonValue::Type::Null;
+                    return Consume("null");
+                default:
+                    return ParseNumber(out);
+                }
+            }
+
+            bool ParseObject(JsonValue& out, int depth)
+            {
+                out.type = JsonValue::Type::Object;
+                ++m_pos;  // '{'
+                SkipWhitespace();
+                if (m_pos < m_end && *m_pos == '}')
+                {
+                    ++m_pos;
+                    return true;
+                }
+                while (true)
+                {
+                    SkipWhitespace();
+                    if (m_pos >= m_end || *m_pos != '"')
+                        return Fail("expected object key");
+                    out.members.emplace_back();
+                    if (!ParseString(out.members.back().first))
+                        return false;
+                    SkipWhitespace();
+                    if (m_pos >= m_end || *m_pos != ':')
+                        return Fail("expected ':'");
+                    ++m_pos;
+                    SkipWhitespace();
+                    if (!ParseValue(out.members.back().second, depth + 1))
+                        return false;
+                    SkipWhitespace();
+                    if (m_pos < m_end && *m_pos == ',')
+                    {
+                        ++m_pos;
+                        continue;
+                    }
+                    if (m_pos < m_end && *m_pos == '}')
+                    {
+                        ++m_pos;
+                        return true;
+                    }
+                    return Fail("expected ',' or '}'");
+                }
+            }
+
+            bool ParseArray(JsonValue& out, int depth)
+            {
+                out.type = JsonValue::Type::Array;
+                ++m_pos;  // '['
+                SkipWhitespace();
+                if (m_pos < m_end && *m_pos == ']')
+                {
+                    ++m_pos;
+                    return true;
+                }
+                while (true)
+                {
+                    SkipWhitespace();
+                    out.items.emplace_back();
+                    if (!ParseValue(out.items.back(), depth + 1))
+                        return false;
+                    SkipWhitespace();
+                    if (m_pos < m_end && *m_pos == ',')
+                    {
+                        ++m_pos;
+                        continue;
+                    }
+                    if (m_pos < m_end && *m_pos == ']')
+                    {
+                        ++m_pos;
+                        return true;
+                    }
+                    return Fail("expected ',' or ']'");
+                }
+            }
+
+            static void AppendUtf8(std::string& out, uint32_t codepoint)
+            {
+                if (codepoint < 0x80)
+                {
+                    out += static_cast<char>(codepoint);
+                }
+                else if (codepoint < 0x800)
+                {
+                    out += static_cast<char>(0xC0 | (codepoint >> 6));
+                    out += static_cast<char>(0x80 | (codepoint & 0x3F));
+                }
+                else if (codepoint < 0x10000)
+                {
+                    out += static_cast<char>(0xE0 | (codepoint >> 12));
+                    out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+                    out += static_cast<char>(0x80 | (codepoint & 0x3F));
+                }
+                else
+                {
+                    out += static_cast<char>(0xF0 | (codepoint >> 18));
+                    out += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+                    out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+                    out += static_cast<char>(0x80 | (codepoint & 0x3F));
+                }
+            }
+
+            bool ParseHex4(uint32_t& out)
+            {
+                if (m_end - m_pos < 4)
+                    return Fail("truncated \\u escape");
+                out = 0;
+                for (int i = 0; i < 4; ++i)
+                {
+                    const char c = *m_pos++;
+                    out <<= 4;
+                    if (c >= '0' && c <= '9')
+                        out |= static_cast<uint32_t>(c - '0');
+                    else if (c >= 'a' && c <= 'f')
+                        out |= static_cast<uint32_t>(c - 'a' + 10);
+                    else if (c >= 'A' && c <= 'F')
+                        out |= static_cast<uint32_t>(c - 'A' + 10);
+                    else
+                        return Fail("invalid \\u escape");
+                }
+                return true;
+            }
+
+            bool ParseString(std::string& out)
+            {
+                ++m_pos;  // '"'
+                while (m_pos < m_end)
+                {
+                    const char c = *m_pos++;
+                    if (c == '"')
+                        return true;
+                    if (static_cast<unsigned char>(c) < 0x20)
+                        return Fail("control character in string");
+                    if (c != '\\')
+                    {
+                        out += c;
+                        continue;
+                    }
+                    if (m_pos >= m_end)
+                        break;
+                    switch (*m_pos++)
+                    {
+                    case '"': out += '"'; break;
+                    case '\\': out += '\\'; break;
+                    case '/': out += '/'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'n': out += '\n'; break;
+                    case 'r': out += '\r'; break;
+                    case 't': out += '\t'; break;
+                    case 'u':
+                    {
+                        uint32_t codepoint = 0;
+                        if (!ParseHex4(codepoint))
+                            return false;
+                        // UTF-16 代理对
+                        if (codepoint >= 0xD800 && codepoint <= 0xDBFF && m_end - m_pos >= 6 &&
+                            m_pos[0] == '\\' && m_pos[1] == 'u')
+                        {
+                            m_pos += 2;
+                            uint32_t low = 0;
+                            if (!ParseHex4(low))
+                                return false;
+                            if (low >= 0xDC00 && low <= 0xDFFF)
+                                codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                            else
+                                return Fail("invalid surrogate pair");
+                        }
+                        AppendUtf8(out, codepoint);
+                        break;
+                    }
+                    default:
+                        return Fail("invalid escape");
+                    }
+                }
+                return Fail("unterminated string");
+            }
+
+            bool ParseNumber(JsonValue& out)
+            {
+                // 映射的文本没有结尾的 '\0'，先复制到局部缓冲区再交给 strtod
+                char buffer[64];
+                size_t length = 0;
+                while (m_pos + length < m_end && length < sizeof(buffer) - 1)
+                {
+                    const char c = m_pos[length];
+                    if (!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E'))
+                        break;
+                    buffer[length++] = c;
+                }
+                if (length == 0)
+                    return Fail("unexpected character");
+                buffer[length] = '\0';
+
+                char* parsedEnd = nullptr;
+                out.type = JsonValue::Type::Number;
+                out.number = std::strtod(buffer, &parsedEnd);
+                if (parsedEnd != buffer + length || !std::isfinite(out.number))
+                    return Fail("invalid number");
+                m_pos += length;
+                return true;
+            }
+
+            const char* m_pos;
+            const char* m_begin;
+            const char* m_end;
+            std::string m_error;
+        };
+
+        // ============================================================
+        // URI 工具
+        // ============================================================
+
+        bool DecodeBase64(const char* begin, const char* end, std::vector<uint8_t>& out)
+        {
+            auto value = [](char c) -> int {
+                if (c >= 'A' && c <= 'Z') return c - 'A';
+                if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+                if (c >= '0' && c <= '9') return c - '0' + 52;
+                if (c == '+' || c == '-') return 62;
+                if (c == '/' || c == '_') return 63;
+                return -1;
+            };
+
+            out.clear();
+            out.reserve(static_cast<size_t>(end - begin) / 4 * 3);
+            uint32_t accumulator = 0;
+            int bits = 0;
+            for (const char* p = begin; p < end; ++p)
+            {
+                if (*p == '=')
+                    break;
+                const int v = value(*p);
+                if (v < 0)
+                    return false;
+                accumulator = (accumulator << 6) | static_cast<uint32_t>(v);
+                bits += 6;
+                if (bits >= 8)
+                {
+                    bits -= 8;
+                    out.push_back(static_cast<uint8_t>((accumulator >> bits) & 0xFF));
+                }
+            }
+            return true;
+        }
+
+        // data:[<mime>][;base64],<data>
+        bool DecodeDataUri(const std::string& uri, std::vector<uint8_t>& out, std::string* mimeType = nullptr)
+        {
+            const size_t comma = uri.find(',');
+            if (uri.compare(0, 5, "data:") != 0 || comma == std::string::npos)
+                return false;
+            const std::string header = uri.substr(5, comma - 5);
+            const size_t base64 = header.find(";base64");
+            if (base64 == std::string::npos)
+                return false;
+            if (mimeType)
+                *mimeType = header.substr(0, header.find(';'));
+            return DecodeBase64(uri.data() + comma + 1, uri.data() + uri.size(), out);
+        }
+
+        // 相对 URI 中的 %XX 转义（例如空格写作 %20）
+        std::string DecodePercent(const std::string& uri)
+        {
+            std::string out;
+            out.reserve(uri.size());
+            for (size_t i = 0; i < uri.size(); ++i)
+            {
+                if (uri[i] == '%' && i + 2 < uri.size() && std::isxdigit(static_cast<unsigned char>(uri[i + 1])) &&
+                    std::isxdigit(static_cast<unsigned char>(uri[i + 2])))
+                {
+                    out += static_cast<char>(std::stoi(uri.substr(i + 1, 2), nullptr, 16));
+                    i += 2;
+                }
+                else
+                {
+                    out += uri[i];
+                }
+            }
+            return out;
+        }
+
+        constexpr const char* kEmbeddedImageTag = "#image";
+
+        std::string BasePathOf(const std::string& filepath)
+        {
+            std::string basePath = fs::path(filepath).parent_path().string();
+            if (!basePath.empty() && basePath.back() != fs::path::preferred_separator)
+            {
+                basePath += fs::path::preferred_separator;
+            }
+            return basePath;
+        }
+
+        // ============================================================
+        // 缓冲区与访问器
+        // ============================================================
+
+        constexpr uint32_t kGLBMagic = 0x46546C67;      // "glTF"
+        constexpr uint32_t kGLBChunkJSON = 0x4E4F534A;  // "JSON"
+        constexpr uint32_t kGLBChunkBIN = 0x004E4942;   // "BIN\0"
+
+        constexpr int kComponentByte = 5120;
+        constexpr int kComponentUnsignedByte = 5121;
+        constexpr int kComponentShort = 5122;
+        constexpr int kComponentUnsignedShort = 5123;
+        constexpr int kComponentUnsignedInt = 5125;
+        constexpr int kComponentFloat = 5126;
+
+        constexpr int kModeTriangles = 4;
+        constexpr int kModeTriangleStrip = 5;
+        constexpr int kModeTriangleFan = 6;
+
+        constexpr int kMaxNodeDepth = 64;
+
+        struct BufferData
+        {
+            const uint8_t* data = nullptr;
+            size_t size = 0;
+            std::shared_ptr<const void> owner;  // MappedFile 或解码后的 vector，MeshData 视图共享
+        };
+
+        struct AccessorView
+        {
+            const uint8_t* data = nullptr;  // 第 0 个元素
+            size_t count = 0;
+            size_t stride = 0;              // 相邻元素的字节距离
+            int componentType = 0;
+            int components = 0;
+            bool normalized = false;
+            int bufferView = -1;
+            const BufferData* buffer = nullptr;
+        };
+
+        size_t ComponentSize(int componentType)
+        {
+            switch (componentType)
+            {
+            case kComponentByte:
+            case kComponentUnsignedByte:
+                return 1;
+            case kComponentShort:
+            case kComponentUnsignedShort:
+                return 2;
+            case kComponentUnsignedInt:
+            case kComponentFloat:
+                return 4;
+            default:
+                return 0;
+            }
+        }
+
+        int ComponentCount(const std::string& type)
+        {
+            if (type == "SCALAR") return 1;
+            if (type == "VEC2") return 2;
+            if (type == "VEC3") return 3;
+            if (type == "VEC4") return 4;
+            return 0;
+        }
+
+        bool IsAligned(const void* p, size_t alignment)
+        {
+            return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+        }
+
+        // 读取一个分量并转换为 float（归一化整数按 glTF 规则映射到 [0, 1] / [-1, 1]，用于 KHR_mesh_quantization）
+        float ReadComponent(const AccessorView& view, size_t element, int component)
+        {
+            const uint8_t* p = view.data + element * view.stride + component * ComponentSize(view.componentType);
+            switch (view.componentType)
+            {
+            case kComponentFloat:
+            {
+                float value;
+                std::memcpy(&value, p, sizeof(value));
+                return value;
+            }
+            case kComponentUnsignedByte:
+                return view.normalized ? *p / 255.0f : static_cast<float>(*p);
+            case kComponentByte:
+            {
+                const float value = static_cast<float>(static_cast<int8_t>(*p));
+                return view.normalized ? std::max(value / 127.0f, -1.0f) : value;
+            }
+            case kComponentUnsignedShort:
+            {
+                uint16_t value;
+                std::memcpy(&value, p, sizeof(value));
+                return view.normalized ? value / 65535.0f : static_cast<float>(value);
+            }
+            case kComponentShort:
+            {
+                int16_t value;
+                std::memcpy(&value, p, sizeof(value));
+                return view.normalized ? std::max(value / 32767.0f, -1.0f) : static_cast<float>(value);
+            }
+            case kComponentUnsignedInt:
+            {
+                uint32_t value;
+                std::memcpy(&value, p, sizeof(value));
+                return static_cast<float>(value);
+            }
+            default:
+                return 0.0f;
+            }
+        }
+
+        uint32_t ReadIndex(const AccessorView& view, size_t element)
+        {
+            const uint8_t* p = view.data + element * view.stride;
+            switch (view.componentType)
+            {
+            case kComponentUnsignedByte:
+                return *p;
+            case kComponentUnsignedShort:
+            {
+                uint16_t value;
+                std::memcpy(&value, p, sizeof(value));
+                return value;
+            }
+            default:
+            {
+                uint32_t value;
+                std::memcpy(&value, p, sizeof(value));
+                return value;
+            }
+            }
+        }
+
+        glm::mat4 NodeLocalTransform(const JsonValue& node, bool& identity)
+        {
+            identity = true;
+            const JsonValue& matrix = node["matrix"];
+            if (matrix.Size() == 16)
+            {
+                glm::mat4 m(1.0f);
+                for (int column = 0; column < 4; ++column)
+                {
+                    for (int row = 0; row < 4; ++row)
+                    {
+                        const float value = static_cast<float>(matrix[column * 4 + row].AsNumber(0.0));
+                        m[column][row] = value;
+                        identity = identity && value == (column == row ? 1.0f : 0.0f);
+                    }
+                }
+                return m;
+            }
+
+            glm::vec3 translation(0.0f);
+            glm::vec3 scale(1.0f);
+            float qx = 0.0f, qy = 0.0f, qz = 0.0f, qw = 1.0f;
+            if (node["translation"].Size() == 3)
+            {
+                for (int i = 0; i < 3; ++i)
+                    translation[i] = static_cast<float>(node["translation"][i].AsNumber(0.0));
+            }
+            if (node["scale"].Size() == 3)
+            {
+                for (int i = 0; i < 3; ++i)
+                    scale[i] = static_cast<float>(node["scale"][i].AsNumber(1.0));
+            }
+            if (node["rotation"].Size() == 4)
+            {
+                qx = static_cast<float>(node["rotation"][0].AsNumber(0.0));
+                qy = static_cast<float>(node["rotation"][1].AsNumber(0.0));
+                qz = static_cast<float>(node["rotation"][2].AsNumber(0.0));
+                qw = static_cast<float>(node["rotation"][3].AsNumber(1.0));
+            }
+            identity = translation == glm::vec3(0.0f) && scale == glm::vec3(1.0f) &&
+                       qx == 0.0f && qy == 0.0f && qz == 0.0f && qw == 1.0f;
+
+            // T * R * S（四元数按 xyzw 存储）
+            glm::mat4 m(1.0f);
+            m[0] = glm::vec4(1.0f - 2.0f * (qy * qy + qz * qz), 2.0f * (qx * qy + qz * qw), 2.0f * (qx * qz - qy * qw), 0.0f) * scale.x;
+            m[1] = glm::vec4(2.0f * (qx * qy - qz * qw), 1.0f - 2.0f * (qx * qx + qz * qz), 2.0f * (qy * qz + qx * qw), 0.0f) * scale.y;
+            m[2] = glm::vec4(2.0f * (qx * qz + qy * qw), 2.0f * (qy * qz - qx * qw), 1.0f - 2.0f * (qx * qx + qy * qy), 0.0f) * scale.z;
+            m[3] = glm::vec4(translation, 1.0f);
+            return m;
+        }
+
+        // ============================================================
+        // 导入过程（一次 LoadFromFile 的全部状态）
+        // ============================================================
+
+        class GLTFImporter
+        {
+        public:
+            GLTFImporter(const std::string& filepath, const std::string& basePath,
+                         std::vector<GLTFPrimitive>& primitives, std::vector<OBJMaterial>& materials,
+                         GLTFImportStats& stats)
+                : m_filepath(filepath), m_basePath(basePath), m_primitives(primitives), m_materials(materials),
+                  m_stats(stats)
+            {
+            }
+
+            bool Run()
+            {
+                if (!Open())
+                    return false;
+                ConvertMaterials();
+
+                // 默认场景；没有场景时导入所有 mesh（规范允许只包含 mesh 的文件）
+                const JsonValue& scenes = m_root["scenes"];
+                if (scenes.Size() > 0)
+                {
+                    const JsonValue& scene = scenes[m_root["scene"].AsIndex(0)];
+                    for (const JsonValue& node : scene["nodes"].items)
+                    {
+                        ImportNode(node.AsIndex(), glm::mat4(1.0f), true, 0);
+                    }
+                }
+                else
+                {
+                    for (size_t mesh = 0; mesh < m_root["meshes"].Size(); ++mesh)
+                    {
+                        ImportMesh(static_cast<int>(mesh), glm::mat4(1.0f), true);
+                    }
+                }
+                return true;
+            }
+
+            const std::vector<std::string>& GetBufferFiles() const { return m_bufferFiles; }
+
+            // 映射文件、解析 JSON 和缓冲区（Run 与 ReadImage 共用）
+            bool Open()
+            {
+                auto file = std::make_shared<Core::MappedFile>();
+                if (!file->Open(m_filepath) || file->Size() == 0)
+                {
+                    Error("cannot open file");
+                    return false;
+                }
+
+                const char* jsonBegin = reinterpret_cast<const char*>(file->Data());
+                const char* jsonEnd = jsonBegin + file->Size();
+                BufferData binChunk;
+                if (file->Size() >= 12 && ReadU32(file->Data()) == kGLBMagic)
+                {
+                    if (!ParseGLB(file, jsonBegin, jsonEnd, binChunk))
+                        return false;
+                }
+
+                std::string err;
+                if (!JsonParser(jsonBegin, jsonEnd).Parse(m_root, err))
+                {
+                    Error("invalid JSON: " + err);
+                    return false;
+                }
+                if (m_root["asset"]["version"].AsString().compare(0, 2, "2.") != 0)
+                {
+                    Error("unsupported glTF version '" + m_root["asset"]["version"].AsString() + "'");
+                    return false;
+                }
+                for (const JsonValue& extension : m_root["extensionsRequired"].items)
+                {
+                    const std::string& name = extension.AsString();
+                    if (name == "KHR_draco_mesh_compression" || name == "EXT_meshopt_compression")
+                    {
+                        Error("required extension " + name + " is not supported");
+                        return false;
+                    }
+                    if (name != "KHR_mesh_quantization")
+                    {
+                        Warning("required extension " + name + " is ignored");
+                    }
+                }
+
+                return LoadBuffers(binChunk);
+            }
+
+            // 嵌入图像（bufferView / data URI）的编码数据：bufferView 直接引用文件映射，data URI 解码到 storage
+            bool ReadImage(int imageIndex, const uint8_t*& outData, size_t& outSize, std::vector<uint8_t>& storage) const
+            {
+                const JsonValue& image = m_root["images"][imageIndex];
+                if (imageIndex < 0 || !image.IsObject())
+                {
+                    Error("invalid image " + std::to_string(imageIndex));
+                    return false;
+                }
+
+                const std::string& uri = image["uri"].AsString();
+                if (!uri.empty())
+                {
+                    if (!DecodeDataUri(uri, storage))
+                    {
+                        Error("image " + std::to_string(imageIndex) + " is not embedded");
+                        return false;
+                    }
+                    outData = storage.data();
+                    outSize = storage.size();
+                    return true;
+                }
+
+                const JsonValue& view = m_root["bufferViews"][image["bufferView"].AsIndex()];
+                const int buffer = view["buffer"].AsIndex();
+                size_t offset = 0, length = 0;
+                if (image["bufferView"].AsIndex() < 0 || buffer < 0 || static_cast<size_t>(buffer) >= m_buffers.size() ||
+                    !view["byteOffset"].AsSize(offset, 0) || !view["byteLength"].AsSize(length, 0) ||
+                    offset > m_buffers[buffer].size || length > m_buffers[buffer].size - offset)
+                {
+                    Error("image " + std::to_string(imageIndex) + " has an invalid bufferView");
+                    return false;
+                }
+                outData = m_buffers[buffer].data + offset;
+                outSize = length;
+                return true;
+            }
+
+        private:
+            static uint32_t ReadU32(const uint8_t* p)
+            {
+                uint32_t value;
+                std::memcpy(&value, p, sizeof(value));
+                return value;
+            }
+
+            void Error(const std::string& message) const
+            {
+                Core::Logger::GetInstance().Error("GLTFLoader::LoadFromFile() - " + m_filepath + ": " + message);
+            }
+
+            void Warning(const std::string& message) const
+            {
+                Core::Logger::GetInstance().Warning("GLTFLoader::LoadFromFile() - " + m_filepath + ": " + message);
+            }
+
+            // GLB：12 字节文件头 + JSON 块 + 可选 BIN 块（块按 4 字节对齐，BIN 中的 float 数据可直接引用）
+            bool ParseGLB(const std::shared_ptr<Core::MappedFile>& file, const char*& jsonBegin, const char*& jsonEnd,
+                          BufferData& binChunk)
+            {
+                const uint8_t* data = file->Data();
+                const size_t size = std::min<size_t>(file->Size(), ReadU32(data + 8));
+                if (ReadU32(data + 4) != 2)
+                {
+                    Error("unsupported GLB version " + std::to_string(ReadU32(data + 4)));
+                    return false;
+                }
+
+                bool hasJson = false;
+                size_t offset = 12;
+                while (offset + 8 <= size)
+                {
+                    const size_t chunkLength = ReadU32(data + offset);
+                    const uint32_t chunkType = ReadU32(data + offset + 4);
+                    const size_t chunkBegin = offset + 8;
+                    if (chunkLength > size - chunkBegin)
+                    {
+                        Error("truncated GLB chunk");
+                        return false;
+                    }
+                    if (chunkType == kGLBChunkJSON && !hasJson)
+                    {
+                        jsonBegin = reinterpret_cast<const char*>(data + chunkBegin);
+                        jsonEnd = jsonBegin + chunkLength;
+                        hasJson = true;
+                    }
+                    else if (chunkType == kGLBChunkBIN && !binChunk.data)
+                    {
+                        binChunk.data = data + chunkBegin;
+                        binChunk.size = chunkLength;
+                        binChunk.owner = file;
+                    }
+                    offset = chunkBegin + ((chunkLength + 3) & ~static_cast<size_t>(3));
+                }
+                if (!hasJson)
+                {
+                    Error("GLB has no JSON chunk");
+                    return false;
+                }
+                return true;
+            }
+
+            bool LoadBuffers(const BufferData& binChunk)
+            {
+                const JsonValue& buffers = m_root["buffers"];
+                m_buffers.resize(buffers.Size());
+                for (size_t i = 0; i < buffers.Size(); ++i)
+                {
+                    const JsonValue& buffer = buffers[i];
+                    const std::string& uri = buffer["uri"].AsString();
+                    BufferData& out = m_buffers[i];
+                    if (uri.empty())
+                    {
+                        if (i != 0 || !binChunk.data)
+                        {
+                            Error("buffer " + std::to_string(i) + " has no uri and no GLB BIN chunk");
+                            return false;
+                        }
+                        out = binChunk;
+                    }
+                    else if (uri.compare(0, 5, "data:") == 0)
+                    {
+                        auto bytes = std::make_shared<std::vector<uint8_t>>();
+                        if (!DecodeDataUri(uri, *bytes))
+                        {
+                            Error("buffer " + std::to_string(i) + " has an invalid data URI");
+                            return false;
+                        }
+                        out.data = bytes->data();
+                        out.size = bytes->size();
+                        out.owner = bytes;
+                    }
+                    else
+                    {
+                        auto file = std::make_shared<Core::MappedFile>();
+                        const std::string path = m_basePath + DecodePercent(uri);
+                        if (!file->Open(path))
+                        {
+                            Error("cannot open buffer " + path);
+                            return false;
+                        }
+                        out.data = file->Data();
+                        out.size = file->Size();
+                        out.owner = file;
+                        m_bufferFiles.push_back(path);
+                    }
+
+                    // byteLength 之后可能有对齐填充，以 byteLength 为准
+                    size_t byteLength = 0;
+                    if (!buffer["byteLength"].AsSize(byteLength, out.size) || byteLength > out.size)
+                    {
+                        Error("buffer " + std::to_string(i) + " is shorter than its byteLength");
+                        return false;
+                    }
+                    out.size = byteLength;
+                }
+                return true;
+            }
+
+            bool ResolveAccessor(int index, AccessorView& view, std::string& err) const
+            {
+                const JsonValue& accessor = m_root["accessors"][index];
+                if (index < 0 || !accessor.IsObject())
+                {
+                    err = "invalid accessor " + std::to_string(index);
+                    return false;
+                }
+                if (!accessor["sparse"].IsNull())
+                {
+                    err = "sparse accessors are not supported";
+                    return false;
+                }
+
+                view.componentType = accessor["componentType"].AsIndex(0);
+                view.components = ComponentCount(accessor["type"].AsString());
+                view.normalized = accessor["normalized"].boolean;
+                view.bufferView = accessor["bufferView"].AsIndex();
+                const size_t elementSize = ComponentSize(view.componentType) * static_cast<size_t>(view.components);
+                size_t byteOffset = 0;
+                if (elementSize == 0 || !accessor["count"].AsSize(view.count, 0) ||
+                    !accessor["byteOffset"].AsSize(byteOffset, 0))
+                {
+                    err = "accessor " + std::to_string(index) + " has an invalid type or count";
+                    return false;
+                }
+
+                const JsonValue& bufferView = m_root["bufferViews"][view.bufferView];
+                const int bufferIndex = bufferView["buffer"].AsIndex();
+                size_t viewOffset = 0, viewLength = 0, viewStride = 0;
+                if (view.bufferView < 0 || bufferIndex < 0 || static_cast<size_t>(bufferIndex) >= m_buffers.size() ||
+                    !bufferView["byteOffset"].AsSize(viewOffset, 0) || !bufferView["byteLength"].AsSize(viewLength, 0) ||
+                    !bufferView["byteStride"].AsSize(viewStride, 0))
+                {
+                    err = "accessor " + std::to_string(index) + " has no valid bufferView";
+                    return false;
+                }
+
+                view.buffer = &m_buffers[bufferIndex];
+                view.stride = viewStride != 0 ? viewStride : elementSize;
+                // 先限制 count，再计算末尾偏移（避免恶意文件的乘法溢出）
+                const bool fits = view.stride >= elementSize && viewOffset <= view.buffer->size &&
+                                  viewLength <= view.buffer->size - viewOffset &&
+                                  (view.count == 0 || (view.count - 1) <= viewLength / view.stride);
+                if (!fits || (view.count > 0 && byteOffset + (view.count - 1) * view.stride + elementSize > viewLength))
+                {
+                    err = "accessor " + std::to_string(index) + " is out of bounds";
+                    return false;
+                }
+                view.data = view.buffer->data + viewOffset + byteOffset;
+                return true;
+            }
+
+            void ConvertMaterials()
+            {
+                const JsonValue& materials = m_root["materials"];
+                m_materials.reserve(materials.Size());
+                for (size_t i = 0; i < materials.Size(); ++i)
+                {
+                    const JsonValue& material = materials[i];
+                    const JsonValue& pbr = material["pbrMetallicRoughness"];
+
+                    glm::vec4 baseColor(1.0f);
+                    if (pbr["baseColorFactor"].Size() == 4)
+                    {
+                        for (int c = 0; c < 4; ++c)
+                            baseColor[c] = static_cast<float>(pbr["baseColorFactor"][c].AsNumber(1.0));
+                    }
+                    const float metallic = glm::clamp(static_cast<float>(pbr["metallicFactor"].AsNumber(1.0)), 0.0f, 1.0f);
+                    const float roughness = glm::clamp(static_cast<float>(pbr["roughnessFactor"].AsNumber(1.0)), 0.0f, 1.0f);
+
+                    OBJMaterial converted;
+                    converted.name = material["name"].AsString().empty() ? "material" + std::to_string(i)
+                                                                          : material["name"].AsString();
+                    converted.ambient = glm::vec3(0.0f);
+                    converted.diffuse = glm::vec3(baseColor);
+                    // 金属度：非金属 F0 = 0.04，金属的高光取基础色
+                    converted.specular = glm::mix(glm::vec3(0.04f), glm::vec3(baseColor), metallic);
+                    // 粗糙度 → Blinn-Phong 指数（alpha = r²，n = 2 / alpha² - 2）
+                    const float alpha = std::max(roughness * roughness, 0.03f);
+                    converted.shininess = glm::clamp(2.0f / (alpha * alpha) - 2.0f, 1.0f, 1000.0f);
+                    converted.dissolve = material["alphaMode"].AsString() == "BLEND" ||
+                                                 material["alphaMode"].AsString() == "MASK"
+                                             ? baseColor.a
+                                             : 1.0f;
+                    converted.diffuseTexname = ResolveTexture(pbr["baseColorTexture"]["index"].AsIndex());
+                    converted.normalTexname = ResolveTexture(material["normalTexture"]["index"].AsIndex());
+                    m_materials.push_back(std::move(converted));
+                }
+            }
+
+            // 纹理 → 相对 basePath 的图像文件名；嵌入的图像（bufferView / data URI）不导出文件，
+            // 纹理名为 "<文件名>#image<N>"，与 basePath 拼接即 GLTFLoader::MakeEmbeddedImageKey，由 Texture::Decode 在内存中解码
+            std::string ResolveTexture(int textureIndex)
+            {
+                if (textureIndex < 0)
+                    return {};
+                const int imageIndex = m_root["textures"][textureIndex]["source"].AsIndex();
+                if (imageIndex < 0)
+                    return {};
+
+                const JsonValue& image = m_root["images"][imageIndex];
+                const std::string& uri = image["uri"].AsString();
+                if (!uri.empty() && uri.compare(0, 5, "data:") != 0)
+                {
+                    return DecodePercent(uri);
+                }
+                if (uri.empty() && image["bufferView"].AsIndex() < 0)
+                {
+                    Warning("image " + std::to_string(imageIndex) + " has neither uri nor bufferView");
+                    return {};
+                }
+                return fs::path(m_filepath).filename().string() + kEmbeddedImageTag + std::to_string(imageIndex);
+            }
+
+            void ImportNode(int nodeIndex, const glm::mat4& parent, bool parentIdentity, int depth)
+            {
+                const JsonValue& node = m_root["nodes"][nodeIndex];
+                if (nodeIndex < 0 || !node.IsObject() || depth > kMaxNodeDepth)
+                {
+                    Warning("skipping invalid node " + std::to_string(nodeIndex));
+                    return;
+                }
+
+                bool localIdentity = true;
+                const glm::mat4 local = NodeLocalTransform(node, localIdentity);
+                const bool identity = parentIdentity && localIdentity;
+                const glm::mat4 world = localIdentity ? parent : parent * local;
+
+                if (node["mesh"].AsIndex() >= 0)
+                {
+                    ImportMesh(node["mesh"].AsIndex(), world, identity);
+                }
+                for (const JsonValue& child : node["children"].items)
+                {
+                    ImportNode(child.AsIndex(), world, identity, depth + 1);
+                }
+            }
+
+            void ImportMesh(int meshIndex, const glm::mat4& world, bool identity)
+            {
+                const JsonValue& mesh = m_root["meshes"][meshIndex];
+                const std::string name = mesh["name"].AsString().empty() ? "mesh" + std::to_string(meshIndex)
+                                                                          : mesh["name"].AsString();
+                for (const JsonValue& primitive : mesh["primitives"].items)
+                {
+                    GLTFPrimitive out;
+                    out.name = name;
+                    std::string err;
+                    if (!ImportPrimitive(primitive, world, identity, out, err))
+                    {
+                        Warning("skipping primitive of " + name + ": " + err);
+                        continue;
+                    }
+                    m_stats.primitives++;
+                    m_stats.vertices += out.data.GetVertexCount();
+                    m_stats.triangles += out.data.GetIndexCount() / 3;
+                    m_primitives.push_back(std::move(out));
+                }
+            }
+
+            bool ImportPrimitive(const JsonValue& primitive, const glm::mat4& world, bool identity,
+                                 GLTFPrimitive& out, std::string& err)
+            {
+                const int mode = primitive["mode"].AsIndex(kModeTriangles);
+                if (mode != kModeTriangles && mode != kModeTriangleStrip && mode != kModeTriangleFan)
+                {
+                    err = "mode " + std::to_string(mode) + " is not a triangle mode";
+                    return false;
+                }
+
+                const int materialIndex = primitive["material"].AsIndex();
+                out.materialIndex = materialIndex >= 0 && static_cast<size_t>(materialIndex) < m_materials.size()
+                                        ? materialIndex
+                                        : -1;
+
+                const JsonValue& attributes = primitive["attributes"];
+                AccessorView position, normal, texCoord;
+                if (!ResolveAccessor(attributes["POSITION"].AsIndex(), position, err) || position.components != 3)
+                {
+                    if (err.empty())
+                        err = "POSITION must be VEC3";
+                    return false;
+                }
+                const bool hasNormal = !attributes["NORMAL"].IsNull();
+                const bool hasTexCoord = !attributes["TEXCOORD_0"].IsNull();
+                if (hasNormal && (!ResolveAccessor(attributes["NORMAL"].AsIndex(), normal, err) ||
+                                  normal.components != 3 || normal.count != position.count))
+                {
+                    if (err.empty())
+                        err = "NORMAL does not match POSITION";
+                    return false;
+                }
+                if (hasTexCoord && (!ResolveAccessor(attributes["TEXCOORD_0"].AsIndex(), texCoord, err) ||
+                                    texCoord.components != 2 || texCoord.count != position.count))
+                {
+                    if (err.empty())
+                        err = "TEXCOORD_0 does not match POSITION";
+                    return false;
+                }
+
+                const size_t vertexCount = position.count;
+                if (vertexCount == 0 || vertexCount > 0xFFFFFFFFull)
+                {
+                    err = "invalid vertex count";
+                    return false;
+                }
+
+                // 负行列式的变换会翻转绕序
+                const glm::vec3 c0(world[0]), c1(world[1]), c2(world[2]);
+                const bool flipWinding = !identity && glm::dot(glm::cross(c0, c1), c2) < 0.0f;
+
+                // ---------- 索引 ----------
+                std::vector<unsigned int> indices;
+                const JsonValue& indicesValue = primitive["indices"];
+                if (!indicesValue.IsNull())
+                {
+                    AccessorView indexView;
+                    if (!ResolveAccessor(indicesValue.AsIndex(), indexView, err))
+                        return false;
+                    if (indexView.components != 1 || (indexView.componentType != kComponentUnsignedByte &&
+                                                      indexView.componentType != kComponentUnsignedShort &&
+                                                      indexView.componentType != kComponentUnsignedInt))
+                    {
+                        err = "indices must be unsigned SCALAR";
+                        return false;
+                    }
+
+                    // ✅ 32 位、紧密排列、对齐的三角形列表：直接引用映射（只检查范围）
+                    //    MeshData 只持有一个视图所有者，索引与位置必须在同一个缓冲区
+                    const bool mapIndices = indexView.buffer == position.buffer &&
+                                            indexView.componentType == kComponentUnsignedInt &&
+                                            indexView.stride == sizeof(uint32_t) &&
+                                            IsAligned(indexView.data, alignof(uint32_t)) &&
+                                            mode == kModeTriangles && !flipWinding && indexView.count % 3 == 0;
+                    if (mapIndices)
+                    {
+                        const auto* mapped = reinterpret_cast<const unsigned int*>(indexView.data);
+                        if (std::any_of(mapped, mapped + indexView.count,
+                                        [vertexCount](unsigned int i) { return i >= vertexCount; }))
+                        {
+                            err = "index out of range";
+                            return false;
+                        }
+                        out.data.SetIndexView(mapped, indexView.count, indexView.buffer->owner);
+                        m_stats.mappedIndexBuffers++;
+                    }
+                    else
+                    {
+                        indices.resize(indexView.count);
+                        for (size_t i = 0; i < indexView.count; ++i)
+                        {
+                            indices[i] = ReadIndex(indexView, i);
+                            if (indices[i] >= vertexCount)
+                            {
+                                err = "index out of range";
+                                return false;
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    // 非索引图元统一生成顺序索引（簇切分与 MeshBuffer 的 16 位索引路径都以索引为准）
+                    indices.resize(vertexCount);
+                    for (size_t i = 0; i < vertexCount; ++i)
+                        indices[i] = static_cast<unsigned int>(i);
+                }
+
+                if (!out.data.HasIndices())
+                {
+                    indices = ToTriangleList(std::move(indices), mode);
+                    if (flipWinding)
+                    {
+                        for (size_t i = 0; i + 2 < indices.size(); i += 3)
+                            std::swap(indices[i + 1], indices[i + 2]);
+                    }
+                    if (indices.empty())
+                    {
+                        err = "no triangles";
+                        return false;
+                    }
+                }
+
+                // ---------- 顶点 ----------
+                // 纹理按 OBJ 约定垂直翻转加载（Texture::LoadFromFile），glTF 的 UV 原点在左上角，
+                // 带纹理的材质需要 v → 1 - v，只能走拷贝路径
+                const bool textured = out.materialIndex >= 0 && (!m_materials[out.materialIndex].diffuseTexname.empty() ||
+                                                                 !m_materials[out.materialIndex].normalTexname.empty());
+                if (identity && hasNormal && hasTexCoord && !textured &&
+                    TryMapInterleaved(position, normal, texCoord, out.data))
+                {
+                    m_stats.mappedVertexBuffers++;
+                }
+                else
+                {
+                    std::vector<float> vertices = CopyVertices(position, hasNormal ? &normal : nullptr,
+                                                               hasTexCoord ? &texCoord : nullptr, world, identity);
+                    if (!hasNormal)
+                    {
+                        const bool mapped = out.data.HasIndices();
+                        ComputeNormals(vertices, mapped ? out.data.GetIndexData() : indices.data(),
+                                       mapped ? out.data.GetIndexCount() : indices.size());
+                    }
+                    out.data.SetVertices(std::move(vertices), 8);
+                    out.data.SetVertexLayout({0, 3, 6}, {3, 3, 2});
+                }
+
+                if (!indices.empty())
+                {
+                    out.data.SetIndices(std::move(indices));
+                }
+                return true;
+            }
+
+            static std::vector<unsigned int> ToTriangleList(std::vector<unsigned int>&& raw, int mode)
+            {
+                if (mode == kModeTriangles)
+                {
+                    raw.resize(raw.size() / 3 * 3);
+                    return std::move(raw);
+                }
+
+                std::vector<unsigned int> triangles;
+                if (raw.size() < 3)
+                    return triangles;
+                triangles.reserve((raw.size() - 2) * 3);
+                for (size_t i = 0; i + 2 < raw.size(); ++i)
+                {
+                    if (mode == kModeTriangleFan)
+                    {
+                        triangles.insert(triangles.end(), {raw[0], raw[i + 1], raw[i + 2]});
+                    }
+                    else if (i % 2 == 0)
+                    {
+                        triangles.insert(triangles.end(), {raw[i], raw[i + 1], raw[i + 2]});
+                    }
+                    else
+                    {
+                        triangles.insert(triangles.end(), {raw[i + 1], raw[i], raw[i + 2]});
+                    }
+                }
+                return triangles;
+            }
+
+            // 三个属性是同一 bufferView 中交错的 float 时，MeshData 直接引用映射的数据
+            static bool TryMapInterleaved(const AccessorView& position, const AccessorView& normal,
+                                          const AccessorView& texCoord, MeshData& data)
+            {
+                const AccessorView* views[3] = {&position, &normal, &texCoord};
+                for (const AccessorView* view : views)
+                {
+                    if (view->componentType != kComponentFloat || view->normalized ||
+                        view->bufferView != position.bufferView || view->stride != position.stride)
+                        return false;
+                }
+                const size_t stride = position.stride;
+                if (stride % sizeof(float) != 0)
+                    return false;
+
+                const uint8_t* base = std::min({position.data, normal.data, texCoord.data});
+                const BufferData& buffer = *position.buffer;
+                if (!IsAligned(base, alignof(float)) ||
+                    static_cast<size_t>(buffer.data + buffer.size - base) / stride < position.count)
+                    return false;  // 最后一个顶点的步长超出缓冲区末尾时不能按 count * stride 引用
+
+                std::vector<size_t> offsets;
+                for (const AccessorView* view : views)
+                {
+                    const size_t offset = static_cast<size_t>(view->data - base);
+                    if (offset + view->components * sizeof(float) > stride)
+                        return false;
+                    offsets.push_back(offset / sizeof(float));
+                }
+
+                const size_t strideWords = stride / sizeof(float);
+                data.SetVertexView(reinterpret_cast<const float*>(base), position.count * strideWords, strideWords,
+                                   buffer.owner);
+                data.SetVertexLayout(offsets, {3, 3, 2});
+                return true;
+            }
+
+            static std::vector<float> CopyVertices(const AccessorView& position, const AccessorView* normal,
+                                                   const AccessorView* texCoord, const glm::mat4& world, bool identity)
+            {
+                const size_t count = position.count;
+                const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(world)));
+                std::vector<float> vertices(count * 8);
+                float* out = vertices.data();
+                for (size_t i = 0; i < count; ++i, out += 8)
+                {
+                    glm::vec3 p(ReadComponent(position, i, 0), ReadComponent(position, i, 1), ReadComponent(position, i, 2));
+                    glm::vec3 n(0.0f, 1.0f, 0.0f);
+                    if (normal)
+                    {
+                        n = glm::vec3(ReadComponent(*normal, i, 0), ReadComponent(*normal, i, 1), ReadComponent(*normal, i, 2));
+                    }
+                    if (!identity)
+                    {
+                        p = glm::vec3(world * glm::vec4(p, 1.0f));
+                        n = normalMatrix * n;
+                    }
+                    const float length = glm::length(n);
+                    if (length > 0.0f)
+                        n /= length;
+
+                    out[0] = p.x;
+                    out[1] = p.y;
+                    out[2] = p.z;
+                    out[3] = n.x;
+                    out[4] = n.y;
+                    out[5] = n.z;
+                    out[6] = texCoord ? ReadComponent(*texCoord, i, 0) : 0.0f;
+                    out[7] = texCoord ? 1.0f - ReadComponent(*texCoord, i, 1) : 0.0f;
+                }
+                return vertices;
+            }
+
+            // 缺少 NORMAL 时按面积加权生成平滑法线（只在拷贝路径中调用）
+            static void ComputeNormals(std::vector<float>& vertices, const unsigned int* indices, size_t indexCount)
+            {
+                const size_t count = vertices.size() / 8;
+                for (size_t v = 0; v < count; ++v)
+                {
+                    vertices[v * 8 + 3] = vertices[v * 8 + 4] = vertices[v * 8 + 5] = 0.0f;
+                }
+                for (size_t i = 0; i + 2 < indexCount; i += 3)
+                {
+                    float* a = &vertices[indices[i] * 8];
+                    float* b = &vertices[indices[i + 1] * 8];
+                    float* c = &vertices[indices[i + 2] * 8];
+                    const glm::vec3 pa(a[0], a[1], a[2]);
+                    const glm::vec3 faceNormal = glm::cross(glm::vec3(b[0], b[1], b[2]) - pa,
+                                                            glm::vec3(c[0], c[1], c[2]) - pa);
+                    for (float* corner : {a, b, c})
+                    {
+                        corner[3] += faceNormal.x;
+                        corner[4] += faceNormal.y;
+                        corner[5] += faceNormal.z;
+                    }
+                }
+                for (size_t v = 0; v < count; ++v)
+                {
+                    float* n = &vertices[v * 8 + 3];
+                    const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                    if (length > 0.0f)
+                    {
+                        n[0] /= length;
+                        n[1] /= length;
+                        n[2] /= length;
+                    }
+                    else
+                    {
+                        n[1] = 1.0f;
+                    }
+                }
+            }
+
+            std::string m_filepath;
+            std::string m_basePath;
+            std::vector<GLTFPrimitive>& m_primitives;
+            std::vector<OBJMaterial>& m_materials;
+            GLTFImportStats& m_stats;
+
+            JsonValue m_root;
+            std::vector<BufferData> m_buffers;
+            std::vector<std::string> m_bufferFiles;  // 外部 .bin 文件
+        };
+    } // namespace
+
+    GLTFLoader::GLTFLoader() = default;
+
+    GLTFLoader::~GLTFLoader() = default;
+
+    bool GLTFLoader::LoadFromFile(const std::string& filepath)
+    {
+        PROFILE_SCOPE("GLTFLoader::LoadFromFile");
+        Clear();
+        m_basePath = BasePathOf(filepath);
+
+        GLTFImporter importer(filepath, m_basePath, m_primitives, m_materials, m_stats);
+        if (!importer.Run())
+        {
+            Clear();
+            return false;
+        }
+        m_sourceFiles.push_back(filepath);
+        m_sourceFiles.insert(m_sourceFiles.end(), importer.GetBufferFiles().begin(), importer.GetBufferFiles().end());
+
+        Core::Logger::GetInstance().Info("GLTFLoader::LoadFromFile() - Loaded " + filepath + ": " +
+                                         std::to_string(m_stats.primitives) + " primitives, " +
+                                         std::to_string(m_stats.vertices) + " vertices, " +
+                                         std::to_string(m_stats.triangles) + " triangles, " +
+                                         std::to_string(m_materials.size()) + " materials (" +
+                                         std::to_string(m_stats.mappedVertexBuffers) + " vertex / " +
+                                         std::to_string(m_stats.mappedIndexBuffers) + " index buffers mapped)");
+        return !m_primitives.empty();
+    }
+
+    std::string GLTFLoader::MakeEmbeddedImageKey(const std::string& gltfPath, int imageIndex)
+    {
+        return gltfPath + kEmbeddedImageTag + std::to_string(imageIndex);
+    }
+
+    bool GLTFLoader::ParseEmbeddedImageKey(const std::string& key, std::string& outGLTFPath, int& outImageIndex)
+    {
+        const size_t tag = key.rfind(kEmbeddedImageTag);
+        const size_t digits = tag == std::string::npos ? 0 : tag + std::strlen(kEmbeddedImageTag);
+        if (tag == std::string::npos || digits == key.size() || key.size() - digits > 9 ||
+            !std::all_of(key.begin() + digits, key.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); }))
+        {
+            return false;
+        }
+
+        std::string extension = fs::path(key.substr(0, tag)).extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (extension != ".gltf" && extension != ".glb")
+        {
+            return false;
+        }
+        outGLTFPath = key.substr(0, tag);
+        outImageIndex = std::atoi(key.c_str() + digits);
+        return true;
+    }
+
+    bool GLTFLoader::ReadEmbeddedImage(const std::string& key, std::vector<uint8_t>& outBytes)
+    {
+        PROFILE_SCOPE("GLTFLoader::ReadEmbeddedImage");
+        std::string gltfPath;
+        int imageIndex = -1;
+        if (!ParseEmbeddedImageKey(key, gltfPath, imageIndex))
+        {
+            return false;
+        }
+
+        // 只映射文件并解析 JSON / 缓冲区，不导入网格
+        std::vector<GLTFPrimitive> primitives;
+        std::vector<OBJMaterial> materials;
+        GLTFImportStats stats;
+        GLTFImporter importer(gltfPath, BasePathOf(gltfPath), primitives, materials, stats);
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        std::vector<uint8_t> storage;
+        if (!importer.Open() || !importer.ReadImage(imageIndex, data, size, storage))
+        {
+            return false;
+        }
+
+        if (!storage.empty())
+            outBytes = std::move(storage);
+        else
+            outBytes.assign(data, data + size);
+        return true;
+    }
+
+    void GLTFLoader::Clear()
+    {
+        m_primitives.clear();
+        m_materials.clear();
+        m_basePath.clear();
+        m_sourceFiles.clear();
+        m_stats = GLTFImportStats();
+    }
+
+} // namespace Renderer
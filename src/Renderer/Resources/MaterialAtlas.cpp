@@ -0,0 +1,177 @@
+#include "Renderer/Resources/MaterialAtlas.hpp"
+#include "Core/Logger.hpp"
+#include <stb_image.h>
+#include <algorithm>
+
+namespace Renderer
+{
+
+    MaterialAtlas::MaterialAtlas(int minSize, int maxSize)
+        : m_minSize(minSize), m_maxSize(std::max(minSize, maxSize))
+    {
+    }
+
+    int MaterialAtlas::GetResolutionClassSize(int width, int height) const
+    {
+        int longest = std::max(width, height);
+        int size = 1;
+        while (size < longest)
+        {
+            size <<= 1;
+        }
+        return std::clamp(size, m_minSize, m_maxSize);
+    }
+
+    AtlasSlot MaterialAtlas::AddTexture(const std::string& filepath)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_slots.find(filepath);
+            if (it != m_slots.end())
+            {
+                return it->second;
+            }
+        }
+
+        // 只读取头信息确定分辨率档位，解码延迟到 Build()（读文件时不持锁）
+        int width = 0, height = 0, channels = 0;
+        if (!stbi_info(filepath.c_str(), &width, &height, &channels))
+        {
+            Core::Logger::GetInstance().Warning("MaterialAtlas::AddTexture() - Cannot read texture: " + filepath);
+            return AtlasSlot();
+        }
+        int classSize = GetResolutionClassSize(width, height);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // 其他线程可能在读文件期间加入了同一纹理
+        auto it = m_slots.find(filepath);
+        if (it != m_slots.end())
+        {
+            return it->second;
+        }
+
+        auto classIt = std::find_if(m_classes.begin(), m_classes.end(),
+                                    [classSize](const ResolutionClass& c) { return c.size == classSize; });
+        if (classIt == m_classes.end())
+        {
+            ResolutionClass newClass;
+            newClass.size = classSize;
+            newClass.array = std::make_shared<TextureArray>();
+            m_classes.push_back(std::move(newClass));
+            classIt = m_classes.end() - 1;
+        }
+
+        AtlasSlot slot;
+        slot.arrayIndex = static_cast<int>(classIt - m_classes.begin());
+        slot.layer = static_cast<int>(classIt->paths.size());
+        classIt->paths.push_back(filepath);
+
+        m_slots[filepath] = slot;
+        return slot;
+    }
+
+    bool MaterialAtlas::Build()
+    {
+        // 在锁内取出待上传的档位快照，解码和上传在锁外进行，不阻塞加载线程的 AddTexture()
+        struct PendingClass
+        {
+            size_t classIndex;
+            int size;
+            std::shared_ptr<TextureArray> array;
+            std::vector<std::string> paths;
+            size_t uploadedLayers;
+        };
+        std::vector<PendingClass> pending;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (size_t i = 0; i < m_classes.size(); ++i)
+            {
+                const ResolutionClass& resolutionClass = m_classes[i];
+                if (resolutionClass.uploadedLayers < resolutionClass.paths.size())
+                {
+                    pending.push_back({i, resolutionClass.size, resolutionClass.array, resolutionClass.paths,
+                                       resolutionClass.uploadedLayers});
+                }
+            }
+        }
+
+        bool success = true;
+        for (PendingClass& resolutionClass : pending)
+        {
+            const std::vector<std::string>& paths = resolutionClass.paths;
+
+            // 优先写入预留的空闲层；空闲层不足（或尚未创建）时扩容并在同一对象上重建
+            TextureArray& array = *resolutionClass.array;
+            std::vector<std::string> newPaths(paths.begin() + resolutionClass.uploadedLayers, paths.end());
+            bool uploaded = array.GetID() != 0 && array.AppendFromFiles(newPaths);
+            if (!uploaded)
+            {
+                int capacity = 1;
+                while (static_cast<size_t>(capacity) < paths.size())
+                {
+                    capacity <<= 1;
+                }
+                uploaded = array.LoadFromFiles(paths, resolutionClass.size, capacity);
+            }
+            if (!uploaded)
+            {
+                success = false;
+            }
+
+            // 快照之后新加入的层留给下一次 Build()
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_classes[resolutionClass.classIndex].uploadedLayers = uploaded ? paths.size() : 0;
+        }
+
+        Core::Logger::GetInstance().Info("MaterialAtlas::Build() - " + std::to_string(GetTextureCount()) + " textures in " +
+                                         std::to_string(GetArrayCount()) + " arrays, " +
+                                         std::to_string(GetGPUSizeBytes() / 1024) + " KB");
+        return success;
+    }
+
+    AtlasSlot MaterialAtlas::GetSlot(const std::string& filepath) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_slots.find(filepath);
+        return it != m_slots.end() ? it->second : AtlasSlot();
+    }
+
+    size_t MaterialAtlas::GetArrayCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_classes.size();
+    }
+
+    std::shared_ptr<TextureArray> MaterialAtlas::GetArray(size_t arrayIndex) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return arrayIndex < m_classes.size() ? m_classes[arrayIndex].array : nullptr;
+    }
+
+    size_t MaterialAtlas::GetTextureCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_slots.size();
+    }
+
+    int MaterialAtlas::GetArraySize(size_t arrayIndex) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return arrayIndex < m_classes.size() ? m_classes[arrayIndex].size : 0;
+    }
+
+    size_t MaterialAtlas::GetGPUSizeBytes() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t total = 0;
+        for (const auto& resolutionClass : m_classes)
+        {
+            if (resolutionClass.array)
+            {
+                total += resolutionClass.array->GetGPUSizeBytes();
+            }
+        }
+        return total;
+    }
+
+} // namespace Renderer
@@ -0,0 +1,160 @@
+#include "Renderer/Resources/MaterialTable.hpp"
+#include "Renderer/Resources/UniformBindings.hpp"
+#include "Renderer/Renderer/FrameStatistics.hpp"
+#include "Core/Logger.hpp"
+#include <glad/glad.h>
+#include <algorithm>
+
+namespace Renderer
+{
+
+    MaterialTable::MaterialTable()
+    {
+        // 索引 0 为默认材质（白色、无纹理），表满或未设置材质索引时使用
+        AddColor(glm::vec3(1.0f), 32.0f, "__default__");
+    }
+
+    MaterialTable::~MaterialTable()
+    {
+        if (m_ubo != 0)
+        {
+            glDeleteBuffers(1, &m_ubo);
+            m_ubo = 0;
+        }
+    }
+
+    unsigned int MaterialTable::Add(const OBJMaterial& material, const AtlasSlot& slot, const std::string& key)
+    {
+        GPUMaterial entry;
+        entry.ambient = glm::vec4(material.ambient, material.dissolve);
+        entry.diffuse = glm::vec4(material.diffuse, slot.IsValid() ? static_cast<float>(slot.layer) : -1.0f);
+        entry.specular = glm::vec4(material.specular, material.shininess);
+        entry.params = glm::vec4(static_cast<float>(slot.arrayIndex), 0.0f, 0.0f, 0.0f);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return Append(entry, key);
+    }
+
+    unsigned int MaterialTable::AddColor(const glm::vec3& diffuse, float shininess, const std::string& key)
+    {
+        GPUMaterial entry;
+        entry.ambient = glm::vec4(diffuse, 1.0f);
+        entry.diffuse = glm::vec4(diffuse, -1.0f);
+        entry.specular = glm::vec4(glm::vec3(0.5f), shininess);
+        entry.params = glm::vec4(-1.0f, 0.0f, 0.0f, 0.0f);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return Append(entry, key);
+    }
+
+    unsigned int MaterialTable::Append(const GPUMaterial& material, const std::string& key)
+    {
+        if (!key.empty())
+        {
+            auto it = m_keyToIndex.find(key);
+            if (it != m_keyToIndex.end())
+            {
+                return it->second;
+            }
+        }
+
+        if (m_materials.size() >= MAX_MATERIALS)
+        {
+            Core::Logger::GetInstance().Warning("MaterialTable::Add() - Table full (" + std::to_string(MAX_MATERIALS) +
+                                                " materials), using default material for: " + key);
+            return 0;
+        }
+
+        unsigned int index = static_cast<unsigned int>(m_materials.size());
+        m_materials.push_back(material);
+        if (!key.empty())
+        {
+            m_keyToIndex[key] = index;
+        }
+        MarkDirty(index);
+        return index;
+    }
+
+    void MaterialTable::Set(unsigned int index, const GPUMaterial& material)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (index >= m_materials.size())
+        {
+            return;
+        }
+        m_materials[index] = material;
+        MarkDirty(index);
+    }
+
+    GPUMaterial MaterialTable::Get(unsigned int index) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return index < m_materials.size() ? m_materials[index] : m_materials[0];
+    }
+
+    size_t MaterialTable::GetCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_materials.size();
+    }
+
+    void MaterialTable::MarkDirty(size_t index)
+    {
+        if (m_dirtyBegin == m_dirtyEnd)
+        {
+            m_dirtyBegin = index;
+            m_dirtyEnd = index + 1;
+        }
+        else
+        {
+            m_dirtyBegin = std::min(m_dirtyBegin, index);
+            m_dirtyEnd = std::max(m_dirtyEnd, index + 1);
+        }
+    }
+
+    void MaterialTable::Upload()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_ubo == 0)
+        {
+            // 一次分配完整大小，之后只做局部更新
+            glGenBuffers(1, &m_ubo);
+            glBindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+            glBufferData(GL_UNIFORM_BUFFER, MAX_MATERIALS * sizeof(GPUMaterial), nullptr, GL_DYNAMIC_DRAW);
+            m_dirtyBegin = 0;
+            m_dirtyEnd = m_materials.size();
+        }
+        else
+        {
+            glBindBuffer(GL_UNIFORM_BUFFER, m_ubo);
+        }
+
+        if (m_dirtyEnd > m_dirtyBegin)
+        {
+            glBufferSubData(GL_UNIFORM_BUFFER,
+                            static_cast<GLintptr>(m_dirtyBegin * sizeof(GPUMaterial)),
+                            static_cast<GLsizeiptr>((m_dirtyEnd - m_dirtyBegin) * sizeof(GPUMaterial)),
+                            m_materials.data() + m_dirtyBegin);
+            RENDER_STATS_ADD(BufferBytesUploaded, (m_dirtyEnd - m_dirtyBegin) * sizeof(GPUMaterial));
+        }
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+        if (m_materials.size() != m_uploadedCount)
+        {
+            Core::Logger::GetInstance().Info("MaterialTable::Upload() - " + std::to_string(m_materials.size()) +
+                                             " materials (UBO: " + std::to_string(m_ubo) + ")");
+            m_uploadedCount = m_materials.size();
+        }
+        m_dirtyBegin = m_dirtyEnd = 0;
+    }
+
+    void MaterialTable::Bind() const
+    {
+        if (m_ubo != 0)
+        {
+            glBindBufferBase(GL_UNIFORM_BUFFER, static_cast<GLuint>(UniformBinding::MATERIAL_TABLE), m_ubo);
+            RENDER_STATS_ADD(BufferBinds, 1);
+        }
+    }
+
+} // namespace Renderer
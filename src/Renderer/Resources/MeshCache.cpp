@@ -0,0 +1,959 @@
+#include "Renderer/Resources/MeshCache.hpp"
+#include "Renderer/Resources/AssetArchive.hpp"
+#include "Renderer/Data/MeshQuantizer.hpp"
+#include "Core/Logger.hpp"
+#include "Core/MappedFile.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace fs = std::filesystem;
+
+namespace Renderer
+{
+
+    namespace
+    {
+        constexpr char kMagic[4] = {'L', 'M', 'S', 'H'};
+        constexpr size_t kAlignment = 16;
+        constexpr uint32_t kVertexStride = 8;         // 位置 3 + 法线 3 + UV 2（float）
+        constexpr uint32_t kQuantizedStride = static_cast<uint32_t>(MeshQuantizer::kQuantizedWords);
+        constexpr uint32_t kSubmeshHasMaterial = 1u; // 有材质时 texturePath = 源文件目录 + diffuseTexname
+        constexpr uint32_t kSubmeshQuantized = 2u;   // 顶点为 MeshQuantizer 布局，positionScale / Offset 有效
+
+        struct FileHeader
+        {
+            char magic[4];
+            uint32_t version;
+            uint32_t dependencyCount;
+            uint32_t submeshCount;
+            uint64_t dependencyOffset;
+            uint64_t submeshOffset;
+            uint64_t stringOffset;
+            uint64_t stringSize;
+            uint64_t fileSize;       // 用于检测截断
+        };
+
+        struct StringRef
+        {
+            uint32_t offset;
+            uint32_t length;
+        };
+
+        struct FileDependency
+        {
+            uint64_t size;
+            int64_t modifiedTime;    // file_time_type 的 tick 数
+            uint64_t contentHash;    // FNV-1a 64
+            StringRef path;          // 相对 OBJ 所在目录
+        };
+
+        struct FileSubmesh
+        {
+            uint64_t vertexOffset;
+            uint64_t indexOffset;
+            uint32_t vertexCount;
+            uint32_t vertexStride;
+            uint32_t indexCount;
+            uint32_t flags;
+            float boundsMin[3];
+            float boundsMax[3];
+            float ambient[3];
+            float diffuse[3];
+            float specular[3];
+            float shininess;
+            float dissolve;
+            StringRef name;
+            StringRef ambientTexname;
+            StringRef diffuseTexname;
+            StringRef specularTexname;
+            StringRef normalTexname;
+            float positionScale[3];  // 量化位置的反量化参数
+            float positionOffset[3];
+            uint32_t meshletCount;
+            uint64_t meshletOffset;
+        };
+
+        struct FileMeshlet
+        {
+            uint32_t firstIndex;
+            uint32_t triangleCount;
+            uint32_t vertexCount;
+            float center[3];
+            float radius;
+            float coneApex[3];
+            float coneAxis[3];
+            float coneCutoff;
+        };
+
+        static_assert(sizeof(FileHeader) % 8 == 0, "FileHeader must be 8-byte aligned");
+        static_assert(sizeof(FileDependency) % 8 == 0, "FileDependency must be 8-byte aligned");
+        static_assert(sizeof(FileSubmesh) % 8 == 0, "FileSubmesh must be 8-byte aligned");
+        static_assert(sizeof(FileMeshlet) % 8 == 0, "FileMeshlet must be 8-byte aligned");
+
+        size_t AlignUp(size_t value)
+        {
+            return (value + kAlignment - 1) & ~(kAlignment - 1);
+        }
+
+        uint64_t HashBytes(const uint8_t* data, size_t size)
+        {
+            uint64_t hash = 1469598103934665603ull;
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= data[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        bool HashFile(const std::string& path, uint64_t& outHash)
+        {
+            Core::MappedFile file;
+            if (!file.Open(path))
+            {
+                return false;
+            }
+            outHash = HashBytes(file.Data(), file.Size());
+            return true;
+        }
+
+        /**
+         * 写临时文件后重命名：已映射旧文件的进程（或本进程中仍持有的视图）不受影响
+         */
+        bool WriteFileAtomic(const std::string& path, const std::vector<uint8_t>& bytes, std::string& error)
+        {
+            std::string tempPath = path + ".tmp";
+            {
+                std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+                if (!out)
+                {
+                    error = "cannot open " + tempPath;
+                    return false;
+                }
+                out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+                if (!out)
+                {
+                    out.close();
+                    std::error_code ec;
+                    fs::remove(tempPath, ec);
+                    error = "write failed: " + tempPath;
+                    return false;
+                }
+            }
+
+            std::error_code ec;
+            fs::rename(tempPath, path, ec);
+            if (ec)
+            {
+                fs::remove(tempPath, ec);
+                error = "cannot rename " + tempPath + " to " + path;
+                return false;
+            }
+            return true;
+        }
+
+        bool StatFile(const fs::path& path, uint64_t& outSize, int64_t& outTime)
+        {
+            std::error_code ec;
+            uintmax_t size = fs::file_size(path, ec);
+            if (ec)
+                return false;
+            auto time = fs::last_write_time(path, ec);
+            if (ec)
+                return false;
+            outSize = static_cast<uint64_t>(size);
+            outTime = static_cast<int64_t>(time.time_since_epoch().count());
+            return true;
+        }
+
+        /**
+         * 扫描 OBJ 中的 mtllib 行（材质文件变化也要使缓存失效）
+         */
+        std::vector<std::string> FindMaterialLibraries(const std::string& objPath)
+        {
+            std::vector<std::string> libraries;
+            Core::MappedFile file;
+            if (!file.Open(objPath) || file.Data() == nullptr)
+            {
+                return libraries;
+            }
+
+            const char* begin = reinterpret_cast<const char*>(file.Data());
+            const char* end = begin + file.Size();
+            const char* line = begin;
+            while (line < end)
+            {
+                const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+                if (lineEnd == nullptr)
+                    lineEnd = end;
+
+                const char* p = line;
+                while (p < lineEnd && (*p == ' ' || *p == '\t'))
+                    ++p;
+                if (lineEnd - p > 7 && std::strncmp(p, "mtllib", 6) == 0 && (p[6] == ' ' || p[6] == '\t'))
+                {
+                    p += 6;
+                    while (p < lineEnd)
+                    {
+                        while (p < lineEnd && (*p == ' ' || *p == '\t' || *p == '\r'))
+                            ++p;
+                        const char* nameEnd = p;
+                        while (nameEnd < lineEnd && *nameEnd != ' ' && *nameEnd != '\t' && *nameEnd != '\r')
+                            ++nameEnd;
+                        if (nameEnd > p)
+                            libraries.emplace_back(p, nameEnd);
+                        p = nameEnd;
+                    }
+                }
+                line = lineEnd + 1;
+            }
+            return libraries;
+        }
+
+        /**
+         * 写入时的字符串表
+         */
+        class StringTable
+        {
+        public:
+            StringRef Add(const std::string& value)
+            {
+                StringRef ref{static_cast<uint32_t>(m_data.size()), static_cast<uint32_t>(value.size())};
+                m_data.insert(m_data.end(), value.begin(), value.end());
+                return ref;
+            }
+            const std::string& GetData() const { return m_data; }
+
+        private:
+            std::string m_data;
+        };
+
+        void CopyVec3(float* dst, const glm::vec3& v)
+        {
+            dst[0] = v.x;
+            dst[1] = v.y;
+            dst[2] = v.z;
+        }
+
+        glm::vec3 LoadVec3(const float* src)
+        {
+            return glm::vec3(src[0], src[1], src[2]);
+        }
+
+        std::string GetBasePath(const std::string& sourcePath)
+        {
+            // 与 OBJLoader::GetBasePath() 一致（以分隔符结尾）
+            std::string basePath = fs::path(sourcePath).parent_path().string();
+            if (!basePath.empty() && basePath.back() != fs::path::preferred_separator)
+            {
+                basePath += fs::path::preferred_separator;
+            }
+            return basePath;
+        }
+
+        /**
+         * 待写入的子网格（float 布局来自 MaterialVertexData，量化布局来自已 PrepareForUpload 的 MeshData）
+         */
+        struct SubmeshInput
+        {
+            const float* vertices = nullptr;
+            size_t vertexWords = 0;
+            uint32_t stride = kVertexStride;
+            const unsigned int* indices = nullptr;
+            size_t indexCount = 0;
+            const OBJMaterial* material = nullptr;
+            std::string texturePath;
+            bool quantized = false;
+            glm::vec3 positionScale = glm::vec3(1.0f);
+            glm::vec3 positionOffset = glm::vec3(0.0f);
+            const std::vector<Meshlet>* meshlets = nullptr;
+        };
+
+        /**
+         * 布局：头部 → 依赖表 → 子网格表 → 字符串表 → 顶点/索引/簇块
+         */
+        bool Serialize(const std::string& sourcePath, const std::vector<SubmeshInput>& submeshes,
+                       const std::vector<FileDependency>& dependencies, StringTable& strings,
+                       std::vector<uint8_t>& outBytes, std::string& error)
+        {
+            std::vector<FileSubmesh> fileSubmeshes(submeshes.size());
+            std::string basePath = GetBasePath(sourcePath);
+            for (size_t i = 0; i < submeshes.size(); ++i)
+            {
+                const SubmeshInput& src = submeshes[i];
+                FileSubmesh& dst = fileSubmeshes[i];
+                if (src.vertexWords % src.stride != 0 ||
+                    src.vertexWords / src.stride > std::numeric_limits<uint32_t>::max() ||
+                    src.indexCount > std::numeric_limits<uint32_t>::max() ||
+                    (src.meshlets && src.meshlets->size() > std::numeric_limits<uint32_t>::max()))
+                {
+                    error = "submesh " + std::to_string(i) + " too large";
+                    return false;
+                }
+
+                dst.vertexStride = src.stride;
+                dst.vertexCount = static_cast<uint32_t>(src.vertexWords / src.stride);
+                dst.indexCount = static_cast<uint32_t>(src.indexCount);
+                dst.meshletCount = src.meshlets ? static_cast<uint32_t>(src.meshlets->size()) : 0u;
+                dst.flags = (src.texturePath.empty() ? 0u : kSubmeshHasMaterial) | (src.quantized ? kSubmeshQuantized : 0u);
+                if (dst.flags & kSubmeshHasMaterial && src.texturePath != basePath + src.material->diffuseTexname)
+                {
+                    error = "unexpected texture path " + src.texturePath;
+                    return false;
+                }
+
+                glm::vec3 boundsMin(std::numeric_limits<float>::max());
+                glm::vec3 boundsMax(-std::numeric_limits<float>::max());
+                if (src.quantized)
+                {
+                    // 量化范围即包围盒
+                    boundsMin = src.positionOffset - src.positionScale;
+                    boundsMax = src.positionOffset + src.positionScale;
+                }
+                else
+                {
+                    for (size_t v = 0; v < dst.vertexCount; ++v)
+                    {
+                        const float* p = src.vertices + v * src.stride;
+                        boundsMin = glm::min(boundsMin, glm::vec3(p[0], p[1], p[2]));
+                        boundsMax = glm::max(boundsMax, glm::vec3(p[0], p[1], p[2]));
+                    }
+                }
+                if (dst.vertexCount == 0)
+                {
+                    boundsMin = boundsMax = glm::vec3(0.0f);
+                }
+                CopyVec3(dst.boundsMin, boundsMin);
+                CopyVec3(dst.boundsMax, boundsMax);
+                CopyVec3(dst.positionScale, src.positionScale);
+                CopyVec3(dst.positionOffset, src.positionOffset);
+
+                const OBJMaterial& material = *src.material;
+                CopyVec3(dst.ambient, material.ambient);
+                CopyVec3(dst.diffuse, material.diffuse);
+                CopyVec3(dst.specular, material.specular);
+                dst.shininess = material.shininess;
+                dst.dissolve = material.dissolve;
+                dst.name = strings.Add(material.name);
+                dst.ambientTexname = strings.Add(material.ambientTexname);
+                dst.diffuseTexname = strings.Add(material.diffuseTexname);
+                dst.specularTexname = strings.Add(material.specularTexname);
+                dst.normalTexname = strings.Add(material.normalTexname);
+            }
+
+            FileHeader header{};
+            std::memcpy(header.magic, kMagic, sizeof(kMagic));
+            header.version = MeshCache::kVersion;
+            header.dependencyCount = static_cast<uint32_t>(dependencies.size());
+            header.submeshCount = static_cast<uint32_t>(fileSubmeshes.size());
+            header.dependencyOffset = sizeof(FileHeader);
+            header.submeshOffset = header.dependencyOffset + dependencies.size() * sizeof(FileDependency);
+            header.stringOffset = header.submeshOffset + fileSubmeshes.size() * sizeof(FileSubmesh);
+            header.stringSize = strings.GetData().size();
+
+            size_t offset = AlignUp(static_cast<size_t>(header.stringOffset + header.stringSize));
+            for (size_t i = 0; i < submeshes.size(); ++i)
+            {
+                fileSubmeshes[i].vertexOffset = offset;
+                offset = AlignUp(offset + submeshes[i].vertexWords * sizeof(float));
+                fileSubmeshes[i].indexOffset = offset;
+                offset = AlignUp(offset + submeshes[i].indexCount * sizeof(unsigned int));
+                fileSubmeshes[i].meshletOffset = offset;
+                offset = AlignUp(offset + fileSubmeshes[i].meshletCount * sizeof(FileMeshlet));
+            }
+            header.fileSize = offset;
+
+            // 对齐填充保持为 0
+            outBytes.assign(offset, 0);
+            auto put = [&outBytes](size_t at, const void* bytes, size_t count) {
+                if (count > 0)
+                    std::memcpy(outBytes.data() + at, bytes, count);
+            };
+            put(0, &header, sizeof(header));
+            put(header.dependencyOffset, dependencies.data(), dependencies.size() * sizeof(FileDependency));
+            put(header.submeshOffset, fileSubmeshes.data(), fileSubmeshes.size() * sizeof(FileSubmesh));
+            put(header.stringOffset, strings.GetData().data(), strings.GetData().size());
+            for (size_t i = 0; i < submeshes.size(); ++i)
+            {
+                put(fileSubmeshes[i].vertexOffset, submeshes[i].vertices, submeshes[i].vertexWords * sizeof(float));
+                put(fileSubmeshes[i].indexOffset, submeshes[i].indices, submeshes[i].indexCount * sizeof(unsigned int));
+                for (uint32_t m = 0; m < fileSubmeshes[i].meshletCount; ++m)
+                {
+                    const Meshlet& meshlet = (*submeshes[i].meshlets)[m];
+                    FileMeshlet out{};
+                    out.firstIndex = meshlet.firstIndex;
+                    out.triangleCount = meshlet.triangleCount;
+                    out.vertexCount = meshlet.vertexCount;
+                    CopyVec3(out.center, meshlet.center);
+                    out.radius = meshlet.radius;
+                    CopyVec3(out.coneApex, meshlet.coneApex);
+                    CopyVec3(out.coneAxis, meshlet.coneAxis);
+                    out.coneCutoff = meshlet.coneCutoff;
+                    put(fileSubmeshes[i].meshletOffset + m * sizeof(FileMeshlet), &out, sizeof(out));
+                }
+            }
+            return true;
+        }
+
+        std::vector<SubmeshInput> FromMaterialVertexData(const std::vector<OBJModel::MaterialVertexData>& submeshes)
+        {
+            std::vector<SubmeshInput> inputs(submeshes.size());
+            for (size_t i = 0; i < submeshes.size(); ++i)
+            {
+                inputs[i].vertices = submeshes[i].vertices.data();
+                inputs[i].vertexWords = submeshes[i].vertices.size();
+                inputs[i].indices = submeshes[i].indices.data();
+                inputs[i].indexCount = submeshes[i].indices.size();
+                inputs[i].material = &submeshes[i].material;
+                inputs[i].texturePath = submeshes[i].texturePath;
+            }
+            return inputs;
+        }
+
+        /**
+         * 依赖表：files 为相对工作目录的路径（第一个为源文件本身），表中记录相对源文件目录的名称
+         */
+        bool CollectDependencies(const std::string& sourcePath, const std::vector<std::string>& files,
+                                 StringTable& strings, std::vector<FileDependency>& outDependencies, std::string& error)
+        {
+            fs::path directory = fs::path(sourcePath).parent_path();
+            for (const std::string& file : files)
+            {
+                FileDependency dependency{};
+                if (!StatFile(file, dependency.size, dependency.modifiedTime))
+                {
+                    continue; // 缺失的 mtl 不阻止缓存（与 tinyobj 的警告行为一致）
+                }
+                if (!HashFile(file, dependency.contentHash))
+                {
+                    error = "failed to hash " + file;
+                    return false;
+                }
+                std::string name = directory.empty() ? fs::path(file).generic_string()
+                                                     : fs::path(file).lexically_relative(directory).generic_string();
+                dependency.path = strings.Add(name.empty() ? file : name);
+                outDependencies.push_back(dependency);
+            }
+            if (outDependencies.empty())
+            {
+                error = "source not found: " + sourcePath;
+                return false;
+            }
+            return true;
+        }
+
+    } // namespace
+
+    std::string MeshCache::GetCachePath(const std::string& sourcePath, bool quantized)
+    {
+        // 量化缓存带上源文件扩展名：同目录下同名的 .obj / .glb 不会共用一个缓存
+        return quantized ? sourcePath + ".q.lmesh" : fs::path(sourcePath).replace_extension(".lmesh").string();
+    }
+
+    std::vector<std::string> MeshCache::GetSourceFiles(const std::string& sourcePath)
+    {
+        std::vector<std::string> files;
+        files.push_back(sourcePath);
+        fs::path directory = fs::path(sourcePath).parent_path();
+        for (const std::string& library : FindMaterialLibraries(sourcePath))
+        {
+            files.push_back((directory / library).generic_string());
+        }
+        return files;
+    }
+
+    std::shared_ptr<const MeshCache> MeshCache::Open(const std::string& sourcePath, bool quantized)
+    {
+        // ✅ 打包文件中的网格优先（lumen-cook 生成；OBJ / mtl 在烘焙后被修改时 Find 返回空，继续走缓存）
+        if (auto archive = AssetArchive::GetMounted())
+        {
+            // 量化布局以缓存路径为条目名（见 lumen-cook）
+            const std::string entryName = quantized ? GetCachePath(sourcePath, true) : sourcePath;
+            if (const AssetArchiveEntry* entry = archive->Find(entryName, AssetType::Mesh))
+            {
+                auto cache = OpenMemory(archive->GetData(*entry), static_cast<size_t>(entry->size), archive, sourcePath);
+                if (cache && cache->IsQuantized() == quantized)
+                {
+                    return cache;
+                }
+                Core::Logger::GetInstance().Warning("Ignoring invalid archived mesh: " + sourcePath);
+            }
+        }
+
+        std::string cachePath = GetCachePath(sourcePath, quantized);
+        std::error_code ec;
+        if (!fs::exists(cachePath, ec))
+        {
+            return nullptr;
+        }
+
+        auto mapCache = [&cachePath]() -> std::shared_ptr<MeshCache>
+        {
+            std::shared_ptr<MeshCache> mapped(new MeshCache());
+            mapped->m_path = cachePath;
+            auto file = std::make_shared<Core::MappedFile>();
+            if (!file->Open(cachePath))
+            {
+                Core::Logger::GetInstance().Warning("Failed to map mesh cache: " + cachePath);
+                return nullptr;
+            }
+            mapped->m_data = file->Data();
+            mapped->m_size = file->Size();
+            mapped->m_storage = std::move(file);
+
+            std::string error;
+            if (!mapped->Parse(error))
+            {
+                Core::Logger::GetInstance().Warning("Invalid mesh cache " + cachePath + ": " + error);
+                return nullptr;
+            }
+            return mapped;
+        };
+
+        std::shared_ptr<MeshCache> cache = mapCache();
+        if (!cache)
+        {
+            return nullptr;
+        }
+        if (cache->IsQuantized() != quantized)
+        {
+            Core::Logger::GetInstance().Warning("Mesh cache has unexpected vertex layout: " + cachePath);
+            return nullptr;
+        }
+
+        // 校验依赖文件
+        const uint8_t* data = cache->m_data;
+        const FileHeader* header = reinterpret_cast<const FileHeader*>(data);
+        const FileDependency* dependencies = reinterpret_cast<const FileDependency*>(data + header->dependencyOffset);
+        const char* strings = reinterpret_cast<const char*>(data + header->stringOffset);
+        fs::path directory = fs::path(sourcePath).parent_path();
+
+        // 只有修改时间变化、内容哈希一致的依赖：记录新的修改时间，之后的启动不必再哈希整个源文件
+        std::vector<std::pair<uint64_t, int64_t>> refreshedTimes;   // (文件内偏移, 新修改时间)
+        for (uint32_t i = 0; i < header->dependencyCount; ++i)
+        {
+            const FileDependency& dependency = dependencies[i];
+            fs::path path = directory / std::string(strings + dependency.path.offset, dependency.path.length);
+
+            uint64_t size = 0;
+            int64_t modifiedTime = 0;
+            if (!StatFile(path, size, modifiedTime) || size != dependency.size)
+            {
+                Core::Logger::GetInstance().Info("Mesh cache is stale (" + path.string() + " changed): " + cachePath);
+                return nullptr;
+            }
+            if (modifiedTime != dependency.modifiedTime)
+            {
+                uint64_t hash = 0;
+                if (!HashFile(path.string(), hash) || hash != dependency.contentHash)
+                {
+                    Core::Logger::GetInstance().Info("Mesh cache is stale (" + path.string() + " changed): " + cachePath);
+                    return nullptr;
+                }
+                refreshedTimes.emplace_back(header->dependencyOffset + i * sizeof(FileDependency) +
+                                                offsetof(FileDependency, modifiedTime),
+                                            modifiedTime);
+            }
+        }
+
+        if (!refreshedTimes.empty())
+        {
+            // 不原地改写映射中的文件：拷贝一份改好修改时间，按写缓存的方式（临时文件 + 重命名）整体替换
+            std::vector<uint8_t> bytes(cache->m_data, cache->m_data + cache->m_size);
+            for (const auto& [offset, modifiedTime] : refreshedTimes)
+            {
+                std::memcpy(bytes.data() + offset, &modifiedTime, sizeof(modifiedTime));
+            }
+
+            // ⚠️ 先释放映射再替换（Windows 上映射中的文件不能被覆盖），之后重新映射
+            cache.reset();
+            std::string error;
+            if (WriteFileAtomic(cachePath, bytes, error))
+            {
+                Core::Logger::GetInstance().Debug("Mesh cache dependency times refreshed: " + cachePath);
+            }
+            else
+            {
+                // 只读资源目录等：缓存内容仍然有效，只是下次启动还要再比较一次哈希
+                Core::Logger::GetInstance().Debug("Mesh cache dependency times not refreshed (" + error + "): " + cachePath);
+            }
+            cache = mapCache();
+            if (!cache)
+            {
+                return nullptr;
+            }
+        }
+
+        cache->ResolveTexturePaths(sourcePath);
+
+        Core::Logger::GetInstance().Info("Mesh cache mapped: " + cachePath + " (" +
+                                         std::to_string(cache->m_submeshes.size()) + " submeshes, " +
+                                         std::to_string(cache->m_size / 1024) + " KB)");
+        return cache;
+    }
+
+    std::shared_ptr<const MeshCache> MeshCache::OpenMemory(const uint8_t* data, size_t size,
+                                                           std::shared_ptr<const void> owner,
+                                                           const std::string& sourcePath)
+    {
+        std::shared_ptr<MeshCache> cache(new MeshCache());
+        cache->m_path = sourcePath;
+        cache->m_data = data;
+        cache->m_size = size;
+        cache->m_storage = std::move(owner);
+
+        std::string error;
+        if (!cache->Parse(error))
+        {
+            Core::Logger::GetInstance().Warning("Invalid mesh data for " + sourcePath + ": " + error);
+            return nullptr;
+        }
+        cache->ResolveTexturePaths(sourcePath);
+        return cache;
+    }
+
+    void MeshCache::ResolveTexturePaths(const std::string& sourcePath)
+    {
+        // 字符串与材质在解析后才能解引用，最后生成纹理路径
+        const FileHeader* header = reinterpret_cast<const FileHeader*>(m_data);
+        const FileSubmesh* fileSubmeshes = reinterpret_cast<const FileSubmesh*>(m_data + header->submeshOffset);
+        std::string basePath = GetBasePath(sourcePath);
+        for (size_t i = 0; i < m_submeshes.size(); ++i)
+        {
+            MeshCacheSubmesh& submesh = m_submeshes[i];
+            if (fileSubmeshes[i].flags & kSubmeshHasMaterial)
+            {
+                submesh.texturePath = basePath + submesh.material.diffuseTexname;
+            }
+        }
+    }
+
+    bool MeshCache::Parse(std::string& error)
+    {
+        const uint8_t* data = m_data;
+        size_t size = m_size;
+        if (data == nullptr || size < sizeof(FileHeader))
+        {
+            error = "file too small";
+            return false;
+        }
+
+        const FileHeader* header = reinterpret_cast<const FileHeader*>(data);
+        if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0)
+        {
+            error = "bad magic";
+            return false;
+        }
+        if (header->version != kVersion)
+        {
+            error = "version " + std::to_string(header->version) + " (expected " + std::to_string(kVersion) + ")";
+            return false;
+        }
+        if (header->fileSize != size)
+        {
+            error = "truncated";
+            return false;
+        }
+
+        auto inRange = [size](uint64_t offset, uint64_t bytes) {
+            return offset <= size && bytes <= size - offset;
+        };
+        if (!inRange(header->dependencyOffset, static_cast<uint64_t>(header->dependencyCount) * sizeof(FileDependency)) ||
+            !inRange(header->submeshOffset, static_cast<uint64_t>(header->submeshCount) * sizeof(FileSubmesh)) ||
+            !inRange(header->stringOffset, header->stringSize))
+        {
+            error = "table out of range";
+            return false;
+        }
+
+        const char* strings = reinterpret_cast<const char*>(data + header->stringOffset);
+        uint64_t stringSize = header->stringSize;
+        bool stringsValid = true;
+        auto getString = [&](const StringRef& ref) {
+            if (static_cast<uint64_t>(ref.offset) + ref.length > stringSize)
+            {
+                stringsValid = false;
+                return std::string();
+            }
+            return std::string(strings + ref.offset, ref.length);
+        };
+
+        const FileDependency* dependencies = reinterpret_cast<const FileDependency*>(data + header->dependencyOffset);
+        for (uint32_t i = 0; i < header->dependencyCount; ++i)
+        {
+            getString(dependencies[i].path);
+        }
+
+        const FileSubmesh* fileSubmeshes = reinterpret_cast<const FileSubmesh*>(data + header->submeshOffset);
+        m_submeshes.resize(header->submeshCount);
+        for (uint32_t i = 0; i < header->submeshCount; ++i)
+        {
+            const FileSubmesh& src = fileSubmeshes[i];
+            uint64_t vertexBytes = static_cast<uint64_t>(src.vertexCount) * src.vertexStride * sizeof(float);
+            uint64_t indexBytes = static_cast<uint64_t>(src.indexCount) * sizeof(unsigned int);
+            if (!inRange(src.vertexOffset, vertexBytes) || !inRange(src.indexOffset, indexBytes) ||
+                src.vertexOffset % kAlignment != 0 || src.indexOffset % kAlignment != 0)
+            {
+                error = "submesh " + std::to_string(i) + " out of range";
+                return false;
+            }
+            const bool quantized = (src.flags & kSubmeshQuantized) != 0;
+            const uint32_t expectedStride = quantized ? kQuantizedStride : kVertexStride;
+            if (src.vertexStride != expectedStride)
+            {
+                error = "submesh " + std::to_string(i) + " vertex stride " + std::to_string(src.vertexStride) +
+                        " (expected " + std::to_string(expectedStride) + ")";
+                return false;
+            }
+            if (i > 0 && quantized != m_quantized)
+            {
+                error = "mixed vertex layouts";
+                return false;
+            }
+            m_quantized = quantized;
+
+            uint64_t meshletBytes = static_cast<uint64_t>(src.meshletCount) * sizeof(FileMeshlet);
+            if (!inRange(src.meshletOffset, meshletBytes) || src.meshletOffset % kAlignment != 0)
+            {
+                error = "submesh " + std::to_string(i) + " meshlets out of range";
+                return false;
+            }
+
+            // 视图直接交给上传 / 优化代码，索引越界会读到顶点块之外：逐个检查（打包文件同样经过这里）
+            const unsigned int* indices = reinterpret_cast<const unsigned int*>(data + src.indexOffset);
+            unsigned int maxIndex = 0;
+            for (uint32_t j = 0; j < src.indexCount; ++j)
+            {
+                maxIndex = std::max(maxIndex, indices[j]);
+            }
+            if (src.indexCount > 0 && maxIndex >= src.vertexCount)
+            {
+                error = "submesh " + std::to_string(i) + " index " + std::to_string(maxIndex) + " out of range (" +
+                        std::to_string(src.vertexCount) + " vertices)";
+                return false;
+            }
+
+            MeshCacheSubmesh& dst = m_submeshes[i];
+            dst.vertices = reinterpret_cast<const float*>(data + src.vertexOffset);
+            dst.vertexCount = src.vertexCount;
+            dst.vertexStride = src.vertexStride;
+            dst.indices = reinterpret_cast<const unsigned int*>(data + src.indexOffset);
+            dst.indexCount = src.indexCount;
+            dst.boundsMin = LoadVec3(src.boundsMin);
+            dst.boundsMax = LoadVec3(src.boundsMax);
+            dst.quantized = quantized;
+            dst.positionScale = LoadVec3(src.positionScale);
+            dst.positionOffset = LoadVec3(src.positionOffset);
+
+            // 簇只有几十字节一个，拷贝为 Meshlet（MeshData 持有 vector）；区间必须落在索引缓冲区内
+            const FileMeshlet* fileMeshlets = reinterpret_cast<const FileMeshlet*>(data + src.meshletOffset);
+            dst.meshlets.resize(src.meshletCount);
+            for (uint32_t m = 0; m < src.meshletCount; ++m)
+            {
+                const FileMeshlet& in = fileMeshlets[m];
+                if (static_cast<uint64_t>(in.firstIndex) + static_cast<uint64_t>(in.triangleCount) * 3 > src.indexCount)
+                {
+                    error = "submesh " + std::to_string(i) + " meshlet " + std::to_string(m) + " out of range";
+                    return false;
+                }
+                Meshlet& out = dst.meshlets[m];
+                out.firstIndex = in.firstIndex;
+                out.triangleCount = in.triangleCount;
+                out.vertexCount = in.vertexCount;
+                out.center = LoadVec3(in.center);
+                out.radius = in.radius;
+                out.coneApex = LoadVec3(in.coneApex);
+                out.coneAxis = LoadVec3(in.coneAxis);
+                out.coneCutoff = in.coneCutoff;
+            }
+
+            dst.material.name = getString(src.name);
+            dst.material.ambient = LoadVec3(src.ambient);
+            dst.material.diffuse = LoadVec3(src.diffuse);
+            dst.material.specular = LoadVec3(src.specular);
+            dst.material.shininess = src.shininess;
+            dst.material.dissolve = src.dissolve;
+            dst.material.ambientTexname = getString(src.ambientTexname);
+            dst.material.diffuseTexname = getString(src.diffuseTexname);
+            dst.material.specularTexname = getString(src.specularTexname);
+            dst.material.normalTexname = getString(src.normalTexname);
+        }
+
+        if (!stringsValid)
+        {
+            error = "string out of range";
+            return false;
+        }
+        return true;
+    }
+
+    bool MeshCache::Write(const std::string& sourcePath, const std::vector<OBJModel::MaterialVertexData>& submeshes,
+                          std::string* error)
+    {
+        auto fail = [error](const std::string& message) {
+            if (error)
+                *error = message;
+            return false;
+        };
+
+        // 依赖：OBJ 本身 + mtllib
+        StringTable strings;
+        std::vector<FileDependency> dependencies;
+        std::vector<uint8_t> bytes;
+        std::string message;
+        if (!CollectDependencies(sourcePath, GetSourceFiles(sourcePath), strings, dependencies, message) ||
+            !Serialize(sourcePath, FromMaterialVertexData(submeshes), dependencies, strings, bytes, message) ||
+            !WriteFileAtomic(GetCachePath(sourcePath), bytes, message))
+        {
+            return fail(message);
+        }
+        return true;
+    }
+
+    bool MeshCache::WriteToMemory(const std::string& sourcePath,
+                                  const std::vector<OBJModel::MaterialVertexData>& submeshes,
+                                  std::vector<uint8_t>& outBytes, std::string* error)
+    {
+        StringTable strings;
+        std::string message;
+        if (!Serialize(sourcePath, FromMaterialVertexData(submeshes), {}, strings, outBytes, message))
+        {
+            if (error)
+                *error = message;
+            return false;
+        }
+        return true;
+    }
+
+    bool MeshCache::SerializeQuantized(const std::string& sourcePath, const std::vector<MeshData>& meshes,
+                                       const std::vector<std::string>& sourceFiles, std::vector<uint8_t>& outBytes,
+                                       std::string* error)
+    {
+        auto fail = [error](const std::string& message) {
+            if (error)
+                *error = message;
+            return false;
+        };
+
+        // 只接受 MeshQuantizer 的基本布局（位置 / 法线 / UV，无额外属性）：文件中不记录属性布局
+        const std::string basePath = GetBasePath(sourcePath);
+        std::vector<OBJMaterial> materials(meshes.size());
+        std::vector<SubmeshInput> inputs(meshes.size());
+        for (size_t i = 0; i < meshes.size(); ++i)
+        {
+            const MeshData& mesh = meshes[i];
+            if (!mesh.IsPositionQuantized() || mesh.GetVertexStride() != kQuantizedStride ||
+                mesh.GetAttributeSizes().size() != 3)
+            {
+                return fail("mesh " + std::to_string(i) + " is not in the quantized layout");
+            }
+            const std::string& texturePath = mesh.GetTexturePath();
+            if (!texturePath.empty() && texturePath.compare(0, basePath.size(), basePath) != 0)
+            {
+                return fail("texture outside the source directory: " + texturePath);
+            }
+
+            materials[i].diffuse = mesh.GetMaterialColor();
+            materials[i].diffuseTexname = texturePath.empty() ? std::string() : texturePath.substr(basePath.size());
+            SubmeshInput& input = inputs[i];
+            input.vertices = mesh.GetVertexData();
+            input.vertexWords = mesh.GetVertexCount() * mesh.GetVertexStride();
+            input.stride = kQuantizedStride;
+            input.indices = mesh.GetIndexData();
+            input.indexCount = mesh.GetIndexCount();
+            input.material = &materials[i];
+            input.texturePath = texturePath;
+            input.quantized = true;
+            input.positionScale = mesh.GetPositionScale();
+            input.positionOffset = mesh.GetPositionOffset();
+            input.meshlets = &mesh.GetMeshlets();
+        }
+
+        StringTable strings;
+        std::vector<FileDependency> dependencies;
+        std::string message;
+        if ((!sourceFiles.empty() && !CollectDependencies(sourcePath, sourceFiles, strings, dependencies, message)) ||
+            !Serialize(sourcePath, inputs, dependencies, strings, outBytes, message))
+        {
+            return fail(message);
+        }
+        return true;
+    }
+
+    bool MeshCache::WriteQuantized(const std::string& sourcePath, const std::vector<MeshData>& meshes,
+                                   const std::vector<std::string>& sourceFiles, std::string* error)
+    {
+        std::vector<uint8_t> bytes;
+        std::string message;
+        if (!SerializeQuantized(sourcePath, meshes, sourceFiles, bytes, &message) ||
+            !WriteFileAtomic(GetCachePath(sourcePath, true), bytes, message))
+        {
+            if (error)
+                *error = message;
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<MeshData> MeshCache::ToMeshData(const std::shared_ptr<const MeshCache>& cache)
+    {
+        std::vector<MeshData> dataList;
+        if (!cache)
+        {
+            return dataList;
+        }
+
+        dataList.reserve(cache->GetSubmeshes().size());
+        for (const MeshCacheSubmesh& submesh : cache->GetSubmeshes())
+        {
+            // 顶点 / 索引视图直接指向映射，MeshBuffer 上传时从映射读取
+            MeshData data;
+            data.SetVertexView(submesh.vertices, static_cast<size_t>(submesh.vertexCount) * submesh.vertexStride,
+                               submesh.vertexStride, cache);
+            data.SetIndexView(submesh.indices, submesh.indexCount, cache);
+            if (submesh.quantized)
+            {
+                MeshQuantizer::SetQuantizedLayout(data, submesh.positionScale, submesh.positionOffset);
+            }
+            else
+            {
+                data.SetVertexLayout({0, 3, 6}, {3, 3, 2});
+            }
+            if (!submesh.meshlets.empty())
+            {
+                data.SetMeshlets(std::vector<Meshlet>(submesh.meshlets));
+            }
+            data.SetMaterialColor(submesh.material.diffuse);
+            data.SetTexturePath(submesh.texturePath);
+            dataList.push_back(std::move(data));
+        }
+        return dataList;
+    }
+
+    std::vector<OBJModel::MaterialVertexData> MeshCache::ToMaterialVertexData() const
+    {
+        if (m_quantized)
+        {
+            Core::Logger::GetInstance().Error("MeshCache::ToMaterialVertexData() - Quantized cache cannot be expanded: " +
+                                              m_path);
+            return {};
+        }
+
+        std::vector<OBJModel::MaterialVertexData> result(m_submeshes.size());
+        for (size_t i = 0; i < m_submeshes.size(); ++i)
+        {
+            const MeshCacheSubmesh& src = m_submeshes[i];
+            OBJModel::MaterialVertexData& dst = result[i];
+            dst.vertices.assign(src.vertices, src.vertices + static_cast<size_t>(src.vertexCount) * src.vertexStride);
+            dst.indices.assign(src.indices, src.indices + src.indexCount);
+            dst.material = src.material;
+            dst.texturePath = src.texturePath;
+        }
+        return result;
+    }
+
+} // namespace Renderer
@@ -1,7 +1,14 @@
+// tinyobj 的实现部分没有包含保护，只在这里展开一次（OBJParser.hpp 等头文件会再次包含声明部分）
 #define TINYOBJLOADER_IMPLEMENTATION
+#include "tiny_obj_loader.h"
+#undef TINYOBJLOADER_IMPLEMENTATION
+
 #include "Renderer/Resources/OBJLoader.hpp"
+#include "Renderer/Resources/OBJParser.hpp"
 #include "Core/Logger.hpp"
+#include "Core/Profiler.hpp"
 #include <iostream>
+#include <algorithm>
 #include <filesystem>
 
 namespace fs = std::filesystem;
@@ -9,6 +16,64 @@ namespace fs = std::filesystem;
 namespace Renderer
 {
 
+    namespace
+    {
+        // 文件所在目录（以路径分隔符结尾），用于查找材质文件和纹理
+        std::string BasePathOf(const std::string& filepath)
+        {
+            std::string basePath = fs::path(filepath).parent_path().string();
+            if (!basePath.empty() && basePath.back() != fs::path::preferred_separator) {
+                basePath += fs::path::preferred_separator;
+            }
+            return basePath;
+        }
+
+        OBJVertex MakeVertex(const tinyobj::attrib_t& attrib, const tinyobj::index_t& idx)
+        {
+            OBJVertex vertex;
+
+            // 位置（tinyobj使用float数组，每个顶点3个float）
+            if (idx.vertex_index >= 0) {
+                vertex.position = glm::vec3(
+                    attrib.vertices[3 * idx.vertex_index + 0],
+                    attrib.vertices[3 * idx.vertex_index + 1],
+                    attrib.vertices[3 * idx.vertex_index + 2]
+                );
+            }
+
+            // 法线
+            if (idx.normal_index >= 0) {
+                vertex.normal = glm::vec3(
+                    attrib.normals[3 * idx.normal_index + 0],
+                    attrib.normals[3 * idx.normal_index + 1],
+                    attrib.normals[3 * idx.normal_index + 2]
+                );
+            } else {
+                // 如果没有法线，设置为默认值
+                vertex.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+            }
+
+            // 纹理坐标（tinyobj使用float数组，每个纹理坐标2个float）
+            if (idx.texcoord_index >= 0) {
+                vertex.texCoord = glm::vec2(
+                    attrib.texcoords[2 * idx.texcoord_index + 0],
+                    attrib.texcoords[2 * idx.texcoord_index + 1]
+                );
+            } else {
+                vertex.texCoord = glm::vec2(0.0f, 0.0f);
+            }
+            return vertex;
+        }
+
+        // 角点引用的属性是否都已解析（流式导入时属性数组只包含当前窗口之前的数据）
+        bool IsCornerInRange(const tinyobj::attrib_t& attrib, const tinyobj::index_t& idx)
+        {
+            return static_cast<size_t>(3) * idx.vertex_index + 2 < attrib.vertices.size() &&
+                   (idx.normal_index < 0 || static_cast<size_t>(3) * idx.normal_index + 2 < attrib.normals.size()) &&
+                   (idx.texcoord_index < 0 || static_cast<size_t>(2) * idx.texcoord_index + 1 < attrib.texcoords.size());
+        }
+    } // namespace
+
     OBJLoader::OBJLoader()
         : m_loaded(false)
     {
@@ -19,8 +84,9 @@ namespace Renderer
         Clear();
     }
 
-    bool OBJLoader::LoadFromFile(const std::string& filepath)
+    bool OBJLoader::LoadFromFile(const std::string& filepath, OBJParserBackend backend)
     {
+        PROFILE_SCOPE("OBJLoader::LoadFromFile");
         Core::Logger::GetInstance().Info("Loading OBJ file: " + filepath);
         std::cout << "[OBJLoader] Starting to load: " << filepath << std::endl;
         std::cout.flush();
@@ -28,12 +94,7 @@ namespace Renderer
         Clear();
 
         // 获取文件所在目录，用于加载材质文件
-        fs::path path(filepath);
-        m_basePath = path.parent_path().string();
-        // 确保basePath以路径分隔符结尾
-        if (!m_basePath.empty() && m_basePath.back() != fs::path::preferred_separator) {
-            m_basePath += fs::path::preferred_separator;
-        }
+        m_basePath = BasePathOf(filepath);
 
         tinyobj::attrib_t attrib;
         std::vector<tinyobj::shape_t> shapes;
@@ -41,12 +102,21 @@ namespace Renderer
 
         std::string err;
 
-        std::cout << "[OBJLoader] Parsing OBJ file with tinyobjloader (this may take a while for large files)..." << std::endl;
-        std::cout.flush();
+        bool ret = false;
+        if (backend == OBJParserBackend::Parallel) {
+            std::cout << "[OBJLoader] Parsing OBJ file with parallel parser..." << std::endl;
+            std::cout.flush();
 
-        // 使用tinyobjloader加载OBJ文件
-        bool ret = tinyobj::LoadObj(&attrib, &shapes, &materials, &err,
+            // ✅ 性能优化：内存映射 + 多线程分块解析，输出与 tinyobj 一致
+            ret = OBJParser::LoadObj(&attrib, &shapes, &materials, &err, filepath, m_basePath);
+        } else {
+            std::cout << "[OBJLoader] Parsing OBJ file with tinyobjloader (this may take a while for large files)..." << std::endl;
+            std::cout.flush();
+
+            // 使用tinyobjloader加载OBJ文件
+            ret = tinyobj::LoadObj(&attrib, &shapes, &materials, &err,
                                    filepath.c_str(), m_basePath.c_str(), true);
+        }
 
         std::cout << "[OBJLoader] Parsing completed!" << std::endl;
         std::cout.flush();
@@ -86,6 +156,134 @@ namespace Renderer
         return true;
     }
 
+    bool OBJLoader::LoadStreaming(const std::string& filepath, const OBJStreamConfig& config,
+                                  const ChunkCallback& onChunk)
+    {
+        Core::Logger::GetInstance().Info("Streaming OBJ file: " + filepath);
+
+        Clear();
+        m_basePath = BasePathOf(filepath);
+
+        const size_t chunkTriangles = std::clamp<size_t>(config.chunkTriangles, 1, kMaxChunkTriangles);
+
+        // 每个材质一个未满的块（块内顶点去重）
+        struct PendingChunk
+        {
+            OBJMeshChunk chunk;
+            std::unordered_map<VertexKey, unsigned int, VertexKeyHash> vertexMap;
+        };
+        std::map<int, PendingChunk> pending;
+        size_t emittedChunks = 0;
+        size_t emittedTriangles = 0;
+        bool cancelled = false;
+
+        auto emit = [&](PendingChunk& entry) {
+            emittedTriangles += entry.chunk.indices.size() / 3;
+            ++emittedChunks;
+            OBJMeshChunk chunk = std::move(entry.chunk);
+            entry.chunk = OBJMeshChunk();
+            entry.chunk.materialIndex = chunk.materialIndex;
+            entry.vertexMap.clear();
+            if (!onChunk(std::move(chunk)))
+            {
+                cancelled = true;
+            }
+        };
+
+        std::string err;
+        bool ret = OBJParser::StreamObj(
+            filepath, m_basePath, config.windowBytes,
+            [&](const tinyobj::attrib_t& attrib, const std::vector<tinyobj::material_t>& materials,
+                const std::vector<tinyobj::index_t>& corners, const std::vector<int>& materialIds) {
+                // 材质只会在 mtllib 处增加
+                if (materials.size() != m_materials.size())
+                {
+                    ConvertMaterials(materials);
+                }
+
+                for (size_t t = 0; t < materialIds.size() && !cancelled; ++t)
+                {
+                    int materialId = materialIds[t];
+                    if (materialId < 0 || static_cast<size_t>(materialId) >= materials.size())
+                    {
+                        materialId = -1;
+                    }
+
+                    // 前向引用或越界索引：无法在当前窗口内转换，整个导入失败
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        const tinyobj::index_t& idx = corners[t * 3 + c];
+                        if (idx.vertex_index < 0 || !IsCornerInRange(attrib, idx))
+                        {
+                            Core::Logger::GetInstance().Error(
+                                "OBJLoader::LoadStreaming() - Face references an undefined attribute (v " +
+                                std::to_string(idx.vertex_index + 1) + ", vt " + std::to_string(idx.texcoord_index + 1) +
+                                ", vn " + std::to_string(idx.normal_index + 1) + "): " + filepath);
+                            cancelled = true;
+                            return false;
+                        }
+                    }
+
+                    PendingChunk& entry = pending[materialId];
+                    entry.chunk.materialIndex = materialId;
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        const tinyobj::index_t& idx = corners[t * 3 + c];
+                        VertexKey key{idx.vertex_index, idx.normal_index, idx.texcoord_index};
+                        auto [it, inserted] = entry.vertexMap.try_emplace(
+                            key, static_cast<unsigned int>(entry.chunk.vertices.size()));
+                        if (inserted)
+                        {
+                            entry.chunk.vertices.push_back(MakeVertex(attrib, idx));
+                        }
+                        entry.chunk.indices.push_back(it->second);
+                    }
+
+                    if (entry.chunk.indices.size() >= chunkTriangles * 3)
+                    {
+                        emit(entry);
+                    }
+                }
+                return !cancelled;
+            },
+            &err);
+
+        if (!err.empty())
+        {
+            if (err.find("WARN") != std::string::npos) {
+                Core::Logger::GetInstance().Warning("OBJ Loader Warning: " + err);
+            } else {
+                Core::Logger::GetInstance().Error("OBJ Loader Error: " + err);
+            }
+        }
+
+        // 文件结束：按材质顺序输出剩余的块
+        for (auto& [materialId, entry] : pending)
+        {
+            if (!ret || cancelled)
+            {
+                break;
+            }
+            if (!entry.chunk.indices.empty())
+            {
+                emit(entry);
+            }
+        }
+
+        if (!ret || cancelled)
+        {
+            Core::Logger::GetInstance().Error("Failed to stream OBJ file: " + filepath);
+            return false;
+        }
+
+        m_loaded = true;
+        Core::Logger::GetInstance().Info("OBJ file streamed: " + filepath + " (Chunks: " +
+                                         std::to_string(emittedChunks) + ", Triangles: " +
+                                         std::to_string(emittedTriangles) + ", Materials: " +
+                                         std::to_string(m_materials.size()) + ")");
+        return true;
+    }
+
     void OBJLoader::ConvertTinyObjData(const tinyobj::attrib_t& attrib,
                                       const std::vector<tinyobj::shape_t>& shapes,
                                       const std::vector<tinyobj::material_t>& materials)
@@ -155,38 +353,7 @@ namespace Renderer
                             faceIndices.push_back(it->second);
                         } else {
                             // 创建新顶点
-                            OBJVertex vertex;
-
-                            // 位置（tinyobj使用float数组，每个顶点3个float）
-                            if (idx.vertex_index >= 0) {
-                                vertex.position = glm::vec3(
-                                    attrib.vertices[3 * idx.vertex_index + 0],
-                                    attrib.vertices[3 * idx.vertex_index + 1],
-                                    attrib.vertices[3 * idx.vertex_index + 2]
-                                );
-                            }
-
-                            // 法线
-                            if (idx.normal_index >= 0) {
-                                vertex.normal = glm::vec3(
-                                    attrib.normals[3 * idx.normal_index + 0],
-                                    attrib.normals[3 * idx.normal_index + 1],
-                                    attrib.normals[3 * idx.normal_index + 2]
-                                );
-                            } else {
-                                // 如果没有法线，设置为默认值
-                                vertex.normal = glm::vec3(0.0f, 1.0f, 0.0f);
-                            }
-
-                            // 纹理坐标（tinyobj使用float数组，每个纹理坐标2个float）
-                            if (idx.texcoord_index >= 0) {
-                                vertex.texCoord = glm::vec2(
-                                    attrib.texcoords[2 * idx.texcoord_index + 0],
-                                    attrib.texcoords[2 * idx.texcoord_index + 1]
-                                );
-                            } else {
-                                vertex.texCoord = glm::vec2(0.0f, 0.0f);
-                            }
+                            OBJVertex vertex = MakeVertex(attrib, idx);
 
                             // 添加顶点到数组
                             unsigned int newIndex = static_cast<unsigned int>(m_vertices.size());
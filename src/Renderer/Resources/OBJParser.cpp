@@ -0,0 +1,826 @@
+#include "Renderer/Resources/OBJParser.hpp"
+#include "Core/MappedFile.hpp"
+#include "Core/ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <sstream>
+
+namespace Renderer
+{
+    namespace OBJParser
+    {
+        namespace
+        {
+            // 每块至少 1MB，避免小文件被切得过碎
+            constexpr size_t kMinChunkBytes = 1u << 20;
+
+            // 相对索引修正记录：(角点下标 << 2) | 分量
+            enum : uint8_t
+            {
+                kRelativeVertex = 1u << 0,
+                kRelativeNormal = 1u << 1,
+                kRelativeTexcoord = 1u << 2,
+            };
+
+            struct ChunkEvent
+            {
+                enum class Type : uint8_t
+                {
+                    UseMaterial,      // usemtl <name>
+                    MaterialLibrary,  // mtllib <files...>
+                    Group,            // g <name> 或 o <name>（对 shape 划分的作用相同）
+                };
+
+                Type type;
+                size_t faceOffset;      // 事件之前本块已解析的面数（含退化面）
+                size_t triangleOffset;  // 事件之前本块已生成的三角形数
+                std::string text;
+            };
+
+            struct Chunk
+            {
+                const char* begin = nullptr;
+                const char* end = nullptr;
+
+                std::vector<tinyobj::real_t> v;
+                std::vector<tinyobj::real_t> vn;
+                std::vector<tinyobj::real_t> vt;
+                std::vector<tinyobj::index_t> corners;  // 每个三角形 3 个
+                std::vector<size_t> relative;           // 需要加上全局偏移的负索引
+                size_t faceCount = 0;
+                std::vector<ChunkEvent> events;
+            };
+
+            inline bool IsSpace(char c) { return c == ' ' || c == '\t'; }
+            inline bool IsDigit(char c) { return static_cast<unsigned int>(c - '0') < 10u; }
+            // isspace() 中可能出现在行内的字符（sscanf / atoi 会跳过它们）
+            inline bool IsCSpace(char c) { return c == ' ' || c == '\t' || c == '\v' || c == '\f'; }
+            inline bool IsTokenEnd(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+            inline void SkipSpaces(const char*& p, const char* end)
+            {
+                while (p < end && IsSpace(*p))
+                {
+                    ++p;
+                }
+            }
+
+            // 与 tinyobj 的 tryParseDouble 逐条一致；在 s_end 处额外做边界检查
+            // （tinyobj 的 s_end 总是指向分隔符，读到的值不是数字，因此结果相同）
+            bool TryParseDouble(const char* s, const char* s_end, double* result)
+            {
+                if (s >= s_end)
+                {
+                    return false;
+                }
+
+                double mantissa = 0.0;
+                int exponent = 0;
+                char sign = '+';
+                char exp_sign = '+';
+                const char* curr = s;
+                int read = 0;
+                bool end_not_reached = false;
+
+                if (*curr == '+' || *curr == '-')
+                {
+                    sign = *curr;
+                    curr++;
+                }
+                else if (!IsDigit(*curr))
+                {
+                    return false;
+                }
+
+                // 整数部分
+                end_not_reached = (curr != s_end);
+                while (end_not_reached && IsDigit(*curr))
+                {
+                    mantissa *= 10;
+                    mantissa += static_cast<int>(*curr - 0x30);
+                    curr++;
+                    read++;
+                    end_not_reached = (curr != s_end);
+                }
+
+                if (read == 0)
+                {
+                    return false;
+                }
+                if (!end_not_reached)
+                {
+                    goto assemble;
+                }
+
+                // 小数部分
+                if (*curr == '.')
+                {
+                    curr++;
+                    read = 1;
+                    end_not_reached = (curr != s_end);
+                    while (end_not_reached && IsDigit(*curr))
+                    {
+                        static const double pow_lut[] = {
+                            1.0, 0.1, 0.01, 0.001, 0.0001, 0.00001, 0.000001, 0.0000001,
+                        };
+                        const int lut_entries = sizeof pow_lut / sizeof pow_lut[0];
+
+                        mantissa += static_cast<int>(*curr - 0x30) *
+                                    (read < lut_entries ? pow_lut[read] : std::pow(10.0, -read));
+                        read++;
+                        curr++;
+                        end_not_reached = (curr != s_end);
+                    }
+                }
+                else if (*curr != 'e' && *curr != 'E')
+                {
+                    goto assemble;
+                }
+
+                if (!end_not_reached)
+                {
+                    goto assemble;
+                }
+
+                // 指数部分
+                if (*curr == 'e' || *curr == 'E')
+                {
+                    curr++;
+                    end_not_reached = (curr != s_end);
+                    if (end_not_reached && (*curr == '+' || *curr == '-'))
+                    {
+                        exp_sign = *curr;
+                        curr++;
+                    }
+                    else if (!(end_not_reached && IsDigit(*curr)))
+                    {
+                        return false;
+                    }
+
+                    read = 0;
+                    end_not_reached = (curr != s_end);
+                    while (end_not_reached && IsDigit(*curr))
+                    {
+                        exponent *= 10;
+                        exponent += static_cast<int>(*curr - 0x30);
+                        curr++;
+                        read++;
+                        end_not_reached = (curr != s_end);
+                    }
+                    exponent *= (exp_sign == '+' ? 1 : -1);
+                    if (read == 0)
+                    {
+                        return false;
+                    }
+                }
+
+            assemble:
+                *result = (sign == '+' ? 1 : -1) *
+                          (exponent ? std::ldexp(mantissa * std::pow(5.0, exponent), exponent) : mantissa);
+                return true;
+            }
+
+            inline tinyobj::real_t ParseReal(const char*& p, const char* end)
+            {
+                SkipSpaces(p, end);
+                const char* tokenEnd = p;
+                while (tokenEnd < end && !IsTokenEnd(*tokenEnd))
+                {
+                    ++tokenEnd;
+                }
+                double value = 0.0;
+                TryParseDouble(p, tokenEnd, &value);
+                p = tokenEnd;
+                return static_cast<tinyobj::real_t>(value);
+            }
+
+            // atoi 语义：跳过空白、可选符号、十进制数字；行尾视为空串（返回 0）
+            inline int ParseInt(const char* p, const char* end)
+            {
+                while (p < end && IsCSpace(*p))
+                {
+                    ++p;
+                }
+                bool negative = false;
+                if (p < end && (*p == '+' || *p == '-'))
+                {
+                    negative = (*p == '-');
+                    ++p;
+                }
+                long long value = 0;
+                while (p < end && IsDigit(*p))
+                {
+                    value = std::min<long long>(value * 10 + (*p - '0'), 0x7FFFFFFFLL);
+                    ++p;
+                }
+                return static_cast<int>(negative ? -value : value);
+            }
+
+            // tinyobj 的 fixIndex：1 起始转 0 起始，负数相对于当前已解析的数量
+            inline int FixIndex(int idx, size_t localCount, uint8_t flag, uint8_t& relativeFlags)
+            {
+                if (idx > 0)
+                {
+                    return idx - 1;
+                }
+                if (idx == 0)
+                {
+                    return 0;
+                }
+                // 块内只知道本块的数量，块起始的全局偏移在合并时补上
+                relativeFlags |= flag;
+                return static_cast<int>(localCount) + idx;
+            }
+
+            inline void SkipIndexToken(const char*& p, const char* end)
+            {
+                while (p < end && *p != '/' && !IsTokenEnd(*p))
+                {
+                    ++p;
+                }
+            }
+
+            // i, i/j, i//k, i/j/k
+            tinyobj::index_t ParseTriple(const char*& p, const char* end, const Chunk& chunk, uint8_t& relativeFlags)
+            {
+                tinyobj::index_t index{-1, -1, -1};
+                const size_t vCount = chunk.v.size() / 3;
+                const size_t vnCount = chunk.vn.size() / 3;
+                const size_t vtCount = chunk.vt.size() / 2;
+
+                index.vertex_index = FixIndex(ParseInt(p, end), vCount, kRelativeVertex, relativeFlags);
+                SkipIndexToken(p, end);
+                if (p >= end || *p != '/')
+                {
+                    return index;
+                }
+                ++p;
+
+                if (p < end && *p == '/')
+                {
+                    ++p;
+                    index.normal_index = FixIndex(ParseInt(p, end), vnCount, kRelativeNormal, relativeFlags);
+                    SkipIndexToken(p, end);
+                    return index;
+                }
+
+                index.texcoord_index = FixIndex(ParseInt(p, end), vtCount, kRelativeTexcoord, relativeFlags);
+                SkipIndexToken(p, end);
+                if (p >= end || *p != '/')
+                {
+                    return index;
+                }
+                ++p;
+
+                index.normal_index = FixIndex(ParseInt(p, end), vnCount, kRelativeNormal, relativeFlags);
+                SkipIndexToken(p, end);
+                return index;
+            }
+
+            // sscanf("%s")：跳过空白后读取到下一个空白
+            std::string ScanWord(const char* p, const char* end)
+            {
+                while (p < end && IsCSpace(*p))
+                {
+                    ++p;
+                }
+                const char* wordEnd = p;
+                while (wordEnd < end && !IsCSpace(*wordEnd))
+                {
+                    ++wordEnd;
+                }
+                return std::string(p, wordEnd);
+            }
+
+            void ParseLine(Chunk& chunk, const char* p, const char* end,
+                           std::vector<tinyobj::index_t>& face, std::vector<uint8_t>& faceRelative)
+            {
+                SkipSpaces(p, end);
+                if (p >= end || *p == '#')
+                {
+                    return;
+                }
+
+                auto at = [&](size_t i) { return p + i < end ? p[i] : '\0'; };
+                const char c0 = p[0];
+
+                if (c0 == 'v' && IsSpace(at(1)))
+                {
+                    p += 2;
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        chunk.v.push_back(ParseReal(p, end));
+                    }
+                    return;
+                }
+
+                if (c0 == 'v' && at(1) == 'n' && IsSpace(at(2)))
+                {
+                    p += 3;
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        chunk.vn.push_back(ParseReal(p, end));
+                    }
+                    return;
+                }
+
+                if (c0 == 'v' && at(1) == 't' && IsSpace(at(2)))
+                {
+                    p += 3;
+                    for (int i = 0; i < 2; ++i)
+                    {
+                        chunk.vt.push_back(ParseReal(p, end));
+                    }
+                    return;
+                }
+
+                if (c0 == 'f' && IsSpace(at(1)))
+                {
+                    p += 2;
+                    SkipSpaces(p, end);
+
+                    face.clear();
+                    faceRelative.clear();
+                    while (p < end)
+                    {
+                        uint8_t relativeFlags = 0;
+                        face.push_back(ParseTriple(p, end, chunk, relativeFlags));
+                        faceRelative.push_back(relativeFlags);
+                        while (p < end && IsTokenEnd(*p))
+                        {
+                            ++p;
+                        }
+                    }
+
+                    // 扇形三角化 (0, k-1, k)；少于 3 个顶点的面不产生三角形，但仍计入面数
+                    ++chunk.faceCount;
+                    for (size_t k = 2; k < face.size(); ++k)
+                    {
+                        const size_t source[3] = {0, k - 1, k};
+                        for (size_t s : source)
+                        {
+                            chunk.corners.push_back(face[s]);
+                            if (faceRelative[s] != 0)
+                            {
+                                const size_t corner = chunk.corners.size() - 1;
+                                for (uint8_t bit = 0; bit < 3; ++bit)
+                                {
+                                    if (faceRelative[s] & (1u << bit))
+                                    {
+                                        chunk.relative.push_back((corner << 2) | bit);
+                                    }
+                                }
+                            }
+                        }
+                    }
+                    return;
+                }
+
+                const size_t triangleCount = chunk.corners.size() / 3;
+
+                if (end - p >= 7 && std::memcmp(p, "usemtl", 6) == 0 && IsSpace(p[6]))
+                {
+                    chunk.events.push_back({ChunkEvent::Type::UseMaterial, chunk.faceCount, triangleCount,
+                                            ScanWord(p + 7, end)});
+                    return;
+                }
+
+                if (end - p >= 7 && std::memcmp(p, "mtllib", 6) == 0 && IsSpace(p[6]))
+                {
+                    chunk.events.push_back({ChunkEvent::Type::MaterialLibrary, chunk.faceCount, triangleCount,
+                                            std::string(p + 7, end)});
+                    return;
+                }
+
+                if (c0 == 'g' && IsSpace(at(1)))
+                {
+                    // 第一个单词是 "g" 本身，第二个单词为组名
+                    const char* name = p + 1;
+                    SkipSpaces(name, end);
+                    const char* nameEnd = name;
+                    while (nameEnd < end && !IsTokenEnd(*nameEnd))
+                    {
+                        ++nameEnd;
+                    }
+                    chunk.events.push_back({ChunkEvent::Type::Group, chunk.faceCount, triangleCount,
+                                            std::string(name, nameEnd)});
+                    return;
+                }
+
+                if (c0 == 'o' && IsSpace(at(1)))
+                {
+                    chunk.events.push_back({ChunkEvent::Type::Group, chunk.faceCount, triangleCount,
+                                            ScanWord(p + 2, end)});
+                    return;
+                }
+
+                // 其他命令（t、s、l、p 等）忽略，与渲染输出无关
+            }
+
+            void ParseChunk(Chunk& chunk)
+            {
+                std::vector<tinyobj::index_t> face;
+                std::vector<uint8_t> faceRelative;
+
+                const char* p = chunk.begin;
+                const char* end = chunk.end;
+                while (p < end)
+                {
+                    // 行结束符：\n、\r\n 或单独的 \r（与 tinyobj 的 safeGetline 相同）
+                    const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+                    const char* lineEnd = newline ? newline : end;
+                    const char* next = newline ? newline + 1 : end;
+
+                    const char* cr = static_cast<const char*>(std::memchr(p, '\r', static_cast<size_t>(lineEnd - p)));
+                    if (cr)
+                    {
+                        lineEnd = cr;
+                        next = (cr + 1 < end && cr[1] == '\n') ? cr + 2 : cr + 1;
+                    }
+
+                    ParseLine(chunk, p, lineEnd, face, faceRelative);
+                    p = next;
+                }
+            }
+
+            // 与 tinyobj 的 SplitString 相同（std::getline 语义，保留中间的空项）
+            std::vector<std::string> SplitString(const std::string& s, char delim)
+            {
+                std::vector<std::string> elems;
+                std::stringstream ss(s);
+                std::string item;
+                while (std::getline(ss, item, delim))
+                {
+                    elems.push_back(item);
+                }
+                return elems;
+            }
+
+            // mtllib：依次尝试每个文件名，第一个成功的生效（与 tinyobj 相同）
+            void LoadMaterialLibrary(tinyobj::MaterialFileReader& reader, const std::string& text,
+                                     std::vector<tinyobj::material_t>* materials,
+                                     std::map<std::string, int>* materialMap, std::string* err)
+            {
+                const std::vector<std::string> filenames = SplitString(text, ' ');
+                if (filenames.empty())
+                {
+                    if (err)
+                    {
+                        (*err) += "WARN: Looks like empty filename for mtllib. Use default material. \n";
+                    }
+                    return;
+                }
+
+                for (const std::string& filename : filenames)
+                {
+                    std::string materialError;
+                    const bool ok = reader(filename, materials, materialMap, &materialError);
+                    if (err && !materialError.empty())
+                    {
+                        (*err) += materialError;
+                    }
+                    if (ok)
+                    {
+                        return;
+                    }
+                }
+                if (err)
+                {
+                    (*err) += "WARN: Failed to load material file(s). Use default material.\n";
+                }
+            }
+
+            // 把 [begin, end) 按行边界切块并在线程池上并行解析
+            std::vector<Chunk> ParseRange(const char* begin, const char* end)
+            {
+                Core::ThreadPool& pool = Core::ThreadPool::GetInstance();
+                const size_t size = static_cast<size_t>(end - begin);
+                const size_t maxChunks = pool.GetThreadCount() + 1;  // ParallelFor 按连续范围分配，每线程一块即可
+                const size_t chunkCount = std::clamp<size_t>(size / kMinChunkBytes, 1, maxChunks);
+
+                std::vector<Chunk> chunks;
+                chunks.reserve(chunkCount);
+                size_t chunkBegin = 0;
+                for (size_t i = 1; i <= chunkCount && chunkBegin < size; ++i)
+                {
+                    size_t chunkEnd = size;
+                    if (i < chunkCount)
+                    {
+                        const size_t target = std::max(chunkBegin, size * i / chunkCount);
+                        const void* newline = std::memchr(begin + target, '\n', size - target);
+                        chunkEnd = newline ? static_cast<size_t>(static_cast<const char*>(newline) - begin) + 1 : size;
+                    }
+
+                    Chunk chunk;
+                    chunk.begin = begin + chunkBegin;
+                    chunk.end = begin + chunkEnd;
+                    chunks.push_back(std::move(chunk));
+                    chunkBegin = chunkEnd;
+                }
+
+                pool.ParallelFor(chunks.size(), [&](size_t first, size_t last) {
+                    for (size_t i = first; i < last; ++i)
+                    {
+                        ParseChunk(chunks[i]);
+                    }
+                });
+                return chunks;
+            }
+
+            struct ChunkOffsets
+            {
+                std::vector<size_t> faceBase;      // 每块第一个面（相对本批块）
+                std::vector<size_t> triangleBase;  // 每块第一个三角形（相对本批块）
+                size_t faceTotal = 0;
+                size_t triangleTotal = 0;
+            };
+
+            // 属性追加到 attrib 末尾（相对索引加上全局偏移），本批块的三角形角点写入 corners
+            ChunkOffsets MergeChunks(std::vector<Chunk>& chunks, tinyobj::attrib_t* attrib,
+                                     std::vector<tinyobj::index_t>& corners)
+            {
+                ChunkOffsets offsets;
+                offsets.faceBase.resize(chunks.size());
+                offsets.triangleBase.resize(chunks.size());
+                std::vector<size_t> vBase(chunks.size()), vnBase(chunks.size()), vtBase(chunks.size());
+                size_t vTotal = attrib->vertices.size() / 3;
+                size_t vnTotal = attrib->normals.size() / 3;
+                size_t vtTotal = attrib->texcoords.size() / 2;
+                for (size_t i = 0; i < chunks.size(); ++i)
+                {
+                    vBase[i] = vTotal;
+                    vnBase[i] = vnTotal;
+                    vtBase[i] = vtTotal;
+                    offsets.faceBase[i] = offsets.faceTotal;
+                    offsets.triangleBase[i] = offsets.triangleTotal;
+                    vTotal += chunks[i].v.size() / 3;
+                    vnTotal += chunks[i].vn.size() / 3;
+                    vtTotal += chunks[i].vt.size() / 2;
+                    offsets.faceTotal += chunks[i].faceCount;
+                    offsets.triangleTotal += chunks[i].corners.size() / 3;
+                }
+
+                attrib->vertices.resize(vTotal * 3);
+                attrib->normals.resize(vnTotal * 3);
+                attrib->texcoords.resize(vtTotal * 2);
+                corners.resize(offsets.triangleTotal * 3);
+
+                Core::ThreadPool::GetInstance().ParallelFor(chunks.size(), [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        Chunk& chunk = chunks[i];
+                        for (size_t entry : chunk.relative)
+                        {
+                            tinyobj::index_t& corner = chunk.corners[entry >> 2];
+                            switch (entry & 3u)
+                            {
+                                case 0: corner.vertex_index += static_cast<int>(vBase[i]); break;
+                                case 1: corner.normal_index += static_cast<int>(vnBase[i]); break;
+                                default: corner.texcoord_index += static_cast<int>(vtBase[i]); break;
+                            }
+                        }
+
+                        std::copy(chunk.v.begin(), chunk.v.end(), attrib->vertices.begin() + vBase[i] * 3);
+                        std::copy(chunk.vn.begin(), chunk.vn.end(), attrib->normals.begin() + vnBase[i] * 3);
+                        std::copy(chunk.vt.begin(), chunk.vt.end(), attrib->texcoords.begin() + vtBase[i] * 2);
+                        std::copy(chunk.corners.begin(), chunk.corners.end(),
+                                  corners.begin() + offsets.triangleBase[i] * 3);
+
+                        std::vector<tinyobj::real_t>().swap(chunk.v);
+                        std::vector<tinyobj::real_t>().swap(chunk.vn);
+                        std::vector<tinyobj::real_t>().swap(chunk.vt);
+                        std::vector<tinyobj::index_t>().swap(chunk.corners);
+                    }
+                });
+                return offsets;
+            }
+
+            struct ShapeRange
+            {
+                size_t begin;  // 三角形范围 [begin, end)
+                size_t end;
+                std::string name;
+            };
+        } // namespace
+
+        bool LoadObj(tinyobj::attrib_t* attrib, std::vector<tinyobj::shape_t>* shapes,
+                     std::vector<tinyobj::material_t>* materials, std::string* err,
+                     const std::string& filepath, const std::string& basePath)
+        {
+            attrib->vertices.clear();
+            attrib->normals.clear();
+            attrib->texcoords.clear();
+            shapes->clear();
+
+            Core::MappedFile file;
+            if (!file.Open(filepath))
+            {
+                if (err)
+                {
+                    (*err) = "Cannot open file [" + filepath + "]\n";
+                }
+                return false;
+            }
+
+            const char* data = reinterpret_cast<const char*>(file.Data());
+            const size_t size = file.Size();
+
+            // ========================================
+            // 1-3. 按行边界切块并行解析，前缀和得到全局偏移后拼接
+            // ========================================
+            std::vector<Chunk> chunks = ParseRange(data, data + size);
+            std::vector<tinyobj::index_t> corners;
+            const ChunkOffsets offsets = MergeChunks(chunks, attrib, corners);
+            const std::vector<size_t>& faceBase = offsets.faceBase;
+            const std::vector<size_t>& triangleBase = offsets.triangleBase;
+            const size_t faceTotal = offsets.faceTotal;
+            const size_t triangleTotal = offsets.triangleTotal;
+
+            // ========================================
+            // 4. 按文件顺序回放事件（材质加载、usemtl、shape 划分）
+            // ========================================
+            // 与 tinyobj 的状态机一致：
+            // - usemtl 切换材质时，把当前面组刷新到 shape（groupStart 前移）
+            // - g / o 时，面组非空则提交整个 shape；面组为空则 shape（包括已刷新的面）被丢弃
+            // - 文件结束时，面组非空或 shape 已有三角形则提交
+            tinyobj::MaterialFileReader materialReader(basePath);
+            std::map<std::string, int> materialMap;
+            int material = -1;
+            std::string name;
+
+            size_t shapeStartTriangle = 0;
+            size_t groupStartFace = 0;
+            size_t groupStartTriangle = 0;
+            std::vector<ShapeRange> shapeRanges;
+            std::vector<std::pair<size_t, int>> materialRuns{{0, -1}};  // (起始三角形, 材质)
+
+            for (size_t i = 0; i < chunks.size(); ++i)
+            {
+                for (const ChunkEvent& event : chunks[i].events)
+                {
+                    const size_t face = faceBase[i] + event.faceOffset;
+                    const size_t triangle = triangleBase[i] + event.triangleOffset;
+
+                    switch (event.type)
+                    {
+                        case ChunkEvent::Type::UseMaterial:
+                        {
+                            auto it = materialMap.find(event.text);
+                            const int newMaterial = (it != materialMap.end()) ? it->second : -1;
+                            if (newMaterial != material)
+                            {
+                                groupStartFace = face;
+                                groupStartTriangle = triangle;
+                                material = newMaterial;
+                                materialRuns.emplace_back(triangle, material);
+                            }
+                            break;
+                        }
+                        case ChunkEvent::Type::MaterialLibrary:
+                        {
+                            LoadMaterialLibrary(materialReader, event.text, materials, &materialMap, err);
+                            break;
+                        }
+                        case ChunkEvent::Type::Group:
+                        {
+                            if (face > groupStartFace)
+                            {
+                                shapeRanges.push_back({shapeStartTriangle, triangle, name});
+                            }
+                            shapeStartTriangle = triangle;
+                            groupStartFace = face;
+                            groupStartTriangle = triangle;
+                            name = event.text;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            if (faceTotal > groupStartFace || groupStartTriangle > shapeStartTriangle)
+            {
+                shapeRanges.push_back({shapeStartTriangle, triangleTotal, name});
+            }
+
+            // 每个三角形的材质
+            std::vector<int> triangleMaterials(triangleTotal);
+            for (size_t r = 0; r < materialRuns.size(); ++r)
+            {
+                const size_t runEnd = (r + 1 < materialRuns.size()) ? materialRuns[r + 1].first : triangleTotal;
+                std::fill(triangleMaterials.begin() + materialRuns[r].first, triangleMaterials.begin() + runEnd,
+                          materialRuns[r].second);
+            }
+
+            // ========================================
+            // 5. 输出 shape
+            // ========================================
+            shapes->reserve(shapeRanges.size());
+            for (const ShapeRange& range : shapeRanges)
+            {
+                tinyobj::shape_t shape;
+                shape.name = range.name;
+
+                // 常见情况：整个文件一个 shape，直接移交数组
+                if (range.begin == 0 && range.end == triangleTotal && shapeRanges.size() == 1)
+                {
+                    shape.mesh.indices = std::move(corners);
+                    shape.mesh.material_ids = std::move(triangleMaterials);
+                }
+                else
+                {
+                    shape.mesh.indices.assign(corners.begin() + range.begin * 3, corners.begin() + range.end * 3);
+                    shape.mesh.material_ids.assign(triangleMaterials.begin() + range.begin,
+                                                   triangleMaterials.begin() + range.end);
+                }
+                shape.mesh.num_face_vertices.assign(range.end - range.begin, 3);
+                shapes->push_back(std::move(shape));
+            }
+
+            return true;
+        }
+
+        bool StreamObj(const std::string& filepath, const std::string& basePath, size_t windowBytes,
+                       const TriangleSink& sink, std::string* err)
+        {
+            Core::MappedFile file;
+            if (!file.Open(filepath))
+            {
+                if (err)
+                {
+                    (*err) = "Cannot open file [" + filepath + "]\n";
+                }
+                return false;
+            }
+
+            const char* data = reinterpret_cast<const char*>(file.Data());
+            const size_t size = file.Size();
+            windowBytes = std::max(windowBytes, kMinChunkBytes);
+
+            tinyobj::attrib_t attrib;
+            std::vector<tinyobj::material_t> materials;
+            tinyobj::MaterialFileReader materialReader(basePath);
+            std::map<std::string, int> materialMap;
+            int material = -1;
+
+            std::vector<tinyobj::index_t> corners;
+            std::vector<int> triangleMaterials;
+
+            size_t windowBegin = 0;
+            while (windowBegin < size)
+            {
+                // 窗口在行边界结束（最后一行可能没有换行符）
+                size_t windowEnd = size;
+                if (size - windowBegin > windowBytes)
+                {
+                    const size_t target = windowBegin + windowBytes;
+                    const void* newline = std::memchr(data + target, '\n', size - target);
+                    windowEnd = newline ? static_cast<size_t>(static_cast<const char*>(newline) - data) + 1 : size;
+                }
+
+                std::vector<Chunk> chunks = ParseRange(data + windowBegin, data + windowEnd);
+                const ChunkOffsets offsets = MergeChunks(chunks, &attrib, corners);
+
+                // 回放 usemtl / mtllib，材质状态跨窗口保持；g / o 不影响流式输出
+                triangleMaterials.resize(offsets.triangleTotal);
+                size_t runStart = 0;
+                for (size_t i = 0; i < chunks.size(); ++i)
+                {
+                    for (const ChunkEvent& event : chunks[i].events)
+                    {
+                        if (event.type == ChunkEvent::Type::MaterialLibrary)
+                        {
+                            LoadMaterialLibrary(materialReader, event.text, &materials, &materialMap, err);
+                        }
+                        else if (event.type == ChunkEvent::Type::UseMaterial)
+                        {
+                            const size_t triangle = offsets.triangleBase[i] + event.triangleOffset;
+                            std::fill(triangleMaterials.begin() + runStart, triangleMaterials.begin() + triangle, material);
+                            runStart = triangle;
+                            auto it = materialMap.find(event.text);
+                            material = (it != materialMap.end()) ? it->second : -1;
+                        }
+                    }
+                }
+                std::fill(triangleMaterials.begin() + runStart, triangleMaterials.end(), material);
+
+                if (!corners.empty() && !sink(attrib, materials, corners, triangleMaterials))
+                {
+                    if (err)
+                    {
+                        (*err) += "Streaming import of [" + filepath + "] cancelled\n";
+                    }
+                    return false;
+                }
+
+                // 已解析的窗口不再访问，提示内核回收页缓存映射
+                file.Release(windowBegin, windowEnd - windowBegin);
+                windowBegin = windowEnd;
+            }
+
+            return true;
+        }
+
+    } // namespace OBJParser
+} // namespace Renderer
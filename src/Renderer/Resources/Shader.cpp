@@ -1,4 +1,6 @@
 #include "Renderer/Resources/Shader.hpp"
+#include "Renderer/Resources/AssetArchive.hpp"
+#include "Renderer/Renderer/FrameStatistics.hpp"
 #include "Core/Logger.hpp"
 #include <glad/glad.h>
 #include <fstream>
@@ -20,6 +22,19 @@ namespace Renderer
     {
         Core::Logger::GetInstance().Info("Loading shader program from: " + vertexPath + " and " + fragmentPath);
 
+        // ⭐ 打包文件中的源码直接传给 glShaderSource（带长度，无需拷贝或补 '\0'）
+        if (auto archive = AssetArchive::GetMounted())
+        {
+            const AssetArchiveEntry *vEntry = archive->Find(vertexPath, AssetType::Shader);
+            const AssetArchiveEntry *fEntry = archive->Find(fragmentPath, AssetType::Shader);
+            if (vEntry && fEntry)
+            {
+                Compile(reinterpret_cast<const char *>(archive->GetData(*vEntry)), static_cast<int>(vEntry->size),
+                        reinterpret_cast<const char *>(archive->GetData(*fEntry)), static_cast<int>(fEntry->size));
+                return;
+            }
+        }
+
         // 读取文件
         std::ifstream vFile(vertexPath);
         std::ifstream fFile(fragmentPath);
@@ -43,10 +58,15 @@ namespace Renderer
         std::string vertexCode = vStream.str();
         std::string fragmentCode = fStream.str();
 
+        Compile(vertexCode.data(), static_cast<int>(vertexCode.size()),
+                fragmentCode.data(), static_cast<int>(fragmentCode.size()));
+    }
+
+    void Shader::Compile(const char *vertexCode, int vertexLength, const char *fragmentCode, int fragmentLength)
+    {
         // 编译顶点着色器
         unsigned int vertex = glCreateShader(GL_VERTEX_SHADER);
-        const char *vCode = vertexCode.c_str();
-        glShaderSource(vertex, 1, &vCode, nullptr);
+        glShaderSource(vertex, 1, &vertexCode, &vertexLength);
         glCompileShader(vertex);
 
         int success;
@@ -62,8 +82,7 @@ namespace Renderer
 
         // 编译片段着色器
         unsigned int fragment = glCreateShader(GL_FRAGMENT_SHADER);
-        const char *fCode = fragmentCode.c_str();
-        glShaderSource(fragment, 1, &fCode, nullptr);
+        glShaderSource(fragment, 1, &fragmentCode, &fragmentLength);
         glCompileShader(fragment);
 
         glGetShaderiv(fragment, GL_COMPILE_STATUS, &success);
@@ -105,7 +124,7 @@ namespace Renderer
     void Shader::Use() const
     {
         glUseProgram(m_id);
-        Core::Logger::GetInstance().LogShaderActivation(m_id);
+        RENDER_STATS_ADD(ShaderBinds, 1);
     }
 
     // 传递矩阵、向量、整数与浮点数到着色器
@@ -134,4 +153,15 @@ namespace Renderer
         glUniform1i(glGetUniformLocation(m_id, name.c_str()), static_cast<int>(value));
     }
 
-} // namespace Renderer
\ No newline at end of file
+    bool Shader::BindUniformBlock(const std::string &blockName, unsigned int bindingPoint) const
+    {
+        GLuint blockIndex = glGetUniformBlockIndex(m_id, blockName.c_str());
+        if (blockIndex == GL_INVALID_INDEX)
+        {
+            return false;
+        }
+        glUniformBlockBinding(m_id, blockIndex, bindingPoint);
+        return true;
+    }
+
+} // namespace Renderer
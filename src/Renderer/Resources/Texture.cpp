@@ -1,17 +1,62 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "Renderer/Resources/Texture.hpp"
+#include "Renderer/Resources/AssetArchive.hpp"
+#include "Renderer/Resources/GLTFLoader.hpp"
+#include "Renderer/Renderer/FrameStatistics.hpp"
 #include "Core/Logger.hpp"
+#include "Core/Profiler.hpp"
 #include <iostream>
 #include <stb_image.h>
 #include <filesystem>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <limits>
 
 namespace fs = std::filesystem;
 
+// glad 只生成了 3.3 核心，S3TC / BPTC 属于扩展，这里补充枚举值
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM_ARB
+#define GL_COMPRESSED_RGBA_BPTC_UNORM_ARB 0x8E8C
+#endif
+
 namespace Renderer
 {
 
+    namespace
+    {
+        bool HasGLExtension(const char* name)
+        {
+            GLint count = 0;
+            glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+            for (GLint i = 0; i < count; ++i)
+            {
+                const char* ext = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+                if (ext && std::strcmp(ext, name) == 0)
+                    return true;
+            }
+            return false;
+        }
+
+        std::string ToLower(std::string s)
+        {
+            std::transform(s.begin(), s.end(), s.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return s;
+        }
+    } // namespace
+
     Texture::Texture()
-        : m_textureID(0), m_loaded(false)
+        : m_textureID(0), m_loaded(false), m_width(0), m_height(0), m_gpuSizeBytes(0), m_compressed(false)
     {
     }
 
@@ -27,7 +72,77 @@ namespace Renderer
         // 如果已经有纹理，先清理
         Cleanup();
 
-        m_filepath = filepath;
+        // ⭐ 打包文件中的预编码纹理：层级直接从映射上传，不经过中间拷贝
+        if (auto archive = AssetArchive::GetMounted())
+        {
+            if (const AssetArchiveEntry* entry = archive->Find(filepath, AssetType::Texture))
+            {
+                CompressedImageView view;
+                std::string error;
+                if (!TextureCompression::ParseDDS(archive->GetData(*entry), static_cast<size_t>(entry->size), view, &error))
+                {
+                    Core::Logger::GetInstance().Warning("Invalid archived texture " + filepath + ": " + error);
+                }
+                else if (LoadFromCompressedView(view, filepath))
+                {
+                    return true;
+                }
+                else
+                {
+                    // 预编码格式不被支持：与 LoadFromSource 相同，回退为解码源图像
+                    Core::Logger::GetInstance().Warning("Falling back to source image: " + filepath);
+                    TextureSource fallback;
+                    fallback.path = filepath;
+                    if (!DecodePixels(filepath, fallback))
+                    {
+                        m_filepath = filepath;
+                        return false;
+                    }
+                    return LoadFromSource(fallback);
+                }
+            }
+        }
+
+        TextureSource source;
+        if (!Decode(filepath, source))
+        {
+            m_filepath = filepath;
+            return false;
+        }
+        return LoadFromSource(source);
+    }
+
+    bool Texture::Decode(const std::string& filepath, TextureSource& source)
+    {
+        PROFILE_SCOPE("Texture::Decode");
+        source = TextureSource();
+        source.path = filepath;
+
+        // 打包文件优先（工作线程路径：拷贝层级，上传时映射可能已卸载）
+        if (auto archive = AssetArchive::GetMounted())
+        {
+            if (const AssetArchiveEntry* entry = archive->Find(filepath, AssetType::Texture))
+            {
+                std::string error;
+                if (TextureCompression::ReadDDSFromMemory(archive->GetData(*entry), static_cast<size_t>(entry->size),
+                                                          source.compressedImage, &error) &&
+                    source.compressedImage.faceCount == 1)
+                {
+                    source.compressed = true;
+                    return true;
+                }
+                Core::Logger::GetInstance().Warning("Invalid archived texture " + filepath + ": " + error);
+                source.compressedImage = CompressedImage();
+            }
+        }
+
+        // glTF 嵌入图像（"<glTF 路径>#image<N>"）：没有松散文件，直接在内存中解码
+        std::string gltfPath;
+        int imageIndex = -1;
+        if (GLTFLoader::ParseEmbeddedImageKey(filepath, gltfPath, imageIndex))
+        {
+            return DecodePixels(filepath, source);
+        }
 
         // 检查文件是否存在
         if (!fs::exists(filepath))
@@ -36,10 +151,51 @@ namespace Renderer
             return false;
         }
 
+        // ⭐ 预编码的块压缩纹理：直接上传，跳过解码和 mip 生成
+        if (ToLower(fs::path(filepath).extension().string()) == ".dds")
+        {
+            source.compressed = ReadCompressedFile(filepath, source.compressedImage);
+            return source.compressed;
+        }
+
+        std::string compressedPath = FindCompressedSibling(filepath);
+        if (!compressedPath.empty())
+        {
+            if (ReadCompressedFile(compressedPath, source.compressedImage))
+            {
+                source.compressed = true;
+                return true;
+            }
+            Core::Logger::GetInstance().Warning("Falling back to source image: " + filepath);
+        }
+
+        return DecodePixels(filepath, source);
+    }
+
+    bool Texture::DecodePixels(const std::string& filepath, TextureSource& source)
+    {
         // 加载图像数据
         int width, height, channels;
-        stbi_set_flip_vertically_on_load(true); // OpenGL的纹理坐标Y轴是反的
-        unsigned char* data = stbi_load(filepath.c_str(), &width, &height, &channels, 0);
+        // OpenGL的纹理坐标Y轴是反的；使用线程局部设置，工作线程解码时互不影响
+        stbi_set_flip_vertically_on_load_thread(1);
+        unsigned char* data = nullptr;
+        std::string gltfPath;
+        int imageIndex = -1;
+        if (GLTFLoader::ParseEmbeddedImageKey(filepath, gltfPath, imageIndex))
+        {
+            std::vector<uint8_t> encoded;
+            if (!GLTFLoader::ReadEmbeddedImage(filepath, encoded) ||
+                encoded.size() > static_cast<size_t>(std::numeric_limits<int>::max()))
+            {
+                Core::Logger::GetInstance().Error("Failed to read embedded image: " + filepath);
+                return false;
+            }
+            data = stbi_load_from_memory(encoded.data(), static_cast<int>(encoded.size()), &width, &height, &channels, 0);
+        }
+        else
+        {
+            data = stbi_load(filepath.c_str(), &width, &height, &channels, 0);
+        }
 
         if (!data)
         {
@@ -48,39 +204,81 @@ namespace Renderer
             return false;
         }
 
-        // 生成纹理
-        glGenTextures(1, &m_textureID);
-        glBindTexture(GL_TEXTURE_2D, m_textureID);
+        if (channels != 4 && channels != 3 && channels != 1)
+        {
+            Core::Logger::GetInstance().Error("Unsupported texture format with " + std::to_string(channels) + " channels");
+            stbi_image_free(data);
+            return false;
+        }
 
-        // 设置纹理参数
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        source.compressed = false;
+        source.compressedImage = CompressedImage();
+        source.pixels.assign(data, data + static_cast<size_t>(width) * height * channels);
+        source.width = width;
+        source.height = height;
+        source.channels = channels;
+
+        // 释放图像数据
+        stbi_image_free(data);
+        return true;
+    }
+
+    bool Texture::LoadFromSource(const TextureSource& source)
+    {
+        if (source.compressed)
+        {
+            if (LoadFromCompressed(source.compressedImage, source.path))
+            {
+                return true;
+            }
+            // 预编码格式不被支持：源文件本身就是 DDS 时无法回退
+            if (ToLower(fs::path(source.path).extension().string()) == ".dds")
+            {
+                return false;
+            }
+            Core::Logger::GetInstance().Warning("Falling back to source image: " + source.path);
+            TextureSource fallback;
+            fallback.path = source.path;
+            if (!DecodePixels(source.path, fallback))
+            {
+                return false;
+            }
+            return LoadFromSource(fallback);
+        }
+
+        Cleanup();
+        m_filepath = source.path;
 
         // 根据通道数确定格式
         GLenum format;
-        if (channels == 4)
+        if (source.channels == 4)
             format = GL_RGBA;
-        else if (channels == 3)
+        else if (source.channels == 3)
             format = GL_RGB;
-        else if (channels == 1)
+        else if (source.channels == 1)
             format = GL_RED;
         else
         {
-            Core::Logger::GetInstance().Error("Unsupported texture format with " + std::to_string(channels) + " channels");
-            stbi_image_free(data);
-            Cleanup();
+            Core::Logger::GetInstance().Error("Unsupported texture format with " + std::to_string(source.channels) + " channels");
             return false;
         }
 
+        // 生成纹理
+        glGenTextures(1, &m_textureID);
+        glBindTexture(GL_TEXTURE_2D, m_textureID);
+
+        // 设置纹理参数
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
         // 上传纹理数据
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+        glTexImage2D(GL_TEXTURE_2D, 0, format, source.width, source.height, 0, format, GL_UNSIGNED_BYTE,
+                     source.pixels.data());
+        RENDER_STATS_ADD(TextureBytesUploaded, source.pixels.size());
         glGenerateMipmap(GL_TEXTURE_2D);
 
-        // 释放图像数据
-        stbi_image_free(data);
-
         // 检查OpenGL错误
         GLenum error = glGetError();
         if (error != GL_NO_ERROR)
@@ -94,13 +292,212 @@ namespace Renderer
         glBindTexture(GL_TEXTURE_2D, 0);
 
         m_loaded = true;
-        Core::Logger::GetInstance().Info("Texture loaded successfully: " + filepath + " (" +
-                                        std::to_string(width) + "x" + std::to_string(height) + ", " +
-                                        std::to_string(channels) + " channels, ID: " + std::to_string(m_textureID) + ")");
+        m_compressed = false;
+        m_width = source.width;
+        m_height = source.height;
+        // 完整 mip 链约为基础层的 4/3
+        m_gpuSizeBytes = static_cast<size_t>(source.width) * source.height * source.channels * 4 / 3;
+        Core::Logger::GetInstance().Info("Texture loaded successfully: " + source.path + " (" +
+                                        std::to_string(source.width) + "x" + std::to_string(source.height) + ", " +
+                                        std::to_string(source.channels) + " channels, ID: " + std::to_string(m_textureID) + ")");
+
+        return true;
+    }
+
+    bool Texture::ReadCompressedFile(const std::string& ddsPath, CompressedImage& image)
+    {
+        std::string error;
+        if (!TextureCompression::ReadDDS(ddsPath, image, &error))
+        {
+            Core::Logger::GetInstance().Error("Failed to read compressed texture " + ddsPath + ": " + error);
+            return false;
+        }
+
+        if (image.faceCount != 1)
+        {
+            Core::Logger::GetInstance().Error("Compressed texture is a cubemap, expected 2D: " + ddsPath);
+            return false;
+        }
+
+        if (!image.flippedForGL)
+        {
+            // 转换器默认按 OpenGL 行序写入；未翻转的文件会上下颠倒
+            Core::Logger::GetInstance().Warning("Compressed texture was not flipped for OpenGL (use lumen-texconv without --no-flip): " + ddsPath);
+        }
+        return true;
+    }
+
+    bool Texture::LoadFromCompressed(const CompressedImage& image, const std::string& sourceName)
+    {
+        return LoadFromCompressedView(TextureCompression::MakeView(image), sourceName);
+    }
+
+    bool Texture::LoadFromCompressedView(const CompressedImageView& image, const std::string& sourceName)
+    {
+        Cleanup();
+        m_filepath = sourceName;
+
+        if (!image.IsValid() || image.faceCount != 1)
+        {
+            Core::Logger::GetInstance().Error("Invalid compressed image for texture: " + sourceName);
+            return false;
+        }
+
+        if (!IsCompressedFormatSupported(image.format))
+        {
+            Core::Logger::GetInstance().Error(std::string("Compressed format ") + TextureCompression::GetFormatName(image.format) +
+                                              " not supported by this OpenGL context: " + sourceName);
+            return false;
+        }
+
+        glGenTextures(1, &m_textureID);
+        glBindTexture(GL_TEXTURE_2D, m_textureID);
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                        image.mipCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.mipCount - 1));
+
+        if (!UploadCompressedLevels(GL_TEXTURE_2D, image, 0))
+        {
+            Core::Logger::GetInstance().Error("OpenGL error uploading compressed texture: " + sourceName);
+            Cleanup();
+            return false;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        m_loaded = true;
+        m_compressed = TextureCompression::IsBlockCompressed(image.format);
+        m_width = static_cast<int>(image.width);
+        m_height = static_cast<int>(image.height);
+        m_gpuSizeBytes = image.GetTotalSizeBytes();
 
+        Core::Logger::GetInstance().Info("Compressed texture loaded: " + sourceName + " (" +
+                                        std::to_string(image.width) + "x" + std::to_string(image.height) + ", " +
+                                        TextureCompression::GetFormatName(image.format) + ", " +
+                                        std::to_string(image.mipCount) + " mips, " +
+                                        std::to_string(m_gpuSizeBytes / 1024) + " KB, ID: " + std::to_string(m_textureID) + ")");
         return true;
     }
 
+    bool Texture::IsCompressedFormatSupported(BlockFormat format)
+    {
+        static const bool s3tc = HasGLExtension("GL_EXT_texture_compression_s3tc");
+        static const bool bptc = HasGLExtension("GL_ARB_texture_compression_bptc");
+
+        switch (format)
+        {
+        case BlockFormat::BC1:
+        case BlockFormat::BC3:
+            return s3tc;
+        case BlockFormat::BC7:
+            return bptc;
+        case BlockFormat::BC4:
+        case BlockFormat::BC5:
+        case BlockFormat::RGBA8:
+        case BlockFormat::RGBA16F:
+        case BlockFormat::RG16F:
+            return true; // RGTC 和半精度纹理为 OpenGL 3.0 核心
+        default:
+            return false;
+        }
+    }
+
+    GLenum Texture::GetGLInternalFormat(BlockFormat format)
+    {
+        switch (format)
+        {
+        case BlockFormat::BC1: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case BlockFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case BlockFormat::BC4: return GL_COMPRESSED_RED_RGTC1;
+        case BlockFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+        case BlockFormat::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM_ARB;
+        case BlockFormat::RGBA16F: return GL_RGBA16F;
+        case BlockFormat::RG16F: return GL_RG16F;
+        default: return GL_RGBA8;
+        }
+    }
+
+    bool Texture::UploadCompressedLevels(GLenum target, const CompressedImage& image, uint32_t face, uint32_t firstMip)
+    {
+        return UploadCompressedLevels(target, TextureCompression::MakeView(image), face, firstMip);
+    }
+
+    bool Texture::UploadCompressedLevels(GLenum target, const CompressedImageView& image, uint32_t face, uint32_t firstMip)
+    {
+        GLenum internalFormat = GetGLInternalFormat(image.format);
+        GLsizei width = std::max(1, static_cast<GLsizei>(image.width >> firstMip));
+        GLsizei height = std::max(1, static_cast<GLsizei>(image.height >> firstMip));
+
+        for (uint32_t mip = firstMip; mip < image.mipCount; ++mip)
+        {
+            size_t level = static_cast<size_t>(face) * image.mipCount + mip;
+            GLint glLevel = static_cast<GLint>(mip - firstMip);
+            if (!TextureCompression::IsBlockCompressed(image.format))
+            {
+                GLenum pixelFormat = image.format == BlockFormat::RG16F ? GL_RG : GL_RGBA;
+                GLenum pixelType = image.format == BlockFormat::RGBA8 ? GL_UNSIGNED_BYTE : GL_HALF_FLOAT;
+                glTexImage2D(target, glLevel, internalFormat, width, height, 0,
+                             pixelFormat, pixelType, image.levelData[level]);
+            }
+            else
+            {
+                glCompressedTexImage2D(target, glLevel, internalFormat, width, height, 0,
+                                       static_cast<GLsizei>(image.levelSizes[level]), image.levelData[level]);
+            }
+            RENDER_STATS_ADD(TextureBytesUploaded, image.levelSizes[level]);
+            width = std::max(1, width / 2);
+            height = std::max(1, height / 2);
+        }
+
+        return glGetError() == GL_NO_ERROR;
+    }
+
+    std::string Texture::FindCompressedSibling(const std::string& sourcePath)
+    {
+        std::string compressedPath = TextureCompression::GetCompressedSiblingPath(sourcePath);
+        if (compressedPath == sourcePath)
+        {
+            return "";
+        }
+
+        std::error_code ec;
+        if (!fs::exists(compressedPath, ec))
+        {
+            return "";
+        }
+
+        // 源文件更新过则认为预编码文件已过期
+        auto compressedTime = fs::last_write_time(compressedPath, ec);
+        if (ec)
+            return "";
+        auto sourceTime = fs::last_write_time(sourcePath, ec);
+        if (!ec && sourceTime > compressedTime)
+        {
+            Core::Logger::GetInstance().Warning("Compressed texture is older than source, ignoring: " + compressedPath);
+            return "";
+        }
+        return compressedPath;
+    }
+
+    void Texture::AdoptGLTexture(GLuint textureID, int width, int height, size_t gpuSizeBytes, bool compressed)
+    {
+        if (m_textureID != 0 && m_textureID != textureID)
+        {
+            glDeleteTextures(1, &m_textureID);
+        }
+        m_textureID = textureID;
+        m_loaded = textureID != 0;
+        m_width = width;
+        m_height = height;
+        m_gpuSizeBytes = gpuSizeBytes;
+        m_compressed = compressed;
+    }
+
     void Texture::Bind(GLenum textureUnit) const
     {
         if (!m_loaded)
@@ -108,7 +505,7 @@ namespace Renderer
 
         glActiveTexture(textureUnit);
         glBindTexture(GL_TEXTURE_2D, m_textureID);
-        Core::Logger::GetInstance().LogTextureBind(m_textureID);
+        RENDER_STATS_ADD(TextureBinds, 1);
     }
 
     void Texture::Unbind() const
@@ -125,6 +522,10 @@ namespace Renderer
         }
         m_loaded = false;
         m_filepath.clear();
+        m_width = 0;
+        m_height = 0;
+        m_gpuSizeBytes = 0;
+        m_compressed = false;
     }
 
 } // namespace Renderer
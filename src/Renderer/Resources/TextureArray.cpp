@@ -0,0 +1,219 @@
+#include "Renderer/Resources/TextureArray.hpp"
+#include "Renderer/Resources/TextureCompression.hpp"
+#include "Renderer/Renderer/FrameStatistics.hpp"
+#include "Core/Logger.hpp"
+#include <stb_image.h>
+#include <algorithm>
+
+namespace Renderer
+{
+
+    TextureArray::TextureArray()
+        : m_textureID(0), m_size(0), m_layerCount(0), m_capacity(0), m_gpuSizeBytes(0)
+    {
+    }
+
+    TextureArray::~TextureArray()
+    {
+        Cleanup();
+    }
+
+    TextureArray::TextureArray(TextureArray&& other) noexcept
+        : m_textureID(other.m_textureID)
+        , m_size(other.m_size)
+        , m_layerCount(other.m_layerCount)
+        , m_capacity(other.m_capacity)
+        , m_gpuSizeBytes(other.m_gpuSizeBytes)
+    {
+        other.m_textureID = 0;
+        other.m_size = 0;
+        other.m_layerCount = 0;
+        other.m_capacity = 0;
+        other.m_gpuSizeBytes = 0;
+    }
+
+    TextureArray& TextureArray::operator=(TextureArray&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Cleanup();
+
+            m_textureID = other.m_textureID;
+            m_size = other.m_size;
+            m_layerCount = other.m_layerCount;
+            m_capacity = other.m_capacity;
+            m_gpuSizeBytes = other.m_gpuSizeBytes;
+
+            other.m_textureID = 0;
+            other.m_size = 0;
+            other.m_layerCount = 0;
+            other.m_capacity = 0;
+            other.m_gpuSizeBytes = 0;
+        }
+        return *this;
+    }
+
+    bool TextureArray::LoadFromFiles(const std::vector<std::string>& filepaths, int size, int capacity)
+    {
+        Cleanup();
+
+        if (filepaths.empty() || size <= 0)
+        {
+            Core::Logger::GetInstance().Error("TextureArray::LoadFromFiles() - No layers or invalid size");
+            return false;
+        }
+
+        GLint maxLayers = 0;
+        glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+        if (static_cast<GLint>(filepaths.size()) > maxLayers)
+        {
+            Core::Logger::GetInstance().Error("TextureArray::LoadFromFiles() - " + std::to_string(filepaths.size()) +
+                                              " layers exceed GL_MAX_ARRAY_TEXTURE_LAYERS (" + std::to_string(maxLayers) + ")");
+            return false;
+        }
+
+        uint32_t layerSize = static_cast<uint32_t>(size);
+        GLsizei layerCount = static_cast<GLsizei>(filepaths.size());
+        GLsizei allocatedLayers = std::min<GLsizei>(std::max<GLsizei>(capacity, layerCount), maxLayers);
+        uint32_t mipCount = TextureCompression::GetFullMipCount(layerSize, layerSize);
+
+        glGenTextures(1, &m_textureID);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureID);
+
+        // 先分配全部层级的存储（包括预留的空闲层）
+        uint32_t levelSize = layerSize;
+        for (uint32_t mip = 0; mip < mipCount; ++mip)
+        {
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLint>(mip), GL_RGBA8,
+                         static_cast<GLsizei>(levelSize), static_cast<GLsizei>(levelSize), allocatedLayers,
+                         0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            levelSize = std::max<uint32_t>(1, levelSize >> 1);
+        }
+        m_size = size;
+
+        // 逐层解码、缩放、生成 mip 并上传
+        stbi_set_flip_vertically_on_load(true); // 与 Texture::LoadFromFile 保持一致
+        for (GLsizei layer = 0; layer < layerCount; ++layer)
+        {
+            UploadLayer(layer, filepaths[layer]);
+        }
+
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(mipCount - 1));
+
+        GLenum error = glGetError();
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        if (error != GL_NO_ERROR)
+        {
+            Core::Logger::GetInstance().Error("OpenGL error creating texture array: " + std::to_string(error));
+            Cleanup();
+            return false;
+        }
+
+        m_layerCount = layerCount;
+        m_capacity = allocatedLayers;
+        m_gpuSizeBytes = static_cast<size_t>(size) * size * 4 * allocatedLayers * 4 / 3;
+
+        Core::Logger::GetInstance().Info("TextureArray created: " + std::to_string(layerCount) + "/" +
+                                         std::to_string(allocatedLayers) + " layers, " +
+                                         std::to_string(size) + "x" + std::to_string(size) + ", " +
+                                         std::to_string(mipCount) + " mips (ID: " + std::to_string(m_textureID) + ")");
+        return true;
+    }
+
+    bool TextureArray::AppendFromFiles(const std::vector<std::string>& filepaths)
+    {
+        if (m_textureID == 0 || m_layerCount + static_cast<int>(filepaths.size()) > m_capacity)
+        {
+            return false;
+        }
+        if (filepaths.empty())
+        {
+            return true;
+        }
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureID);
+        stbi_set_flip_vertically_on_load(true);
+        for (size_t i = 0; i < filepaths.size(); ++i)
+        {
+            UploadLayer(static_cast<GLsizei>(m_layerCount + i), filepaths[i]);
+        }
+
+        GLenum error = glGetError();
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        if (error != GL_NO_ERROR)
+        {
+            Core::Logger::GetInstance().Error("OpenGL error appending texture array layers: " + std::to_string(error));
+            return false;
+        }
+
+        m_layerCount += static_cast<int>(filepaths.size());
+        Core::Logger::GetInstance().Info("TextureArray appended: " + std::to_string(filepaths.size()) + " layers (" +
+                                         std::to_string(m_layerCount) + "/" + std::to_string(m_capacity) +
+                                         ", ID: " + std::to_string(m_textureID) + ")");
+        return true;
+    }
+
+    void TextureArray::UploadLayer(GLsizei layer, const std::string& path)
+    {
+        // 调用方已绑定纹理数组
+        const uint32_t layerSize = static_cast<uint32_t>(m_size);
+        const uint32_t mipCount = TextureCompression::GetFullMipCount(layerSize, layerSize);
+
+        int width = 0, height = 0, channels = 0;
+        unsigned char* pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
+
+        std::vector<uint8_t> rgba;
+        if (pixels)
+        {
+            std::vector<uint8_t> source(pixels, pixels + static_cast<size_t>(width) * height * 4);
+            stbi_image_free(pixels);
+            rgba = TextureCompression::ResizeRGBA8(source, static_cast<uint32_t>(width), static_cast<uint32_t>(height),
+                                                   layerSize, layerSize);
+        }
+        else
+        {
+            Core::Logger::GetInstance().Warning("TextureArray - Failed to load layer " + std::to_string(layer) + ": " +
+                                                path + " (" + stbi_failure_reason() + ")");
+            rgba.assign(static_cast<size_t>(layerSize) * layerSize * 4, 255);
+        }
+
+        std::vector<std::vector<uint8_t>> mips = TextureCompression::BuildMipChainRGBA8(std::move(rgba), layerSize, layerSize);
+        uint32_t levelSize = layerSize;
+        for (uint32_t mip = 0; mip < mipCount; ++mip)
+        {
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLint>(mip), 0, 0, layer,
+                            static_cast<GLsizei>(levelSize), static_cast<GLsizei>(levelSize), 1,
+                            GL_RGBA, GL_UNSIGNED_BYTE, mips[mip].data());
+            RENDER_STATS_ADD(TextureBytesUploaded, mips[mip].size());
+            levelSize = std::max<uint32_t>(1, levelSize >> 1);
+        }
+    }
+
+    void TextureArray::Bind(GLenum textureUnit) const
+    {
+        if (m_textureID == 0)
+            return;
+
+        glActiveTexture(textureUnit);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureID);
+        RENDER_STATS_ADD(TextureBinds, 1);
+    }
+
+    void TextureArray::Cleanup()
+    {
+        if (m_textureID != 0)
+        {
+            glDeleteTextures(1, &m_textureID);
+            m_textureID = 0;
+        }
+        m_size = 0;
+        m_layerCount = 0;
+        m_capacity = 0;
+        m_gpuSizeBytes = 0;
+    }
+
+} // namespace Renderer
@@ -0,0 +1,1222 @@
+#include "Renderer/Resources/TextureCompression.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace Renderer
+{
+    namespace
+    {
+        // ============================================================
+        // DDS 常量
+        // ============================================================
+
+        constexpr uint32_t MakeFourCC(char a, char b, char c, char d)
+        {
+            return static_cast<uint32_t>(static_cast<uint8_t>(a)) |
+                   (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8) |
+                   (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16) |
+                   (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+        }
+
+        constexpr uint32_t DDS_MAGIC = MakeFourCC('D', 'D', 'S', ' ');
+        constexpr uint32_t LUMENARIS_TAG = MakeFourCC('L', 'M', 'N', 'R');
+
+        constexpr uint32_t DDSD_CAPS = 0x1;
+        constexpr uint32_t DDSD_HEIGHT = 0x2;
+        constexpr uint32_t DDSD_WIDTH = 0x4;
+        constexpr uint32_t DDSD_PITCH = 0x8;
+        constexpr uint32_t DDSD_PIXELFORMAT = 0x1000;
+        constexpr uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+        constexpr uint32_t DDSD_LINEARSIZE = 0x80000;
+
+        constexpr uint32_t DDPF_ALPHAPIXELS = 0x1;
+        constexpr uint32_t DDPF_FOURCC = 0x4;
+        constexpr uint32_t DDPF_RGB = 0x40;
+
+        constexpr uint32_t DDSCAPS_COMPLEX = 0x8;
+        constexpr uint32_t DDSCAPS_TEXTURE = 0x1000;
+        constexpr uint32_t DDSCAPS_MIPMAP = 0x400000;
+        constexpr uint32_t DDSCAPS2_CUBEMAP_ALL_FACES = 0xFE00;
+
+        constexpr uint32_t DXGI_FORMAT_R16G16B16A16_FLOAT = 10;
+        constexpr uint32_t DXGI_FORMAT_R8G8B8A8_UNORM = 28;
+        constexpr uint32_t DXGI_FORMAT_R16G16_FLOAT = 34;
+        constexpr uint32_t DXGI_FORMAT_BC1_UNORM = 71;
+        constexpr uint32_t DXGI_FORMAT_BC3_UNORM = 77;
+        constexpr uint32_t DXGI_FORMAT_BC4_UNORM = 80;
+        constexpr uint32_t DXGI_FORMAT_BC5_UNORM = 83;
+        constexpr uint32_t DXGI_FORMAT_BC7_UNORM = 98;
+        constexpr uint32_t DXGI_FORMAT_BC7_UNORM_SRGB = 99;
+        constexpr uint32_t DDS_DIMENSION_TEXTURE2D = 3;
+        constexpr uint32_t DDS_RESOURCE_MISC_TEXTURECUBE = 0x4;
+
+        struct DDSPixelFormat
+        {
+            uint32_t size;
+            uint32_t flags;
+            uint32_t fourCC;
+            uint32_t rgbBitCount;
+            uint32_t rBitMask;
+            uint32_t gBitMask;
+            uint32_t bBitMask;
+            uint32_t aBitMask;
+        };
+
+        struct DDSHeader
+        {
+            uint32_t size;
+            uint32_t flags;
+            uint32_t height;
+            uint32_t width;
+            uint32_t pitchOrLinearSize;
+            uint32_t depth;
+            uint32_t mipMapCount;
+            uint32_t reserved1[11];
+            DDSPixelFormat pixelFormat;
+            uint32_t caps;
+            uint32_t caps2;
+            uint32_t caps3;
+            uint32_t caps4;
+            uint32_t reserved2;
+        };
+
+        struct DDSHeaderDX10
+        {
+            uint32_t dxgiFormat;
+            uint32_t resourceDimension;
+            uint32_t miscFlag;
+            uint32_t arraySize;
+            uint32_t miscFlags2;
+        };
+
+        static_assert(sizeof(DDSHeader) == 124, "DDS header must be 124 bytes");
+        static_assert(sizeof(DDSHeaderDX10) == 20, "DX10 header must be 20 bytes");
+
+        void SetError(std::string* error, const std::string& message)
+        {
+            if (error)
+            {
+                *error = message;
+            }
+        }
+
+        size_t GetBlockBytes(BlockFormat format)
+        {
+            switch (format)
+            {
+            case BlockFormat::BC1:
+            case BlockFormat::BC4:
+                return 8;
+            case BlockFormat::BC3:
+            case BlockFormat::BC5:
+            case BlockFormat::BC7:
+                return 16;
+            default:
+                return 0;
+            }
+        }
+
+        // ============================================================
+        // BC 编码辅助
+        // ============================================================
+
+        uint16_t PackRGB565(const float rgb[3])
+        {
+            int r = static_cast<int>(std::lround(std::clamp(rgb[0], 0.0f, 255.0f) * 31.0f / 255.0f));
+            int g = static_cast<int>(std::lround(std::clamp(rgb[1], 0.0f, 255.0f) * 63.0f / 255.0f));
+            int b = static_cast<int>(std::lround(std::clamp(rgb[2], 0.0f, 255.0f) * 31.0f / 255.0f));
+            return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+        }
+
+        void UnpackRGB565(uint16_t c, int rgb[3])
+        {
+            int r = (c >> 11) & 31;
+            int g = (c >> 5) & 63;
+            int b = c & 31;
+            rgb[0] = (r << 3) | (r >> 2);
+            rgb[1] = (g << 2) | (g >> 4);
+            rgb[2] = (b << 3) | (b >> 2);
+        }
+
+        // 从图像中取一个 4x4 块（边缘钳制）
+        void FetchBlock(const uint8_t* rgba, uint32_t width, uint32_t height,
+                        uint32_t bx, uint32_t by, uint8_t out[16][4])
+        {
+            for (uint32_t y = 0; y < 4; ++y)
+            {
+                uint32_t sy = std::min(by * 4 + y, height - 1);
+                for (uint32_t x = 0; x < 4; ++x)
+                {
+                    uint32_t sx = std::min(bx * 4 + x, width - 1);
+                    const uint8_t* p = rgba + (static_cast<size_t>(sy) * width + sx) * 4;
+                    std::memcpy(out[y * 4 + x], p, 4);
+                }
+            }
+        }
+
+        // 选择颜色端点（返回浮点 RGB）
+        void ChooseColorEndpoints(const uint8_t block[16][4], const bool* mask,
+                                  CompressionQuality quality, float outMax[3], float outMin[3])
+        {
+            float minC[3] = {255.0f, 255.0f, 255.0f};
+            float maxC[3] = {0.0f, 0.0f, 0.0f};
+            float mean[3] = {0.0f, 0.0f, 0.0f};
+            int count = 0;
+
+            for (int i = 0; i < 16; ++i)
+            {
+                if (mask && !mask[i])
+                    continue;
+                for (int c = 0; c < 3; ++c)
+                {
+                    float v = block[i][c];
+                    minC[c] = std::min(minC[c], v);
+                    maxC[c] = std::max(maxC[c], v);
+                    mean[c] += v;
+                }
+                ++count;
+            }
+
+            if (count == 0)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    outMax[c] = 0.0f;
+                    outMin[c] = 0.0f;
+                }
+                return;
+            }
+
+            if (quality == CompressionQuality::FAST)
+            {
+                std::copy(maxC, maxC + 3, outMax);
+                std::copy(minC, minC + 3, outMin);
+                return;
+            }
+
+            for (int c = 0; c < 3; ++c)
+                mean[c] /= static_cast<float>(count);
+
+            // 协方差矩阵
+            float cov[6] = {0, 0, 0, 0, 0, 0};
+            for (int i = 0; i < 16; ++i)
+            {
+                if (mask && !mask[i])
+                    continue;
+                float d[3] = {block[i][0] - mean[0], block[i][1] - mean[1], block[i][2] - mean[2]};
+                cov[0] += d[0] * d[0];
+                cov[1] += d[0] * d[1];
+                cov[2] += d[0] * d[2];
+                cov[3] += d[1] * d[1];
+                cov[4] += d[1] * d[2];
+                cov[5] += d[2] * d[2];
+            }
+
+            // 幂迭代求主轴
+            float axis[3] = {maxC[0] - minC[0], maxC[1] - minC[1], maxC[2] - minC[2]};
+            if (axis[0] == 0.0f && axis[1] == 0.0f && axis[2] == 0.0f)
+            {
+                axis[0] = axis[1] = axis[2] = 1.0f;
+            }
+            for (int iter = 0; iter < 8; ++iter)
+            {
+                float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+                float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+                float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+                float len = std::max({std::fabs(x), std::fabs(y), std::fabs(z)});
+                if (len <= 1e-6f)
+                    break;
+                axis[0] = x / len;
+                axis[1] = y / len;
+                axis[2] = z / len;
+            }
+            float axisLenSq = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+            if (axisLenSq <= 1e-12f)
+            {
+                std::copy(maxC, maxC + 3, outMax);
+                std::copy(minC, minC + 3, outMin);
+                return;
+            }
+
+            float tMin = 1e30f;
+            float tMax = -1e30f;
+            for (int i = 0; i < 16; ++i)
+            {
+                if (mask && !mask[i])
+                    continue;
+                float t = ((block[i][0] - mean[0]) * axis[0] +
+                           (block[i][1] - mean[1]) * axis[1] +
+                           (block[i][2] - mean[2]) * axis[2]) / axisLenSq;
+                tMin = std::min(tMin, t);
+                tMax = std::max(tMax, t);
+            }
+
+            for (int c = 0; c < 3; ++c)
+            {
+                outMax[c] = std::clamp(mean[c] + axis[c] * tMax, 0.0f, 255.0f);
+                outMin[c] = std::clamp(mean[c] + axis[c] * tMin, 0.0f, 255.0f);
+            }
+        }
+
+        // 根据量化后的端点构建调色板并选择索引，返回误差
+        uint32_t SelectColorIndices(const uint8_t block[16][4], uint16_t c0, uint16_t c1,
+                                    bool threeColorMode, const bool* mask, float& outError)
+        {
+            int p[4][3];
+            UnpackRGB565(c0, p[0]);
+            UnpackRGB565(c1, p[1]);
+            for (int c = 0; c < 3; ++c)
+            {
+                if (threeColorMode)
+                {
+                    p[2][c] = (p[0][c] + p[1][c]) / 2;
+                    p[3][c] = 0;
+                }
+                else
+                {
+                    p[2][c] = (2 * p[0][c] + p[1][c]) / 3;
+                    p[3][c] = (p[0][c] + 2 * p[1][c]) / 3;
+                }
+            }
+
+            uint32_t indices = 0;
+            outError = 0.0f;
+            int paletteSize = threeColorMode ? 3 : 4;
+            for (int i = 0; i < 16; ++i)
+            {
+                uint32_t best = 0;
+                if (mask && !mask[i])
+                {
+                    best = 3; // 透明像素
+                }
+                else
+                {
+                    int bestDist = 1 << 30;
+                    for (int k = 0; k < paletteSize; ++k)
+                    {
+                        int dr = block[i][0] - p[k][0];
+                        int dg = block[i][1] - p[k][1];
+                        int db = block[i][2] - p[k][2];
+                        int dist = dr * dr + dg * dg + db * db;
+                        if (dist < bestDist)
+                        {
+                            bestDist = dist;
+                            best = static_cast<uint32_t>(k);
+                        }
+                    }
+                    outError += static_cast<float>(bestDist);
+                }
+                indices |= best << (2 * i);
+            }
+            return indices;
+        }
+
+        // 最小二乘端点优化（4 色模式）
+        bool RefineColorEndpoints(const uint8_t block[16][4], uint32_t indices, float outMax[3], float outMin[3])
+        {
+            static const float kWeights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+            float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+            float ax[3] = {0, 0, 0};
+            float bx[3] = {0, 0, 0};
+            for (int i = 0; i < 16; ++i)
+            {
+                float a = kWeights[(indices >> (2 * i)) & 3];
+                float b = 1.0f - a;
+                aa += a * a;
+                bb += b * b;
+                ab += a * b;
+                for (int c = 0; c < 3; ++c)
+                {
+                    ax[c] += a * block[i][c];
+                    bx[c] += b * block[i][c];
+                }
+            }
+            float det = aa * bb - ab * ab;
+            if (std::fabs(det) < 1e-6f)
+                return false;
+            float inv = 1.0f / det;
+            for (int c = 0; c < 3; ++c)
+            {
+                outMax[c] = std::clamp((ax[c] * bb - bx[c] * ab) * inv, 0.0f, 255.0f);
+                outMin[c] = std::clamp((bx[c] * aa - ax[c] * ab) * inv, 0.0f, 255.0f);
+            }
+            return true;
+        }
+
+        void EncodeColorBlock(const uint8_t block[16][4], bool allowPunchThrough,
+                              CompressionQuality quality, uint8_t out[8])
+        {
+            bool mask[16];
+            bool hasTransparent = false;
+            for (int i = 0; i < 16; ++i)
+            {
+                mask[i] = !allowPunchThrough || block[i][3] >= 128;
+                hasTransparent |= !mask[i];
+            }
+
+            float maxC[3], minC[3];
+            ChooseColorEndpoints(block, hasTransparent ? mask : nullptr, quality, maxC, minC);
+
+            uint16_t c0 = PackRGB565(maxC);
+            uint16_t c1 = PackRGB565(minC);
+            uint32_t indices = 0;
+            float error = 0.0f;
+
+            if (hasTransparent)
+            {
+                // 3 色 + 透明模式要求 c0 <= c1
+                if (c0 > c1)
+                    std::swap(c0, c1);
+                indices = SelectColorIndices(block, c0, c1, true, mask, error);
+            }
+            else
+            {
+                if (c0 < c1)
+                    std::swap(c0, c1);
+
+                if (c0 == c1)
+                {
+                    indices = 0; // 纯色块
+                }
+                else
+                {
+                    indices = SelectColorIndices(block, c0, c1, false, nullptr, error);
+
+                    if (quality == CompressionQuality::HIGH)
+                    {
+                        for (int iter = 0; iter < 2; ++iter)
+                        {
+                            float rMax[3], rMin[3];
+                            if (!RefineColorEndpoints(block, indices, rMax, rMin))
+                                break;
+                            uint16_t r0 = PackRGB565(rMax);
+                            uint16_t r1 = PackRGB565(rMin);
+                            if (r0 < r1)
+                                std::swap(r0, r1);
+                            if (r0 == r1)
+                                break;
+                            float newError = 0.0f;
+                            uint32_t newIndices = SelectColorIndices(block, r0, r1, false, nullptr, newError);
+                            if (newError >= error)
+                                break;
+                            c0 = r0;
+                            c1 = r1;
+                            indices = newIndices;
+                            error = newError;
+                        }
+                    }
+                }
+            }
+
+            out[0] = static_cast<uint8_t>(c0 & 0xFF);
+            out[1] = static_cast<uint8_t>(c0 >> 8);
+            out[2] = static_cast<uint8_t>(c1 & 0xFF);
+            out[3] = static_cast<uint8_t>(c1 >> 8);
+            out[4] = static_cast<uint8_t>(indices & 0xFF);
+            out[5] = static_cast<uint8_t>((indices >> 8) & 0xFF);
+            out[6] = static_cast<uint8_t>((indices >> 16) & 0xFF);
+            out[7] = static_cast<uint8_t>((indices >> 24) & 0xFF);
+        }
+
+        // 单通道块（BC4 / BC3 alpha / BC5 的每个通道）
+        void EncodeSingleChannelBlock(const uint8_t block[16][4], int channel, uint8_t out[8])
+        {
+            int minV = 255;
+            int maxV = 0;
+            for (int i = 0; i < 16; ++i)
+            {
+                minV = std::min(minV, static_cast<int>(block[i][channel]));
+                maxV = std::max(maxV, static_cast<int>(block[i][channel]));
+            }
+
+            out[0] = static_cast<uint8_t>(maxV);
+            out[1] = static_cast<uint8_t>(minV);
+
+            uint64_t bits = 0;
+            if (maxV != minV)
+            {
+                // 8 值模式（a0 > a1）：索引 0=a0, 1=a1, 2..7 为插值
+                int palette[8];
+                palette[0] = maxV;
+                palette[1] = minV;
+                for (int k = 1; k <= 6; ++k)
+                {
+                    palette[k + 1] = ((7 - k) * maxV + k * minV) / 7;
+                }
+
+                for (int i = 0; i < 16; ++i)
+                {
+                    int v = block[i][channel];
+                    int best = 0;
+                    int bestDist = 1 << 30;
+                    for (int k = 0; k < 8; ++k)
+                    {
+                        int d = std::abs(v - palette[k]);
+                        if (d < bestDist)
+                        {
+                            bestDist = d;
+                            best = k;
+                        }
+                    }
+                    bits |= static_cast<uint64_t>(best) << (3 * i);
+                }
+            }
+
+            for (int b = 0; b < 6; ++b)
+            {
+                out[2 + b] = static_cast<uint8_t>((bits >> (8 * b)) & 0xFF);
+            }
+        }
+
+        uint32_t ToDXGIFormat(BlockFormat format)
+        {
+            switch (format)
+            {
+            case BlockFormat::BC1: return DXGI_FORMAT_BC1_UNORM;
+            case BlockFormat::BC3: return DXGI_FORMAT_BC3_UNORM;
+            case BlockFormat::BC4: return DXGI_FORMAT_BC4_UNORM;
+            case BlockFormat::BC5: return DXGI_FORMAT_BC5_UNORM;
+            case BlockFormat::BC7: return DXGI_FORMAT_BC7_UNORM;
+            case BlockFormat::RGBA16F: return DXGI_FORMAT_R16G16B16A16_FLOAT;
+            case BlockFormat::RG16F: return DXGI_FORMAT_R16G16_FLOAT;
+            default: return DXGI_FORMAT_R8G8B8A8_UNORM;
+            }
+        }
+
+        bool FromDXGIFormat(uint32_t dxgi, BlockFormat& outFormat)
+        {
+            switch (dxgi)
+            {
+            case DXGI_FORMAT_BC1_UNORM: outFormat = BlockFormat::BC1; return true;
+            case DXGI_FORMAT_BC3_UNORM: outFormat = BlockFormat::BC3; return true;
+            case DXGI_FORMAT_BC4_UNORM: outFormat = BlockFormat::BC4; return true;
+            case DXGI_FORMAT_BC5_UNORM: outFormat = BlockFormat::BC5; return true;
+            case DXGI_FORMAT_BC7_UNORM:
+            case DXGI_FORMAT_BC7_UNORM_SRGB: outFormat = BlockFormat::BC7; return true;
+            case DXGI_FORMAT_R8G8B8A8_UNORM: outFormat = BlockFormat::RGBA8; return true;
+            case DXGI_FORMAT_R16G16B16A16_FLOAT: outFormat = BlockFormat::RGBA16F; return true;
+            case DXGI_FORMAT_R16G16_FLOAT: outFormat = BlockFormat::RG16F; return true;
+            default: return false;
+            }
+        }
+
+        bool FromFourCC(uint32_t fourCC, BlockFormat& outFormat)
+        {
+            if (fourCC == MakeFourCC('D', 'X', 'T', '1')) { outFormat = BlockFormat::BC1; return true; }
+            if (fourCC == MakeFourCC('D', 'X', 'T', '5')) { outFormat = BlockFormat::BC3; return true; }
+            if (fourCC == MakeFourCC('A', 'T', 'I', '1') || fourCC == MakeFourCC('B', 'C', '4', 'U'))
+            {
+                outFormat = BlockFormat::BC4;
+                return true;
+            }
+            if (fourCC == MakeFourCC('A', 'T', 'I', '2') || fourCC == MakeFourCC('B', 'C', '5', 'U'))
+            {
+                outFormat = BlockFormat::BC5;
+                return true;
+            }
+            return false;
+        }
+
+    } // namespace
+
+    size_t CompressedImage::GetTotalSizeBytes() const
+    {
+        size_t total = 0;
+        for (const auto& level : levels)
+        {
+            total += level.size();
+        }
+        return total;
+    }
+
+    size_t CompressedImageView::GetTotalSizeBytes() const
+    {
+        size_t total = 0;
+        for (size_t size : levelSizes)
+        {
+            total += size;
+        }
+        return total;
+    }
+
+    namespace TextureCompression
+    {
+
+        bool IsBlockCompressed(BlockFormat format)
+        {
+            return GetPixelBytes(format) == 0;
+        }
+
+        size_t GetPixelBytes(BlockFormat format)
+        {
+            switch (format)
+            {
+            case BlockFormat::RGBA8:
+            case BlockFormat::RG16F:
+                return 4;
+            case BlockFormat::RGBA16F:
+                return 8;
+            default:
+                return 0;
+            }
+        }
+
+        size_t GetLevelSizeBytes(BlockFormat format, uint32_t width, uint32_t height)
+        {
+            if (!IsBlockCompressed(format))
+            {
+                return static_cast<size_t>(width) * height * GetPixelBytes(format);
+            }
+            size_t blocksX = std::max<uint32_t>(1, (width + 3) / 4);
+            size_t blocksY = std::max<uint32_t>(1, (height + 3) / 4);
+            return blocksX * blocksY * GetBlockBytes(format);
+        }
+
+        uint32_t GetFullMipCount(uint32_t width, uint32_t height)
+        {
+            uint32_t count = 1;
+            while (width > 1 || height > 1)
+            {
+                width = std::max<uint32_t>(1, width >> 1);
+                height = std::max<uint32_t>(1, height >> 1);
+                ++count;
+            }
+            return count;
+        }
+
+        const char* GetFormatName(BlockFormat format)
+        {
+            switch (format)
+            {
+            case BlockFormat::BC1: return "BC1";
+            case BlockFormat::BC3: return "BC3";
+            case BlockFormat::BC4: return "BC4";
+            case BlockFormat::BC5: return "BC5";
+            case BlockFormat::BC7: return "BC7";
+            case BlockFormat::RGBA8: return "RGBA8";
+            case BlockFormat::RGBA16F: return "RGBA16F";
+            case BlockFormat::RG16F: return "RG16F";
+            default: return "UNKNOWN";
+            }
+        }
+
+        bool ParseFormatName(const std::string& name, BlockFormat& outFormat)
+        {
+            std::string lower = name;
+            std::transform(lower.begin(), lower.end(), lower.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+            if (lower == "bc1") { outFormat = BlockFormat::BC1; return true; }
+            if (lower == "bc3") { outFormat = BlockFormat::BC3; return true; }
+            if (lower == "bc4") { outFormat = BlockFormat::BC4; return true; }
+            if (lower == "bc5") { outFormat = BlockFormat::BC5; return true; }
+            if (lower == "bc7") { outFormat = BlockFormat::BC7; return true; }
+            if (lower == "rgba8") { outFormat = BlockFormat::RGBA8; return true; }
+            if (lower == "rgba16f") { outFormat = BlockFormat::RGBA16F; return true; }
+            if (lower == "rg16f") { outFormat = BlockFormat::RG16F; return true; }
+            return false;
+        }
+
+        BlockFormat ChooseDefaultFormat(const uint8_t* rgba, uint32_t width, uint32_t height, int channels)
+        {
+            if (channels == 1)
+                return BlockFormat::BC4;
+            if (channels == 2)
+                return BlockFormat::BC5;
+            if (channels == 4)
+            {
+                size_t pixelCount = static_cast<size_t>(width) * height;
+                for (size_t i = 0; i < pixelCount; ++i)
+                {
+                    if (rgba[i * 4 + 3] != 255)
+                        return BlockFormat::BC3;
+                }
+            }
+            return BlockFormat::BC1;
+        }
+
+        std::vector<uint8_t> ExpandToRGBA8(const uint8_t* pixels, uint32_t width, uint32_t height, int channels)
+        {
+            size_t pixelCount = static_cast<size_t>(width) * height;
+            std::vector<uint8_t> rgba(pixelCount * 4);
+
+            for (size_t i = 0; i < pixelCount; ++i)
+            {
+                const uint8_t* src = pixels + i * channels;
+                uint8_t* dst = rgba.data() + i * 4;
+                switch (channels)
+                {
+                case 1:
+                    dst[0] = src[0]; dst[1] = src[0]; dst[2] = src[0]; dst[3] = 255;
+                    break;
+                case 2:
+                    // 双通道保留 RG（BC5 法线贴图约定）
+                    dst[0] = src[0]; dst[1] = src[1]; dst[2] = 0; dst[3] = 255;
+                    break;
+                case 3:
+                    dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = 255;
+                    break;
+                default:
+                    dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = src[3];
+                    break;
+                }
+            }
+            return rgba;
+        }
+
+        void FlipVerticalRGBA8(std::vector<uint8_t>& rgba, uint32_t width, uint32_t height)
+        {
+            size_t rowBytes = static_cast<size_t>(width) * 4;
+            std::vector<uint8_t> row(rowBytes);
+            for (uint32_t y = 0; y < height / 2; ++y)
+            {
+                uint8_t* top = rgba.data() + y * rowBytes;
+                uint8_t* bottom = rgba.data() + (height - 1 - y) * rowBytes;
+                std::memcpy(row.data(), top, rowBytes);
+                std::memcpy(top, bottom, rowBytes);
+                std::memcpy(bottom, row.data(), rowBytes);
+            }
+        }
+
+        std::vector<uint8_t> DownsampleRGBA8(const std::vector<uint8_t>& rgba, uint32_t width, uint32_t height)
+        {
+            uint32_t newWidth = std::max<uint32_t>(1, width >> 1);
+            uint32_t newHeight = std::max<uint32_t>(1, height >> 1);
+            std::vector<uint8_t> result(static_cast<size_t>(newWidth) * newHeight * 4);
+
+            for (uint32_t y = 0; y < newHeight; ++y)
+            {
+                uint32_t y0 = std::min(y * 2, height - 1);
+                uint32_t y1 = std::min(y * 2 + 1, height - 1);
+                for (uint32_t x = 0; x < newWidth; ++x)
+                {
+                    uint32_t x0 = std::min(x * 2, width - 1);
+                    uint32_t x1 = std::min(x * 2 + 1, width - 1);
+                    const uint8_t* p00 = &rgba[(static_cast<size_t>(y0) * width + x0) * 4];
+                    const uint8_t* p01 = &rgba[(static_cast<size_t>(y0) * width + x1) * 4];
+                    const uint8_t* p10 = &rgba[(static_cast<size_t>(y1) * width + x0) * 4];
+                    const uint8_t* p11 = &rgba[(static_cast<size_t>(y1) * width + x1) * 4];
+                    uint8_t* dst = &result[(static_cast<size_t>(y) * newWidth + x) * 4];
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        dst[c] = static_cast<uint8_t>((p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4);
+                    }
+                }
+            }
+            return result;
+        }
+
+        std::vector<uint8_t> ResizeRGBA8(const std::vector<uint8_t>& rgba, uint32_t width, uint32_t height,
+                                         uint32_t newWidth, uint32_t newHeight)
+        {
+            if (width == newWidth && height == newHeight)
+            {
+                return rgba;
+            }
+
+            // 大比例缩小：先逐级减半
+            std::vector<uint8_t> source = rgba;
+            while (width >= newWidth * 2 && height >= newHeight * 2)
+            {
+                source = DownsampleRGBA8(source, width, height);
+                width = std::max<uint32_t>(1, width >> 1);
+                height = std::max<uint32_t>(1, height >> 1);
+            }
+
+            std::vector<uint8_t> result(static_cast<size_t>(newWidth) * newHeight * 4);
+            float scaleX = static_cast<float>(width) / static_cast<float>(newWidth);
+            float scaleY = static_cast<float>(height) / static_cast<float>(newHeight);
+
+            for (uint32_t y = 0; y < newHeight; ++y)
+            {
+                // 像素中心对齐采样
+                float srcY = std::clamp((y + 0.5f) * scaleY - 0.5f, 0.0f, static_cast<float>(height - 1));
+                uint32_t y0 = static_cast<uint32_t>(srcY);
+                uint32_t y1 = std::min(y0 + 1, height - 1);
+                float fy = srcY - static_cast<float>(y0);
+
+                for (uint32_t x = 0; x < newWidth; ++x)
+                {
+                    float srcX = std::clamp((x + 0.5f) * scaleX - 0.5f, 0.0f, static_cast<float>(width - 1));
+                    uint32_t x0 = static_cast<uint32_t>(srcX);
+                    uint32_t x1 = std::min(x0 + 1, width - 1);
+                    float fx = srcX - static_cast<float>(x0);
+
+                    const uint8_t* p00 = &source[(static_cast<size_t>(y0) * width + x0) * 4];
+                    const uint8_t* p01 = &source[(static_cast<size_t>(y0) * width + x1) * 4];
+                    const uint8_t* p10 = &source[(static_cast<size_t>(y1) * width + x0) * 4];
+                    const uint8_t* p11 = &source[(static_cast<size_t>(y1) * width + x1) * 4];
+                    uint8_t* dst = &result[(static_cast<size_t>(y) * newWidth + x) * 4];
+
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        float top = p00[c] + (p01[c] - p00[c]) * fx;
+                        float bottom = p10[c] + (p11[c] - p10[c]) * fx;
+                        dst[c] = static_cast<uint8_t>(std::lround(top + (bottom - top) * fy));
+                    }
+                }
+            }
+            return result;
+        }
+
+        std::vector<std::vector<uint8_t>> BuildMipChainRGBA8(std::vector<uint8_t> rgba, uint32_t width, uint32_t height)
+        {
+            std::vector<std::vector<uint8_t>> chain;
+            chain.reserve(GetFullMipCount(width, height));
+            chain.push_back(std::move(rgba));
+
+            while (width > 1 || height > 1)
+            {
+                chain.push_back(DownsampleRGBA8(chain.back(), width, height));
+                width = std::max<uint32_t>(1, width >> 1);
+                height = std::max<uint32_t>(1, height >> 1);
+            }
+            return chain;
+        }
+
+        std::vector<uint8_t> EncodeLevel(const uint8_t* rgba, uint32_t width, uint32_t height,
+                                         BlockFormat format, CompressionQuality quality)
+        {
+            if (format == BlockFormat::RGBA8)
+            {
+                return std::vector<uint8_t>(rgba, rgba + static_cast<size_t>(width) * height * 4);
+            }
+
+            if (format == BlockFormat::BC7 || format == BlockFormat::RGBA16F || format == BlockFormat::RG16F)
+            {
+                return {}; // 不支持 BC7 / 半精度编码（调用者负责检查）
+            }
+            std::vector<uint8_t> out(GetLevelSizeBytes(format, width, height));
+
+            uint32_t blocksX = std::max<uint32_t>(1, (width + 3) / 4);
+            uint32_t blocksY = std::max<uint32_t>(1, (height + 3) / 4);
+            size_t blockBytes = GetBlockBytes(format);
+            uint8_t block[16][4];
+
+            for (uint32_t by = 0; by < blocksY; ++by)
+            {
+                for (uint32_t bx = 0; bx < blocksX; ++bx)
+                {
+                    FetchBlock(rgba, width, height, bx, by, block);
+                    uint8_t* dst = out.data() + (static_cast<size_t>(by) * blocksX + bx) * blockBytes;
+
+                    switch (format)
+                    {
+                    case BlockFormat::BC1:
+                        EncodeColorBlock(block, true, quality, dst);
+                        break;
+                    case BlockFormat::BC3:
+                        EncodeSingleChannelBlock(block, 3, dst);
+                        EncodeColorBlock(block, false, quality, dst + 8);
+                        break;
+                    case BlockFormat::BC4:
+                        EncodeSingleChannelBlock(block, 0, dst);
+                        break;
+                    case BlockFormat::BC5:
+                        EncodeSingleChannelBlock(block, 0, dst);
+                        EncodeSingleChannelBlock(block, 1, dst + 8);
+                        break;
+                    default:
+                        break;
+                    }
+                }
+            }
+            return out;
+        }
+
+        bool Compress(const std::vector<std::vector<uint8_t>>& faces, uint32_t width, uint32_t height,
+                      BlockFormat format, CompressionQuality quality, bool generateMips,
+                      CompressedImage& outImage, std::string* error)
+        {
+            if (faces.size() != 1 && faces.size() != 6)
+            {
+                SetError(error, "Compressed image must have 1 or 6 faces");
+                return false;
+            }
+            if (format == BlockFormat::BC7)
+            {
+                SetError(error, "BC7 encoding is not supported by the built-in encoder (BC7 files can still be loaded)");
+                return false;
+            }
+            if (format == BlockFormat::RGBA16F || format == BlockFormat::RG16F)
+            {
+                SetError(error, "Half-float formats cannot be encoded from RGBA8 (fill CompressedImage::levels directly)");
+                return false;
+            }
+
+            size_t expectedBytes = static_cast<size_t>(width) * height * 4;
+            for (const auto& face : faces)
+            {
+                if (face.size() != expectedBytes)
+                {
+                    SetError(error, "Face data size does not match " + std::to_string(width) + "x" + std::to_string(height) + " RGBA8");
+                    return false;
+                }
+            }
+
+            outImage = CompressedImage();
+            outImage.format = format;
+            outImage.width = width;
+            outImage.height = height;
+            outImage.faceCount = static_cast<uint32_t>(faces.size());
+            outImage.mipCount = generateMips ? GetFullMipCount(width, height) : 1;
+            outImage.levels.reserve(static_cast<size_t>(outImage.faceCount) * outImage.mipCount);
+
+            for (const auto& face : faces)
+            {
+                std::vector<uint8_t> current = face;
+                uint32_t w = width;
+                uint32_t h = height;
+                for (uint32_t mip = 0; mip < outImage.mipCount; ++mip)
+                {
+                    outImage.levels.push_back(EncodeLevel(current.data(), w, h, format, quality));
+                    if (mip + 1 < outImage.mipCount)
+                    {
+                        current = DownsampleRGBA8(current, w, h);
+                        w = std::max<uint32_t>(1, w >> 1);
+                        h = std::max<uint32_t>(1, h >> 1);
+                    }
+                }
+            }
+            return true;
+        }
+
+        bool WriteDDSToMemory(const CompressedImage& image, std::vector<uint8_t>& outBytes, std::string* error)
+        {
+            if (!image.IsValid())
+            {
+                SetError(error, "Invalid compressed image");
+                return false;
+            }
+
+            // BC7 和半精度格式没有通用的 FourCC / 位掩码表示
+            bool useDX10 = image.format == BlockFormat::BC7 || image.format == BlockFormat::RGBA16F ||
+                           image.format == BlockFormat::RG16F;
+
+            DDSHeader header{};
+            header.size = sizeof(DDSHeader);
+            header.flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT;
+            header.height = image.height;
+            header.width = image.width;
+            header.mipMapCount = image.mipCount;
+            header.reserved1[0] = LUMENARIS_TAG;
+            header.reserved1[1] = image.flippedForGL ? 1u : 0u;
+            header.reserved1[2] = static_cast<uint32_t>(image.userKey & 0xFFFFFFFFull);
+            header.reserved1[3] = static_cast<uint32_t>(image.userKey >> 32);
+            header.pixelFormat.size = sizeof(DDSPixelFormat);
+
+            if (IsBlockCompressed(image.format))
+            {
+                header.flags |= DDSD_LINEARSIZE;
+                header.pitchOrLinearSize = static_cast<uint32_t>(GetLevelSizeBytes(image.format, image.width, image.height));
+                header.pixelFormat.flags = DDPF_FOURCC;
+                switch (image.format)
+                {
+                case BlockFormat::BC1: header.pixelFormat.fourCC = MakeFourCC('D', 'X', 'T', '1'); break;
+                case BlockFormat::BC3: header.pixelFormat.fourCC = MakeFourCC('D', 'X', 'T', '5'); break;
+                case BlockFormat::BC4: header.pixelFormat.fourCC = MakeFourCC('A', 'T', 'I', '1'); break;
+                case BlockFormat::BC5: header.pixelFormat.fourCC = MakeFourCC('A', 'T', 'I', '2'); break;
+                default: header.pixelFormat.fourCC = MakeFourCC('D', 'X', '1', '0'); break;
+                }
+            }
+            else if (useDX10)
+            {
+                header.flags |= DDSD_PITCH;
+                header.pitchOrLinearSize = image.width * static_cast<uint32_t>(GetPixelBytes(image.format));
+                header.pixelFormat.flags = DDPF_FOURCC;
+                header.pixelFormat.fourCC = MakeFourCC('D', 'X', '1', '0');
+            }
+            else
+            {
+                header.flags |= DDSD_PITCH;
+                header.pitchOrLinearSize = image.width * 4;
+                header.pixelFormat.flags = DDPF_RGB | DDPF_ALPHAPIXELS;
+                header.pixelFormat.rgbBitCount = 32;
+                header.pixelFormat.rBitMask = 0x000000FF;
+                header.pixelFormat.gBitMask = 0x0000FF00;
+                header.pixelFormat.bBitMask = 0x00FF0000;
+                header.pixelFormat.aBitMask = 0xFF000000;
+            }
+
+            header.caps = DDSCAPS_TEXTURE;
+            if (image.mipCount > 1)
+                header.caps |= DDSCAPS_MIPMAP | DDSCAPS_COMPLEX;
+            if (image.faceCount == 6)
+            {
+                header.caps |= DDSCAPS_COMPLEX;
+                header.caps2 = DDSCAPS2_CUBEMAP_ALL_FACES;
+            }
+
+            size_t totalSize = sizeof(uint32_t) + sizeof(DDSHeader) + (useDX10 ? sizeof(DDSHeaderDX10) : 0) +
+                               image.GetTotalSizeBytes();
+            outBytes.clear();
+            outBytes.reserve(totalSize);
+
+            auto append = [&outBytes](const void* data, size_t size) {
+                const uint8_t* bytes = static_cast<const uint8_t*>(data);
+                outBytes.insert(outBytes.end(), bytes, bytes + size);
+            };
+
+            append(&DDS_MAGIC, sizeof(DDS_MAGIC));
+            append(&header, sizeof(header));
+
+            if (useDX10)
+            {
+                DDSHeaderDX10 dx10{};
+                dx10.dxgiFormat = ToDXGIFormat(image.format);
+                dx10.resourceDimension = DDS_DIMENSION_TEXTURE2D;
+                dx10.miscFlag = image.faceCount == 6 ? DDS_RESOURCE_MISC_TEXTURECUBE : 0;
+                dx10.arraySize = 1;
+                append(&dx10, sizeof(dx10));
+            }
+
+            for (const auto& level : image.levels)
+            {
+                append(level.data(), level.size());
+            }
+            return true;
+        }
+
+        bool WriteDDS(const std::string& filepath, const CompressedImage& image, std::string* error)
+        {
+            std::vector<uint8_t> bytes;
+            if (!WriteDDSToMemory(image, bytes, error))
+                return false;
+
+            // 先写临时文件再重命名，避免并发读取到半写入的缓存
+            std::string tempPath = filepath + ".tmp";
+            {
+                std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+                if (!file.is_open())
+                {
+                    SetError(error, "Failed to open for writing: " + tempPath);
+                    return false;
+                }
+                file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+                if (!file.good())
+                {
+                    SetError(error, "Failed to write: " + tempPath);
+                    return false;
+                }
+            }
+
+            std::error_code ec;
+            fs::rename(tempPath, filepath, ec);
+            if (ec)
+            {
+                fs::remove(filepath, ec);
+                fs::rename(tempPath, filepath, ec);
+                if (ec)
+                {
+                    SetError(error, "Failed to rename " + tempPath + " to " + filepath + ": " + ec.message());
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool ParseDDS(const uint8_t* data, size_t size, CompressedImageView& outView, std::string* error)
+        {
+            if (size < sizeof(uint32_t) + sizeof(DDSHeader))
+            {
+                SetError(error, "File too small to be a DDS");
+                return false;
+            }
+
+            uint32_t magic;
+            std::memcpy(&magic, data, sizeof(magic));
+            if (magic != DDS_MAGIC)
+            {
+                SetError(error, "Not a DDS file (bad magic)");
+                return false;
+            }
+
+            DDSHeader header;
+            std::memcpy(&header, data + sizeof(uint32_t), sizeof(header));
+            if (header.size != sizeof(DDSHeader) || header.pixelFormat.size != sizeof(DDSPixelFormat))
+            {
+                SetError(error, "Corrupt DDS header");
+                return false;
+            }
+
+            size_t offset = sizeof(uint32_t) + sizeof(DDSHeader);
+            BlockFormat format;
+            uint32_t faceCount = (header.caps2 & DDSCAPS2_CUBEMAP_ALL_FACES) == DDSCAPS2_CUBEMAP_ALL_FACES ? 6 : 1;
+
+            if (header.pixelFormat.flags & DDPF_FOURCC)
+            {
+                if (header.pixelFormat.fourCC == MakeFourCC('D', 'X', '1', '0'))
+                {
+                    if (size < offset + sizeof(DDSHeaderDX10))
+                    {
+                        SetError(error, "Truncated DX10 header");
+                        return false;
+                    }
+                    DDSHeaderDX10 dx10;
+                    std::memcpy(&dx10, data + offset, sizeof(dx10));
+                    offset += sizeof(dx10);
+
+                    if (!FromDXGIFormat(dx10.dxgiFormat, format))
+                    {
+                        SetError(error, "Unsupported DXGI format: " + std::to_string(dx10.dxgiFormat));
+                        return false;
+                    }
+                    if (dx10.arraySize > 1)
+                    {
+                        SetError(error, "Texture arrays in DDS are not supported");
+                        return false;
+                    }
+                    if (dx10.miscFlag & DDS_RESOURCE_MISC_TEXTURECUBE)
+                        faceCount = 6;
+                }
+                else if (!FromFourCC(header.pixelFormat.fourCC, format))
+                {
+                    SetError(error, "Unsupported DDS FourCC");
+                    return false;
+                }
+            }
+            else if ((header.pixelFormat.flags & DDPF_RGB) && header.pixelFormat.rgbBitCount == 32 &&
+                     header.pixelFormat.rBitMask == 0x000000FF && header.pixelFormat.gBitMask == 0x0000FF00 &&
+                     header.pixelFormat.bBitMask == 0x00FF0000)
+            {
+                format = BlockFormat::RGBA8;
+            }
+            else
+            {
+                SetError(error, "Unsupported uncompressed DDS pixel layout (only RGBA8 is supported)");
+                return false;
+            }
+
+            // 尺寸和 mip 数来自文件，分配之前先校验（损坏或恶意的 mipMapCount 不能决定 reserve 的大小）
+            uint32_t mipCount = (header.flags & DDSD_MIPMAPCOUNT) && header.mipMapCount > 0 ? header.mipMapCount : 1;
+            if (header.width == 0 || header.height == 0)
+            {
+                SetError(error, "Invalid DDS dimensions: " + std::to_string(header.width) + "x" +
+                                    std::to_string(header.height));
+                return false;
+            }
+            if (mipCount > GetFullMipCount(header.width, header.height))
+            {
+                SetError(error, "Invalid DDS mip count: " + std::to_string(mipCount) + " for " +
+                                    std::to_string(header.width) + "x" + std::to_string(header.height));
+                return false;
+            }
+
+            outView = CompressedImageView();
+            outView.format = format;
+            outView.width = header.width;
+            outView.height = header.height;
+            outView.faceCount = faceCount;
+            outView.mipCount = mipCount;
+            if (header.reserved1[0] == LUMENARIS_TAG)
+            {
+                outView.flippedForGL = (header.reserved1[1] & 1u) != 0;
+                outView.userKey = static_cast<uint64_t>(header.reserved1[2]) |
+                                   (static_cast<uint64_t>(header.reserved1[3]) << 32);
+            }
+
+            outView.levelData.reserve(static_cast<size_t>(faceCount) * outView.mipCount);
+            outView.levelSizes.reserve(static_cast<size_t>(faceCount) * outView.mipCount);
+            for (uint32_t face = 0; face < faceCount; ++face)
+            {
+                uint32_t w = outView.width;
+                uint32_t h = outView.height;
+                for (uint32_t mip = 0; mip < outView.mipCount; ++mip)
+                {
+                    size_t levelSize = GetLevelSizeBytes(format, w, h);
+                    if (levelSize > size - offset)
+                    {
+                        SetError(error, "Truncated DDS data");
+                        return false;
+                    }
+                    outView.levelData.push_back(data + offset);
+                    outView.levelSizes.push_back(levelSize);
+                    offset += levelSize;
+                    w = std::max<uint32_t>(1, w >> 1);
+                    h = std::max<uint32_t>(1, h >> 1);
+                }
+            }
+            return true;
+        }
+
+        CompressedImageView MakeView(const CompressedImage& image)
+        {
+            CompressedImageView view;
+            view.format = image.format;
+            view.width = image.width;
+            view.height = image.height;
+            view.faceCount = image.faceCount;
+            view.mipCount = image.mipCount;
+            view.flippedForGL = image.flippedForGL;
+            view.userKey = image.userKey;
+            view.levelData.reserve(image.levels.size());
+            view.levelSizes.reserve(image.levels.size());
+            for (const std::vector<uint8_t>& level : image.levels)
+            {
+                view.levelData.push_back(level.data());
+                view.levelSizes.push_back(level.size());
+            }
+            return view;
+        }
+
+        bool ReadDDSFromMemory(const uint8_t* data, size_t size, CompressedImage& outImage, std::string* error)
+        {
+            CompressedImageView view;
+            if (!ParseDDS(data, size, view, error))
+            {
+                return false;
+            }
+
+            outImage = CompressedImage();
+            outImage.format = view.format;
+            outImage.width = view.width;
+            outImage.height = view.height;
+            outImage.faceCount = view.faceCount;
+            outImage.mipCount = view.mipCount;
+            outImage.flippedForGL = view.flippedForGL;
+            outImage.userKey = view.userKey;
+            outImage.levels.reserve(view.levelData.size());
+            for (size_t i = 0; i < view.levelData.size(); ++i)
+            {
+                outImage.levels.emplace_back(view.levelData[i], view.levelData[i] + view.levelSizes[i]);
+            }
+            return true;
+        }
+
+        bool ReadDDS(const std::string& filepath, CompressedImage& outImage, std::string* error)
+        {
+            std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+            if (!file.is_open())
+            {
+                SetError(error, "Failed to open: " + filepath);
+                return false;
+            }
+
+            std::streamsize size = file.tellg();
+            file.seekg(0, std::ios::beg);
+            std::vector<uint8_t> bytes(static_cast<size_t>(size));
+            if (!file.read(reinterpret_cast<char*>(bytes.data()), size))
+            {
+                SetError(error, "Failed to read: " + filepath);
+                return false;
+            }
+
+            return ReadDDSFromMemory(bytes.data(), bytes.size(), outImage, error);
+        }
+
+        std::string GetCompressedSiblingPath(const std::string& sourcePath)
+        {
+            fs::path path(sourcePath);
+            path.replace_extension(".dds");
+            return path.string();
+        }
+
+    } // namespace TextureCompression
+
+} // namespace Renderer
@@ -0,0 +1,428 @@
+#include "Renderer/Resources/TextureStreamer.hpp"
+#include "Core/Logger.hpp"
+#include "Core/Profiler.hpp"
+#include <glad/glad.h>
+#include <stb_image.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Renderer
+{
+
+    TextureStreamer::TextureStreamer(const TextureStreamerConfig& config)
+        : m_config(config)
+    {
+    }
+
+    std::shared_ptr<Texture> TextureStreamer::Load(const std::string& filepath)
+    {
+        CompressedImage image;
+        if (!ReadSource(filepath, image))
+        {
+            return nullptr;
+        }
+
+        auto texture = std::make_shared<Texture>();
+        texture->SetFilePath(filepath);
+        if (!Adopt(texture, std::move(image)))
+        {
+            return nullptr;
+        }
+        return texture;
+    }
+
+    std::shared_ptr<Texture> TextureStreamer::Load(TextureSource&& source)
+    {
+        CompressedImage image;
+        if (source.compressed && source.compressedImage.faceCount == 1 &&
+            Texture::IsCompressedFormatSupported(source.compressedImage.format))
+        {
+            image = std::move(source.compressedImage);
+        }
+        else if (!source.compressed && PrepareSource(source))
+        {
+            image = std::move(source.compressedImage);
+        }
+        else if (!ReadSource(source.path, image))
+        {
+            // 预编码格式不被当前上下文支持：与 Texture::LoadFromSource 相同，回退为解码源图像
+            return nullptr;
+        }
+
+        auto texture = std::make_shared<Texture>();
+        texture->SetFilePath(source.path);
+        if (!Adopt(texture, std::move(image)))
+        {
+            return nullptr;
+        }
+        return texture;
+    }
+
+    bool TextureStreamer::PrepareSource(TextureSource& source)
+    {
+        if (source.compressed)
+        {
+            return source.compressedImage.IsValid();
+        }
+
+        const size_t pixelCount = static_cast<size_t>(source.width) * static_cast<size_t>(source.height);
+        const int channels = source.channels;
+        if (pixelCount == 0 || (channels != 1 && channels != 3 && channels != 4) ||
+            source.pixels.size() < pixelCount * static_cast<size_t>(channels))
+        {
+            return false;
+        }
+
+        // 与 Texture::LoadFromSource 的 GL_RED / GL_RGB 采样结果一致：缺少的通道补 0，alpha 补 255
+        std::vector<uint8_t> rgba(pixelCount * 4);
+        for (size_t i = 0; i < pixelCount; ++i)
+        {
+            const uint8_t* src = source.pixels.data() + i * channels;
+            uint8_t* dst = rgba.data() + i * 4;
+            dst[0] = src[0];
+            dst[1] = channels >= 3 ? src[1] : 0;
+            dst[2] = channels >= 3 ? src[2] : 0;
+            dst[3] = channels == 4 ? src[3] : 255;
+        }
+
+        CompressedImage& image = source.compressedImage;
+        image = CompressedImage();
+        image.format = BlockFormat::RGBA8;
+        image.width = static_cast<uint32_t>(source.width);
+        image.height = static_cast<uint32_t>(source.height);
+        image.flippedForGL = true; // Texture::Decode 已按 OpenGL 行序翻转
+        image.levels = TextureCompression::BuildMipChainRGBA8(std::move(rgba), image.width, image.height);
+        image.mipCount = static_cast<uint32_t>(image.levels.size());
+
+        source.compressed = true;
+        std::vector<unsigned char>().swap(source.pixels);
+        return image.IsValid();
+    }
+
+    bool TextureStreamer::Track(const std::shared_ptr<Texture>& texture,
+                                const std::shared_ptr<InstanceData>& instances,
+                                float boundingRadius)
+    {
+        if (!texture)
+        {
+            return false;
+        }
+
+        auto it = m_textures.find(texture.get());
+        StreamedTexture* entry = it != m_textures.end() ? &it->second : nullptr;
+        if (!entry)
+        {
+            // 慢路径：纹理不是由本管理器加载的，重新读取完整 mip 链
+            Core::Logger::GetInstance().Debug("TextureStreamer - Re-reading " + texture->GetFilePath() +
+                                              " (load it through TextureStreamer::Load to avoid this)");
+            CompressedImage image;
+            if (texture->GetFilePath().empty() || !ReadSource(texture->GetFilePath(), image))
+            {
+                return false;
+            }
+            entry = Adopt(texture, std::move(image));
+            if (!entry)
+            {
+                return false;
+            }
+        }
+
+        if (instances)
+        {
+            TextureUser user;
+            user.instances = instances;
+            user.boundingRadius = boundingRadius;
+            entry->users.push_back(user);
+        }
+        return true;
+    }
+
+    void TextureStreamer::Untrack(const Texture* texture)
+    {
+        auto it = m_textures.find(texture);
+        if (it == m_textures.end())
+        {
+            return;
+        }
+
+        // 恢复完整驻留后不再计入预算；恢复失败时 residentMip 不变，按实际驻留的大小扣除
+        SetResidency(it->second, 0);
+        m_residentBytes -= GetResidentBytes(it->second, it->second.residentMip);
+        m_textures.erase(it);
+    }
+
+    bool TextureStreamer::ReadSource(const std::string& filepath, CompressedImage& outImage) const
+    {
+        std::string ddsPath = TextureCompression::GetCompressedSiblingPath(filepath) == filepath
+                                  ? filepath
+                                  : Texture::FindCompressedSibling(filepath);
+        if (!ddsPath.empty())
+        {
+            std::string error;
+            if (TextureCompression::ReadDDS(ddsPath, outImage, &error) && outImage.faceCount == 1 &&
+                Texture::IsCompressedFormatSupported(outImage.format))
+            {
+                return true;
+            }
+            Core::Logger::GetInstance().Warning("TextureStreamer - Cannot stream compressed file " + ddsPath +
+                                                (error.empty() ? "" : ": " + error) + ", using source image");
+        }
+
+        int width = 0, height = 0, channels = 0;
+        stbi_set_flip_vertically_on_load(true); // 与 Texture::LoadFromFile 保持一致
+        unsigned char* pixels = stbi_load(filepath.c_str(), &width, &height, &channels, 4);
+        if (!pixels)
+        {
+            Core::Logger::GetInstance().Error("TextureStreamer - Failed to load texture: " + filepath +
+                                              " (" + stbi_failure_reason() + ")");
+            return false;
+        }
+
+        std::vector<uint8_t> rgba(pixels, pixels + static_cast<size_t>(width) * height * 4);
+        stbi_image_free(pixels);
+
+        outImage = CompressedImage();
+        outImage.format = BlockFormat::RGBA8;
+        outImage.width = static_cast<uint32_t>(width);
+        outImage.height = static_cast<uint32_t>(height);
+        outImage.flippedForGL = true;
+        outImage.levels = TextureCompression::BuildMipChainRGBA8(std::move(rgba), outImage.width, outImage.height);
+        outImage.mipCount = static_cast<uint32_t>(outImage.levels.size());
+        return outImage.IsValid();
+    }
+
+    TextureStreamer::StreamedTexture* TextureStreamer::Adopt(const std::shared_ptr<Texture>& texture, CompressedImage&& image)
+    {
+        StreamedTexture entry;
+        entry.texture = texture;
+        entry.image = std::move(image);
+        entry.residentMip = entry.image.mipCount; // 尚无驻留层级（不计入预算）
+
+        // 初始驻留：第一个不大于 initialMaxSize 的层级
+        uint32_t initialMip = 0;
+        while (initialMip + 1 < entry.image.mipCount &&
+               std::max(entry.image.width >> initialMip, entry.image.height >> initialMip) > m_config.initialMaxSize)
+        {
+            ++initialMip;
+        }
+        entry.initialMip = initialMip;
+        entry.desiredMip = initialMip;
+
+        std::string name = texture->GetFilePath();
+        if (!SetResidency(entry, initialMip))
+        {
+            return nullptr;
+        }
+
+        StreamedTexture& stored = m_textures[texture.get()] = std::move(entry);
+        Core::Logger::GetInstance().Info("TextureStreamer - Tracking " + name + " (" +
+                                         std::to_string(stored.image.width) + "x" + std::to_string(stored.image.height) +
+                                         ", resident from mip " + std::to_string(initialMip) + ", " +
+                                         std::to_string(GetResidentBytes(stored, initialMip) / 1024) + " KB)");
+        return &stored;
+    }
+
+    size_t TextureStreamer::GetResidentBytes(const StreamedTexture& entry, uint32_t mip) const
+    {
+        size_t bytes = 0;
+        for (uint32_t level = mip; level < entry.image.mipCount; ++level)
+        {
+            bytes += entry.image.GetLevel(0, level).size();
+        }
+        return bytes;
+    }
+
+    bool TextureStreamer::SetResidency(StreamedTexture& entry, uint32_t mip)
+    {
+        mip = std::min(mip, entry.image.mipCount - 1);
+        if (mip == entry.residentMip)
+        {
+            return true;
+        }
+
+        // 重新分配只包含驻留层级的纹理（GL 3.3 没有稀疏纹理，仅调整 BASE_LEVEL 不会释放显存）
+        GLuint textureID = 0;
+        glGenTextures(1, &textureID);
+        glBindTexture(GL_TEXTURE_2D, textureID);
+
+        GLint levelCount = static_cast<GLint>(entry.image.mipCount - mip);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+
+        bool uploaded = Texture::UploadCompressedLevels(GL_TEXTURE_2D, entry.image, 0, mip);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        if (!uploaded)
+        {
+            Core::Logger::GetInstance().Error("TextureStreamer - OpenGL error uploading mip " + std::to_string(mip) +
+                                              " of " + entry.texture->GetFilePath());
+            glDeleteTextures(1, &textureID);
+            return false;
+        }
+
+        size_t oldBytes = GetResidentBytes(entry, entry.residentMip);
+        size_t newBytes = GetResidentBytes(entry, mip);
+        m_residentBytes = m_residentBytes - oldBytes + newBytes;
+
+        entry.texture->AdoptGLTexture(textureID,
+                                      static_cast<int>(std::max(1u, entry.image.width >> mip)),
+                                      static_cast<int>(std::max(1u, entry.image.height >> mip)),
+                                      newBytes, TextureCompression::IsBlockCompressed(entry.image.format));
+        entry.residentMip = mip;
+        return true;
+    }
+
+    float TextureStreamer::ComputeScreenPixels(const StreamedTexture& entry, const glm::vec3& cameraPos,
+                                               const glm::vec3& cameraFront, float pixelsPerUnitAtOne) const
+    {
+        float maxPixels = 0.0f;
+        for (const auto& user : entry.users)
+        {
+            auto instances = user.instances.lock();
+            if (!instances)
+            {
+                continue;
+            }
+
+            for (const auto& model : instances->GetModelMatrices())
+            {
+                glm::vec3 center = glm::vec3(model[3]);
+                float scale = std::max({glm::length(glm::vec3(model[0])),
+                                        glm::length(glm::vec3(model[1])),
+                                        glm::length(glm::vec3(model[2]))});
+                float radius = user.boundingRadius * scale;
+
+                glm::vec3 toCenter = center - cameraPos;
+                if (glm::dot(toCenter, cameraFront) < -radius)
+                {
+                    continue; // 完全在摄像机后方
+                }
+
+                float distance = std::max(glm::length(toCenter) - radius, 0.1f);
+                maxPixels = std::max(maxPixels, 2.0f * radius * pixelsPerUnitAtOne / distance);
+            }
+        }
+        return maxPixels;
+    }
+
+    bool TextureStreamer::MakeRoom(size_t requiredBytes, const StreamedTexture* requester)
+    {
+        // LRU 顺序：最久未可见的先降级，同一帧内屏幕尺寸小的先降级
+        std::vector<StreamedTexture*> candidates;
+        for (auto& [key, entry] : m_textures)
+        {
+            if (&entry != requester && entry.residentMip < entry.initialMip)
+            {
+                candidates.push_back(&entry);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const StreamedTexture* a, const StreamedTexture* b) {
+            if (a->lastVisibleFrame != b->lastVisibleFrame)
+                return a->lastVisibleFrame < b->lastVisibleFrame;
+            return a->screenPixels < b->screenPixels;
+        });
+
+        for (StreamedTexture* candidate : candidates)
+        {
+            if (m_residentBytes + requiredBytes <= m_config.budgetBytes)
+            {
+                break;
+            }
+
+            // 当前帧可见的纹理只释放超出期望的部分
+            uint32_t target = candidate->lastVisibleFrame == m_frame ? candidate->desiredMip : candidate->initialMip;
+            if (target <= candidate->residentMip)
+            {
+                continue;
+            }
+            if (SetResidency(*candidate, target))
+            {
+                ++m_evictions;
+            }
+        }
+        return m_residentBytes + requiredBytes <= m_config.budgetBytes;
+    }
+
+    void TextureStreamer::Update(const ::Core::Camera& camera, float aspectRatio, float viewportHeight)
+    {
+        PROFILE_SCOPE("TextureStreamer::Update");
+        ++m_frame;
+
+        float tanHalfFov = std::tan(glm::radians(camera.GetFOV()) * 0.5f);
+        float pixelsPerUnitAtOne = viewportHeight / (2.0f * std::max(tanHalfFov, 1e-4f));
+        float maxScreenPixels = viewportHeight * std::max(aspectRatio, 1.0f);
+
+        // 1. 计算每张纹理的期望层级
+        std::vector<StreamedTexture*> requests;
+        for (auto& [key, entry] : m_textures)
+        {
+            entry.users.erase(std::remove_if(entry.users.begin(), entry.users.end(),
+                                             [](const TextureUser& user) { return user.instances.expired(); }),
+                              entry.users.end());
+
+            entry.screenPixels = std::min(ComputeScreenPixels(entry, camera.GetPosition(), camera.GetFront(), pixelsPerUnitAtOne),
+                                          maxScreenPixels);
+            if (entry.screenPixels <= 0.0f)
+            {
+                entry.desiredMip = entry.initialMip;
+                continue;
+            }
+
+            entry.lastVisibleFrame = m_frame;
+            float textureSize = static_cast<float>(std::max(entry.image.width, entry.image.height));
+            float mip = std::floor(std::log2(textureSize / entry.screenPixels) + m_config.lodBias);
+            entry.desiredMip = static_cast<uint32_t>(std::clamp(mip, 0.0f, static_cast<float>(entry.initialMip)));
+
+            if (entry.desiredMip < entry.residentMip)
+            {
+                requests.push_back(&entry);
+            }
+        }
+
+        // 2. 屏幕尺寸大的优先提升，每帧限量
+        std::sort(requests.begin(), requests.end(), [](const StreamedTexture* a, const StreamedTexture* b) {
+            return a->screenPixels > b->screenPixels;
+        });
+
+        size_t processed = 0;
+        size_t satisfied = 0;
+        for (StreamedTexture* request : requests)
+        {
+            if (processed >= m_config.maxUploadsPerFrame)
+            {
+                break;
+            }
+
+            size_t extraBytes = GetResidentBytes(*request, request->desiredMip) - GetResidentBytes(*request, request->residentMip);
+            if (m_residentBytes + extraBytes > m_config.budgetBytes && !MakeRoom(extraBytes, request))
+            {
+                continue; // 预算不足，保持待处理
+            }
+
+            ++processed;
+            if (SetResidency(*request, request->desiredMip))
+            {
+                ++m_uploads;
+                ++satisfied;
+            }
+        }
+
+        m_pendingRequests = requests.size() - satisfied;
+    }
+
+    TextureStreamerStats TextureStreamer::GetStats() const
+    {
+        TextureStreamerStats stats;
+        stats.trackedTextures = m_textures.size();
+        stats.residentBytes = m_residentBytes;
+        stats.budgetBytes = m_config.budgetBytes;
+        stats.pendingRequests = m_pendingRequests;
+        stats.uploads = m_uploads;
+        stats.evictions = m_evictions;
+        return stats;
+    }
+
+} // namespace Renderer
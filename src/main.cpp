@@ -3,15 +3,23 @@
 #include "Core/MouseController.hpp"
 #include "Core/KeyboardController.hpp"
 #include "Core/Logger.hpp"
+#include "Core/GpuProfiler.hpp"
 #include "Renderer/Core/RenderContext.hpp"  // ⭐ NEW - 多Context架构
 #include "Renderer/Lighting/Light.hpp"
 #include "Renderer/Resources/Shader.hpp"
+#include "Renderer/Resources/MaterialTable.hpp"
+#include "Renderer/Resources/UniformBindings.hpp"
+#include "Renderer/Resources/TextureStreamer.hpp"
+#include "Renderer/Resources/AssetRegistry.hpp"
+#include "Renderer/Resources/AssetLoader.hpp"
+#include "Renderer/Resources/AssetArchive.hpp"
 #include "Renderer/Data/MeshBuffer.hpp"
 #include "Renderer/Environment/Skybox.hpp"
 #include "Renderer/Environment/AmbientLighting.hpp"
 
 #include "Renderer/Factory/MeshDataFactory.hpp"
 #include "Renderer/Renderer/InstancedRenderer.hpp"
+#include "Renderer/Renderer/FrameStatistics.hpp"
 #include "Renderer/Data/InstanceData.hpp"
 #include <GLFW/glfw3.h>
 #include <iostream>
@@ -29,7 +37,7 @@ namespace fs = std::filesystem;
 // 窗口设置
 const int WINDOW_WIDTH = 1920;
 const int WINDOW_HEIGHT = 1080;
-const char *WINDOW_TITLE = "Super Disco Stage + Skybox | Space:Pause 1/2/3:AmbMode [/]:Intensity";
+const char *WINDOW_TITLE = "Super Disco Stage + Skybox | Space:Pause 1-4:AmbMode [/]:Intensity";
 
 // 性能统计
 float fps = 0.0f;
@@ -61,6 +69,7 @@ struct Car
     std::vector<Renderer::InstancedRenderer> renderers;  // 车的渲染器（多材质）
     std::vector<std::shared_ptr<Renderer::MeshBuffer>> meshBuffers;
     std::shared_ptr<Renderer::InstanceData> instanceData;
+    std::shared_ptr<Renderer::MaterialTable> materialTable;  // 车的材质表（UBO）
     float speed = 2.0f;          // 降低速度（更慢更真实）
     float carScale = 0.8f;       // 缩小到0.8倍
     float orbitRadius = 12.0f;   // 行驶半径
@@ -126,6 +135,7 @@ glm::vec3 CalculateLightMotion(int index, float time, float baseRadius, float ba
 // ========================================
 void UpdateDiscoStageAnimation(DiscoStage &stage, float time)
 {
+    PROFILE_SCOPE("UpdateDiscoStageAnimation");
     const float goldenRatio = (1.0f + std::sqrt(5.0f)) / 2.0f;
 
     // 索引定义
@@ -306,13 +316,12 @@ void UpdateDiscoStageAnimation(DiscoStage &stage, float time)
         if (++debugFrameCount % 60 == 0)
         {
             glm::vec3 currentPos = glm::vec3(bunnyMatrices[0][3]);
-            Core::Logger::GetInstance().Info("=== BUNNY ANIMATION DEBUG ===");
-            Core::Logger::GetInstance().Info("Time: " + std::to_string(time));
-            Core::Logger::GetInstance().Info("Bunny position: (" + std::to_string(currentPos.x) + ", " +
-                                             std::to_string(currentPos.y) + ", " + std::to_string(currentPos.z) + ")");
-            Core::Logger::GetInstance().Info("Y position changed: " + std::to_string(currentPos.y - lastDebugY));
-            Core::Logger::GetInstance().Info("bunnyData pointer: " + std::to_string(reinterpret_cast<uintptr_t>(stage.bunnyData.get())));
-            Core::Logger::GetInstance().Info("============================");
+            LOG_INFO("=== BUNNY ANIMATION DEBUG ===");
+            LOG_INFO("Time: {:.6f}", time);
+            LOG_INFO("Bunny position: ({:.6f}, {:.6f}, {:.6f})", currentPos.x, currentPos.y, currentPos.z);
+            LOG_INFO("Y position changed: {:.6f}", currentPos.y - lastDebugY);
+            LOG_INFO("bunnyData pointer: {}", static_cast<const void *>(stage.bunnyData.get()));
+            LOG_INFO("============================");
             lastDebugY = currentPos.y;
         }
 #else
@@ -631,11 +640,33 @@ std::shared_ptr<Renderer::InstanceData> CreateMultiLightDemoPlane()
 }
 
 // ========================================
-// 创建行驶的车
+// 辅助函数：资源到达后为渲染器设置网格并初始化（在 AssetLoader::ProcessUploads 中回调）
 // ========================================
-Car CreateCar()
+Renderer::AssetLoader::MeshCallback AttachMesh(Renderer::InstancedRenderer *renderer)
+{
+    return [renderer](const Renderer::MeshHandle &asset)
+    {
+        if (!asset)
+        {
+            return;
+        }
+        if (asset->GetLODCount(0) > 1)
+        {
+            renderer->SetLODMeshes(asset->GetLODs());
+        }
+        else
+        {
+            renderer->SetMesh(asset->GetMesh());
+        }
+        renderer->Initialize();
+    };
+}
+
+// ========================================
+// 创建行驶的车（后台加载，到达后创建渲染器）
+// ========================================
+void LoadCar(Car &car, Renderer::AssetLoader &loader)
 {
-    Car car;
     std::string carPath = "assets/models/cars/sportsCar.obj";
 
     Core::Logger::GetInstance().Info("Loading car model: " + carPath);
@@ -643,7 +674,7 @@ Car CreateCar()
     if (!fs::exists(carPath))
     {
         Core::Logger::GetInstance().Warning("Car model not found: " + carPath);
-        return car;
+        return;
     }
 
     // 创建车实例（单个车）
@@ -655,24 +686,42 @@ Car CreateCar()
 
     car.instanceData->Add(position, rotation, scale, color);
 
-    // 创建渲染器（多材质）
-    auto [renderers, meshBuffers, instances] =
-        Renderer::InstancedRenderer::CreateForOBJ(carPath, car.instanceData);
+    // 创建渲染器（多材质合并到纹理数组图集，材质参数由材质表提供，通常只需一次绘制）
+    // ⭐ QEM 简化生成 4 级 LOD，远处的车不再以完整精度绘制
+    // ⭐ 解析、材质拆分、LOD 简化在工作线程执行；渲染器在网格上传完成后创建，此前车辆不绘制
+    car.materialTable = std::make_shared<Renderer::MaterialTable>();
+    auto atlas = Renderer::AssetRegistry::GetInstance().GetDefaultAtlas();
+    Renderer::MeshLODConfig carLODConfig;
+    loader.LoadOBJAtlas(carPath, atlas, car.materialTable, &carLODConfig,
+                        [&car, atlas](const Renderer::MeshHandle &asset)
+                        {
+                            if (!asset)
+                            {
+                                Core::Logger::GetInstance().Error("Failed to load car model");
+                                return;
+                            }
+                            car.renderers = Renderer::InstancedRenderer::CreateForAsset(asset, car.instanceData, atlas);
+                            for (size_t i = 0; i < asset->GetSubmeshCount(); ++i)
+                            {
+                                auto lods = asset->GetLODs(i);
+                                car.meshBuffers.insert(car.meshBuffers.end(), lods.begin(), lods.end());
+                            }
+
+                            Core::Logger::GetInstance().Info("Car loaded: " + std::to_string(car.renderers.size()) + " materials");
+                            for (size_t i = 0; i < car.renderers.size(); ++i)
+                            {
+                                const auto &mesh = car.renderers[i].GetMesh();
+                                Core::Logger::GetInstance().Info("Car renderer[" + std::to_string(i) + "] Vertices: " +
+                                                                 std::to_string(mesh->GetVertexCount()) +
+                                                                 " Indices: " + std::to_string(mesh->GetIndexCount()) +
+                                                                 " LODs: " + std::to_string(asset->GetLODCount(i)));
+                            }
+                        });
 
-    car.renderers = std::move(renderers);
-    car.meshBuffers = std::move(meshBuffers);
-
-    // ⭐ 关键修复：使用返回的 instances，而不是传入的那个
-    // CreateForOBJ 内部使用传入的 instances 创建渲染器，但返回的是渲染器内部使用的 shared_ptr
-    car.instanceData = instances;
-
-    Core::Logger::GetInstance().Info("Car loaded: " + std::to_string(car.renderers.size()) + " materials");
     Core::Logger::GetInstance().Info("Car scale: " + std::to_string(car.carScale) + ", orbit radius: " + std::to_string(car.orbitRadius));
-
-    return car;
 }
 
-DiscoStage CreateDiscoStage()
+DiscoStage CreateDiscoStage(Renderer::AssetLoader &loader)
 {
     Core::Logger::GetInstance().Info("Creating Disco Stage...");
 
@@ -892,14 +941,11 @@ DiscoStage CreateDiscoStage()
     Core::Logger::GetInstance().Info("Creating floor renderer...");
     try
     {
-        Renderer::MeshBuffer floorMesh = Renderer::MeshBufferFactory::CreatePlaneBuffer(1.0f, 1.0f, 1, 1);
-        auto floorMeshPtr = std::make_shared<Renderer::MeshBuffer>(std::move(floorMesh));
-        stage.meshBuffers.push_back(floorMeshPtr);
-
+        // ⭐ 单位平面由资源注册表共享（平台渲染器使用同一份 VBO/EBO）
+        // ⭐ 网格在后台生成、按帧预算上传，到达后渲染器才开始绘制
         auto floorRenderer = std::make_unique<Renderer::InstancedRenderer>();
-        floorRenderer->SetMesh(floorMeshPtr);
         floorRenderer->SetInstances(floorInstances);
-        floorRenderer->Initialize();
+        loader.LoadPlane(1.0f, 1.0f, 1, 1, AttachMesh(floorRenderer.get()));
         stage.renderers.push_back(std::move(floorRenderer));
         stage.instanceDataList.push_back(floorInstances);
 
@@ -933,14 +979,9 @@ DiscoStage CreateDiscoStage()
     Core::Logger::GetInstance().Info("Creating cube-based sphere lights renderer...");
     try
     {
-        Renderer::MeshBuffer cubeMesh = Renderer::MeshBufferFactory::CreateCubeBuffer();
-        auto cubeMeshPtr = std::make_shared<Renderer::MeshBuffer>(std::move(cubeMesh));
-        stage.meshBuffers.push_back(cubeMeshPtr);
-
         auto cubeRenderer = std::make_unique<Renderer::InstancedRenderer>();
-        cubeRenderer->SetMesh(cubeMeshPtr);
         cubeRenderer->SetInstances(cubeInstances);
-        cubeRenderer->Initialize();
+        loader.LoadCube(AttachMesh(cubeRenderer.get()));
         stage.renderers.push_back(std::move(cubeRenderer));
         stage.instanceDataList.push_back(cubeInstances);
         Core::Logger::GetInstance().Info("Cube renderer index: " + std::to_string(stage.renderers.size() - 1));
@@ -954,14 +995,10 @@ DiscoStage CreateDiscoStage()
     Core::Logger::GetInstance().Info("Creating center core sphere renderer...");
     try
     {
-        Renderer::MeshBuffer sphereMesh = Renderer::MeshBufferFactory::CreateSphereBuffer(32, 32, 1.0f);
-        auto sphereMeshPtr = std::make_shared<Renderer::MeshBuffer>(std::move(sphereMesh));
-        stage.meshBuffers.push_back(sphereMeshPtr);
-
+        // ⭐ 参数化 LOD：32x32 → 16x16 → 8x8 → 4x6
         auto sphereRenderer = std::make_unique<Renderer::InstancedRenderer>();
-        sphereRenderer->SetMesh(sphereMeshPtr);
         sphereRenderer->SetInstances(sphereInstances);
-        sphereRenderer->Initialize();
+        loader.LoadSphereLOD(32, 32, 1.0f, 4, AttachMesh(sphereRenderer.get()));
         stage.renderers.push_back(std::move(sphereRenderer));
         stage.instanceDataList.push_back(sphereInstances);
         Core::Logger::GetInstance().Info("Sphere renderer index: " + std::to_string(stage.renderers.size() - 1));
@@ -980,14 +1017,10 @@ DiscoStage CreateDiscoStage()
         // ⭐ 创建圆环（参数化，2025-01-01修复后参数真正生效）
         // majorRadius=1.0, minorRadius=0.07, majorSegments=96, minorSegments=64
         // 高分段数确保圆环平滑，参数现在会被正确使用
-        Renderer::MeshBuffer torusMesh = Renderer::MeshBufferFactory::CreateTorusBuffer(1.0f, 0.07f, 96, 64);
-        auto torusMeshPtr = std::make_shared<Renderer::MeshBuffer>(std::move(torusMesh));
-        stage.meshBuffers.push_back(torusMeshPtr);
-
+        // 远处使用参数化 LOD（分段数逐级减半）
         auto torusRenderer = std::make_unique<Renderer::InstancedRenderer>();
-        torusRenderer->SetMesh(torusMeshPtr);
         torusRenderer->SetInstances(torusInstances);
-        torusRenderer->Initialize();
+        loader.LoadTorusLOD(1.0f, 0.07f, 96, 64, 4, AttachMesh(torusRenderer.get()));
         stage.renderers.push_back(std::move(torusRenderer));
         stage.instanceDataList.push_back(torusInstances);
         Core::Logger::GetInstance().Info("Torus renderer index: " + std::to_string(stage.renderers.size() - 1));
@@ -1003,14 +1036,9 @@ DiscoStage CreateDiscoStage()
     Core::Logger::GetInstance().Info("Creating platform renderer...");
     try
     {
-        Renderer::MeshBuffer platformMesh = Renderer::MeshBufferFactory::CreatePlaneBuffer(1.0f, 1.0f, 1, 1);
-        auto platformMeshPtr = std::make_shared<Renderer::MeshBuffer>(std::move(platformMesh));
-        stage.meshBuffers.push_back(platformMeshPtr);
-
         auto platformRenderer = std::make_unique<Renderer::InstancedRenderer>();
-        platformRenderer->SetMesh(platformMeshPtr);
         platformRenderer->SetInstances(platformInstances);
-        platformRenderer->Initialize();
+        loader.LoadPlane(1.0f, 1.0f, 1, 1, AttachMesh(platformRenderer.get()));   // 与地板合并为同一个请求
         stage.renderers.push_back(std::move(platformRenderer));
         stage.instanceDataList.push_back(platformInstances);
         Core::Logger::GetInstance().Info("Platform renderer index: " + std::to_string(stage.renderers.size() - 1));
@@ -1023,102 +1051,20 @@ DiscoStage CreateDiscoStage()
     // ========================================
     // 新增：斯坦福兔子在舞台上跳舞（最后添加）
     // ========================================
-    std::string bunnyPath = "assets/models/bunny.obj";
-    std::shared_ptr<Renderer::InstanceData> bunnyInstances = nullptr;
-
-    try
-    {
-        bunnyInstances = std::make_shared<Renderer::InstanceData>();
-
-        // 添加1个兔子实例 - 放大尺寸以便观察
-        bunnyInstances->Add(
-            glm::vec3(0.0f, 1.0f, 0.0f), // 位置：舞台中心，地面以上1米
-            glm::vec3(0.0f, 180.0f, 0.0f), // 旋转180度面向相机
-            glm::vec3(2.0f),             // 缩放：2倍（显著增大）
-            glm::vec3(1.0f, 0.0f, 0.0f)  // 红色
-        );
-
-        // 创建实例化渲染器（每个材质一个）
-        auto [bunnyRenderers, bunnyMeshes, bunnyData] =
-            Renderer::InstancedRenderer::CreateForOBJ(bunnyPath, bunnyInstances);
-
-        // 记录bunny渲染器的索引范围
-        stage.bunnyRendererStart = stage.renderers.size();
-        stage.bunnyRendererCount = bunnyRenderers.size();
-
-        Core::Logger::GetInstance().Info("=== BUNNY RENDERER DEBUG ===");
-        Core::Logger::GetInstance().Info("Bunny has " + std::to_string(bunnyRenderers.size()) + " renderers (materials)");
-        Core::Logger::GetInstance().Info("Bunny has " + std::to_string(bunnyMeshes.size()) + " mesh buffers");
-        for (size_t i = 0; i < bunnyMeshes.size(); ++i)
-        {
-            Core::Logger::GetInstance().Info("  Mesh " + std::to_string(i) +
-                                             " VAO: " + std::to_string(bunnyMeshes[i]->GetVAO()) +
-                                             " Vertices: " + std::to_string(bunnyMeshes[i]->GetVertexCount()) +
-                                             " Indices: " + std::to_string(bunnyMeshes[i]->GetIndexCount()) +
-                                             " HasIndices: " + std::string(bunnyMeshes[i]->HasIndices() ? "YES" : "NO"));
-        }
-        Core::Logger::GetInstance().Info("================================");
-
-        size_t bunnyRendererIndex = stage.renderers.size();
-        for (auto &renderer : bunnyRenderers)
-        {
-            renderer.Initialize();
-            stage.renderers.push_back(std::make_unique<Renderer::InstancedRenderer>(std::move(renderer)));
-        }
-
-        // 先添加到instanceDataList，然后再验证
-        for (auto &mesh : bunnyMeshes)
-        {
-            stage.meshBuffers.push_back(mesh);
-        }
-        stage.instanceDataList.push_back(bunnyData);
-        stage.bunnyData = bunnyData; // 保存bunnyData到DiscoStage
-
-        // 现在可以安全地验证了
-        Core::Logger::GetInstance().Info("=== CRITICAL VERIFICATION ===");
-        Core::Logger::GetInstance().Info("Bunny renderer index: " + std::to_string(bunnyRendererIndex));
-        Core::Logger::GetInstance().Info("Bunny renderer uses instanceData at: " +
-                                         std::to_string(reinterpret_cast<uintptr_t>(bunnyInstances.get())));
-        Core::Logger::GetInstance().Info("instanceDataList at: " +
-                                         std::to_string(reinterpret_cast<uintptr_t>(stage.instanceDataList[stage.instanceDataList.size() - 1].get())));
-        Core::Logger::GetInstance().Info("bunnyData at: " +
-                                         std::to_string(reinterpret_cast<uintptr_t>(bunnyData.get())));
-        Core::Logger::GetInstance().Info("All three should be the SAME!");
-        Core::Logger::GetInstance().Info("================================");
-
-        Core::Logger::GetInstance().Info("Stanford Bunny loaded successfully - " +
-                                         std::to_string(bunnyRenderers.size()) + " renderers (materials)");
-        Core::Logger::GetInstance().Info("Bunny renderer indices: [" +
-                                         std::to_string(stage.bunnyRendererStart) + " to " +
-                                         std::to_string(stage.bunnyRendererStart + stage.bunnyRendererCount - 1) + "]");
-
-        // 验证指针地址
-        Core::Logger::GetInstance().Info("=== POINTER VERIFICATION ===");
-        Core::Logger::GetInstance().Info("bunnyInstances.get(): " + std::to_string(reinterpret_cast<uintptr_t>(bunnyInstances.get())));
-        Core::Logger::GetInstance().Info("bunnyData.get(): " + std::to_string(reinterpret_cast<uintptr_t>(bunnyData.get())));
-        Core::Logger::GetInstance().Info("stage.instanceDataList[last].get(): " + std::to_string(reinterpret_cast<uintptr_t>(stage.instanceDataList[stage.instanceDataList.size() - 1].get())));
-        Core::Logger::GetInstance().Info("stage.bunnyData.get(): " + std::to_string(reinterpret_cast<uintptr_t>(stage.bunnyData.get())));
-        Core::Logger::GetInstance().Info("Same pointer? " + std::string(bunnyData.get() == stage.instanceDataList[stage.instanceDataList.size() - 1].get() ? "YES" : "NO"));
-
-        // 关键：检查bunnyInstances和bunnyData是否是同一个指针
-        bool samePointer = (bunnyInstances.get() == bunnyData.get());
-        Core::Logger::GetInstance().Info("bunnyInstances == bunnyData? " + std::string(samePointer ? "YES" : "NO"));
-
-        if (!samePointer)
-        {
-            Core::Logger::GetInstance().Error("WARNING: bunnyInstances and bunnyData are DIFFERENT pointers!");
-            Core::Logger::GetInstance().Error("This means the renderer uses bunnyInstances, but we're modifying bunnyData!");
-        }
-
-        Core::Logger::GetInstance().Info("================================");
-    }
-    catch (const std::exception &e)
-    {
-        Core::Logger::GetInstance().Error("Failed to load Stanford Bunny: " + std::string(e.what()));
-        bunnyInstances = nullptr;
-    }
+    // 实例数据先创建（动画从第一帧开始），渲染器由 LoadStageBunny 在模型到达后追加
+    auto bunnyInstances = std::make_shared<Renderer::InstanceData>();
+
+    // 添加1个兔子实例 - 放大尺寸以便观察
+    bunnyInstances->Add(
+        glm::vec3(0.0f, 1.0f, 0.0f),   // 位置：舞台中心，地面以上1米
+        glm::vec3(0.0f, 180.0f, 0.0f), // 旋转180度面向相机
+        glm::vec3(2.0f),               // 缩放：2倍（显著增大）
+        glm::vec3(1.0f, 0.0f, 0.0f)    // 红色
+    );
 
+    stage.instanceDataList.push_back(bunnyInstances);
     stage.bunnyInstances = bunnyInstances;
+    stage.bunnyData = bunnyInstances;
 
     // 打印渲染器索引分配
     Core::Logger::GetInstance().Info("========================================");
@@ -1133,9 +1079,8 @@ DiscoStage CreateDiscoStage()
     Core::Logger::GetInstance().Info("Platform renderer: " + std::to_string(idx++));
     if (stage.bunnyRendererCount > 0)
     {
-        Core::Logger::GetInstance().Info("Bunny renderers: [" + std::to_string(stage.bunnyRendererStart) +
-                                         " to " + std::to_string(stage.bunnyRendererStart + stage.bunnyRendererCount - 1) + "] " +
-                                         "(" + std::to_string(stage.bunnyRendererCount) + " materials)");
+        LOG_INFO("Bunny renderers: [{} to {}] ({} materials)", stage.bunnyRendererStart,
+                 stage.bunnyRendererStart + stage.bunnyRendererCount - 1, stage.bunnyRendererCount);
     }
 
     Core::Logger::GetInstance().Info("========================================");
@@ -1150,7 +1095,7 @@ DiscoStage CreateDiscoStage()
     Core::Logger::GetInstance().Info("Platform instanceData: " + std::to_string(dataIdx++));
     if (stage.bunnyData)
     {
-        Core::Logger::GetInstance().Info("Bunny instanceData: " + std::to_string(dataIdx++));
+        LOG_INFO("Bunny instanceData: {}", dataIdx);
     }
 
     Core::Logger::GetInstance().Info("========================================");
@@ -1167,6 +1112,129 @@ DiscoStage CreateDiscoStage()
     return stage;
 }
 
+// ========================================
+// 斯坦福兔子（后台加载，到达后追加渲染器）
+// ========================================
+void LoadStageBunny(DiscoStage &stage, Renderer::AssetLoader &loader, Renderer::TextureStreamer &textureStreamer)
+{
+    std::string bunnyPath = "assets/models/bunny.obj";
+
+    // ⭐ OBJ 解析和材质纹理解码在工作线程执行，纹理随网格一起上传（直接交由流送管理，只上传低分辨率 mip）
+    loader.LoadOBJ(bunnyPath, [&stage, &textureStreamer, bunnyPath](const Renderer::MeshHandle &asset)
+                   {
+        if (!asset)
+        {
+            Core::Logger::GetInstance().Error("Failed to load Stanford Bunny: " + bunnyPath);
+            return;
+        }
+
+        // 创建实例化渲染器（每个材质一个）
+        std::vector<Renderer::InstancedRenderer> bunnyRenderers =
+            Renderer::InstancedRenderer::CreateForAsset(asset, stage.bunnyData);
+
+        // 记录bunny渲染器的索引范围
+        stage.bunnyRendererStart = stage.renderers.size();
+        stage.bunnyRendererCount = bunnyRenderers.size();
+
+        for (auto &renderer : bunnyRenderers)
+        {
+            // 带纹理的材质交由纹理流送管理
+            if (renderer.HasTexture())
+            {
+                textureStreamer.Track(renderer.GetTexture(), renderer.GetInstances(),
+                                      renderer.GetMesh()->GetData().ComputeBoundingRadius());
+            }
+            stage.renderers.push_back(std::make_unique<Renderer::InstancedRenderer>(std::move(renderer)));
+        }
+        for (const auto &mesh : asset->GetMeshes())
+        {
+            stage.meshBuffers.push_back(mesh);
+        }
+
+        LOG_INFO("Stanford Bunny loaded successfully - {} renderers (materials), indices [{} to {}]",
+                 stage.bunnyRendererCount, stage.bunnyRendererStart,
+                 stage.bunnyRendererStart + stage.bunnyRendererCount - 1); },
+                   true, &textureStreamer);
+}
+
+// ========================================
+// 大型扫描模型（可选，流式导入：模型边解析边出现）
+// ========================================
+void StreamStageScan(DiscoStage &stage, Renderer::AssetLoader &loader)
+{
+    const std::string scanPath = "assets/models/scan.obj";
+    if (!std::filesystem::exists(scanPath))
+    {
+        return;
+    }
+
+    auto scanInstances = std::make_shared<Renderer::InstanceData>();
+    scanInstances->Add(
+        glm::vec3(0.0f, 0.0f, -25.0f), // 位置：舞台后方
+        glm::vec3(0.0f),
+        glm::vec3(1.0f),
+        glm::vec3(0.8f));
+    stage.instanceDataList.push_back(scanInstances);
+
+    // ⭐ 每个材质的第一块到达时创建渲染器；之后的块追加到同一个缓冲区，渲染器自动绘制新增部分
+    loader.StreamOBJ(
+        scanPath,
+        [&stage, scanInstances](const std::shared_ptr<Renderer::MeshBuffer> &mesh)
+        {
+            auto renderer = std::make_unique<Renderer::InstancedRenderer>();
+            renderer->SetMesh(mesh);
+            renderer->SetInstances(scanInstances);
+            renderer->Initialize();
+            stage.renderers.push_back(std::move(renderer));
+            stage.meshBuffers.push_back(mesh);
+        },
+        [scanPath](bool success)
+        {
+            if (!success)
+            {
+                Core::Logger::GetInstance().Error("Failed to stream scan model: " + scanPath);
+            }
+        });
+}
+
+// ========================================
+// glTF 模型（可选，GLB 的二进制块直接映射为网格数据）
+// ========================================
+void LoadStageGLTF(DiscoStage &stage, Renderer::AssetLoader &loader)
+{
+    const std::string gltfPath = "assets/models/stage.glb";
+    if (!std::filesystem::exists(gltfPath))
+    {
+        return;
+    }
+
+    auto gltfInstances = std::make_shared<Renderer::InstanceData>();
+    gltfInstances->Add(
+        glm::vec3(12.0f, 0.0f, -10.0f), // 位置：舞台右后方
+        glm::vec3(0.0f),
+        glm::vec3(1.0f),
+        glm::vec3(1.0f));
+    stage.instanceDataList.push_back(gltfInstances);
+
+    loader.LoadGLTF(gltfPath, [&stage, gltfInstances, gltfPath](const Renderer::MeshHandle &asset)
+                    {
+        if (!asset)
+        {
+            Core::Logger::GetInstance().Error("Failed to load glTF model: " + gltfPath);
+            return;
+        }
+
+        // 每个图元一个渲染器
+        for (auto &renderer : Renderer::InstancedRenderer::CreateForAsset(asset, gltfInstances))
+        {
+            stage.renderers.push_back(std::make_unique<Renderer::InstancedRenderer>(std::move(renderer)));
+        }
+        for (const auto &mesh : asset->GetMeshes())
+        {
+            stage.meshBuffers.push_back(mesh);
+        } });
+}
+
 // ========================================
 // 主程序
 // ========================================
@@ -1206,10 +1274,21 @@ int main()
             Core::LogLevel::INFO, // ✅ 改为INFO级别，确保能看到启动日志
             true,
             rotationConfig);
+        PROFILE_THREAD("Main");
 
         Core::Logger::GetInstance().Info("========================================");
         Core::Logger::GetInstance().Info("Cool Cubes Demo - Starting...");
         Core::Logger::GetInstance().Info("========================================");
+        // ========================================
+        // ⭐ 挂载资源打包文件（lumen-cook 生成）：着色器 / 纹理 / OBJ 网格从一个映射读取，
+        //    不存在时照常读取松散文件；烘焙后修改过的源文件自动回退到松散文件（AssetArchive::IsStale）
+        // ========================================
+        const std::string archivePath = "assets/scene.lpak";
+        if (fs::exists(archivePath))
+        {
+            Renderer::AssetArchive::Mount(archivePath);
+        }
+
         // ========================================
         // 创建窗口
         // ========================================
@@ -1303,6 +1382,22 @@ int main()
         glm::vec3 centerPosition(0.0f, 0.0f, 0.0f);
         SetupLighting(mainContext, rotatingPointLights, flashlight, centerPosition);  // ⭐ 传递Context
 
+        // ========================================
+        // ⭐ 后台资源加载：网格生成、OBJ 解析、材质纹理解码在工作线程进行，
+        //    天空盒和环境光照在此期间同步加载；渲染循环每帧按预算上传，渲染器随资源到达开始绘制
+        // ========================================
+        Renderer::TextureStreamer textureStreamer;  // 先于 assetLoader 构造：加载器的上传任务会把纹理交给它
+        Renderer::AssetLoader assetLoader;
+        double loadStartTime = glfwGetTime();
+
+        DiscoStage discoStage = CreateDiscoStage(assetLoader);
+        LoadStageBunny(discoStage, assetLoader, textureStreamer);
+        StreamStageScan(discoStage, assetLoader);
+        LoadStageGLTF(discoStage, assetLoader);
+
+        Car car;
+        LoadCar(car, assetLoader);
+
         // ========================================
         // 创建Skybox系统
         // ========================================
@@ -1343,7 +1438,7 @@ int main()
 
         if (skyboxLoaded)
         {
-            ambientLighting.LoadFromSkybox(skybox.GetTextureID(), g_ambientIntensity);
+            ambientLighting.LoadFromSkybox(skybox, g_ambientIntensity);
             ambientLighting.SetMode(g_currentAmbientMode);
             Core::Logger::GetInstance().Info("✓ Ambient lighting loaded from skybox");
             Core::Logger::GetInstance().Info("  - Mode: SKYBOX_SAMPLE (default)");
@@ -1367,51 +1462,10 @@ int main()
         // 使用环境光照着色器
         Renderer::Shader ambientShader;
         ambientShader.Load("assets/shader/ambient_ibl.vert", "assets/shader/ambient_ibl.frag");
+        ambientShader.BindUniformBlock("MaterialTable", static_cast<unsigned int>(Renderer::UniformBinding::MATERIAL_TABLE));
+        ambientShader.BindUniformBlock("AmbientSH", static_cast<unsigned int>(Renderer::UniformBinding::AMBIENT_SH));
         Core::Logger::GetInstance().Info("Using ambient_ibl shader with skybox sampling");
 
-        // ========================================
-        // 创建Disco舞台
-        // ========================================
-        DiscoStage discoStage = CreateDiscoStage();
-
-        // 初始化所有实例数据到GPU
-        Core::Logger::GetInstance().Info("Uploading instance data to GPU...");
-
-        for (size_t i = 0; i < discoStage.renderers.size(); ++i)
-        {
-            discoStage.renderers[i]->UpdateInstanceData();
-            Core::Logger::GetInstance().Info("  Updated renderer " + std::to_string(i) + " with " +
-                                             std::to_string(discoStage.renderers[i]->GetInstanceCount()) + " instances");
-        }
-
-        // ========================================
-        // 创建行驶的车
-        // ========================================
-        Car car = CreateCar();
-
-        Core::Logger::GetInstance().Info("=== CAR CREATION DEBUG ===");
-        Core::Logger::GetInstance().Info("Car renderers count: " + std::to_string(car.renderers.size()));
-        Core::Logger::GetInstance().Info("Car instanceData pointer: " + std::to_string(reinterpret_cast<uintptr_t>(car.instanceData.get())));
-        if (car.renderers.size() > 0)
-        {
-            Core::Logger::GetInstance().Info("Car renderer[0] instanceData pointer: " +
-                                             std::to_string(reinterpret_cast<uintptr_t>(car.renderers[0].GetInstances().get())));
-            Core::Logger::GetInstance().Info("Same pointer? " + std::string(car.instanceData.get() == car.renderers[0].GetInstances().get() ? "YES" : "NO"));
-            Core::Logger::GetInstance().Info("Car renderer[0] VAO: " + std::to_string(car.renderers[0].GetMesh()->GetVAO()));
-            Core::Logger::GetInstance().Info("Car renderer[0] HasTexture: " + std::string(car.renderers[0].HasTexture() ? "YES" : "NO"));
-            Core::Logger::GetInstance().Info("Car renderer[0] InstanceCount: " + std::to_string(car.renderers[0].GetInstanceCount()));
-
-            // 检查所有渲染器的VAO
-            for (size_t i = 0; i < car.renderers.size(); ++i)
-            {
-                Core::Logger::GetInstance().Info("Car renderer[" + std::to_string(i) + "] VAO: " +
-                                                 std::to_string(car.renderers[i].GetMesh()->GetVAO()) +
-                                                 " Vertices: " + std::to_string(car.renderers[i].GetMesh()->GetVertexCount()) +
-                                                 " Indices: " + std::to_string(car.renderers[i].GetMesh()->GetIndexCount()));
-            }
-        }
-        Core::Logger::GetInstance().Info("===========================");
-
         // ========================================
         // 注册键盘回调
         // ========================================
@@ -1443,6 +1497,17 @@ int main()
             g_currentAmbientMode = Renderer::AmbientLighting::Mode::HEMISPHERE;
             Core::Logger::GetInstance().Info("Ambient mode: HEMISPHERE (Gradient sky to ground)"); });
 
+        keyboardController.RegisterKeyCallback(GLFW_KEY_4, [&ambientLighting]()
+                                               {
+            if (!ambientLighting.HasIrradiance())
+            {
+                Core::Logger::GetInstance().Warning("SH ambient unavailable (no skybox)");
+                return;
+            }
+            ambientLighting.SetMode(Renderer::AmbientLighting::Mode::SPHERICAL_HARMONICS);
+            g_currentAmbientMode = Renderer::AmbientLighting::Mode::SPHERICAL_HARMONICS;
+            Core::Logger::GetInstance().Info("Ambient mode: SPHERICAL_HARMONICS (SH9 irradiance from skybox)"); });
+
         // 环境光强度调整
         keyboardController.RegisterKeyCallback(GLFW_KEY_RIGHT_BRACKET, [&]()
                                                {
@@ -1456,6 +1521,22 @@ int main()
             ambientLighting.SetIntensity(g_ambientIntensity);
             Core::Logger::GetInstance().Info("Ambient intensity: " + std::to_string(g_ambientIntensity)); });
 
+        // ⭐ F11：导出最近的每帧渲染统计（CSV + JSON，用于性能回归对比）
+        keyboardController.RegisterKeyCallback(GLFW_KEY_F11, []()
+                                               {
+            auto &frameStatistics = Renderer::FrameStatistics::GetInstance();
+            const std::string statsPath = "logs/render_stats_" + std::to_string(frameStatistics.GetLastFrame().frameIndex);
+            frameStatistics.ExportCSV(statsPath + ".csv");
+            frameStatistics.ExportJSON(statsPath + ".json"); });
+
+#if ENABLE_PROFILER
+        // ⭐ F12：导出最近的 CPU / GPU 区间（chrome://tracing 或 ui.perfetto.dev 打开）
+        keyboardController.RegisterKeyCallback(GLFW_KEY_F12, []()
+                                               {
+            const std::string tracePath = "logs/trace_" + std::to_string(Core::Profiler::GetInstance().GetFrameIndex()) + ".json";
+            Core::Profiler::GetInstance().ExportChromeTrace(tracePath); });
+#endif
+
         Core::Logger::GetInstance().Info("========================================");
         Core::Logger::GetInstance().Info("Disco Stage + Skybox loaded successfully!");
         Core::Logger::GetInstance().Info("Total renderers: " + std::to_string(discoStage.renderers.size()));
@@ -1467,8 +1548,12 @@ int main()
         Core::Logger::GetInstance().Info("  Mouse  - Look around");
         Core::Logger::GetInstance().Info("  TAB    - Toggle mouse capture");
         Core::Logger::GetInstance().Info("  SPACE  - Pause/Resume light animation");
-        Core::Logger::GetInstance().Info("  1/2/3  - Switch ambient mode (Color/Skybox/Hemisphere)");
+        Core::Logger::GetInstance().Info("  1/2/3/4 - Switch ambient mode (Color/Skybox/Hemisphere/SH)");
         Core::Logger::GetInstance().Info("  [ / ]  - Decrease/Increase ambient intensity");
+        Core::Logger::GetInstance().Info("  F11    - Export render statistics (logs/render_stats_<frame>.csv/.json)");
+#if ENABLE_PROFILER
+        Core::Logger::GetInstance().Info("  F12    - Export profiler trace (logs/trace_<frame>.json)");
+#endif
         Core::Logger::GetInstance().Info("  ESC    - Exit");
         Core::Logger::GetInstance().Info("========================================");
 
@@ -1493,8 +1578,25 @@ int main()
         float rotationAngle = 0.0f;
         bool animationPaused = false;
 
+        bool assetsLoaded = false;
+
         while (!window.ShouldClose())
         {
+            // ⭐ 按预算上传后台加载完成的资源（回调中为渲染器设置网格）
+            assetLoader.ProcessUploads();
+            if (!assetsLoaded && assetLoader.IsIdle())
+            {
+                assetsLoaded = true;
+                Renderer::AssetLoadProgress progress = assetLoader.GetProgress();
+                Core::Logger::GetInstance().Info("All assets loaded in " +
+                                                 std::to_string(static_cast<int>((glfwGetTime() - loadStartTime) * 1000.0)) +
+                                                 " ms (" + std::to_string(progress.completed) + " loaded, " +
+                                                 std::to_string(progress.failed) + " failed)");
+
+                // 共享网格资源概览（每个资源的引用数和 CPU / GPU 占用）
+                Renderer::AssetRegistry::GetInstance().LogStats();
+            }
+
             // FPS 计算
             double currentTime = glfwGetTime();
             fpsFrameCount++;
@@ -1509,7 +1611,11 @@ int main()
                 std::string title = std::string("Super Disco Stage | FPS: ") +
                                     std::to_string(static_cast<int>(fps)) +
                                     " | Frames: " + std::to_string(totalFrameCount) +
-                                    " | Space:Pause 1/2/3:AmbMode [/]:Intensity";
+                                    " | Space:Pause 1-4:AmbMode [/]:Intensity";
+                if (!assetsLoaded)
+                {
+                    title += " | Loading " + std::to_string(static_cast<int>(assetLoader.GetProgress().GetFraction() * 100.0f)) + "%";
+                }
                 window.SetTitle(title);
 
 #if ENABLE_PERFORMANCE_LOGGING
@@ -1517,10 +1623,17 @@ int main()
                 static int logCounter = 0;
                 if (++logCounter >= 2) // 每1秒输出一次
                 {
+                    Renderer::TextureStreamerStats streamStats = textureStreamer.GetStats();
+                    Renderer::FrameStats frameStats = Renderer::FrameStatistics::GetInstance().GetLastFrame();
                     std::string logMessage = "Disco Stage | FPS: " +
                                              std::to_string(static_cast<int>(fps)) +
                                              " | Total Frames: " +
-                                             std::to_string(totalFrameCount);
+                                             std::to_string(totalFrameCount) +
+                                             " | Draws: " + std::to_string(frameStats.Get(Renderer::RenderCounter::DrawCalls)) +
+                                             " | Triangles: " + std::to_string(frameStats.Get(Renderer::RenderCounter::Triangles)) +
+                                             " | Textures: " + std::to_string(streamStats.residentBytes / 1024) + " KB" +
+                                             " (pending " + std::to_string(streamStats.pendingRequests) +
+                                             ", evictions " + std::to_string(streamStats.evictions) + ")";
                     Core::Logger::GetInstance().Info(logMessage);
                     logCounter = 0;
                 }
@@ -1541,6 +1654,7 @@ int main()
             // ========================================
             if (!animationPaused)
             {
+                PROFILE_SCOPE("UpdateLights");
                 float time = static_cast<float>(glfwGetTime());
 
                 // 更新48个旋转点光源（使用辅助函数简化）
@@ -1654,14 +1768,13 @@ int main()
             static bool firstBunnyUpdate = true;
             if (firstBunnyUpdate)
             {
-                Core::Logger::GetInstance().Info("=== BUNNY UPDATE DEBUG ===");
-                Core::Logger::GetInstance().Info("bunnyRendererStart: " + std::to_string(discoStage.bunnyRendererStart));
-                Core::Logger::GetInstance().Info("bunnyRendererCount: " + std::to_string(discoStage.bunnyRendererCount));
-                Core::Logger::GetInstance().Info("renderers.size(): " + std::to_string(discoStage.renderers.size()));
-                Core::Logger::GetInstance().Info("Will update renderers " +
-                                                 std::to_string(discoStage.bunnyRendererStart) + " to " +
-                                                 std::to_string(discoStage.bunnyRendererStart + discoStage.bunnyRendererCount - 1));
-                Core::Logger::GetInstance().Info("========================");
+                LOG_INFO("=== BUNNY UPDATE DEBUG ===");
+                LOG_INFO("bunnyRendererStart: {}", discoStage.bunnyRendererStart);
+                LOG_INFO("bunnyRendererCount: {}", discoStage.bunnyRendererCount);
+                LOG_INFO("renderers.size(): {}", discoStage.renderers.size());
+                LOG_INFO("Will update renderers {} to {}", discoStage.bunnyRendererStart,
+                         discoStage.bunnyRendererStart + discoStage.bunnyRendererCount - 1);
+                LOG_INFO("========================");
                 firstBunnyUpdate = false;
             }
 
@@ -1715,6 +1828,26 @@ int main()
             glm::mat4 projection = camera.GetProjectionMatrix(aspectRatio, 0.1f, 300.0f);
             glm::mat4 view = camera.GetViewMatrix();
 
+            // 根据本帧相机更新纹理驻留层级
+            textureStreamer.Update(camera, aspectRatio, static_cast<float>(window.GetHeight()));
+
+            // 按投影尺寸把实例分到各 LOD（未设置 LOD 的渲染器为空操作）
+            for (auto &renderer : discoStage.renderers)
+            {
+                renderer->UpdateLOD(camera, static_cast<float>(window.GetHeight()));
+            }
+            for (auto &renderer : car.renderers)
+            {
+                renderer.UpdateLOD(camera, static_cast<float>(window.GetHeight()));
+            }
+
+            // 逐簇剔除（只有切分过簇的大网格参与，其余渲染器绘制完整网格）
+            const glm::mat4 viewProjection = projection * view;
+            for (auto &renderer : car.renderers)
+            {
+                renderer.UpdateCulling(viewProjection, camera.GetPosition());
+            }
+
             // 设置日志上下文
             Core::LogContext renderContext;
             renderContext.renderPass = "DiscoStage";
@@ -1743,11 +1876,14 @@ int main()
             ambientShader.SetVec3("viewPos", camera.GetPosition());
             ambientShader.SetBool("useInstanceColor", true);
             ambientShader.SetBool("useTexture", false);
+            ambientShader.SetBool("useTextureArray", false);
+            ambientShader.SetBool("useMaterialTable", false);
             ambientShader.SetFloat("shininess", 64.0f);
             ambientShader.SetFloat("time", static_cast<float>(currentTime));
 
             // ⭐ 设置纹理单元（材质纹理使用单元1）
             ambientShader.SetInt("textureSampler", 1);  // TextureUnit::MATERIAL_DIFFUSE
+            ambientShader.SetInt("textureArraySampler", 6);  // TextureUnit::MATERIAL_DIFFUSE_ARRAY
 
             // 应用环境光照（使用纹理单元10，避免与常用纹理冲突）
             ambientLighting.ApplyToShader(ambientShader);  // 默认 textureUnit = 10
@@ -1786,7 +1922,10 @@ int main()
             // ✅ 性能优化（2026-01-02）：使用批量渲染，减少OpenGL状态切换
             // 修复前：逐个渲染（46个渲染器 × 4次状态切换 = 184次状态切换/帧）
             // 修复后：按纹理分组批量渲染（状态切换减少60-70%）
-            Renderer::InstancedRenderer::RenderBatch(discoStage.renderers);
+            {
+                PROFILE_GPU_SCOPE("Scene");
+                Renderer::InstancedRenderer::RenderBatch(discoStage.renderers);
+            }
 
             // ========================================
             // 渲染行驶的车 - ✅ 放在最后渲染，确保不被遮挡
@@ -1807,16 +1946,16 @@ int main()
                 }
 
                 // 渲染车的所有材质
-                for (const auto &carRenderer : car.renderers)
+                // ⭐ 材质参数来自材质表（每顶点材质索引），整辆车只需设置一次状态
+                car.materialTable->Bind();
+                ambientShader.SetBool("useMaterialTable", true);
+                ambientShader.SetBool("useTexture", false);
+                ambientShader.SetBool("useInstanceColor", false);
                 {
-                    if (carRenderer.GetInstanceCount() > 0)
-                    {
-                        ambientShader.SetBool("useTexture", carRenderer.HasTexture());
-                        ambientShader.SetBool("useInstanceColor", false);  // 使用材质颜色
-                        ambientShader.SetVec3("objectColor", carRenderer.GetMaterialColor());
-                        carRenderer.Render();
-                    }
+                    PROFILE_GPU_SCOPE("Car");
+                    Renderer::InstancedRenderer::RenderBatch(car.renderers);
                 }
+                ambientShader.SetBool("useMaterialTable", false);
 
                 // 调试：每5秒输出一次渲染信息
                 static int renderDebugCount = 0;
@@ -1830,6 +1969,21 @@ int main()
                                                          " HasTexture: " + (car.renderers[i].HasTexture() ? "YES" : "NO") +
                                                          " InstanceCount: " + std::to_string(car.renderers[i].GetInstanceCount()));
                     }
+                    Renderer::MeshletCullStats cullStats;
+                    for (const auto &renderer : car.renderers)
+                    {
+                        cullStats.Accumulate(renderer.GetMeshletCullStats());
+                    }
+                    if (cullStats.totalClusters > 0)
+                    {
+                        Core::Logger::GetInstance().Info("Meshlet culling: " + std::to_string(cullStats.visibleClusters) + "/" +
+                                                         std::to_string(cullStats.totalClusters) + " clusters visible (" +
+                                                         std::to_string(static_cast<int>(cullStats.GetClusterCulledFraction() * 100.0f)) +
+                                                         "% culled), triangles culled " +
+                                                         std::to_string(static_cast<int>(cullStats.GetTriangleCulledFraction() * 100.0f)) +
+                                                         "%, drawn " + std::to_string(cullStats.drawnTriangles) + " in " +
+                                                         std::to_string(cullStats.drawRanges) + " range(s)");
+                    }
                     Core::Logger::GetInstance().Info("========================");
                 }
             }
@@ -1837,10 +1991,21 @@ int main()
             // ========================================
             // 交换缓冲区和事件处理
             // ========================================
-            window.SwapBuffers();
+            {
+                PROFILE_SCOPE("SwapBuffers");
+                window.SwapBuffers();
+            }
             window.PollEvents();
+
+            Renderer::FrameStatistics::GetInstance().EndFrame(deltaTime * 1000.0);
+            PROFILE_GPU_FRAME();
+            PROFILE_FRAME();
         }
 
+#if ENABLE_PROFILER
+        Core::GpuProfiler::GetInstance().Shutdown();
+#endif
+
         // ========================================
         // 清理和退出
         // ========================================
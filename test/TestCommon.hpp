@@ -0,0 +1,65 @@
+#pragma once
+
+/**
+ * @file TestCommon.hpp
+ * @brief 无头单元测试的公共断言（不依赖测试框架，由 ctest 按返回值判定）
+ *
+ * 使用方式：
+ * @code
+ * TEST_CHECK(a == b);
+ * TEST_CHECK_NEAR(value, 1.0f, 1e-3f);
+ * return Test::Finish("test_name");
+ * @endcode
+ */
+
+#include <cmath>
+#include <iostream>
+
+namespace Test
+{
+
+    inline int& FailureCount()
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    inline void Check(bool condition, const char* expression, const char* file, int line)
+    {
+        if (!condition)
+        {
+            std::cerr << file << ":" << line << ": CHECK failed: " << expression << std::endl;
+            ++FailureCount();
+        }
+    }
+
+    inline void CheckNear(double actual, double expected, double tolerance, const char* expression,
+                          const char* file, int line)
+    {
+        if (!(std::fabs(actual - expected) <= tolerance))
+        {
+            std::cerr << file << ":" << line << ": CHECK_NEAR failed: " << expression << " = " << actual
+                      << ", expected " << expected << " +/- " << tolerance << std::endl;
+            ++FailureCount();
+        }
+    }
+
+    /**
+     * @brief 输出结果并返回进程退出码（0 = 全部通过）
+     */
+    inline int Finish(const char* name)
+    {
+        if (FailureCount() == 0)
+        {
+            std::cout << "[PASS] " << name << std::endl;
+            return 0;
+        }
+        std::cerr << "[FAIL] " << name << ": " << FailureCount() << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+} // namespace Test
+
+#define TEST_CHECK(expr) ::Test::Check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+#define TEST_CHECK_NEAR(actual, expected, tolerance) \
+    ::Test::CheckNear(static_cast<double>(actual), static_cast<double>(expected), static_cast<double>(tolerance), #actual, __FILE__, __LINE__)
@@ -176,7 +176,7 @@ int main()
             {
                 double fps = fps_frameCount / (fps_currentTime - fps_lastTime);
                 Core::Logger::GetInstance().SetFPS(static_cast<int>(fps));
-                Core::Logger::GetInstance().LogStatisticsSummary();
+                Core::Logger::GetInstance().Info("FPS: " + std::to_string(static_cast<int>(fps)));
 
                 fps_frameCount = 0;
                 fps_lastTime = fps_currentTime;
@@ -0,0 +1,202 @@
+/**
+ * @file test_environment_prefilter.cpp
+ * @brief IBL CPU 预计算测试 - PrefilterCubemapCPU / ComputeBRDFLUTCPU（无需 GL 上下文）
+ *
+ * 测试目标：
+ * 1. 输出尺寸、mip 数与配置一致，非法输入返回 false
+ * 2. 纯色环境预滤波后每个粗糙度级别仍为同一颜色（能量守恒）
+ * 3. 单面光源：粗糙度 0 保留原方向，粗糙度增大后向相邻面扩散、背面保持黑色
+ * 4. BRDF LUT 数值范围及光滑 / 粗糙两端的已知趋势
+ */
+
+#include "TestCommon.hpp"
+#include "Renderer/Environment/EnvironmentPrefilter.hpp"
+#include "Core/Logger.hpp"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace Renderer;
+
+namespace
+{
+
+    float HalfToFloat(uint16_t half)
+    {
+        uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+        uint32_t exponent = (half >> 10) & 0x1Fu;
+        uint32_t mantissa = half & 0x3FFu;
+        uint32_t bits;
+        if (exponent == 0)
+        {
+            float value = std::ldexp(static_cast<float>(mantissa), -24);
+            return sign ? -value : value;
+        }
+        if (exponent == 31)
+        {
+            bits = sign | 0x7F800000u | (mantissa << 13);
+        }
+        else
+        {
+            bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+        }
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // RGBA16F 立方体贴图中 (face, mip) 级别的某个 texel 的某个通道
+    float Texel(const CompressedImage& image, uint32_t face, uint32_t mip, uint32_t x, uint32_t y, uint32_t channel)
+    {
+        uint32_t mipSize = std::max(1u, image.width >> mip);
+        const uint16_t* level = reinterpret_cast<const uint16_t*>(image.levels[face * image.mipCount + mip].data());
+        return HalfToFloat(level[(static_cast<size_t>(y) * mipSize + x) * 4 + channel]);
+    }
+
+    std::vector<std::vector<uint8_t>> MakeFaces(uint32_t size, const uint8_t (&colors)[6][3])
+    {
+        std::vector<std::vector<uint8_t>> faces(6, std::vector<uint8_t>(static_cast<size_t>(size) * size * 4));
+        for (uint32_t face = 0; face < 6; ++face)
+        {
+            for (size_t i = 0; i < static_cast<size_t>(size) * size; ++i)
+            {
+                faces[face][i * 4 + 0] = colors[face][0];
+                faces[face][i * 4 + 1] = colors[face][1];
+                faces[face][i * 4 + 2] = colors[face][2];
+                faces[face][i * 4 + 3] = 255;
+            }
+        }
+        return faces;
+    }
+
+    void TestInvalidInput()
+    {
+        EnvironmentPrefilterConfig config;
+        CompressedImage image;
+        std::vector<std::vector<uint8_t>> fiveFaces(5, std::vector<uint8_t>(16 * 16 * 4));
+        TEST_CHECK(!EnvironmentPrefilter::PrefilterCubemapCPU(fiveFaces, 16, config, image));
+
+        std::vector<std::vector<uint8_t>> shortFaces(6, std::vector<uint8_t>(8 * 8 * 4));
+        TEST_CHECK(!EnvironmentPrefilter::PrefilterCubemapCPU(shortFaces, 16, config, image));
+    }
+
+    void TestUniformEnvironment()
+    {
+        const uint8_t colors[6][3] = {{204, 102, 51}, {204, 102, 51}, {204, 102, 51},
+                                      {204, 102, 51}, {204, 102, 51}, {204, 102, 51}};
+        EnvironmentPrefilterConfig config;
+        config.size = 16;
+        config.mipCount = 4;
+        config.sampleCount = 64;
+
+        CompressedImage image;
+        TEST_CHECK(EnvironmentPrefilter::PrefilterCubemapCPU(MakeFaces(16, colors), 16, config, image));
+        TEST_CHECK(image.format == BlockFormat::RGBA16F);
+        TEST_CHECK(image.width == 16 && image.height == 16);
+        TEST_CHECK(image.faceCount == 6);
+        TEST_CHECK(image.mipCount == 4);
+        TEST_CHECK(image.levels.size() == 6u * 4u);
+        if (image.levels.size() != 6u * 4u)
+        {
+            return;
+        }
+
+        for (uint32_t face = 0; face < 6; ++face)
+        {
+            for (uint32_t mip = 0; mip < image.mipCount; ++mip)
+            {
+                uint32_t mipSize = std::max(1u, 16u >> mip);
+                TEST_CHECK(image.levels[face * image.mipCount + mip].size() == static_cast<size_t>(mipSize) * mipSize * 8);
+                for (uint32_t y = 0; y < mipSize; ++y)
+                {
+                    for (uint32_t x = 0; x < mipSize; ++x)
+                    {
+                        TEST_CHECK_NEAR(Texel(image, face, mip, x, y, 0), 0.8f, 0.01f);
+                        TEST_CHECK_NEAR(Texel(image, face, mip, x, y, 1), 0.4f, 0.01f);
+                        TEST_CHECK_NEAR(Texel(image, face, mip, x, y, 2), 0.2f, 0.01f);
+                        TEST_CHECK_NEAR(Texel(image, face, mip, x, y, 3), 1.0f, 0.0f);
+                    }
+                }
+            }
+        }
+    }
+
+    void TestSingleLitFace()
+    {
+        // 只有 +X 面为白色
+        const uint8_t colors[6][3] = {{255, 255, 255}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+        EnvironmentPrefilterConfig config;
+        config.size = 16;
+        config.mipCount = 5;
+        config.sampleCount = 256;
+
+        CompressedImage image;
+        TEST_CHECK(EnvironmentPrefilter::PrefilterCubemapCPU(MakeFaces(32, colors), 32, config, image));
+        if (image.levels.size() != 6u * 5u)
+        {
+            TEST_CHECK(image.levels.size() == 6u * 5u);
+            return;
+        }
+
+        const uint32_t roughMip = image.mipCount - 1;
+        const uint32_t roughCenter = std::max(1u, 16u >> roughMip) / 2;
+
+        // 粗糙度 0：+X 面保持白色，-X 面保持黑色
+        TEST_CHECK_NEAR(Texel(image, 0, 0, 8, 8, 0), 1.0f, 0.01f);
+        TEST_CHECK_NEAR(Texel(image, 1, 0, 8, 8, 0), 0.0f, 0.01f);
+
+        // 粗糙度 1：+X 中心变暗但仍是最亮的方向，相邻面（+Y）中心接收到部分光，背面（-X）仍为黑色
+        float litCenter = Texel(image, 0, roughMip, roughCenter, roughCenter, 0);
+        float sideCenter = Texel(image, 2, roughMip, roughCenter, roughCenter, 0);
+        float backCenter = Texel(image, 1, roughMip, roughCenter, roughCenter, 0);
+        TEST_CHECK(litCenter < 0.99f);
+        TEST_CHECK(litCenter > sideCenter);
+        TEST_CHECK(sideCenter > 0.01f);
+        TEST_CHECK_NEAR(backCenter, 0.0f, 0.01f);
+    }
+
+    void TestBRDFLUT()
+    {
+        const uint32_t size = 32;
+        CompressedImage lut;
+        EnvironmentPrefilter::ComputeBRDFLUTCPU(size, 256, lut);
+        TEST_CHECK(lut.format == BlockFormat::RG16F);
+        TEST_CHECK(lut.width == size && lut.height == size);
+        TEST_CHECK(lut.mipCount == 1 && lut.levels.size() == 1);
+        TEST_CHECK(lut.levels[0].size() == static_cast<size_t>(size) * size * 4);
+
+        const uint16_t* pixels = reinterpret_cast<const uint16_t*>(lut.levels[0].data());
+        auto scale = [&](uint32_t x, uint32_t y) { return HalfToFloat(pixels[(y * size + x) * 2 + 0]); };
+        auto bias = [&](uint32_t x, uint32_t y) { return HalfToFloat(pixels[(y * size + x) * 2 + 1]); };
+
+        for (uint32_t y = 0; y < size; ++y)
+        {
+            for (uint32_t x = 0; x < size; ++x)
+            {
+                TEST_CHECK(scale(x, y) >= 0.0f && bias(x, y) >= 0.0f);
+                TEST_CHECK(scale(x, y) + bias(x, y) <= 1.02f);
+            }
+        }
+
+        // 光滑表面正视（N·V ≈ 1，粗糙度 ≈ 0）：反射率 ≈ F0，scale ≈ 1，bias ≈ 0
+        TEST_CHECK_NEAR(scale(size - 1, 0), 1.0f, 0.03f);
+        TEST_CHECK_NEAR(bias(size - 1, 0), 0.0f, 0.01f);
+
+        // 粗糙表面的总反射低于光滑表面（几何遮蔽），掠射角的 bias（菲涅耳项）高于正视
+        TEST_CHECK(scale(size - 1, size - 1) + bias(size - 1, size - 1) < scale(size - 1, 0) + bias(size - 1, 0));
+        TEST_CHECK(bias(0, 0) > bias(size - 1, 0));
+    }
+
+} // namespace
+
+int main()
+{
+    Core::Logger::GetInstance().Initialize("logs/test_environment_prefilter.log", false, Core::LogLevel::WARNING, false);
+
+    TestInvalidInput();
+    TestUniformEnvironment();
+    TestSingleLitFace();
+    TestBRDFLUT();
+
+    return Test::Finish("test_environment_prefilter");
+}
@@ -0,0 +1,223 @@
+/**
+ * @file test_log_ring.cpp
+ * @brief 延迟格式化日志测试 - LogRing 无锁队列、LogFormat 参数编码 / 格式化、二进制日志与 lumen-logdecode
+ *
+ * 测试目标：
+ * 1. 容量取整、队列满时 TryPush 失败且出队后恢复；槽位内联与单独分配的消息内容完整
+ * 2. 多生产者 / 单消费者并发：每条消息恰好出队一次，同一生产者的消息保持顺序
+ * 3. LogFormat::Format：各参数类型、{:.Nf} / {:x}、花括号转义、参数不足输出 {?}
+ * 4. 二进制日志经 lumen-logdecode 还原的文本与格式化结果一致（附带调用点）
+ */
+
+#include "TestCommon.hpp"
+#include "Core/LogRing.hpp"
+#include "Core/LogFormat.hpp"
+#include "Core/Logger.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+    template <typename... Args>
+    std::string Encode(const Args&... args)
+    {
+        std::string bytes((Core::LogFormat::EncodedSize(args) + ... + 0), '\0');
+        char* cursor = &bytes[0];
+        (Core::LogFormat::EncodeArg(cursor, args), ...);
+        return bytes;
+    }
+
+    std::string Format(const char* format, const std::string& args)
+    {
+        return Core::LogFormat::Format(format, args.data(), args.size());
+    }
+
+    void TestCapacityAndOverflow()
+    {
+        TEST_CHECK(Core::LogRing(5).GetCapacity() == 8);
+        TEST_CHECK(Core::LogRing(1).GetCapacity() == 2);
+
+        Core::LogRing ring(4);
+        for (int i = 0; i < 4; ++i)
+        {
+            const std::string message = "message " + std::to_string(i);
+            TEST_CHECK(ring.TryPush(1, i, 0, message.data(), message.size()));
+        }
+        TEST_CHECK(!ring.TryPush(1, 4, 0, "full", 4));
+
+        std::vector<std::string> drained;
+        auto collect = [&drained](const Core::LogRecord& record) { drained.emplace_back(record.data, record.size); };
+        TEST_CHECK(ring.Drain(1, collect) == 1);
+        TEST_CHECK(ring.TryPush(2, 5, 7, "after", 5));
+        TEST_CHECK(ring.Drain(16, collect) == 4);
+        TEST_CHECK(ring.IsEmpty());
+        TEST_CHECK(drained.size() == 5 && drained.front() == "message 0" && drained.back() == "after");
+    }
+
+    void TestInlineAndHeapMessages()
+    {
+        Core::LogRing ring(8);
+        const size_t sizes[] = {0, 1, Core::LogRing::kInlineBytes, Core::LogRing::kInlineBytes + 1, 5000};
+        for (size_t i = 0; i < 5; ++i)
+        {
+            std::string message(sizes[i], static_cast<char>('a' + i));
+            TEST_CHECK(ring.TryPush(static_cast<uint8_t>(i % 4), 1000 + static_cast<int64_t>(i),
+                                    static_cast<uint32_t>(i), message.data(), message.size()));
+        }
+
+        size_t index = 0;
+        ring.Drain(8, [&](const Core::LogRecord& record) {
+            TEST_CHECK(record.size == sizes[index]);
+            TEST_CHECK(record.level == index % 4);
+            TEST_CHECK(record.timestampNs == 1000 + static_cast<int64_t>(index));
+            TEST_CHECK(record.formatId == index);
+            TEST_CHECK(std::string(record.data, record.size) == std::string(sizes[index], static_cast<char>('a' + index)));
+            ++index;
+        });
+        TEST_CHECK(index == 5);
+    }
+
+    void TestConcurrentProducers()
+    {
+        constexpr int kProducers = 4;
+        constexpr uint32_t kPerProducer = 20000;
+        Core::LogRing ring(64);  // 小队列：生产者频繁遇到队列满
+
+        std::atomic<int> finished{0};
+        std::vector<std::thread> producers;
+        for (int p = 0; p < kProducers; ++p)
+        {
+            producers.emplace_back([&ring, &finished, p]() {
+                for (uint32_t i = 0; i < kPerProducer; ++i)
+                {
+                    // 每 100 条插入一条超过内联大小的消息
+                    std::string message = std::to_string(p) + ":" + std::to_string(i);
+                    if (i % 100 == 0)
+                    {
+                        message.resize(Core::LogRing::kInlineBytes + 64, '#');
+                    }
+                    while (!ring.TryPush(1, 0, static_cast<uint32_t>(p), message.data(), message.size()))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                ++finished;
+            });
+        }
+
+        std::vector<uint32_t> next(kProducers, 0);
+        bool ordered = true;
+        size_t received = 0;
+        auto consume = [&](const Core::LogRecord& record) {
+            const std::string message(record.data, record.size);
+            const uint32_t producer = record.formatId;
+            const uint32_t sequence = static_cast<uint32_t>(std::stoul(message.substr(message.find(':') + 1)));
+            ordered = ordered && producer < kProducers && sequence == next[producer];
+            if (producer < kProducers)
+            {
+                next[producer] = sequence + 1;
+            }
+            ++received;
+        };
+        while (finished.load() < kProducers || !ring.IsEmpty())
+        {
+            if (ring.Drain(32, consume) == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+        ring.Drain(SIZE_MAX, consume);
+
+        TEST_CHECK(ordered);
+        TEST_CHECK(received == static_cast<size_t>(kProducers) * kPerProducer);
+    }
+
+    void TestFormat()
+    {
+        const std::string name = "bunny.obj";
+        TEST_CHECK(Format("Loaded {} vertices from {}", Encode(35947, name)) == "Loaded 35947 vertices from bunny.obj");
+        TEST_CHECK(Format("{} {} {}", Encode(-7, 42u, static_cast<int64_t>(-1))) == "-7 42 -1");
+        TEST_CHECK(Format("{:.3f} ms, scale {}", Encode(1.23456, 0.5f)) == "1.235 ms, scale 0.5");
+        TEST_CHECK(Format("flags {:x}", Encode(255u)) == "flags ff");
+        TEST_CHECK(Format("{} {} [{}]", Encode(true, false, 'x')) == "true false [x]");
+        TEST_CHECK(Format("{{literal}} {}", Encode("text")) == "{literal} text");
+        TEST_CHECK(Format("{} and {}", Encode(1)) == "1 and {?}");
+        TEST_CHECK(Format("only {}", Encode(1, 2, 3)) == "only 1");
+        TEST_CHECK(Format("{}", Encode(std::string())) == "");
+
+        static_assert(Core::LogFormat::CountPlaceholders("{} {:.2f} {{}}") == 2, "placeholder count");
+        static_assert(Core::LogFormat::CountPlaceholders("{") == SIZE_MAX, "unbalanced brace");
+    }
+
+    std::string ReadFile(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    void TestBinaryLogDecode()
+    {
+        const std::string binaryPath = "logs/test_log_ring.llog";
+        std::remove(binaryPath.c_str());
+
+        Core::LogQueueConfig queueConfig;
+        queueConfig.binaryLogPath = binaryPath;
+        Core::Logger& logger = Core::Logger::GetInstance();
+        logger.Initialize("logs/test_log_ring.log", false, Core::LogLevel::INFO, true, Core::LogRotationConfig(),
+                          queueConfig);
+        LOG_INFO("Loaded {} vertices from {} in {:.2f} ms", 35947, "bunny.obj", 12.345);
+        LOG_WARNING("Retry {} of {}", 2, 3);
+        logger.Info("plain text message");
+        logger.Shutdown();
+
+        const std::string binary = ReadFile(binaryPath);
+        TEST_CHECK(binary.size() > 8 && binary.compare(0, 4, "LLOG") == 0);
+
+#ifdef LUMEN_LOGDECODE
+        const std::string decodedPath = "logs/test_log_ring.decoded.log";
+        std::remove(decodedPath.c_str());
+        const std::string command = std::string("\"") + LUMEN_LOGDECODE + "\" --source -o " + decodedPath + " " + binaryPath;
+        TEST_CHECK(std::system(command.c_str()) == 0);
+
+        const std::string decoded = ReadFile(decodedPath);
+        TEST_CHECK(decoded.find("[INFO] Loaded 35947 vertices from bunny.obj in 12.35 ms  (") != std::string::npos);
+        TEST_CHECK(decoded.find("[WARNING] Retry 2 of 3") != std::string::npos);
+        TEST_CHECK(decoded.find("[INFO] plain text message") != std::string::npos);
+        TEST_CHECK(decoded.find("test_log_ring.cpp:") != std::string::npos);
+
+        // --level 过滤
+        const std::string warningsPath = "logs/test_log_ring.warnings.log";
+        const std::string filtered = std::string("\"") + LUMEN_LOGDECODE + "\" --level warning -o " + warningsPath + " " + binaryPath;
+        TEST_CHECK(std::system(filtered.c_str()) == 0);
+        const std::string warnings = ReadFile(warningsPath);
+        TEST_CHECK(warnings.find("Retry 2 of 3") != std::string::npos);
+        TEST_CHECK(warnings.find("Loaded") == std::string::npos);
+#endif
+    }
+
+} // namespace
+
+int main()
+{
+    TestCapacityAndOverflow();
+    TestInlineAndHeapMessages();
+    TestConcurrentProducers();
+    TestFormat();
+    TestBinaryLogDecode();
+
+    return Test::Finish("test_log_ring");
+}
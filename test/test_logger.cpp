@@ -0,0 +1,112 @@
+/**
+ * @file test_logger.cpp
+ * @brief 异步日志测试 - 队列溢出时的级别过滤与丢弃策略
+ *
+ * 测试目标：
+ * 1. 写入端不输出的 DEBUG 在入队前被过滤，不占用队列
+ * 2. 默认 LogOverflowPolicy::DROP 下，多线程 INFO 洪峰只丢弃 INFO，WARNING / ERROR 一条不丢
+ */
+
+#include "TestCommon.hpp"
+#include "Core/Logger.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+    constexpr int kThreads = 4;
+    constexpr int kDebugPerThread = 20000;
+    constexpr int kInfoPerThread = 20000;
+    constexpr int kErrorsPerThread = 50;
+
+    size_t CountLines(const std::string& path, const std::string& needle)
+    {
+        std::ifstream file(path);
+        size_t count = 0;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.find(needle) != std::string::npos)
+            {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+} // namespace
+
+int main()
+{
+    const std::string logPath = "test_logger.log";
+    std::remove(logPath.c_str());
+
+    Core::LogQueueConfig queueConfig;
+    queueConfig.capacity = 256; // 小队列，保证洪峰时溢出
+    queueConfig.overflow = Core::LogOverflowPolicy::DROP;
+
+    Core::Logger& logger = Core::Logger::GetInstance();
+    logger.Initialize(logPath, false, Core::LogLevel::DEBUG, true, Core::LogRotationConfig(), queueConfig);
+
+    TEST_CHECK(!logger.IsEnabled(Core::LogLevel::DEBUG));
+    TEST_CHECK(logger.IsEnabled(Core::LogLevel::INFO));
+    TEST_CHECK(logger.IsEnabled(Core::LogLevel::ERROR));
+
+    // DEBUG 洪峰：全部在入队前过滤，不产生丢弃
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t)
+        {
+            threads.emplace_back([t]() {
+                for (int i = 0; i < kDebugPerThread; ++i)
+                {
+                    Core::Logger::GetInstance().Debug("debug message " + std::to_string(i));
+                }
+                LOG_ERROR("after-debug error thread={}", t);
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+    TEST_CHECK(logger.GetDroppedCount() == 0);
+
+    // INFO 洪峰后紧跟 WARNING / ERROR：只允许丢弃 INFO
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t)
+        {
+            threads.emplace_back([t]() {
+                for (int i = 0; i < kInfoPerThread; ++i)
+                {
+                    LOG_INFO("info message thread={} i={}", t, i);
+                    if (i % 400 == 0)
+                    {
+                        LOG_ERROR("burst error thread={} i={}", t, i);
+                        Core::Logger::GetInstance().Warning("burst warning thread=" + std::to_string(t));
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+    uint64_t dropped = logger.GetDroppedCount();
+    logger.Shutdown();
+
+    const size_t burstErrors = static_cast<size_t>(kThreads) * kErrorsPerThread;
+    TEST_CHECK(CountLines(logPath, "debug message") == 0);
+    TEST_CHECK(CountLines(logPath, "after-debug error") == static_cast<size_t>(kThreads));
+    TEST_CHECK(CountLines(logPath, "burst error") == burstErrors);
+    TEST_CHECK(CountLines(logPath, "burst warning") == burstErrors);
+    TEST_CHECK(CountLines(logPath, "info message") + dropped == static_cast<size_t>(kThreads) * kInfoPerThread);
+
+    return Test::Finish("test_logger");
+}
@@ -0,0 +1,206 @@
+/**
+ * @file test_mesh_simplifier.cpp
+ * @brief QEM 网格简化测试 - MeshSimplifier::Simplify / BuildLODChain
+ *
+ * 测试目标：
+ * 1. 平面网格：内部顶点零误差折叠，边界顶点全部保留，面积不变、法线不翻转
+ * 2. 起伏曲面：实际误差不超过 targetError，误差上限越大简化越多
+ * 3. LOD 链：层级数不超过配置，三角形数逐级下降，每级只保留被引用的顶点，布局和材质与 LOD0 一致
+ */
+
+#include "TestCommon.hpp"
+#include "Renderer/Data/MeshSimplifier.hpp"
+#include "Core/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <vector>
+
+using namespace Renderer;
+
+namespace
+{
+
+    constexpr size_t kStride = 8;  // 位置(3) + 法线(3) + UV(2)
+
+    /**
+     * gridSize x gridSize 个四边形的开口网格，z = height(x, y)
+     */
+    template <typename HeightFn>
+    void MakeGrid(int gridSize, HeightFn height, std::vector<float>& vertices, std::vector<unsigned int>& indices)
+    {
+        vertices.clear();
+        indices.clear();
+        for (int y = 0; y <= gridSize; ++y)
+        {
+            for (int x = 0; x <= gridSize; ++x)
+            {
+                const float fx = static_cast<float>(x), fy = static_cast<float>(y);
+                vertices.insert(vertices.end(), {fx, fy, height(fx, fy), 0.0f, 0.0f, 1.0f,
+                                                 fx / gridSize, fy / gridSize});
+            }
+        }
+        const unsigned int row = static_cast<unsigned int>(gridSize + 1);
+        for (unsigned int y = 0; y < static_cast<unsigned int>(gridSize); ++y)
+        {
+            for (unsigned int x = 0; x < static_cast<unsigned int>(gridSize); ++x)
+            {
+                const unsigned int a = y * row + x, b = a + 1, c = a + row + 1, d = a + row;
+                indices.insert(indices.end(), {a, b, c, a, c, d});
+            }
+        }
+    }
+
+    // 三角形法线（未归一化，长度为面积的两倍）的 z 分量
+    float TriangleNormalZ(const std::vector<float>& vertices, const unsigned int* triangle)
+    {
+        const float* p0 = &vertices[triangle[0] * kStride];
+        const float* p1 = &vertices[triangle[1] * kStride];
+        const float* p2 = &vertices[triangle[2] * kStride];
+        return (p1[0] - p0[0]) * (p2[1] - p0[1]) - (p1[1] - p0[1]) * (p2[0] - p0[0]);
+    }
+
+    void TestPlanarGrid()
+    {
+        const int gridSize = 16;
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+        MakeGrid(gridSize, [](float, float) { return 0.0f; }, vertices, indices);
+        const size_t vertexCount = vertices.size() / kStride;
+
+        float error = -1.0f;
+        std::vector<unsigned int> simplified =
+            MeshSimplifier::Simplify(vertices.data(), vertexCount, kStride, 0, indices.data(), indices.size(), 0,
+                                     1e-4f, &error);
+
+        TEST_CHECK(!simplified.empty() && simplified.size() % 3 == 0);
+        TEST_CHECK(simplified.size() < indices.size() / 2);
+        TEST_CHECK_NEAR(error, 0.0f, 1e-5f);
+
+        double area = 0.0;
+        bool validIndices = true;
+        bool noFlips = true;
+        std::set<unsigned int> referenced;
+        for (size_t t = 0; t + 2 < simplified.size(); t += 3)
+        {
+            for (size_t c = 0; c < 3; ++c)
+            {
+                validIndices = validIndices && simplified[t + c] < vertexCount;
+                referenced.insert(simplified[t + c]);
+            }
+            if (!validIndices)
+            {
+                break;
+            }
+            const float normalZ = TriangleNormalZ(vertices, &simplified[t]);
+            noFlips = noFlips && normalZ > 0.0f;
+            area += 0.5 * normalZ;
+        }
+        TEST_CHECK(validIndices);
+        TEST_CHECK(noFlips);
+        TEST_CHECK_NEAR(area, static_cast<double>(gridSize * gridSize), 1e-3);
+
+        // 边界顶点被锁定
+        const unsigned int row = static_cast<unsigned int>(gridSize + 1);
+        size_t missingBoundary = 0;
+        for (unsigned int y = 0; y < row; ++y)
+        {
+            for (unsigned int x = 0; x < row; ++x)
+            {
+                const bool boundary = x == 0 || y == 0 || x == row - 1 || y == row - 1;
+                if (boundary && referenced.count(y * row + x) == 0)
+                {
+                    ++missingBoundary;
+                }
+            }
+        }
+        TEST_CHECK(missingBoundary == 0);
+    }
+
+    void TestErrorBound()
+    {
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+        MakeGrid(32, [](float x, float y) { return 1.5f * std::sin(x * 0.4f) * std::cos(y * 0.3f); }, vertices,
+                 indices);
+        const size_t vertexCount = vertices.size() / kStride;
+
+        size_t previousSize = indices.size() + 1;
+        for (float targetError : {0.001f, 0.01f, 0.05f})
+        {
+            float error = -1.0f;
+            std::vector<unsigned int> simplified =
+                MeshSimplifier::Simplify(vertices.data(), vertexCount, kStride, 0, indices.data(), indices.size(), 0,
+                                         targetError, &error);
+            TEST_CHECK(!simplified.empty());
+            TEST_CHECK(error >= 0.0f && error <= targetError);
+            TEST_CHECK(simplified.size() <= previousSize);
+            previousSize = simplified.size();
+        }
+        TEST_CHECK(previousSize < indices.size() / 2);
+    }
+
+    void TestLODChain()
+    {
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+        MakeGrid(48, [](float x, float y) { return 0.5f * std::sin(x * 0.2f) + 0.3f * std::cos(y * 0.25f); },
+                 vertices, indices);
+        const size_t indexCount = indices.size();
+
+        MeshData mesh;
+        mesh.SetVertices(std::move(vertices), kStride);
+        mesh.SetIndices(std::move(indices));
+        mesh.SetVertexLayout({0, 3, 6}, {3, 3, 2});
+        mesh.SetMaterialColor(glm::vec3(0.25f, 0.5f, 0.75f));
+        mesh.SetTexturePath("textures/grid.png");
+
+        MeshLODConfig config;
+        config.levelCount = 4;
+        config.maxError = 0.05f;
+        std::vector<MeshData> levels = MeshSimplifier::BuildLODChain(std::move(mesh), config);
+
+        TEST_CHECK(levels.size() >= 2 && levels.size() <= config.levelCount);
+        TEST_CHECK(!levels.empty() && levels[0].GetIndexCount() == indexCount);
+        for (size_t i = 1; i < levels.size(); ++i)
+        {
+            const MeshData& level = levels[i];
+            const MeshData& previous = levels[i - 1];
+            TEST_CHECK(level.GetIndexCount() % 3 == 0);
+            TEST_CHECK(static_cast<double>(level.GetIndexCount()) <=
+                       static_cast<double>(previous.GetIndexCount()) * config.minReduction);
+            TEST_CHECK(level.GetVertexCount() < previous.GetVertexCount());
+            TEST_CHECK(level.GetAttributeOffsets() == levels[0].GetAttributeOffsets());
+            TEST_CHECK(level.GetAttributeSizes() == levels[0].GetAttributeSizes());
+            TEST_CHECK(level.GetTexturePath() == "textures/grid.png");
+            TEST_CHECK_NEAR(level.GetMaterialColor().z, 0.75f, 0.0f);
+
+            // 每个顶点都被引用，索引都有效
+            std::vector<bool> used(level.GetVertexCount(), false);
+            bool validIndices = true;
+            for (size_t k = 0; k < level.GetIndexCount(); ++k)
+            {
+                const unsigned int index = level.GetIndexData()[k];
+                validIndices = validIndices && index < level.GetVertexCount();
+                if (validIndices)
+                {
+                    used[index] = true;
+                }
+            }
+            TEST_CHECK(validIndices);
+            TEST_CHECK(std::find(used.begin(), used.end(), false) == used.end());
+        }
+    }
+
+} // namespace
+
+int main()
+{
+    Core::Logger::GetInstance().Initialize("logs/test_mesh_simplifier.log", false, Core::LogLevel::WARNING, false);
+
+    TestPlanarGrid();
+    TestErrorBound();
+    TestLODChain();
+
+    return Test::Finish("test_mesh_simplifier");
+}
@@ -0,0 +1,233 @@
+/**
+ * @file test_meshlet.cpp
+ * @brief 网格簇测试 - MeshletBuilder 的切分规则、包围球与法线锥
+ *
+ * 测试目标：
+ * 1. 簇在索引缓冲区中连续且覆盖全部三角形，顶点数 / 三角形数不超过上限，vertexCount 为簇内不同顶点数
+ * 2. 包围球包含簇内所有顶点
+ * 3. 法线锥保守：锥体判定为背面的摄像机位置，簇内每个三角形确实背向摄像机
+ * 4. 平面簇的锥体有效（cutoff < 1），从背面看时被剔除；没有索引 / 已量化的网格不切分
+ */
+
+#include "TestCommon.hpp"
+#include "Renderer/Data/Meshlet.hpp"
+#include "Renderer/Data/MeshData.hpp"
+#include "Core/Logger.hpp"
+#include <cmath>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace Renderer;
+
+namespace
+{
+
+    constexpr size_t kStride = 8;  // 位置(3) + 法线(3) + UV(2)
+
+    MeshData MakeMesh(std::vector<float> vertices, std::vector<unsigned int> indices)
+    {
+        MeshData mesh;
+        mesh.SetVertices(std::move(vertices), kStride);
+        mesh.SetIndices(std::move(indices));
+        mesh.SetVertexLayout({0, 3, 6}, {3, 3, 2});
+        return mesh;
+    }
+
+    // 单位球（共享顶点，按纬度带输出三角形，外侧为正面）
+    MeshData MakeSphere(int stacks, int slices)
+    {
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+        const float pi = 3.14159265358979f;
+        for (int i = 0; i <= stacks; ++i)
+        {
+            const float phi = pi * static_cast<float>(i) / static_cast<float>(stacks);
+            for (int j = 0; j <= slices; ++j)
+            {
+                const float theta = 2.0f * pi * static_cast<float>(j) / static_cast<float>(slices);
+                const float x = std::sin(phi) * std::cos(theta), y = std::cos(phi), z = std::sin(phi) * std::sin(theta);
+                vertices.insert(vertices.end(), {x, y, z, x, y, z, static_cast<float>(j) / slices,
+                                                 static_cast<float>(i) / stacks});
+            }
+        }
+        const unsigned int row = static_cast<unsigned int>(slices + 1);
+        for (unsigned int i = 0; i < static_cast<unsigned int>(stacks); ++i)
+        {
+            for (unsigned int j = 0; j < static_cast<unsigned int>(slices); ++j)
+            {
+                const unsigned int a = i * row + j, b = a + row, c = b + 1, d = a + 1;
+                if (i != 0)
+                {
+                    indices.insert(indices.end(), {a, d, b});
+                }
+                if (i + 1 != static_cast<unsigned int>(stacks))
+                {
+                    indices.insert(indices.end(), {d, c, b});
+                }
+            }
+        }
+        return MakeMesh(std::move(vertices), std::move(indices));
+    }
+
+    // z = 0 平面上的网格，正面朝 +z
+    MeshData MakePlane(int gridSize)
+    {
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+        for (int y = 0; y <= gridSize; ++y)
+        {
+            for (int x = 0; x <= gridSize; ++x)
+            {
+                vertices.insert(vertices.end(), {static_cast<float>(x), static_cast<float>(y), 0.0f, 0.0f, 0.0f, 1.0f,
+                                                 0.0f, 0.0f});
+            }
+        }
+        const unsigned int row = static_cast<unsigned int>(gridSize + 1);
+        for (unsigned int y = 0; y < static_cast<unsigned int>(gridSize); ++y)
+        {
+            for (unsigned int x = 0; x < static_cast<unsigned int>(gridSize); ++x)
+            {
+                const unsigned int a = y * row + x, b = a + 1, c = a + row + 1, d = a + row;
+                indices.insert(indices.end(), {a, b, c, a, c, d});
+            }
+        }
+        return MakeMesh(std::move(vertices), std::move(indices));
+    }
+
+    glm::vec3 Position(const MeshData& mesh, unsigned int index)
+    {
+        const float* p = mesh.GetVertexData() + static_cast<size_t>(index) * mesh.GetVertexStride();
+        return glm::vec3(p[0], p[1], p[2]);
+    }
+
+    // Meshlet.hpp 中的判定：dot(normalize(coneApex - cameraPos), coneAxis) >= coneCutoff 时整簇背向摄像机
+    bool ConeCulled(const Meshlet& meshlet, const glm::vec3& camera)
+    {
+        const glm::vec3 toApex = meshlet.coneApex - camera;
+        const float length = glm::length(toApex);
+        return length > 0.0f && glm::dot(toApex / length, meshlet.coneAxis) >= meshlet.coneCutoff;
+    }
+
+    bool AllTrianglesBackfacing(const MeshData& mesh, const Meshlet& meshlet, const glm::vec3& camera)
+    {
+        const unsigned int* indices = mesh.GetIndexData() + meshlet.firstIndex;
+        for (uint32_t t = 0; t < meshlet.triangleCount; ++t)
+        {
+            const glm::vec3 p0 = Position(mesh, indices[t * 3]);
+            const glm::vec3 n = glm::cross(Position(mesh, indices[t * 3 + 1]) - p0, Position(mesh, indices[t * 3 + 2]) - p0);
+            const glm::vec3 view = p0 - camera;
+            if (glm::dot(n, view) < -1e-4f * glm::length(n) * glm::length(view))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void TestPartition()
+    {
+        MeshData sphere = MakeSphere(48, 64);
+        std::vector<Meshlet> meshlets = MeshletBuilder::Build(sphere, 64, 124);
+        TEST_CHECK(meshlets.size() > 1);
+
+        uint32_t nextIndex = 0;
+        bool contiguous = true;
+        bool withinLimits = true;
+        bool distinctCounts = true;
+        bool spheresContain = true;
+        for (const Meshlet& meshlet : meshlets)
+        {
+            contiguous = contiguous && meshlet.firstIndex == nextIndex && meshlet.triangleCount > 0;
+            nextIndex = meshlet.firstIndex + meshlet.triangleCount * 3;
+            withinLimits = withinLimits && meshlet.triangleCount <= 124 && meshlet.vertexCount <= 64;
+
+            std::set<unsigned int> distinct;
+            for (uint32_t i = 0; i < meshlet.triangleCount * 3 && meshlet.firstIndex + i < sphere.GetIndexCount(); ++i)
+            {
+                const unsigned int index = sphere.GetIndexData()[meshlet.firstIndex + i];
+                distinct.insert(index);
+                spheresContain = spheresContain &&
+                                 glm::length(Position(sphere, index) - meshlet.center) <= meshlet.radius + 1e-5f;
+            }
+            distinctCounts = distinctCounts && distinct.size() == meshlet.vertexCount;
+        }
+        TEST_CHECK(contiguous);
+        TEST_CHECK(nextIndex == sphere.GetIndexCount());
+        TEST_CHECK(withinLimits);
+        TEST_CHECK(distinctCounts);
+        TEST_CHECK(spheresContain);
+    }
+
+    void TestConeIsConservative()
+    {
+        MeshData sphere = MakeSphere(48, 64);
+        std::vector<Meshlet> meshlets = MeshletBuilder::Build(sphere);
+
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> coordinate(-6.0f, 6.0f);
+        size_t culled = 0;
+        size_t wrong = 0;
+        for (int sample = 0; sample < 200; ++sample)
+        {
+            const glm::vec3 camera(coordinate(random), coordinate(random), coordinate(random));
+            if (glm::length(camera) < 1.5f)
+            {
+                continue;
+            }
+            for (const Meshlet& meshlet : meshlets)
+            {
+                if (ConeCulled(meshlet, camera))
+                {
+                    ++culled;
+                    wrong += AllTrianglesBackfacing(sphere, meshlet, camera) ? 0 : 1;
+                }
+            }
+        }
+        TEST_CHECK(wrong == 0);
+        TEST_CHECK(culled > 0);  // 球面的簇足够平坦，锥体剔除确实生效
+    }
+
+    void TestPlanarCone()
+    {
+        MeshData plane = MakePlane(6);  // 49 个顶点、72 个三角形：一个簇
+        std::vector<Meshlet> meshlets = MeshletBuilder::Build(plane);
+        TEST_CHECK(meshlets.size() == 1);
+        if (meshlets.size() != 1)
+        {
+            return;
+        }
+
+        const Meshlet& meshlet = meshlets[0];
+        TEST_CHECK(meshlet.coneCutoff < 1.0f);
+        TEST_CHECK_NEAR(meshlet.coneAxis.z, 1.0f, 1e-5f);
+        TEST_CHECK(ConeCulled(meshlet, glm::vec3(3.0f, 3.0f, -10.0f)));   // 背面
+        TEST_CHECK(!ConeCulled(meshlet, glm::vec3(3.0f, 3.0f, 10.0f)));   // 正面
+        TEST_CHECK(!ConeCulled(meshlet, glm::vec3(-20.0f, 3.0f, 0.5f)));  // 掠射，在平面正面一侧
+    }
+
+    void TestRejectedInput()
+    {
+        MeshData noIndices;
+        noIndices.SetVertices(std::vector<float>(kStride * 3, 0.0f), kStride);
+        noIndices.SetVertexLayout({0, 3, 6}, {3, 3, 2});
+        TEST_CHECK(MeshletBuilder::Build(noIndices).empty());
+
+        MeshData quantized = MakePlane(2);
+        quantized.SetPositionDequantization(glm::vec3(1.0f), glm::vec3(0.0f));
+        TEST_CHECK(MeshletBuilder::Build(quantized).empty());
+    }
+
+} // namespace
+
+int main()
+{
+    Core::Logger::GetInstance().Initialize("logs/test_meshlet.log", false, Core::LogLevel::WARNING, false);
+
+    TestPartition();
+    TestConeIsConservative();
+    TestPlanarCone();
+    TestRejectedInput();
+
+    return Test::Finish("test_meshlet");
+}
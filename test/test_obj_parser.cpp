@@ -0,0 +1,199 @@
+/**
+ * @file test_obj_parser.cpp
+ * @brief 多线程 OBJ 解析测试 - OBJParser::LoadObj 与 tinyobj::LoadObj 的输出一致性
+ *
+ * 测试目标：
+ * 1. 仓库中的 OBJ 资源（assets/models）：属性数组、索引、每面顶点数、材质下标完全一致
+ * 2. 生成的多块（> 1MB，跨线程分块）OBJ：mtllib / usemtl / g / o、负索引、四边形与多种索引格式
+ *    的解析结果与 tinyobj 完全一致
+ */
+
+#include "TestCommon.hpp"
+#include "Renderer/Resources/OBJParser.hpp"
+#include "Core/Logger.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace Renderer;
+
+namespace
+{
+
+    struct ParseResult
+    {
+        bool ok = false;
+        tinyobj::attrib_t attrib;
+        std::vector<tinyobj::shape_t> shapes;
+        std::vector<tinyobj::material_t> materials;
+    };
+
+    ParseResult ParseWithTinyObj(const std::string& path, const std::string& basePath)
+    {
+        ParseResult result;
+        std::string err;
+        result.ok = tinyobj::LoadObj(&result.attrib, &result.shapes, &result.materials, &err, path.c_str(),
+                                     basePath.c_str(), true);
+        return result;
+    }
+
+    ParseResult ParseWithOBJParser(const std::string& path, const std::string& basePath)
+    {
+        ParseResult result;
+        std::string err;
+        result.ok = OBJParser::LoadObj(&result.attrib, &result.shapes, &result.materials, &err, path, basePath);
+        return result;
+    }
+
+    bool SameIndices(const std::vector<tinyobj::index_t>& a, const std::vector<tinyobj::index_t>& b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i].vertex_index != b[i].vertex_index || a[i].normal_index != b[i].normal_index ||
+                a[i].texcoord_index != b[i].texcoord_index)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void CheckSame(const ParseResult& expected, const ParseResult& actual)
+    {
+        TEST_CHECK(expected.ok && actual.ok);
+        TEST_CHECK(actual.attrib.vertices == expected.attrib.vertices);
+        TEST_CHECK(actual.attrib.normals == expected.attrib.normals);
+        TEST_CHECK(actual.attrib.texcoords == expected.attrib.texcoords);
+
+        TEST_CHECK(actual.shapes.size() == expected.shapes.size());
+        for (size_t s = 0; s < expected.shapes.size() && s < actual.shapes.size(); ++s)
+        {
+            const tinyobj::mesh_t& a = actual.shapes[s].mesh;
+            const tinyobj::mesh_t& e = expected.shapes[s].mesh;
+            TEST_CHECK(actual.shapes[s].name == expected.shapes[s].name);
+            TEST_CHECK(SameIndices(a.indices, e.indices));
+            TEST_CHECK(a.num_face_vertices == e.num_face_vertices);
+            TEST_CHECK(a.material_ids == e.material_ids);
+        }
+
+        TEST_CHECK(actual.materials.size() == expected.materials.size());
+        for (size_t m = 0; m < expected.materials.size() && m < actual.materials.size(); ++m)
+        {
+            TEST_CHECK(actual.materials[m].name == expected.materials[m].name);
+            TEST_CHECK(actual.materials[m].diffuse_texname == expected.materials[m].diffuse_texname);
+        }
+    }
+
+    void TestRepositoryModels()
+    {
+        const std::string basePath = std::string(LUMEN_SOURCE_DIR) + "/assets/models/";
+        for (const char* name : {"cube.obj", "simple_cube.obj"})
+        {
+            const std::string path = basePath + name;
+            ParseResult expected = ParseWithTinyObj(path, basePath);
+            ParseResult actual = ParseWithOBJParser(path, basePath);
+            CheckSame(expected, actual);
+            TEST_CHECK(!actual.shapes.empty() && !actual.shapes[0].mesh.indices.empty());
+        }
+    }
+
+    /**
+     * 网格面片：每行四边形交替使用 v/vt/vn、v//vn、v/vt 和负索引，每隔若干行切换 usemtl / g / o
+     */
+    void WriteLargeOBJ(const std::string& objPath, const std::string& mtlName, int gridSize)
+    {
+        std::ofstream obj(objPath);
+        obj << "# generated by test_obj_parser\n";
+        obj << "mtllib " << mtlName << "\n";
+
+        auto index = [gridSize](int x, int y) { return y * (gridSize + 1) + x + 1; };
+        char line[160];
+        for (int y = 0; y <= gridSize; ++y)
+        {
+            for (int x = 0; x <= gridSize; ++x)
+            {
+                std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\nvt %.5f %.5f\nvn 0.0 0.0 1.0\n",
+                              x * 0.013 - 1.0, y * 0.017 - 1.0, ((x * 7 + y * 3) % 11) * 0.031,
+                              static_cast<double>(x) / gridSize, static_cast<double>(y) / gridSize);
+                obj << line;
+            }
+        }
+
+        const int vertexCount = (gridSize + 1) * (gridSize + 1);
+        for (int y = 0; y < gridSize; ++y)
+        {
+            if (y % 37 == 0)
+            {
+                obj << (y % 2 == 0 ? "g" : "o") << " part" << y << "\n";
+            }
+            if (y % 23 == 0)
+            {
+                obj << "usemtl " << (y % 46 == 0 ? "red" : "textured") << "\n";
+            }
+            for (int x = 0; x < gridSize; ++x)
+            {
+                const int a = index(x, y), b = index(x + 1, y), c = index(x + 1, y + 1), d = index(x, y + 1);
+                switch ((x + y) % 4)
+                {
+                case 0:
+                    std::snprintf(line, sizeof(line), "f %d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d\n",
+                                  a, a, a, b, b, b, c, c, c, d, d, d);
+                    break;
+                case 1:
+                    std::snprintf(line, sizeof(line), "f %d//%d %d//%d %d//%d\n", a, a, b, b, c, c);
+                    break;
+                case 2:
+                    std::snprintf(line, sizeof(line), "f %d/%d %d/%d %d/%d %d/%d\n", a, a, b, b, c, c, d, d);
+                    break;
+                default:
+                    // 负索引相对于当前已定义的顶点数
+                    std::snprintf(line, sizeof(line), "f %d/%d/%d %d/%d/%d %d/%d/%d\n",
+                                  a - vertexCount - 1, a - vertexCount - 1, a - vertexCount - 1,
+                                  c - vertexCount - 1, c - vertexCount - 1, c - vertexCount - 1,
+                                  d - vertexCount - 1, d - vertexCount - 1, d - vertexCount - 1);
+                    break;
+                }
+                obj << line;
+            }
+        }
+    }
+
+    void TestLargeGeneratedOBJ()
+    {
+        const std::string objPath = "test_obj_parser.obj";
+        const std::string mtlPath = "test_obj_parser.mtl";
+        {
+            std::ofstream mtl(mtlPath);
+            mtl << "newmtl red\nKd 1.0 0.0 0.0\n\nnewmtl textured\nKd 1.0 1.0 1.0\nmap_Kd checker.png\n";
+        }
+        WriteLargeOBJ(objPath, mtlPath, 300);
+
+        std::ifstream file(objPath, std::ios::binary | std::ios::ate);
+        TEST_CHECK(static_cast<size_t>(file.tellg()) > (2u << 20));  // 至少两块
+
+        ParseResult expected = ParseWithTinyObj(objPath, "");
+        ParseResult actual = ParseWithOBJParser(objPath, "");
+        CheckSame(expected, actual);
+        TEST_CHECK(expected.materials.size() == 2);
+        TEST_CHECK(expected.shapes.size() > 1);
+
+        std::remove(objPath.c_str());
+        std::remove(mtlPath.c_str());
+    }
+
+} // namespace
+
+int main()
+{
+    Core::Logger::GetInstance().Initialize("logs/test_obj_parser.log", false, Core::LogLevel::WARNING, false);
+
+    TestRepositoryModels();
+    TestLargeGeneratedOBJ();
+
+    return Test::Finish("test_obj_parser");
+}
@@ -0,0 +1,431 @@
+/**
+ * lumen-cook - 离线资源打包工具
+ *
+ * 按场景清单把网格、纹理和着色器处理为运行时格式，写入一个 .lpak 打包文件。
+ * 运行时 AssetArchive::Mount 后，MeshCache / Texture / Shader 的加载入口直接从映射读取，
+ * 启动时不再逐个打开松散文件。
+ *
+ * 用法：
+ *   lumen-cook [选项] <清单文件>
+ *
+ * 选项：
+ *   -o <路径>      输出文件（默认与清单同名的 .lpak）
+ *   --root <目录>  清单中的路径相对此目录，也是运行时的工作目录（默认当前目录）
+ *   -q <质量>      纹理编码质量 fast | normal | high（默认 normal）
+ *   --verify       写入后重新打开并校验所有条目的哈希
+ *   -h, --help     显示帮助
+ *
+ * 清单格式（每行一个资源，# 开头为注释）：
+ *   mesh    <obj 路径>                 按材质拆分并优化为 .lmesh 布局（float + 量化上传布局各一条），
+ *                                      材质的漫反射纹理自动加入
+ *   texture <图像路径> [选项...]        编码为带 mip 链的 DDS；.dds 原样加入
+ *                                      选项：format=bc1|bc3|bc4|bc5|rgba8  no-mips  no-flip
+ *   shader  <glsl 路径>                源码
+ *   raw     <路径>                     原样拷贝
+ */
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include "Renderer/Geometry/OBJModel.hpp"
+#include "Renderer/Data/MeshQuantizer.hpp"
+#include "Renderer/Data/Meshlet.hpp"
+#include "Renderer/Resources/AssetArchive.hpp"
+#include "Renderer/Resources/MeshCache.hpp"
+#include "Renderer/Resources/TextureCompression.hpp"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Renderer;
+namespace fs = std::filesystem;
+
+namespace
+{
+    struct Options
+    {
+        std::string manifest;
+        std::string output;
+        std::string root;
+        CompressionQuality quality = CompressionQuality::NORMAL;
+        bool verify = false;
+    };
+
+    struct TextureOptions
+    {
+        bool autoFormat = true;
+        BlockFormat format = BlockFormat::BC1;
+        bool generateMips = true;
+        bool flip = true;
+    };
+
+    void PrintUsage()
+    {
+        std::printf(
+            "Usage: lumen-cook [options] <manifest>\n"
+            "  -o <path>     output archive (default: <manifest>.lpak)\n"
+            "  --root <dir>  directory manifest paths are relative to (default: current directory)\n"
+            "  -q <quality>  texture quality: fast | normal | high (default: normal)\n"
+            "  --verify      reopen the archive and check every entry hash\n"
+            "\n"
+            "Manifest lines:\n"
+            "  mesh <file.obj>\n"
+            "  texture <image> [format=bc1|bc3|bc4|bc5|rgba8] [no-mips] [no-flip]\n"
+            "  shader <file>\n"
+            "  raw <file>\n");
+    }
+
+    bool ParseArguments(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg == "-h" || arg == "--help")
+            {
+                return false;
+            }
+            else if (arg == "-o" && i + 1 < argc)
+            {
+                options.output = argv[++i];
+            }
+            else if (arg == "--root" && i + 1 < argc)
+            {
+                options.root = argv[++i];
+            }
+            else if (arg == "-q" && i + 1 < argc)
+            {
+                std::string name = argv[++i];
+                if (name == "fast")
+                    options.quality = CompressionQuality::FAST;
+                else if (name == "normal")
+                    options.quality = CompressionQuality::NORMAL;
+                else if (name == "high")
+                    options.quality = CompressionQuality::HIGH;
+                else
+                {
+                    std::fprintf(stderr, "Unknown quality: %s\n", name.c_str());
+                    return false;
+                }
+            }
+            else if (arg == "--verify")
+            {
+                options.verify = true;
+            }
+            else if (!arg.empty() && arg[0] == '-')
+            {
+                std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+                return false;
+            }
+            else if (options.manifest.empty())
+            {
+                options.manifest = arg;
+            }
+            else
+            {
+                std::fprintf(stderr, "Only one manifest can be cooked at a time\n");
+                return false;
+            }
+        }
+        return !options.manifest.empty();
+    }
+
+    bool ReadFile(const std::string& path, std::vector<uint8_t>& outBytes)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        std::streamsize size = file.tellg();
+        file.seekg(0, std::ios::beg);
+        outBytes.resize(static_cast<size_t>(size));
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(outBytes.data()), size));
+    }
+
+    bool CookTexture(const std::string& path, const TextureOptions& textureOptions, const Options& options,
+                     std::vector<uint8_t>& outBytes)
+    {
+        std::string error;
+        if (fs::path(path).extension() == ".dds" || fs::path(path).extension() == ".DDS")
+        {
+            // 已预编码：校验后原样加入
+            CompressedImageView view;
+            if (!ReadFile(path, outBytes) || !TextureCompression::ParseDDS(outBytes.data(), outBytes.size(), view, &error))
+            {
+                std::fprintf(stderr, "Invalid DDS %s: %s\n", path.c_str(), error.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        int width = 0, height = 0, channels = 0;
+        stbi_set_flip_vertically_on_load(false);
+        unsigned char* pixels = stbi_load(path.c_str(), &width, &height, &channels, 0);
+        if (!pixels)
+        {
+            std::fprintf(stderr, "Failed to load %s: %s\n", path.c_str(), stbi_failure_reason());
+            return false;
+        }
+
+        std::vector<uint8_t> rgba = TextureCompression::ExpandToRGBA8(
+            pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height), channels);
+        stbi_image_free(pixels);
+
+        if (textureOptions.flip)
+        {
+            // 与运行时 stbi_set_flip_vertically_on_load(true) 保持一致
+            TextureCompression::FlipVerticalRGBA8(rgba, static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+        }
+
+        BlockFormat format = textureOptions.autoFormat
+                                 ? TextureCompression::ChooseDefaultFormat(rgba.data(), static_cast<uint32_t>(width),
+                                                                           static_cast<uint32_t>(height), channels)
+                                 : textureOptions.format;
+
+        CompressedImage image;
+        std::vector<std::vector<uint8_t>> faces;
+        faces.push_back(std::move(rgba));
+        if (!TextureCompression::Compress(faces, static_cast<uint32_t>(width), static_cast<uint32_t>(height),
+                                          format, options.quality, textureOptions.generateMips, image, &error))
+        {
+            std::fprintf(stderr, "Failed to compress %s: %s\n", path.c_str(), error.c_str());
+            return false;
+        }
+        image.flippedForGL = textureOptions.flip;
+
+        if (!TextureCompression::WriteDDSToMemory(image, outBytes, &error))
+        {
+            std::fprintf(stderr, "Failed to encode %s: %s\n", path.c_str(), error.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool ParseTextureOptions(std::istringstream& tokens, TextureOptions& textureOptions)
+    {
+        std::string option;
+        while (tokens >> option)
+        {
+            if (option.compare(0, 7, "format=") == 0)
+            {
+                if (!TextureCompression::ParseFormatName(option.substr(7), textureOptions.format) ||
+                    textureOptions.format == BlockFormat::BC7)
+                {
+                    std::fprintf(stderr, "Unsupported output format: %s\n", option.c_str() + 7);
+                    return false;
+                }
+                textureOptions.autoFormat = false;
+            }
+            else if (option == "no-mips")
+            {
+                textureOptions.generateMips = false;
+            }
+            else if (option == "no-flip")
+            {
+                textureOptions.flip = false;
+            }
+            else
+            {
+                std::fprintf(stderr, "Unknown texture option: %s\n", option.c_str());
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool CookMesh(const std::string& path, const Options& options, AssetArchiveWriter& writer)
+    {
+        if (fs::path(path).extension() != ".obj")
+        {
+            // glTF / GLB 已是零拷贝映射的二进制格式，不需要烘焙
+            std::fprintf(stderr, "Only OBJ meshes can be cooked: %s\n", path.c_str());
+            return false;
+        }
+
+        std::vector<OBJModel::MaterialVertexData> submeshes = OBJModel::ParseMaterialVertexData(path);
+        if (submeshes.empty())
+        {
+            std::fprintf(stderr, "Failed to load mesh %s\n", path.c_str());
+            return false;
+        }
+
+        std::vector<uint8_t> bytes;
+        std::string error;
+        if (!MeshCache::WriteToMemory(path, submeshes, bytes, &error))
+        {
+            std::fprintf(stderr, "Failed to cook mesh %s: %s\n", path.c_str(), error.c_str());
+            return false;
+        }
+        writer.Add(path, AssetType::Mesh, std::move(bytes), MeshCache::GetSourceFiles(path));
+
+        // 量化上传布局（MeshDataFactory::PrepareForUpload 的结果），运行时 quantize 导入直接映射
+        std::vector<MeshData> prepared(submeshes.size());
+        for (size_t i = 0; i < submeshes.size(); ++i)
+        {
+            MeshData& data = prepared[i];
+            data.SetVertices(submeshes[i].vertices, 8);
+            data.SetIndices(submeshes[i].indices);
+            data.SetVertexLayout({0, 3, 6}, {3, 3, 2});
+            data.SetMaterialColor(submeshes[i].material.diffuse);
+            data.SetTexturePath(submeshes[i].texturePath);
+            if (data.GetIndexCount() / 3 >= MeshletBuilder::kMinTriangles)
+            {
+                data.SetMeshlets(MeshletBuilder::Build(data));
+            }
+            MeshQuantizer::Quantize(data);
+        }
+        std::vector<uint8_t> quantizedBytes;
+        if (!MeshCache::SerializeQuantized(path, prepared, {}, quantizedBytes, &error))
+        {
+            std::fprintf(stderr, "Failed to cook quantized mesh %s: %s\n", path.c_str(), error.c_str());
+            return false;
+        }
+        writer.Add(MeshCache::GetCachePath(path, true), AssetType::Mesh, std::move(quantizedBytes),
+                   MeshCache::GetSourceFiles(path));
+
+        // 材质纹理按 MeshCache 生成的路径加入，运行时 Texture::LoadFromFile 以同一路径命中
+        for (const auto& submesh : submeshes)
+        {
+            if (submesh.texturePath.empty() || writer.Has(submesh.texturePath, AssetType::Texture))
+                continue;
+
+            std::error_code ec;
+            if (!fs::exists(submesh.texturePath, ec))
+            {
+                std::fprintf(stderr, "Warning: texture not found, skipped: %s\n", submesh.texturePath.c_str());
+                continue;
+            }
+            std::vector<uint8_t> textureBytes;
+            if (CookTexture(submesh.texturePath, TextureOptions(), options, textureBytes))
+            {
+                writer.Add(submesh.texturePath, AssetType::Texture, std::move(textureBytes));
+            }
+        }
+        return true;
+    }
+
+    bool CookManifest(const std::string& manifestPath, const Options& options, AssetArchiveWriter& writer)
+    {
+        std::ifstream manifest(manifestPath);
+        if (!manifest.is_open())
+        {
+            std::fprintf(stderr, "Failed to open manifest %s\n", manifestPath.c_str());
+            return false;
+        }
+
+        int failures = 0;
+        int lineNumber = 0;
+        std::string line;
+        while (std::getline(manifest, line))
+        {
+            ++lineNumber;
+            size_t comment = line.find('#');
+            if (comment != std::string::npos)
+                line.erase(comment);
+
+            std::istringstream tokens(line);
+            std::string type, path;
+            if (!(tokens >> type))
+                continue;
+            if (!(tokens >> path))
+            {
+                std::fprintf(stderr, "%s:%d: missing path\n", manifestPath.c_str(), lineNumber);
+                ++failures;
+                continue;
+            }
+
+            auto start = std::chrono::high_resolution_clock::now();
+            size_t entriesBefore = writer.GetEntryCount();
+            bool ok = false;
+            if (type == "mesh")
+            {
+                ok = CookMesh(path, options, writer);
+            }
+            else if (type == "texture")
+            {
+                TextureOptions textureOptions;
+                std::vector<uint8_t> bytes;
+                ok = ParseTextureOptions(tokens, textureOptions) && CookTexture(path, textureOptions, options, bytes);
+                if (ok)
+                    writer.Add(path, AssetType::Texture, std::move(bytes));
+            }
+            else if (type == "shader" || type == "raw")
+            {
+                std::vector<uint8_t> bytes;
+                ok = ReadFile(path, bytes);
+                if (ok)
+                    writer.Add(path, type == "shader" ? AssetType::Shader : AssetType::Raw, std::move(bytes));
+                else
+                    std::fprintf(stderr, "Failed to read %s\n", path.c_str());
+            }
+            else
+            {
+                std::fprintf(stderr, "%s:%d: unknown asset type '%s'\n", manifestPath.c_str(), lineNumber, type.c_str());
+            }
+
+            if (!ok)
+            {
+                ++failures;
+                continue;
+            }
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            std::printf("%-8s %s  (%zu entries, %.1f ms)\n", type.c_str(), path.c_str(),
+                        writer.GetEntryCount() - entriesBefore, ms);
+        }
+        return failures == 0;
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseArguments(argc, argv, options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    // 清单和输出路径相对调用目录，资源路径相对 --root
+    fs::path manifestPath = fs::absolute(options.manifest);
+    fs::path outputPath = fs::absolute(options.output.empty() ? fs::path(options.manifest).replace_extension(".lpak")
+                                                              : fs::path(options.output));
+    if (!options.root.empty())
+    {
+        std::error_code ec;
+        fs::current_path(options.root, ec);
+        if (ec)
+        {
+            std::fprintf(stderr, "Cannot change to root directory %s: %s\n", options.root.c_str(), ec.message().c_str());
+            return 1;
+        }
+    }
+
+    AssetArchiveWriter writer;
+    if (!CookManifest(manifestPath.string(), options, writer))
+    {
+        std::fprintf(stderr, "Cooking failed, archive not written\n");
+        return 1;
+    }
+
+    std::string error;
+    if (!writer.Write(outputPath.string(), &error))
+    {
+        std::fprintf(stderr, "Failed to write %s: %s\n", outputPath.string().c_str(), error.c_str());
+        return 1;
+    }
+
+    AssetArchive archive;
+    if (!archive.Open(outputPath.string(), options.verify))
+    {
+        std::fprintf(stderr, "Written archive failed validation: %s\n", outputPath.string().c_str());
+        return 1;
+    }
+    std::printf("%s: %zu entries, %zu KB\n", outputPath.string().c_str(), archive.GetEntries().size(),
+                archive.GetSizeBytes() / 1024);
+    return 0;
+}
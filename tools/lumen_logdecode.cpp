@@ -0,0 +1,259 @@
+/**
+ * lumen-logdecode - 二进制日志解码工具
+ *
+ * 把 Logger 写出的二进制日志（LogQueueConfig::binaryLogPath）还原为文本日志，
+ * 输出格式与文本日志文件相同（不含渲染上下文）。格式串保存在日志文件内，不需要对应版本的程序。
+ *
+ * 用法：
+ *   lumen-logdecode [选项] <二进制日志>
+ *
+ * 选项：
+ *   -o <路径>        输出文件（默认标准输出）
+ *   --level <级别>   只输出不低于此级别的记录：debug | info | warning | error
+ *   --source         在每行末尾附加调用点（文件:行号）
+ *   -h, --help       显示帮助
+ */
+
+#include "Core/LogFormat.hpp"
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    struct Options
+    {
+        std::string input;
+        std::string output;
+        int minLevel = 0;
+        bool source = false;
+    };
+
+    struct FormatDefinition
+    {
+        std::string file;
+        uint32_t line = 0;
+        std::string format;
+    };
+
+    const char *LevelName(uint8_t level)
+    {
+        static const char *names[] = {"DEBUG", "INFO", "WARNING", "ERROR"};
+        return level < 4 ? names[level] : "UNKNOWN";
+    }
+
+    int ParseLevel(const std::string &name)
+    {
+        if (name == "debug")
+            return 0;
+        if (name == "info")
+            return 1;
+        if (name == "warning")
+            return 2;
+        if (name == "error")
+            return 3;
+        return -1;
+    }
+
+    // 与 Logger::FormatTimestamp 相同的格式
+    std::string FormatTimestamp(int64_t timestampNs)
+    {
+        std::chrono::system_clock::time_point time{
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(timestampNs))};
+        std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+        long long ms = (timestampNs / 1000000) % 1000;
+
+        char buffer[64];
+        size_t length = std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", std::localtime(&seconds));
+        std::snprintf(buffer + length, sizeof(buffer) - length, ".%03lld", ms < 0 ? ms + 1000 : ms);
+        return buffer;
+    }
+
+    void PrintUsage()
+    {
+        std::printf("Usage: lumen-logdecode [-o output] [--level debug|info|warning|error] [--source] <binary log>\n");
+    }
+
+    bool ParseArgs(int argc, char **argv, Options &options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg == "-h" || arg == "--help")
+            {
+                return false;
+            }
+            else if (arg == "-o" && i + 1 < argc)
+            {
+                options.output = argv[++i];
+            }
+            else if (arg == "--level" && i + 1 < argc)
+            {
+                options.minLevel = ParseLevel(argv[++i]);
+                if (options.minLevel < 0)
+                {
+                    std::fprintf(stderr, "Unknown level: %s\n", argv[i]);
+                    return false;
+                }
+            }
+            else if (arg == "--source")
+            {
+                options.source = true;
+            }
+            else if (!arg.empty() && arg[0] != '-' && options.input.empty())
+            {
+                options.input = arg;
+            }
+            else
+            {
+                std::fprintf(stderr, "Unknown argument: %s\n", arg.c_str());
+                return false;
+            }
+        }
+        return !options.input.empty();
+    }
+
+    template <typename T>
+    bool Read(std::istream &in, T &value)
+    {
+        return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+    }
+
+    bool ReadBytes(std::istream &in, uint32_t size, std::string &out)
+    {
+        out.resize(size);
+        return size == 0 || static_cast<bool>(in.read(&out[0], size));
+    }
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!ParseArgs(argc, argv, options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    std::ifstream in(options.input, std::ios::binary);
+    if (!in)
+    {
+        std::fprintf(stderr, "Cannot open %s\n", options.input.c_str());
+        return 1;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    if (!in.read(magic, sizeof(magic)) || !Read(in, version) ||
+        std::string(magic, sizeof(magic)) != std::string(Core::LogFormat::kBinaryMagic, sizeof(magic)))
+    {
+        std::fprintf(stderr, "%s is not a binary log\n", options.input.c_str());
+        return 1;
+    }
+    if (version != Core::LogFormat::kBinaryVersion)
+    {
+        std::fprintf(stderr, "Unsupported binary log version %u (expected %u)\n", version,
+                     Core::LogFormat::kBinaryVersion);
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!options.output.empty())
+    {
+        file.open(options.output, std::ios::out | std::ios::trunc);
+        if (!file)
+        {
+            std::fprintf(stderr, "Cannot open %s\n", options.output.c_str());
+            return 1;
+        }
+    }
+    std::ostream &out = options.output.empty() ? std::cout : file;
+
+    std::unordered_map<uint32_t, FormatDefinition> formats;
+    std::string payload;
+    size_t messageCount = 0;
+    bool truncated = false;
+
+    uint8_t kind = 0;
+    while (Read(in, kind))
+    {
+        if (kind == static_cast<uint8_t>(Core::LogFormat::BinaryRecordKind::Format))
+        {
+            uint32_t id = 0;
+            uint32_t fileLength = 0;
+            uint32_t formatLength = 0;
+            FormatDefinition definition;
+            if (!Read(in, id) || !Read(in, definition.line) || !Read(in, fileLength) ||
+                !ReadBytes(in, fileLength, definition.file) || !Read(in, formatLength) ||
+                !ReadBytes(in, formatLength, definition.format))
+            {
+                truncated = true;
+                break;
+            }
+            formats[id] = std::move(definition);
+        }
+        else if (kind == static_cast<uint8_t>(Core::LogFormat::BinaryRecordKind::Message))
+        {
+            uint32_t formatId = 0;
+            uint8_t level = 0;
+            int64_t timestampNs = 0;
+            uint32_t size = 0;
+            if (!Read(in, formatId) || !Read(in, level) || !Read(in, timestampNs) || !Read(in, size) ||
+                !ReadBytes(in, size, payload))
+            {
+                truncated = true;
+                break;
+            }
+            if (level < options.minLevel)
+            {
+                continue;
+            }
+
+            std::string message;
+            const FormatDefinition *definition = nullptr;
+            if (formatId == 0)
+            {
+                message = payload;
+            }
+            else
+            {
+                auto it = formats.find(formatId);
+                if (it != formats.end())
+                {
+                    definition = &it->second;
+                    message = Core::LogFormat::Format(definition->format, payload.data(), payload.size());
+                }
+                else
+                {
+                    message = "<unknown log format " + std::to_string(formatId) + ">";
+                }
+            }
+
+            out << "[" << FormatTimestamp(timestampNs) << "] [" << LevelName(level) << "] " << message;
+            if (options.source && definition)
+            {
+                out << "  (" << definition->file << ":" << definition->line << ")";
+            }
+            out << "\n";
+            ++messageCount;
+        }
+        else
+        {
+            std::fprintf(stderr, "Corrupt record (kind %u) after %zu messages\n", kind, messageCount);
+            return 1;
+        }
+    }
+
+    if (truncated)
+    {
+        // 进程异常退出时最后一条记录可能不完整，之前的记录仍然有效
+        std::fprintf(stderr, "Warning: log truncated after %zu messages\n", messageCount);
+    }
+    return 0;
+}
@@ -0,0 +1,212 @@
+/**
+ * lumen-texconv - 离线纹理压缩工具
+ *
+ * 将 PNG/JPG/TGA/BMP 等图像转换为带完整 mip 链的块压缩 DDS 文件，
+ * 运行时 Texture::LoadFromFile / Skybox::Load 会自动优先加载同名 .dds。
+ *
+ * 用法：
+ *   lumen-texconv [选项] <输入文件...>
+ *
+ * 选项：
+ *   -o <路径>      输出文件（仅单个输入时有效，默认与输入同名的 .dds）
+ *   -f <格式>      bc1 | bc3 | bc4 | bc5 | rgba8 | auto（默认 auto：按通道数/alpha 选择）
+ *   -q <质量>      fast | normal | high（默认 normal）
+ *   --no-mips      只输出第 0 级
+ *   --no-flip      不做垂直翻转（天空盒面使用此选项）
+ *   -h, --help     显示帮助
+ */
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include "Renderer/Resources/TextureCompression.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Renderer;
+
+namespace
+{
+    struct Options
+    {
+        std::vector<std::string> inputs;
+        std::string output;
+        bool autoFormat = true;
+        BlockFormat format = BlockFormat::BC1;
+        CompressionQuality quality = CompressionQuality::NORMAL;
+        bool generateMips = true;
+        bool flip = true;
+    };
+
+    void PrintUsage()
+    {
+        std::printf(
+            "Usage: lumen-texconv [options] <input...>\n"
+            "  -o <path>     output file (single input only, default: <input>.dds)\n"
+            "  -f <format>   bc1 | bc3 | bc4 | bc5 | rgba8 | auto (default: auto)\n"
+            "  -q <quality>  fast | normal | high (default: normal)\n"
+            "  --no-mips     write only mip level 0\n"
+            "  --no-flip     keep top-down row order (use for skybox faces)\n");
+    }
+
+    bool ParseArguments(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg == "-h" || arg == "--help")
+            {
+                return false;
+            }
+            else if (arg == "-o" && i + 1 < argc)
+            {
+                options.output = argv[++i];
+            }
+            else if (arg == "-f" && i + 1 < argc)
+            {
+                std::string name = argv[++i];
+                if (name == "auto")
+                {
+                    options.autoFormat = true;
+                }
+                else if (TextureCompression::ParseFormatName(name, options.format) && options.format != BlockFormat::BC7)
+                {
+                    options.autoFormat = false;
+                }
+                else
+                {
+                    std::fprintf(stderr, "Unsupported output format: %s\n", name.c_str());
+                    return false;
+                }
+            }
+            else if (arg == "-q" && i + 1 < argc)
+            {
+                std::string name = argv[++i];
+                if (name == "fast")
+                    options.quality = CompressionQuality::FAST;
+                else if (name == "normal")
+                    options.quality = CompressionQuality::NORMAL;
+                else if (name == "high")
+                    options.quality = CompressionQuality::HIGH;
+                else
+                {
+                    std::fprintf(stderr, "Unknown quality: %s\n", name.c_str());
+                    return false;
+                }
+            }
+            else if (arg == "--no-mips")
+            {
+                options.generateMips = false;
+            }
+            else if (arg == "--no-flip")
+            {
+                options.flip = false;
+            }
+            else if (!arg.empty() && arg[0] == '-')
+            {
+                std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+                return false;
+            }
+            else
+            {
+                options.inputs.push_back(arg);
+            }
+        }
+
+        if (options.inputs.empty())
+        {
+            return false;
+        }
+        if (!options.output.empty() && options.inputs.size() > 1)
+        {
+            std::fprintf(stderr, "-o can only be used with a single input\n");
+            return false;
+        }
+        return true;
+    }
+
+    bool ConvertFile(const std::string& input, const std::string& output, const Options& options)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        int width = 0, height = 0, channels = 0;
+        stbi_set_flip_vertically_on_load(false);
+        unsigned char* pixels = stbi_load(input.c_str(), &width, &height, &channels, 0);
+        if (!pixels)
+        {
+            std::fprintf(stderr, "Failed to load %s: %s\n", input.c_str(), stbi_failure_reason());
+            return false;
+        }
+
+        std::vector<uint8_t> rgba = TextureCompression::ExpandToRGBA8(
+            pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height), channels);
+        stbi_image_free(pixels);
+
+        if (options.flip)
+        {
+            // 与运行时 stbi_set_flip_vertically_on_load(true) 保持一致
+            TextureCompression::FlipVerticalRGBA8(rgba, static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+        }
+
+        BlockFormat format = options.autoFormat
+                                 ? TextureCompression::ChooseDefaultFormat(rgba.data(), static_cast<uint32_t>(width),
+                                                                           static_cast<uint32_t>(height), channels)
+                                 : options.format;
+
+        CompressedImage image;
+        std::string error;
+        std::vector<std::vector<uint8_t>> faces;
+        faces.push_back(std::move(rgba));
+        if (!TextureCompression::Compress(faces, static_cast<uint32_t>(width), static_cast<uint32_t>(height),
+                                          format, options.quality, options.generateMips, image, &error))
+        {
+            std::fprintf(stderr, "Failed to compress %s: %s\n", input.c_str(), error.c_str());
+            return false;
+        }
+        image.flippedForGL = options.flip;
+
+        if (!TextureCompression::WriteDDS(output, image, &error))
+        {
+            std::fprintf(stderr, "Failed to write %s: %s\n", output.c_str(), error.c_str());
+            return false;
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        // 对比未压缩 RGBA8 + mip 链的显存占用
+        size_t rawBytes = static_cast<size_t>(width) * height * 4 * (options.generateMips ? 4 : 3) / 3;
+        std::printf("%s -> %s  %dx%d %s, %u mips, %zu KB (RGBA8: %zu KB), %.1f ms\n",
+                    input.c_str(), output.c_str(), width, height,
+                    TextureCompression::GetFormatName(format), image.mipCount,
+                    image.GetTotalSizeBytes() / 1024, rawBytes / 1024, ms);
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseArguments(argc, argv, options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    int failures = 0;
+    for (const auto& input : options.inputs)
+    {
+        std::string output = options.output.empty() ? TextureCompression::GetCompressedSiblingPath(input)
+                                                    : options.output;
+        if (!ConvertFile(input, output, options))
+        {
+            ++failures;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}